@@ -16,6 +16,12 @@ Sen_06_Triangle::~Sen_06_Triangle()
 }
 /*********************************************************************************************************************/
 /*********************************************************************************************************************/
+void Sen_06_Triangle::prefetchStartupAssets()
+{
+	prefetchShader("SenVulkanTutorial/Shaders/Triangle.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/Triangle.frag");
+}
+
 void Sen_06_Triangle::initVulkanApplication()
 {
 	createColorAttachOnlyRenderPass();
@@ -72,7 +78,7 @@ void Sen_06_Triangle::finalizeWidget()
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != triangleVertexBuffer) {
 		vkDestroyBuffer(m_LogicalDevice, triangleVertexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, triangleVertexBufferMemory, nullptr);	// always try to destroy before free
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, triangleVertexBufferMemory);	// always try to destroy before free
 
 		triangleVertexBuffer = VK_NULL_HANDLE;
 		triangleVertexBufferMemory = VK_NULL_HANDLE;
@@ -409,7 +415,7 @@ void Sen_06_Triangle::createTriangleVertexBuffer() {
 		triangleVertexBuffer, verticesBufferSize);
 
 	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, stagingBufferDeviceMemory);	// always try to destroy before free
 }
 
 void Sen_06_Triangle::createTriangleCommandBuffers() {
@@ -12,6 +12,7 @@ public:
 	virtual ~Sen_06_Triangle();
 	
 protected:
+	void prefetchStartupAssets();
 	void initVulkanApplication();
 	void reCreateRenderTarget();// for resize window
 
@@ -19,6 +19,13 @@ Sen_072_TextureArray::~Sen_072_TextureArray()
 	OutputDebugString("\n\t ~Sen_072_TextureArray()\n");
 }
 
+void Sen_072_TextureArray::prefetchStartupAssets()
+{
+	prefetchShader("SenVulkanTutorial/Shaders/textureArray.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/textureArray.frag");
+	prefetchTexture("../Images/texturearray_bc3.ktx");	// the array initTex2DArrayImage() loads
+}
+
 void Sen_072_TextureArray::initVulkanApplication()
 {
 	// Need to be segmented base on pipleStages in this function
@@ -112,7 +119,7 @@ void Sen_072_TextureArray::finalizeWidget()
 		if (VK_NULL_HANDLE != texture2DSampler)  
 			vkDestroySampler(m_LogicalDevice, texture2DSampler, nullptr);
 		if (VK_NULL_HANDLE != backgroundTextureImageDeviceMemory)
-			vkFreeMemory(m_LogicalDevice, backgroundTextureImageDeviceMemory, nullptr); 	// always try to destroy before free
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, backgroundTextureImageDeviceMemory); 	// always try to destroy before free
 
 		backgroundTextureImage				= VK_NULL_HANDLE;
 		backgroundTextureImageDeviceMemory	= VK_NULL_HANDLE;
@@ -124,7 +131,7 @@ void Sen_072_TextureArray::finalizeWidget()
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != textureAppVertexBuffer) {
 		vkDestroyBuffer(m_LogicalDevice, textureAppVertexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, textureAppVertexBufferMemory, nullptr);	// always try to destroy before free
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, textureAppVertexBufferMemory);	// always try to destroy before free
 
 		textureAppVertexBuffer			= VK_NULL_HANDLE;
 		textureAppVertexBufferMemory	= VK_NULL_HANDLE;
@@ -377,7 +384,7 @@ void Sen_072_TextureArray::createTextureAppVertexBuffer()
 		textureAppVertexBuffer, verticesBufferSize);
 
 	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, stagingBufferDeviceMemory);	// always try to destroy before free
 }
 
 void Sen_072_TextureArray::initTex2DArrayImage()
@@ -402,7 +409,7 @@ void Sen_072_TextureArray::initTex2DArrayImage()
 	SLVK_AbstractGLFW::createDeviceLocalTextureArray(m_LogicalDevice, m_PhysicalDeviceMemoryProperties
 		, texturesDiskAddressVector, VK_IMAGE_TYPE_2D
 		, backgroundTextureImage, backgroundTextureImageDeviceMemory, backgroundTextureImageView
-		, VK_SHARING_MODE_EXCLUSIVE, m_DefaultThreadCommandPool, m_GraphicsQueue);
+		, VK_SHARING_MODE_EXCLUSIVE, *stagingRing);
 
 	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
 }
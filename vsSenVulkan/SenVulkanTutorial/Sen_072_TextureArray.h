@@ -12,6 +12,7 @@ public:
 	virtual ~Sen_072_TextureArray();
 
 protected:
+	void prefetchStartupAssets();
 	void initVulkanApplication();
 	void reCreateRenderTarget(); // for resize window
 	void finalizeWidget();
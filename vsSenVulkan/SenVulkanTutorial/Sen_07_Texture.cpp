@@ -18,6 +18,13 @@ Sen_07_Texture::~Sen_07_Texture()
 	OutputDebugString("\n\t ~Sen_07_Texture()\n");
 }
 
+void Sen_07_Texture::prefetchStartupAssets()
+{
+	prefetchShader("SenVulkanTutorial/Shaders/Texture.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/Texture.frag");
+	prefetchTexture(backgroundTextureDiskAddress);
+}
+
 void Sen_07_Texture::initVulkanApplication()
 {
 	// Need to be segmented base on pipleStages in this function
@@ -111,7 +118,7 @@ void Sen_07_Texture::finalizeWidget()
 		if (VK_NULL_HANDLE != texture2DSampler)  
 			vkDestroySampler(m_LogicalDevice, texture2DSampler, nullptr);
 		if (VK_NULL_HANDLE != backgroundTextureImageDeviceMemory)
-			vkFreeMemory(m_LogicalDevice, backgroundTextureImageDeviceMemory, nullptr); 	// always try to destroy before free
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, backgroundTextureImageDeviceMemory); 	// always try to destroy before free
 
 		backgroundTextureImage				= VK_NULL_HANDLE;
 		backgroundTextureImageDeviceMemory	= VK_NULL_HANDLE;
@@ -123,7 +130,7 @@ void Sen_07_Texture::finalizeWidget()
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != textureAppVertexBuffer) {
 		vkDestroyBuffer(m_LogicalDevice, textureAppVertexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, textureAppVertexBufferMemory, nullptr);	// always try to destroy before free
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, textureAppVertexBufferMemory);	// always try to destroy before free
 
 		textureAppVertexBuffer			= VK_NULL_HANDLE;
 		textureAppVertexBufferMemory	= VK_NULL_HANDLE;
@@ -376,7 +383,7 @@ void Sen_07_Texture::createTextureAppVertexBuffer()
 		textureAppVertexBuffer, verticesBufferSize);
 
 	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, stagingBufferDeviceMemory);	// always try to destroy before free
 }
 
 void Sen_07_Texture::initBackgroundTextureImage()
@@ -384,7 +391,7 @@ void Sen_07_Texture::initBackgroundTextureImage()
 	SLVK_AbstractGLFW::createDeviceLocalTexture(m_LogicalDevice, m_PhysicalDeviceMemoryProperties
 		, backgroundTextureDiskAddress, VK_IMAGE_TYPE_2D, backgroundTextureWidth, backgroundTextureHeight
 		, backgroundTextureImage, backgroundTextureImageDeviceMemory, backgroundTextureImageView
-		, VK_SHARING_MODE_EXCLUSIVE, m_DefaultThreadCommandPool, m_GraphicsQueue);
+		, VK_SHARING_MODE_EXCLUSIVE, *stagingRing);
 
 	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
 }
@@ -12,6 +12,7 @@ public:
 	virtual ~Sen_07_Texture();
 
 protected:
+	void prefetchStartupAssets();
 	void initVulkanApplication();
 	void reCreateRenderTarget(); // for resize window
 	void finalizeWidget();
@@ -17,6 +17,13 @@ Sen_221_Cube::~Sen_221_Cube()
 	OutputDebugString("\n\t ~Sen_221_Cube()\n");
 }
 
+void Sen_221_Cube::prefetchStartupAssets()
+{
+	prefetchShader("SenVulkanTutorial/Shaders/SenCube.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/SenCube.frag");
+	prefetchTexture(backgroundTextureDiskAddress);
+}
+
 void Sen_221_Cube::initVulkanApplication()
 {
 	createTextureAppDescriptorSetLayout();
@@ -55,7 +62,7 @@ void Sen_221_Cube::cleanUpDepthStencil()
 		if (VK_NULL_HANDLE != depthTestImageView)
 			vkDestroyImageView(m_LogicalDevice, depthTestImageView, nullptr);
 		if (VK_NULL_HANDLE != depthTestImageDeviceMemory)
-			vkFreeMemory(m_LogicalDevice, depthTestImageDeviceMemory, nullptr); 	// always try to destroy before free
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, depthTestImageDeviceMemory); 	// always try to destroy before free
 
 		depthTestImage = VK_NULL_HANDLE;
 		depthTestImageView = VK_NULL_HANDLE;
@@ -123,7 +130,7 @@ void Sen_221_Cube::finalizeWidget()
 		if (VK_NULL_HANDLE != texture2DSampler)  
 			vkDestroySampler(m_LogicalDevice, texture2DSampler, nullptr);
 		if (VK_NULL_HANDLE != backgroundTextureImageDeviceMemory)
-			vkFreeMemory(m_LogicalDevice, backgroundTextureImageDeviceMemory, nullptr); 	// always try to destroy before free
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, backgroundTextureImageDeviceMemory); 	// always try to destroy before free
 
 		backgroundTextureImage				= VK_NULL_HANDLE;
 		backgroundTextureImageDeviceMemory	= VK_NULL_HANDLE;
@@ -135,14 +142,14 @@ void Sen_221_Cube::finalizeWidget()
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != cubeVertexBuffer) {
 		vkDestroyBuffer(m_LogicalDevice, cubeVertexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, cubeVertexBufferMemory, nullptr);	// always try to destroy before free
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, cubeVertexBufferMemory);	// always try to destroy before free
 
 		cubeVertexBuffer			= VK_NULL_HANDLE;
 		cubeVertexBufferMemory	= VK_NULL_HANDLE;
 	}
 	if (VK_NULL_HANDLE != cubeIndexBuffer) {
 		vkDestroyBuffer(m_LogicalDevice, cubeIndexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, cubeIndexBufferMemory, nullptr);	// always try to destroy before free
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, cubeIndexBufferMemory);	// always try to destroy before free
 
 		cubeIndexBuffer = VK_NULL_HANDLE;
 		cubeIndexBufferMemory = VK_NULL_HANDLE;
@@ -415,7 +422,7 @@ void Sen_221_Cube::createCubeIndexBuffer()
 		cubeIndexBuffer, indicesBufferSize);
 
 	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, stagingBufferDeviceMemory);	// always try to destroy before free
 }
 
 void Sen_221_Cube::createCubeVertexBuffer()
@@ -494,7 +501,7 @@ void Sen_221_Cube::createCubeVertexBuffer()
 		cubeVertexBuffer, verticesBufferSize);
 
 	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, stagingBufferDeviceMemory);	// always try to destroy before free
 }
 
 void Sen_221_Cube::initBackgroundTextureImage()
@@ -502,7 +509,7 @@ void Sen_221_Cube::initBackgroundTextureImage()
 	SLVK_AbstractGLFW::createDeviceLocalTexture(m_LogicalDevice, m_PhysicalDeviceMemoryProperties
 		, backgroundTextureDiskAddress, VK_IMAGE_TYPE_2D, backgroundTextureWidth, backgroundTextureHeight
 		, backgroundTextureImage, backgroundTextureImageDeviceMemory, backgroundTextureImageView
-		, VK_SHARING_MODE_EXCLUSIVE, m_DefaultThreadCommandPool, m_GraphicsQueue);
+		, VK_SHARING_MODE_EXCLUSIVE, *stagingRing);
 
 	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
 }
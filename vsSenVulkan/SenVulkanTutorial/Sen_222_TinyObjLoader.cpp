@@ -8,6 +8,7 @@ Sen_222_TinyObjLoader::Sen_222_TinyObjLoader()
 
 	tinyObjCompleteTextureDiskAddress	= "../Images/MeshLinkModels/Chalet/chalet.jpg";
 	tinyObjectDiskAddress				= "../Images/MeshLinkModels/Chalet/chalet.obj";
+	//tinyObjectDiskAddress				= "../Images/MeshLinkModels/Chalet/chalet.smc";	// vsSenVulkan --compress-mesh
 	//tinyObjCompleteTextureDiskAddress	= "../Images/MeshLinkModels/Duck/duckCM.jpg";
 	//tinyObjectDiskAddress				= "../Images/MeshLinkModels/Duck/duck.3ds";
 }
@@ -19,27 +20,49 @@ Sen_222_TinyObjLoader::~Sen_222_TinyObjLoader()
 	OutputDebugString("\n\t ~Sen_222_TinyObjLoader()\n");
 }
 
+void Sen_222_TinyObjLoader::prefetchStartupAssets()
+{
+	prefetchShader("SenVulkanTutorial/Shaders/loadModelObjMvp.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/loadModelObjThreeMatrix.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/loadModelObj.frag");
+	prefetchShader("SenVulkanTutorial/Shaders/loadModelObjDepthPrePass.vert");
+}
+
 void Sen_222_TinyObjLoader::initVulkanApplication()
 {
 	createTextureAppDescriptorSetLayout();
 	createDefaultCommandPool();
 
-	initTinyObjCompleteTextureImage();
-	createMvpUniformBuffers();
+	// The model and its texture arrive through the loader thread, a placeholder cube is drawn until both are resident;
+	// the loader sub-allocates the model from the same geometry arena as the cube
+	createGeometryArena();
+	streamingStartTime = std::chrono::high_resolution_clock::now();
+	streamingLoader.reset(new SenStreamingLoader(m_LogicalDevice, m_PhysicalDeviceMemoryProperties, graphicsQueueFamilyIndex, *graphicsTimeline,
+		geometryArena.get()));
+	streamedMeshAssetId		= streamingLoader->requestMesh(tinyObjectDiskAddress, true);
+	streamedTextureAssetId	= streamingLoader->requestTexture(tinyObjCompleteTextureDiskAddress);
+
+	initPlaceholderTextureImage();
+	createMvpRegionsBuffer();				// replaces createMvpUniformBuffers(), no staging copy per frame
 	createTextureAppDescriptorPool();
 	createTextureAppDescriptorSet();
 
 	/***************************************/
-	createDepthTestAttachment();			// has to be called after createDefaultCommandPool();
-	createDepthTestRenderPass();			// has to be called after createDepthTestAttachment() for depthTestFormat
+	createRenderGraphs();					// compiled render passes, the pipelines are created against them
 	createTinyObjLoaderPipeline();
 
-	createDepthTestSwapchainFramebuffers(); // has to be called after createDepthTestAttachment() for the depthTestImageView
+	// Both graphs keep their targets, P switches between them without waiting for the device
+	singlePassGraph->createTargets(m_WidgetWidth, m_WidgetHeight, m_SwapchainImageViewsVector);	// depth image and framebuffers
+	depthPrePassGraph->createTargets(m_WidgetWidth, m_WidgetHeight, m_SwapchainImageViewsVector);
 
-	stobjl::populateVertexIndexVector(tinyObjectDiskAddress, vertexStructVector, indexVector);
+	createPlaceholderCubeMesh();
+	computeModelBoundingSphere();
 
 	createMeshLinkModeVertexBuffer();
+	createPositionStreamBuffer();
 	createMeshLinkModelndexBuffer();
+	createLodIndirectBuffer();				// has to be called after createSwapchain() for the correct m_SwapChain_ImagesCount
+	createDrawTimestampQueryPool();			// after createLodIndirectBuffer(), whose per-image updates submit nothing
 	/***************************************/
 
 	createTinyObjLoaderCommandBuffers();
@@ -49,63 +72,158 @@ void Sen_222_TinyObjLoader::initVulkanApplication()
 
 void Sen_222_TinyObjLoader::reCreateRenderTarget()
 {
-	createDepthTestAttachment();
-	createDepthTestSwapchainFramebuffers();
+	singlePassGraph->createTargets(m_WidgetWidth, m_WidgetHeight, m_SwapchainImageViewsVector);
+	depthPrePassGraph->createTargets(m_WidgetWidth, m_WidgetHeight, m_SwapchainImageViewsVector);
+	if (lodIndirectRegionsCount != m_SwapChain_ImagesCount) {
+		createMvpRegionsBuffer();
+		createLodIndirectBuffer();
+		createDrawTimestampQueryPool();
+	}
 	createTinyObjLoaderCommandBuffers();
 }
 
 void Sen_222_TinyObjLoader::cleanUpDepthStencil()
 {
-	if (VK_NULL_HANDLE != depthTestImage) {
-		vkDestroyImage(m_LogicalDevice, depthTestImage, nullptr);
-		if (VK_NULL_HANDLE != depthTestImageView)
-			vkDestroyImageView(m_LogicalDevice, depthTestImageView, nullptr);
-		if (VK_NULL_HANDLE != depthTestImageDeviceMemory)
-			vkFreeMemory(m_LogicalDevice, depthTestImageDeviceMemory, nullptr); 	// always try to destroy before free
-
-		depthTestImage = VK_NULL_HANDLE;
-		depthTestImageView = VK_NULL_HANDLE;
-		depthTestImageDeviceMemory = VK_NULL_HANDLE;
-	}
+	// the swapchain views the framebuffers reference are about to go
+	if (singlePassGraph)
+		singlePassGraph->destroyTargets();
+	if (depthPrePassGraph)
+		depthPrePassGraph->destroyTargets();
+}
+
+void Sen_222_TinyObjLoader::createRenderGraphs()
+{
+	selectDepthTestFormat();
+
+	/****************************************************************************************************************************/
+	/**********   Single pass:  depth test and write while shading, fragment work grows with the overdraw   **********************/
+	/****************************************************************************************************************************/
+	singlePassGraph.reset(new SenRenderGraph(m_LogicalDevice, m_PhysicalDeviceMemoryProperties));
+	uint32_t swapchainResource	= singlePassGraph->importSwapchain(m_SurfaceFormat.format);
+	uint32_t depthResource		= singlePassGraph->createTransientImage("depth", depthTestFormat);
+
+	modelPassIndex = singlePassGraph->addPass("model", [this](const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex) {
+		recordModelPass(commandBuffer, swapchainImageIndex, threeMatrixMvpPathEnabled ? threeMatrixMvpPipeline : tinyObjLoaderPipeline, true); });
+	singlePassGraph->writeColor(modelPassIndex, swapchainResource, { 0.2f, 0.3f, 0.3f, 1.0f });
+	singlePassGraph->writeDepth(modelPassIndex, depthResource, { 1.0f, 0 });
+	singlePassGraph->compile();
+
+	/****************************************************************************************************************************/
+	/**********   Depth pre-pass:  positions only lay down the nearest depth, then each pixel is shaded once (EQUAL)   ***********/
+	/****************************************************************************************************************************/
+	depthPrePassGraph.reset(new SenRenderGraph(m_LogicalDevice, m_PhysicalDeviceMemoryProperties));
+	swapchainResource	= depthPrePassGraph->importSwapchain(m_SurfaceFormat.format);
+	depthResource		= depthPrePassGraph->createTransientImage("prePassDepth", depthTestFormat);
+
+	depthPrePassIndex = depthPrePassGraph->addPass("depthPrePass", [this](const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex) {
+		recordDepthPrePass(commandBuffer, swapchainImageIndex); });
+	depthPrePassGraph->writeDepth(depthPrePassIndex, depthResource, { 1.0f, 0 });
+
+	prePassModelPassIndex = depthPrePassGraph->addPass("model", [this](const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex) {
+		recordModelPass(commandBuffer, swapchainImageIndex, depthEqualPipeline, false); });
+	depthPrePassGraph->writeColor(prePassModelPassIndex, swapchainResource, { 0.2f, 0.3f, 0.3f, 1.0f });
+	depthPrePassGraph->readDepth(prePassModelPassIndex, depthResource);
+	depthPrePassGraph->compile();
 }
 
 void Sen_222_TinyObjLoader::updateUniformBuffer() {
+	streamingLoader->pumpUploads(m_StreamingUploadByteBudget);
+	if (!streamedAssetsSwappedIn)
+		swapInStreamedAssets();
+
 	static auto startTime = std::chrono::high_resolution_clock::now();
 	auto currentTime = std::chrono::high_resolution_clock::now();
 	float duration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - startTime).count() / 220.0f;
 
-	MvpUniformBufferObject mvpUbo{};
+	PrecomputedMvpUniformObject& mvpUbo = frameMvpUniform;
 	mvpUbo.model = glm::rotate(glm::mat4(1.0f), duration * glm::radians(15.0f), glm::vec3(-1.0f, 1.0f, 1.0f))
 				* glm::rotate(glm::mat4(1.0f), duration * glm::radians(3.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 
-	mvpUbo.view = glm::lookAt(glm::vec3(0.0f, 0.0f, 3.5f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
-	mvpUbo.projection = glm::perspective(glm::radians(45.0f), m_WidgetWidth / (float)m_WidgetHeight, 0.1f, 100.0f);
+	// Dolly the camera between 3.5 and 40 units away, so the LOD chain gets exercised
+	float cameraDistance = 3.5f + 36.5f * (0.5f - 0.5f * std::cos(duration * glm::radians(2.0f)));
+	const float fovY = glm::radians(45.0f);
+	mvpUbo.view = glm::lookAt(glm::vec3(0.0f, 0.0f, cameraDistance), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	mvpUbo.projection = glm::perspective(fovY, m_WidgetWidth / (float)m_WidgetHeight, 0.1f, 100.0f);
 	mvpUbo.projection[1][1] *= -1;
 
-	void* data;
-	vkMapMemory(m_LogicalDevice, mvpUniformStagingBufferDeviceMemory, 0, sizeof(mvpUbo), 0, &data);
-	memcpy(data, &mvpUbo, sizeof(mvpUbo));
-	vkUnmapMemory(m_LogicalDevice, mvpUniformStagingBufferDeviceMemory);
+	// Once per frame here instead of proj * view * model for every vertex of the mesh
+	glm::mat4 modelView;
+	stfm::computeModelViewProjection(mvpUbo.projection, mvpUbo.view, mvpUbo.model, modelView, mvpUbo.modelViewProjection);
+
+	/****************************************************************************************************************************/
+	/**********   Pick the coarsest LOD whose error projects under lodPixelErrorThreshold at the nearest point of the bounds  ****/
+	/****************************************************************************************************************************/
+	glm::vec4 boundsCenterInView = modelView * glm::vec4(glm::vec3(modelBoundingSphere), 1.0f);
+	float distanceToCamera = (std::max)(glm::length(glm::vec3(boundsCenterInView)) - modelBoundingSphere.w, 0.1f);
+	uint32_t lodLevel = stobjl::selectLodLevel(lodLevelVector, distanceToCamera, fovY, static_cast<float>(m_WidgetHeight), lodPixelErrorThreshold);
+	if (lodLevel != selectedLodLevel) {
+		selectedLodLevel = lodLevel;
+		std::ostringstream stream;
+		stream << "LOD " << selectedLodLevel << " selected at distance " << distanceToCamera << ":  "
+			<< lodLevelVector[selectedLodLevel].indexCount / 3 << " of " << lodLevelVector[0].indexCount / 3 << " triangles\n";
+		std::cout << stream.str();
+	}
+	// frameMvpUniform reaches the GPU in updateSwapchainImageResources(), once the timeline value of the acquired image completed
 
-	SLVK_AbstractGLFW::transferResourceBuffer(m_DefaultThreadCommandPool, m_LogicalDevice, m_GraphicsQueue, mvpUniformStagingBuffer,
-		mvpOptimalUniformBuffer, sizeof(mvpUbo));
+	/****************************************************************************************************************************/
+	/**********   Average GPU time of the model draw, once per second, to compare both transform paths   ************************/
+	/****************************************************************************************************************************/
+	if (drawTimestampsCount > 0 && currentTime - drawTimingReportTime > std::chrono::seconds(1)) {
+		std::ostringstream stream;
+		stream << "Draw GPU time:  " << drawGpuMicrosecondsSum / drawTimestampsCount << " us over " << drawTimestampsCount << " frames,  "
+			<< (depthPrePassEnabled ? "depth pre-pass + EQUAL color pass, precomputed MVP"
+				: (threeMatrixMvpPathEnabled ? "single pass, proj * view * model per vertex" : "single pass, precomputed MVP"))
+			<< ",  LOD " << selectedLodLevel << " (" << lodLevelVector[selectedLodLevel].indexCount / 3 << " triangles),  M / P to switch\n";
+		std::cout << stream.str();
+
+		drawGpuMicrosecondsSum	= 0.0;
+		drawTimestampsCount		= 0;
+		drawTimingReportTime	= currentTime;
+	}
+}
+
+void Sen_222_TinyObjLoader::onKeyboardReaction(GLFWwindow* widget, int key, int scancode, int action, int mode)
+{
+	SLVK_AbstractGLFW::onKeyboardReaction(widget, key, scancode, action, mode);
+
+	// M: compare with the three-matrix multiply in the vertex shader, every swapchain image re-records after its own timeline value
+	if (key == GLFW_KEY_M && action == GLFW_PRESS) {
+		threeMatrixMvpPathEnabled = !threeMatrixMvpPathEnabled;
+		resourceGeneration++;
+		drawGpuMicrosecondsSum	= 0.0;
+		drawTimestampsCount		= 0;
+	}
+	// P: depth pre-pass + EQUAL color pass against the single pass, timed the same way from the first draw to the last
+	if (key == GLFW_KEY_P && action == GLFW_PRESS) {
+		depthPrePassEnabled = !depthPrePassEnabled;
+		resourceGeneration++;
+		drawGpuMicrosecondsSum	= 0.0;
+		drawTimestampsCount		= 0;
+	}
 }
 
 void Sen_222_TinyObjLoader::finalizeWidget()
 {	
+	streamingLoader.reset();	// joins the loader thread, waits for the uploads in flight
 	cleanUpDepthStencil();
+	singlePassGraph.reset();	// own the render passes, the framebuffers and the depth images
+	depthPrePassGraph.reset();
 
 	/************************************************************************************************************/
 	/*********************           Destroy Pipeline, PipelineLayout, and RenderPass         *******************/
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != tinyObjLoaderPipeline) {
 		vkDestroyPipeline(m_LogicalDevice, tinyObjLoaderPipeline, nullptr);
+		vkDestroyPipeline(m_LogicalDevice, threeMatrixMvpPipeline, nullptr);
+		vkDestroyPipeline(m_LogicalDevice, depthPrePassPipeline, nullptr);
+		vkDestroyPipeline(m_LogicalDevice, depthEqualPipeline, nullptr);
 		vkDestroyPipelineLayout(m_LogicalDevice, tinyObjLoaderPipelineLayout, nullptr);
-		vkDestroyRenderPass(m_LogicalDevice, depthTestRenderPass, nullptr);
 
 		tinyObjLoaderPipeline			= VK_NULL_HANDLE;
+		threeMatrixMvpPipeline			= VK_NULL_HANDLE;
+		depthPrePassPipeline			= VK_NULL_HANDLE;
+		depthEqualPipeline				= VK_NULL_HANDLE;
 		tinyObjLoaderPipelineLayout	= VK_NULL_HANDLE;
-		depthTestRenderPass			= VK_NULL_HANDLE;
 	}
 	/************************************************************************************************************/
 	/*************      Destroy m_DescriptorPool,  m_Default_DSL,  m_Default_DS      ****************************/
@@ -129,7 +247,7 @@ void Sen_222_TinyObjLoader::finalizeWidget()
 		if (VK_NULL_HANDLE != texture2DSampler)  
 			vkDestroySampler(m_LogicalDevice, texture2DSampler, nullptr);
 		if (VK_NULL_HANDLE != tinyObjCompleteImageDeviceMemory)
-			vkFreeMemory(m_LogicalDevice, tinyObjCompleteImageDeviceMemory, nullptr); 	// always try to destroy before free
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, tinyObjCompleteImageDeviceMemory); 	// always try to destroy before free
 
 		tinyObjCompleteImage				= VK_NULL_HANDLE;
 		tinyObjCompleteImageDeviceMemory	= VK_NULL_HANDLE;
@@ -137,22 +255,52 @@ void Sen_222_TinyObjLoader::finalizeWidget()
 		texture2DSampler					= VK_NULL_HANDLE;
 	}
 	/************************************************************************************************************/
-	/******************     Destroy VertexBuffer, VertexBufferMemory     ****************************************/
+	/******************     Free the arena ranges of the mesh drawn last     ************************************/
 	/************************************************************************************************************/
-	if (VK_NULL_HANDLE != tinyMeshLinkModelVertexBuffer) {
-		vkDestroyBuffer(m_LogicalDevice, tinyMeshLinkModelVertexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, tinyMeshLinkModelVertexBufferMemory, nullptr);	// always try to destroy before free
-
-		tinyMeshLinkModelVertexBuffer			= VK_NULL_HANDLE;
-		tinyMeshLinkModelVertexBufferMemory	= VK_NULL_HANDLE;
+	if (geometryArena) {
+		geometryArena->free(tinyMeshLinkModelVertexAllocation);
+		geometryArena->free(tinyMeshLinkModelIndexAllocation);
+		geometryArena->free(positionStreamAllocation);
 	}
-	if (VK_NULL_HANDLE != tinyMeshLinkModelIndexBuffer) {
-		vkDestroyBuffer(m_LogicalDevice, tinyMeshLinkModelIndexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, tinyMeshLinkModelIndexBufferMemory, nullptr);	// always try to destroy before free
-
-		tinyMeshLinkModelIndexBuffer = VK_NULL_HANDLE;
-		tinyMeshLinkModelIndexBufferMemory = VK_NULL_HANDLE;
+	if (VK_NULL_HANDLE != lodIndirectBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, lodIndirectBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, lodIndirectBufferMemory);	// implicitly unmaps lodIndirectBufferMappedData
+
+		lodIndirectBuffer				= VK_NULL_HANDLE;
+		lodIndirectBufferMemory			= VK_NULL_HANDLE;
+		lodIndirectBufferMappedData		= nullptr;
+		lodIndirectRegionsCount			= 0;
 	}
+	if (VK_NULL_HANDLE != mvpRegionsBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, mvpRegionsBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, mvpRegionsBufferMemory);	// implicitly unmaps mvpRegionsBufferMappedData
+
+		mvpRegionsBuffer				= VK_NULL_HANDLE;
+		mvpRegionsBufferMemory			= VK_NULL_HANDLE;
+		mvpRegionsBufferMappedData		= nullptr;
+		mvpRegionsCount					= 0;
+	}
+	if (VK_NULL_HANDLE != drawTimestampQueryPool) {
+		vkDestroyQueryPool(m_LogicalDevice, drawTimestampQueryPool, nullptr);
+		drawTimestampQueryPool = VK_NULL_HANDLE;
+	}
+	/************************************************************************************************************/
+	/***********     Destroy placeholders still waiting for retirement, and assets taken but never swapped in    */
+	/************************************************************************************************************/
+	swapchainImageGenerationVector.assign(swapchainImageGenerationVector.size(), resourceGeneration);	// device is idle here
+	destroyRetiredResources();
+	if (geometryArena) {
+		geometryArena->free(streamedMesh.vertexAllocation);
+		geometryArena->free(streamedMesh.indexAllocation);
+		streamedMesh = SenStreamingLoader::StreamedMeshStruct();
+	}
+	if (VK_NULL_HANDLE != streamedTexture.image) {
+		vkDestroyImageView(m_LogicalDevice, streamedTexture.imageView, nullptr);
+		vkDestroyImage(m_LogicalDevice, streamedTexture.image, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, streamedTexture.imageMemory);
+		streamedTexture = SenStreamingLoader::StreamedTextureStruct();
+	}
+	geometryArena.reset();		// every range is back, after the loader that allocates from it
 	OutputDebugString("\n\tFinish  Sen_222_TinyObjLoader::finalizeWidget()\n");
 }
 
@@ -163,9 +311,15 @@ void Sen_222_TinyObjLoader::createTinyObjLoaderPipeline()
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != tinyObjLoaderPipeline) {
 		vkDestroyPipeline(m_LogicalDevice, tinyObjLoaderPipeline, nullptr);
+		vkDestroyPipeline(m_LogicalDevice, threeMatrixMvpPipeline, nullptr);
+		vkDestroyPipeline(m_LogicalDevice, depthPrePassPipeline, nullptr);
+		vkDestroyPipeline(m_LogicalDevice, depthEqualPipeline, nullptr);
 		vkDestroyPipelineLayout(m_LogicalDevice, tinyObjLoaderPipelineLayout, nullptr);
 
 		tinyObjLoaderPipeline			= VK_NULL_HANDLE;
+		threeMatrixMvpPipeline			= VK_NULL_HANDLE;
+		depthPrePassPipeline			= VK_NULL_HANDLE;
+		depthEqualPipeline				= VK_NULL_HANDLE;
 		tinyObjLoaderPipelineLayout	= VK_NULL_HANDLE;
 	}
 
@@ -173,10 +327,12 @@ void Sen_222_TinyObjLoader::createTinyObjLoaderPipeline()
 	/**********                Reserve pipeline ShaderStage CreateInfos Array           *****************************************/
 	/********     Different shader or vertex layout    ==>>   entirely Recreate the graphics pipeline.    ***********************/
 	/*--------------------------------------------------------------------------------------------------------------------------*/
-	VkShaderModule vertShaderModule, fragShaderModule;
+	VkShaderModule vertShaderModule, threeMatrixVertShaderModule, fragShaderModule, depthPrePassVertShaderModule;
 
-	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/loadModelObj.vert", vertShaderModule);
+	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/loadModelObjMvp.vert", vertShaderModule);
+	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/loadModelObjThreeMatrix.vert", threeMatrixVertShaderModule);
 	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/loadModelObj.frag", fragShaderModule);
+	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/loadModelObjDepthPrePass.vert", depthPrePassVertShaderModule);
 
 	VkPipelineShaderStageCreateInfo vertPipelineShaderStageCreateInfo{};
 	vertPipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -194,47 +350,24 @@ void Sen_222_TinyObjLoader::createTinyObjLoaderPipeline()
 	pipelineShaderStagesCreateInfoVector.push_back(vertPipelineShaderStageCreateInfo);
 	pipelineShaderStagesCreateInfoVector.push_back(fragPipelineShaderStageCreateInfo);
 
+	// Same fixed-function state and layout, only the vertex shader differs
+	std::vector<VkPipelineShaderStageCreateInfo> threeMatrixShaderStagesCreateInfoVector(pipelineShaderStagesCreateInfoVector);
+	threeMatrixShaderStagesCreateInfoVector[0].module = threeMatrixVertShaderModule;
+
+	// Depth only:  no fragment shader, the rasterizer's depth is all the pre-pass writes
+	std::vector<VkPipelineShaderStageCreateInfo> depthPrePassShaderStagesCreateInfoVector;
+	depthPrePassShaderStagesCreateInfoVector.push_back(vertPipelineShaderStageCreateInfo);
+	depthPrePassShaderStagesCreateInfoVector[0].module = depthPrePassVertShaderModule;
+
 	/****************************************************************************************************************************/
 	/**********                Reserve pipeline Fixed-Function Stages CreateInfos           *************************************/
 	/****************************************************************************************************************************/
-	VkVertexInputBindingDescription vertexInputBindingDescription{};
-	vertexInputBindingDescription.binding	= 0;
-	vertexInputBindingDescription.stride	= sizeof(VertexStruct);
-	vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-	std::vector<VkVertexInputBindingDescription> vertexInputBindingDescriptionVector;
-	vertexInputBindingDescriptionVector.push_back(vertexInputBindingDescription);
-
-
-	std::vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptionVector;
-
-	VkVertexInputAttributeDescription positionVertexInputAttributeDescription;
-	positionVertexInputAttributeDescription.location	= 0;
-	positionVertexInputAttributeDescription.binding		= 0;
-	positionVertexInputAttributeDescription.format		= VK_FORMAT_R32G32B32_SFLOAT;
-	positionVertexInputAttributeDescription.offset		= 0;
-	vertexInputAttributeDescriptionVector.push_back(positionVertexInputAttributeDescription);
-
-	//VkVertexInputAttributeDescription colorVertexInputAttributeDescription;
-	//colorVertexInputAttributeDescription.location		= 1;
-	//colorVertexInputAttributeDescription.binding		= 0;
-	//colorVertexInputAttributeDescription.format			= VK_FORMAT_R32G32B32_SFLOAT;
-	//colorVertexInputAttributeDescription.offset			= 3 * sizeof(float);
-	//vertexInputAttributeDescriptionVector.push_back(colorVertexInputAttributeDescription);
-
-	VkVertexInputAttributeDescription texCoordVertexInputAttributeDescription;
-	texCoordVertexInputAttributeDescription.location	= 1;
-	texCoordVertexInputAttributeDescription.binding		= 0;
-	texCoordVertexInputAttributeDescription.format		= VK_FORMAT_R32G32_SFLOAT;
-	texCoordVertexInputAttributeDescription.offset		= 3 * sizeof(float);
-	vertexInputAttributeDescriptionVector.push_back(texCoordVertexInputAttributeDescription);
-
+	// Vertex pulling:  no bindings, no attributes;  the vertex shaders read the geometry arena with gl_VertexIndex,
+	// the depth pre-pass its tightly packed position stream, the other pipelines the interleaved VertexStruct
 	VkPipelineVertexInputStateCreateInfo pipelineVertexInputStateCreateInfo{};
-	pipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-	pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount	= vertexInputBindingDescriptionVector.size();// spacing between data && whether the data is per-vertex or per-instance (geometry instancing)
-	pipelineVertexInputStateCreateInfo.pVertexBindingDescriptions		= vertexInputBindingDescriptionVector.data();
-	pipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount	= vertexInputAttributeDescriptionVector.size();
-	pipelineVertexInputStateCreateInfo.pVertexAttributeDescriptions		= vertexInputAttributeDescriptionVector.data();
-
+	pipelineVertexInputStateCreateInfo.sType							= VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount	= 0;
+	pipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount	= 0;
 
 	VkPipelineInputAssemblyStateCreateInfo pipelineInputAssemblyStateCreateInfo{};
 	pipelineInputAssemblyStateCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
@@ -299,6 +432,11 @@ void Sen_222_TinyObjLoader::createTinyObjLoaderPipeline()
 	pipelineColorBlendStateCreateInfo.blendConstants[2] = 0.0f;
 	pipelineColorBlendStateCreateInfo.blendConstants[3] = 0.0f;
 
+	VkPipelineColorBlendStateCreateInfo depthOnlyColorBlendStateCreateInfo{};	// the pre-pass has no color attachment
+	depthOnlyColorBlendStateCreateInfo.sType			= VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	depthOnlyColorBlendStateCreateInfo.logicOpEnable	= VK_FALSE;
+	depthOnlyColorBlendStateCreateInfo.attachmentCount	= 0;
+
 	/*********************************************************************************************/
 	/*********************************************************************************************/
 	VkPipelineDepthStencilStateCreateInfo pipelineDepthStencilStateCreateInfo{};
@@ -309,6 +447,11 @@ void Sen_222_TinyObjLoader::createTinyObjLoaderPipeline()
 	pipelineDepthStencilStateCreateInfo.depthBoundsTestEnable	= VK_FALSE;
 	pipelineDepthStencilStateCreateInfo.stencilTestEnable		= VK_FALSE;
 
+	// After the pre-pass only the nearest fragment of each pixel passes, and the depth is already final
+	VkPipelineDepthStencilStateCreateInfo depthEqualStencilStateCreateInfo(pipelineDepthStencilStateCreateInfo);
+	depthEqualStencilStateCreateInfo.depthWriteEnable			= VK_FALSE;
+	depthEqualStencilStateCreateInfo.depthCompareOp				= VK_COMPARE_OP_EQUAL;
+
 	/*********************************************************************************************/
 	/*********************************************************************************************/
 	std::vector<VkDynamicState> dynamicStateEnablesVector;
@@ -353,102 +496,244 @@ void Sen_222_TinyObjLoader::createTinyObjLoaderPipeline()
 	depthTestPipelineCreateInfo.pColorBlendState	= &pipelineColorBlendStateCreateInfo;
 	depthTestPipelineCreateInfo.pDepthStencilState	= &pipelineDepthStencilStateCreateInfo;
 	depthTestPipelineCreateInfo.layout				= tinyObjLoaderPipelineLayout;
-	depthTestPipelineCreateInfo.renderPass			= depthTestRenderPass;
-	depthTestPipelineCreateInfo.subpass				= 0;	// index of this tinyObjLoaderPipeline's subpass of the depthTestRenderPass
+	depthTestPipelineCreateInfo.renderPass			= singlePassGraph->renderPass(modelPassIndex);
+	depthTestPipelineCreateInfo.subpass				= 0;	// index of this tinyObjLoaderPipeline's subpass of the model pass
 															//depthTestPipelineCreateInfo.basePipelineHandle	= VK_NULL_HANDLE;
 
 	depthTestGraphicsPipelineCreateInfoVector.push_back(depthTestPipelineCreateInfo);
+	depthTestPipelineCreateInfo.stageCount			= (uint32_t)threeMatrixShaderStagesCreateInfoVector.size();
+	depthTestPipelineCreateInfo.pStages				= threeMatrixShaderStagesCreateInfoVector.data();
+	depthTestGraphicsPipelineCreateInfoVector.push_back(depthTestPipelineCreateInfo);
+
+	// Color pass of the pre-pass graph:  precomputed MVP only, the three-matrix product would not match the pre-pass depth
+	depthTestPipelineCreateInfo.stageCount			= (uint32_t)pipelineShaderStagesCreateInfoVector.size();
+	depthTestPipelineCreateInfo.pStages				= pipelineShaderStagesCreateInfoVector.data();
+	depthTestPipelineCreateInfo.pDepthStencilState	= &depthEqualStencilStateCreateInfo;
+	depthTestPipelineCreateInfo.renderPass			= depthPrePassGraph->renderPass(prePassModelPassIndex);
+	depthTestGraphicsPipelineCreateInfoVector.push_back(depthTestPipelineCreateInfo);
+
+	depthTestPipelineCreateInfo.stageCount			= (uint32_t)depthPrePassShaderStagesCreateInfoVector.size();
+	depthTestPipelineCreateInfo.pStages				= depthPrePassShaderStagesCreateInfoVector.data();
+	depthTestPipelineCreateInfo.pColorBlendState	= &depthOnlyColorBlendStateCreateInfo;
+	depthTestPipelineCreateInfo.pDepthStencilState	= &pipelineDepthStencilStateCreateInfo;
+	depthTestPipelineCreateInfo.renderPass			= depthPrePassGraph->renderPass(depthPrePassIndex);
+	depthTestGraphicsPipelineCreateInfoVector.push_back(depthTestPipelineCreateInfo);
 
+	std::array<VkPipeline, 4> pipelineArray{};
 	SLVK_AbstractGLFW::errorCheck(
 		vkCreateGraphicsPipelines(
 			m_LogicalDevice, VK_NULL_HANDLE,
 			(uint32_t)depthTestGraphicsPipelineCreateInfoVector.size(),
 			depthTestGraphicsPipelineCreateInfoVector.data(),
 			nullptr,
-			&tinyObjLoaderPipeline), // could be a pipelineArray
+			pipelineArray.data()),
 		std::string("Failed to create graphics pipeline !!!")
 	);
+	tinyObjLoaderPipeline	= pipelineArray[0];
+	threeMatrixMvpPipeline	= pipelineArray[1];
+	depthEqualPipeline		= pipelineArray[2];
+	depthPrePassPipeline	= pipelineArray[3];
 
 	vkDestroyShaderModule(m_LogicalDevice, vertShaderModule, nullptr);
+	vkDestroyShaderModule(m_LogicalDevice, threeMatrixVertShaderModule, nullptr);
 	vkDestroyShaderModule(m_LogicalDevice, fragShaderModule, nullptr);
+	vkDestroyShaderModule(m_LogicalDevice, depthPrePassVertShaderModule, nullptr);
+}
+
+void Sen_222_TinyObjLoader::createGeometryArena()
+{
+	// The whole arena is one storage buffer descriptor, so it cannot outgrow maxStorageBufferRange
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(m_PhysicalDevice, &physicalDeviceProperties);
+	const VkDeviceSize arenaBytes = (std::min)(m_GeometryArenaBytes, (VkDeviceSize)physicalDeviceProperties.limits.maxStorageBufferRange);
+
+	geometryArena.reset(new SenGeometryArena(m_LogicalDevice, m_PhysicalDeviceMemoryProperties, arenaBytes));
 }
 
 void Sen_222_TinyObjLoader::createMeshLinkModelndexBuffer()
 {
 	VkDeviceSize indicesBufferSize = sizeof(indexVector[0]) * indexVector.size();
+	tinyMeshLinkModelIndexAllocation = geometryArena->allocate((uint32_t)indexVector.size(), sizeof(indexVector[0]));
 
-	/****************************************************************************************************************************************************/
-	/***************   Create temporary stagingBuffer to transfer from to get Optimal Buffer Resource   *************************************************/
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferDeviceMemory;
-	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indicesBufferSize,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
-		stagingBuffer, stagingBufferDeviceMemory, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	// Chunked through the staging ring when larger than a ring chunk, batched with the vertex upload
+	stagingRing->uploadToBuffer(indexVector.data(), indicesBufferSize, geometryArena->buffer(), tinyMeshLinkModelIndexAllocation.byteOffset);
+}
 
-	void* data;
-	vkMapMemory(m_LogicalDevice, stagingBufferDeviceMemory, 0, indicesBufferSize, 0, &data);
-	memcpy(data, indexVector.data(), indicesBufferSize);
-	//// The driver may not immediately copy the data into the buffer memory, for example because of caching. 
-	//// There are two ways to deal with that problem, and what we use is the first one below:
-	////  1. Use a memory heap that is host coherent, indicated with VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-	////  2. Call vkFlushMappedMemoryRanges to after writing to the mapped memory, and call vkInvalidateMappedMemoryRanges before reading from the mapped memory
-	vkUnmapMemory(m_LogicalDevice, stagingBufferDeviceMemory);
+void Sen_222_TinyObjLoader::createMeshLinkModeVertexBuffer()
+{
+	VkDeviceSize verticesBufferSize = sizeof(vertexStructVector[0]) * vertexStructVector.size();
+	tinyMeshLinkModelVertexAllocation = geometryArena->allocate((uint32_t)vertexStructVector.size(), sizeof(vertexStructVector[0]));
 
-	/****************************************************************************************************************************************************/
-	/***************   Transfer from stagingBuffer to Optimal triangleVertexBuffer   ********************************************************************/
-	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indicesBufferSize,
-		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
-		tinyMeshLinkModelIndexBuffer, tinyMeshLinkModelIndexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+	stagingRing->uploadToBuffer(vertexStructVector.data(), verticesBufferSize, geometryArena->buffer(), tinyMeshLinkModelVertexAllocation.byteOffset);
+}
 
-	SLVK_AbstractGLFW::transferResourceBuffer(m_DefaultThreadCommandPool, m_LogicalDevice, m_GraphicsQueue, stagingBuffer,
-		tinyMeshLinkModelIndexBuffer, indicesBufferSize);
+void Sen_222_TinyObjLoader::createPositionStreamBuffer()
+{
+	std::vector<glm::vec3> positionVector;
+	positionVector.reserve(vertexStructVector.size());
+	for (const auto& vertexStruct : vertexStructVector)
+		positionVector.push_back(vertexStruct.position);
+	VkDeviceSize positionsBufferSize = sizeof(positionVector[0]) * positionVector.size();
+	positionStreamAllocation = geometryArena->allocate((uint32_t)positionVector.size(), sizeof(positionVector[0]));
+
+	// Flushed with this frame's uploads, before any commandBuffer drawing from it is submitted
+	stagingRing->uploadToBuffer(positionVector.data(), positionsBufferSize, geometryArena->buffer(), positionStreamAllocation.byteOffset);
+}
+
+void Sen_222_TinyObjLoader::initPlaceholderTextureImage()
+{
+	// 1x1 opaque grey texel, sampled by the placeholder cube until the streamed texture is resident
+	const uint8_t placeholderTexel[4] = { 160, 160, 160, 255 };
+	tinyObjCompleteTextureWidth		= 1;
+	tinyObjCompleteTextureHeight	= 1;
+
+	SLVK_AbstractGLFW::createResourceImage(m_LogicalDevice, 1, 1, VK_IMAGE_TYPE_2D,
+		VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, tinyObjCompleteImage
+		, tinyObjCompleteImageDeviceMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties, 1);
+
+	VkImageSubresourceRange textureImageSubresourceRange{};
+	textureImageSubresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	textureImageSubresourceRange.baseMipLevel	= 0;
+	textureImageSubresourceRange.levelCount		= 1;
+	textureImageSubresourceRange.baseArrayLayer	= 0;
+	textureImageSubresourceRange.layerCount		= 1;
+
+	// Transitions and copy go out with the vertex and index uploads above, as one batch of the staging ring
+	VkBufferImageCopy bufferImageCopyRegion{};
+	bufferImageCopyRegion.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	bufferImageCopyRegion.imageSubresource.layerCount		= 1;
+	bufferImageCopyRegion.imageExtent						= { 1, 1, 1 };
+	stagingRing->transitionImageLayout(tinyObjCompleteImage, textureImageSubresourceRange, VK_IMAGE_LAYOUT_PREINITIALIZED,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+	stagingRing->uploadToImage(placeholderTexel, tinyObjCompleteImage, VK_FORMAT_R8G8B8A8_UNORM, bufferImageCopyRegion);
+	stagingRing->transitionImageLayout(tinyObjCompleteImage, textureImageSubresourceRange, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+	VkImageViewCreateInfo textureImageViewCreateInfo{};
+	textureImageViewCreateInfo.sType			= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	textureImageViewCreateInfo.image			= tinyObjCompleteImage;
+	textureImageViewCreateInfo.viewType			= VK_IMAGE_VIEW_TYPE_2D;
+	textureImageViewCreateInfo.format			= VK_FORMAT_R8G8B8A8_UNORM;
+	textureImageViewCreateInfo.subresourceRange = textureImageSubresourceRange;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateImageView(m_LogicalDevice, &textureImageViewCreateInfo, nullptr, &tinyObjCompleteImageView),
+		std::string("Failed to create placeholder Image View !!!")
+	);
 
-	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
 }
 
-void Sen_222_TinyObjLoader::createMeshLinkModeVertexBuffer()
+void Sen_222_TinyObjLoader::createPlaceholderCubeMesh()
 {
-	VkDeviceSize verticesBufferSize = sizeof(vertexStructVector[0]) * vertexStructVector.size();
+	// Unit cube, counter-clockwise faces seen from outside; a single LOD level
+	vertexStructVector.clear();
+	for (uint32_t corner = 0; corner < 8; corner++) {
+		VertexStruct vertexStruct{};
+		vertexStruct.position = glm::vec3((corner == 1 || corner == 2 || corner == 5 || corner == 6) ? 0.5f : -0.5f,
+			(corner == 2 || corner == 3 || corner == 6 || corner == 7) ? 0.5f : -0.5f, corner >= 4 ? 0.5f : -0.5f);
+		vertexStruct.texCoord = glm::vec2(vertexStruct.position.x + 0.5f, vertexStruct.position.y + 0.5f);
+		vertexStructVector.push_back(vertexStruct);
+	}
+	indexVector = {
+		4, 5, 6, 6, 7, 4,		// +z
+		1, 0, 3, 3, 2, 1,		// -z
+		5, 1, 2, 2, 6, 5,		// +x
+		0, 4, 7, 7, 3, 0,		// -x
+		7, 6, 2, 2, 3, 7,		// +y
+		0, 1, 5, 5, 4, 0		// -y
+	};
+
+	LodLevelStruct fullLevel{};
+	fullLevel.firstIndex		= 0;
+	fullLevel.indexCount		= (uint32_t)indexVector.size();
+	fullLevel.objectSpaceError	= 0.0f;
+	lodLevelVector.assign(1, fullLevel);
+	selectedLodLevel = 0;
+}
 
-	/****************************************************************************************************************************************************/
-	/***************   Create temporary stagingBuffer to transfer from to get Optimal Buffer Resource   *************************************************/
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferDeviceMemory;
-	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, verticesBufferSize,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
-		stagingBuffer, stagingBufferDeviceMemory, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-	void* data;
-	vkMapMemory(m_LogicalDevice, stagingBufferDeviceMemory, 0, verticesBufferSize, 0, &data);
-	memcpy(data, vertexStructVector.data(), verticesBufferSize);
-	// The driver may not immediately copy the data into the buffer memory, for example because of caching. 
-	// There are two ways to deal with that problem, and what we use is the first one below:
-	//  1. Use a memory heap that is host coherent, indicated with VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-	//  2. Call vkFlushMappedMemoryRanges to after writing to the mapped memory, and call vkInvalidateMappedMemoryRanges before reading from the mapped memory
-	vkUnmapMemory(m_LogicalDevice, stagingBufferDeviceMemory);
-
-	/****************************************************************************************************************************************************/
-	/***************   Transfer from stagingBuffer to Optimal tinyMeshLinkModelVertexBuffer   ********************************************************************/
-	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, verticesBufferSize,
-		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
-		tinyMeshLinkModelVertexBuffer, tinyMeshLinkModelVertexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-
-	SLVK_AbstractGLFW::transferResourceBuffer(m_DefaultThreadCommandPool, m_LogicalDevice, m_GraphicsQueue, stagingBuffer,
-		tinyMeshLinkModelVertexBuffer, verticesBufferSize);
-
-	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
-}
-
-void Sen_222_TinyObjLoader::initTinyObjCompleteTextureImage()
+void Sen_222_TinyObjLoader::computeModelBoundingSphere()
 {
-	SLVK_AbstractGLFW::createDeviceLocalTexture(m_LogicalDevice, m_PhysicalDeviceMemoryProperties
-		, tinyObjCompleteTextureDiskAddress, VK_IMAGE_TYPE_2D, tinyObjCompleteTextureWidth, tinyObjCompleteTextureHeight
-		, tinyObjCompleteImage, tinyObjCompleteImageDeviceMemory, tinyObjCompleteImageView
-		, VK_SHARING_MODE_EXCLUSIVE, m_DefaultThreadCommandPool, m_GraphicsQueue);
+	glm::vec3 boundsMin = vertexStructVector[0].position, boundsMax = vertexStructVector[0].position;
+	for (const auto& vertexStruct : vertexStructVector) {
+		boundsMin = glm::min(boundsMin, vertexStruct.position);
+		boundsMax = glm::max(boundsMax, vertexStruct.position);
+	}
+	modelBoundingSphere = glm::vec4((boundsMin + boundsMax) * 0.5f, glm::length(boundsMax - boundsMin) * 0.5f);
+}
 
-	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
+void Sen_222_TinyObjLoader::swapInStreamedAssets()
+{
+	if (!streamedMeshTaken)		streamedMeshTaken		= streamingLoader->takeMesh(streamedMeshAssetId, streamedMesh);
+	if (!streamedTextureTaken)	streamedTextureTaken	= streamingLoader->takeTexture(streamedTextureAssetId, streamedTexture);
+	if (!streamedMeshTaken || !streamedTextureTaken) return;
+
+	/****************************************************************************************************************************/
+	/**********   Placeholders are retired, not destroyed: swapchain images still in flight keep drawing them   ****************/
+	/****************************************************************************************************************************/
+	retiredVertexAllocation				= tinyMeshLinkModelVertexAllocation;
+	retiredIndexAllocation				= tinyMeshLinkModelIndexAllocation;
+	retiredPositionAllocation			= positionStreamAllocation;
+	retiredImage						= tinyObjCompleteImage;
+	retiredImageDeviceMemory			= tinyObjCompleteImageDeviceMemory;
+	retiredImageView					= tinyObjCompleteImageView;
+
+	tinyMeshLinkModelVertexAllocation	= streamedMesh.vertexAllocation;	// ranges of the arena the loader filled
+	tinyMeshLinkModelIndexAllocation	= streamedMesh.indexAllocation;
+	vertexStructVector					= std::move(streamedMesh.vertexStructVector);
+	indexVector							= std::move(streamedMesh.indexVector);
+	lodLevelVector						= std::move(streamedMesh.lodLevelVector);
+	selectedLodLevel					= 0;
+	streamedMesh						= SenStreamingLoader::StreamedMeshStruct();
+	createPositionStreamBuffer();		// the loader builds the interleaved stream only
+
+	tinyObjCompleteImage				= streamedTexture.image;
+	tinyObjCompleteImageDeviceMemory	= streamedTexture.imageMemory;
+	tinyObjCompleteImageView			= streamedTexture.imageView;
+	tinyObjCompleteTextureWidth			= streamedTexture.width;
+	tinyObjCompleteTextureHeight		= streamedTexture.height;
+	streamedTexture						= SenStreamingLoader::StreamedTextureStruct();
+
+	// streamedTexture_DS is not recorded in any commandBuffer yet, safe to write now
+	writeTextureAppDescriptorSet(streamedTexture_DS, tinyObjCompleteImageView);
+	activeTexture_DS = streamedTexture_DS;
+
+	computeModelBoundingSphere();
+	resourceGeneration++;
+	streamedAssetsSwappedIn = true;
+
+	std::ostringstream stream;
+	stream << "Streamed assets swapped in after " << std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::high_resolution_clock::now() - streamingStartTime).count() << " ms\n";
+	for (size_t level = 0; level < lodLevelVector.size(); level++) {
+		stream << "\t LOD " << level << ":  " << lodLevelVector[level].indexCount / 3 << " triangles,  object space error = "
+			<< lodLevelVector[level].objectSpaceError << "\n";
+	}
+	stream << "\t geometry arena:  " << geometryArena->usedBytes() / 1024 << " KB of " << geometryArena->capacity() / 1024
+		<< " KB in use, placeholder cube included until retired\n";
+	std::cout << stream.str();
+}
+
+void Sen_222_TinyObjLoader::destroyRetiredResources()
+{
+	for (const auto& swapchainImageGeneration : swapchainImageGenerationVector)
+		if (swapchainImageGeneration != resourceGeneration) return;
+
+	// Back to the arena for later meshes, free() resets the allocations
+	if (geometryArena) {
+		geometryArena->free(retiredVertexAllocation);
+		geometryArena->free(retiredIndexAllocation);
+		geometryArena->free(retiredPositionAllocation);
+	}
+	if (VK_NULL_HANDLE != retiredImage) {
+		vkDestroyImageView(m_LogicalDevice, retiredImageView, nullptr);
+		vkDestroyImage(m_LogicalDevice, retiredImage, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, retiredImageDeviceMemory);	// always try to destroy before free
+
+		retiredImage				= VK_NULL_HANDLE;
+		retiredImageDeviceMemory	= VK_NULL_HANDLE;
+		retiredImageView			= VK_NULL_HANDLE;
+	}
 }
 
 void Sen_222_TinyObjLoader::createTextureAppDescriptorPool()
@@ -456,20 +741,25 @@ void Sen_222_TinyObjLoader::createTextureAppDescriptorPool()
 	std::vector<VkDescriptorPoolSize> descriptorPoolSizeVector;
 
 	VkDescriptorPoolSize uniformBufferDescriptorPoolSize{};
-	uniformBufferDescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	uniformBufferDescriptorPoolSize.descriptorCount = 1;
+	uniformBufferDescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	uniformBufferDescriptorPoolSize.descriptorCount = 2;	// placeholder + streamed set
 	descriptorPoolSizeVector.push_back(uniformBufferDescriptorPoolSize);
 
+	VkDescriptorPoolSize storageBufferDescriptorPoolSize{};
+	storageBufferDescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	storageBufferDescriptorPoolSize.descriptorCount = 2;	// the geometry arena, in both sets
+	descriptorPoolSizeVector.push_back(storageBufferDescriptorPoolSize);
+
 	VkDescriptorPoolSize combinedImageSamplerDescriptorPoolSize{};
 	combinedImageSamplerDescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	combinedImageSamplerDescriptorPoolSize.descriptorCount = 1;
+	combinedImageSamplerDescriptorPoolSize.descriptorCount = 2;
 	descriptorPoolSizeVector.push_back(combinedImageSamplerDescriptorPoolSize);
 
 	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
 	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
 	descriptorPoolCreateInfo.poolSizeCount = descriptorPoolSizeVector.size();
 	descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizeVector.data();
-	descriptorPoolCreateInfo.maxSets = 1; // Need a new descriptorSetVector
+	descriptorPoolCreateInfo.maxSets = 2; // m_Default_DS, streamedTexture_DS
 
 	SLVK_AbstractGLFW::errorCheck(
 		vkCreateDescriptorPool(m_LogicalDevice, &descriptorPoolCreateInfo, nullptr, &m_DescriptorPool),
@@ -484,11 +774,19 @@ void Sen_222_TinyObjLoader::createTextureAppDescriptorSetLayout()
 	VkDescriptorSetLayoutBinding mvpUboDSL_Binding{};
 	mvpUboDSL_Binding.binding				= m_UniformBuffer_DS_BindingIndex;
 	mvpUboDSL_Binding.descriptorCount		= 1;
-	mvpUboDSL_Binding.descriptorType		= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	mvpUboDSL_Binding.descriptorType		= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;	// offset picks the swapchain image's region
 	mvpUboDSL_Binding.pImmutableSamplers	= nullptr;
 	mvpUboDSL_Binding.stageFlags			= VK_SHADER_STAGE_VERTEX_BIT;
 	perspectiveProjectionDSL_BindingVector.push_back(mvpUboDSL_Binding);
 
+	VkDescriptorSetLayoutBinding geometryArenaDSL_Binding{};
+	geometryArenaDSL_Binding.binding			= m_GeometryArena_DS_BindingIndex;
+	geometryArenaDSL_Binding.descriptorCount	= 1;
+	geometryArenaDSL_Binding.descriptorType		= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;	// vertices pulled with gl_VertexIndex
+	geometryArenaDSL_Binding.pImmutableSamplers	= nullptr;
+	geometryArenaDSL_Binding.stageFlags			= VK_SHADER_STAGE_VERTEX_BIT;
+	perspectiveProjectionDSL_BindingVector.push_back(geometryArenaDSL_Binding);
+
 	VkDescriptorSetLayoutBinding combinedImageSamplerDSL_Binding{};
 	combinedImageSamplerDSL_Binding.binding				= m_COMB_IMA_SAMPLER_DS_BindingIndex;
 	combinedImageSamplerDSL_Binding.descriptorCount		= 1;
@@ -512,43 +810,67 @@ void Sen_222_TinyObjLoader::createTextureAppDescriptorSet()
 {
 	std::vector<VkDescriptorSetLayout> descriptorSetLayoutVector;
 	descriptorSetLayoutVector.push_back(m_Default_DSL);
+	descriptorSetLayoutVector.push_back(m_Default_DSL);
 	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
 	descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 	descriptorSetAllocateInfo.descriptorPool		= m_DescriptorPool;
 	descriptorSetAllocateInfo.descriptorSetCount	= descriptorSetLayoutVector.size();
 	descriptorSetAllocateInfo.pSetLayouts			= descriptorSetLayoutVector.data();
 
+	std::array<VkDescriptorSet, 2> descriptorSetArray{};
 	SLVK_AbstractGLFW::errorCheck(
-		vkAllocateDescriptorSets(m_LogicalDevice, &descriptorSetAllocateInfo, &m_Default_DS),
+		vkAllocateDescriptorSets(m_LogicalDevice, &descriptorSetAllocateInfo, descriptorSetArray.data()),
 		std::string("Fail to Allocate m_Default_DS !")
 	);
+	m_Default_DS		= descriptorSetArray[0];
+	streamedTexture_DS	= descriptorSetArray[1];
+	activeTexture_DS	= m_Default_DS;
+
+	writeTextureAppDescriptorSet(m_Default_DS, tinyObjCompleteImageView);
+}
+
+void Sen_222_TinyObjLoader::writeTextureAppDescriptorSet(const VkDescriptorSet& descriptorSetToWrite, const VkImageView& textureImageView)
+{
 	/**********************************************************************************************************************/
 	/**********************************************************************************************************************/
 	VkDescriptorBufferInfo mvpDescriptorBufferInfo{};
-	mvpDescriptorBufferInfo.buffer	= mvpOptimalUniformBuffer;
-	mvpDescriptorBufferInfo.offset	= 0;
-	mvpDescriptorBufferInfo.range	= sizeof(MvpUniformBufferObject);
+	mvpDescriptorBufferInfo.buffer	= mvpRegionsBuffer;
+	mvpDescriptorBufferInfo.offset	= 0;	// + dynamic offset at bind time
+	mvpDescriptorBufferInfo.range	= sizeof(PrecomputedMvpUniformObject);
 	std::vector<VkDescriptorBufferInfo> descriptorBufferInfoVector;
 	descriptorBufferInfoVector.push_back(mvpDescriptorBufferInfo);
 	VkWriteDescriptorSet uniformBuffer_DS_Write{};
 	uniformBuffer_DS_Write.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-	uniformBuffer_DS_Write.descriptorType	= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-	uniformBuffer_DS_Write.dstSet			= m_Default_DS;
+	uniformBuffer_DS_Write.descriptorType	= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	uniformBuffer_DS_Write.dstSet			= descriptorSetToWrite;
 	uniformBuffer_DS_Write.dstBinding		= m_UniformBuffer_DS_BindingIndex;	// binding number, same with the binding index  in shader
 	uniformBuffer_DS_Write.dstArrayElement	= 0;	// start from the index dstArrayElement of pBufferInfo (descriptorBufferInfoVector)
 	uniformBuffer_DS_Write.descriptorCount	= descriptorBufferInfoVector.size();// the total number of descriptors to update in pBufferInfo
 	uniformBuffer_DS_Write.pBufferInfo		= descriptorBufferInfoVector.data();
 	/**********************************************************************************************************************/
+	VkDescriptorBufferInfo geometryArenaDescriptorBufferInfo{};
+	geometryArenaDescriptorBufferInfo.buffer	= geometryArena->buffer();
+	geometryArenaDescriptorBufferInfo.offset	= 0;	// every mesh, told apart by the draw's vertexOffset
+	geometryArenaDescriptorBufferInfo.range		= VK_WHOLE_SIZE;
+	VkWriteDescriptorSet geometryArena_DS_Write{};
+	geometryArena_DS_Write.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	geometryArena_DS_Write.descriptorType	= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	geometryArena_DS_Write.dstSet			= descriptorSetToWrite;
+	geometryArena_DS_Write.dstBinding		= m_GeometryArena_DS_BindingIndex;
+	geometryArena_DS_Write.dstArrayElement	= 0;
+	geometryArena_DS_Write.descriptorCount	= 1;
+	geometryArena_DS_Write.pBufferInfo		= &geometryArenaDescriptorBufferInfo;
+	/**********************************************************************************************************************/
 	VkDescriptorImageInfo backgroundTextureDescriptorImageInfo{};
 	backgroundTextureDescriptorImageInfo.imageLayout	= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-	backgroundTextureDescriptorImageInfo.imageView		= tinyObjCompleteImageView;
+	backgroundTextureDescriptorImageInfo.imageView		= textureImageView;
 	backgroundTextureDescriptorImageInfo.sampler		= texture2DSampler;
 	std::vector<VkDescriptorImageInfo> descriptorImageInfoVector;
 	descriptorImageInfoVector.push_back(backgroundTextureDescriptorImageInfo);
 	VkWriteDescriptorSet combinedImageSampler_DS_Write{};
 	combinedImageSampler_DS_Write.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 	combinedImageSampler_DS_Write.descriptorType	= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-	combinedImageSampler_DS_Write.dstSet			= m_Default_DS;
+	combinedImageSampler_DS_Write.dstSet			= descriptorSetToWrite;
 	combinedImageSampler_DS_Write.dstBinding		= m_COMB_IMA_SAMPLER_DS_BindingIndex; // binding number, same with the binding index  in shader
 	combinedImageSampler_DS_Write.dstArrayElement	= 0;	// start from the index dstArrayElement of pBufferInfo (descriptorBufferInfoVector)
 	combinedImageSampler_DS_Write.descriptorCount	= descriptorImageInfoVector.size();// the total number of descriptors to update in pBufferInfo
@@ -556,6 +878,7 @@ void Sen_222_TinyObjLoader::createTextureAppDescriptorSet()
 
 	std::vector<VkWriteDescriptorSet> DS_Write_Vector;
 	DS_Write_Vector.push_back(uniformBuffer_DS_Write);
+	DS_Write_Vector.push_back(geometryArena_DS_Write);
 	DS_Write_Vector.push_back(combinedImageSampler_DS_Write);
 
 	vkUpdateDescriptorSets(m_LogicalDevice, DS_Write_Vector.size(), DS_Write_Vector.data(), 0, nullptr);
@@ -585,62 +908,241 @@ void Sen_222_TinyObjLoader::createTinyObjLoaderCommandBuffers()
 		std::string("Failed to allocate Swapchain commandBuffers !!!")
 	);
 
+	for (uint32_t i = 0; i < m_SwapchainCommandBufferVector.size(); i++)
+		recordTinyObjLoaderCommandBuffer(i);
+
+	swapchainImageGenerationVector.assign(m_SwapchainCommandBufferVector.size(), resourceGeneration);
+	destroyRetiredResources();
+}
+
+void Sen_222_TinyObjLoader::recordTinyObjLoaderCommandBuffer(const uint32_t& swapchainImageIndex)
+{
 	/****************************************************************************************************************************/
 	/**********           Record Triangle Swapchain CommandBuffers        *******************************************************/
 	/****************************************************************************************************************************/
-	for (size_t i = 0; i < m_SwapchainCommandBufferVector.size(); i++) {
-		//======================================================================================
-		//======================================================================================
-		VkCommandBufferBeginInfo commandBufferBeginInfo{};
-		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		vkBeginCommandBuffer(m_SwapchainCommandBufferVector[i], &commandBufferBeginInfo);
-
-		//======================================================================================
-		//======================================================================================
-		VkRenderPassBeginInfo renderPassBeginInfo{};
-		renderPassBeginInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-		renderPassBeginInfo.renderPass			= depthTestRenderPass;
-		renderPassBeginInfo.framebuffer			= m_SwapchainFramebufferVector[i];
-		renderPassBeginInfo.renderArea.offset	= { 0, 0 };
-		renderPassBeginInfo.renderArea.extent.width		= m_WidgetWidth;
-		renderPassBeginInfo.renderArea.extent.height	= m_WidgetHeight;
-
-		// Because we now have both color & depth attachments with VK_ATTACHMENT_LOAD_OP_CLEAR, we also need to specify multiple clear values. 
-		std::array<VkClearValue, 2> clearValueArray{};
-		clearValueArray[0].color		= { 0.2f, 0.3f, 0.3f, 1.0f };
-		clearValueArray[1].depthStencil = { 1.0f, 0 };
-		renderPassBeginInfo.clearValueCount = (uint32_t)clearValueArray.size();
-		renderPassBeginInfo.pClearValues	= clearValueArray.data();
-
-		vkCmdBeginRenderPass(m_SwapchainCommandBufferVector[i], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
-
-		//======================================================================================
-		//======================================================================================
-		vkCmdBindPipeline(m_SwapchainCommandBufferVector[i], VK_PIPELINE_BIND_POINT_GRAPHICS, tinyObjLoaderPipeline);
-		VkDeviceSize offsetDeviceSize = 0;
-		vkCmdBindVertexBuffers(m_SwapchainCommandBufferVector[i], 0, 1, &tinyMeshLinkModelVertexBuffer, &offsetDeviceSize);
-		vkCmdBindIndexBuffer(m_SwapchainCommandBufferVector[i], tinyMeshLinkModelIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
-		vkCmdBindDescriptorSets(m_SwapchainCommandBufferVector[i], VK_PIPELINE_BIND_POINT_GRAPHICS,
-			tinyObjLoaderPipelineLayout, 0, 1, &m_Default_DS, 0, nullptr);
-
-		//vkCmdDraw(
-		//	m_SwapchainCommandBufferVector[i],
-		//	3, // vertexCount
-		//	1, // instanceCount
-		//	0, // firstVertex
-		//	0  // firstInstance
-		//);
-		vkCmdSetViewport(m_SwapchainCommandBufferVector[i], 0, 1, &m_SwapchainResize_Viewport);
-		vkCmdSetScissor(m_SwapchainCommandBufferVector[i], 0, 1, &m_SwapchainResize_ScissorRect2D);
-
-		//vkCmdDrawIndexed(m_SwapchainCommandBufferVector[i], 6*6, 1, 0, 0, 0);
-		vkCmdDrawIndexed(m_SwapchainCommandBufferVector[i], static_cast<uint32_t>(indexVector.size()), 1, 0, 0, 0);
-
-		vkCmdEndRenderPass(m_SwapchainCommandBufferVector[i]);
-
-		SLVK_AbstractGLFW::errorCheck(
-			vkEndCommandBuffer(m_SwapchainCommandBufferVector[i]),
-			std::string("Failed to end record of Triangle Swapchain commandBuffers !!!")
-		);
+	//======================================================================================
+	//======================================================================================
+	VkCommandBufferBeginInfo commandBufferBeginInfo{};
+	commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	vkBeginCommandBuffer(m_SwapchainCommandBufferVector[swapchainImageIndex], &commandBufferBeginInfo);
+
+	// Queries have to be reset outside of a render pass
+	if (VK_NULL_HANDLE != drawTimestampQueryPool)
+		vkCmdResetQueryPool(m_SwapchainCommandBufferVector[swapchainImageIndex], drawTimestampQueryPool, 2 * swapchainImageIndex, 2);
+
+	// Render passes, clears and layout transitions come from the graph, the draws from recordDepthPrePass() / recordModelPass()
+	const SenRenderGraph& activeRenderGraph = depthPrePassEnabled ? *depthPrePassGraph : *singlePassGraph;
+	activeRenderGraph.record(m_SwapchainCommandBufferVector[swapchainImageIndex], swapchainImageIndex);
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkEndCommandBuffer(m_SwapchainCommandBufferVector[swapchainImageIndex]),
+		std::string("Failed to end record of Triangle Swapchain commandBuffers !!!")
+	);
+}
+
+void Sen_222_TinyObjLoader::recordDepthPrePass(const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex)
+{
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, depthPrePassPipeline);
+	vkCmdBindIndexBuffer(commandBuffer, geometryArena->buffer(), 0, VK_INDEX_TYPE_UINT32);	// positions are pulled through the arena binding of activeTexture_DS
+	uint32_t mvpDynamicOffset = static_cast<uint32_t>(swapchainImageIndex * mvpRegionStride);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+		tinyObjLoaderPipelineLayout, 0, 1, &activeTexture_DS, 1, &mvpDynamicOffset);
+	vkCmdSetViewport(commandBuffer, 0, 1, &m_SwapchainResize_Viewport);
+	vkCmdSetScissor(commandBuffer, 0, 1, &m_SwapchainResize_ScissorRect2D);
+
+	// The measured span starts here in pre-pass mode, so both modes are timed over all of their draws
+	if (VK_NULL_HANDLE != drawTimestampQueryPool)
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, drawTimestampQueryPool, 2 * swapchainImageIndex);
+	// Same LOD as the color pass, written with it:  EQUAL needs the same triangles;  only vertexOffset differs
+	vkCmdDrawIndexedIndirect(commandBuffer, lodIndirectBuffer,
+		(2 * swapchainImageIndex + 1) * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+}
+
+void Sen_222_TinyObjLoader::recordModelPass(const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex,
+	const VkPipeline& modelPipeline, const bool& writeStartTimestamp)
+{
+	//======================================================================================
+	//======================================================================================
+	vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, modelPipeline);
+	// The whole arena as index buffer, firstIndex of the indirect command points at this mesh's indices;
+	// no vertex buffer, the vertex shader pulls from the arena through the storage buffer binding of the set
+	vkCmdBindIndexBuffer(commandBuffer, geometryArena->buffer(), 0, VK_INDEX_TYPE_UINT32);
+	// Each swapchain image reads the transform region its updateSwapchainImageResources() wrote
+	uint32_t mvpDynamicOffset = static_cast<uint32_t>(swapchainImageIndex * mvpRegionStride);
+	vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS,
+		tinyObjLoaderPipelineLayout, 0, 1, &activeTexture_DS, 1, &mvpDynamicOffset);
+
+	//vkCmdDraw(
+	//	commandBuffer,
+	//	3, // vertexCount
+	//	1, // instanceCount
+	//	0, // firstVertex
+	//	0  // firstInstance
+	//);
+	vkCmdSetViewport(commandBuffer, 0, 1, &m_SwapchainResize_Viewport);
+	vkCmdSetScissor(commandBuffer, 0, 1, &m_SwapchainResize_ScissorRect2D);
+
+	//vkCmdDrawIndexed(commandBuffer, 6*6, 1, 0, 0, 0);
+	if (VK_NULL_HANDLE != drawTimestampQueryPool && writeStartTimestamp)
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+			drawTimestampQueryPool, 2 * swapchainImageIndex);
+	// firstIndex & indexCount of the selected LOD are read from the indirect region of this swapchain image
+	vkCmdDrawIndexedIndirect(commandBuffer, lodIndirectBuffer,
+		2 * swapchainImageIndex * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+	if (VK_NULL_HANDLE != drawTimestampQueryPool)
+		vkCmdWriteTimestamp(commandBuffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			drawTimestampQueryPool, 2 * swapchainImageIndex + 1);
+}
+
+void Sen_222_TinyObjLoader::createLodIndirectBuffer()
+{
+	/************************************************************************************************************/
+	/*********     Destroy old lodIndirectBuffer first if the swapchain images count changed     ****************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != lodIndirectBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, lodIndirectBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, lodIndirectBufferMemory);	// implicitly unmaps lodIndirectBufferMappedData
+
+		lodIndirectBuffer				= VK_NULL_HANDLE;
+		lodIndirectBufferMemory			= VK_NULL_HANDLE;
+		lodIndirectBufferMappedData		= nullptr;
+	}
+
+	lodIndirectRegionsCount = m_SwapChain_ImagesCount;
+	SLVK_AbstractGLFW::createPersistentMappedBuffer(m_LogicalDevice, 2 * sizeof(VkDrawIndexedIndirectCommand) * lodIndirectRegionsCount,
+		VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		lodIndirectBuffer, lodIndirectBufferMemory, lodIndirectBufferMappedData);
+
+	for (uint32_t i = 0; i < lodIndirectRegionsCount; i++)
+		updateSwapchainImageResources(i);
+}
+
+void Sen_222_TinyObjLoader::createMvpRegionsBuffer()
+{
+	/************************************************************************************************************/
+	/*********     Destroy old mvpRegionsBuffer first if the swapchain images count changed     *****************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != mvpRegionsBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, mvpRegionsBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, mvpRegionsBufferMemory);	// implicitly unmaps mvpRegionsBufferMappedData
+
+		mvpRegionsBuffer				= VK_NULL_HANDLE;
+		mvpRegionsBufferMemory			= VK_NULL_HANDLE;
+		mvpRegionsBufferMappedData		= nullptr;
+	}
+
+	// Dynamic offsets have to be multiples of minUniformBufferOffsetAlignment (a power of two)
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(m_PhysicalDevice, &physicalDeviceProperties);
+	const VkDeviceSize offsetAlignment = (std::max)(physicalDeviceProperties.limits.minUniformBufferOffsetAlignment, VkDeviceSize(1));
+	mvpRegionStride = (sizeof(PrecomputedMvpUniformObject) + offsetAlignment - 1) & ~(offsetAlignment - 1);
+
+	mvpRegionsCount = m_SwapChain_ImagesCount;
+	SLVK_AbstractGLFW::createPersistentMappedBuffer(m_LogicalDevice, mvpRegionStride * mvpRegionsCount,
+		VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		mvpRegionsBuffer, mvpRegionsBufferMemory, mvpRegionsBufferMappedData);
+
+	for (uint32_t i = 0; i < mvpRegionsCount; i++)
+		memcpy(static_cast<uint8_t*>(mvpRegionsBufferMappedData) + i * mvpRegionStride, &frameMvpUniform, sizeof(frameMvpUniform));
+
+	/****************************************************************************************************************************/
+	/**********   Recreated for a new swapchain images count:  point the sets at the new buffer, the device is idle here   *******/
+	/****************************************************************************************************************************/
+	if (VK_NULL_HANDLE == m_Default_DS) return;
+
+	VkDescriptorBufferInfo mvpDescriptorBufferInfo{};
+	mvpDescriptorBufferInfo.buffer	= mvpRegionsBuffer;
+	mvpDescriptorBufferInfo.offset	= 0;
+	mvpDescriptorBufferInfo.range	= sizeof(PrecomputedMvpUniformObject);
+
+	std::vector<VkWriteDescriptorSet> DS_Write_Vector;
+	for (const VkDescriptorSet& descriptorSetToWrite : { m_Default_DS, streamedTexture_DS }) {
+		VkWriteDescriptorSet uniformBuffer_DS_Write{};
+		uniformBuffer_DS_Write.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		uniformBuffer_DS_Write.descriptorType	= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		uniformBuffer_DS_Write.dstSet			= descriptorSetToWrite;
+		uniformBuffer_DS_Write.dstBinding		= m_UniformBuffer_DS_BindingIndex;
+		uniformBuffer_DS_Write.dstArrayElement	= 0;
+		uniformBuffer_DS_Write.descriptorCount	= 1;
+		uniformBuffer_DS_Write.pBufferInfo		= &mvpDescriptorBufferInfo;
+		DS_Write_Vector.push_back(uniformBuffer_DS_Write);
 	}
+	vkUpdateDescriptorSets(m_LogicalDevice, DS_Write_Vector.size(), DS_Write_Vector.data(), 0, nullptr);
+}
+
+void Sen_222_TinyObjLoader::createDrawTimestampQueryPool()
+{
+	if (VK_NULL_HANDLE != drawTimestampQueryPool) {
+		vkDestroyQueryPool(m_LogicalDevice, drawTimestampQueryPool, nullptr);
+		drawTimestampQueryPool = VK_NULL_HANDLE;
+	}
+	drawTimestampPendingVector.assign(m_SwapChain_ImagesCount, false);
+
+	// Timestamps are optional on the graphics queue family:  no queries, no report
+	uint32_t queueFamiliesCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &queueFamiliesCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilyPropertiesVector(queueFamiliesCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &queueFamiliesCount, queueFamilyPropertiesVector.data());
+	const uint32_t timestampValidBits = queueFamilyPropertiesVector[graphicsQueueFamilyIndex].timestampValidBits;
+	if (0 == timestampValidBits) {
+		std::cout << "Graphics queue family has no timestamps, draw GPU time is not reported\n";
+		return;
+	}
+	timestampValidMask = (timestampValidBits >= 64) ? ~0ull : ((1ull << timestampValidBits) - 1);
+
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(m_PhysicalDevice, &physicalDeviceProperties);
+	timestampPeriodNanoseconds = physicalDeviceProperties.limits.timestampPeriod;
+
+	VkQueryPoolCreateInfo queryPoolCreateInfo{};
+	queryPoolCreateInfo.sType		= VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+	queryPoolCreateInfo.queryType	= VK_QUERY_TYPE_TIMESTAMP;
+	queryPoolCreateInfo.queryCount	= 2 * m_SwapChain_ImagesCount;	// before and after the draw, per swapchain image
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateQueryPool(m_LogicalDevice, &queryPoolCreateInfo, nullptr, &drawTimestampQueryPool),
+		std::string("Failed to create draw timestamp Query Pool !!!")
+	);
+}
+
+void Sen_222_TinyObjLoader::updateSwapchainImageResources(const uint32_t& swapchainImageIndex)
+{
+	// The last submission of this image completed:  its timestamps are available, before a re-record resets them
+	if (VK_NULL_HANDLE != drawTimestampQueryPool && swapchainImageIndex < drawTimestampPendingVector.size()) {
+		if (drawTimestampPendingVector[swapchainImageIndex]) {
+			std::array<uint64_t, 2> drawTimestampArray{};
+			if (VK_SUCCESS == vkGetQueryPoolResults(m_LogicalDevice, drawTimestampQueryPool, 2 * swapchainImageIndex, 2,
+				sizeof(drawTimestampArray), drawTimestampArray.data(), sizeof(uint64_t), VK_QUERY_RESULT_64_BIT)) {
+				uint64_t drawTicks = (drawTimestampArray[1] - drawTimestampArray[0]) & timestampValidMask;
+				drawGpuMicrosecondsSum += drawTicks * timestampPeriodNanoseconds / 1000.0;
+				drawTimestampsCount++;
+			}
+		}
+		drawTimestampPendingVector[swapchainImageIndex] = true;	// submitted right after this call
+	}
+
+	if (nullptr != mvpRegionsBufferMappedData && swapchainImageIndex < mvpRegionsCount)
+		memcpy(static_cast<uint8_t*>(mvpRegionsBufferMappedData) + swapchainImageIndex * mvpRegionStride, &frameMvpUniform, sizeof(frameMvpUniform));
+
+	// Re-record this image's commandBuffer once its timeline value completed, if the resources it draws changed since
+	if (swapchainImageIndex < swapchainImageGenerationVector.size() && swapchainImageGenerationVector[swapchainImageIndex] != resourceGeneration) {
+		recordTinyObjLoaderCommandBuffer(swapchainImageIndex);
+		swapchainImageGenerationVector[swapchainImageIndex] = resourceGeneration;
+		destroyRetiredResources();
+	}
+
+	if (nullptr == lodIndirectBufferMappedData || swapchainImageIndex >= lodIndirectRegionsCount) return;
+
+	// Arena element offsets:  indices of the mesh, then its interleaved vertices or its position stream
+	std::array<VkDrawIndexedIndirectCommand, 2> drawIndexedIndirectCommandArray{};
+	drawIndexedIndirectCommandArray[0].indexCount		= lodLevelVector[selectedLodLevel].indexCount;
+	drawIndexedIndirectCommandArray[0].instanceCount	= 1;
+	drawIndexedIndirectCommandArray[0].firstIndex		= tinyMeshLinkModelIndexAllocation.firstElement() + lodLevelVector[selectedLodLevel].firstIndex;
+	drawIndexedIndirectCommandArray[0].vertexOffset		= static_cast<int32_t>(tinyMeshLinkModelVertexAllocation.firstElement());
+	drawIndexedIndirectCommandArray[0].firstInstance	= 0;
+	drawIndexedIndirectCommandArray[1]					= drawIndexedIndirectCommandArray[0];
+	drawIndexedIndirectCommandArray[1].vertexOffset		= static_cast<int32_t>(positionStreamAllocation.firstElement());
+
+	memcpy(static_cast<VkDrawIndexedIndirectCommand*>(lodIndirectBufferMappedData) + 2 * swapchainImageIndex,
+		drawIndexedIndirectCommandArray.data(), sizeof(drawIndexedIndirectCommandArray));
 }
@@ -5,6 +5,12 @@
 
 #include "../Support/SLVK_AbstractGLFW.h"
 #include "../Support/SenTinyObjLoader.h"
+#include "../Support/SenStreamingLoader.h"
+#include "../Support/SenTransformMath.h"
+#include "../Support/SenRenderGraph.h"
+#include "../Support/SenGeometryArena.h"
+
+#include <memory>
 
 class Sen_222_TinyObjLoader :	public SLVK_AbstractGLFW
 {
@@ -13,23 +19,42 @@ public:
 	virtual ~Sen_222_TinyObjLoader();
 
 protected:
+	void prefetchStartupAssets();
 	void initVulkanApplication();
 	void reCreateRenderTarget(); // for resize window
 	void finalizeWidget();
 
 	void cleanUpDepthStencil();
 	void updateUniformBuffer();
+	void updateSwapchainImageResources(const uint32_t& swapchainImageIndex);
+	void onKeyboardReaction(GLFWwindow* widget, int key, int scancode, int action, int mode);
 
 private:
+	void createGeometryArena();
 	void createMeshLinkModelndexBuffer();
 	void createMeshLinkModeVertexBuffer();
 	void createTinyObjLoaderCommandBuffers();
+	void recordTinyObjLoaderCommandBuffer(const uint32_t& swapchainImageIndex);
+	void recordModelPass(const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex,
+		const VkPipeline& modelPipeline, const bool& writeStartTimestamp);
+	void recordDepthPrePass(const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex);
+	void createRenderGraphs();
+	void createPositionStreamBuffer();
+	void createLodIndirectBuffer();
+	void computeModelBoundingSphere();
+	void createMvpRegionsBuffer();
+	void createDrawTimestampQueryPool();
+
+	void createPlaceholderCubeMesh();
+	void initPlaceholderTextureImage();
+	void swapInStreamedAssets();
+	void destroyRetiredResources();
 
-	void initTinyObjCompleteTextureImage();
 	void createTinyObjLoaderPipeline();
 	void createTextureAppDescriptorPool();
 	void createTextureAppDescriptorSetLayout();
 	void createTextureAppDescriptorSet();
+	void writeTextureAppDescriptorSet(const VkDescriptorSet& descriptorSetToWrite, const VkImageView& textureImageView);
 
 	/*****************************************************************************************************************/
 	/*------------------------     For Resources Descrition       ---------------------------------------------------*/
@@ -37,8 +62,11 @@ private:
 	/* uniform values need to be specified during pipeline creation by creating a VkPipelineLayout object */
 	VkDescriptorPool				m_DescriptorPool					= VK_NULL_HANDLE;
 	VkDescriptorSetLayout			m_Default_DSL						= VK_NULL_HANDLE;
-	VkDescriptorSet					m_Default_DS						= VK_NULL_HANDLE;
+	VkDescriptorSet					m_Default_DS						= VK_NULL_HANDLE;	// placeholder texture
+	VkDescriptorSet					streamedTexture_DS					= VK_NULL_HANDLE;	// written once the streamed texture is resident
+	VkDescriptorSet					activeTexture_DS					= VK_NULL_HANDLE;
 
+	const int						m_GeometryArena_DS_BindingIndex		= 1;	// storage buffer the vertex shaders pull from
 	const int						m_COMB_IMA_SAMPLER_DS_BindingIndex	= 3;
 	VkImage							tinyObjCompleteImage				= VK_NULL_HANDLE;
 	VkDeviceMemory					tinyObjCompleteImageDeviceMemory	= VK_NULL_HANDLE;
@@ -46,21 +74,103 @@ private:
 	VkSampler						texture2DSampler					= VK_NULL_HANDLE;
 
 
-	VkBuffer						tinyMeshLinkModelVertexBuffer		= VK_NULL_HANDLE;
-	VkDeviceMemory					tinyMeshLinkModelVertexBufferMemory	= VK_NULL_HANDLE;
-	VkBuffer						tinyMeshLinkModelIndexBuffer		= VK_NULL_HANDLE;
-	VkDeviceMemory					tinyMeshLinkModelIndexBufferMemory	= VK_NULL_HANDLE;
+	// Placeholder cube and streamed model alike live in one arena, bound once as index buffer and vertex storage buffer;
+	// the draws tell them apart by firstIndex / vertexOffset
+	std::unique_ptr<SenGeometryArena>	geometryArena;
+	const VkDeviceSize				m_GeometryArenaBytes				= 64 * 1024 * 1024;	// capped to maxStorageBufferRange
+	SenGeometryArena::AllocationStruct	tinyMeshLinkModelVertexAllocation;
+	SenGeometryArena::AllocationStruct	tinyMeshLinkModelIndexAllocation;
+	SenGeometryArena::AllocationStruct	positionStreamAllocation;		// positions only, for the depth pre-pass
 
-	VkPipeline						tinyObjLoaderPipeline				= VK_NULL_HANDLE;
+	VkPipeline						tinyObjLoaderPipeline				= VK_NULL_HANDLE;	// precomputed MVP, one mat4 * vec4 per vertex
+	VkPipeline						threeMatrixMvpPipeline				= VK_NULL_HANDLE;	// proj * view * model per vertex, for comparison
+	bool							threeMatrixMvpPathEnabled			= false;
+	VkPipeline						depthPrePassPipeline				= VK_NULL_HANDLE;	// positions only, depth LESS + write
+	VkPipeline						depthEqualPipeline					= VK_NULL_HANDLE;	// shades after the pre-pass, depth EQUAL, no write
+	bool							depthPrePassEnabled					= false;
 
 	VkPipelineLayout				tinyObjLoaderPipelineLayout			= VK_NULL_HANDLE;
 
+	// Swapchain + depth, one "model" pass;  or a "depthPrePass" then the "model" pass reading its depth.
+	// Own the render passes the pipelines are created against, both keep their targets for P to switch at once
+	std::unique_ptr<SenRenderGraph>	singlePassGraph;
+	std::unique_ptr<SenRenderGraph>	depthPrePassGraph;
+	uint32_t						modelPassIndex						= 0;
+	uint32_t						depthPrePassIndex					= 0;
+	uint32_t						prePassModelPassIndex				= 0;
+
 	int tinyObjCompleteTextureWidth, tinyObjCompleteTextureHeight;
 	const char* tinyObjCompleteTextureDiskAddress;
 	const char* tinyObjectDiskAddress;
 
 	std::vector<VertexStruct>	vertexStructVector;
-	std::vector<uint32_t>		indexVector;
+	std::vector<uint32_t>		indexVector;	// all LOD levels back to back, sharing vertexStructVector
+
+	/*****************************************************************************************************************/
+	/*-----------   LOD chain, selected per frame from projected screen-space error   --------------------------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	std::vector<LodLevelStruct>		lodLevelVector;
+	uint32_t						selectedLodLevel					= 0;
+	float							lodPixelErrorThreshold				= 1.0f;
+	glm::vec4						modelBoundingSphere;	// xyz: center, w: radius, in model space
+
+	// Two VkDrawIndexedIndirectCommand per swapchain image, rewritten after the fence of that image signaled:
+	// the model draw, then the depth pre-pass draw, whose vertexOffset points at the position stream instead
+	VkBuffer						lodIndirectBuffer					= VK_NULL_HANDLE;
+	VkDeviceMemory					lodIndirectBufferMemory				= VK_NULL_HANDLE;
+	void*							lodIndirectBufferMappedData			= nullptr;
+	uint32_t						lodIndirectRegionsCount				= 0;
+
+	/*****************************************************************************************************************/
+	/*-----------   Transforms multiplied once per frame on the CPU, one uniform region per swapchain image   --------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	// std140 layout of binding m_UniformBuffer_DS_BindingIndex, bound with a dynamic offset of swapchainImageIndex * mvpRegionStride
+	struct PrecomputedMvpUniformObject {
+		glm::mat4 model					= glm::mat4(1.0f);	// model, view, projection:  read by the three-matrix path only
+		glm::mat4 view					= glm::mat4(1.0f);
+		glm::mat4 projection			= glm::mat4(1.0f);
+		glm::mat4 modelViewProjection	= glm::mat4(1.0f);
+	};
+	PrecomputedMvpUniformObject		frameMvpUniform;	// written by updateUniformBuffer(), copied to a region after that image's fence
+	VkBuffer						mvpRegionsBuffer					= VK_NULL_HANDLE;
+	VkDeviceMemory					mvpRegionsBufferMemory				= VK_NULL_HANDLE;
+	void*							mvpRegionsBufferMappedData			= nullptr;
+	VkDeviceSize					mvpRegionStride						= 0;	// rounded up to minUniformBufferOffsetAlignment
+	uint32_t						mvpRegionsCount						= 0;
+
+	// Two timestamps around the draw per swapchain image, read back after the fence of that image signaled
+	VkQueryPool						drawTimestampQueryPool				= VK_NULL_HANDLE;	// stays null without graphics queue timestamps
+	float							timestampPeriodNanoseconds			= 1.0f;
+	uint64_t						timestampValidMask					= ~0ull;
+	std::vector<bool>				drawTimestampPendingVector;
+	double							drawGpuMicrosecondsSum				= 0.0;
+	uint32_t						drawTimestampsCount					= 0;
+	std::chrono::high_resolution_clock::time_point	drawTimingReportTime;
+
+	/*****************************************************************************************************************/
+	/*-----------   Streaming:  draw a placeholder cube until the model and texture are resident   -------------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	std::unique_ptr<SenStreamingLoader>	streamingLoader;
+	uint32_t						streamedMeshAssetId					= 0;
+	uint32_t						streamedTextureAssetId				= 0;
+	SenStreamingLoader::StreamedMeshStruct		streamedMesh;
+	SenStreamingLoader::StreamedTextureStruct	streamedTexture;
+	bool							streamedMeshTaken					= false;
+	bool							streamedTextureTaken				= false;
+	bool							streamedAssetsSwappedIn				= false;
+	const VkDeviceSize				m_StreamingUploadByteBudget			= 8 * 1024 * 1024;	// per frame
+	std::chrono::high_resolution_clock::time_point	streamingStartTime;
+
+	// Each swapchain commandBuffer is re-recorded after its own fence once resourceGeneration moves on,
+	// the placeholder resources are destroyed when no swapchain image records them anymore
+	uint32_t						resourceGeneration					= 0;
+	std::vector<uint32_t>			swapchainImageGenerationVector;
+	SenGeometryArena::AllocationStruct	retiredVertexAllocation;
+	SenGeometryArena::AllocationStruct	retiredIndexAllocation;
+	SenGeometryArena::AllocationStruct	retiredPositionAllocation;
+	VkImage							retiredImage						= VK_NULL_HANDLE;
+	VkDeviceMemory					retiredImageDeviceMemory			= VK_NULL_HANDLE;
+	VkImageView						retiredImageView					= VK_NULL_HANDLE;
 };
 
 
@@ -0,0 +1,698 @@
+
+#include "Sen_223_Instancing.h"
+
+Sen_223_Instancing::Sen_223_Instancing()
+{
+	std::cout << "Constructor: Sen_223_Instancing()\n\n";
+	strWindowName = "Sen Vulkan Instancing Tutorial";
+
+	instancingTextureDiskAddress	= "../Images/SunRaise.jpg";
+	instancedObjectDiskAddress		= nullptr;
+	//instancingTextureDiskAddress	= "../Images/MeshLinkModels/Chalet/chalet.jpg";
+	//instancedObjectDiskAddress	= "../Images/MeshLinkModels/Chalet/chalet.obj";
+}
+
+Sen_223_Instancing::~Sen_223_Instancing()
+{
+	finalizeWidget();
+
+	OutputDebugString("\n\t ~Sen_223_Instancing()\n");
+}
+
+void Sen_223_Instancing::prefetchStartupAssets()
+{
+	prefetchShader("SenVulkanTutorial/Shaders/instancing.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/loadModelObj.frag");
+	prefetchTexture(instancingTextureDiskAddress);
+}
+
+void Sen_223_Instancing::initVulkanApplication()
+{
+	createTextureAppDescriptorSetLayout();
+	createDefaultCommandPool();
+
+	initInstancingTextureImage();
+	createMvpUniformRegionsBuffer();		// has to be called after createSwapchain() for the correct m_SwapChain_ImagesCount
+	createTextureAppDescriptorPool();
+	createTextureAppDescriptorSet();
+
+	/***************************************/
+	createDepthTestAttachment();			// has to be called after createDefaultCommandPool();
+	createDepthTestRenderPass();			// has to be called after createDepthTestAttachment() for depthTestFormat
+	createInstancingPipeline();
+
+	createDepthTestSwapchainFramebuffers(); // has to be called after createDepthTestAttachment() for the depthTestImageView
+
+	populateInstancedMesh();
+	createInstancedMeshVertexBuffer();
+	createInstancedMeshIndexBuffer();
+	createInstanceBuffer();					// has to be called after createSwapchain() for the correct m_SwapChain_ImagesCount
+	/***************************************/
+
+	createInstancingCommandBuffers();
+
+	throughputReportTime = std::chrono::high_resolution_clock::now();
+	std::cout << "\n Finish  Sen_223_Instancing::initVulkanApplication()\n";
+}
+
+void Sen_223_Instancing::reCreateRenderTarget()
+{
+	createDepthTestAttachment();
+	createDepthTestSwapchainFramebuffers();
+	if (instanceBufferRegionsCount != m_SwapChain_ImagesCount)
+		createInstanceBuffer();
+	if (mvpUniformRegionsCount != m_SwapChain_ImagesCount) {
+		createMvpUniformRegionsBuffer();
+		writeMvpUniformRegionsDescriptor(m_Default_DS);	// the device is idle here
+	}
+	createInstancingCommandBuffers();
+}
+
+void Sen_223_Instancing::cleanUpDepthStencil()
+{
+	if (VK_NULL_HANDLE != depthTestImage) {
+		vkDestroyImage(m_LogicalDevice, depthTestImage, nullptr);
+		if (VK_NULL_HANDLE != depthTestImageView)
+			vkDestroyImageView(m_LogicalDevice, depthTestImageView, nullptr);
+		if (VK_NULL_HANDLE != depthTestImageDeviceMemory)
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, depthTestImageDeviceMemory); 	// always try to destroy before free
+
+		depthTestImage = VK_NULL_HANDLE;
+		depthTestImageView = VK_NULL_HANDLE;
+		depthTestImageDeviceMemory = VK_NULL_HANDLE;
+	}
+}
+
+void Sen_223_Instancing::updateUniformBuffer() {
+	static auto startTime = std::chrono::high_resolution_clock::now();
+	auto currentTime = std::chrono::high_resolution_clock::now();
+	float duration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - startTime).count() / 220.0f;
+	instanceAnimationTime = duration;
+
+	frameMvpUniform.model = glm::rotate(glm::mat4(1.0f), duration * glm::radians(1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	frameMvpUniform.view = glm::lookAt(glm::vec3(0.0f, 90.0f, 200.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	frameMvpUniform.projection = glm::perspective(glm::radians(45.0f), m_WidgetWidth / (float)m_WidgetHeight, 0.1f, 1000.0f);
+	frameMvpUniform.projection[1][1] *= -1;
+	// Uploaded into the region of the acquired swapchain image by updateSwapchainImageResources()
+
+	/****************************************************************************************************************************/
+	/**********           Report frame / instance / triangle throughput once per second          ********************************/
+	/****************************************************************************************************************************/
+	double reportSeconds = std::chrono::duration<double>(currentTime - throughputReportTime).count();
+	if (reportSeconds >= 1.0 && throughputFramesCount > 0) {
+		double framesPerSecond = throughputFramesCount / reportSeconds;
+		std::ostringstream stream;
+		stream << "Instancing:  " << instanceCount << " instances x " << indexVector.size() / 3 << " triangles"
+			<< "\t FPS = " << framesPerSecond
+			<< "\t Instances/s = " << framesPerSecond * instanceCount
+			<< "\t Triangles/s = " << framesPerSecond * instanceCount * (indexVector.size() / 3)
+			<< "\t Instance update = " << instanceUpdateMillisecondsSum / throughputFramesCount << " ms/frame\n";
+		std::cout << stream.str();
+
+		throughputReportTime			= currentTime;
+		throughputFramesCount			= 0;
+		instanceUpdateMillisecondsSum	= 0.0;
+	}
+}
+
+void Sen_223_Instancing::updateSwapchainImageResources(const uint32_t& swapchainImageIndex)
+{
+	// Through the staging ring into this image's own region:  no host wait, and no frame in flight reads the region being written
+	uploadMvpUniformRegion(frameMvpUniform, swapchainImageIndex);
+
+	if (nullptr == instanceBufferMappedData || swapchainImageIndex >= instanceBufferRegionsCount) return;
+
+	auto updateStartTime = std::chrono::high_resolution_clock::now();
+	/****************************************************************************************************************************/
+	/**********   Write straight into the mapped region of this swapchain image, no staging copy, no map/unmap    ***************/
+	/****************************************************************************************************************************/
+	InstanceStruct* instanceRegion = reinterpret_cast<InstanceStruct*>(
+		static_cast<char*>(instanceBufferMappedData) + swapchainImageIndex * instanceBufferRegionSize);
+
+	const glm::vec3 rotationAxis = glm::normalize(glm::vec3(-1.0f, 1.0f, 1.0f));
+	for (uint32_t i = 0; i < instanceCount; i++) {
+		const glm::vec4& originPhase = instanceOriginPhaseVector[i];
+		instanceRegion[i].model = glm::rotate(glm::translate(glm::mat4(1.0f), glm::vec3(originPhase)),
+			instanceAnimationTime * glm::radians(15.0f) + originPhase.w, rotationAxis);
+	}
+
+	instanceUpdateMillisecondsSum += std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - updateStartTime).count();
+	throughputFramesCount++;
+}
+
+void Sen_223_Instancing::finalizeWidget()
+{
+	cleanUpDepthStencil();
+
+	/************************************************************************************************************/
+	/*********************           Destroy Pipeline, PipelineLayout, and RenderPass         *******************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != instancingPipeline) {
+		vkDestroyPipeline(m_LogicalDevice, instancingPipeline, nullptr);
+		vkDestroyPipelineLayout(m_LogicalDevice, instancingPipelineLayout, nullptr);
+		vkDestroyRenderPass(m_LogicalDevice, depthTestRenderPass, nullptr);
+
+		instancingPipeline			= VK_NULL_HANDLE;
+		instancingPipelineLayout	= VK_NULL_HANDLE;
+		depthTestRenderPass			= VK_NULL_HANDLE;
+	}
+	/************************************************************************************************************/
+	/*************      Destroy m_DescriptorPool,  m_Default_DSL,  m_Default_DS      ****************************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != m_DescriptorPool) {
+		vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr);
+		// When a DescriptorPool is destroyed, all descriptor sets allocated from the pool are implicitly freed and become invalid
+		vkDestroyDescriptorSetLayout(m_LogicalDevice, m_Default_DSL, nullptr);
+
+		m_Default_DSL		= VK_NULL_HANDLE;
+		m_DescriptorPool	= VK_NULL_HANDLE;
+		m_Default_DS		= VK_NULL_HANDLE;
+	}
+	/************************************************************************************************************/
+	/******************           Destroy Memory, ImageView, Image          *************************************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != instancingTextureImage) {
+		vkDestroyImage(m_LogicalDevice, instancingTextureImage, nullptr);
+		if (VK_NULL_HANDLE != instancingTextureImageView)
+			vkDestroyImageView(m_LogicalDevice, instancingTextureImageView, nullptr);
+		if (VK_NULL_HANDLE != texture2DSampler)
+			vkDestroySampler(m_LogicalDevice, texture2DSampler, nullptr);
+		if (VK_NULL_HANDLE != instancingTextureImageDeviceMemory)
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, instancingTextureImageDeviceMemory); 	// always try to destroy before free
+
+		instancingTextureImage				= VK_NULL_HANDLE;
+		instancingTextureImageDeviceMemory	= VK_NULL_HANDLE;
+		instancingTextureImageView			= VK_NULL_HANDLE;
+		texture2DSampler					= VK_NULL_HANDLE;
+	}
+	/************************************************************************************************************/
+	/******************     Destroy VertexBuffer, IndexBuffer, InstanceBuffer and their Memory     **************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != instancedMeshVertexBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, instancedMeshVertexBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, instancedMeshVertexBufferMemory);	// always try to destroy before free
+
+		instancedMeshVertexBuffer		= VK_NULL_HANDLE;
+		instancedMeshVertexBufferMemory	= VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != instancedMeshIndexBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, instancedMeshIndexBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, instancedMeshIndexBufferMemory);	// always try to destroy before free
+
+		instancedMeshIndexBuffer		= VK_NULL_HANDLE;
+		instancedMeshIndexBufferMemory	= VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != instanceBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, instanceBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, instanceBufferMemory);	// implicitly unmaps instanceBufferMappedData
+
+		instanceBuffer				= VK_NULL_HANDLE;
+		instanceBufferMemory		= VK_NULL_HANDLE;
+		instanceBufferMappedData	= nullptr;
+		instanceBufferRegionsCount	= 0;
+	}
+	OutputDebugString("\n\tFinish  Sen_223_Instancing::finalizeWidget()\n");
+}
+
+void Sen_223_Instancing::createInstancingPipeline()
+{
+	/************************************************************************************************************/
+	/*********     Destroy old instancingPipeline first for widgetRezie, if there are      **********************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != instancingPipeline) {
+		vkDestroyPipeline(m_LogicalDevice, instancingPipeline, nullptr);
+		vkDestroyPipelineLayout(m_LogicalDevice, instancingPipelineLayout, nullptr);
+
+		instancingPipeline			= VK_NULL_HANDLE;
+		instancingPipelineLayout	= VK_NULL_HANDLE;
+	}
+
+	/****************************************************************************************************************************/
+	/**********                Reserve pipeline ShaderStage CreateInfos Array           *****************************************/
+	/****************************************************************************************************************************/
+	VkShaderModule vertShaderModule, fragShaderModule;
+
+	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/instancing.vert", vertShaderModule);
+	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/loadModelObj.frag", fragShaderModule);
+
+	VkPipelineShaderStageCreateInfo vertPipelineShaderStageCreateInfo{};
+	vertPipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	vertPipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+	vertPipelineShaderStageCreateInfo.module = vertShaderModule;
+	vertPipelineShaderStageCreateInfo.pName = "main"; // shader's entry point name
+
+	VkPipelineShaderStageCreateInfo fragPipelineShaderStageCreateInfo{};
+	fragPipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	fragPipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	fragPipelineShaderStageCreateInfo.module = fragShaderModule;
+	fragPipelineShaderStageCreateInfo.pName = "main"; // shader's entry point name
+
+	std::vector<VkPipelineShaderStageCreateInfo> pipelineShaderStagesCreateInfoVector;
+	pipelineShaderStagesCreateInfoVector.push_back(vertPipelineShaderStageCreateInfo);
+	pipelineShaderStagesCreateInfoVector.push_back(fragPipelineShaderStageCreateInfo);
+
+	/****************************************************************************************************************************/
+	/**********       Two vertex streams:  binding 0 per-vertex VertexStruct,  binding 1 per-instance InstanceStruct     ********/
+	/****************************************************************************************************************************/
+	std::vector<VkVertexInputBindingDescription> vertexInputBindingDescriptionVector;
+
+	VkVertexInputBindingDescription vertexInputBindingDescription{};
+	vertexInputBindingDescription.binding	= 0;
+	vertexInputBindingDescription.stride	= sizeof(VertexStruct);
+	vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+	vertexInputBindingDescriptionVector.push_back(vertexInputBindingDescription);
+
+	VkVertexInputBindingDescription instanceInputBindingDescription{};
+	instanceInputBindingDescription.binding		= m_Instance_VI_BindingIndex;
+	instanceInputBindingDescription.stride		= sizeof(InstanceStruct);
+	instanceInputBindingDescription.inputRate	= VK_VERTEX_INPUT_RATE_INSTANCE; // advance once per instance, instead of per vertex
+	vertexInputBindingDescriptionVector.push_back(instanceInputBindingDescription);
+
+	std::vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptionVector;
+
+	VkVertexInputAttributeDescription positionVertexInputAttributeDescription;
+	positionVertexInputAttributeDescription.location	= 0;
+	positionVertexInputAttributeDescription.binding		= 0;
+	positionVertexInputAttributeDescription.format		= VK_FORMAT_R32G32B32_SFLOAT;
+	positionVertexInputAttributeDescription.offset		= 0;
+	vertexInputAttributeDescriptionVector.push_back(positionVertexInputAttributeDescription);
+
+	VkVertexInputAttributeDescription texCoordVertexInputAttributeDescription;
+	texCoordVertexInputAttributeDescription.location	= 1;
+	texCoordVertexInputAttributeDescription.binding		= 0;
+	texCoordVertexInputAttributeDescription.format		= VK_FORMAT_R32G32_SFLOAT;
+	texCoordVertexInputAttributeDescription.offset		= 3 * sizeof(float);
+	vertexInputAttributeDescriptionVector.push_back(texCoordVertexInputAttributeDescription);
+
+	// layout(location = 2) in mat4 instanceModel;  one vec4 column per location, 2 ~ 5
+	for (uint32_t column = 0; column < 4; column++) {
+		VkVertexInputAttributeDescription instanceModelInputAttributeDescription;
+		instanceModelInputAttributeDescription.location	= 2 + column;
+		instanceModelInputAttributeDescription.binding	= m_Instance_VI_BindingIndex;
+		instanceModelInputAttributeDescription.format	= VK_FORMAT_R32G32B32A32_SFLOAT;
+		instanceModelInputAttributeDescription.offset	= column * sizeof(glm::vec4);
+		vertexInputAttributeDescriptionVector.push_back(instanceModelInputAttributeDescription);
+	}
+
+	VkPipelineVertexInputStateCreateInfo pipelineVertexInputStateCreateInfo{};
+	pipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount	= vertexInputBindingDescriptionVector.size();
+	pipelineVertexInputStateCreateInfo.pVertexBindingDescriptions		= vertexInputBindingDescriptionVector.data();
+	pipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount	= vertexInputAttributeDescriptionVector.size();
+	pipelineVertexInputStateCreateInfo.pVertexAttributeDescriptions		= vertexInputAttributeDescriptionVector.data();
+
+	VkPipelineInputAssemblyStateCreateInfo pipelineInputAssemblyStateCreateInfo{};
+	pipelineInputAssemblyStateCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	pipelineInputAssemblyStateCreateInfo.topology				= VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	pipelineInputAssemblyStateCreateInfo.primitiveRestartEnable = VK_FALSE;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	m_SwapchainResize_Viewport.x		= 0.0f;									m_SwapchainResize_Viewport.y		= 0.0f;
+	m_SwapchainResize_Viewport.width	= static_cast<float>(m_WidgetWidth);	m_SwapchainResize_Viewport.height	= static_cast<float>(m_WidgetHeight);
+	m_SwapchainResize_Viewport.minDepth	= 0.0f;									m_SwapchainResize_Viewport.maxDepth	= 1.0f;
+	m_SwapchainResize_ScissorRect2D.offset			= { 0, 0 };
+	m_SwapchainResize_ScissorRect2D.extent.width	= static_cast<uint32_t>(m_WidgetWidth);
+	m_SwapchainResize_ScissorRect2D.extent.height	= static_cast<uint32_t>(m_WidgetHeight);
+
+	VkPipelineViewportStateCreateInfo pipelineViewportStateCreateInfo{};
+	pipelineViewportStateCreateInfo.sType			= VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	pipelineViewportStateCreateInfo.viewportCount	= 1;
+	pipelineViewportStateCreateInfo.pViewports		= &m_SwapchainResize_Viewport;
+	pipelineViewportStateCreateInfo.scissorCount	= 1;
+	pipelineViewportStateCreateInfo.pScissors		= &m_SwapchainResize_ScissorRect2D;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineRasterizationStateCreateInfo pipelineRasterizationStateCreateInfo{};
+	pipelineRasterizationStateCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	pipelineRasterizationStateCreateInfo.depthClampEnable			= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.rasterizerDiscardEnable	= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.polygonMode				= VK_POLYGON_MODE_FILL;
+	pipelineRasterizationStateCreateInfo.cullMode					= VK_CULL_MODE_NONE; // the built-in cube is not consistently wound
+	pipelineRasterizationStateCreateInfo.frontFace					= VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	pipelineRasterizationStateCreateInfo.depthBiasEnable			= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.lineWidth					= 1.0f;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineMultisampleStateCreateInfo pipelineMultisampleStateCreateInfo{}; // for anti-aliasing
+	pipelineMultisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	pipelineMultisampleStateCreateInfo.sampleShadingEnable = VK_FALSE;
+	pipelineMultisampleStateCreateInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	std::vector<VkPipelineColorBlendAttachmentState> pipelineColorBlendAttachmentStateVector;
+	VkPipelineColorBlendAttachmentState pipelineColorBlendAttachmentState{};
+	pipelineColorBlendAttachmentState.colorWriteMask	= VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+															| VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	pipelineColorBlendAttachmentState.blendEnable		= VK_FALSE;
+	pipelineColorBlendAttachmentStateVector.push_back(pipelineColorBlendAttachmentState);
+
+	VkPipelineColorBlendStateCreateInfo pipelineColorBlendStateCreateInfo{};
+	pipelineColorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	pipelineColorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
+	pipelineColorBlendStateCreateInfo.attachmentCount	= (uint32_t)pipelineColorBlendAttachmentStateVector.size();
+	pipelineColorBlendStateCreateInfo.pAttachments		= pipelineColorBlendAttachmentStateVector.data();
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineDepthStencilStateCreateInfo pipelineDepthStencilStateCreateInfo{};
+	pipelineDepthStencilStateCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	pipelineDepthStencilStateCreateInfo.depthTestEnable			= VK_TRUE;
+	pipelineDepthStencilStateCreateInfo.depthWriteEnable		= VK_TRUE;
+	pipelineDepthStencilStateCreateInfo.depthCompareOp			= VK_COMPARE_OP_LESS;
+	pipelineDepthStencilStateCreateInfo.depthBoundsTestEnable	= VK_FALSE;
+	pipelineDepthStencilStateCreateInfo.stencilTestEnable		= VK_FALSE;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	std::vector<VkDynamicState> dynamicStateEnablesVector;
+	dynamicStateEnablesVector.push_back(VK_DYNAMIC_STATE_VIEWPORT);
+	dynamicStateEnablesVector.push_back(VK_DYNAMIC_STATE_SCISSOR);
+
+	VkPipelineDynamicStateCreateInfo pipelineDynamicStateCreateInfo{};
+	pipelineDynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	pipelineDynamicStateCreateInfo.dynamicStateCount = dynamicStateEnablesVector.size();
+	pipelineDynamicStateCreateInfo.pDynamicStates = dynamicStateEnablesVector.data();
+
+	/****************************************************************************************************************************/
+	/**********   Reserve pipeline Layout, which help access to descriptor sets from a pipeline       ***************************/
+	/****************************************************************************************************************************/
+	std::vector<VkDescriptorSetLayout> descriptorSetLayoutVector;
+	descriptorSetLayoutVector.push_back(m_Default_DSL);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+	pipelineLayoutCreateInfo.sType			= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.setLayoutCount = descriptorSetLayoutVector.size();
+	pipelineLayoutCreateInfo.pSetLayouts	= descriptorSetLayoutVector.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreatePipelineLayout(m_LogicalDevice, &pipelineLayoutCreateInfo, nullptr, &instancingPipelineLayout),
+		std::string("Failed to to create pipeline layout !!!")
+	);
+
+	/****************************************************************************************************************************/
+	/**********                Create   Pipeline            *********************************************************************/
+	/****************************************************************************************************************************/
+	VkGraphicsPipelineCreateInfo instancingPipelineCreateInfo{};
+	instancingPipelineCreateInfo.sType					= VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	instancingPipelineCreateInfo.stageCount				= (uint32_t)pipelineShaderStagesCreateInfoVector.size();
+	instancingPipelineCreateInfo.pStages				= pipelineShaderStagesCreateInfoVector.data();
+	instancingPipelineCreateInfo.pDynamicState			= &pipelineDynamicStateCreateInfo;
+	instancingPipelineCreateInfo.pVertexInputState		= &pipelineVertexInputStateCreateInfo;
+	instancingPipelineCreateInfo.pInputAssemblyState	= &pipelineInputAssemblyStateCreateInfo;
+	instancingPipelineCreateInfo.pViewportState			= &pipelineViewportStateCreateInfo;
+	instancingPipelineCreateInfo.pRasterizationState	= &pipelineRasterizationStateCreateInfo;
+	instancingPipelineCreateInfo.pMultisampleState		= &pipelineMultisampleStateCreateInfo;
+	instancingPipelineCreateInfo.pColorBlendState		= &pipelineColorBlendStateCreateInfo;
+	instancingPipelineCreateInfo.pDepthStencilState		= &pipelineDepthStencilStateCreateInfo;
+	instancingPipelineCreateInfo.layout					= instancingPipelineLayout;
+	instancingPipelineCreateInfo.renderPass				= depthTestRenderPass;
+	instancingPipelineCreateInfo.subpass				= 0;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateGraphicsPipelines(m_LogicalDevice, VK_NULL_HANDLE, 1, &instancingPipelineCreateInfo, nullptr, &instancingPipeline),
+		std::string("Failed to create graphics pipeline !!!")
+	);
+
+	vkDestroyShaderModule(m_LogicalDevice, vertShaderModule, nullptr);
+	vkDestroyShaderModule(m_LogicalDevice, fragShaderModule, nullptr);
+}
+
+void Sen_223_Instancing::populateInstancedMesh()
+{
+	vertexStructVector.clear();
+	indexVector.clear();
+
+	if (nullptr != instancedObjectDiskAddress) {
+		stobjl::populateVertexIndexVector(instancedObjectDiskAddress, vertexStructVector, indexVector);
+	}
+	else {
+		vertexStructVector = {
+			// Positions							// Texture Coords
+			{ { -0.5f,  0.5f, -0.5f },	{ 1.0f, 0.0f } },	{ { -0.5f, -0.5f, -0.5f },	{ 1.0f, 1.0f } },	// Front
+			{ {  0.5f, -0.5f, -0.5f },	{ 0.0f, 1.0f } },	{ {  0.5f,  0.5f, -0.5f },	{ 0.0f, 0.0f } },
+			{ {  0.5f,  0.5f,  0.5f },	{ 1.0f, 0.0f } },	{ {  0.5f, -0.5f,  0.5f },	{ 1.0f, 1.0f } },	// Back
+			{ { -0.5f, -0.5f,  0.5f },	{ 0.0f, 1.0f } },	{ { -0.5f,  0.5f,  0.5f },	{ 0.0f, 0.0f } },
+			{ { -0.5f,  0.5f,  0.5f },	{ 1.0f, 0.0f } },	{ { -0.5f, -0.5f,  0.5f },	{ 1.0f, 1.0f } },	// Left
+			{ { -0.5f, -0.5f, -0.5f },	{ 0.0f, 1.0f } },	{ { -0.5f,  0.5f, -0.5f },	{ 0.0f, 0.0f } },
+			{ {  0.5f,  0.5f, -0.5f },	{ 1.0f, 0.0f } },	{ {  0.5f, -0.5f, -0.5f },	{ 1.0f, 1.0f } },	// Right
+			{ {  0.5f, -0.5f,  0.5f },	{ 0.0f, 1.0f } },	{ {  0.5f,  0.5f,  0.5f },	{ 0.0f, 0.0f } },
+			{ {  0.5f,  0.5f, -0.5f },	{ 1.0f, 0.0f } },	{ {  0.5f,  0.5f,  0.5f },	{ 1.0f, 1.0f } },	// Top
+			{ { -0.5f,  0.5f,  0.5f },	{ 0.0f, 1.0f } },	{ { -0.5f,  0.5f, -0.5f },	{ 0.0f, 0.0f } },
+			{ { -0.5f, -0.5f, -0.5f },	{ 1.0f, 0.0f } },	{ { -0.5f, -0.5f,  0.5f },	{ 1.0f, 1.0f } },	// Bottom
+			{ {  0.5f, -0.5f,  0.5f },	{ 0.0f, 1.0f } },	{ {  0.5f, -0.5f, -0.5f },	{ 0.0f, 0.0f } }
+		};
+		for (uint32_t face = 0; face < 6; face++) {
+			uint32_t first = face * 4;
+			indexVector.insert(indexVector.end(), { first, first + 1, first + 3, first + 1, first + 2, first + 3 });
+		}
+	}
+
+	/****************************************************************************************************************************/
+	/**********      Lay instances out on a 100 x 100 x 10 grid, each with its own rotation phase     ***************************/
+	/****************************************************************************************************************************/
+	const uint32_t gridWidth = 100, gridDepth = 100;
+	const float gridSpacing = 1.6f;
+	instanceOriginPhaseVector.resize(instanceCount);
+	for (uint32_t i = 0; i < instanceCount; i++) {
+		uint32_t x = i % gridWidth, z = (i / gridWidth) % gridDepth, y = i / (gridWidth * gridDepth);
+		instanceOriginPhaseVector[i] = glm::vec4(
+			(x - gridWidth * 0.5f) * gridSpacing, y * gridSpacing, (z - gridDepth * 0.5f) * gridSpacing, (i % 97) * 0.37f);
+	}
+}
+
+void Sen_223_Instancing::createInstancedMeshIndexBuffer()
+{
+	VkDeviceSize indicesBufferSize = sizeof(indexVector[0]) * indexVector.size();
+
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indicesBufferSize,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		instancedMeshIndexBuffer, instancedMeshIndexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	// Queued in the staging ring, submitted with the other uploads before the first frame
+	stagingRing->uploadToBuffer(indexVector.data(), indicesBufferSize, instancedMeshIndexBuffer);
+}
+
+void Sen_223_Instancing::createInstancedMeshVertexBuffer()
+{
+	VkDeviceSize verticesBufferSize = sizeof(vertexStructVector[0]) * vertexStructVector.size();
+
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, verticesBufferSize,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		instancedMeshVertexBuffer, instancedMeshVertexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	stagingRing->uploadToBuffer(vertexStructVector.data(), verticesBufferSize, instancedMeshVertexBuffer);
+}
+
+void Sen_223_Instancing::createInstanceBuffer()
+{
+	/************************************************************************************************************/
+	/*********     Destroy old instanceBuffer first if the swapchain images count changed     *******************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != instanceBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, instanceBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, instanceBufferMemory);	// implicitly unmaps instanceBufferMappedData
+
+		instanceBuffer				= VK_NULL_HANDLE;
+		instanceBufferMemory		= VK_NULL_HANDLE;
+		instanceBufferMappedData	= nullptr;
+	}
+
+	/****************************************************************************************************************************/
+	/**********   One region per swapchain image, such that CPU writes region i only after image i's timeline value completed  *******/
+	/****************************************************************************************************************************/
+	instanceBufferRegionSize	= sizeof(InstanceStruct) * instanceCount;
+	instanceBufferRegionsCount	= m_SwapChain_ImagesCount;
+
+	SLVK_AbstractGLFW::createPersistentMappedBuffer(m_LogicalDevice, instanceBufferRegionSize * instanceBufferRegionsCount,
+		VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		instanceBuffer, instanceBufferMemory, instanceBufferMappedData);
+
+	for (uint32_t i = 0; i < instanceBufferRegionsCount; i++)
+		updateSwapchainImageResources(i);
+	throughputFramesCount			= 0;
+	instanceUpdateMillisecondsSum	= 0.0;
+}
+
+void Sen_223_Instancing::initInstancingTextureImage()
+{
+	SLVK_AbstractGLFW::createDeviceLocalTexture(m_LogicalDevice, m_PhysicalDeviceMemoryProperties
+		, instancingTextureDiskAddress, VK_IMAGE_TYPE_2D, instancingTextureWidth, instancingTextureHeight
+		, instancingTextureImage, instancingTextureImageDeviceMemory, instancingTextureImageView
+		, VK_SHARING_MODE_EXCLUSIVE, *stagingRing);
+
+	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
+}
+
+void Sen_223_Instancing::createTextureAppDescriptorPool()
+{
+	std::vector<VkDescriptorPoolSize> descriptorPoolSizeVector;
+
+	VkDescriptorPoolSize uniformBufferDescriptorPoolSize{};
+	uniformBufferDescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	uniformBufferDescriptorPoolSize.descriptorCount = 1;
+	descriptorPoolSizeVector.push_back(uniformBufferDescriptorPoolSize);
+
+	VkDescriptorPoolSize combinedImageSamplerDescriptorPoolSize{};
+	combinedImageSamplerDescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	combinedImageSamplerDescriptorPoolSize.descriptorCount = 1;
+	descriptorPoolSizeVector.push_back(combinedImageSamplerDescriptorPoolSize);
+
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.poolSizeCount = descriptorPoolSizeVector.size();
+	descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizeVector.data();
+	descriptorPoolCreateInfo.maxSets = 1;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorPool(m_LogicalDevice, &descriptorPoolCreateInfo, nullptr, &m_DescriptorPool),
+		std::string("Fail to Create descriptorPool !")
+	);
+}
+
+void Sen_223_Instancing::createTextureAppDescriptorSetLayout()
+{
+	std::vector<VkDescriptorSetLayoutBinding> instancingDSL_BindingVector;
+
+	VkDescriptorSetLayoutBinding mvpUboDSL_Binding{};
+	mvpUboDSL_Binding.binding				= m_UniformBuffer_DS_BindingIndex;
+	mvpUboDSL_Binding.descriptorCount		= 1;
+	mvpUboDSL_Binding.descriptorType		= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;	// one region per swapchain image
+	mvpUboDSL_Binding.pImmutableSamplers	= nullptr;
+	mvpUboDSL_Binding.stageFlags			= VK_SHADER_STAGE_VERTEX_BIT;
+	instancingDSL_BindingVector.push_back(mvpUboDSL_Binding);
+
+	VkDescriptorSetLayoutBinding combinedImageSamplerDSL_Binding{};
+	combinedImageSamplerDSL_Binding.binding				= m_COMB_IMA_SAMPLER_DS_BindingIndex;
+	combinedImageSamplerDSL_Binding.descriptorCount		= 1;
+	combinedImageSamplerDSL_Binding.descriptorType		= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	combinedImageSamplerDSL_Binding.pImmutableSamplers	= nullptr;
+	combinedImageSamplerDSL_Binding.stageFlags			= VK_SHADER_STAGE_FRAGMENT_BIT;
+	instancingDSL_BindingVector.push_back(combinedImageSamplerDSL_Binding);
+
+	VkDescriptorSetLayoutCreateInfo instancingDSL_CreateInfo{};
+	instancingDSL_CreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	instancingDSL_CreateInfo.bindingCount	= instancingDSL_BindingVector.size();
+	instancingDSL_CreateInfo.pBindings		= instancingDSL_BindingVector.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorSetLayout(m_LogicalDevice, &instancingDSL_CreateInfo, nullptr, &m_Default_DSL),
+		std::string("Fail to Create m_Default_DSL !")
+	);
+}
+
+void Sen_223_Instancing::createTextureAppDescriptorSet()
+{
+	std::vector<VkDescriptorSetLayout> descriptorSetLayoutVector;
+	descriptorSetLayoutVector.push_back(m_Default_DSL);
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+	descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.descriptorPool		= m_DescriptorPool;
+	descriptorSetAllocateInfo.descriptorSetCount	= descriptorSetLayoutVector.size();
+	descriptorSetAllocateInfo.pSetLayouts			= descriptorSetLayoutVector.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateDescriptorSets(m_LogicalDevice, &descriptorSetAllocateInfo, &m_Default_DS),
+		std::string("Fail to Allocate m_Default_DS !")
+	);
+	/**********************************************************************************************************************/
+	/**********************************************************************************************************************/
+	writeMvpUniformRegionsDescriptor(m_Default_DS);
+	/**********************************************************************************************************************/
+	VkDescriptorImageInfo textureDescriptorImageInfo{};
+	textureDescriptorImageInfo.imageLayout	= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	textureDescriptorImageInfo.imageView	= instancingTextureImageView;
+	textureDescriptorImageInfo.sampler		= texture2DSampler;
+	VkWriteDescriptorSet combinedImageSampler_DS_Write{};
+	combinedImageSampler_DS_Write.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	combinedImageSampler_DS_Write.descriptorType	= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	combinedImageSampler_DS_Write.dstSet			= m_Default_DS;
+	combinedImageSampler_DS_Write.dstBinding		= m_COMB_IMA_SAMPLER_DS_BindingIndex; // binding number, same with the binding index  in shader
+	combinedImageSampler_DS_Write.dstArrayElement	= 0;
+	combinedImageSampler_DS_Write.descriptorCount	= 1;
+	combinedImageSampler_DS_Write.pImageInfo		= &textureDescriptorImageInfo;
+
+	std::vector<VkWriteDescriptorSet> DS_Write_Vector;
+	DS_Write_Vector.push_back(combinedImageSampler_DS_Write);
+
+	vkUpdateDescriptorSets(m_LogicalDevice, DS_Write_Vector.size(), DS_Write_Vector.data(), 0, nullptr);
+}
+
+void Sen_223_Instancing::createInstancingCommandBuffers()
+{
+	/************************************************************************************************************/
+	/*********     Destroy old m_SwapchainCommandBufferVector first for widgetRezie, if there are      ************/
+	/************************************************************************************************************/
+	if (m_SwapchainCommandBufferVector.size() > 0) {
+		vkFreeCommandBuffers(m_LogicalDevice, m_DefaultThreadCommandPool, (uint32_t)m_SwapchainCommandBufferVector.size(), m_SwapchainCommandBufferVector.data());
+	}
+	/****************************************************************************************************************************/
+	/**********           Allocate Swapchain CommandBuffers         *************************************************************/
+	/****************************************************************************************************************************/
+	m_SwapchainCommandBufferVector.resize(m_SwapChain_ImagesCount);
+
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+	commandBufferAllocateInfo.sType			= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.commandPool	= m_DefaultThreadCommandPool;
+	commandBufferAllocateInfo.level			= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = static_cast<uint32_t>(m_SwapchainCommandBufferVector.size());
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateCommandBuffers(m_LogicalDevice, &commandBufferAllocateInfo, m_SwapchainCommandBufferVector.data()),
+		std::string("Failed to allocate Swapchain commandBuffers !!!")
+	);
+
+	/****************************************************************************************************************************/
+	/**********           Record Instancing Swapchain CommandBuffers        *****************************************************/
+	/****************************************************************************************************************************/
+	for (size_t i = 0; i < m_SwapchainCommandBufferVector.size(); i++) {
+		VkCommandBufferBeginInfo commandBufferBeginInfo{};
+		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		vkBeginCommandBuffer(m_SwapchainCommandBufferVector[i], &commandBufferBeginInfo);
+
+		VkRenderPassBeginInfo renderPassBeginInfo{};
+		renderPassBeginInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassBeginInfo.renderPass			= depthTestRenderPass;
+		renderPassBeginInfo.framebuffer			= m_SwapchainFramebufferVector[i];
+		renderPassBeginInfo.renderArea.offset	= { 0, 0 };
+		renderPassBeginInfo.renderArea.extent.width		= m_WidgetWidth;
+		renderPassBeginInfo.renderArea.extent.height	= m_WidgetHeight;
+
+		std::array<VkClearValue, 2> clearValueArray{};
+		clearValueArray[0].color		= { 0.2f, 0.3f, 0.3f, 1.0f };
+		clearValueArray[1].depthStencil = { 1.0f, 0 };
+		renderPassBeginInfo.clearValueCount = (uint32_t)clearValueArray.size();
+		renderPassBeginInfo.pClearValues	= clearValueArray.data();
+
+		vkCmdBeginRenderPass(m_SwapchainCommandBufferVector[i], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+		//======================================================================================
+		//======================================================================================
+		vkCmdBindPipeline(m_SwapchainCommandBufferVector[i], VK_PIPELINE_BIND_POINT_GRAPHICS, instancingPipeline);
+		// binding 0: per-vertex mesh stream;	binding 1: the instance region owned by swapchain image i
+		std::array<VkBuffer, 2> vertexBufferArray = { instancedMeshVertexBuffer, instanceBuffer };
+		std::array<VkDeviceSize, 2> offsetDeviceSizeArray = { 0, i * instanceBufferRegionSize };
+		vkCmdBindVertexBuffers(m_SwapchainCommandBufferVector[i], 0, (uint32_t)vertexBufferArray.size(), vertexBufferArray.data(), offsetDeviceSizeArray.data());
+		vkCmdBindIndexBuffer(m_SwapchainCommandBufferVector[i], instancedMeshIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+		// The MVP region owned by swapchain image i too
+		uint32_t mvpDynamicOffset = mvpUniformDynamicOffset(static_cast<uint32_t>(i));
+		vkCmdBindDescriptorSets(m_SwapchainCommandBufferVector[i], VK_PIPELINE_BIND_POINT_GRAPHICS,
+			instancingPipelineLayout, 0, 1, &m_Default_DS, 1, &mvpDynamicOffset);
+
+		vkCmdSetViewport(m_SwapchainCommandBufferVector[i], 0, 1, &m_SwapchainResize_Viewport);
+		vkCmdSetScissor(m_SwapchainCommandBufferVector[i], 0, 1, &m_SwapchainResize_ScissorRect2D);
+
+		vkCmdDrawIndexed(m_SwapchainCommandBufferVector[i], static_cast<uint32_t>(indexVector.size()), instanceCount, 0, 0, 0);
+
+		vkCmdEndRenderPass(m_SwapchainCommandBufferVector[i]);
+
+		SLVK_AbstractGLFW::errorCheck(
+			vkEndCommandBuffer(m_SwapchainCommandBufferVector[i]),
+			std::string("Failed to end record of Instancing Swapchain commandBuffers !!!")
+		);
+	}
+}
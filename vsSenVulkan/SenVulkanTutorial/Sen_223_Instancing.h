@@ -0,0 +1,91 @@
+#pragma once
+
+#ifndef __Sen_223_Instancing__
+#define __Sen_223_Instancing__
+
+#include "../Support/SLVK_AbstractGLFW.h"
+#include "../Support/SenTinyObjLoader.h"
+
+class Sen_223_Instancing :	public SLVK_AbstractGLFW
+{
+public:
+	Sen_223_Instancing();
+	virtual ~Sen_223_Instancing();
+
+protected:
+	void prefetchStartupAssets();
+	void initVulkanApplication();
+	void reCreateRenderTarget(); // for resize window
+	void finalizeWidget();
+
+	void cleanUpDepthStencil();
+	void updateUniformBuffer();
+	void updateSwapchainImageResources(const uint32_t& swapchainImageIndex);
+
+private:
+	void populateInstancedMesh();
+	void createInstancedMeshIndexBuffer();
+	void createInstancedMeshVertexBuffer();
+	void createInstanceBuffer();
+	void createInstancingCommandBuffers();
+
+	void initInstancingTextureImage();
+	void createInstancingPipeline();
+	void createTextureAppDescriptorPool();
+	void createTextureAppDescriptorSetLayout();
+	void createTextureAppDescriptorSet();
+
+	/*****************************************************************************************************************/
+	/*------------------------     For Resources Descrition       ---------------------------------------------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	/* uniform values need to be specified during pipeline creation by creating a VkPipelineLayout object */
+	VkDescriptorPool				m_DescriptorPool					= VK_NULL_HANDLE;
+	VkDescriptorSetLayout			m_Default_DSL						= VK_NULL_HANDLE;
+	VkDescriptorSet					m_Default_DS						= VK_NULL_HANDLE;
+
+	const int						m_COMB_IMA_SAMPLER_DS_BindingIndex	= 3;
+	VkImage							instancingTextureImage				= VK_NULL_HANDLE;
+	VkDeviceMemory					instancingTextureImageDeviceMemory	= VK_NULL_HANDLE;
+	VkImageView						instancingTextureImageView			= VK_NULL_HANDLE;
+	VkSampler						texture2DSampler					= VK_NULL_HANDLE;
+
+	VkBuffer						instancedMeshVertexBuffer			= VK_NULL_HANDLE;
+	VkDeviceMemory					instancedMeshVertexBufferMemory		= VK_NULL_HANDLE;
+	VkBuffer						instancedMeshIndexBuffer			= VK_NULL_HANDLE;
+	VkDeviceMemory					instancedMeshIndexBufferMemory		= VK_NULL_HANDLE;
+
+	/*****************************************************************************************************************/
+	/*-----------   Per-Instance vertex stream: one region per swapchain image, persistently mapped   ---------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	const uint32_t					m_Instance_VI_BindingIndex			= 1;	// binding 0 is the per-vertex VertexStruct stream
+	const uint32_t					instanceCount						= 100000;
+	VkBuffer						instanceBuffer						= VK_NULL_HANDLE;
+	VkDeviceMemory					instanceBufferMemory				= VK_NULL_HANDLE;
+	void*							instanceBufferMappedData			= nullptr;
+	VkDeviceSize					instanceBufferRegionSize			= 0;
+	uint32_t						instanceBufferRegionsCount			= 0;
+	std::vector<glm::vec4>			instanceOriginPhaseVector;	// xyz: grid position, w: rotation phase
+	MvpUniformBufferObject			frameMvpUniform;			// uploaded into the MVP region of each acquired swapchain image
+
+	VkPipeline						instancingPipeline					= VK_NULL_HANDLE;
+	VkPipelineLayout				instancingPipelineLayout			= VK_NULL_HANDLE;
+
+	int instancingTextureWidth, instancingTextureHeight;
+	const char* instancingTextureDiskAddress;
+	const char* instancedObjectDiskAddress;	// nullptr to instance the built-in cube
+
+	std::vector<VertexStruct>	vertexStructVector;
+	std::vector<uint32_t>		indexVector;
+
+	/*****************************************************************************************************************/
+	/*-----------             Throughput measurement, reported once per second          -----------------------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	std::chrono::high_resolution_clock::time_point	throughputReportTime;
+	uint64_t						throughputFramesCount				= 0;
+	double							instanceUpdateMillisecondsSum		= 0.0;
+	float							instanceAnimationTime				= 0.0f;
+};
+
+
+#endif // !__Sen_223_Instancing__
+
@@ -0,0 +1,890 @@
+
+#include "Sen_224_ClusterCulling.h"
+#include "../Support/SenComputeOffloadDevice.h"
+
+Sen_224_ClusterCulling::Sen_224_ClusterCulling()
+{
+	std::cout << "Constructor: Sen_224_ClusterCulling()\n\n";
+	strWindowName = "Sen Vulkan Cluster Culling Tutorial";
+
+	clusterTextureDiskAddress	= "../Images/MeshLinkModels/Chalet/chalet.jpg";
+	clusterObjectDiskAddress	= "../Images/MeshLinkModels/Chalet/chalet.obj";
+
+	enableComputeOffloadDevice();	// meshlet bounds on a second GPU, if there is one
+}
+
+Sen_224_ClusterCulling::~Sen_224_ClusterCulling()
+{
+	finalizeWidget();
+
+	OutputDebugString("\n\t ~Sen_224_ClusterCulling()\n");
+}
+
+void Sen_224_ClusterCulling::prefetchStartupAssets()
+{
+	prefetchShader("SenVulkanTutorial/Shaders/loadModelObj.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/loadModelObj.frag");
+	prefetchShader("SenVulkanTutorial/Shaders/clusterCulling.comp");
+	prefetchTexture(clusterTextureDiskAddress);
+}
+
+void Sen_224_ClusterCulling::initVulkanApplication()
+{
+	/****************************************************************************************************************************/
+	/**********   The culling pass is recorded into the graphics command buffers, so the graphics queue must run compute  ******/
+	/****************************************************************************************************************************/
+	uint32_t queueFamilyCount = 0;
+	vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &queueFamilyCount, nullptr);
+	std::vector<VkQueueFamilyProperties> queueFamilyPropertiesVector(queueFamilyCount);
+	vkGetPhysicalDeviceQueueFamilyProperties(m_PhysicalDevice, &queueFamilyCount, queueFamilyPropertiesVector.data());
+	if (!(queueFamilyPropertiesVector[graphicsQueueFamilyIndex].queueFlags & VK_QUEUE_COMPUTE_BIT))
+		throw std::runtime_error("Graphics queue family does not support compute, cluster culling is not available !");
+
+	VkPhysicalDeviceFeatures physicalDeviceFeatures{};
+	vkGetPhysicalDeviceFeatures(m_PhysicalDevice, &physicalDeviceFeatures);	// all supported features are enabled on m_LogicalDevice
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(m_PhysicalDevice, &physicalDeviceProperties);
+	multiDrawIndirectSupported	= (VK_TRUE == physicalDeviceFeatures.multiDrawIndirect);
+	maxDrawIndirectCount		= multiDrawIndirectSupported ? physicalDeviceProperties.limits.maxDrawIndirectCount : 1;
+
+	createTextureAppDescriptorSetLayout();
+	createClusterCullingDescriptorSetLayout();
+	createDefaultCommandPool();
+
+	initClusterTextureImage();
+	createMvpUniformRegionsBuffer();		// has to be called after createSwapchain() for the correct m_SwapChain_ImagesCount
+	createTextureAppDescriptorPool();
+	createTextureAppDescriptorSet();
+
+	/***************************************/
+	createDepthTestAttachment();			// has to be called after createDefaultCommandPool();
+	createDepthTestRenderPass();			// has to be called after createDepthTestAttachment() for depthTestFormat
+	createClusterGraphicsPipeline();
+	createClusterCullingPipeline();
+
+	createDepthTestSwapchainFramebuffers(); // has to be called after createDepthTestAttachment() for the depthTestImageView
+
+	stobjl::populateVertexIndexVector(clusterObjectDiskAddress, vertexStructVector, indexVector);
+	// With a second GPU the bounds are computed there while the vertex and index buffers are uploaded here
+	stobjl::buildMeshlets(vertexStructVector, indexVector, meshletVector, meshletIndexVector, 64, 124, nullptr == computeOffloadDevice);
+	std::cout << "\t " << indexVector.size() / 3 << " triangles split into " << meshletVector.size() << " meshlets\n";
+	std::shared_future<std::vector<MeshletStruct>> meshletBoundsFuture;
+	if (nullptr != computeOffloadDevice)
+		meshletBoundsFuture = computeOffloadDevice->computeMeshletBounds(vertexStructVector, meshletIndexVector, meshletVector);
+
+	createMeshletVertexBuffer();
+	createMeshletIndexBuffer();
+	if (meshletBoundsFuture.valid())
+		meshletVector = meshletBoundsFuture.get();
+	createMeshletStorageBuffer();
+	createClusterCullingFrameResources();	// has to be called after createSwapchain() for the correct m_SwapChain_ImagesCount
+	/***************************************/
+
+	createClusterCullingCommandBuffers();
+
+	statisticsReportTime = std::chrono::high_resolution_clock::now();
+	std::cout << "\n Finish  Sen_224_ClusterCulling::initVulkanApplication()\n";
+}
+
+void Sen_224_ClusterCulling::reCreateRenderTarget()
+{
+	createDepthTestAttachment();
+	createDepthTestSwapchainFramebuffers();
+	if (clusterCullingFrameVector.size() != m_SwapChain_ImagesCount)
+		createClusterCullingFrameResources();
+	if (mvpUniformRegionsCount != m_SwapChain_ImagesCount) {
+		createMvpUniformRegionsBuffer();
+		writeMvpUniformRegionsDescriptor(m_Default_DS);	// the device is idle here
+	}
+	createClusterCullingCommandBuffers();
+}
+
+void Sen_224_ClusterCulling::cleanUpDepthStencil()
+{
+	if (VK_NULL_HANDLE != depthTestImage) {
+		vkDestroyImage(m_LogicalDevice, depthTestImage, nullptr);
+		if (VK_NULL_HANDLE != depthTestImageView)
+			vkDestroyImageView(m_LogicalDevice, depthTestImageView, nullptr);
+		if (VK_NULL_HANDLE != depthTestImageDeviceMemory)
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, depthTestImageDeviceMemory); 	// always try to destroy before free
+
+		depthTestImage = VK_NULL_HANDLE;
+		depthTestImageView = VK_NULL_HANDLE;
+		depthTestImageDeviceMemory = VK_NULL_HANDLE;
+	}
+}
+
+void Sen_224_ClusterCulling::updateUniformBuffer() {
+	static auto startTime = std::chrono::high_resolution_clock::now();
+	auto currentTime = std::chrono::high_resolution_clock::now();
+	float duration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - startTime).count() / 220.0f;
+
+	MvpUniformBufferObject& mvpUbo = frameMvpUniform;
+	mvpUbo.model = glm::rotate(glm::mat4(1.0f), duration * glm::radians(15.0f), glm::vec3(-1.0f, 1.0f, 1.0f))
+				* glm::rotate(glm::mat4(1.0f), duration * glm::radians(3.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+	// Close enough that part of the model leaves the frustum while it rotates
+	mvpUbo.view = glm::lookAt(glm::vec3(0.0f, 0.0f, 1.8f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	mvpUbo.projection = glm::perspective(glm::radians(45.0f), m_WidgetWidth / (float)m_WidgetHeight, 0.1f, 100.0f);
+	mvpUbo.projection[1][1] *= -1;
+
+	// Uploaded into the region of the acquired swapchain image by updateSwapchainImageResources()
+
+	/****************************************************************************************************************************/
+	/**********   Frustum planes (Gribb & Hartmann) and camera position, both in model space where meshlet bounds live  *********/
+	/****************************************************************************************************************************/
+	glm::mat4 mvpMatrix = mvpUbo.projection * mvpUbo.view * mvpUbo.model;
+	glm::vec4 rowVector[4];
+	for (int row = 0; row < 4; row++)
+		rowVector[row] = glm::vec4(mvpMatrix[0][row], mvpMatrix[1][row], mvpMatrix[2][row], mvpMatrix[3][row]);
+
+	clusterCullingUniform.frustumPlanes[0] = rowVector[3] + rowVector[0];	// left
+	clusterCullingUniform.frustumPlanes[1] = rowVector[3] - rowVector[0];	// right
+	clusterCullingUniform.frustumPlanes[2] = rowVector[3] + rowVector[1];	// bottom (top, with the flipped y)
+	clusterCullingUniform.frustumPlanes[3] = rowVector[3] - rowVector[1];	// top
+	clusterCullingUniform.frustumPlanes[4] = rowVector[3] + rowVector[2];	// near, glm default [-1, 1] depth range
+	clusterCullingUniform.frustumPlanes[5] = rowVector[3] - rowVector[2];	// far
+	for (auto& plane : clusterCullingUniform.frustumPlanes)
+		plane = plane * (1.0f / glm::length(glm::vec3(plane)));
+
+	clusterCullingUniform.cameraPosition	= glm::inverse(mvpUbo.view * mvpUbo.model)[3];
+	clusterCullingUniform.meshletCount		= static_cast<uint32_t>(meshletVector.size());
+	clusterCullingUniform.cullingEnabled	= clusterCullingEnabled ? 1 : 0;
+
+	/****************************************************************************************************************************/
+	/**********           Report surviving meshlets / triangles once per second          ****************************************/
+	/****************************************************************************************************************************/
+	double reportSeconds = std::chrono::duration<double>(currentTime - statisticsReportTime).count();
+	if (reportSeconds >= 1.0 && statisticsFramesCount > 0) {
+		std::ostringstream stream;
+		stream << "Cluster culling " << (clusterCullingEnabled ? "ON " : "OFF")
+			<< "\t FPS = " << statisticsFramesCount / reportSeconds
+			<< "\t meshlets drawn = " << visibleMeshletsSum / statisticsFramesCount << " / " << meshletVector.size()
+			<< "\t triangles drawn = " << visibleTrianglesSum / statisticsFramesCount << " / " << meshletIndexVector.size() / 3 << "\n";
+		std::cout << stream.str();
+
+		statisticsReportTime	= currentTime;
+		statisticsFramesCount	= 0;
+		visibleMeshletsSum		= 0;
+		visibleTrianglesSum		= 0;
+	}
+}
+
+void Sen_224_ClusterCulling::updateSwapchainImageResources(const uint32_t& swapchainImageIndex)
+{
+	// Through the staging ring into this image's own region:  no host wait, and no frame in flight reads the region being written
+	uploadMvpUniformRegion(frameMvpUniform, swapchainImageIndex);
+
+	if (swapchainImageIndex >= clusterCullingFrameVector.size()) return;
+	ClusterCullingFrameStruct& cullingFrame = clusterCullingFrameVector[swapchainImageIndex];
+
+	// The timeline value of this image completed, so the statistics of its last culling pass are complete; collect and reset them
+	CullingStatisticsStruct* cullingStatistics = static_cast<CullingStatisticsStruct*>(cullingFrame.cullingStatisticsMappedData);
+	if (cullingFrame.statisticsPending) {
+		visibleMeshletsSum	+= cullingStatistics->visibleMeshletsCount;
+		visibleTrianglesSum	+= cullingStatistics->visibleTrianglesCount;
+		statisticsFramesCount++;
+	}
+	*cullingStatistics = CullingStatisticsStruct{};
+
+	memcpy(cullingFrame.cullingUniformMappedData, &clusterCullingUniform, sizeof(clusterCullingUniform));
+	cullingFrame.statisticsPending = true;
+}
+
+void Sen_224_ClusterCulling::onKeyboardReaction(GLFWwindow* widget, int key, int scancode, int action, int mode)
+{
+	SLVK_AbstractGLFW::onKeyboardReaction(widget, key, scancode, action, mode);
+
+	// C: compare with every meshlet drawn
+	if (key == GLFW_KEY_C && action == GLFW_PRESS)
+		clusterCullingEnabled = !clusterCullingEnabled;
+}
+
+void Sen_224_ClusterCulling::finalizeWidget()
+{
+	cleanUpDepthStencil();
+
+	/************************************************************************************************************/
+	/*********************           Destroy Pipeline, PipelineLayout, and RenderPass         *******************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != clusterGraphicsPipeline) {
+		vkDestroyPipeline(m_LogicalDevice, clusterGraphicsPipeline, nullptr);
+		vkDestroyPipelineLayout(m_LogicalDevice, clusterGraphicsPipelineLayout, nullptr);
+		vkDestroyRenderPass(m_LogicalDevice, depthTestRenderPass, nullptr);
+
+		clusterGraphicsPipeline			= VK_NULL_HANDLE;
+		clusterGraphicsPipelineLayout	= VK_NULL_HANDLE;
+		depthTestRenderPass				= VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != clusterCullingPipeline) {
+		vkDestroyPipeline(m_LogicalDevice, clusterCullingPipeline, nullptr);
+		vkDestroyPipelineLayout(m_LogicalDevice, clusterCullingPipelineLayout, nullptr);
+
+		clusterCullingPipeline			= VK_NULL_HANDLE;
+		clusterCullingPipelineLayout	= VK_NULL_HANDLE;
+	}
+	/************************************************************************************************************/
+	/*************      Destroy m_DescriptorPool,  m_Default_DSL,  m_Default_DS      ****************************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != m_DescriptorPool) {
+		vkDestroyDescriptorPool(m_LogicalDevice, m_DescriptorPool, nullptr);
+		// When a DescriptorPool is destroyed, all descriptor sets allocated from the pool are implicitly freed and become invalid
+		vkDestroyDescriptorSetLayout(m_LogicalDevice, m_Default_DSL, nullptr);
+
+		m_Default_DSL		= VK_NULL_HANDLE;
+		m_DescriptorPool	= VK_NULL_HANDLE;
+		m_Default_DS		= VK_NULL_HANDLE;
+	}
+	destroyClusterCullingFrameResources();
+	if (VK_NULL_HANDLE != clusterCulling_DSL) {
+		vkDestroyDescriptorSetLayout(m_LogicalDevice, clusterCulling_DSL, nullptr);
+		clusterCulling_DSL = VK_NULL_HANDLE;
+	}
+	/************************************************************************************************************/
+	/******************           Destroy Memory, ImageView, Image          *************************************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != clusterTextureImage) {
+		vkDestroyImage(m_LogicalDevice, clusterTextureImage, nullptr);
+		if (VK_NULL_HANDLE != clusterTextureImageView)
+			vkDestroyImageView(m_LogicalDevice, clusterTextureImageView, nullptr);
+		if (VK_NULL_HANDLE != texture2DSampler)
+			vkDestroySampler(m_LogicalDevice, texture2DSampler, nullptr);
+		if (VK_NULL_HANDLE != clusterTextureImageDeviceMemory)
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, clusterTextureImageDeviceMemory); 	// always try to destroy before free
+
+		clusterTextureImage				= VK_NULL_HANDLE;
+		clusterTextureImageDeviceMemory	= VK_NULL_HANDLE;
+		clusterTextureImageView			= VK_NULL_HANDLE;
+		texture2DSampler				= VK_NULL_HANDLE;
+	}
+	/************************************************************************************************************/
+	/******************     Destroy VertexBuffer, IndexBuffer, MeshletBuffer and their Memory     ***************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != meshletVertexBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, meshletVertexBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, meshletVertexBufferMemory);	// always try to destroy before free
+
+		meshletVertexBuffer			= VK_NULL_HANDLE;
+		meshletVertexBufferMemory	= VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != meshletIndexBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, meshletIndexBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, meshletIndexBufferMemory);	// always try to destroy before free
+
+		meshletIndexBuffer			= VK_NULL_HANDLE;
+		meshletIndexBufferMemory	= VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != meshletStorageBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, meshletStorageBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, meshletStorageBufferMemory);	// always try to destroy before free
+
+		meshletStorageBuffer		= VK_NULL_HANDLE;
+		meshletStorageBufferMemory	= VK_NULL_HANDLE;
+	}
+	OutputDebugString("\n\tFinish  Sen_224_ClusterCulling::finalizeWidget()\n");
+}
+
+void Sen_224_ClusterCulling::createClusterGraphicsPipeline()
+{
+	/************************************************************************************************************/
+	/*********     Destroy old clusterGraphicsPipeline first for widgetRezie, if there are      **********************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != clusterGraphicsPipeline) {
+		vkDestroyPipeline(m_LogicalDevice, clusterGraphicsPipeline, nullptr);
+		vkDestroyPipelineLayout(m_LogicalDevice, clusterGraphicsPipelineLayout, nullptr);
+
+		clusterGraphicsPipeline			= VK_NULL_HANDLE;
+		clusterGraphicsPipelineLayout	= VK_NULL_HANDLE;
+	}
+
+	/****************************************************************************************************************************/
+	/**********                Reserve pipeline ShaderStage CreateInfos Array           *****************************************/
+	/****************************************************************************************************************************/
+	VkShaderModule vertShaderModule, fragShaderModule;
+
+	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/loadModelObj.vert", vertShaderModule);
+	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/loadModelObj.frag", fragShaderModule);
+
+	VkPipelineShaderStageCreateInfo vertPipelineShaderStageCreateInfo{};
+	vertPipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	vertPipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+	vertPipelineShaderStageCreateInfo.module = vertShaderModule;
+	vertPipelineShaderStageCreateInfo.pName = "main"; // shader's entry point name
+
+	VkPipelineShaderStageCreateInfo fragPipelineShaderStageCreateInfo{};
+	fragPipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	fragPipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	fragPipelineShaderStageCreateInfo.module = fragShaderModule;
+	fragPipelineShaderStageCreateInfo.pName = "main"; // shader's entry point name
+
+	std::vector<VkPipelineShaderStageCreateInfo> pipelineShaderStagesCreateInfoVector;
+	pipelineShaderStagesCreateInfoVector.push_back(vertPipelineShaderStageCreateInfo);
+	pipelineShaderStagesCreateInfoVector.push_back(fragPipelineShaderStageCreateInfo);
+
+	/****************************************************************************************************************************/
+	/**********                Reserve pipeline Fixed-Function Stage CreateInfos           ***********************************/
+	/****************************************************************************************************************************/
+	std::vector<VkVertexInputBindingDescription> vertexInputBindingDescriptionVector;
+
+	VkVertexInputBindingDescription vertexInputBindingDescription{};
+	vertexInputBindingDescription.binding	= 0;
+	vertexInputBindingDescription.stride	= sizeof(VertexStruct);
+	vertexInputBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+	vertexInputBindingDescriptionVector.push_back(vertexInputBindingDescription);
+
+	std::vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptionVector;
+
+	VkVertexInputAttributeDescription positionVertexInputAttributeDescription;
+	positionVertexInputAttributeDescription.location	= 0;
+	positionVertexInputAttributeDescription.binding		= 0;
+	positionVertexInputAttributeDescription.format		= VK_FORMAT_R32G32B32_SFLOAT;
+	positionVertexInputAttributeDescription.offset		= 0;
+	vertexInputAttributeDescriptionVector.push_back(positionVertexInputAttributeDescription);
+
+	VkVertexInputAttributeDescription texCoordVertexInputAttributeDescription;
+	texCoordVertexInputAttributeDescription.location	= 1;
+	texCoordVertexInputAttributeDescription.binding		= 0;
+	texCoordVertexInputAttributeDescription.format		= VK_FORMAT_R32G32_SFLOAT;
+	texCoordVertexInputAttributeDescription.offset		= 3 * sizeof(float);
+	vertexInputAttributeDescriptionVector.push_back(texCoordVertexInputAttributeDescription);
+
+	VkPipelineVertexInputStateCreateInfo pipelineVertexInputStateCreateInfo{};
+	pipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount	= vertexInputBindingDescriptionVector.size();
+	pipelineVertexInputStateCreateInfo.pVertexBindingDescriptions		= vertexInputBindingDescriptionVector.data();
+	pipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount	= vertexInputAttributeDescriptionVector.size();
+	pipelineVertexInputStateCreateInfo.pVertexAttributeDescriptions		= vertexInputAttributeDescriptionVector.data();
+
+	VkPipelineInputAssemblyStateCreateInfo pipelineInputAssemblyStateCreateInfo{};
+	pipelineInputAssemblyStateCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	pipelineInputAssemblyStateCreateInfo.topology				= VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	pipelineInputAssemblyStateCreateInfo.primitiveRestartEnable = VK_FALSE;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	m_SwapchainResize_Viewport.x		= 0.0f;									m_SwapchainResize_Viewport.y		= 0.0f;
+	m_SwapchainResize_Viewport.width	= static_cast<float>(m_WidgetWidth);	m_SwapchainResize_Viewport.height	= static_cast<float>(m_WidgetHeight);
+	m_SwapchainResize_Viewport.minDepth	= 0.0f;									m_SwapchainResize_Viewport.maxDepth	= 1.0f;
+	m_SwapchainResize_ScissorRect2D.offset			= { 0, 0 };
+	m_SwapchainResize_ScissorRect2D.extent.width	= static_cast<uint32_t>(m_WidgetWidth);
+	m_SwapchainResize_ScissorRect2D.extent.height	= static_cast<uint32_t>(m_WidgetHeight);
+
+	VkPipelineViewportStateCreateInfo pipelineViewportStateCreateInfo{};
+	pipelineViewportStateCreateInfo.sType			= VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	pipelineViewportStateCreateInfo.viewportCount	= 1;
+	pipelineViewportStateCreateInfo.pViewports		= &m_SwapchainResize_Viewport;
+	pipelineViewportStateCreateInfo.scissorCount	= 1;
+	pipelineViewportStateCreateInfo.pScissors		= &m_SwapchainResize_ScissorRect2D;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineRasterizationStateCreateInfo pipelineRasterizationStateCreateInfo{};
+	pipelineRasterizationStateCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	pipelineRasterizationStateCreateInfo.depthClampEnable			= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.rasterizerDiscardEnable	= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.polygonMode				= VK_POLYGON_MODE_FILL;
+	pipelineRasterizationStateCreateInfo.cullMode					= VK_CULL_MODE_BACK_BIT; // what cluster culling could not reject
+	pipelineRasterizationStateCreateInfo.frontFace					= VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	pipelineRasterizationStateCreateInfo.depthBiasEnable			= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.lineWidth					= 1.0f;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineMultisampleStateCreateInfo pipelineMultisampleStateCreateInfo{}; // for anti-aliasing
+	pipelineMultisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	pipelineMultisampleStateCreateInfo.sampleShadingEnable = VK_FALSE;
+	pipelineMultisampleStateCreateInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	std::vector<VkPipelineColorBlendAttachmentState> pipelineColorBlendAttachmentStateVector;
+	VkPipelineColorBlendAttachmentState pipelineColorBlendAttachmentState{};
+	pipelineColorBlendAttachmentState.colorWriteMask	= VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+															| VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	pipelineColorBlendAttachmentState.blendEnable		= VK_FALSE;
+	pipelineColorBlendAttachmentStateVector.push_back(pipelineColorBlendAttachmentState);
+
+	VkPipelineColorBlendStateCreateInfo pipelineColorBlendStateCreateInfo{};
+	pipelineColorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	pipelineColorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
+	pipelineColorBlendStateCreateInfo.attachmentCount	= (uint32_t)pipelineColorBlendAttachmentStateVector.size();
+	pipelineColorBlendStateCreateInfo.pAttachments		= pipelineColorBlendAttachmentStateVector.data();
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineDepthStencilStateCreateInfo pipelineDepthStencilStateCreateInfo{};
+	pipelineDepthStencilStateCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	pipelineDepthStencilStateCreateInfo.depthTestEnable			= VK_TRUE;
+	pipelineDepthStencilStateCreateInfo.depthWriteEnable		= VK_TRUE;
+	pipelineDepthStencilStateCreateInfo.depthCompareOp			= VK_COMPARE_OP_LESS;
+	pipelineDepthStencilStateCreateInfo.depthBoundsTestEnable	= VK_FALSE;
+	pipelineDepthStencilStateCreateInfo.stencilTestEnable		= VK_FALSE;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	std::vector<VkDynamicState> dynamicStateEnablesVector;
+	dynamicStateEnablesVector.push_back(VK_DYNAMIC_STATE_VIEWPORT);
+	dynamicStateEnablesVector.push_back(VK_DYNAMIC_STATE_SCISSOR);
+
+	VkPipelineDynamicStateCreateInfo pipelineDynamicStateCreateInfo{};
+	pipelineDynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	pipelineDynamicStateCreateInfo.dynamicStateCount = dynamicStateEnablesVector.size();
+	pipelineDynamicStateCreateInfo.pDynamicStates = dynamicStateEnablesVector.data();
+
+	/****************************************************************************************************************************/
+	/**********   Reserve pipeline Layout, which help access to descriptor sets from a pipeline       ***************************/
+	/****************************************************************************************************************************/
+	std::vector<VkDescriptorSetLayout> descriptorSetLayoutVector;
+	descriptorSetLayoutVector.push_back(m_Default_DSL);
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+	pipelineLayoutCreateInfo.sType			= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.setLayoutCount = descriptorSetLayoutVector.size();
+	pipelineLayoutCreateInfo.pSetLayouts	= descriptorSetLayoutVector.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreatePipelineLayout(m_LogicalDevice, &pipelineLayoutCreateInfo, nullptr, &clusterGraphicsPipelineLayout),
+		std::string("Failed to to create pipeline layout !!!")
+	);
+
+	/****************************************************************************************************************************/
+	/**********                Create   Pipeline            *********************************************************************/
+	/****************************************************************************************************************************/
+	VkGraphicsPipelineCreateInfo clusterGraphicsPipelineCreateInfo{};
+	clusterGraphicsPipelineCreateInfo.sType					= VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	clusterGraphicsPipelineCreateInfo.stageCount				= (uint32_t)pipelineShaderStagesCreateInfoVector.size();
+	clusterGraphicsPipelineCreateInfo.pStages				= pipelineShaderStagesCreateInfoVector.data();
+	clusterGraphicsPipelineCreateInfo.pDynamicState			= &pipelineDynamicStateCreateInfo;
+	clusterGraphicsPipelineCreateInfo.pVertexInputState		= &pipelineVertexInputStateCreateInfo;
+	clusterGraphicsPipelineCreateInfo.pInputAssemblyState	= &pipelineInputAssemblyStateCreateInfo;
+	clusterGraphicsPipelineCreateInfo.pViewportState			= &pipelineViewportStateCreateInfo;
+	clusterGraphicsPipelineCreateInfo.pRasterizationState	= &pipelineRasterizationStateCreateInfo;
+	clusterGraphicsPipelineCreateInfo.pMultisampleState		= &pipelineMultisampleStateCreateInfo;
+	clusterGraphicsPipelineCreateInfo.pColorBlendState		= &pipelineColorBlendStateCreateInfo;
+	clusterGraphicsPipelineCreateInfo.pDepthStencilState		= &pipelineDepthStencilStateCreateInfo;
+	clusterGraphicsPipelineCreateInfo.layout					= clusterGraphicsPipelineLayout;
+	clusterGraphicsPipelineCreateInfo.renderPass				= depthTestRenderPass;
+	clusterGraphicsPipelineCreateInfo.subpass				= 0;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateGraphicsPipelines(m_LogicalDevice, VK_NULL_HANDLE, 1, &clusterGraphicsPipelineCreateInfo, nullptr, &clusterGraphicsPipeline),
+		std::string("Failed to create graphics pipeline !!!")
+	);
+
+	vkDestroyShaderModule(m_LogicalDevice, vertShaderModule, nullptr);
+	vkDestroyShaderModule(m_LogicalDevice, fragShaderModule, nullptr);
+}
+
+void Sen_224_ClusterCulling::createMeshletIndexBuffer()
+{
+	VkDeviceSize indicesBufferSize = sizeof(meshletIndexVector[0]) * meshletIndexVector.size();
+
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indicesBufferSize,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		meshletIndexBuffer, meshletIndexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	// Queued in the staging ring, submitted with the other uploads before the first frame
+	stagingRing->uploadToBuffer(meshletIndexVector.data(), indicesBufferSize, meshletIndexBuffer);
+}
+
+void Sen_224_ClusterCulling::createMeshletVertexBuffer()
+{
+	VkDeviceSize verticesBufferSize = sizeof(vertexStructVector[0]) * vertexStructVector.size();
+
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, verticesBufferSize,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		meshletVertexBuffer, meshletVertexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	stagingRing->uploadToBuffer(vertexStructVector.data(), verticesBufferSize, meshletVertexBuffer);
+}
+
+void Sen_224_ClusterCulling::initClusterTextureImage()
+{
+	SLVK_AbstractGLFW::createDeviceLocalTexture(m_LogicalDevice, m_PhysicalDeviceMemoryProperties
+		, clusterTextureDiskAddress, VK_IMAGE_TYPE_2D, clusterTextureWidth, clusterTextureHeight
+		, clusterTextureImage, clusterTextureImageDeviceMemory, clusterTextureImageView
+		, VK_SHARING_MODE_EXCLUSIVE, *stagingRing);
+
+	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
+}
+
+void Sen_224_ClusterCulling::createTextureAppDescriptorPool()
+{
+	std::vector<VkDescriptorPoolSize> descriptorPoolSizeVector;
+
+	VkDescriptorPoolSize uniformBufferDescriptorPoolSize{};
+	uniformBufferDescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	uniformBufferDescriptorPoolSize.descriptorCount = 1;
+	descriptorPoolSizeVector.push_back(uniformBufferDescriptorPoolSize);
+
+	VkDescriptorPoolSize combinedImageSamplerDescriptorPoolSize{};
+	combinedImageSamplerDescriptorPoolSize.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	combinedImageSamplerDescriptorPoolSize.descriptorCount = 1;
+	descriptorPoolSizeVector.push_back(combinedImageSamplerDescriptorPoolSize);
+
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+	descriptorPoolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.poolSizeCount = descriptorPoolSizeVector.size();
+	descriptorPoolCreateInfo.pPoolSizes = descriptorPoolSizeVector.data();
+	descriptorPoolCreateInfo.maxSets = 1;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorPool(m_LogicalDevice, &descriptorPoolCreateInfo, nullptr, &m_DescriptorPool),
+		std::string("Fail to Create descriptorPool !")
+	);
+}
+
+void Sen_224_ClusterCulling::createTextureAppDescriptorSetLayout()
+{
+	std::vector<VkDescriptorSetLayoutBinding> clusterDSL_BindingVector;
+
+	VkDescriptorSetLayoutBinding mvpUboDSL_Binding{};
+	mvpUboDSL_Binding.binding				= m_UniformBuffer_DS_BindingIndex;
+	mvpUboDSL_Binding.descriptorCount		= 1;
+	mvpUboDSL_Binding.descriptorType		= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;	// one region per swapchain image
+	mvpUboDSL_Binding.pImmutableSamplers	= nullptr;
+	mvpUboDSL_Binding.stageFlags			= VK_SHADER_STAGE_VERTEX_BIT;
+	clusterDSL_BindingVector.push_back(mvpUboDSL_Binding);
+
+	VkDescriptorSetLayoutBinding combinedImageSamplerDSL_Binding{};
+	combinedImageSamplerDSL_Binding.binding				= m_COMB_IMA_SAMPLER_DS_BindingIndex;
+	combinedImageSamplerDSL_Binding.descriptorCount		= 1;
+	combinedImageSamplerDSL_Binding.descriptorType		= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	combinedImageSamplerDSL_Binding.pImmutableSamplers	= nullptr;
+	combinedImageSamplerDSL_Binding.stageFlags			= VK_SHADER_STAGE_FRAGMENT_BIT;
+	clusterDSL_BindingVector.push_back(combinedImageSamplerDSL_Binding);
+
+	VkDescriptorSetLayoutCreateInfo clusterDSL_CreateInfo{};
+	clusterDSL_CreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	clusterDSL_CreateInfo.bindingCount	= clusterDSL_BindingVector.size();
+	clusterDSL_CreateInfo.pBindings		= clusterDSL_BindingVector.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorSetLayout(m_LogicalDevice, &clusterDSL_CreateInfo, nullptr, &m_Default_DSL),
+		std::string("Fail to Create m_Default_DSL !")
+	);
+}
+
+void Sen_224_ClusterCulling::createTextureAppDescriptorSet()
+{
+	std::vector<VkDescriptorSetLayout> descriptorSetLayoutVector;
+	descriptorSetLayoutVector.push_back(m_Default_DSL);
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+	descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.descriptorPool		= m_DescriptorPool;
+	descriptorSetAllocateInfo.descriptorSetCount	= descriptorSetLayoutVector.size();
+	descriptorSetAllocateInfo.pSetLayouts			= descriptorSetLayoutVector.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateDescriptorSets(m_LogicalDevice, &descriptorSetAllocateInfo, &m_Default_DS),
+		std::string("Fail to Allocate m_Default_DS !")
+	);
+	/**********************************************************************************************************************/
+	/**********************************************************************************************************************/
+	writeMvpUniformRegionsDescriptor(m_Default_DS);
+	/**********************************************************************************************************************/
+	VkDescriptorImageInfo textureDescriptorImageInfo{};
+	textureDescriptorImageInfo.imageLayout	= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	textureDescriptorImageInfo.imageView	= clusterTextureImageView;
+	textureDescriptorImageInfo.sampler		= texture2DSampler;
+	VkWriteDescriptorSet combinedImageSampler_DS_Write{};
+	combinedImageSampler_DS_Write.sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	combinedImageSampler_DS_Write.descriptorType	= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	combinedImageSampler_DS_Write.dstSet			= m_Default_DS;
+	combinedImageSampler_DS_Write.dstBinding		= m_COMB_IMA_SAMPLER_DS_BindingIndex; // binding number, same with the binding index  in shader
+	combinedImageSampler_DS_Write.dstArrayElement	= 0;
+	combinedImageSampler_DS_Write.descriptorCount	= 1;
+	combinedImageSampler_DS_Write.pImageInfo		= &textureDescriptorImageInfo;
+
+	std::vector<VkWriteDescriptorSet> DS_Write_Vector;
+	DS_Write_Vector.push_back(combinedImageSampler_DS_Write);
+
+	vkUpdateDescriptorSets(m_LogicalDevice, DS_Write_Vector.size(), DS_Write_Vector.data(), 0, nullptr);
+}
+
+void Sen_224_ClusterCulling::createMeshletStorageBuffer()
+{
+	VkDeviceSize meshletsBufferSize = sizeof(meshletVector[0]) * meshletVector.size();
+
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, meshletsBufferSize,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		meshletStorageBuffer, meshletStorageBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	stagingRing->uploadToBuffer(meshletVector.data(), meshletsBufferSize, meshletStorageBuffer);
+}
+
+void Sen_224_ClusterCulling::createClusterCullingDescriptorSetLayout()
+{
+	// binding 0: meshlets,  1: culling uniform,  2: indirect draw commands,  3: culling statistics
+	std::vector<VkDescriptorType> descriptorTypeVector = { VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+		VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER };
+
+	std::vector<VkDescriptorSetLayoutBinding> clusterCullingDSL_BindingVector;
+	for (uint32_t binding = 0; binding < descriptorTypeVector.size(); binding++) {
+		VkDescriptorSetLayoutBinding clusterCullingDSL_Binding{};
+		clusterCullingDSL_Binding.binding				= binding;
+		clusterCullingDSL_Binding.descriptorCount		= 1;
+		clusterCullingDSL_Binding.descriptorType		= descriptorTypeVector[binding];
+		clusterCullingDSL_Binding.pImmutableSamplers	= nullptr;
+		clusterCullingDSL_Binding.stageFlags			= VK_SHADER_STAGE_COMPUTE_BIT;
+		clusterCullingDSL_BindingVector.push_back(clusterCullingDSL_Binding);
+	}
+
+	VkDescriptorSetLayoutCreateInfo clusterCullingDSL_CreateInfo{};
+	clusterCullingDSL_CreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	clusterCullingDSL_CreateInfo.bindingCount	= clusterCullingDSL_BindingVector.size();
+	clusterCullingDSL_CreateInfo.pBindings		= clusterCullingDSL_BindingVector.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorSetLayout(m_LogicalDevice, &clusterCullingDSL_CreateInfo, nullptr, &clusterCulling_DSL),
+		std::string("Fail to Create clusterCulling_DSL !")
+	);
+}
+
+void Sen_224_ClusterCulling::createClusterCullingPipeline()
+{
+	if (VK_NULL_HANDLE != clusterCullingPipeline) {
+		vkDestroyPipeline(m_LogicalDevice, clusterCullingPipeline, nullptr);
+		vkDestroyPipelineLayout(m_LogicalDevice, clusterCullingPipelineLayout, nullptr);
+
+		clusterCullingPipeline			= VK_NULL_HANDLE;
+		clusterCullingPipelineLayout	= VK_NULL_HANDLE;
+	}
+
+	VkShaderModule compShaderModule;
+	createVulkanShaderModule(m_LogicalDevice, "SenVulkanTutorial/Shaders/clusterCulling.comp", compShaderModule);
+
+	VkPipelineShaderStageCreateInfo compPipelineShaderStageCreateInfo{};
+	compPipelineShaderStageCreateInfo.sType		= VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	compPipelineShaderStageCreateInfo.stage		= VK_SHADER_STAGE_COMPUTE_BIT;
+	compPipelineShaderStageCreateInfo.module	= compShaderModule;
+	compPipelineShaderStageCreateInfo.pName		= "main"; // shader's entry point name
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+	pipelineLayoutCreateInfo.sType			= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.setLayoutCount = 1;
+	pipelineLayoutCreateInfo.pSetLayouts	= &clusterCulling_DSL;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreatePipelineLayout(m_LogicalDevice, &pipelineLayoutCreateInfo, nullptr, &clusterCullingPipelineLayout),
+		std::string("Failed to to create cluster culling pipeline layout !!!")
+	);
+
+	VkComputePipelineCreateInfo clusterCullingPipelineCreateInfo{};
+	clusterCullingPipelineCreateInfo.sType	= VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+	clusterCullingPipelineCreateInfo.stage	= compPipelineShaderStageCreateInfo;
+	clusterCullingPipelineCreateInfo.layout	= clusterCullingPipelineLayout;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateComputePipelines(m_LogicalDevice, VK_NULL_HANDLE, 1, &clusterCullingPipelineCreateInfo, nullptr, &clusterCullingPipeline),
+		std::string("Failed to create cluster culling compute pipeline !!!")
+	);
+
+	vkDestroyShaderModule(m_LogicalDevice, compShaderModule, nullptr);
+}
+
+void Sen_224_ClusterCulling::createClusterCullingFrameResources()
+{
+	destroyClusterCullingFrameResources();
+	clusterCullingFrameVector.resize(m_SwapChain_ImagesCount);
+
+	/****************************************************************************************************************************/
+	/**********           One culling descriptor set per swapchain image         ************************************************/
+	/****************************************************************************************************************************/
+	std::vector<VkDescriptorPoolSize> descriptorPoolSizeVector;
+	VkDescriptorPoolSize uniformBufferDescriptorPoolSize{};
+	uniformBufferDescriptorPoolSize.type			= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	uniformBufferDescriptorPoolSize.descriptorCount = m_SwapChain_ImagesCount;
+	descriptorPoolSizeVector.push_back(uniformBufferDescriptorPoolSize);
+	VkDescriptorPoolSize storageBufferDescriptorPoolSize{};
+	storageBufferDescriptorPoolSize.type			= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	storageBufferDescriptorPoolSize.descriptorCount = 3 * m_SwapChain_ImagesCount;
+	descriptorPoolSizeVector.push_back(storageBufferDescriptorPoolSize);
+
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+	descriptorPoolCreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.poolSizeCount	= descriptorPoolSizeVector.size();
+	descriptorPoolCreateInfo.pPoolSizes		= descriptorPoolSizeVector.data();
+	descriptorPoolCreateInfo.maxSets		= m_SwapChain_ImagesCount;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorPool(m_LogicalDevice, &descriptorPoolCreateInfo, nullptr, &clusterCullingDescriptorPool),
+		std::string("Fail to Create clusterCullingDescriptorPool !")
+	);
+
+	const VkDeviceSize indirectDrawBufferSize = sizeof(VkDrawIndexedIndirectCommand) * meshletVector.size();
+	for (auto& cullingFrame : clusterCullingFrameVector) {
+		SLVK_AbstractGLFW::createPersistentMappedBuffer(m_LogicalDevice, sizeof(ClusterCullingUniformStruct),
+			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+			cullingFrame.cullingUniformBuffer, cullingFrame.cullingUniformBufferMemory, cullingFrame.cullingUniformMappedData);
+		// Only written and read by the GPU
+		SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indirectDrawBufferSize,
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+			cullingFrame.indirectDrawBuffer, cullingFrame.indirectDrawBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		SLVK_AbstractGLFW::createPersistentMappedBuffer(m_LogicalDevice, sizeof(CullingStatisticsStruct),
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+			cullingFrame.cullingStatisticsBuffer, cullingFrame.cullingStatisticsBufferMemory, cullingFrame.cullingStatisticsMappedData);
+		*static_cast<CullingStatisticsStruct*>(cullingFrame.cullingStatisticsMappedData) = CullingStatisticsStruct{};
+		memcpy(cullingFrame.cullingUniformMappedData, &clusterCullingUniform, sizeof(clusterCullingUniform));
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+		descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocateInfo.descriptorPool		= clusterCullingDescriptorPool;
+		descriptorSetAllocateInfo.descriptorSetCount	= 1;
+		descriptorSetAllocateInfo.pSetLayouts			= &clusterCulling_DSL;
+
+		SLVK_AbstractGLFW::errorCheck(
+			vkAllocateDescriptorSets(m_LogicalDevice, &descriptorSetAllocateInfo, &cullingFrame.cullingDS),
+			std::string("Fail to Allocate cullingDS !")
+		);
+
+		std::array<VkDescriptorBufferInfo, 4> descriptorBufferInfoArray{};
+		descriptorBufferInfoArray[0] = { meshletStorageBuffer, 0, VK_WHOLE_SIZE };
+		descriptorBufferInfoArray[1] = { cullingFrame.cullingUniformBuffer, 0, sizeof(ClusterCullingUniformStruct) };
+		descriptorBufferInfoArray[2] = { cullingFrame.indirectDrawBuffer, 0, VK_WHOLE_SIZE };
+		descriptorBufferInfoArray[3] = { cullingFrame.cullingStatisticsBuffer, 0, sizeof(CullingStatisticsStruct) };
+
+		std::vector<VkWriteDescriptorSet> DS_Write_Vector;
+		for (uint32_t binding = 0; binding < descriptorBufferInfoArray.size(); binding++) {
+			VkWriteDescriptorSet cullingBuffer_DS_Write{};
+			cullingBuffer_DS_Write.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+			cullingBuffer_DS_Write.descriptorType	= (1 == binding) ? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+			cullingBuffer_DS_Write.dstSet			= cullingFrame.cullingDS;
+			cullingBuffer_DS_Write.dstBinding		= binding;	// binding number, same with the binding index  in shader
+			cullingBuffer_DS_Write.dstArrayElement	= 0;
+			cullingBuffer_DS_Write.descriptorCount	= 1;
+			cullingBuffer_DS_Write.pBufferInfo		= &descriptorBufferInfoArray[binding];
+			DS_Write_Vector.push_back(cullingBuffer_DS_Write);
+		}
+		vkUpdateDescriptorSets(m_LogicalDevice, DS_Write_Vector.size(), DS_Write_Vector.data(), 0, nullptr);
+	}
+}
+
+void Sen_224_ClusterCulling::destroyClusterCullingFrameResources()
+{
+	for (auto& cullingFrame : clusterCullingFrameVector) {
+		if (VK_NULL_HANDLE != cullingFrame.cullingUniformBuffer) {
+			vkDestroyBuffer(m_LogicalDevice, cullingFrame.cullingUniformBuffer, nullptr);
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, cullingFrame.cullingUniformBufferMemory);	// implicitly unmaps
+		}
+		if (VK_NULL_HANDLE != cullingFrame.indirectDrawBuffer) {
+			vkDestroyBuffer(m_LogicalDevice, cullingFrame.indirectDrawBuffer, nullptr);
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, cullingFrame.indirectDrawBufferMemory);	// always try to destroy before free
+		}
+		if (VK_NULL_HANDLE != cullingFrame.cullingStatisticsBuffer) {
+			vkDestroyBuffer(m_LogicalDevice, cullingFrame.cullingStatisticsBuffer, nullptr);
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, cullingFrame.cullingStatisticsBufferMemory);	// implicitly unmaps
+		}
+	}
+	clusterCullingFrameVector.clear();
+
+	if (VK_NULL_HANDLE != clusterCullingDescriptorPool) {
+		// all cullingDS are implicitly freed with their pool
+		vkDestroyDescriptorPool(m_LogicalDevice, clusterCullingDescriptorPool, nullptr);
+		clusterCullingDescriptorPool = VK_NULL_HANDLE;
+	}
+}
+
+void Sen_224_ClusterCulling::createClusterCullingCommandBuffers()
+{
+	/************************************************************************************************************/
+	/*********     Destroy old m_SwapchainCommandBufferVector first for widgetRezie, if there are      ************/
+	/************************************************************************************************************/
+	if (m_SwapchainCommandBufferVector.size() > 0) {
+		vkFreeCommandBuffers(m_LogicalDevice, m_DefaultThreadCommandPool, (uint32_t)m_SwapchainCommandBufferVector.size(), m_SwapchainCommandBufferVector.data());
+	}
+	/****************************************************************************************************************************/
+	/**********           Allocate Swapchain CommandBuffers         *************************************************************/
+	/****************************************************************************************************************************/
+	m_SwapchainCommandBufferVector.resize(m_SwapChain_ImagesCount);
+
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+	commandBufferAllocateInfo.sType			= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.commandPool	= m_DefaultThreadCommandPool;
+	commandBufferAllocateInfo.level			= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = static_cast<uint32_t>(m_SwapchainCommandBufferVector.size());
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateCommandBuffers(m_LogicalDevice, &commandBufferAllocateInfo, m_SwapchainCommandBufferVector.data()),
+		std::string("Failed to allocate Swapchain commandBuffers !!!")
+	);
+
+	const uint32_t meshletCount = static_cast<uint32_t>(meshletVector.size());
+	/****************************************************************************************************************************/
+	/**********           Record Cluster Culling Swapchain CommandBuffers:  compute culling, then indirect draws     ************/
+	/****************************************************************************************************************************/
+	for (size_t i = 0; i < m_SwapchainCommandBufferVector.size(); i++) {
+		VkCommandBufferBeginInfo commandBufferBeginInfo{};
+		commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		vkBeginCommandBuffer(m_SwapchainCommandBufferVector[i], &commandBufferBeginInfo);
+
+		//======================================================================================
+		//======================================================================================
+		vkCmdBindPipeline(m_SwapchainCommandBufferVector[i], VK_PIPELINE_BIND_POINT_COMPUTE, clusterCullingPipeline);
+		vkCmdBindDescriptorSets(m_SwapchainCommandBufferVector[i], VK_PIPELINE_BIND_POINT_COMPUTE,
+			clusterCullingPipelineLayout, 0, 1, &clusterCullingFrameVector[i].cullingDS, 0, nullptr);
+		vkCmdDispatch(m_SwapchainCommandBufferVector[i], (meshletCount + m_CullingWorkGroupSize - 1) / m_CullingWorkGroupSize, 1, 1);
+
+		// Draw commands must be complete before the indirect reads; statistics before the host reads them after the frame's timeline value
+		std::array<VkBufferMemoryBarrier, 2> bufferMemoryBarrierArray{};
+		bufferMemoryBarrierArray[0].sType				= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+		bufferMemoryBarrierArray[0].srcAccessMask		= VK_ACCESS_SHADER_WRITE_BIT;
+		bufferMemoryBarrierArray[0].dstAccessMask		= VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		bufferMemoryBarrierArray[0].srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		bufferMemoryBarrierArray[0].dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+		bufferMemoryBarrierArray[0].buffer				= clusterCullingFrameVector[i].indirectDrawBuffer;
+		bufferMemoryBarrierArray[0].offset				= 0;
+		bufferMemoryBarrierArray[0].size				= VK_WHOLE_SIZE;
+		bufferMemoryBarrierArray[1]						= bufferMemoryBarrierArray[0];
+		bufferMemoryBarrierArray[1].dstAccessMask		= VK_ACCESS_HOST_READ_BIT;
+		bufferMemoryBarrierArray[1].buffer				= clusterCullingFrameVector[i].cullingStatisticsBuffer;
+
+		vkCmdPipelineBarrier(m_SwapchainCommandBufferVector[i], VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0,
+			0, nullptr, (uint32_t)bufferMemoryBarrierArray.size(), bufferMemoryBarrierArray.data(), 0, nullptr);
+
+		//======================================================================================
+		//======================================================================================
+		VkRenderPassBeginInfo renderPassBeginInfo{};
+		renderPassBeginInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassBeginInfo.renderPass			= depthTestRenderPass;
+		renderPassBeginInfo.framebuffer			= m_SwapchainFramebufferVector[i];
+		renderPassBeginInfo.renderArea.offset	= { 0, 0 };
+		renderPassBeginInfo.renderArea.extent.width		= m_WidgetWidth;
+		renderPassBeginInfo.renderArea.extent.height	= m_WidgetHeight;
+
+		std::array<VkClearValue, 2> clearValueArray{};
+		clearValueArray[0].color		= { 0.2f, 0.3f, 0.3f, 1.0f };
+		clearValueArray[1].depthStencil = { 1.0f, 0 };
+		renderPassBeginInfo.clearValueCount = (uint32_t)clearValueArray.size();
+		renderPassBeginInfo.pClearValues	= clearValueArray.data();
+
+		vkCmdBeginRenderPass(m_SwapchainCommandBufferVector[i], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+		vkCmdBindPipeline(m_SwapchainCommandBufferVector[i], VK_PIPELINE_BIND_POINT_GRAPHICS, clusterGraphicsPipeline);
+		VkDeviceSize offsetDeviceSize = 0;
+		vkCmdBindVertexBuffers(m_SwapchainCommandBufferVector[i], 0, 1, &meshletVertexBuffer, &offsetDeviceSize);
+		vkCmdBindIndexBuffer(m_SwapchainCommandBufferVector[i], meshletIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+		// The MVP region owned by swapchain image i
+		uint32_t mvpDynamicOffset = mvpUniformDynamicOffset(static_cast<uint32_t>(i));
+		vkCmdBindDescriptorSets(m_SwapchainCommandBufferVector[i], VK_PIPELINE_BIND_POINT_GRAPHICS,
+			clusterGraphicsPipelineLayout, 0, 1, &m_Default_DS, 1, &mvpDynamicOffset);
+
+		vkCmdSetViewport(m_SwapchainCommandBufferVector[i], 0, 1, &m_SwapchainResize_Viewport);
+		vkCmdSetScissor(m_SwapchainCommandBufferVector[i], 0, 1, &m_SwapchainResize_ScissorRect2D);
+
+		// One command per meshlet, culled ones carry instanceCount = 0; without multiDrawIndirect maxDrawIndirectCount is 1
+		for (uint32_t firstDraw = 0; firstDraw < meshletCount; firstDraw += maxDrawIndirectCount) {
+			vkCmdDrawIndexedIndirect(m_SwapchainCommandBufferVector[i], clusterCullingFrameVector[i].indirectDrawBuffer,
+				firstDraw * sizeof(VkDrawIndexedIndirectCommand), (std::min)(maxDrawIndirectCount, meshletCount - firstDraw),
+				sizeof(VkDrawIndexedIndirectCommand));
+		}
+
+		vkCmdEndRenderPass(m_SwapchainCommandBufferVector[i]);
+
+		SLVK_AbstractGLFW::errorCheck(
+			vkEndCommandBuffer(m_SwapchainCommandBufferVector[i]),
+			std::string("Failed to end record of Cluster Culling Swapchain commandBuffers !!!")
+		);
+	}
+}
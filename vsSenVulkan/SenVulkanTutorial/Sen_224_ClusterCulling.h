@@ -0,0 +1,128 @@
+#pragma once
+
+#ifndef __Sen_224_ClusterCulling__
+#define __Sen_224_ClusterCulling__
+
+#include "../Support/SLVK_AbstractGLFW.h"
+#include "../Support/SenTinyObjLoader.h"
+
+class Sen_224_ClusterCulling :	public SLVK_AbstractGLFW
+{
+public:
+	Sen_224_ClusterCulling();
+	virtual ~Sen_224_ClusterCulling();
+
+protected:
+	void prefetchStartupAssets();
+	void initVulkanApplication();
+	void reCreateRenderTarget(); // for resize window
+	void finalizeWidget();
+
+	void cleanUpDepthStencil();
+	void updateUniformBuffer();
+	void updateSwapchainImageResources(const uint32_t& swapchainImageIndex);
+	void onKeyboardReaction(GLFWwindow* widget, int key, int scancode, int action, int mode);
+
+private:
+	void createMeshletVertexBuffer();
+	void createMeshletIndexBuffer();
+	void createMeshletStorageBuffer();
+	void createClusterCullingCommandBuffers();
+
+	void initClusterTextureImage();
+	void createClusterGraphicsPipeline();
+	void createTextureAppDescriptorPool();
+	void createTextureAppDescriptorSetLayout();
+	void createTextureAppDescriptorSet();
+
+	void createClusterCullingDescriptorSetLayout();
+	void createClusterCullingPipeline();
+	void createClusterCullingFrameResources();
+	void destroyClusterCullingFrameResources();
+
+	/*****************************************************************************************************************/
+	/*------------------------     For Resources Descrition       ---------------------------------------------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	/* uniform values need to be specified during pipeline creation by creating a VkPipelineLayout object */
+	VkDescriptorPool				m_DescriptorPool					= VK_NULL_HANDLE;
+	VkDescriptorSetLayout			m_Default_DSL						= VK_NULL_HANDLE;
+	VkDescriptorSet					m_Default_DS						= VK_NULL_HANDLE;
+
+	const int						m_COMB_IMA_SAMPLER_DS_BindingIndex	= 3;
+	VkImage							clusterTextureImage					= VK_NULL_HANDLE;
+	VkDeviceMemory					clusterTextureImageDeviceMemory		= VK_NULL_HANDLE;
+	VkImageView						clusterTextureImageView				= VK_NULL_HANDLE;
+	VkSampler						texture2DSampler					= VK_NULL_HANDLE;
+
+	VkBuffer						meshletVertexBuffer					= VK_NULL_HANDLE;
+	VkDeviceMemory					meshletVertexBufferMemory			= VK_NULL_HANDLE;
+	VkBuffer						meshletIndexBuffer					= VK_NULL_HANDLE;	// triangles regrouped by meshlet
+	VkDeviceMemory					meshletIndexBufferMemory			= VK_NULL_HANDLE;
+	VkBuffer						meshletStorageBuffer				= VK_NULL_HANDLE;	// MeshletStruct array, read by the culling pass
+	VkDeviceMemory					meshletStorageBufferMemory			= VK_NULL_HANDLE;
+
+	VkPipeline						clusterGraphicsPipeline				= VK_NULL_HANDLE;
+	VkPipelineLayout				clusterGraphicsPipelineLayout		= VK_NULL_HANDLE;
+
+	/*****************************************************************************************************************/
+	/*-----------   Compute cluster culling, writes one VkDrawIndexedIndirectCommand per meshlet   -------------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	// std140 mirror of ClusterCullingUniform in clusterCulling.comp
+	struct ClusterCullingUniformStruct {
+		glm::vec4 frustumPlanes[6];
+		glm::vec4 cameraPosition;
+		uint32_t meshletCount;
+		uint32_t cullingEnabled;
+		uint32_t padding[2];
+	};
+	struct CullingStatisticsStruct {
+		uint32_t visibleMeshletsCount;
+		uint32_t visibleTrianglesCount;
+	};
+	// Everything the culling pass of one swapchain image writes or reads per frame
+	struct ClusterCullingFrameStruct {
+		VkBuffer		cullingUniformBuffer				= VK_NULL_HANDLE;
+		VkDeviceMemory	cullingUniformBufferMemory			= VK_NULL_HANDLE;
+		void*			cullingUniformMappedData			= nullptr;
+		VkBuffer		indirectDrawBuffer					= VK_NULL_HANDLE;
+		VkDeviceMemory	indirectDrawBufferMemory			= VK_NULL_HANDLE;
+		VkBuffer		cullingStatisticsBuffer				= VK_NULL_HANDLE;
+		VkDeviceMemory	cullingStatisticsBufferMemory		= VK_NULL_HANDLE;
+		void*			cullingStatisticsMappedData			= nullptr;
+		VkDescriptorSet	cullingDS							= VK_NULL_HANDLE;
+		bool			statisticsPending					= false;	// a culling pass was submitted since the last read back
+	};
+
+	const uint32_t					m_CullingWorkGroupSize				= 64;	// local_size_x in clusterCulling.comp
+	VkDescriptorSetLayout			clusterCulling_DSL					= VK_NULL_HANDLE;
+	VkDescriptorPool				clusterCullingDescriptorPool		= VK_NULL_HANDLE;
+	VkPipeline						clusterCullingPipeline				= VK_NULL_HANDLE;
+	VkPipelineLayout				clusterCullingPipelineLayout		= VK_NULL_HANDLE;
+	std::vector<ClusterCullingFrameStruct>	clusterCullingFrameVector;
+	ClusterCullingUniformStruct		clusterCullingUniform{};
+	MvpUniformBufferObject			frameMvpUniform;			// uploaded into the MVP region of each acquired swapchain image
+	bool							clusterCullingEnabled				= true;
+	bool							multiDrawIndirectSupported			= false;
+	uint32_t						maxDrawIndirectCount				= 1;
+
+	int clusterTextureWidth, clusterTextureHeight;
+	const char* clusterTextureDiskAddress;
+	const char* clusterObjectDiskAddress;
+
+	std::vector<VertexStruct>		vertexStructVector;
+	std::vector<uint32_t>			indexVector;
+	std::vector<MeshletStruct>		meshletVector;
+	std::vector<uint32_t>			meshletIndexVector;
+
+	/*****************************************************************************************************************/
+	/*-----------             Culling statistics, reported once per second          ---------------------------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	std::chrono::high_resolution_clock::time_point	statisticsReportTime;
+	uint64_t						statisticsFramesCount				= 0;
+	uint64_t						visibleMeshletsSum					= 0;
+	uint64_t						visibleTrianglesSum					= 0;
+};
+
+
+#endif // !__Sen_224_ClusterCulling__
+
@@ -0,0 +1,614 @@
+
+#include "Sen_225_TextureStreaming.h"
+
+Sen_225_TextureStreaming::Sen_225_TextureStreaming()
+{
+	std::cout << "Constructor: Sen_225_TextureStreaming()\n\n";
+	strWindowName = "Sen Vulkan Texture Streaming Tutorial";
+
+	textureDiskAddressVector = {
+		"../Images/Lau2.jpg",
+		"../Images/SenSqaurePortrait.jpg",
+		"../Images/SunRaise.jpg",
+		"../Images/UKY.jpg",
+		"../Images/MeshLinkModels/Chalet/chalet.jpg"
+	};
+
+	enableComputeOffloadDevice();	// mip chains on a second GPU, if there is one
+}
+
+Sen_225_TextureStreaming::~Sen_225_TextureStreaming()
+{
+	finalizeWidget();
+
+	OutputDebugString("\n\t ~Sen_225_TextureStreaming()\n");
+}
+
+void Sen_225_TextureStreaming::prefetchStartupAssets()
+{
+	prefetchShader(m_TextureStreamingVertShader);
+	prefetchShader(m_TextureStreamingFragShader);
+}
+
+void Sen_225_TextureStreaming::initVulkanApplication()
+{
+	createTextureAppDescriptorSetLayout();
+	createDefaultCommandPool();
+
+	initStreamedTextures();
+	createMvpUniformRegionsBuffer();		// has to be called after createSwapchain() for the correct m_SwapChain_ImagesCount
+	populateStreamingScene();				// cubeCenterVector sizes the per-cube descriptor sets
+	createTextureAppDescriptorSets();		// has to be called after createSwapchain() for the correct m_SwapChain_ImagesCount
+
+	/***************************************/
+	createDepthTestAttachment();			// has to be called after createDefaultCommandPool();
+	createDepthTestRenderPass();			// has to be called after createDepthTestAttachment() for depthTestFormat
+	createTextureStreamingPipeline();
+
+	createDepthTestSwapchainFramebuffers(); // has to be called after createDepthTestAttachment() for the depthTestImageView
+
+	createStreamingCubeVertexBuffer();
+	createStreamingCubeIndexBuffer();
+	/***************************************/
+
+	createTextureStreamingCommandBuffers();
+
+	residencyReportTime = std::chrono::high_resolution_clock::now();
+	std::cout << "\n Finish  Sen_225_TextureStreaming::initVulkanApplication()\n";
+}
+
+void Sen_225_TextureStreaming::reCreateRenderTarget()
+{
+	createDepthTestAttachment();
+	createDepthTestSwapchainFramebuffers();
+	if (descriptorSetImagesCount != m_SwapChain_ImagesCount) {
+		createMvpUniformRegionsBuffer();	// the sets written next point at the new regions
+		createTextureAppDescriptorSets();
+	}
+	createTextureStreamingCommandBuffers();
+}
+
+void Sen_225_TextureStreaming::cleanUpDepthStencil()
+{
+	if (VK_NULL_HANDLE != depthTestImage) {
+		vkDestroyImage(m_LogicalDevice, depthTestImage, nullptr);
+		if (VK_NULL_HANDLE != depthTestImageView)
+			vkDestroyImageView(m_LogicalDevice, depthTestImageView, nullptr);
+		if (VK_NULL_HANDLE != depthTestImageDeviceMemory)
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, depthTestImageDeviceMemory); 	// always try to destroy before free
+
+		depthTestImage = VK_NULL_HANDLE;
+		depthTestImageView = VK_NULL_HANDLE;
+		depthTestImageDeviceMemory = VK_NULL_HANDLE;
+	}
+}
+
+void Sen_225_TextureStreaming::updateUniformBuffer() {
+	static auto startTime = std::chrono::high_resolution_clock::now();
+	auto currentTime = std::chrono::high_resolution_clock::now();
+	float duration = std::chrono::duration_cast<std::chrono::milliseconds>(currentTime - startTime).count() / 1000.0f;
+	frameNumber++;
+
+	/****************************************************************************************************************************/
+	/**********      Fly back and forth along the row of cubes, looking slightly ahead      *************************************/
+	/****************************************************************************************************************************/
+	const float rowLength	= cubeCenterVector.back().x - cubeCenterVector.front().x;
+	const float cameraX		= cubeCenterVector.front().x + rowLength * (0.5f - 0.5f * std::cos(duration * 0.15f));
+	const float flyDirection = std::sin(duration * 0.15f) >= 0.0f ? 1.0f : -1.0f;
+	const glm::vec3 cameraPosition(cameraX, 1.0f, 3.5f);
+	const float fieldOfViewY = glm::radians(45.0f);
+
+	frameMvpUniform.model = glm::mat4(1.0f);	// every cube pushes its own model matrix
+	frameMvpUniform.view = glm::lookAt(cameraPosition, glm::vec3(cameraX + flyDirection * 6.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	frameMvpUniform.projection = glm::perspective(fieldOfViewY, m_WidgetWidth / (float)m_WidgetHeight, 0.1f, 1000.0f);
+	frameMvpUniform.projection[1][1] *= -1;
+	// Uploaded into the region of the acquired swapchain image by updateSwapchainImageResources()
+
+	/****************************************************************************************************************************/
+	/**********      Request each visible cube's mip level from its projected size, then let the streamer work      *************/
+	/****************************************************************************************************************************/
+	const glm::vec3 viewDirection = glm::normalize(glm::vec3(flyDirection * 6.0f, -1.0f, -3.5f));
+	const float pixelsPerUnitAtOne = m_WidgetHeight / (2.0f * std::tan(fieldOfViewY * 0.5f));
+	for (size_t cube = 0; cube < cubeCenterVector.size(); cube++) {
+		glm::vec3 cameraToCube = cubeCenterVector[cube] - cameraPosition;
+		if (glm::dot(cameraToCube, viewDirection) < -m_CubeSize) continue;	// behind the camera, left to LRU eviction
+
+		float projectedPixelsCount = m_CubeSize * pixelsPerUnitAtOne / (std::max)(glm::length(cameraToCube), 0.1f);
+		uint32_t textureId = textureIdVector[cubeTextureIndexVector[cube]];
+		textureStreamer->requestMipLevel(textureId, textureStreamer->mipLevelForScreenSize(textureId, projectedPixelsCount), frameNumber);
+	}
+	textureStreamer->update(frameNumber, m_FrameUploadByteBudget);
+
+	// Frame boundary:  pipelines rebuilt from saved shaders are swapped in, swapchain images re-record as they come up
+	shaderHotReloader->swapRebuiltPipelines();
+
+	/****************************************************************************************************************************/
+	/**********           Report residency once per second          *************************************************************/
+	/****************************************************************************************************************************/
+	if (std::chrono::duration<double>(currentTime - residencyReportTime).count() >= 1.0) {
+		// Keep half of what the device local heap still has free for everything else, never above the configured budget
+		textureStreamer->setResidencyBudget((std::min)(m_ResidencyBudgetBytes,
+			textureStreamer->residentBytes() + SenMemoryTracker::deviceLocalHeadroom() / 2));
+
+		std::ostringstream stream;
+		stream << "Texture streaming:  resident " << textureStreamer->residentBytes() / (1024.0 * 1024.0) << " MB / "
+			<< textureStreamer->residencyBudget() / (1024.0 * 1024.0) << " MB,  evictions = " << textureStreamer->evictionsCount()
+			<< ",  base mips =";
+		for (const auto& textureId : textureIdVector)
+			stream << " " << textureStreamer->residentMipLevel(textureId) << "/" << textureStreamer->mipLevelsCount(textureId);
+		stream << "\n Descriptor sets:  allocated " << descriptorAllocator->allocatedSetsCount() << ",  deduplicated "
+			<< descriptorAllocator->reusedSetsCount() << ",  pools = " << descriptorAllocator->poolsCount()
+			<< ",  layouts = " << descriptorAllocator->layoutsCount() << "\n";
+		stream << SenMemoryTracker::report();
+		std::cout << stream.str();
+
+		residencyReportTime = currentTime;
+	}
+}
+
+void Sen_225_TextureStreaming::updateSwapchainImageResources(const uint32_t& swapchainImageIndex)
+{
+	// Through the staging ring into this image's own region:  no host wait, and no frame in flight reads the region being written
+	uploadMvpUniformRegion(frameMvpUniform, swapchainImageIndex);
+
+	if (nullptr == textureStreamer || swapchainImageIndex >= swapchainImageGenerationVector.size()) return;
+
+	// Image views changed since this image's sets were written:  its timeline value completed, so rewrite and re-record it now
+	const bool texturesChanged = swapchainImageGenerationVector[swapchainImageIndex] != textureStreamer->residencyGeneration();
+	// A hot-reloaded pipeline was swapped in since this image was recorded
+	const bool pipelineChanged = swapchainImagePipelineGenerationVector[swapchainImageIndex] != shaderHotReloader->pipelineGeneration();
+	if (texturesChanged)
+		writeTextureAppDescriptorSets(swapchainImageIndex);
+	if (texturesChanged || pipelineChanged) {
+		recordTextureStreamingCommandBuffer(swapchainImageIndex);
+		swapchainImageGenerationVector[swapchainImageIndex]			= textureStreamer->residencyGeneration();
+		swapchainImagePipelineGenerationVector[swapchainImageIndex]	= shaderHotReloader->pipelineGeneration();
+	}
+	textureStreamer->destroyRetiredImages(*std::min_element(swapchainImageGenerationVector.begin(), swapchainImageGenerationVector.end()));
+	shaderHotReloader->destroyRetiredPipelines(
+		*std::min_element(swapchainImagePipelineGenerationVector.begin(), swapchainImagePipelineGenerationVector.end()));
+}
+
+void Sen_225_TextureStreaming::finalizeWidget()
+{
+	cleanUpDepthStencil();
+
+	/************************************************************************************************************/
+	/*********************           Destroy Pipeline, PipelineLayout, and RenderPass         *******************/
+	/************************************************************************************************************/
+	if (nullptr != shaderHotReloader) {
+		delete shaderHotReloader;	// joins the watcher thread, destroys live and retired pipelines
+		shaderHotReloader = nullptr;
+	}
+	if (VK_NULL_HANDLE != depthTestRenderPass) {
+		vkDestroyRenderPass(m_LogicalDevice, depthTestRenderPass, nullptr);
+
+		textureStreamingPipelineLayout	= VK_NULL_HANDLE;	// owned by shaderReflection's pipeline layout cache
+		depthTestRenderPass				= VK_NULL_HANDLE;
+	}
+	if (nullptr != shaderReflection) {
+		delete shaderReflection;
+		shaderReflection = nullptr;
+	}
+	/************************************************************************************************************/
+	/*************      Destroy descriptorAllocator:  its pools, cached m_Default_DSL and streamedCube_DS_Vector     *****/
+	/************************************************************************************************************/
+	if (nullptr != descriptorAllocator) {
+		delete descriptorAllocator;	// device is idle here
+		descriptorAllocator = nullptr;
+		m_Default_DSL = VK_NULL_HANDLE;
+		streamedCube_DS_Vector.clear();
+	}
+	/************************************************************************************************************/
+	/******************           Destroy Sampler, and every streamed image          ****************************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != texture2DSampler) {
+		vkDestroySampler(m_LogicalDevice, texture2DSampler, nullptr);
+		texture2DSampler = VK_NULL_HANDLE;
+	}
+	if (nullptr != textureStreamer) {
+		delete textureStreamer;	// device is idle here
+		textureStreamer = nullptr;
+	}
+	/************************************************************************************************************/
+	/******************     Destroy VertexBuffer, IndexBuffer and their Memory     ******************************/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != streamingCubeVertexBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, streamingCubeVertexBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, streamingCubeVertexBufferMemory);	// always try to destroy before free
+
+		streamingCubeVertexBuffer		= VK_NULL_HANDLE;
+		streamingCubeVertexBufferMemory	= VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != streamingCubeIndexBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, streamingCubeIndexBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, streamingCubeIndexBufferMemory);	// always try to destroy before free
+
+		streamingCubeIndexBuffer		= VK_NULL_HANDLE;
+		streamingCubeIndexBufferMemory	= VK_NULL_HANDLE;
+	}
+	OutputDebugString("\n\tFinish  Sen_225_TextureStreaming::finalizeWidget()\n");
+}
+
+void Sen_225_TextureStreaming::createTextureStreamingPipeline()
+{
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	m_SwapchainResize_Viewport.x		= 0.0f;									m_SwapchainResize_Viewport.y		= 0.0f;
+	m_SwapchainResize_Viewport.width	= static_cast<float>(m_WidgetWidth);	m_SwapchainResize_Viewport.height	= static_cast<float>(m_WidgetHeight);
+	m_SwapchainResize_Viewport.minDepth	= 0.0f;									m_SwapchainResize_Viewport.maxDepth	= 1.0f;
+	m_SwapchainResize_ScissorRect2D.offset			= { 0, 0 };
+	m_SwapchainResize_ScissorRect2D.extent.width	= static_cast<uint32_t>(m_WidgetWidth);
+	m_SwapchainResize_ScissorRect2D.extent.height	= static_cast<uint32_t>(m_WidgetHeight);
+
+	/****************************************************************************************************************************/
+	/**********     Register with the hot-reloader:  built now, rebuilt in the background whenever a stage is saved      *******/
+	/****************************************************************************************************************************/
+	if (nullptr == shaderHotReloader)
+		shaderHotReloader = new SenShaderHotReloader(m_LogicalDevice, "SenVulkanTutorial/Shaders");
+
+	textureStreamingPipelineId = shaderHotReloader->registerPipeline({ m_TextureStreamingVertShader, m_TextureStreamingFragShader },
+		[this](const VkPipelineCache& pipelineCache, const std::vector<VkShaderModule>& shaderModuleVector) {
+			return buildTextureStreamingPipeline(pipelineCache, shaderModuleVector); },
+		{ shaderReflection->loadShader(m_TextureStreamingVertShader).spirv32Vector, shaderReflection->loadShader(m_TextureStreamingFragShader).spirv32Vector });
+}
+
+VkPipeline Sen_225_TextureStreaming::buildTextureStreamingPipeline(const VkPipelineCache& pipelineCache, const std::vector<VkShaderModule>& shaderModuleVector) const
+{
+	// Runs on the hot-reload watcher thread as well:  only reads objects that stay constant after initVulkanApplication()
+	/****************************************************************************************************************************/
+	/**********                Reserve pipeline ShaderStage CreateInfos Array           *****************************************/
+	/****************************************************************************************************************************/
+	VkPipelineShaderStageCreateInfo vertPipelineShaderStageCreateInfo{};
+	vertPipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	vertPipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_VERTEX_BIT;
+	vertPipelineShaderStageCreateInfo.module = shaderModuleVector[0];
+	vertPipelineShaderStageCreateInfo.pName = "main"; // shader's entry point name
+
+	VkPipelineShaderStageCreateInfo fragPipelineShaderStageCreateInfo{};
+	fragPipelineShaderStageCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	fragPipelineShaderStageCreateInfo.stage = VK_SHADER_STAGE_FRAGMENT_BIT;
+	fragPipelineShaderStageCreateInfo.module = shaderModuleVector[1];
+	fragPipelineShaderStageCreateInfo.pName = "main"; // shader's entry point name
+
+	std::vector<VkPipelineShaderStageCreateInfo> pipelineShaderStagesCreateInfoVector;
+	pipelineShaderStagesCreateInfoVector.push_back(vertPipelineShaderStageCreateInfo);
+	pipelineShaderStagesCreateInfoVector.push_back(fragPipelineShaderStageCreateInfo);
+
+	/****************************************************************************************************************************/
+	/**********                Reserve pipeline Vertex Input State CreateInfo           *****************************************/
+	/****************************************************************************************************************************/
+	// Reflected from textureStreaming.vert:  location 0 vec3, location 1 vec2, interleaved in location order
+	if (textureStreamingProgram.vertexInputBindingDescription.stride != sizeof(VertexStruct))
+		throw std::runtime_error("textureStreaming.vert vertex inputs do not match VertexStruct !");
+
+	std::vector<VkVertexInputBindingDescription> vertexInputBindingDescriptionVector;
+	vertexInputBindingDescriptionVector.push_back(textureStreamingProgram.vertexInputBindingDescription);
+
+	const std::vector<VkVertexInputAttributeDescription>& vertexInputAttributeDescriptionVector
+		= textureStreamingProgram.vertexInputAttributeDescriptionVector;
+
+	VkPipelineVertexInputStateCreateInfo pipelineVertexInputStateCreateInfo{};
+	pipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+	pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount	= vertexInputBindingDescriptionVector.size();
+	pipelineVertexInputStateCreateInfo.pVertexBindingDescriptions		= vertexInputBindingDescriptionVector.data();
+	pipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount	= vertexInputAttributeDescriptionVector.size();
+	pipelineVertexInputStateCreateInfo.pVertexAttributeDescriptions		= vertexInputAttributeDescriptionVector.data();
+
+	VkPipelineInputAssemblyStateCreateInfo pipelineInputAssemblyStateCreateInfo{};
+	pipelineInputAssemblyStateCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+	pipelineInputAssemblyStateCreateInfo.topology				= VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+	pipelineInputAssemblyStateCreateInfo.primitiveRestartEnable = VK_FALSE;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+
+	VkPipelineViewportStateCreateInfo pipelineViewportStateCreateInfo{};
+	pipelineViewportStateCreateInfo.sType			= VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+	pipelineViewportStateCreateInfo.viewportCount	= 1;
+	pipelineViewportStateCreateInfo.pViewports		= nullptr;	// dynamic state, set while recording
+	pipelineViewportStateCreateInfo.scissorCount	= 1;
+	pipelineViewportStateCreateInfo.pScissors		= nullptr;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineRasterizationStateCreateInfo pipelineRasterizationStateCreateInfo{};
+	pipelineRasterizationStateCreateInfo.sType						= VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+	pipelineRasterizationStateCreateInfo.depthClampEnable			= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.rasterizerDiscardEnable	= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.polygonMode				= VK_POLYGON_MODE_FILL;
+	pipelineRasterizationStateCreateInfo.cullMode					= VK_CULL_MODE_NONE; // the cube is not consistently wound
+	pipelineRasterizationStateCreateInfo.frontFace					= VK_FRONT_FACE_COUNTER_CLOCKWISE;
+	pipelineRasterizationStateCreateInfo.depthBiasEnable			= VK_FALSE;
+	pipelineRasterizationStateCreateInfo.lineWidth					= 1.0f;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineMultisampleStateCreateInfo pipelineMultisampleStateCreateInfo{}; // for anti-aliasing
+	pipelineMultisampleStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+	pipelineMultisampleStateCreateInfo.sampleShadingEnable = VK_FALSE;
+	pipelineMultisampleStateCreateInfo.rasterizationSamples = VK_SAMPLE_COUNT_1_BIT;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	std::vector<VkPipelineColorBlendAttachmentState> pipelineColorBlendAttachmentStateVector;
+	VkPipelineColorBlendAttachmentState pipelineColorBlendAttachmentState{};
+	pipelineColorBlendAttachmentState.colorWriteMask	= VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT
+															| VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
+	pipelineColorBlendAttachmentState.blendEnable		= VK_FALSE;
+	pipelineColorBlendAttachmentStateVector.push_back(pipelineColorBlendAttachmentState);
+
+	VkPipelineColorBlendStateCreateInfo pipelineColorBlendStateCreateInfo{};
+	pipelineColorBlendStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+	pipelineColorBlendStateCreateInfo.logicOpEnable = VK_FALSE;
+	pipelineColorBlendStateCreateInfo.attachmentCount	= (uint32_t)pipelineColorBlendAttachmentStateVector.size();
+	pipelineColorBlendStateCreateInfo.pAttachments		= pipelineColorBlendAttachmentStateVector.data();
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	VkPipelineDepthStencilStateCreateInfo pipelineDepthStencilStateCreateInfo{};
+	pipelineDepthStencilStateCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+	pipelineDepthStencilStateCreateInfo.depthTestEnable			= VK_TRUE;
+	pipelineDepthStencilStateCreateInfo.depthWriteEnable		= VK_TRUE;
+	pipelineDepthStencilStateCreateInfo.depthCompareOp			= VK_COMPARE_OP_LESS;
+	pipelineDepthStencilStateCreateInfo.depthBoundsTestEnable	= VK_FALSE;
+	pipelineDepthStencilStateCreateInfo.stencilTestEnable		= VK_FALSE;
+
+	/*********************************************************************************************/
+	/*********************************************************************************************/
+	std::vector<VkDynamicState> dynamicStateEnablesVector;
+	dynamicStateEnablesVector.push_back(VK_DYNAMIC_STATE_VIEWPORT);
+	dynamicStateEnablesVector.push_back(VK_DYNAMIC_STATE_SCISSOR);
+
+	VkPipelineDynamicStateCreateInfo pipelineDynamicStateCreateInfo{};
+	pipelineDynamicStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+	pipelineDynamicStateCreateInfo.dynamicStateCount = dynamicStateEnablesVector.size();
+	pipelineDynamicStateCreateInfo.pDynamicStates = dynamicStateEnablesVector.data();
+
+	/****************************************************************************************************************************/
+	/**********   Reserve pipeline Layout, which help access to descriptor sets from a pipeline       ***************************/
+	/****************************************************************************************************************************/
+	// Reflected set layouts and push constant range (mat4 model, one per cube), shared with any program of the same signature
+	textureStreamingPipelineLayout = textureStreamingProgram.pipelineLayout;
+
+	/****************************************************************************************************************************/
+	/**********                Create   Pipeline            *********************************************************************/
+	/****************************************************************************************************************************/
+	VkGraphicsPipelineCreateInfo textureStreamingPipelineCreateInfo{};
+	textureStreamingPipelineCreateInfo.sType					= VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+	textureStreamingPipelineCreateInfo.stageCount				= (uint32_t)pipelineShaderStagesCreateInfoVector.size();
+	textureStreamingPipelineCreateInfo.pStages				= pipelineShaderStagesCreateInfoVector.data();
+	textureStreamingPipelineCreateInfo.pDynamicState			= &pipelineDynamicStateCreateInfo;
+	textureStreamingPipelineCreateInfo.pVertexInputState		= &pipelineVertexInputStateCreateInfo;
+	textureStreamingPipelineCreateInfo.pInputAssemblyState	= &pipelineInputAssemblyStateCreateInfo;
+	textureStreamingPipelineCreateInfo.pViewportState			= &pipelineViewportStateCreateInfo;
+	textureStreamingPipelineCreateInfo.pRasterizationState	= &pipelineRasterizationStateCreateInfo;
+	textureStreamingPipelineCreateInfo.pMultisampleState		= &pipelineMultisampleStateCreateInfo;
+	textureStreamingPipelineCreateInfo.pColorBlendState		= &pipelineColorBlendStateCreateInfo;
+	textureStreamingPipelineCreateInfo.pDepthStencilState		= &pipelineDepthStencilStateCreateInfo;
+	textureStreamingPipelineCreateInfo.layout					= textureStreamingPipelineLayout;
+	textureStreamingPipelineCreateInfo.renderPass				= depthTestRenderPass;
+	textureStreamingPipelineCreateInfo.subpass				= 0;
+
+	VkPipeline textureStreamingPipeline = VK_NULL_HANDLE;
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateGraphicsPipelines(m_LogicalDevice, pipelineCache, 1, &textureStreamingPipelineCreateInfo, nullptr, &textureStreamingPipeline),
+		std::string("Failed to create graphics pipeline !!!")
+	);
+	return textureStreamingPipeline;
+}
+
+void Sen_225_TextureStreaming::populateStreamingScene()
+{
+	vertexStructVector = {
+		// Positions							// Texture Coords
+		{ { -0.5f,  0.5f, -0.5f },	{ 1.0f, 0.0f } },	{ { -0.5f, -0.5f, -0.5f },	{ 1.0f, 1.0f } },	// Front
+		{ {  0.5f, -0.5f, -0.5f },	{ 0.0f, 1.0f } },	{ {  0.5f,  0.5f, -0.5f },	{ 0.0f, 0.0f } },
+		{ {  0.5f,  0.5f,  0.5f },	{ 1.0f, 0.0f } },	{ {  0.5f, -0.5f,  0.5f },	{ 1.0f, 1.0f } },	// Back
+		{ { -0.5f, -0.5f,  0.5f },	{ 0.0f, 1.0f } },	{ { -0.5f,  0.5f,  0.5f },	{ 0.0f, 0.0f } },
+		{ { -0.5f,  0.5f,  0.5f },	{ 1.0f, 0.0f } },	{ { -0.5f, -0.5f,  0.5f },	{ 1.0f, 1.0f } },	// Left
+		{ { -0.5f, -0.5f, -0.5f },	{ 0.0f, 1.0f } },	{ { -0.5f,  0.5f, -0.5f },	{ 0.0f, 0.0f } },
+		{ {  0.5f,  0.5f, -0.5f },	{ 1.0f, 0.0f } },	{ {  0.5f, -0.5f, -0.5f },	{ 1.0f, 1.0f } },	// Right
+		{ {  0.5f, -0.5f,  0.5f },	{ 0.0f, 1.0f } },	{ {  0.5f,  0.5f,  0.5f },	{ 0.0f, 0.0f } },
+		{ {  0.5f,  0.5f, -0.5f },	{ 1.0f, 0.0f } },	{ {  0.5f,  0.5f,  0.5f },	{ 1.0f, 1.0f } },	// Top
+		{ { -0.5f,  0.5f,  0.5f },	{ 0.0f, 1.0f } },	{ { -0.5f,  0.5f, -0.5f },	{ 0.0f, 0.0f } },
+		{ { -0.5f, -0.5f, -0.5f },	{ 1.0f, 0.0f } },	{ { -0.5f, -0.5f,  0.5f },	{ 1.0f, 1.0f } },	// Bottom
+		{ {  0.5f, -0.5f,  0.5f },	{ 0.0f, 1.0f } },	{ {  0.5f, -0.5f, -0.5f },	{ 0.0f, 0.0f } }
+	};
+	indexVector.clear();
+	for (uint32_t face = 0; face < 6; face++) {
+		uint32_t first = face * 4;
+		indexVector.insert(indexVector.end(), { first, first + 1, first + 3, first + 1, first + 2, first + 3 });
+	}
+
+	/****************************************************************************************************************************/
+	/**********      One row of cubes, every texture used three times, far more texels than the residency budget      ***********/
+	/****************************************************************************************************************************/
+	const uint32_t cubesCount = 3 * (uint32_t)textureIdVector.size();
+	cubeCenterVector.resize(cubesCount);
+	cubeTextureIndexVector.resize(cubesCount);
+	for (uint32_t cube = 0; cube < cubesCount; cube++) {
+		cubeCenterVector[cube]			= glm::vec3(cube * m_CubeSize * 1.5f, 0.0f, -m_CubeSize);
+		cubeTextureIndexVector[cube]	= cube % (uint32_t)textureIdVector.size();
+	}
+}
+
+void Sen_225_TextureStreaming::createStreamingCubeIndexBuffer()
+{
+	VkDeviceSize indicesBufferSize = sizeof(indexVector[0]) * indexVector.size();
+
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indicesBufferSize,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		streamingCubeIndexBuffer, streamingCubeIndexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	// Queued in the staging ring, submitted with the other uploads before the first frame
+	stagingRing->uploadToBuffer(indexVector.data(), indicesBufferSize, streamingCubeIndexBuffer);
+}
+
+void Sen_225_TextureStreaming::createStreamingCubeVertexBuffer()
+{
+	VkDeviceSize verticesBufferSize = sizeof(vertexStructVector[0]) * vertexStructVector.size();
+
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, verticesBufferSize,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		streamingCubeVertexBuffer, streamingCubeVertexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	stagingRing->uploadToBuffer(vertexStructVector.data(), verticesBufferSize, streamingCubeVertexBuffer);
+}
+
+void Sen_225_TextureStreaming::initStreamedTextures()
+{
+	textureStreamer = new SenTextureStreamer(m_LogicalDevice, m_PhysicalDeviceMemoryProperties, *stagingRing, m_ResidencyBudgetBytes);
+	textureStreamer->setMipGenerationDevice(computeOffloadDevice);	// nullptr keeps them on the CPU
+
+	// All tails in one staging ring batch, a single wait before the descriptor sets take their views
+	textureIdVector = textureStreamer->registerTextures(
+		std::vector<std::string>(textureDiskAddressVector.begin(), textureDiskAddressVector.end()));
+
+	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
+}
+
+void Sen_225_TextureStreaming::createTextureAppDescriptorSetLayout()
+{
+	// Frame slots are resized with the swapchain in createTextureAppDescriptorSets()
+	if (nullptr == descriptorAllocator)
+		descriptorAllocator = new SenDescriptorAllocator(m_LogicalDevice, m_SwapChain_ImagesCount);
+	if (nullptr == shaderReflection)
+		shaderReflection = new SenShaderReflection(m_LogicalDevice, *descriptorAllocator);
+
+	// Bindings, push constants and vertex inputs are read back from the shaders' SPIR-V, not written by hand
+	textureStreamingProgram = shaderReflection->buildProgram({ m_TextureStreamingVertShader, m_TextureStreamingFragShader });
+	m_Default_DSL = textureStreamingProgram.setLayoutVector.at(0);
+}
+
+void Sen_225_TextureStreaming::createTextureAppDescriptorSets()
+{
+	// Called at init, or after a swapchain recreation changed the images count:  the device is idle either way
+	if (descriptorAllocator->framesCount() != m_SwapChain_ImagesCount)
+		descriptorAllocator->resizeFrames(m_SwapChain_ImagesCount);
+
+	descriptorSetImagesCount = m_SwapChain_ImagesCount;
+	streamedCube_DS_Vector.assign(descriptorSetImagesCount * cubeCenterVector.size(), VK_NULL_HANDLE);
+
+	for (uint32_t i = 0; i < descriptorSetImagesCount; i++)
+		writeTextureAppDescriptorSets(i);
+	swapchainImageGenerationVector.assign(descriptorSetImagesCount, textureStreamer->residencyGeneration());
+	swapchainImagePipelineGenerationVector.assign(descriptorSetImagesCount, 0);	// set when createTextureStreamingCommandBuffers() records
+}
+
+void Sen_225_TextureStreaming::writeTextureAppDescriptorSets(const uint32_t& swapchainImageIndex)
+{
+	/************************************************************************************************************/
+	/*********     Reset the image's frame slot in bulk, then ask one set per cube:  5 textures -> 5 sets      **/
+	/************************************************************************************************************/
+	descriptorAllocator->beginFrame(swapchainImageIndex);
+
+	SenDescriptorAllocator::DescriptorWriteStruct mvpUboWrite{};
+	mvpUboWrite.binding				= m_UniformBuffer_DS_BindingIndex;	// binding number, same with the binding index  in shader
+	mvpUboWrite.descriptorType		= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+	mvpUboWrite.bufferInfo.buffer	= mvpOptimalUniformBuffer;
+	mvpUboWrite.bufferInfo.offset	= swapchainImageIndex * mvpUniformRegionStride;	// the sets are per image already, no dynamic offset
+	mvpUboWrite.bufferInfo.range	= sizeof(MvpUniformBufferObject);
+
+	SenDescriptorAllocator::DescriptorWriteStruct combinedImageSamplerWrite{};
+	combinedImageSamplerWrite.binding				= m_COMB_IMA_SAMPLER_DS_BindingIndex; // binding number, same with the binding index  in shader
+	combinedImageSamplerWrite.descriptorType		= VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+	combinedImageSamplerWrite.imageInfo.imageLayout	= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	combinedImageSamplerWrite.imageInfo.sampler		= texture2DSampler;
+
+	for (size_t cube = 0; cube < cubeCenterVector.size(); cube++) {
+		combinedImageSamplerWrite.imageInfo.imageView = textureStreamer->getImageView(textureIdVector[cubeTextureIndexVector[cube]]);
+		streamedCube_DS_Vector[swapchainImageIndex * cubeCenterVector.size() + cube] = descriptorAllocator->getDescriptorSet(
+			swapchainImageIndex, m_Default_DSL, { mvpUboWrite, combinedImageSamplerWrite });
+	}
+}
+
+void Sen_225_TextureStreaming::createTextureStreamingCommandBuffers()
+{
+	/************************************************************************************************************/
+	/*********     Destroy old m_SwapchainCommandBufferVector first for widgetRezie, if there are      ************/
+	/************************************************************************************************************/
+	if (m_SwapchainCommandBufferVector.size() > 0) {
+		vkFreeCommandBuffers(m_LogicalDevice, m_DefaultThreadCommandPool, (uint32_t)m_SwapchainCommandBufferVector.size(), m_SwapchainCommandBufferVector.data());
+	}
+	/****************************************************************************************************************************/
+	/**********           Allocate Swapchain CommandBuffers         *************************************************************/
+	/****************************************************************************************************************************/
+	m_SwapchainCommandBufferVector.resize(m_SwapChain_ImagesCount);
+
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+	commandBufferAllocateInfo.sType			= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.commandPool	= m_DefaultThreadCommandPool;
+	commandBufferAllocateInfo.level			= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount = static_cast<uint32_t>(m_SwapchainCommandBufferVector.size());
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateCommandBuffers(m_LogicalDevice, &commandBufferAllocateInfo, m_SwapchainCommandBufferVector.data()),
+		std::string("Failed to allocate Swapchain commandBuffers !!!")
+	);
+
+	// Device is idle here:  bring every image's sets up to date before recording
+	for (uint32_t i = 0; i < m_SwapchainCommandBufferVector.size(); i++) {
+		if (swapchainImageGenerationVector[i] != textureStreamer->residencyGeneration()) {
+			writeTextureAppDescriptorSets(i);
+			swapchainImageGenerationVector[i] = textureStreamer->residencyGeneration();
+		}
+		recordTextureStreamingCommandBuffer(i);
+		swapchainImagePipelineGenerationVector[i] = shaderHotReloader->pipelineGeneration();
+	}
+}
+
+void Sen_225_TextureStreaming::recordTextureStreamingCommandBuffer(const uint32_t& swapchainImageIndex)
+{
+	/****************************************************************************************************************************/
+	/**********           Record Texture Streaming Swapchain CommandBuffers        **********************************************/
+	/****************************************************************************************************************************/
+	VkCommandBufferBeginInfo commandBufferBeginInfo{};
+	commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	vkBeginCommandBuffer(m_SwapchainCommandBufferVector[swapchainImageIndex], &commandBufferBeginInfo);
+
+	VkRenderPassBeginInfo renderPassBeginInfo{};
+	renderPassBeginInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+	renderPassBeginInfo.renderPass			= depthTestRenderPass;
+	renderPassBeginInfo.framebuffer			= m_SwapchainFramebufferVector[swapchainImageIndex];
+	renderPassBeginInfo.renderArea.offset	= { 0, 0 };
+	renderPassBeginInfo.renderArea.extent.width		= m_WidgetWidth;
+	renderPassBeginInfo.renderArea.extent.height	= m_WidgetHeight;
+
+	std::array<VkClearValue, 2> clearValueArray{};
+	clearValueArray[0].color		= { 0.2f, 0.3f, 0.3f, 1.0f };
+	clearValueArray[1].depthStencil = { 1.0f, 0 };
+	renderPassBeginInfo.clearValueCount = (uint32_t)clearValueArray.size();
+	renderPassBeginInfo.pClearValues	= clearValueArray.data();
+
+	vkCmdBeginRenderPass(m_SwapchainCommandBufferVector[swapchainImageIndex], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+
+	//======================================================================================
+	//======================================================================================
+	vkCmdBindPipeline(m_SwapchainCommandBufferVector[swapchainImageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS,
+		shaderHotReloader->getPipeline(textureStreamingPipelineId));
+	VkDeviceSize offsetDeviceSize = 0;
+	vkCmdBindVertexBuffers(m_SwapchainCommandBufferVector[swapchainImageIndex], 0, 1, &streamingCubeVertexBuffer, &offsetDeviceSize);
+	vkCmdBindIndexBuffer(m_SwapchainCommandBufferVector[swapchainImageIndex], streamingCubeIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+	vkCmdSetViewport(m_SwapchainCommandBufferVector[swapchainImageIndex], 0, 1, &m_SwapchainResize_Viewport);
+	vkCmdSetScissor(m_SwapchainCommandBufferVector[swapchainImageIndex], 0, 1, &m_SwapchainResize_ScissorRect2D);
+
+	for (size_t cube = 0; cube < cubeCenterVector.size(); cube++) {
+		vkCmdBindDescriptorSets(m_SwapchainCommandBufferVector[swapchainImageIndex], VK_PIPELINE_BIND_POINT_GRAPHICS, textureStreamingPipelineLayout, 0, 1,
+			&streamedCube_DS_Vector[swapchainImageIndex * cubeCenterVector.size() + cube], 0, nullptr);
+
+		glm::mat4 cubeModel = glm::scale(glm::translate(glm::mat4(1.0f), cubeCenterVector[cube]), glm::vec3(m_CubeSize));
+		vkCmdPushConstants(m_SwapchainCommandBufferVector[swapchainImageIndex], textureStreamingPipelineLayout,
+			VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(glm::mat4), &cubeModel);
+
+		vkCmdDrawIndexed(m_SwapchainCommandBufferVector[swapchainImageIndex], static_cast<uint32_t>(indexVector.size()), 1, 0, 0, 0);
+	}
+
+	vkCmdEndRenderPass(m_SwapchainCommandBufferVector[swapchainImageIndex]);
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkEndCommandBuffer(m_SwapchainCommandBufferVector[swapchainImageIndex]),
+		std::string("Failed to end record of Texture Streaming Swapchain commandBuffers !!!")
+	);
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#ifndef __Sen_225_TextureStreaming__
+#define __Sen_225_TextureStreaming__
+
+#include "../Support/SLVK_AbstractGLFW.h"
+#include "../Support/SenTinyObjLoader.h"
+#include "../Support/SenTextureStreamer.h"
+#include "../Support/SenDescriptorAllocator.h"
+#include "../Support/SenShaderReflection.h"
+#include "../Support/SenShaderHotReloader.h"
+#include "../Support/SenMemoryTracker.h"
+
+class Sen_225_TextureStreaming :	public SLVK_AbstractGLFW
+{
+public:
+	Sen_225_TextureStreaming();
+	virtual ~Sen_225_TextureStreaming();
+
+protected:
+	void prefetchStartupAssets();
+	void initVulkanApplication();
+	void reCreateRenderTarget(); // for resize window
+	void finalizeWidget();
+
+	void cleanUpDepthStencil();
+	void updateUniformBuffer();
+	void updateSwapchainImageResources(const uint32_t& swapchainImageIndex);
+
+private:
+	void populateStreamingScene();
+	void createStreamingCubeIndexBuffer();
+	void createStreamingCubeVertexBuffer();
+	void createTextureStreamingCommandBuffers();
+	void recordTextureStreamingCommandBuffer(const uint32_t& swapchainImageIndex);
+
+	void initStreamedTextures();
+	void createTextureStreamingPipeline();
+	VkPipeline buildTextureStreamingPipeline(const VkPipelineCache& pipelineCache, const std::vector<VkShaderModule>& shaderModuleVector) const;
+	void createTextureAppDescriptorSetLayout();
+	void createTextureAppDescriptorSets();
+	void writeTextureAppDescriptorSets(const uint32_t& swapchainImageIndex);
+
+	/*****************************************************************************************************************/
+	/*------------------------     For Resources Descrition       ---------------------------------------------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	/* uniform values need to be specified during pipeline creation by creating a VkPipelineLayout object */
+	// Frame slot i belongs to swapchain image i:  resetting it never touches a commandBuffer still in flight
+	SenDescriptorAllocator*			descriptorAllocator					= nullptr;
+	VkDescriptorSetLayout			m_Default_DSL						= VK_NULL_HANDLE;	// owned by descriptorAllocator's layout cache
+	// One set per (swapchain image, cube), cubes sharing a texture share the deduplicated set
+	std::vector<VkDescriptorSet>	streamedCube_DS_Vector;
+	uint32_t						descriptorSetImagesCount			= 0;
+	MvpUniformBufferObject			frameMvpUniform;					// uploaded into the MVP region of each acquired swapchain image
+
+	const int						m_COMB_IMA_SAMPLER_DS_BindingIndex	= 3;
+	VkSampler						texture2DSampler					= VK_NULL_HANDLE;
+
+	VkBuffer						streamingCubeVertexBuffer			= VK_NULL_HANDLE;
+	VkDeviceMemory					streamingCubeVertexBufferMemory		= VK_NULL_HANDLE;
+	VkBuffer						streamingCubeIndexBuffer			= VK_NULL_HANDLE;
+	VkDeviceMemory					streamingCubeIndexBufferMemory		= VK_NULL_HANDLE;
+
+	VkPipelineLayout				textureStreamingPipelineLayout		= VK_NULL_HANDLE;	// owned by shaderReflection
+	// The pipeline itself lives in shaderHotReloader, rebuilt whenever one of its shaders is saved
+	SenShaderHotReloader*			shaderHotReloader					= nullptr;
+	uint32_t						textureStreamingPipelineId			= 0;
+	std::vector<uint64_t>			swapchainImagePipelineGenerationVector;	// hot-reload generation each swapchain image was recorded with
+
+	SenShaderReflection*			shaderReflection					= nullptr;
+	SenShaderReflection::ReflectedProgramStruct	textureStreamingProgram;
+	const std::string				m_TextureStreamingVertShader		= "SenVulkanTutorial/Shaders/textureStreaming.vert";
+	const std::string				m_TextureStreamingFragShader		= "SenVulkanTutorial/Shaders/loadModelObj.frag";
+
+	std::vector<VertexStruct>		vertexStructVector;
+	std::vector<uint32_t>			indexVector;
+
+	/*****************************************************************************************************************/
+	/*-----------    Streamed textures: one mip chain each, residency follows each cube's screen size   -------------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	SenTextureStreamer*				textureStreamer						= nullptr;
+	std::vector<const char*>		textureDiskAddressVector;
+	std::vector<uint32_t>			textureIdVector;
+	std::vector<glm::vec3>			cubeCenterVector;
+	std::vector<uint32_t>			cubeTextureIndexVector;			// into textureIdVector
+	const float						m_CubeSize							= 4.0f;
+	const VkDeviceSize				m_ResidencyBudgetBytes				= 32 * 1024 * 1024;
+	const VkDeviceSize				m_FrameUploadByteBudget				= 4 * 1024 * 1024;
+	uint64_t						frameNumber							= 0;
+	std::vector<uint64_t>			swapchainImageGenerationVector;	// streamer generation each swapchain image's sets were written with
+
+	std::chrono::high_resolution_clock::time_point	residencyReportTime;
+};
+
+
+#endif // !__Sen_225_TextureStreaming__
@@ -17,6 +17,13 @@ Sen_22_DepthTest::~Sen_22_DepthTest()
 	OutputDebugString("\n\t ~Sen_22_DepthTest()\n");
 }
 
+void Sen_22_DepthTest::prefetchStartupAssets()
+{
+	prefetchShader("SenVulkanTutorial/Shaders/depthTest.vert");
+	prefetchShader("SenVulkanTutorial/Shaders/depthTest.frag");
+	prefetchTexture(backgroundTextureDiskAddress);
+}
+
 void Sen_22_DepthTest::initVulkanApplication()
 {
 	createTextureAppDescriptorSetLayout();
@@ -55,7 +62,7 @@ void Sen_22_DepthTest::cleanUpDepthStencil()
 		if (VK_NULL_HANDLE != depthTestImageView)
 			vkDestroyImageView(m_LogicalDevice, depthTestImageView, nullptr);
 		if (VK_NULL_HANDLE != depthTestImageDeviceMemory)
-			vkFreeMemory(m_LogicalDevice, depthTestImageDeviceMemory, nullptr); 	// always try to destroy before free
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, depthTestImageDeviceMemory); 	// always try to destroy before free
 
 		depthTestImage = VK_NULL_HANDLE;
 		depthTestImageView = VK_NULL_HANDLE;
@@ -121,7 +128,7 @@ void Sen_22_DepthTest::finalizeWidget()
 		if (VK_NULL_HANDLE != texture2DSampler)  
 			vkDestroySampler(m_LogicalDevice, texture2DSampler, nullptr);
 		if (VK_NULL_HANDLE != backgroundTextureImageDeviceMemory)
-			vkFreeMemory(m_LogicalDevice, backgroundTextureImageDeviceMemory, nullptr); 	// always try to destroy before free
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, backgroundTextureImageDeviceMemory); 	// always try to destroy before free
 
 		backgroundTextureImage				= VK_NULL_HANDLE;
 		backgroundTextureImageDeviceMemory	= VK_NULL_HANDLE;
@@ -133,7 +140,7 @@ void Sen_22_DepthTest::finalizeWidget()
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != depthTestVertexBuffer) {
 		vkDestroyBuffer(m_LogicalDevice, depthTestVertexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, depthTestVertexBufferMemory, nullptr);	// always try to destroy before free
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, depthTestVertexBufferMemory);	// always try to destroy before free
 
 		depthTestVertexBuffer			= VK_NULL_HANDLE;
 		depthTestVertexBufferMemory	= VK_NULL_HANDLE;
@@ -392,7 +399,7 @@ void Sen_22_DepthTest::createDepthTestIndexBuffer()
 		singleRectIndexBuffer, indicesBufferSize);
 
 	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, stagingBufferDeviceMemory);	// always try to destroy before free
 }
 
 void Sen_22_DepthTest::createDepthTestVertexBuffer()
@@ -438,7 +445,7 @@ void Sen_22_DepthTest::createDepthTestVertexBuffer()
 		depthTestVertexBuffer, verticesBufferSize);
 
 	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, stagingBufferDeviceMemory);	// always try to destroy before free
 }
 
 void Sen_22_DepthTest::initBackgroundTextureImage()
@@ -446,7 +453,7 @@ void Sen_22_DepthTest::initBackgroundTextureImage()
 	SLVK_AbstractGLFW::createDeviceLocalTexture(m_LogicalDevice, m_PhysicalDeviceMemoryProperties
 		, backgroundTextureDiskAddress, VK_IMAGE_TYPE_2D, backgroundTextureWidth, backgroundTextureHeight
 		, backgroundTextureImage, backgroundTextureImageDeviceMemory, backgroundTextureImageView
-		, VK_SHARING_MODE_EXCLUSIVE, m_DefaultThreadCommandPool, m_GraphicsQueue);
+		, VK_SHARING_MODE_EXCLUSIVE, *stagingRing);
 
 	SLVK_AbstractGLFW::createTextureSampler(m_LogicalDevice, texture2DSampler);
 }
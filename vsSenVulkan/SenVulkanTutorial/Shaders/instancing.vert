@@ -0,0 +1,28 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+/*
+	uniform values in shaders, are globals similar to dynamic state variables;
+	can be changed at drawing time to alter the behavior of your shaders without having to recreate them.
+*/
+const int m_UniformBuffer_DS_BindingIndex = 0;
+layout(binding = m_UniformBuffer_DS_BindingIndex) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+layout(location = 0) in vec3 inPosition;
+layout(location = 1) in vec2 inTexCoord;
+// Per-instance stream (VK_VERTEX_INPUT_RATE_INSTANCE), a mat4 occupies locations 2 ~ 5
+layout(location = 2) in mat4 instanceModel;
+
+layout(location = 0) out vec2 fragTexCoord;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+void main() {
+    gl_Position = ubo.proj * ubo.view * ubo.model * instanceModel * vec4(inPosition, 1.0);
+    fragTexCoord = inTexCoord;
+}
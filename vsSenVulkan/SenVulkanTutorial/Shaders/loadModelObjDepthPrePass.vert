@@ -0,0 +1,27 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+/*
+	Depth pre-pass:  positions only, pulled from their own tightly packed range of the geometry arena (3 floats per vertex),
+	and no fragment shader.  gl_Position has to come out bit-identical to loadModelObjMvp.vert, the color pass tests
+	depth with EQUAL:  same uniform, same expression, invariant in both.
+*/
+const int m_UniformBuffer_DS_BindingIndex = 0;
+layout(binding = m_UniformBuffer_DS_BindingIndex) uniform PrecomputedMvpUniformObject {
+    layout(offset = 192) mat4 modelViewProjection;
+} ubo;
+
+const int m_GeometryArena_DS_BindingIndex = 1;
+layout(std430, binding = m_GeometryArena_DS_BindingIndex) readonly buffer GeometryArena {
+    float arenaFloats[];
+};
+
+out gl_PerVertex {
+    invariant vec4 gl_Position;
+};
+
+void main() {
+    uint positionFloat = uint(gl_VertexIndex) * 3;
+    vec3 inPosition = vec3(arenaFloats[positionFloat], arenaFloats[positionFloat + 1], arenaFloats[positionFloat + 2]);
+
+    gl_Position = ubo.modelViewProjection * vec4(inPosition, 1.0);
+}
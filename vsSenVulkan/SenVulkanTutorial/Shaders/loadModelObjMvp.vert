@@ -0,0 +1,32 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+/*
+	model-view-projection is multiplied once per frame on the CPU, one mat4 * vec4 per vertex is left here;
+	model, view and proj in front of it are only read by loadModelObjThreeMatrix.vert, the three-matrix comparison path.
+	gl_Position is invariant:  after loadModelObjDepthPrePass.vert it is depth tested with EQUAL.
+	No vertex input:  the VertexStruct (vec3 position, vec2 texCoord, 5 floats) is pulled from the geometry arena,
+	gl_VertexIndex already includes the draw's vertexOffset, the first vertex of the mesh in the arena.
+*/
+const int m_UniformBuffer_DS_BindingIndex = 0;
+layout(binding = m_UniformBuffer_DS_BindingIndex) uniform PrecomputedMvpUniformObject {
+    layout(offset = 192) mat4 modelViewProjection;
+} ubo;
+
+const int m_GeometryArena_DS_BindingIndex = 1;
+layout(std430, binding = m_GeometryArena_DS_BindingIndex) readonly buffer GeometryArena {
+    float arenaFloats[];
+};
+
+layout(location = 0) out vec2 fragTexCoord;
+
+out gl_PerVertex {
+    invariant vec4 gl_Position;
+};
+
+void main() {
+    uint vertexFloat = uint(gl_VertexIndex) * 5;
+    vec3 inPosition = vec3(arenaFloats[vertexFloat], arenaFloats[vertexFloat + 1], arenaFloats[vertexFloat + 2]);
+
+    gl_Position = ubo.modelViewProjection * vec4(inPosition, 1.0);
+    fragTexCoord = vec2(arenaFloats[vertexFloat + 3], arenaFloats[vertexFloat + 4]);
+}
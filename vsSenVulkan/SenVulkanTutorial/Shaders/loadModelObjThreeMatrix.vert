@@ -0,0 +1,31 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+/*
+	loadModelObj.vert with its vertices pulled from the geometry arena, like loadModelObjMvp.vert:
+	proj * view * model for every vertex, kept as the comparison path of the precomputed MVP.
+*/
+const int m_UniformBuffer_DS_BindingIndex = 0;
+layout(binding = m_UniformBuffer_DS_BindingIndex) uniform UniformBufferObject {
+    mat4 model;
+    mat4 view;
+    mat4 proj;
+} ubo;
+
+const int m_GeometryArena_DS_BindingIndex = 1;
+layout(std430, binding = m_GeometryArena_DS_BindingIndex) readonly buffer GeometryArena {
+    float arenaFloats[];
+};
+
+layout(location = 0) out vec2 fragTexCoord;
+
+out gl_PerVertex {
+    vec4 gl_Position;
+};
+
+void main() {
+    uint vertexFloat = uint(gl_VertexIndex) * 5;
+    vec3 inPosition = vec3(arenaFloats[vertexFloat], arenaFloats[vertexFloat + 1], arenaFloats[vertexFloat + 2]);
+
+    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    fragTexCoord = vec2(arenaFloats[vertexFloat + 3], arenaFloats[vertexFloat + 4]);
+}
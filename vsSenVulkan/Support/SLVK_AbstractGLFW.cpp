@@ -1,11 +1,79 @@
 #include "pch.h"
 #include "SLVK_AbstractGLFW.h"
+#include "SenMemoryTracker.h"
+#include "SenStagingRing.h"
+#include "SenStartupPipeline.h"
+#include "SenComputeOffloadDevice.h"
+#include "SenQueueTimeline.h"
+#include "SenBarrierBatch.h"
+#include "SenKtxFile.h"
+#include "SenHostImageCopy.h"
+#include "SenJobSystem.h"
 
 // Since stb_image.h header file contains the implementation of functions, only one class source file could include it to make new implementation
 // all stb_image realated functions have to be implemented in this class
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb/stb_image.h>
-#include <gli/gli.hpp> // to load KTX image file
+#include <thread>		// frame limiter sleep, startup prefetch owner thread
+#include <cmath>
+#include <memory>
+#include <mutex>
+
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+/*****   Startup prefetch:  results of SLVK_AbstractGLFW::prefetchShader() / prefetchTexture(), keyed by disk address        *****/
+/*****   Taken (at most once) by the static loaders, only on the thread that prefetched, since waitStep() is main thread only *****/
+/*---------------------------------------------------------------------------------------------------------------------------------*/
+struct PrefetchedShaderStruct {
+	std::vector<uint32_t>				spirv32Vector;
+};
+struct PrefetchedTextureStruct {
+	stbi_uc*							ptrPixels				= nullptr;	// stb decoded, STBI_rgb_alpha
+	int									textureWidth			= 0;
+	int									textureHeight			= 0;
+	std::unique_ptr<SenKtxFile>			ktxFile;							// .ktx / .ktx2 files, mapped and paged in
+	~PrefetchedTextureStruct() { if (nullptr != ptrPixels) stbi_image_free(ptrPixels); }
+};
+template <typename PrefetchedType>
+struct PrefetchEntryStruct {
+	SenStartupPipeline*					startupPipeline			= nullptr;
+	std::string							stepName;
+	std::thread::id						ownerThreadId;
+	std::shared_ptr<PrefetchedType>		prefetchedResult;
+};
+static std::mutex prefetchMapsMutex;
+static std::map<std::string, PrefetchEntryStruct<PrefetchedShaderStruct>>	prefetchedShaderMap;
+static std::map<std::string, PrefetchEntryStruct<PrefetchedTextureStruct>>	prefetchedTextureMap;
+
+// nullptr when diskFileAddress was not prefetched (or by another thread), rethrows when its step failed
+template <typename PrefetchedType>
+static std::shared_ptr<PrefetchedType> takePrefetchedResult(std::map<std::string, PrefetchEntryStruct<PrefetchedType>>& prefetchedMap,
+	const std::string& diskFileAddress)
+{
+	PrefetchEntryStruct<PrefetchedType> prefetchEntry;
+	{
+		std::lock_guard<std::mutex> prefetchMapsLock(prefetchMapsMutex);
+		auto prefetchEntryIterator = prefetchedMap.find(diskFileAddress);
+		if (prefetchEntryIterator == prefetchedMap.end() || prefetchEntryIterator->second.ownerThreadId != std::this_thread::get_id())
+			return nullptr;
+		prefetchEntry = prefetchEntryIterator->second;
+		prefetchedMap.erase(prefetchEntryIterator);
+	}
+	prefetchEntry.startupPipeline->waitStep(prefetchEntry.stepName);
+	return prefetchEntry.prefetchedResult;
+}
+
+template <typename PrefetchedType>
+static void discardPrefetchedResults(std::map<std::string, PrefetchEntryStruct<PrefetchedType>>& prefetchedMap,
+	const SenStartupPipeline* startupPipeline)
+{
+	std::lock_guard<std::mutex> prefetchMapsLock(prefetchMapsMutex);
+	for (auto prefetchEntryIterator = prefetchedMap.begin(); prefetchEntryIterator != prefetchedMap.end(); ) {
+		if (prefetchEntryIterator->second.startupPipeline == startupPipeline)
+			prefetchEntryIterator = prefetchedMap.erase(prefetchEntryIterator);
+		else
+			++prefetchEntryIterator;
+	}
+}
 
 /****************************************************************************************************************************/
 /****************************************************************************************************************************/
@@ -129,26 +197,39 @@ void SLVK_AbstractGLFW::errorCheck(VkResult result, std::string msg)
 
 
 void SLVK_AbstractGLFW::createVulkanShaderModule(const VkDevice& logicalDevice, const std::string& diskFileAddress, VkShaderModule& shaderModule) {
-	std::vector<char> spirvCharVector;// (spirv32Vector.size() * sizeof(uint32_t) / sizeof(char));
+	createVulkanShaderModule(logicalDevice, SLVK_AbstractGLFW::compileShaderToSPIRV(diskFileAddress), shaderModule);
+}
 
-	if (diskFileAddress.substr(diskFileAddress.length() - 4, 4).compare(".spv") == 0)
-		spirvCharVector = SLVK_AbstractGLFW::readFileStream(diskFileAddress, true);
-	else {
-		std::string shaderTypeString = diskFileAddress.substr(diskFileAddress.length() - 5, 5);
-		shaderc_shader_kind shadercType;
-		if (shaderTypeString.compare(".vert") == 0)		shadercType = shaderc_glsl_vertex_shader;
-		else if (shaderTypeString.compare(".frag") == 0)		shadercType = shaderc_glsl_fragment_shader;
-		else if (shaderTypeString.compare(".geom") == 0)		shadercType = shaderc_glsl_geometry_shader;
-		else assert(false);
-		// Android system Attension:   sourceString size for shadercToSPIRV() below may change.
-		std::vector<uint32_t> spirv32Vector = SLVK_AbstractGLFW::shadercToSPIRV("glShaderSrc", shadercType, SLVK_AbstractGLFW::readFileStream(diskFileAddress).data());
-		spirvCharVector.resize(spirv32Vector.size() * sizeof(uint32_t) / sizeof(char));
-		memcpy(spirvCharVector.data(), spirv32Vector.data(), spirvCharVector.size());
-	}
+void SLVK_AbstractGLFW::createVulkanShaderModule(const VkDevice& logicalDevice, const std::vector<uint32_t>& spirv32Vector, VkShaderModule& shaderModule) {
+	std::vector<char> spirvCharVector(spirv32Vector.size() * sizeof(uint32_t) / sizeof(char));
+	memcpy(spirvCharVector.data(), spirv32Vector.data(), spirvCharVector.size());
 
 	createShaderModuleFromSPIRV(logicalDevice, spirvCharVector, shaderModule);
 }
 
+std::vector<uint32_t> SLVK_AbstractGLFW::compileShaderToSPIRV(const std::string& diskFileAddress) {
+	std::shared_ptr<PrefetchedShaderStruct> prefetchedShader = takePrefetchedResult(prefetchedShaderMap, diskFileAddress);
+	if (nullptr != prefetchedShader)
+		return std::move(prefetchedShader->spirv32Vector);
+
+	if (diskFileAddress.substr(diskFileAddress.length() - 4, 4).compare(".spv") == 0) {
+		std::vector<char> spirvCharVector = SLVK_AbstractGLFW::readFileStream(diskFileAddress, true);
+		std::vector<uint32_t> spirv32Vector(spirvCharVector.size() * sizeof(char) / sizeof(uint32_t));
+		memcpy(spirv32Vector.data(), spirvCharVector.data(), spirv32Vector.size() * sizeof(uint32_t));
+		return spirv32Vector;
+	}
+
+	std::string shaderTypeString = diskFileAddress.substr(diskFileAddress.length() - 5, 5);
+	shaderc_shader_kind shadercType;
+	if (shaderTypeString.compare(".vert") == 0)		shadercType = shaderc_glsl_vertex_shader;
+	else if (shaderTypeString.compare(".frag") == 0)		shadercType = shaderc_glsl_fragment_shader;
+	else if (shaderTypeString.compare(".geom") == 0)		shadercType = shaderc_glsl_geometry_shader;
+	else if (shaderTypeString.compare(".comp") == 0)		shadercType = shaderc_glsl_compute_shader;
+	else assert(false);
+	// Android system Attension:   sourceString size for shadercToSPIRV() below may change.
+	return SLVK_AbstractGLFW::shadercToSPIRV(diskFileAddress, shadercType, SLVK_AbstractGLFW::readFileStream(diskFileAddress).data());
+}
+
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 const std::vector<VkFormat> SLVK_AbstractGLFW::depthStencilSupportCheckFormatsVector = {
@@ -202,12 +283,18 @@ void SLVK_AbstractGLFW::endSingleTimeCommandBuffer(const VkCommandPool& tmpComma
 	tmpCommandBufferSubmitInfo.commandBufferCount = 1;
 	tmpCommandBufferSubmitInfo.pCommandBuffers = &tmpCommandBufferToEnd;
 
-	vkQueueSubmit(tmpCommandBufferQueue, 1, &tmpCommandBufferSubmitInfo, VK_NULL_HANDLE);
 	// There are again two possible ways to wait on this transfer to complete:
 	//   1. We could use a fence and wait with vkWaitForFences, which would allow you to schedule multiple transfers simultaneously 
 	//			and wait for all of them complete, instead of executing one at a time;
 	//   2. Simply wait for the transfer queue to become idle with vkQueueWaitIdle.
-	vkQueueWaitIdle(tmpCommandBufferQueue);
+	// The queue's SenQueueTimeline does the first:  only this submission is waited, not whatever else runs on the queue
+	SenQueueTimeline* queueTimeline = SenQueueTimeline::findQueueTimeline(tmpCommandBufferQueue);
+	if (nullptr != queueTimeline)
+		queueTimeline->waitUntil(queueTimeline->submit(tmpCommandBufferToEnd));
+	else {
+		vkQueueSubmit(tmpCommandBufferQueue, 1, &tmpCommandBufferSubmitInfo, VK_NULL_HANDLE);
+		vkQueueWaitIdle(tmpCommandBufferQueue);
+	}
 	vkFreeCommandBuffers(logicalDevice, tmpCommandBufferCommandPool, 1, &tmpCommandBufferToEnd);
 }
 
@@ -241,10 +328,17 @@ void SLVK_AbstractGLFW::createResourceBuffer(const VkDevice& logicalDevice, cons
 		vkAllocateMemory(logicalDevice, &bufferMemoryAllocateInfo, nullptr, &bufferDeviceMemoryToAllocate),
 		std::string("Failed to allocate m_TriangleVertexBufferMemory !!!")
 	);
+	SenMemoryTracker::recordAllocation(bufferDeviceMemoryToAllocate, bufferMemoryAllocateInfo.allocationSize, bufferMemoryAllocateInfo.memoryTypeIndex,
+		SenMemoryTracker::categoryFromBufferUsage(bufferUsageFlags, requiredMemoryPropertyFlags));
 
 	vkBindBufferMemory(logicalDevice, bufferToCreate, bufferDeviceMemoryToAllocate, 0);
 }
 
+void SLVK_AbstractGLFW::freeDeviceMemory(const VkDevice& logicalDevice, const VkDeviceMemory& deviceMemoryToFree) {
+	SenMemoryTracker::recordFree(deviceMemoryToFree);
+	vkFreeMemory(logicalDevice, deviceMemoryToFree, nullptr);
+}
+
 void SLVK_AbstractGLFW::transferResourceBuffer(const VkCommandPool& bufferTransferCommandPool, const VkDevice& logicalDevice, const VkQueue& bufferMemoryTransferQueue,
 	const VkBuffer& srcBuffer, const VkBuffer& dstBuffer, const VkDeviceSize& resourceBufferSize) {
 
@@ -259,6 +353,20 @@ void SLVK_AbstractGLFW::transferResourceBuffer(const VkCommandPool& bufferTransf
 	bufferCopyCommandBuffer = VK_NULL_HANDLE;
 }
 
+void SLVK_AbstractGLFW::createPersistentMappedBuffer(const VkDevice& logicalDevice, const VkDeviceSize& bufferDeviceSize,
+	const VkBufferUsageFlags& bufferUsageFlags, const VkSharingMode& bufferSharingMode, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+	VkBuffer& bufferToCreate, VkDeviceMemory& bufferDeviceMemoryToAllocate, void*& persistentMappedData) {
+	// Host coherent memory is mapped once for its whole life time, no vkFlushMappedMemoryRanges needed after each write;
+	// vkFreeMemory implicitly unmaps it, so the owner only needs the usual destroy-before-free clean up.
+	SLVK_AbstractGLFW::createResourceBuffer(logicalDevice, bufferDeviceSize, bufferUsageFlags, bufferSharingMode, gpuMemoryProperties,
+		bufferToCreate, bufferDeviceMemoryToAllocate, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkMapMemory(logicalDevice, bufferDeviceMemoryToAllocate, 0, bufferDeviceSize, 0, &persistentMappedData),
+		std::string("Failed to map persistent mapped buffer memory !!!")
+	);
+}
+
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 void SLVK_AbstractGLFW::createResourceImage(const VkDevice& logicalDevice,const uint32_t& imageWidth, const uint32_t& imageHeight
@@ -317,57 +425,100 @@ void SLVK_AbstractGLFW::createResourceImage(const VkDevice& logicalDevice,const
 		vkAllocateMemory(logicalDevice, &imageMemoryAllocateInfo, nullptr, &imageDeviceMemoryToAllocate),
 		std::string("Failed to allocate reource image memory !!!")
 	);
+	SenMemoryTracker::recordAllocation(imageDeviceMemoryToAllocate, imageMemoryAllocateInfo.allocationSize, imageMemoryAllocateInfo.memoryTypeIndex,
+		SenMemoryTracker::categoryFromImageUsage(imageUsageFlags));
 
 	vkBindImageMemory(logicalDevice, imageToCreate, imageDeviceMemoryToAllocate, 0);
 }
 
+void SLVK_AbstractGLFW::createTransientAttachmentImage(const VkDevice& logicalDevice, const uint32_t& imageWidth, const uint32_t& imageHeight
+	, const VkFormat& imageFormat, const VkImageUsageFlags& attachmentUsageFlags, const std::string& attachmentName
+	, VkImage& imageToCreate, VkDeviceMemory& imageDeviceMemoryToAllocate, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties)
+{
+	if (~(VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT) & attachmentUsageFlags)
+		throw std::runtime_error("Illegal attachmentUsageFlags to create transient attachment " + attachmentName + " !!!");
+
+	VkImageCreateInfo imageCreateInfo{};
+	imageCreateInfo.sType			= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.imageType		= VK_IMAGE_TYPE_2D;
+	imageCreateInfo.extent			= { imageWidth, imageHeight, 1 };
+	imageCreateInfo.mipLevels		= 1;
+	imageCreateInfo.arrayLayers		= 1;
+	imageCreateInfo.format			= imageFormat;
+	imageCreateInfo.tiling			= VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.initialLayout	= VK_IMAGE_LAYOUT_UNDEFINED;	// cleared by the render pass, never holds data before it
+	imageCreateInfo.usage			= attachmentUsageFlags | VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+	imageCreateInfo.samples			= VK_SAMPLE_COUNT_1_BIT;
+	imageCreateInfo.sharingMode		= VK_SHARING_MODE_EXCLUSIVE;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateImage(logicalDevice, &imageCreateInfo, nullptr, &imageToCreate),
+		std::string("Failed to create transient attachment " + attachmentName + " !!!")
+	);
+	/***********************************************************************************************************************************************/
+	VkMemoryRequirements imageMemoryRequirements{};
+	vkGetImageMemoryRequirements(logicalDevice, imageToCreate, &imageMemoryRequirements);
+
+	VkMemoryAllocateInfo imageMemoryAllocateInfo{};
+	imageMemoryAllocateInfo.sType			= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	imageMemoryAllocateInfo.allocationSize	= imageMemoryRequirements.size;
+	bool lazilyAllocated = SLVK_AbstractGLFW::findLazilyAllocatedMemoryTypeIndex(gpuMemoryProperties, imageMemoryRequirements,
+		imageMemoryAllocateInfo.memoryTypeIndex);
+	if (!lazilyAllocated)
+		imageMemoryAllocateInfo.memoryTypeIndex
+			= SLVK_AbstractGLFW::findPhysicalDeviceMemoryPropertyIndex(gpuMemoryProperties, imageMemoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateMemory(logicalDevice, &imageMemoryAllocateInfo, nullptr, &imageDeviceMemoryToAllocate),
+		std::string("Failed to allocate transient attachment memory !!!")
+	);
+	SenMemoryTracker::recordAllocation(imageDeviceMemoryToAllocate, imageMemoryAllocateInfo.allocationSize, imageMemoryAllocateInfo.memoryTypeIndex,
+		SenMemoryTracker::MEMORY_CATEGORY_ATTACHMENT);
+
+	vkBindImageMemory(logicalDevice, imageToCreate, imageDeviceMemoryToAllocate, 0);
+	SLVK_AbstractGLFW::reportTransientAttachment(attachmentName, imageMemoryRequirements.size, lazilyAllocated);
+}
+
+bool SLVK_AbstractGLFW::findLazilyAllocatedMemoryTypeIndex(const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties
+	, const VkMemoryRequirements& memoryRequirements, uint32_t& lazilyAllocatedMemoryTypeIndex)
+{
+	for (uint32_t gpuMemoryTypeIndex = 0; gpuMemoryTypeIndex < gpuMemoryProperties.memoryTypeCount; ++gpuMemoryTypeIndex) {
+		if ((memoryRequirements.memoryTypeBits & (1 << gpuMemoryTypeIndex))
+			&& (gpuMemoryProperties.memoryTypes[gpuMemoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT)) {
+			lazilyAllocatedMemoryTypeIndex = gpuMemoryTypeIndex;
+			return true;
+		}
+	}
+	return false;
+}
+
+void SLVK_AbstractGLFW::reportTransientAttachment(const std::string& attachmentName, const VkDeviceSize& attachmentBytes, const bool& lazilyAllocated)
+{
+	std::ostringstream stream;
+	stream << "Transient attachment " << attachmentName << ":  " << attachmentBytes / 1024 << " KB ";
+	if (lazilyAllocated)	// committed only if the tiles spill, and never loaded from or stored to memory
+		stream << "lazily allocated, saves the memory and its per frame load/store bandwidth\n";
+	else
+		stream << "device local (no lazily allocated memory type), storeOp DONT_CARE still saves the per frame store bandwidth\n";
+	std::cout << stream.str();
+}
+
 void SLVK_AbstractGLFW::transitionResourceImageLayout(const VkImage& imageToTransitionLayout
 	,const VkImageSubresourceRange& imageSubresourceRangeToTransition, const VkImageLayout& oldImageLayout, const VkImageLayout& newImageLayout
 	,const VkDevice& logicalDevice ,const VkCommandPool& transitionImageLayoutCommandPool  ,const VkQueue& imageMemoryTransferQueue) {
 	
-	if (newImageLayout == VK_IMAGE_LAYOUT_UNDEFINED || newImageLayout == VK_IMAGE_LAYOUT_PREINITIALIZED)
-		throw std::runtime_error(" The newImageLayout must not be VK_IMAGE_LAYOUT_UNDEFINED or VK_IMAGE_LAYOUT_PREINITIALIZED  !!!");
-
 	// Transitions can happen with an image memory barrier, included as part of a vkCmdPipelineBarrier;
 	//								or a vkCmdWaitEvents command buffer command;
 	//								or as part of a subpass dependency within a render pass(see VkSubpassDependency
 	//										, like transitions between swapchain colorImage for framebuffer paiting and presentation);
-	VkImageMemoryBarrier imageMemoryBarrier{};
-	imageMemoryBarrier.sType							= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-	imageMemoryBarrier.oldLayout						= oldImageLayout; // current layout of the image subresource or else be VK_IMAGE_LAYOUT_UNDEFINED
-	imageMemoryBarrier.newLayout						= newImageLayout; // must not be VK_IMAGE_LAYOUT_UNDEFINED or VK_IMAGE_LAYOUT_PREINITIALIZED.
-	imageMemoryBarrier.srcQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED; // must be VK_QUEUE_FAMILY_IGNORED instead of 0
-	imageMemoryBarrier.dstQueueFamilyIndex				= VK_QUEUE_FAMILY_IGNORED; // must be VK_QUEUE_FAMILY_IGNORED instead of 0
-	imageMemoryBarrier.image							= imageToTransitionLayout;
-	imageMemoryBarrier.subresourceRange					= imageSubresourceRangeToTransition;
-
-	if		(oldImageLayout == VK_IMAGE_LAYOUT_PREINITIALIZED && newImageLayout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
-		imageMemoryBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;	// the first access scope includes command buffer submission (HOST_WRITE)
-		imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-	}else if (oldImageLayout == VK_IMAGE_LAYOUT_PREINITIALIZED && newImageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) {
-		imageMemoryBarrier.srcAccessMask = VK_ACCESS_HOST_WRITE_BIT;	// the first access scope includes command buffer submission (HOST_WRITE)
-		imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-	}else if (oldImageLayout == VK_IMAGE_LAYOUT_PREINITIALIZED && newImageLayout == VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL) {
-		imageMemoryBarrier.srcAccessMask = 0;
-		imageMemoryBarrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-	}else if (oldImageLayout == VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL && newImageLayout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
-		imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		imageMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-	}else {
-		throw std::invalid_argument("unsupported layout transition!");
-	}
+	// One submit and wait for this transition alone:  uploads queue theirs in SenStagingRing::transitionImageLayout() instead,
+	//   recording code adds them to a SenBarrierBatch
+	SenBarrierBatch transitionBarrierBatch;
+	transitionBarrierBatch.addImageLayoutTransition(imageToTransitionLayout, imageSubresourceRangeToTransition, oldImageLayout, newImageLayout);
 
 	VkCommandBuffer transitionImageLayoutCommandBuffer = VK_NULL_HANDLE;
 	SLVK_AbstractGLFW::beginSingleTimeCommandBuffer(transitionImageLayoutCommandPool, logicalDevice, transitionImageLayoutCommandBuffer);
-	vkCmdPipelineBarrier(
-		transitionImageLayoutCommandBuffer,
-		VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,		// srcStageMask
-		VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,		// dstStageMask
-		0,						// dependencyFlags, framebuffer-global instead of framebuffer-local 
-		0, nullptr,	0, nullptr, // VkMemoryBarrier or VkBufferMemoryBarrirer related
-		1,						// imageMemoryBarrierCount
-		&imageMemoryBarrier		// pImageMemoryBarriers
-	);
+	transitionBarrierBatch.flush(transitionImageLayoutCommandBuffer);
 	SLVK_AbstractGLFW::endSingleTimeCommandBuffer(transitionImageLayoutCommandPool, logicalDevice, imageMemoryTransferQueue, transitionImageLayoutCommandBuffer);
 	transitionImageLayoutCommandBuffer = VK_NULL_HANDLE;
 }
@@ -401,20 +552,23 @@ void SLVK_AbstractGLFW::transferResourceBufferToImage(const VkCommandPool& buffe
 void SLVK_AbstractGLFW::createDeviceLocalTexture(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties
 	,const char*& textureDiskAddress, const VkImageType& imageType,  int& textureWidth, int& textureHeight
 	,VkImage& deviceLocalTextureToCreate, VkDeviceMemory& textureDeviceMemoryToAllocate, VkImageView& textureImageViewToCreate
-	,const VkSharingMode& imageSharingMode, const VkCommandPool& tmpCommandBufferCommandPool, const VkQueue& imageMemoryTransferQueue)
+	,const VkSharingMode& imageSharingMode, SenStagingRing& stagingRing)
 {
-	bool usingGliLibrary = false;
-	if (std::string(textureDiskAddress).substr(std::string(textureDiskAddress).length() - 4, 4).compare(".ktx") == 0)
-		usingGliLibrary = true;
+	const bool usingKtxFile = SenKtxFile::isKtxAddress(textureDiskAddress);
 	stbi_uc* ptrDiskTextureToUpload = nullptr;
-	gli::texture2d tex2D;
+	std::unique_ptr<SenKtxFile> ktxFile;	// level data is copied from the mapping straight into the staging ring
+	std::shared_ptr<PrefetchedTextureStruct> prefetchedTexture = takePrefetchedResult(prefetchedTextureMap, std::string(textureDiskAddress));
 	/*****************************************************************************************************************************************/
-	if (usingGliLibrary) {
-		tex2D = gli::texture2d(gli::load(textureDiskAddress));
-		assert(!tex2D.empty());
-		if (tex2D.empty()) { throw std::runtime_error("failed to load texture2D KTX image!"); }
-		textureWidth = static_cast<uint32_t>(tex2D[0].extent().x);
-		textureHeight = static_cast<uint32_t>(tex2D[0].extent().y);
+	if (usingKtxFile) {
+		if (nullptr != prefetchedTexture)	ktxFile = std::move(prefetchedTexture->ktxFile);
+		else								ktxFile.reset(new SenKtxFile(textureDiskAddress));
+		textureWidth = static_cast<int>(ktxFile->width());
+		textureHeight = static_cast<int>(ktxFile->height());
+	}else if (nullptr != prefetchedTexture) {
+		ptrDiskTextureToUpload			= prefetchedTexture->ptrPixels;		// ownership moves here, freed below as if loaded here
+		textureWidth					= prefetchedTexture->textureWidth;
+		textureHeight					= prefetchedTexture->textureHeight;
+		prefetchedTexture->ptrPixels	= nullptr;
 	}else	{
 		// The pointer ptrBackgroundTexture returned from stbi_load(...) is the first element in an array of pixel values.
 		int actuallyTextureChannels	= 0;
@@ -490,59 +644,16 @@ void SLVK_AbstractGLFW::createDeviceLocalTexture(const VkDevice& logicalDevice,
 	//linearStagingImageDeviceMemory	= VK_NULL_HANDLE;
 	
 	/***********************************************************************************************************************************************/
-	/*************      First:   Upload/MapMemory texture image file to texture StagingBuffer )         ********************************************/
-	VkBuffer textureStagingBuffer;
-	VkDeviceMemory textureStagingBufferDeviceMemory;
-	VkDeviceSize hostVisibleTextureDeviceSize;
-	if (usingGliLibrary)
-			hostVisibleTextureDeviceSize = tex2D.size();
-	else	hostVisibleTextureDeviceSize = textureWidth * textureHeight * 4;
-
-	SLVK_AbstractGLFW::createResourceBuffer(logicalDevice, hostVisibleTextureDeviceSize, // 4 for RGBA
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, gpuMemoryProperties,
-		textureStagingBuffer, textureStagingBufferDeviceMemory, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-	void* ptrHostVisibleData;
-	vkMapMemory(logicalDevice, textureStagingBufferDeviceMemory, 0, hostVisibleTextureDeviceSize, 0, &ptrHostVisibleData);
-
-	if (usingGliLibrary) {
-		memcpy(ptrHostVisibleData, tex2D.data(), static_cast<size_t>(hostVisibleTextureDeviceSize));
-	}else	{
-		memcpy(ptrHostVisibleData, ptrDiskTextureToUpload, static_cast<size_t>(hostVisibleTextureDeviceSize));
-		stbi_image_free(ptrDiskTextureToUpload);
-	}
-	vkUnmapMemory(logicalDevice, textureStagingBufferDeviceMemory);
-	/***********************************************************************************************************************************************/
-	/**********        Second: Transfer stagingImage to deviceLocalTextureImage with correct textureImageLayout )        ***************************/
+	/**********        First: Transfer through the staging ring (or host image copy) to deviceLocalTextureImage with correct textureImageLayout )  *****/
 	VkFormat textureFormat;
-	if (usingGliLibrary) {
-		gli::texture::format_type  formatType = tex2D.format();
-		switch (formatType)
-		{
-			case gli::texture::format_type::FORMAT_RGBA_BP_UNORM_BLOCK16:
-				textureFormat = VkFormat::VK_FORMAT_BC7_UNORM_BLOCK;			break;
-			case gli::texture::format_type::FORMAT_RGBA_DXT3_UNORM_BLOCK16:
-				textureFormat = VkFormat::VK_FORMAT_BC2_UNORM_BLOCK;			break;
-			case gli::texture::format_type::FORMAT_RG_ATI2N_UNORM_BLOCK16:
-				textureFormat = VkFormat::VK_FORMAT_BC5_UNORM_BLOCK;			break;
-			case gli::texture::format_type::FORMAT_R_ATI1N_UNORM_BLOCK8:
-				textureFormat = VkFormat::VK_FORMAT_BC4_UNORM_BLOCK;			break;
-			case gli::texture::format_type::FORMAT_RGBA_DXT5_UNORM_BLOCK16:
-				textureFormat = VkFormat::VK_FORMAT_BC3_UNORM_BLOCK;			break;
-			case gli::texture::format_type::FORMAT_RGBA_DXT1_UNORM_BLOCK8:
-				textureFormat = VkFormat::VK_FORMAT_BC1_RGBA_UNORM_BLOCK;		break;
-			case gli::texture::format_type::FORMAT_R_EAC_UNORM_BLOCK8:
-				textureFormat = VkFormat::VK_FORMAT_EAC_R11_UNORM_BLOCK;		break;
-
-			default:
-				throw std::runtime_error("May not support this KTX image format, check it out !!!");		break;
-		}
-	}
-	else	textureFormat = VK_FORMAT_R8G8B8A8_UNORM;
+	if (usingKtxFile)	textureFormat = ktxFile->format();		// unsupported formats already threw while parsing
+	else				textureFormat = VK_FORMAT_R8G8B8A8_UNORM;
 
-	SLVK_AbstractGLFW::createResourceImage(logicalDevice, textureWidth, textureHeight, imageType,
-		textureFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, deviceLocalTextureToCreate
-		, textureDeviceMemoryToAllocate, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, imageSharingMode, gpuMemoryProperties);
+	SenHostImageCopy* hostImageCopy = stagingRing.hostImageCopy();
+	const bool usingHostImageCopy = nullptr != hostImageCopy && hostImageCopy->supportsImage(textureFormat, imageType, VK_IMAGE_USAGE_SAMPLED_BIT);
+	SLVK_AbstractGLFW::createResourceImage(logicalDevice, textureWidth, textureHeight, imageType, textureFormat, VK_IMAGE_TILING_OPTIMAL
+		, usingHostImageCopy ? hostImageCopy->hostTransferUsage(VK_IMAGE_USAGE_SAMPLED_BIT) : VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+		, deviceLocalTextureToCreate, textureDeviceMemoryToAllocate, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, imageSharingMode, gpuMemoryProperties);
 
 	VkImageSubresourceRange textureImageSubresourceRange{};
 	textureImageSubresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
@@ -551,22 +662,29 @@ void SLVK_AbstractGLFW::createDeviceLocalTexture(const VkDevice& logicalDevice,
 	textureImageSubresourceRange.baseArrayLayer	= 0;	// first arrayLayer to start
 	textureImageSubresourceRange.layerCount		= 1;
 
-	SLVK_AbstractGLFW::transitionResourceImageLayout(deviceLocalTextureToCreate, textureImageSubresourceRange, VK_IMAGE_LAYOUT_PREINITIALIZED,
-		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, logicalDevice, tmpCommandBufferCommandPool, imageMemoryTransferQueue);
-	SLVK_AbstractGLFW::transferResourceBufferToImage(tmpCommandBufferCommandPool, imageMemoryTransferQueue,
-		logicalDevice, textureStagingBuffer, deviceLocalTextureToCreate, textureWidth, textureHeight);
-	SLVK_AbstractGLFW::transitionResourceImageLayout(deviceLocalTextureToCreate, textureImageSubresourceRange, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, logicalDevice, tmpCommandBufferCommandPool, imageMemoryTransferQueue);
-
-	/***********************************************************************************************************************************************/
-	/**********            Third:  clean the staging Buffer, DeviceMemory                 ***********************************************************/
-	vkDestroyBuffer(logicalDevice, textureStagingBuffer, nullptr);
-	vkFreeMemory(logicalDevice, textureStagingBufferDeviceMemory, nullptr);
-	textureStagingBuffer				= VK_NULL_HANDLE;
-	textureStagingBufferDeviceMemory	= VK_NULL_HANDLE;
+	VkBufferImageCopy bufferImageCopyRegion{};
+	bufferImageCopyRegion.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	bufferImageCopyRegion.imageSubresource.mipLevel			= 0;
+	bufferImageCopyRegion.imageSubresource.baseArrayLayer	= 0;
+	bufferImageCopyRegion.imageSubresource.layerCount		= 1;
+	bufferImageCopyRegion.imageExtent						= { static_cast<uint32_t>(textureWidth), static_cast<uint32_t>(textureHeight), 1 };
+	const void* ptrTexelsToUpload = usingKtxFile ? static_cast<const void*>(ktxFile->imageData(0, 0)) : ptrDiskTextureToUpload;
+	if (usingHostImageCopy) {
+		// Written and transitioned on the host, nothing to submit
+		hostImageCopy->uploadToImage(ptrTexelsToUpload, deviceLocalTextureToCreate, textureFormat, bufferImageCopyRegion);
+	}else	{
+		stagingRing.transitionImageLayout(deviceLocalTextureToCreate, textureImageSubresourceRange, VK_IMAGE_LAYOUT_PREINITIALIZED,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+		stagingRing.uploadToImage(ptrTexelsToUpload, deviceLocalTextureToCreate, textureFormat, bufferImageCopyRegion);
+		stagingRing.transitionImageLayout(deviceLocalTextureToCreate, textureImageSubresourceRange, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		stagingRing.flush();	// both transitions and the copies in one submit, the queue orders it before any draw
+	}
+	if (!usingKtxFile)
+		stbi_image_free(ptrDiskTextureToUpload);	// already copied into the ring or the image
 
 	/***********************************************************************************************************************************************/
-	/****************          Fourth:  create textureImageView       ******************************************************************************/
+	/****************          Second:  create textureImageView       ******************************************************************************/
 	VkImageViewCreateInfo textureImageViewCreateInfo{};
 	textureImageViewCreateInfo.sType	= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
 	textureImageViewCreateInfo.image	= deviceLocalTextureToCreate;
@@ -599,6 +717,8 @@ void SLVK_AbstractGLFW::createTextureSampler(const VkDevice& logicalDevice, VkSa
 	textureSamplerCreateInfo.compareOp = VK_COMPARE_OP_ALWAYS;
 	textureSamplerCreateInfo.borderColor = VK_BORDER_COLOR_INT_OPAQUE_BLACK;
 	textureSamplerCreateInfo.unnormalizedCoordinates = VK_FALSE;
+	textureSamplerCreateInfo.minLod = 0.0f;
+	textureSamplerCreateInfo.maxLod = VK_LOD_CLAMP_NONE; // sample whatever mip chain the image view holds
 
 	SLVK_AbstractGLFW::errorCheck(
 		vkCreateSampler(logicalDevice, &textureSamplerCreateInfo, nullptr, &textureSamplerToCreate),
@@ -642,102 +762,68 @@ void SLVK_AbstractGLFW::transferResourceImage(const VkCommandPool& imageTransfer
 void SLVK_AbstractGLFW::createDeviceLocalTextureArray(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties
 	, const std::vector<std::string> & texturesDiskAddressVector, const VkImageType& imageType
 	, VkImage& deviceLocalTextureToCreate, VkDeviceMemory& textureDeviceMemoryToAllocate, VkImageView& textureImageViewToCreate
-	, const VkSharingMode& imageSharingMode, const VkCommandPool& tmpCommandBufferCommandPool, const VkQueue& imageMemoryTransferQueue)
+	, const VkSharingMode& imageSharingMode, SenStagingRing& stagingRing)
 {
-	bool usingGliLibrary = false;
-	if (texturesDiskAddressVector.size() == 1
-		&& texturesDiskAddressVector[0].substr(texturesDiskAddressVector[0].length() - 4, 4).compare(".ktx") == 0)
-		usingGliLibrary = true;
+	const bool usingKtxFile = texturesDiskAddressVector.size() == 1 && SenKtxFile::isKtxAddress(texturesDiskAddressVector[0]);
 	std::vector<stbi_uc*> ptrDiskTexToUploadVector;
-	gli::texture2d_array tex2DArray;
-	int textureArrayLayerCount, maxTextureWidth = 0, minTextureWidth = 999, maxTextureHeight = 0, minTextureHeight = 999;
-	std::vector<VkDeviceSize> hostVisibleTexDeviceSizeVector;
+	std::unique_ptr<SenKtxFile> ktxFile;
+	int textureArrayLayerCount, maxTextureWidth = 0, maxTextureHeight = 0;
 	std::vector<int> textureWidthVector, textureHeightVector;
-	VkDeviceSize totalHostVisibleTexDeviceSize = 0;
 	/*****************************************************************************************************************************************/
-	if (usingGliLibrary) {
-		tex2DArray = gli::texture2d_array(gli::load(texturesDiskAddressVector[0]));
-		assert(!tex2DArray.empty());
-		if (tex2DArray.empty()) { throw std::runtime_error("failed to load texture2DArray KTX image!"); }
-		maxTextureWidth = static_cast<uint32_t>(tex2DArray[0].extent().x);
-		maxTextureHeight = static_cast<uint32_t>(tex2DArray[0].extent().y);
-		textureArrayLayerCount = static_cast<int>(tex2DArray.layers());
-		totalHostVisibleTexDeviceSize = tex2DArray.size();
+	if (usingKtxFile) {
+		std::shared_ptr<PrefetchedTextureStruct> prefetchedTexture = takePrefetchedResult(prefetchedTextureMap, texturesDiskAddressVector[0]);
+		if (nullptr != prefetchedTexture)	ktxFile = std::move(prefetchedTexture->ktxFile);
+		else								ktxFile.reset(new SenKtxFile(texturesDiskAddressVector[0]));
+		maxTextureWidth = static_cast<int>(ktxFile->width());
+		maxTextureHeight = static_cast<int>(ktxFile->height());
+		textureArrayLayerCount = static_cast<int>(ktxFile->layersCount());
 	}
 	else {
 		textureArrayLayerCount = static_cast<int>(texturesDiskAddressVector.size());
 		textureWidthVector.resize(textureArrayLayerCount);
 		textureHeightVector.resize(textureArrayLayerCount);
+		ptrDiskTexToUploadVector.resize(textureArrayLayerCount, nullptr);
+		// Prefetched layers can only be taken on this thread, the others are decoded one layer per job
+		for (int i = 0; i < textureArrayLayerCount; i++) {
+			std::shared_ptr<PrefetchedTextureStruct> prefetchedTexture = takePrefetchedResult(prefetchedTextureMap, texturesDiskAddressVector[i]);
+			if (nullptr != prefetchedTexture) {
+				ptrDiskTexToUploadVector[i]		= prefetchedTexture->ptrPixels;
+				textureWidthVector[i]			= prefetchedTexture->textureWidth;
+				textureHeightVector[i]			= prefetchedTexture->textureHeight;
+				prefetchedTexture->ptrPixels	= nullptr;
+			}
+		}
 		// The pointer ptrBackgroundTexture returned from stbi_load(...) is the first element in an array of pixel values.
-		int actuallyTextureChannels;
+		SenJobSystem::shared().parallelFor(textureArrayLayerCount, 1, [&](uint32_t layerBegin, uint32_t layerEnd) {
+			for (uint32_t i = layerBegin; i < layerEnd; i++) {
+				if (nullptr != ptrDiskTexToUploadVector[i]) continue;
+				int actuallyTextureChannels;
+				ptrDiskTexToUploadVector[i] = stbi_load(texturesDiskAddressVector[i].c_str(), &textureWidthVector[i], &textureHeightVector[i], &actuallyTextureChannels, STBI_rgb_alpha);
+			}
+		});
 		for (int i = 0; i < textureArrayLayerCount; i++) {
-			stbi_uc* ptrDiskTextureToUpload = stbi_load(texturesDiskAddressVector[i].c_str(), &textureWidthVector[i], &textureHeightVector[i], &actuallyTextureChannels, STBI_rgb_alpha);
-			if (!ptrDiskTextureToUpload) { throw std::runtime_error("failed to load one of the texture2DArray images!"); }
-			ptrDiskTexToUploadVector.push_back(ptrDiskTextureToUpload);
-			hostVisibleTexDeviceSizeVector.push_back(textureWidthVector[i] * textureHeightVector[i] * 4);
-			totalHostVisibleTexDeviceSize += hostVisibleTexDeviceSizeVector[i];
-
+			if (!ptrDiskTexToUploadVector[i]) {
+				for (stbi_uc* ptrDiskTextureToUpload : ptrDiskTexToUploadVector)
+					stbi_image_free(ptrDiskTextureToUpload);
+				throw std::runtime_error("failed to load one of the texture2DArray images!");
+			}
 			maxTextureWidth = maxTextureWidth > textureWidthVector[i] ? maxTextureWidth : textureWidthVector[i];
-			minTextureWidth = minTextureWidth < textureWidthVector[i] ? minTextureWidth : textureWidthVector[i];
 			maxTextureHeight = maxTextureHeight > textureHeightVector[i] ? maxTextureHeight : textureHeightVector[i];
-			minTextureHeight = minTextureHeight < textureHeightVector[i] ? minTextureHeight : textureHeightVector[i];
 		}
 	}
 
 	/***********************************************************************************************************************************************/
-	/*************      First:   Upload/MapMemory texture image file to texture StagingBuffer )         ********************************************/
-	VkBuffer textureStagingBuffer;
-	VkDeviceMemory textureStagingBufferDeviceMemory;
-
-	SLVK_AbstractGLFW::createResourceBuffer(logicalDevice, totalHostVisibleTexDeviceSize, // 4 for RGBA
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, gpuMemoryProperties,
-		textureStagingBuffer, textureStagingBufferDeviceMemory, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-	void* ptrHostVisibleData;
-	vkMapMemory(logicalDevice, textureStagingBufferDeviceMemory, 0, totalHostVisibleTexDeviceSize, 0, &ptrHostVisibleData);
-
-	if (usingGliLibrary) {
-		memcpy(ptrHostVisibleData, tex2DArray.data(), static_cast<size_t>(totalHostVisibleTexDeviceSize));
-	}
-	else {
-		int offset = 0;
-		for (int i = 0; i < textureArrayLayerCount; i++) {
-			memcpy(static_cast<char*>(ptrHostVisibleData) + offset, ptrDiskTexToUploadVector[i], static_cast<size_t>(hostVisibleTexDeviceSizeVector[i]));
-			stbi_image_free(ptrDiskTexToUploadVector[i]);
-			offset += static_cast<int>(hostVisibleTexDeviceSizeVector[i]);
-		}
-	}
-	vkUnmapMemory(logicalDevice, textureStagingBufferDeviceMemory);
-	/***********************************************************************************************************************************************/
-	/**********        Second: Transfer stagingImage to deviceLocalTextureImage with correct textureImageLayout )        ***************************/
+	/**********        First: Transfer through the staging ring (or host image copy) to deviceLocalTextureImage with correct textureImageLayout )  *****/
 	VkFormat textureFormat;
-	if (usingGliLibrary) {
-		gli::texture::format_type  formatType = tex2DArray.format();
-		switch (formatType)
-		{
-		case gli::texture::format_type::FORMAT_RGBA_BP_UNORM_BLOCK16:
-			textureFormat = VkFormat::VK_FORMAT_BC7_UNORM_BLOCK;			break;
-		case gli::texture::format_type::FORMAT_RGBA_DXT3_UNORM_BLOCK16:
-			textureFormat = VkFormat::VK_FORMAT_BC2_UNORM_BLOCK;			break;
-		case gli::texture::format_type::FORMAT_RG_ATI2N_UNORM_BLOCK16:
-			textureFormat = VkFormat::VK_FORMAT_BC5_UNORM_BLOCK;			break;
-		case gli::texture::format_type::FORMAT_R_ATI1N_UNORM_BLOCK8:
-			textureFormat = VkFormat::VK_FORMAT_BC4_UNORM_BLOCK;			break;
-		case gli::texture::format_type::FORMAT_RGBA_DXT5_UNORM_BLOCK16:
-			textureFormat = VkFormat::VK_FORMAT_BC3_UNORM_BLOCK;			break;
-		case gli::texture::format_type::FORMAT_RGBA_DXT1_UNORM_BLOCK8:
-			textureFormat = VkFormat::VK_FORMAT_BC1_RGBA_UNORM_BLOCK;		break;
-		case gli::texture::format_type::FORMAT_R_EAC_UNORM_BLOCK8:
-			textureFormat = VkFormat::VK_FORMAT_EAC_R11_UNORM_BLOCK;		break;
-		default:
-			throw std::runtime_error("May not support this KTX image format, check it out !!!");		break;
-		}
-	}
-	else	textureFormat = VK_FORMAT_R8G8B8A8_UNORM;
+	if (usingKtxFile)	textureFormat = ktxFile->format();
+	else				textureFormat = VK_FORMAT_R8G8B8A8_UNORM;
 
-	SLVK_AbstractGLFW::createResourceImage(logicalDevice, maxTextureWidth, maxTextureHeight, imageType,
-		textureFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, deviceLocalTextureToCreate
-		, textureDeviceMemoryToAllocate, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, imageSharingMode, gpuMemoryProperties, textureArrayLayerCount);
+	SenHostImageCopy* hostImageCopy = stagingRing.hostImageCopy();
+	const bool usingHostImageCopy = nullptr != hostImageCopy && hostImageCopy->supportsImage(textureFormat, imageType, VK_IMAGE_USAGE_SAMPLED_BIT);
+	SLVK_AbstractGLFW::createResourceImage(logicalDevice, maxTextureWidth, maxTextureHeight, imageType, textureFormat, VK_IMAGE_TILING_OPTIMAL
+		, usingHostImageCopy ? hostImageCopy->hostTransferUsage(VK_IMAGE_USAGE_SAMPLED_BIT) : VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+		, deviceLocalTextureToCreate, textureDeviceMemoryToAllocate, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, imageSharingMode, gpuMemoryProperties
+		, textureArrayLayerCount);
 
 	VkImageSubresourceRange textureImageSubresourceRange{};
 	textureImageSubresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
@@ -746,68 +832,44 @@ void SLVK_AbstractGLFW::createDeviceLocalTextureArray(const VkDevice& logicalDev
 	textureImageSubresourceRange.baseArrayLayer = 0;	// first arrayLayer to start
 	textureImageSubresourceRange.layerCount = textureArrayLayerCount;
 
-	SLVK_AbstractGLFW::transitionResourceImageLayout(deviceLocalTextureToCreate, textureImageSubresourceRange, VK_IMAGE_LAYOUT_PREINITIALIZED,
-		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, logicalDevice, tmpCommandBufferCommandPool, imageMemoryTransferQueue);
+	if (!usingHostImageCopy)
+		stagingRing.transitionImageLayout(deviceLocalTextureToCreate, textureImageSubresourceRange, VK_IMAGE_LAYOUT_PREINITIALIZED,
+			VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
 
 	/******************************************************************************************************/
-	/**********       Setup buffer copy regions for array layers      *************************************/
-	std::vector<VkBufferImageCopy> bufferImageCopyRegionsVector;
-
-	VkBufferImageCopy sameDemensionBufferImageCopyRegion{};
-	sameDemensionBufferImageCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-	sameDemensionBufferImageCopyRegion.imageSubresource.mipLevel = 0;
-	sameDemensionBufferImageCopyRegion.imageSubresource.baseArrayLayer = 0;
-	sameDemensionBufferImageCopyRegion.imageSubresource.layerCount = textureArrayLayerCount;
-	sameDemensionBufferImageCopyRegion.imageExtent.width = maxTextureWidth;
-	sameDemensionBufferImageCopyRegion.imageExtent.height = maxTextureHeight;
-	sameDemensionBufferImageCopyRegion.imageExtent.depth = 1;
-
-	if (usingGliLibrary) {
-		// assume same dimensions for all layers
-		bufferImageCopyRegionsVector.push_back(sameDemensionBufferImageCopyRegion);
-	}
-	else {
-		// Check if all array layers have the same dimension
-		if (maxTextureWidth == minTextureWidth && maxTextureHeight == minTextureHeight) {
-			bufferImageCopyRegionsVector.push_back(sameDemensionBufferImageCopyRegion);
-		}
-		else { // not same dimension
-			uint32_t offset = 0;
-			// If dimensions differ, copy layer by layer and pass offsets
-			for (int layerIndex = 0; layerIndex < textureArrayLayerCount; layerIndex++) {
-				VkBufferImageCopy bufferImageCopyRegion{};
-				bufferImageCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-				bufferImageCopyRegion.imageSubresource.mipLevel = 0;
-				bufferImageCopyRegion.imageSubresource.baseArrayLayer = layerIndex;
-				bufferImageCopyRegion.imageSubresource.layerCount = 1;
-				bufferImageCopyRegion.imageExtent.width = textureWidthVector[layerIndex];
-				bufferImageCopyRegion.imageExtent.height = textureHeightVector[layerIndex];
-				bufferImageCopyRegion.imageExtent.depth = 1;
-				bufferImageCopyRegion.bufferOffset = offset;
-
-				bufferImageCopyRegionsVector.push_back(bufferImageCopyRegion);
-				offset += static_cast<int>(hostVisibleTexDeviceSizeVector[layerIndex]);
-			}
-		}
+	/**********       KTX:  every layer of level 0 is contiguous in the mapping, one ring copy     ********/
+	if (usingKtxFile) {
+		VkBufferImageCopy bufferImageCopyRegion{};
+		bufferImageCopyRegion.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+		bufferImageCopyRegion.imageSubresource.mipLevel			= 0;
+		bufferImageCopyRegion.imageSubresource.baseArrayLayer	= 0;
+		bufferImageCopyRegion.imageSubresource.layerCount		= textureArrayLayerCount;
+		bufferImageCopyRegion.imageExtent						= { static_cast<uint32_t>(maxTextureWidth), static_cast<uint32_t>(maxTextureHeight), 1 };
+		if (usingHostImageCopy)	hostImageCopy->uploadToImage(ktxFile->imageData(0, 0), deviceLocalTextureToCreate, textureFormat, bufferImageCopyRegion);
+		else					stagingRing.uploadToImage(ktxFile->imageData(0, 0), deviceLocalTextureToCreate, textureFormat, bufferImageCopyRegion);
+	}
+	/**********       stb:  one ring copy per array layer, the ring coalesces them into one batch     ***************/
+	for (int layerIndex = 0; layerIndex < static_cast<int>(ptrDiskTexToUploadVector.size()); layerIndex++) {
+		VkBufferImageCopy bufferImageCopyRegion{};
+		bufferImageCopyRegion.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+		bufferImageCopyRegion.imageSubresource.mipLevel			= 0;
+		bufferImageCopyRegion.imageSubresource.baseArrayLayer	= layerIndex;
+		bufferImageCopyRegion.imageSubresource.layerCount		= 1;
+		bufferImageCopyRegion.imageExtent.depth					= 1;
+		bufferImageCopyRegion.imageExtent.width					= textureWidthVector[layerIndex];
+		bufferImageCopyRegion.imageExtent.height				= textureHeightVector[layerIndex];
+		if (usingHostImageCopy)	hostImageCopy->uploadToImage(ptrDiskTexToUploadVector[layerIndex], deviceLocalTextureToCreate, textureFormat, bufferImageCopyRegion);
+		else					stagingRing.uploadToImage(ptrDiskTexToUploadVector[layerIndex], deviceLocalTextureToCreate, textureFormat, bufferImageCopyRegion);
+		stbi_image_free(ptrDiskTexToUploadVector[layerIndex]);	// already copied into the ring or the image
+	}
+	if (!usingHostImageCopy) {
+		stagingRing.transitionImageLayout(deviceLocalTextureToCreate, textureImageSubresourceRange, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		stagingRing.flush();	// both transitions and the copies in one submit, the queue orders it before any draw
 	}
 
-	SLVK_AbstractGLFW::transferResourceBufferToImage(tmpCommandBufferCommandPool, imageMemoryTransferQueue,
-		logicalDevice, textureStagingBuffer, deviceLocalTextureToCreate, static_cast<uint32_t>(maxTextureWidth)
-		, static_cast<uint32_t>(maxTextureHeight), static_cast<uint32_t>(textureArrayLayerCount)
-		, static_cast<uint32_t>(bufferImageCopyRegionsVector.size()), bufferImageCopyRegionsVector.data());
-
-	SLVK_AbstractGLFW::transitionResourceImageLayout(deviceLocalTextureToCreate, textureImageSubresourceRange, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-		VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, logicalDevice, tmpCommandBufferCommandPool, imageMemoryTransferQueue);
-
-	/***********************************************************************************************************************************************/
-	/**********            Third:  clean the staging Buffer, DeviceMemory                 ***********************************************************/
-	vkDestroyBuffer(logicalDevice, textureStagingBuffer, nullptr);
-	vkFreeMemory(logicalDevice, textureStagingBufferDeviceMemory, nullptr);
-	textureStagingBuffer = VK_NULL_HANDLE;
-	textureStagingBufferDeviceMemory = VK_NULL_HANDLE;
-
 	/***********************************************************************************************************************************************/
-	/****************          Fourth:  create textureImageView       ******************************************************************************/
+	/****************          Second:  create textureImageView       ******************************************************************************/
 	VkImageViewCreateInfo textureImageViewCreateInfo{};
 	textureImageViewCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
 	textureImageViewCreateInfo.image = deviceLocalTextureToCreate;
@@ -852,19 +914,103 @@ SLVK_AbstractGLFW::~SLVK_AbstractGLFW()
 	OutputDebugString("\n\t ~SLVK_AbstractGLFW()\n");
 }
 
+void SLVK_AbstractGLFW::setLatencyPolicy(const LatencyPolicy& latencyPolicy, const double& frameLimitFramesPerSecond)
+{
+	m_LatencyPolicy				= latencyPolicy;
+	m_FrameLimitFramesPerSecond	= frameLimitFramesPerSecond;
+	if (LATENCY_POLICY_POWER_SAVING == latencyPolicy && frameLimitFramesPerSecond <= 0.0)
+		m_FrameLimitFramesPerSecond = 30.0;
+	m_ReportFramePacing = true;
+}
+
+SLVK_AbstractGLFW::DeviceCapabilityProfile SLVK_AbstractGLFW::defaultComputeOffloadProfile()
+{
+	DeviceCapabilityProfile computeOffloadProfile;
+	computeOffloadProfile.requiredQueueFlags		= VK_QUEUE_COMPUTE_BIT;
+	computeOffloadProfile.requirePresent			= false;
+	computeOffloadProfile.requireSamplerAnisotropy	= false;
+	computeOffloadProfile.preferDiscrete			= false;	// the discrete GPU is expected to render
+	return computeOffloadProfile;
+}
+
+void SLVK_AbstractGLFW::setRenderDeviceProfile(const DeviceCapabilityProfile& renderDeviceProfile)
+{
+	m_RenderDeviceProfile = renderDeviceProfile;
+}
+
+void SLVK_AbstractGLFW::enableComputeOffloadDevice(const DeviceCapabilityProfile& computeOffloadProfile)
+{
+	m_ComputeOffloadProfile	= computeOffloadProfile;
+	m_ComputeOffloadEnabled	= true;
+}
+
 void SLVK_AbstractGLFW::showWidget()
 {
+	startupPipeline = new SenStartupPipeline();
+	startupPipeline->runStep("prefetchStartupAssets", [this]() { prefetchStartupAssets(); });
 	initGlfwVulkanDebugWSI();
-	initVulkanApplication();
+	startupPipeline->runStep("initVulkanApplication", [this]() { initVulkanApplication(); });
+
+	nextFrameDeadline = framePacingReportTime = std::chrono::high_resolution_clock::now();
+	auto lastFrameStartTime = nextFrameDeadline;
 	// Game loop
 	while (!glfwWindowShouldClose(widgetGLFW))
 	{
+		// Block on the oldest frame in flight before sampling input, such that input is as fresh as the policy allows
+		waitForFramesInFlight();
+
 		// Check if any events have been activiated (key pressed, mouse moved etc.) and call corresponding response functions
+		auto frameStartTime = std::chrono::high_resolution_clock::now();
 		glfwPollEvents();
 
 		updateUniformBuffer();
 
 		swapSwapchain();
+
+		if (!startupPipeline->firstFrameMarked()) {
+			startupPipeline->markFirstFrame();
+			std::cout << "\n" << startupPipeline->report() << std::endl;
+		}
+
+		/****************************************************************************************************************************/
+		/**********      Input-to-present latency (CPU side: glfwPollEvents -> vkQueuePresentKHR returned) and frame pacing     ******/
+		/****************************************************************************************************************************/
+		if (presentTimePoint > frameStartTime) {
+			double inputToPresentMilliseconds = std::chrono::duration<double, std::milli>(presentTimePoint - frameStartTime).count();
+			double frameMilliseconds = std::chrono::duration<double, std::milli>(frameStartTime - lastFrameStartTime).count();
+			inputToPresentMillisecondsSum	+= inputToPresentMilliseconds;
+			inputToPresentMillisecondsMax	= (std::max)(inputToPresentMillisecondsMax, inputToPresentMilliseconds);
+			frameMillisecondsSum			+= frameMilliseconds;
+			frameMillisecondsSquareSum		+= frameMilliseconds * frameMilliseconds;
+			framePacingFramesCount++;
+		}
+		lastFrameStartTime = frameStartTime;
+
+		double reportSeconds = std::chrono::duration<double>(frameStartTime - framePacingReportTime).count();
+		if (m_ReportFramePacing && reportSeconds >= 1.0 && framePacingFramesCount > 0) {
+			const char* latencyPolicyName = LATENCY_POLICY_LOW_LATENCY == m_LatencyPolicy ? "low-latency"
+				: (LATENCY_POLICY_THROUGHPUT == m_LatencyPolicy ? "throughput" : "power-saving");
+			const char* presentModeName = VK_PRESENT_MODE_MAILBOX_KHR == m_SwapchainPresentMode ? "MAILBOX"
+				: (VK_PRESENT_MODE_IMMEDIATE_KHR == m_SwapchainPresentMode ? "IMMEDIATE" : "FIFO");
+			double frameMillisecondsMean = frameMillisecondsSum / framePacingFramesCount;
+			double frameMillisecondsVariance = frameMillisecondsSquareSum / framePacingFramesCount - frameMillisecondsMean * frameMillisecondsMean;
+
+			std::ostringstream stream;
+			stream << "Latency policy " << latencyPolicyName << " (" << presentModeName << ", " << m_SwapChain_ImagesCount << " images, "
+				<< m_MaxFramesInFlight << " in flight):  input->present = " << inputToPresentMillisecondsSum / framePacingFramesCount
+				<< " ms (max " << inputToPresentMillisecondsMax << ")\t frame = " << frameMillisecondsMean
+				<< " ms +- " << std::sqrt((std::max)(frameMillisecondsVariance, 0.0)) << "\n";
+			std::cout << stream.str();
+
+			framePacingReportTime			= frameStartTime;
+			framePacingFramesCount			= 0;
+			inputToPresentMillisecondsSum	= 0.0;
+			inputToPresentMillisecondsMax	= 0.0;
+			frameMillisecondsSum			= 0.0;
+			frameMillisecondsSquareSum		= 0.0;
+		}
+
+		paceFrame();
 	}
 
 	// All of the operations in drawFrame are asynchronous, which means that when we exit the loop in mainLoop,
@@ -989,6 +1135,72 @@ void SLVK_AbstractGLFW::createDefaultCommandPool() {
 		std::string("Failed to create m_DefaultThreadCommandPool !!!")
 	);
 
+	if (nullptr == stagingRing) {
+		stagingRing = new SenStagingRing(m_LogicalDevice, m_PhysicalDeviceMemoryProperties, graphicsQueueFamilyIndex, *graphicsTimeline, m_StagingRingBytes);
+		stagingRing->setHostImageCopy(hostImageCopy);
+		if (m_CompareTextureUploadPaths)
+			compareTextureUploadPaths();
+	}
+}
+
+void SLVK_AbstractGLFW::compareTextureUploadPaths()
+{
+	const uint32_t imageExtent = 2048, uploadsCount = 8;
+	const VkFormat imageFormat = VK_FORMAT_R8G8B8A8_UNORM;
+	std::vector<uint8_t> texelVector(static_cast<size_t>(imageExtent) * imageExtent * 4);
+	for (size_t texelByte = 0; texelByte < texelVector.size(); texelByte++)
+		texelVector[texelByte] = static_cast<uint8_t>(texelByte * 31);
+
+	VkImageSubresourceRange imageSubresourceRange{};
+	imageSubresourceRange.aspectMask	= VK_IMAGE_ASPECT_COLOR_BIT;
+	imageSubresourceRange.levelCount	= 1;
+	imageSubresourceRange.layerCount	= 1;
+	VkBufferImageCopy bufferImageCopyRegion{};
+	bufferImageCopyRegion.imageSubresource.aspectMask	= VK_IMAGE_ASPECT_COLOR_BIT;
+	bufferImageCopyRegion.imageSubresource.layerCount	= 1;
+	bufferImageCopyRegion.imageExtent					= { imageExtent, imageExtent, 1 };
+
+	const bool hostCopySupported = nullptr != hostImageCopy && hostImageCopy->supportsImage(imageFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_USAGE_SAMPLED_BIT);
+	const double uploadedMegaBytes = static_cast<double>(texelVector.size()) * uploadsCount / (1024.0 * 1024.0);
+	auto timeUploads = [&](const bool& throughHostCopy) {
+		VkImage uploadImage = VK_NULL_HANDLE;
+		VkDeviceMemory uploadImageMemory = VK_NULL_HANDLE;
+		SLVK_AbstractGLFW::createResourceImage(m_LogicalDevice, imageExtent, imageExtent, VK_IMAGE_TYPE_2D, imageFormat, VK_IMAGE_TILING_OPTIMAL
+			, throughHostCopy ? hostImageCopy->hostTransferUsage(VK_IMAGE_USAGE_SAMPLED_BIT) : VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT
+			, uploadImage, uploadImageMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties);
+
+		auto startTimePoint = std::chrono::high_resolution_clock::now();
+		for (uint32_t uploadIndex = 0; uploadIndex < uploadsCount; uploadIndex++) {
+			if (throughHostCopy) {
+				hostImageCopy->uploadToImage(texelVector.data(), uploadImage, imageFormat, bufferImageCopyRegion);
+			}else	{
+				// As createDeviceLocalTexture() does it:  the previous upload is discarded, one submit per texture
+				stagingRing->transitionImageLayout(uploadImage, imageSubresourceRange, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+				stagingRing->uploadToImage(texelVector.data(), uploadImage, imageFormat, bufferImageCopyRegion);
+				stagingRing->transitionImageLayout(uploadImage, imageSubresourceRange, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+				stagingRing->flush();
+			}
+		}
+		if (!throughHostCopy)
+			stagingRing->finish();	// until the data is in the image, as it is on return from the host copy
+		double elapsedSeconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTimePoint).count();
+
+		vkDestroyImage(m_LogicalDevice, uploadImage, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, uploadImageMemory);
+		return uploadedMegaBytes / (std::max)(elapsedSeconds, 1e-9);
+	};
+
+	std::ostringstream stream;
+	stream << "\t Texture upload, " << uploadsCount << " x " << imageExtent << "x" << imageExtent << " RGBA8:\n";
+	stream << "\t\t staging ring:\t" << timeUploads(false) << " MB/s\n";
+	if (hostCopySupported)	stream << "\t\t host image copy:\t" << timeUploads(true) << " MB/s\n";
+	else					stream << "\t\t host image copy:\t not supported by this device / format, textures use the staging ring\n";
+	std::cout << stream.str();
+}
+
+void SLVK_AbstractGLFW::enableTextureUploadComparison()
+{
+	m_CompareTextureUploadPaths = true;
 }
 
 void SLVK_AbstractGLFW::createSingleRectIndexBuffer()
@@ -996,34 +1208,12 @@ void SLVK_AbstractGLFW::createSingleRectIndexBuffer()
 	uint16_t indices[] = { 0, 1, 2, 1, 2, 3 };
 	size_t indicesBufferSize = sizeof(indices);
 
-	/****************************************************************************************************************************************************/
-	/***************   Create temporary stagingBuffer to transfer from to get Optimal Buffer Resource   *************************************************/
-	VkBuffer stagingBuffer;
-	VkDeviceMemory stagingBufferDeviceMemory;
-	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indicesBufferSize,
-		VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
-		stagingBuffer, stagingBufferDeviceMemory, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-
-	void* data;
-	vkMapMemory(m_LogicalDevice, stagingBufferDeviceMemory, 0, indicesBufferSize, 0, &data);
-	memcpy(data, indices, indicesBufferSize);
-	//// The driver may not immediately copy the data into the buffer memory, for example because of caching. 
-	//// There are two ways to deal with that problem, and what we use is the first one below:
-	////  1. Use a memory heap that is host coherent, indicated with VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
-	////  2. Call vkFlushMappedMemoryRanges to after writing to the mapped memory, and call vkInvalidateMappedMemoryRanges before reading from the mapped memory
-	vkUnmapMemory(m_LogicalDevice, stagingBufferDeviceMemory);
-
-	/****************************************************************************************************************************************************/
-	/***************   Transfer from stagingBuffer to Optimal m_TriangleVertexBuffer   ********************************************************************/
 	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indicesBufferSize,
 		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
 		singleRectIndexBuffer, singleRectIndexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
 
-	SLVK_AbstractGLFW::transferResourceBuffer(m_DefaultThreadCommandPool, m_LogicalDevice, m_GraphicsQueue, stagingBuffer,
-		singleRectIndexBuffer, indicesBufferSize);
-
-	vkDestroyBuffer(m_LogicalDevice, stagingBuffer, nullptr);
-	vkFreeMemory(m_LogicalDevice, stagingBufferDeviceMemory, nullptr);	// always try to destroy before free
+	// Queued in the staging ring, submitted with the other uploads before the first frame
+	stagingRing->uploadToBuffer(indices, indicesBufferSize, singleRectIndexBuffer);
 }
 
 /****************************************************************************************************************************/
@@ -1048,6 +1238,68 @@ void SLVK_AbstractGLFW::onKeyboardReaction(GLFWwindow* widget, int key, int scan
 		glfwSetWindowShouldClose(widget, VK_TRUE);
 }
 
+void SLVK_AbstractGLFW::updateSwapchainImageResources(const uint32_t& swapchainImageIndex)
+{
+	// Nothing to update by default, apps with per swapchain image resources override this
+}
+
+void SLVK_AbstractGLFW::prefetchStartupAssets()
+{
+	// Nothing to prefetch by default, everything is loaded on demand inside initVulkanApplication()
+}
+
+void SLVK_AbstractGLFW::prefetchShader(const std::string& diskFileAddress)
+{
+	if (nullptr == startupPipeline)
+		throw std::runtime_error("prefetchShader() has to be called from prefetchStartupAssets() !!!");
+
+	PrefetchEntryStruct<PrefetchedShaderStruct> prefetchEntry;
+	prefetchEntry.startupPipeline	= startupPipeline;
+	prefetchEntry.stepName			= "shader " + diskFileAddress;
+	prefetchEntry.ownerThreadId		= std::this_thread::get_id();
+	prefetchEntry.prefetchedResult	= std::make_shared<PrefetchedShaderStruct>();
+	{
+		std::lock_guard<std::mutex> prefetchMapsLock(prefetchMapsMutex);
+		if (!prefetchedShaderMap.insert(std::make_pair(diskFileAddress, prefetchEntry)).second) return;	// already prefetched
+	}
+	// shadercToSPIRV() uses its own shaderc::Compiler, so shaders compile concurrently
+	std::shared_ptr<PrefetchedShaderStruct> prefetchedShader = prefetchEntry.prefetchedResult;
+	startupPipeline->launchStep(prefetchEntry.stepName, [prefetchedShader, diskFileAddress]() {
+		std::vector<uint32_t> spirv32Vector = SLVK_AbstractGLFW::compileShaderToSPIRV(diskFileAddress);	// not prefetched on this thread
+		prefetchedShader->spirv32Vector = std::move(spirv32Vector);
+	});
+}
+
+void SLVK_AbstractGLFW::prefetchTexture(const std::string& diskFileAddress)
+{
+	if (nullptr == startupPipeline)
+		throw std::runtime_error("prefetchTexture() has to be called from prefetchStartupAssets() !!!");
+
+	PrefetchEntryStruct<PrefetchedTextureStruct> prefetchEntry;
+	prefetchEntry.startupPipeline	= startupPipeline;
+	prefetchEntry.stepName			= "texture " + diskFileAddress;
+	prefetchEntry.ownerThreadId		= std::this_thread::get_id();
+	prefetchEntry.prefetchedResult	= std::make_shared<PrefetchedTextureStruct>();
+	{
+		std::lock_guard<std::mutex> prefetchMapsLock(prefetchMapsMutex);
+		if (!prefetchedTextureMap.insert(std::make_pair(diskFileAddress, prefetchEntry)).second) return;	// already prefetched
+	}
+	std::shared_ptr<PrefetchedTextureStruct> prefetchedTexture = prefetchEntry.prefetchedResult;
+	startupPipeline->launchStep(prefetchEntry.stepName, [prefetchedTexture, diskFileAddress]() {
+		if (SenKtxFile::isKtxAddress(diskFileAddress)) {
+			// Mapping and parsing is cheap, the page faults of reading the file are what is worth taking off the main thread
+			prefetchedTexture->ktxFile.reset(new SenKtxFile(diskFileAddress));
+			prefetchedTexture->ktxFile->touchPages();
+		}
+		else {
+			int actuallyTextureChannels = 0;
+			prefetchedTexture->ptrPixels = stbi_load(diskFileAddress.c_str(), &prefetchedTexture->textureWidth, &prefetchedTexture->textureHeight,
+				&actuallyTextureChannels, STBI_rgb_alpha);
+			if (!prefetchedTexture->ptrPixels) { throw std::runtime_error("failed to load texture image!"); }
+		}
+	});
+}
+
 void SLVK_AbstractGLFW::onKeyboardDetected(GLFWwindow* widget, int key, int scancode, int action, int mode)
 {
 	SLVK_AbstractGLFW* ptrAbstractWidget = reinterpret_cast<SLVK_AbstractGLFW*>(glfwGetWindowUserPointer(widget));
@@ -1155,46 +1407,66 @@ std::vector<uint32_t> SLVK_AbstractGLFW::shadercToSPIRV(const std::string& sourc
 
 void SLVK_AbstractGLFW::initGlfwVulkanDebugWSI()
 {
-	// Init GLFW
-	glfwInit();
-	// Set all the required options for GLFW
-	glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API); //tell GLFW to not create an OpenGL context 
-	glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
-
-	// Create a GLFWwindow object that we can use for GLFW's functions
-	widgetGLFW = glfwCreateWindow(m_WidgetWidth, m_WidgetHeight, strWindowName, nullptr, nullptr);
-	glfwSetWindowPos(widgetGLFW, 400, 240);
-	glfwMakeContextCurrent(widgetGLFW);
-
-	// GLFW allows us to store an arbitrary pointer in the window object with glfwSetWindowUserPointer,
-	//   so we can specify a static class member and get the original class instance back with glfwGetWindowUserPointer;
-	// We can then proceed to call recreateSwapChain, but only if the size of the window is non - zero;
-	//   This case occurs when the window is minimized and it will cause swap chain creation to fail.
-	glfwSetWindowUserPointer(widgetGLFW, this);
-	glfwSetWindowSizeCallback(widgetGLFW, SLVK_AbstractGLFW::onWidgetResized);
-	glfwSetKeyCallback(widgetGLFW, SLVK_AbstractGLFW::onKeyboardDetected);
+	// Init GLFW, which has to be on the main thread as all of the window functions below;
+	//   glfwGetRequiredInstanceExtensions() (in initExtensions) is allowed from any thread once GLFW is initialized
+	startupPipeline->runStep("glfwInit", []() { glfwInit(); });
 
 	/*****************************************************************************************************************************/
-	// Set the required callback functions
-	if (DEBUG_LAYERS_ENABLED) {
-		initDebugLayers();
-	}
-	initExtensions();
-	createInstance();
-	if (DEBUG_LAYERS_ENABLED) {
-		initDebugReportCallback(); // Need created Instance
-	}
+	// The instance (loader, layers, ICD enumeration) doesn't need the window, it is created on a worker meanwhile
+	startupPipeline->launchStep("createInstance", [this]() {
+		if (DEBUG_LAYERS_ENABLED) {
+			initDebugLayers();
+		}
+		initExtensions();
+		createInstance();
+		if (DEBUG_LAYERS_ENABLED) {
+			initDebugReportCallback(); // Need created Instance
+		}
+	});
+
+	startupPipeline->runStep("createWindow", [this]() {
+		// Set all the required options for GLFW
+		glfwWindowHint(GLFW_CLIENT_API, GLFW_NO_API); //tell GLFW to not create an OpenGL context 
+		glfwWindowHint(GLFW_RESIZABLE, GLFW_TRUE);
+
+		// Create a GLFWwindow object that we can use for GLFW's functions
+		widgetGLFW = glfwCreateWindow(m_WidgetWidth, m_WidgetHeight, strWindowName, nullptr, nullptr);
+		glfwSetWindowPos(widgetGLFW, 400, 240);
+		glfwMakeContextCurrent(widgetGLFW);
+
+		// GLFW allows us to store an arbitrary pointer in the window object with glfwSetWindowUserPointer,
+		//   so we can specify a static class member and get the original class instance back with glfwGetWindowUserPointer;
+		// We can then proceed to call recreateSwapChain, but only if the size of the window is non - zero;
+		//   This case occurs when the window is minimized and it will cause swap chain creation to fail.
+		glfwSetWindowUserPointer(widgetGLFW, this);
+		glfwSetWindowSizeCallback(widgetGLFW, SLVK_AbstractGLFW::onWidgetResized);
+		glfwSetKeyCallback(widgetGLFW, SLVK_AbstractGLFW::onKeyboardDetected);
+	});
+	startupPipeline->waitStep("createInstance");
 
 	/*******************************************************************************************************************************/
 	/********* The window surface needs to be created right after the instance creation, *******************************************/
 	/********* because the check of "surface" support will influence the physical m_LogicalDevice selection.     ****************************/
-	createSurface(); // m_Surface == default framebuffer to draw
-	pickPhysicalDevice();
+	startupPipeline->runStep("createSurface", [this]() { createSurface(); }); // m_Surface == default framebuffer to draw
+	startupPipeline->runStep("pickPhysicalDevice", [this]() { pickPhysicalDevice(); });
 	//showPhysicalDeviceSupportedLayersAndExtensions(m_PhysicalDevice);// only show m_PhysicalDevice after pickPhysicalDevice()
-	createDefaultLogicalDevice();
-	collectSwapchainFeatures();
-	createSwapchain();
-	createSynchronizationPrimitives(); // has to be after createSwapchain() for the correct m_SwapChain_ImagesCount
+
+	// Device creation (driver compiles its internal state, may take tens of ms) and the surface queries of
+	//   collectSwapchainFeatures() touch disjoint members, so they overlap;  the swapchain needs both
+	startupPipeline->launchStep("createDefaultLogicalDevice", [this]() { createDefaultLogicalDevice(); });
+	if (VK_NULL_HANDLE != offloadPhysicalDevice) {
+		startupPipeline->launchStep("createComputeOffloadDevice", [this]() {
+			computeOffloadDevice = new SenComputeOffloadDevice(offloadPhysicalDevice, offloadComputeQueueFamilyIndex);
+		});
+	}
+	startupPipeline->runStep("collectSwapchainFeatures", [this]() { collectSwapchainFeatures(); });
+	startupPipeline->waitStep("createDefaultLogicalDevice");
+	startupPipeline->runStep("createSwapchain", [this]() {
+		createSwapchain();
+		createSynchronizationPrimitives(); // has to be after createSwapchain() for the correct m_SwapChain_ImagesCount
+	});
+	if (startupPipeline->hasStep("createComputeOffloadDevice"))
+		startupPipeline->waitStep("createComputeOffloadDevice");
 
 	std::cout << "\n Finish  SLVK_AbstractGLFW::initGlfwVulkanDebugWSI()\n";
 }
@@ -1245,6 +1517,20 @@ void SLVK_AbstractGLFW::initExtensions()
 	if (DEBUG_LAYERS_ENABLED) {
 		debugInstanceExtensionsVector.push_back(VK_EXT_DEBUG_REPORT_EXTENSION_NAME);
 	}
+#if defined( VK_KHR_get_physical_device_properties2 )
+	// Optional, only to query VK_EXT_memory_budget through vkGetPhysicalDeviceMemoryProperties2KHR later
+	uint32_t instanceExtensionsCount = 0;
+	vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionsCount, nullptr);
+	std::vector<VkExtensionProperties> instanceExtensionsVector(instanceExtensionsCount);
+	vkEnumerateInstanceExtensionProperties(nullptr, &instanceExtensionsCount, instanceExtensionsVector.data());
+	for (const auto& instanceExtension : instanceExtensionsVector) {
+		if (0 == std::strcmp(instanceExtension.extensionName, VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME)) {
+			debugInstanceExtensionsVector.push_back(VK_KHR_GET_PHYSICAL_DEVICE_PROPERTIES_2_EXTENSION_NAME);
+			physicalDeviceProperties2Enabled = true;
+			break;
+		}
+	}
+#endif
 
 	/*****************************************************************************************************************************/
 	/*************  For Physical Device Extensions  ******************************************************************************/
@@ -1327,6 +1613,12 @@ void SLVK_AbstractGLFW::showPhysicalDeviceInfo(const VkPhysicalDevice & gpuToChe
 	case 4:			stream << "VK_PHYSICAL_DEVICE_TYPE_CPU\"\n";				break;
 	default:		stream << "Unrecognized GPU Property.deviceType! \n";		break;
 	}
+	VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties{};
+	vkGetPhysicalDeviceMemoryProperties(gpuToCheck, &physicalDeviceMemoryProperties);
+	for (uint32_t heapIndex = 0; heapIndex < physicalDeviceMemoryProperties.memoryHeapCount; heapIndex++) {
+		stream << "\t\t\t\tMemory Heap " << heapIndex << " = \t\t" << physicalDeviceMemoryProperties.memoryHeaps[heapIndex].size / (1024 * 1024) << " MB"
+			<< ((physicalDeviceMemoryProperties.memoryHeaps[heapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) ? ",  device local\n" : "\n");
+	}
 	std::cout << stream.str();
 }
 
@@ -1371,13 +1663,14 @@ bool SLVK_AbstractGLFW::isPhysicalDeviceSuitable(const VkPhysicalDevice& gpuToCh
 	return graphicsQueueIndex >= 0 && presentQueueIndex >= 0;
 }
 
-int SLVK_AbstractGLFW::ratePhysicalDevice(const VkPhysicalDevice & gpuToCheck, int32_t& graphicsQueueIndex, int32_t& presentQueueIndex)
+int SLVK_AbstractGLFW::ratePhysicalDevice(const VkPhysicalDevice & gpuToCheck, const DeviceCapabilityProfile& profile,
+	int32_t& workQueueIndex, int32_t& presentQueueIndex)
 {
-	graphicsQueueIndex = -1; presentQueueIndex = -1;
+	workQueueIndex = -1; presentQueueIndex = -1;
 	if (VK_NULL_HANDLE == gpuToCheck) return 0;
 
 	/************************************************************************************************************/
-	/******* Check Graphics Queue Family support of GPU and get QueueFamilyIndex of Graphics ********************/
+	/******* Check the Queue Families of GPU and get the QueueFamilyIndex of the profile's work *****************/
 	/************************************************************************************************************/
 	uint32_t gpuQueueFamiliesCount = 0;
 	vkGetPhysicalDeviceQueueFamilyProperties(gpuToCheck, &gpuQueueFamiliesCount, nullptr);
@@ -1394,12 +1687,12 @@ int SLVK_AbstractGLFW::ratePhysicalDevice(const VkPhysicalDevice & gpuToCheck, i
 	//	3. Get the index ID for the required Queue family, this ID will act like a handle index to queue.
 
 	for (uint32_t i = 0; i < gpuQueueFamiliesCount; i++) {
-		if (graphicsQueueIndex < 0 && gpuQueueFamiliesPropertiesVector[i].queueCount > 0
-			&& gpuQueueFamiliesPropertiesVector[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
-			graphicsQueueIndex = i;
+		if (workQueueIndex < 0 && gpuQueueFamiliesPropertiesVector[i].queueCount > 0
+			&& profile.requiredQueueFlags == (gpuQueueFamiliesPropertiesVector[i].queueFlags & profile.requiredQueueFlags)) {
+			workQueueIndex = i;
 		}
 
-		if (presentQueueIndex < 0 && gpuQueueFamiliesPropertiesVector[i].queueCount > 0) {
+		if (profile.requirePresent && presentQueueIndex < 0 && gpuQueueFamiliesPropertiesVector[i].queueCount > 0) {
 			VkBool32 presentSupport = VK_FALSE;// WSI_supported, or surface support
 			vkGetPhysicalDeviceSurfaceSupportKHR(gpuToCheck, i, m_Surface, &presentSupport);
 			if (presentSupport) {
@@ -1407,29 +1700,63 @@ int SLVK_AbstractGLFW::ratePhysicalDevice(const VkPhysicalDevice & gpuToCheck, i
 			}
 		}
 
-		if (graphicsQueueIndex >= 0 && presentQueueIndex >= 0)
+		if (workQueueIndex >= 0 && (presentQueueIndex >= 0 || !profile.requirePresent))
 			break;
 	}
-	if (graphicsQueueIndex < 0 || presentQueueIndex < 0) return 0; // If graphics QueueFamilyIndex is still -1 as default, this GPU doesn't support Graphics drawing
+	if (workQueueIndex < 0 || (profile.requirePresent && presentQueueIndex < 0)) return 0; // No family does the profile's work (or presents)
 
 	/************************************************************************************************************/
-	/******* If gets here, Graphics Queue Family support of this this GPU is good *******************************/
+	/******* If gets here, Queue Family support of this this GPU is good, check the profile's features **********/
 	/************************************************************************************************************/
 	VkPhysicalDeviceFeatures physicalDeviceFeatures{};
 	vkGetPhysicalDeviceFeatures(gpuToCheck, &physicalDeviceFeatures);
-	if (!physicalDeviceFeatures.geometryShader || !physicalDeviceFeatures.samplerAnisotropy)
-		return 0;	// Application can't function without geometry shaders
+	if ((profile.requireGeometryShader && !physicalDeviceFeatures.geometryShader)
+		|| (profile.requireSamplerAnisotropy && !physicalDeviceFeatures.samplerAnisotropy))
+		return 0;
+
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(gpuToCheck, &physicalDeviceProperties);
+	if (profile.minSubgroupSize > 0) {
+		uint32_t subgroupSize = 0;	// stays 0 (rejected) without a way to ask
+#if defined(VK_VERSION_1_1) && defined(VK_KHR_get_physical_device_properties2)
+		PFN_vkGetPhysicalDeviceProperties2KHR fetch_vkGetPhysicalDeviceProperties2KHR = physicalDeviceProperties2Enabled
+			? reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR")) : nullptr;
+		if (nullptr != fetch_vkGetPhysicalDeviceProperties2KHR && physicalDeviceProperties.apiVersion >= VK_MAKE_VERSION(1, 1, 0)) {
+			VkPhysicalDeviceSubgroupProperties subgroupProperties{};
+			subgroupProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES;
+			VkPhysicalDeviceProperties2KHR physicalDeviceProperties2{};
+			physicalDeviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+			physicalDeviceProperties2.pNext = &subgroupProperties;
+			fetch_vkGetPhysicalDeviceProperties2KHR(gpuToCheck, &physicalDeviceProperties2);
+			subgroupSize = subgroupProperties.subgroupSize;
+		}
+#endif
+		if (subgroupSize < profile.minSubgroupSize)
+			return 0;
+	}
+
+	VkPhysicalDeviceMemoryProperties physicalDeviceMemoryProperties{};
+	vkGetPhysicalDeviceMemoryProperties(gpuToCheck, &physicalDeviceMemoryProperties);
+	VkDeviceSize largestDeviceLocalHeapSize = 0;
+	for (uint32_t heapIndex = 0; heapIndex < physicalDeviceMemoryProperties.memoryHeapCount; heapIndex++) {
+		if (physicalDeviceMemoryProperties.memoryHeaps[heapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT)
+			largestDeviceLocalHeapSize = (std::max)(largestDeviceLocalHeapSize, physicalDeviceMemoryProperties.memoryHeaps[heapIndex].size);
+	}
+	if (largestDeviceLocalHeapSize < profile.minDeviceLocalBytes)
+		return 0;
 	/************************************************************************************************************/
-	/****** If gets here, Geometry Shader of this GPU is good, let's Rate Score *********************************/
+	/****** If gets here, this GPU can run the profile's workload, let's Rate Score *****************************/
 	/************************************************************************************************************/
 	int score = 0;
-	VkPhysicalDeviceProperties physicalDeviceProperties{};
-	vkGetPhysicalDeviceProperties(gpuToCheck, &physicalDeviceProperties);
-	if (physicalDeviceProperties.deviceType == VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU) {
-		score += 100000;	// Discrete GPUs have a significant performance advantage
+	const VkPhysicalDeviceType preferredDeviceType = profile.preferDiscrete ? VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU : VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU;
+	if (physicalDeviceProperties.deviceType == preferredDeviceType) {
+		score += 100000;	// Discrete GPUs have a significant performance advantage, integrated ones share the host memory
 	}
 	score += physicalDeviceProperties.limits.maxImageDimension2D;// Maximum possible size of textures affects graphics quality
 
+	// Among GPUs of the same type, the one with more device local memory streams and caches more before running out
+	score += static_cast<int>(largestDeviceLocalHeapSize / (1024 * 1024 * 64));	// 16 per GB, a tie breaker next to the type bonus
+
 	return score;
 }
 
@@ -1463,24 +1790,67 @@ void SLVK_AbstractGLFW::pickPhysicalDevice()
 	/******** Rate all available PhysicalDevices and  Pick the best suitable one  *************************/
 	/******** Use an ordered map to automatically sort candidates by increasing score *********************/
 
-	std::multimap<int, VkPhysicalDevice> physicalDevicesScoredMap;
+	/******** Every GPU is probed on its own worker (queue families, surface support, features, heaps),  *********/
+	/******** each with its own queue indices, such that the indices kept are the ones of the picked GPU  *********/
+
+	struct PhysicalDeviceRatingStruct {
+		int								score					= 0;
+		int32_t							graphicsQueueIndex		= -1;
+		int32_t							presentQueueIndex		= -1;
+		int								offloadScore			= 0;	// only with m_ComputeOffloadEnabled
+		int32_t							offloadQueueIndex		= -1;
+	};
+	// Shared with the workers, such that an exception thrown here doesn't leave them writing into a dead stack frame
+	std::shared_ptr<std::vector<PhysicalDeviceRatingStruct>> ratingVector = std::make_shared<std::vector<PhysicalDeviceRatingStruct>>(physicalDevicesCount);
+	for (uint32_t i = 0; i < physicalDevicesCount; i++) {
+		VkPhysicalDevice gpuToRate = physicalDevicesVector[i];
+		startupPipeline->launchStep("ratePhysicalDevice " + std::to_string(i), [this, i, gpuToRate, ratingVector]() {
+			PhysicalDeviceRatingStruct& rating = (*ratingVector)[i];
+			rating.score = ratePhysicalDevice(gpuToRate, m_RenderDeviceProfile, rating.graphicsQueueIndex, rating.presentQueueIndex);// Primary check function in this block
+			if (m_ComputeOffloadEnabled) {
+				int32_t unusedPresentQueueIndex = -1;
+				rating.offloadScore = ratePhysicalDevice(gpuToRate, m_ComputeOffloadProfile, rating.offloadQueueIndex, unusedPresentQueueIndex);
+			}
+		});
+	}
+
+	std::multimap<int, uint32_t> physicalDevicesScoredMap;
 	std::cout << "All Detected GPUs Properties: \n";
-	for (int i = 0; i < physicalDevicesVector.size(); i++) {
-		int score = ratePhysicalDevice(physicalDevicesVector[i], graphicsQueueFamilyIndex, presentQueueFamilyIndex);// Primary check function in this block
+	for (uint32_t i = 0; i < physicalDevicesCount; i++) {
+		startupPipeline->waitStep("ratePhysicalDevice " + std::to_string(i));
+		const PhysicalDeviceRatingStruct& rating = (*ratingVector)[i];
 		showPhysicalDeviceInfo(physicalDevicesVector[i]);
-		physicalDevicesScoredMap.insert(std::make_pair(score, physicalDevicesVector[i]));
-		std::cout << "\t\t\t\tGraphics QueueFamily Index = \t" << graphicsQueueFamilyIndex << std::endl;
-		std::cout << "\t\t\t\tPresent  QueueFamily Index = \t" << presentQueueFamilyIndex << std::endl;
-		std::cout << "\t\t\t\tRated Score = \t\t" << score << std::endl;
+		physicalDevicesScoredMap.insert(std::make_pair(rating.score, i));
+		std::cout << "\t\t\t\tGraphics QueueFamily Index = \t" << rating.graphicsQueueIndex << std::endl;
+		std::cout << "\t\t\t\tPresent  QueueFamily Index = \t" << rating.presentQueueIndex << std::endl;
+		std::cout << "\t\t\t\tRated Score = \t\t" << rating.score << std::endl;
+		if (m_ComputeOffloadEnabled)
+			std::cout << "\t\t\t\tCompute Offload Score = \t" << rating.offloadScore << std::endl;
 	}
 	// Check if the best candidate is suitable at all
 	if (physicalDevicesScoredMap.rbegin()->first > 0) {
-		m_PhysicalDevice = physicalDevicesScoredMap.rbegin()->second;
+		uint32_t pickedIndex		= physicalDevicesScoredMap.rbegin()->second;
+		m_PhysicalDevice			= physicalDevicesVector[pickedIndex];
+		graphicsQueueFamilyIndex	= (*ratingVector)[pickedIndex].graphicsQueueIndex;
+		presentQueueFamilyIndex		= (*ratingVector)[pickedIndex].presentQueueIndex;
 	}
 	else {
 		throw std::runtime_error("failed to find a suitable GPU!");
 	}
 	/******************************************************************************************************/
+	/******** The best other GPU matching m_ComputeOffloadProfile gets the preprocessing jobs      ********/
+	if (m_ComputeOffloadEnabled) {
+		int bestOffloadScore = 0;
+		for (uint32_t i = 0; i < physicalDevicesCount; i++) {
+			if (physicalDevicesVector[i] == m_PhysicalDevice || (*ratingVector)[i].offloadScore <= bestOffloadScore) continue;
+			bestOffloadScore				= (*ratingVector)[i].offloadScore;
+			offloadPhysicalDevice			= physicalDevicesVector[i];
+			offloadComputeQueueFamilyIndex	= (*ratingVector)[i].offloadQueueIndex;
+		}
+		if (VK_NULL_HANDLE == offloadPhysicalDevice)
+			std::cout << "\nNo second GPU matches the compute offload profile, preprocessing stays on the CPU\n";
+	}
+	/******************************************************************************************************/
 	/*****  Acquire the m_PhysicalDeviceMemoryProperties of the selected GPU   *****/
 	vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &m_PhysicalDeviceMemoryProperties);
 	std::cout << "\n\nSelected GPU Properties:\n";	showPhysicalDeviceInfo(m_PhysicalDevice);
@@ -1519,6 +1889,73 @@ void SLVK_AbstractGLFW::createDefaultLogicalDevice()
 		deviceCreateInfo.enabledLayerCount = static_cast<uint32_t>(debugDeviceLayersVector.size());   // depricated
 		deviceCreateInfo.ppEnabledLayerNames = debugDeviceLayersVector.data();				// depricated
 	}
+
+	/*******************************************************************************************************************************/
+	/*** VK_EXT_memory_budget when the driver has it:  live per heap budget and usage for SenMemoryTracker *************************/
+	/*** VK_KHR_timeline_semaphore (core in 1.2) when the driver has it and its feature:  graphicsTimeline without fences **********/
+	/*** VK_EXT_host_image_copy (with its two dependencies) when the driver has it and its feature:  textures skip the staging ring */
+	bool memoryBudgetEnabled = false;
+#if defined( VK_KHR_get_physical_device_properties2 )
+	std::vector<VkExtensionProperties> gpuExtensionsVector;
+	if (physicalDeviceProperties2Enabled) {
+		uint32_t gpuExtensionsCount = 0;
+		vkEnumerateDeviceExtensionProperties(m_PhysicalDevice, nullptr, &gpuExtensionsCount, nullptr);
+		gpuExtensionsVector.resize(gpuExtensionsCount);
+		vkEnumerateDeviceExtensionProperties(m_PhysicalDevice, nullptr, &gpuExtensionsCount, gpuExtensionsVector.data());
+	}
+	auto gpuExtensionSupported = [&gpuExtensionsVector](const char* extensionName) {
+		for (const auto& gpuExtension : gpuExtensionsVector) {
+			if (0 == std::strcmp(gpuExtension.extensionName, extensionName))
+				return true;
+		}
+		return false;
+	};
+	PFN_vkGetPhysicalDeviceFeatures2KHR fetch_vkGetPhysicalDeviceFeatures2KHR = physicalDeviceProperties2Enabled
+		? reinterpret_cast<PFN_vkGetPhysicalDeviceFeatures2KHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceFeatures2KHR")) : nullptr;
+#if defined( VK_EXT_memory_budget )
+	if (gpuExtensionSupported(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME)) {
+		debugDeviceExtensionsVector.push_back(VK_EXT_MEMORY_BUDGET_EXTENSION_NAME);
+		memoryBudgetEnabled = true;
+	}
+#endif
+#if defined( VK_KHR_timeline_semaphore )
+	// Kept alive until vkCreateDevice(), chained to deviceCreateInfo next to pEnabledFeatures
+	VkPhysicalDeviceTimelineSemaphoreFeaturesKHR timelineSemaphoreFeatures{};
+	timelineSemaphoreFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_TIMELINE_SEMAPHORE_FEATURES_KHR;
+	if (nullptr != fetch_vkGetPhysicalDeviceFeatures2KHR && gpuExtensionSupported(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME)) {
+		VkPhysicalDeviceFeatures2KHR physicalDeviceFeatures2{};
+		physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+		physicalDeviceFeatures2.pNext = &timelineSemaphoreFeatures;
+		fetch_vkGetPhysicalDeviceFeatures2KHR(m_PhysicalDevice, &physicalDeviceFeatures2);
+		if (VK_TRUE == timelineSemaphoreFeatures.timelineSemaphore) {
+			debugDeviceExtensionsVector.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+			timelineSemaphoreFeatures.pNext	= nullptr;
+			deviceCreateInfo.pNext			= &timelineSemaphoreFeatures;
+			timelineSemaphoreEnabled		= true;
+		}
+	}
+#endif
+#if defined( VK_EXT_host_image_copy )
+	// Chained in front of whatever deviceCreateInfo.pNext already holds
+	VkPhysicalDeviceHostImageCopyFeaturesEXT hostImageCopyFeatures{};
+	hostImageCopyFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_FEATURES_EXT;
+	if (nullptr != fetch_vkGetPhysicalDeviceFeatures2KHR && gpuExtensionSupported(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME)
+		&& gpuExtensionSupported(VK_KHR_COPY_COMMANDS_2_EXTENSION_NAME) && gpuExtensionSupported(VK_KHR_FORMAT_FEATURE_FLAGS_2_EXTENSION_NAME)) {
+		VkPhysicalDeviceFeatures2KHR physicalDeviceFeatures2{};
+		physicalDeviceFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2_KHR;
+		physicalDeviceFeatures2.pNext = &hostImageCopyFeatures;
+		fetch_vkGetPhysicalDeviceFeatures2KHR(m_PhysicalDevice, &physicalDeviceFeatures2);
+		if (VK_TRUE == hostImageCopyFeatures.hostImageCopy) {
+			debugDeviceExtensionsVector.push_back(VK_EXT_HOST_IMAGE_COPY_EXTENSION_NAME);
+			debugDeviceExtensionsVector.push_back(VK_KHR_COPY_COMMANDS_2_EXTENSION_NAME);
+			debugDeviceExtensionsVector.push_back(VK_KHR_FORMAT_FEATURE_FLAGS_2_EXTENSION_NAME);
+			hostImageCopyFeatures.pNext		= const_cast<void*>(deviceCreateInfo.pNext);
+			deviceCreateInfo.pNext			= &hostImageCopyFeatures;
+			hostImageCopyEnabled			= true;
+		}
+	}
+#endif
+#endif
 	deviceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(debugDeviceExtensionsVector.size());
 	deviceCreateInfo.ppEnabledExtensionNames = debugDeviceExtensionsVector.data();
 
@@ -1527,9 +1964,16 @@ void SLVK_AbstractGLFW::createDefaultLogicalDevice()
 		std::string("Fail at Create Logical Device!")
 	);
 
+	SenMemoryTracker::initialize(m_PhysicalDevice, m_PhysicalDeviceMemoryProperties,
+		memoryBudgetEnabled ? vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceMemoryProperties2KHR") : nullptr);
+
 	// Retrieve queue handles for each queue family
 	vkGetDeviceQueue(m_LogicalDevice, graphicsQueueFamilyIndex, 0, &m_GraphicsQueue);
 	vkGetDeviceQueue(m_LogicalDevice, presentQueueFamilyIndex, 0, &m_SwapchainPresentQueue); // We only need 1 queue, so the third parameter (index) we give is 0.
+
+	graphicsTimeline = new SenQueueTimeline(m_LogicalDevice, m_GraphicsQueue, timelineSemaphoreEnabled);
+	if (hostImageCopyEnabled)
+		hostImageCopy = new SenHostImageCopy(instance, m_PhysicalDevice, m_LogicalDevice);
 }
 
 /*---------------------------------------------------------------------------------------------------------------------------------*/
@@ -1551,17 +1995,6 @@ void SLVK_AbstractGLFW::collectSwapchainFeatures()
 		m_WidgetHeight = (std::max)(m_SurfaceCapabilities.minImageExtent.height, (std::min)(m_SurfaceCapabilities.maxImageExtent.height, static_cast<uint32_t>(m_WidgetHeight)));
 	}
 
-	/****************************************************************************************************************************/
-	/**************************** Reserve swapchain minImageCount ***************************************************************/
-	/****************************************************************************************************************************/
-	// For best performance, possibly at the price of some latency, the minImageCount should be set to at least 3 if supported;
-	// maxImageCount can actually be zero in which case the amount of swapchain images do not have an upper limit other than available memory. 
-	// It's also possible that the swapchain image amount is locked to a certain value on certain systems. The code below takes into consideration both of these possibilities.
-	if (m_SwapChain_ImagesCount < m_SurfaceCapabilities.minImageCount + 1) m_SwapChain_ImagesCount = m_SurfaceCapabilities.minImageCount + 1;
-	if (m_SurfaceCapabilities.maxImageCount > 0) {
-		if (m_SwapChain_ImagesCount > m_SurfaceCapabilities.maxImageCount) m_SwapChain_ImagesCount = m_SurfaceCapabilities.maxImageCount;
-	}
-
 	/****************************************************************************************************************************/
 	/********** Reserve swapchain imageFormat and imageColorSpace ***************************************************************/
 	uint32_t formatCount = 0;
@@ -1587,14 +2020,35 @@ void SLVK_AbstractGLFW::collectSwapchainFeatures()
 	vkGetPhysicalDeviceSurfacePresentModesKHR(m_PhysicalDevice, m_Surface, &presentModeCount, nullptr);
 	std::vector<VkPresentModeKHR> presentModeVector(presentModeCount);
 	vkGetPhysicalDeviceSurfacePresentModesKHR(m_PhysicalDevice, m_Surface, &presentModeCount, presentModeVector.data());
-	for (auto m : presentModeVector) {
-		// VK_PRESENT_MODE_MAILBOX_KHR is good for gaming, but can only get full advantage of MailBox PresentMode with more than 2 buffers,
-		// which means triple-buffering
-		if (m == VK_PRESENT_MODE_MAILBOX_KHR) {
-			m_SwapchainPresentMode = m;
-			break;
-		}
+	auto presentModeSupported = [&presentModeVector](const VkPresentModeKHR& presentMode) {
+		return presentModeVector.end() != std::find(presentModeVector.begin(), presentModeVector.end(), presentMode);
+	};
+	// VK_PRESENT_MODE_MAILBOX_KHR is good for gaming, but can only get full advantage of MailBox PresentMode with more than 2 buffers,
+	// which means triple-buffering;  FIFO blocks on v-sync and lets the GPU idle, IMMEDIATE may tear.
+	m_SwapchainPresentMode = VK_PRESENT_MODE_FIFO_KHR;
+	if (LATENCY_POLICY_LOW_LATENCY == m_LatencyPolicy) {
+		if (presentModeSupported(VK_PRESENT_MODE_MAILBOX_KHR))			m_SwapchainPresentMode = VK_PRESENT_MODE_MAILBOX_KHR;
+		else if (presentModeSupported(VK_PRESENT_MODE_IMMEDIATE_KHR))	m_SwapchainPresentMode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+	}
+	else if (LATENCY_POLICY_THROUGHPUT == m_LatencyPolicy) {
+		if (presentModeSupported(VK_PRESENT_MODE_MAILBOX_KHR))			m_SwapchainPresentMode = VK_PRESENT_MODE_MAILBOX_KHR;
 	}
+
+	/****************************************************************************************************************************/
+	/**************************** Reserve swapchain minImageCount, and how many frames may be in flight *************************/
+	/****************************************************************************************************************************/
+	// For best performance, possibly at the price of some latency, the minImageCount should be set to at least 3 if supported;
+	// maxImageCount can actually be zero in which case the amount of swapchain images do not have an upper limit other than available memory. 
+	// It's also possible that the swapchain image amount is locked to a certain value on certain systems. The code below takes into consideration both of these possibilities.
+	// Every queued image is a frame of latency:  low-latency / power-saving only keep the spare image MAILBOX needs to never block.
+	if (LATENCY_POLICY_THROUGHPUT == m_LatencyPolicy || VK_PRESENT_MODE_MAILBOX_KHR == m_SwapchainPresentMode)
+		m_SwapChain_ImagesCount = m_SurfaceCapabilities.minImageCount + 1;
+	else
+		m_SwapChain_ImagesCount = (std::max)(m_SurfaceCapabilities.minImageCount, 2u);
+	if (m_SurfaceCapabilities.maxImageCount > 0) {
+		if (m_SwapChain_ImagesCount > m_SurfaceCapabilities.maxImageCount) m_SwapChain_ImagesCount = m_SurfaceCapabilities.maxImageCount;
+	}
+	m_MaxFramesInFlight = LATENCY_POLICY_THROUGHPUT == m_LatencyPolicy ? m_SwapChain_ImagesCount : 1;
 }
 
 void SLVK_AbstractGLFW::createSwapchain() {
@@ -1702,28 +2156,44 @@ void SLVK_AbstractGLFW::createSynchronizationPrimitives() {
 	VkSemaphoreCreateInfo semaphoreCreateInfo{};
 	semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-	SLVK_AbstractGLFW::errorCheck(
-		vkCreateSemaphore(m_LogicalDevice, &semaphoreCreateInfo, nullptr, &m_SC_ImageAcquiredSemaphore),
-		std::string("Failed to create m_SC_ImageAcquiredSemaphore !!!")
-	);
-	SLVK_AbstractGLFW::errorCheck(
-		vkCreateSemaphore(m_LogicalDevice, &semaphoreCreateInfo, nullptr, &m_SC_PaintReadyToPresentSemaphore),
-		std::string("Failed to create m_SC_PaintReadyToPresentSemaphore !!!")
-	);
+	// m_MaxFramesInFlight == 0 lets every swapchain image be in flight
+	m_SC_ImageAcquiredSemaphoreVector.resize(m_MaxFramesInFlight > 0 ? m_MaxFramesInFlight : m_SwapChain_ImagesCount, VK_NULL_HANDLE);
+	for (auto& imageAcquiredSemaphore : m_SC_ImageAcquiredSemaphoreVector) {
+		SLVK_AbstractGLFW::errorCheck(
+			vkCreateSemaphore(m_LogicalDevice, &semaphoreCreateInfo, nullptr, &imageAcquiredSemaphore),
+			std::string("Failed to create m_SC_ImageAcquiredSemaphore !!!")
+		);
+	}
+	m_SC_FrameSlotIndex = 0;
+	createPaintReadyToPresentSemaphores();
 
-	VkFenceCreateInfo fenceCreateInfo{};
-	fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-	fenceCreateInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;	// Signaled state, no wait for the first render of each command buffer
-	m_SC_WaitCommandBufferCompleteFencesVector.resize(m_SwapChain_ImagesCount);
-	for (auto& fence : m_SC_WaitCommandBufferCompleteFencesVector)
-	{
+	// 0 is complete from the start, no wait for the first render of each command buffer
+	m_SC_CommandBufferTimelineValueVector.assign(m_SwapChain_ImagesCount, 0);
+}
+
+void SLVK_AbstractGLFW::createPaintReadyToPresentSemaphores() {
+	VkSemaphoreCreateInfo semaphoreCreateInfo{};
+	semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+	m_SC_PaintReadyToPresentSemaphoreVector.resize(m_SwapChain_ImagesCount, VK_NULL_HANDLE);
+	for (auto& paintReadyToPresentSemaphore : m_SC_PaintReadyToPresentSemaphoreVector) {
 		SLVK_AbstractGLFW::errorCheck(
-			vkCreateFence(m_LogicalDevice, &fenceCreateInfo, nullptr, &fence),
-			std::string("Failed to create waitCommandBufferCompleteFences !!!")
+			vkCreateSemaphore(m_LogicalDevice, &semaphoreCreateInfo, nullptr, &paintReadyToPresentSemaphore),
+			std::string("Failed to create m_SC_PaintReadyToPresentSemaphore !!!")
 		);
 	}
 }
 
+void SLVK_AbstractGLFW::destroyPaintReadyToPresentSemaphores() {
+	for (auto& paintReadyToPresentSemaphore : m_SC_PaintReadyToPresentSemaphoreVector) {
+		if (VK_NULL_HANDLE != paintReadyToPresentSemaphore) {
+			vkDestroySemaphore(m_LogicalDevice, paintReadyToPresentSemaphore, nullptr);
+			paintReadyToPresentSemaphore = VK_NULL_HANDLE;
+		}
+	}
+	m_SC_PaintReadyToPresentSemaphoreVector.clear();
+}
+
 /* Draw frames by acquiring images, submitting the right draw command buffer and returning the images back to the swap chain.
 	1. vkAcquireNextImageKHR:	Acquire an image from the SwapChain;
 	2. vkQueueSubmit:			Select the appropriate command buffer for that image and execute it;  m_SwapchainPresentQueue
@@ -1737,9 +2207,10 @@ void SLVK_AbstractGLFW::swapSwapchain()
 	// Use of a presentable image must occur only after the image is returned by vkAcquireNextImageKHR, and before it is presented by vkQueuePresentKHR.
 	// This includes transitioning the image layout and rendering commands.
 	uint32_t swapchainImageIndex;
+	VkSemaphore imageAcquiredSemaphore = m_SC_ImageAcquiredSemaphoreVector[m_SC_FrameSlotIndex];
 	VkResult result = vkAcquireNextImageKHR(m_LogicalDevice, m_SwapChain,
 		UINT64_MAX,							// timeout for this Image Acquire command, i.e., (std::numeric_limits<uint64_t>::max)(),
-		m_SC_ImageAcquiredSemaphore,	// semaphore to signal
+		imageAcquiredSemaphore,				// semaphore to signal
 		VK_NULL_HANDLE,						// fence to signal
 		&swapchainImageIndex
 	);
@@ -1750,46 +2221,36 @@ void SLVK_AbstractGLFW::swapSwapchain()
 	else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR) {
 		throw std::runtime_error("Failed to acquire swap chain image !!!!");
 	}
+	// Signaled, so the slot is taken;  an out of date acquire above left it unsignaled for the next try
+	m_SC_FrameSlotIndex = (m_SC_FrameSlotIndex + 1) % static_cast<uint32_t>(m_SC_ImageAcquiredSemaphoreVector.size());
+	VkSemaphore paintReadyToPresentSemaphore = m_SC_PaintReadyToPresentSemaphoreVector[swapchainImageIndex];
 
-	// Use a fence to wait until the m_SwapchainCommandBufferVector[swapchainImageIndex] has finished last execution before using it again
-	SLVK_AbstractGLFW::errorCheck(
-		vkWaitForFences(m_LogicalDevice, 1, &m_SC_WaitCommandBufferCompleteFencesVector[swapchainImageIndex], VK_TRUE, UINT64_MAX),
-		std::string("Failed to vkWaitForFences m_SC_WaitCommandBufferCompleteFencesVector[swapchainImageIndex] !!")
-	);
-	vkResetFences(m_LogicalDevice, 1, &m_SC_WaitCommandBufferCompleteFencesVector[swapchainImageIndex]);
+	// Wait until the m_SwapchainCommandBufferVector[swapchainImageIndex] has finished last execution before using it again
+	graphicsTimeline->waitUntil(m_SC_CommandBufferTimelineValueVector[swapchainImageIndex]);
+	// m_SwapchainCommandBufferVector[swapchainImageIndex] is no longer in use by GPU, its per-image resources can be rewritten now
+	updateSwapchainImageResources(swapchainImageIndex);
+	// Whatever was queued for upload since the last frame (this image's regions included) is submitted ahead of its commandBuffer
+	if (nullptr != stagingRing)
+		stagingRing->flush();
 
 	/*******************************************************************************************************************************/
 	/*********       2. vkQueueSubmit:			Select the appropriate command buffer for that image and execute it    *************/
 	/*-----------------------------------------------------------------------------------------------------------------------------*/
-	VkSubmitInfo submitInfo = {};
-	submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-
-	std::vector<VkSemaphore> submitInfoWaitSemaphoresVecotr;
-	submitInfoWaitSemaphoresVecotr.push_back(m_SC_ImageAcquiredSemaphore);
-	// Commands before this submitInfoWaitDstStageMaskArray stage could be executed before semaphore signaled
-	VkPipelineStageFlags submitInfoWaitDstStageMaskArray[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-	submitInfo.waitSemaphoreCount = (uint32_t)submitInfoWaitSemaphoresVecotr.size();
-	submitInfo.pWaitSemaphores = submitInfoWaitSemaphoresVecotr.data();
-	submitInfo.pWaitDstStageMask = submitInfoWaitDstStageMaskArray;
+	SenQueueTimeline::SubmitStruct frameSubmit;
+	frameSubmit.waitSemaphoreVector.push_back(imageAcquiredSemaphore);
+	// Commands before this wait dst stage could be executed before semaphore signaled
+	frameSubmit.waitDstStageMaskVector.push_back(VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+	frameSubmit.commandBufferVector.push_back(m_SwapchainCommandBufferVector[swapchainImageIndex]);
+	frameSubmit.signalSemaphoreVector.push_back(paintReadyToPresentSemaphore);
 
-	submitInfo.commandBufferCount = 1;	// wait for submitInfoCommandBuffersVecotr to be created
-	submitInfo.pCommandBuffers = &m_SwapchainCommandBufferVector[swapchainImageIndex];
-
-	std::vector<VkSemaphore> submitInfoSignalSemaphoresVector;
-	submitInfoSignalSemaphoresVector.push_back(m_SC_PaintReadyToPresentSemaphore);
-	submitInfo.signalSemaphoreCount = (uint32_t)submitInfoSignalSemaphoresVector.size();
-	submitInfo.pSignalSemaphores = submitInfoSignalSemaphoresVector.data();
-
-	SLVK_AbstractGLFW::errorCheck(
-		vkQueueSubmit(m_GraphicsQueue, 1, &submitInfo, m_SC_WaitCommandBufferCompleteFencesVector[swapchainImageIndex]),
-		std::string("Failed to submit draw command buffer !!!")
-	);
+	// Its value replaces the per command buffer fence, readbacks of this frame wait on it too
+	m_SC_CommandBufferTimelineValueVector[swapchainImageIndex] = graphicsTimeline->submit(frameSubmit);
 
 	/*******************************************************************************************************************************/
 	/**  3. m_SwapchainPresentQueue		vkQueuePresentKHR:	Return the image to the swap chain for presentation to the screen.   ***/
 	/*-----------------------------------------------------------------------------------------------------------------------------*/
 	std::vector<VkSemaphore> presentInfoWaitSemaphoresVector;
-	presentInfoWaitSemaphoresVector.push_back(m_SC_PaintReadyToPresentSemaphore);
+	presentInfoWaitSemaphoresVector.push_back(paintReadyToPresentSemaphore);
 	VkPresentInfoKHR presentInfo{};
 	presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 	presentInfo.waitSemaphoreCount = (uint32_t)presentInfoWaitSemaphoresVector.size();
@@ -1801,6 +2262,8 @@ void SLVK_AbstractGLFW::swapSwapchain()
 	presentInfo.pImageIndices = &swapchainImageIndex;
 
 	result = vkQueuePresentKHR(m_SwapchainPresentQueue, &presentInfo);
+	presentTimePoint = std::chrono::high_resolution_clock::now();
+	inFlightSwapchainImageIndexVector.push_back(swapchainImageIndex);
 	if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
 		reCreateRenderTarget();
 	}
@@ -1809,6 +2272,40 @@ void SLVK_AbstractGLFW::swapSwapchain()
 	}
 }
 
+void SLVK_AbstractGLFW::waitForFramesInFlight()
+{
+	// Timeline values only grow, waiting on an already completed (or newer, after a resubmission) value is harmless;
+	//   bound by the acquire semaphores, the slot of the next frame is free once its previous frame's submit completed
+	while (inFlightSwapchainImageIndexVector.size() >= m_SC_ImageAcquiredSemaphoreVector.size()) {
+		graphicsTimeline->waitUntil(m_SC_CommandBufferTimelineValueVector[inFlightSwapchainImageIndexVector.front()]);
+		inFlightSwapchainImageIndexVector.erase(inFlightSwapchainImageIndexVector.begin());
+	}
+}
+
+void SLVK_AbstractGLFW::paceFrame()
+{
+	if (m_FrameLimitFramesPerSecond <= 0.0) return;
+
+	/****************************************************************************************************************************/
+	/**********      Frames start on a fixed period grid;  a missed deadline re-anchors the grid instead of bursting     ********/
+	/****************************************************************************************************************************/
+	auto framePeriod = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+		std::chrono::duration<double>(1.0 / m_FrameLimitFramesPerSecond));
+	nextFrameDeadline += framePeriod;
+
+	auto currentTime = std::chrono::high_resolution_clock::now();
+	if (currentTime >= nextFrameDeadline) {
+		nextFrameDeadline = currentTime;
+		return;
+	}
+	// OS sleep is only good to about a millisecond, spin the rest
+	const auto spinMargin = std::chrono::milliseconds(1);
+	if (nextFrameDeadline - currentTime > spinMargin)
+		std::this_thread::sleep_for(nextFrameDeadline - currentTime - spinMargin);
+	while (std::chrono::high_resolution_clock::now() < nextFrameDeadline)
+		std::this_thread::yield();
+}
+
 /*---------------------------------------------------------------------------------------------------------------------------------*/
 void SLVK_AbstractGLFW::reInitPresentation()
 {
@@ -1832,6 +2329,13 @@ void SLVK_AbstractGLFW::reInitPresentation()
 
 	cleanUpSwapChain();
 	createSwapchain();
+
+	// createSwapchain() re-queried the image count, and the old image indices mean nothing to the new swapchain;
+	//   nothing is in flight anymore after vkDeviceWaitIdle()
+	m_SC_CommandBufferTimelineValueVector.assign(m_SwapChain_ImagesCount, 0);
+	inFlightSwapchainImageIndexVector.clear();
+	destroyPaintReadyToPresentSemaphores();
+	createPaintReadyToPresentSemaphores();
 }
 
 void SLVK_AbstractGLFW::finalizeAbstractGLFW() {
@@ -1855,6 +2359,33 @@ void SLVK_AbstractGLFW::finalizeAbstractGLFW() {
 		m_ColorAttachOnlyRenderPass = VK_NULL_HANDLE;
 	}
 	/************************************************************************************************************/
+	/*********************     Drop prefetched assets never taken, join the startup workers     *****************/
+	/************************************************************************************************************/
+	if (nullptr != startupPipeline) {
+		discardPrefetchedResults(prefetchedShaderMap, startupPipeline);
+		discardPrefetchedResults(prefetchedTextureMap, startupPipeline);
+		delete startupPipeline;
+		startupPipeline = nullptr;
+	}
+	/************************************************************************************************************/
+	/*********************     Destroy computeOffloadDevice, runs its queued jobs first     *********************/
+	/************************************************************************************************************/
+	if (nullptr != computeOffloadDevice) {
+		delete computeOffloadDevice;
+		computeOffloadDevice = nullptr;
+	}
+	/************************************************************************************************************/
+	/*********************           Destroy stagingRing, waits for its last batches        *********************/
+	/************************************************************************************************************/
+	if (nullptr != stagingRing) {
+		delete stagingRing;
+		stagingRing = nullptr;
+	}
+	if (nullptr != hostImageCopy) {
+		delete hostImageCopy;
+		hostImageCopy = nullptr;
+	}
+	/************************************************************************************************************/
 	/*********************           Destroy m_DefaultThreadCommandPool         ***********************************/
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != m_DefaultThreadCommandPool) {
@@ -1868,7 +2399,7 @@ void SLVK_AbstractGLFW::finalizeAbstractGLFW() {
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != singleRectIndexBuffer) {
 		vkDestroyBuffer(m_LogicalDevice, singleRectIndexBuffer, nullptr);
-		vkFreeMemory(m_LogicalDevice, singleRectIndexBufferMemory, nullptr);	// always try to destroy before free
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, singleRectIndexBufferMemory);	// always try to destroy before free
 
 		singleRectIndexBuffer = VK_NULL_HANDLE;
 		singleRectIndexBufferMemory = VK_NULL_HANDLE;
@@ -1895,23 +2426,26 @@ void SLVK_AbstractGLFW::finalizeAbstractGLFW() {
 	/************************************************************************************************************/
 	/*********************           Destroy Synchronization Items             **********************************/
 	/************************************************************************************************************/
-	if (VK_NULL_HANDLE != m_SC_ImageAcquiredSemaphore) {
-		vkDestroySemaphore(m_LogicalDevice, m_SC_ImageAcquiredSemaphore, nullptr);
-		m_SC_ImageAcquiredSemaphore = VK_NULL_HANDLE;
-	}
-	if (VK_NULL_HANDLE != m_SC_PaintReadyToPresentSemaphore) {
-		vkDestroySemaphore(m_LogicalDevice, m_SC_PaintReadyToPresentSemaphore, nullptr);
-		m_SC_PaintReadyToPresentSemaphore = VK_NULL_HANDLE;
+	for (auto& imageAcquiredSemaphore : m_SC_ImageAcquiredSemaphoreVector) {
+		if (VK_NULL_HANDLE != imageAcquiredSemaphore) {
+			vkDestroySemaphore(m_LogicalDevice, imageAcquiredSemaphore, nullptr);
+			imageAcquiredSemaphore = VK_NULL_HANDLE;
+		}
 	}
-	for (auto& fence : m_SC_WaitCommandBufferCompleteFencesVector) {
-		vkDestroyFence(m_LogicalDevice, fence, nullptr);
+	m_SC_ImageAcquiredSemaphoreVector.clear();
+	destroyPaintReadyToPresentSemaphores();
+	m_SC_CommandBufferTimelineValueVector.clear();
+	if (nullptr != graphicsTimeline) {
+		delete graphicsTimeline;
+		graphicsTimeline = nullptr;
 	}
-	m_SC_WaitCommandBufferCompleteFencesVector.clear();
 
 	/************************************************************************************************************/
 	/*********************           Destroy logical m_LogicalDevice                **************************************/
 	/************************************************************************************************************/
 	if (VK_NULL_HANDLE != m_LogicalDevice) {
+		// Peaks of the whole run;  bytes still tracked here were never given back through freeDeviceMemory()
+		std::cout << SenMemoryTracker::report();
 		vkDestroyDevice(m_LogicalDevice, VK_NULL_HANDLE);
 
 		// Device queues are implicitly cleaned up when the m_LogicalDevice is destroyed
@@ -2118,11 +2652,59 @@ void SLVK_AbstractGLFW::createMvpUniformBuffers() {
 
 }
 
+void SLVK_AbstractGLFW::createMvpUniformRegionsBuffer() {
+	/************************************************************************************************************/
+	/*********     Destroy old mvpOptimalUniformBuffer first if the swapchain images count changed     **********/
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != mvpOptimalUniformBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, mvpOptimalUniformBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, mvpOptimalUniformBufferMemory);	// always try to destroy before free
+
+		mvpOptimalUniformBuffer			= VK_NULL_HANDLE;
+		mvpOptimalUniformBufferMemory	= VK_NULL_HANDLE;
+	}
+
+	// Descriptor (and dynamic) offsets have to be multiples of minUniformBufferOffsetAlignment (a power of two)
+	VkPhysicalDeviceProperties physicalDeviceProperties{};
+	vkGetPhysicalDeviceProperties(m_PhysicalDevice, &physicalDeviceProperties);
+	const VkDeviceSize offsetAlignment = (std::max)(physicalDeviceProperties.limits.minUniformBufferOffsetAlignment, VkDeviceSize(1));
+	mvpUniformRegionStride = (sizeof(MvpUniformBufferObject) + offsetAlignment - 1) & ~(offsetAlignment - 1);
+
+	mvpUniformRegionsCount = m_SwapChain_ImagesCount;
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, mvpUniformRegionStride * mvpUniformRegionsCount,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+		mvpOptimalUniformBuffer, mvpOptimalUniformBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+}
+
+void SLVK_AbstractGLFW::uploadMvpUniformRegion(const MvpUniformBufferObject& mvpUbo, const uint32_t& swapchainImageIndex) {
+	if (nullptr == stagingRing || swapchainImageIndex >= mvpUniformRegionsCount) return;
+
+	// Flushed by swapSwapchain() right after updateSwapchainImageResources(), ahead of this image's commandBuffer
+	stagingRing->uploadToBuffer(&mvpUbo, sizeof(mvpUbo), mvpOptimalUniformBuffer, swapchainImageIndex * mvpUniformRegionStride);
+}
+
+void SLVK_AbstractGLFW::writeMvpUniformRegionsDescriptor(const VkDescriptorSet& descriptorSet) {
+	VkDescriptorBufferInfo mvpDescriptorBufferInfo{};
+	mvpDescriptorBufferInfo.buffer	= mvpOptimalUniformBuffer;
+	mvpDescriptorBufferInfo.offset	= 0;
+	mvpDescriptorBufferInfo.range	= sizeof(MvpUniformBufferObject);	// one region, the dynamic offset selects which
+	VkWriteDescriptorSet uniformBuffer_DS_Write{};
+	uniformBuffer_DS_Write.sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+	uniformBuffer_DS_Write.descriptorType	= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+	uniformBuffer_DS_Write.dstSet			= descriptorSet;
+	uniformBuffer_DS_Write.dstBinding		= m_UniformBuffer_DS_BindingIndex;	// binding number, same with the binding index  in shader
+	uniformBuffer_DS_Write.dstArrayElement	= 0;
+	uniformBuffer_DS_Write.descriptorCount	= 1;
+	uniformBuffer_DS_Write.pBufferInfo		= &mvpDescriptorBufferInfo;
+
+	vkUpdateDescriptorSets(m_LogicalDevice, 1, &uniformBuffer_DS_Write, 0, nullptr);
+}
+
 /*****************************************************************************************************************/
 /*-----------             Depth Test FrameBuffer related            ---------------------------------------------*/
 /*---------------------------------------------------------------------------------------------------------------*/
 
-void SLVK_AbstractGLFW::createDepthTestAttachment()
+void SLVK_AbstractGLFW::selectDepthTestFormat()
 {
 	/********************************************************************************************************************/
 	/******    If first time (not resize):  Check depthTestImage Format,  Initial depthTestImageSubresourceRange     ****/
@@ -2152,11 +2734,16 @@ void SLVK_AbstractGLFW::createDepthTestAttachment()
 		depthTestImageSubresourceRange.baseArrayLayer = 0;	// first arrayLayer to start
 		depthTestImageSubresourceRange.layerCount = 1;
 	}
+}
+
+void SLVK_AbstractGLFW::createDepthTestAttachment()
+{
+	selectDepthTestFormat();
 	/********************************************************************************************************************/
 	/***************************     Create depthTest Image     *********************************************************/
-	SLVK_AbstractGLFW::createResourceImage(m_LogicalDevice, m_WidgetWidth, m_WidgetHeight, VK_IMAGE_TYPE_2D,  // depthTestImage is also a 2D image
-		depthTestFormat, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, depthTestImage
-		, depthTestImageDeviceMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties);
+	// Cleared at the start of depthTestRenderPass and never stored:  no memory needs to back it on tile-based GPUs
+	SLVK_AbstractGLFW::createTransientAttachmentImage(m_LogicalDevice, m_WidgetWidth, m_WidgetHeight, depthTestFormat,
+		VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, "depthTest", depthTestImage, depthTestImageDeviceMemory, m_PhysicalDeviceMemoryProperties);
 
 	/********************************************************************************************************************/
 	/******************************     Create depthTest Image View    **************************************************/
@@ -2168,10 +2755,7 @@ void SLVK_AbstractGLFW::createDepthTestAttachment()
 	depthTestImageViewCreateInfo.subresourceRange = depthTestImageSubresourceRange;
 
 	vkCreateImageView(m_LogicalDevice, &depthTestImageViewCreateInfo, nullptr, &depthTestImageView);
-	/********************************************************************************************************************/
-	/******************************     Transition depthTest ImageLayout     ********************************************/
-	SLVK_AbstractGLFW::transitionResourceImageLayout(depthTestImage, depthTestImageSubresourceRange, VK_IMAGE_LAYOUT_PREINITIALIZED,
-		VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL, m_LogicalDevice, m_DefaultThreadCommandPool, m_GraphicsQueue);
+	// No layout transition:  depthTestRenderPass takes it from VK_IMAGE_LAYOUT_UNDEFINED
 }
 
 void SLVK_AbstractGLFW::createDepthTestRenderPass()
@@ -2297,16 +2881,11 @@ void SLVK_AbstractGLFW::createDepthTestSwapchainFramebuffers()
 /*-----------             Depth Stencil FrameBuffer related, Not Applicable Yet    ------------------------------*/
 /*---------------------------------------------------------------------------------------------------------------*/
 
-///* A helper function that records memory barrirers using the vkCmdPipelineBarrier() command */
+///* A helper function that queues the memory barrirer into barrierBatch, recorded by its next flush(commandBuffer) */
 void SLVK_AbstractGLFW::setImageMemoryBarrier(VkImage image, VkImageAspectFlags imageAspectFlags
 	, VkImageLayout oldImageLayout, VkImageLayout newImageLayout
-	, VkAccessFlagBits srcAccessFlagBits, const VkCommandBuffer& imageLayoutTransitionCommandBuffer)
+	, VkAccessFlagBits srcAccessFlagBits, SenBarrierBatch& barrierBatch)
 {
-	// Dependency on imageLayoutTransitionCommandBuffer
-	if (VK_NULL_HANDLE == imageLayoutTransitionCommandBuffer) {
-		throw std::runtime_error("failed to open file!");
-	}
-
 	VkImageMemoryBarrier imgMemoryBarrier{};
 	imgMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
 	imgMemoryBarrier.pNext = NULL;
@@ -2314,47 +2893,23 @@ void SLVK_AbstractGLFW::setImageMemoryBarrier(VkImage image, VkImageAspectFlags
 	imgMemoryBarrier.dstAccessMask = 0;
 	imgMemoryBarrier.oldLayout = oldImageLayout;
 	imgMemoryBarrier.newLayout = newImageLayout;
+	imgMemoryBarrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+	imgMemoryBarrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
 	imgMemoryBarrier.image = image;
 	imgMemoryBarrier.subresourceRange.aspectMask = imageAspectFlags;
 	imgMemoryBarrier.subresourceRange.baseMipLevel = 0;
 	imgMemoryBarrier.subresourceRange.levelCount = 1;
 	imgMemoryBarrier.subresourceRange.layerCount = 1;
 
-	if (oldImageLayout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL) {
-		imgMemoryBarrier.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-	}
-
-	switch (newImageLayout)
-	{
-		// Ensure that anything that was copying from this image has completed
-		// An image in this layout can only be used as the destination operand of the commands
-	case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
-	case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:
-		imgMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		break;
-
-		// Ensure any Copy or CPU writes to image are flushed
-		// An image in this layout can only be used as a read-only shader resource
-	case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
-		imgMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-		imgMemoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-		break;
-
-		// An image in this layout can only be used as a framebuffer color attachment
-	case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
-		imgMemoryBarrier.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-		break;
+	// Access masks derived from the layouts, the stages that go with them instead of TOP_OF_PIPE on both sides
+	VkAccessFlags oldLayoutAccessMask = 0, newLayoutAccessMask = 0;
+	VkPipelineStageFlags srcStages = 0, destStages = 0;
+	SenBarrierBatch::layoutAccessAndStage(oldImageLayout, true, oldLayoutAccessMask, srcStages);
+	SenBarrierBatch::layoutAccessAndStage(newImageLayout, false, newLayoutAccessMask, destStages);
+	imgMemoryBarrier.srcAccessMask |= oldLayoutAccessMask;
+	imgMemoryBarrier.dstAccessMask = newLayoutAccessMask;
 
-		// An image in this layout can only be used as a framebuffer depth/stencil attachment
-	case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
-		imgMemoryBarrier.dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-		break;
-	}
-
-	VkPipelineStageFlags srcStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-	VkPipelineStageFlags destStages = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-
-	vkCmdPipelineBarrier(imageLayoutTransitionCommandBuffer, srcStages, destStages, 0, 0, NULL, 0, NULL, 1, &imgMemoryBarrier);
+	barrierBatch.addImageBarrier(imgMemoryBarrier, srcStages, destStages);
 }
 
 void SLVK_AbstractGLFW::createDepthStencilAttachment()
@@ -2381,45 +2936,9 @@ void SLVK_AbstractGLFW::createDepthStencilAttachment()
 	else std::cout << "The seleted depthStencilFormat is not in the stencil list !!!!! \n \t Take a check !!!!\n";
 
 	/******************************************************************************************************************************************************/
-	/******************************  Create depthStencil Image ********************************************************************************************/
-	VkImageCreateInfo depthStencilImageCreateInfo{};
-	depthStencilImageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-	depthStencilImageCreateInfo.flags = 0;
-	depthStencilImageCreateInfo.imageType = VK_IMAGE_TYPE_2D; // 2D image
-	depthStencilImageCreateInfo.format = depthStencilFormat;
-	depthStencilImageCreateInfo.extent.width = m_WidgetWidth;
-	depthStencilImageCreateInfo.extent.height = m_WidgetHeight;
-	depthStencilImageCreateInfo.extent.depth = 1; // 2D image, has to be 1
-	depthStencilImageCreateInfo.mipLevels = 1;
-	depthStencilImageCreateInfo.arrayLayers = 1;
-	depthStencilImageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT; // multi-sampling
-	depthStencilImageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-	depthStencilImageCreateInfo.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;// for depth stencil image
-	depthStencilImageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE; // no share with anther QueueFamily
-	depthStencilImageCreateInfo.queueFamilyIndexCount = 0;
-	depthStencilImageCreateInfo.pQueueFamilyIndices = nullptr;
-	depthStencilImageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED; // will overwrite this with a command later
-
-	vkCreateImage(m_LogicalDevice, &depthStencilImageCreateInfo, nullptr, &depthStencilImage);
-
-	/******************************************************************************************************************************************************/
-	/***************************  Allocate & Bind memory for depthStencil Image using the created handle *********************************************************/
-	VkMemoryRequirements imageMemoryRequirements{};
-	vkGetImageMemoryRequirements(m_LogicalDevice, depthStencilImage, &imageMemoryRequirements);
-
-	uint32_t gpuMemoryTypeIndex = SLVK_AbstractGLFW::findPhysicalDeviceMemoryPropertyIndex(
-		m_PhysicalDeviceMemoryProperties,
-		imageMemoryRequirements,
-		VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT  // Set the resource to reside on GPU itself
-	);
-
-	VkMemoryAllocateInfo depthStencilImageMemoryAllocateInfo{};
-	depthStencilImageMemoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	depthStencilImageMemoryAllocateInfo.allocationSize = imageMemoryRequirements.size;
-	depthStencilImageMemoryAllocateInfo.memoryTypeIndex = gpuMemoryTypeIndex;
-
-	vkAllocateMemory(m_LogicalDevice, &depthStencilImageMemoryAllocateInfo, nullptr, &depthStencilImageDeviceMemory);
-	vkBindImageMemory(m_LogicalDevice, depthStencilImage, depthStencilImageDeviceMemory, 0);
+	/******************************  Create depthStencil Image:  transient, both aspects live within depthStencilRenderPass only  ************************/
+	SLVK_AbstractGLFW::createTransientAttachmentImage(m_LogicalDevice, m_WidgetWidth, m_WidgetHeight, depthStencilFormat,
+		VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, "depthStencil", depthStencilImage, depthStencilImageDeviceMemory, m_PhysicalDeviceMemoryProperties);
 
 	/******************************************************************************************************************************************************/
 	/******************************  Create depthStencil Image View ***************************************************************************************/
@@ -2469,8 +2988,8 @@ void SLVK_AbstractGLFW::createDepthStencilRenderPass()
 	attachmentDescriptionsArray[0].samples = VK_SAMPLE_COUNT_1_BIT;
 	attachmentDescriptionsArray[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
 	attachmentDescriptionsArray[0].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	attachmentDescriptionsArray[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	attachmentDescriptionsArray[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_STORE;
+	attachmentDescriptionsArray[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	attachmentDescriptionsArray[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;	// transient, nothing reads the stencil after the pass
 	attachmentDescriptionsArray[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
 	attachmentDescriptionsArray[0].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
 
@@ -45,6 +45,13 @@
 #include <shaderc/shaderc.hpp>
 
 
+class SenStagingRing;
+class SenStartupPipeline;
+class SenComputeOffloadDevice;
+class SenQueueTimeline;
+class SenBarrierBatch;
+class SenHostImageCopy;
+
 class SLVK_AbstractGLFW
 {
 public:
@@ -56,6 +63,9 @@ public:
 	);
 	static void errorCheck(VkResult result, std::string msg);
 	static void createVulkanShaderModule(const VkDevice& logicalDevice, const std::string& diskFileAddress, VkShaderModule& shaderModule);
+	static void createVulkanShaderModule(const VkDevice& logicalDevice, const std::vector<uint32_t>& spirv32Vector, VkShaderModule& shaderModule);
+	// .spv is read as is, .vert/.frag/.geom/.comp GLSL goes through shadercToSPIRV();  empty on compile error
+	static std::vector<uint32_t> compileShaderToSPIRV(const std::string& diskFileAddress);
 
 	/*---------------------------------------------------------------------------------------------------------------*/
 	static const std::vector<VkFormat> depthStencilSupportCheckFormatsVector;
@@ -73,18 +83,32 @@ public:
 		VkBuffer& bufferToCreate, VkDeviceMemory& bufferDeviceMemoryToAllocate, const VkMemoryPropertyFlags& requiredMemoryPropertyFlags);
 	static void transferResourceBuffer(const VkCommandPool& bufferTransferCommandPool, const VkDevice& logicalDevice, const VkQueue& bufferMemoryTransferQueue,
 		const VkBuffer& srcBuffer, const VkBuffer& dstBuffer, const VkDeviceSize& resourceBufferSize);
+	static void createPersistentMappedBuffer(const VkDevice& logicalDevice, const VkDeviceSize& bufferDeviceSize,
+		const VkBufferUsageFlags& bufferUsageFlags, const VkSharingMode& bufferSharingMode, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+		VkBuffer& bufferToCreate, VkDeviceMemory& bufferDeviceMemoryToAllocate, void*& persistentMappedData);
+	// vkFreeMemory() that also drops the allocation from SenMemoryTracker
+	static void freeDeviceMemory(const VkDevice& logicalDevice, const VkDeviceMemory& deviceMemoryToFree);
 
 	/*---------------------------------------------------------------------------------------------------------------*/
 	static void createDeviceLocalTexture(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties
 		, const char*& textureDiskAddress, const VkImageType& imageType, int& textureWidth, int& textureHeight
 		, VkImage& deviceLocalTextureToCreate, VkDeviceMemory& textureDeviceMemoryToAllocate, VkImageView& textureImageViewToCreate
-		, const VkSharingMode& imageSharingMode, const VkCommandPool& tmpCommandBufferCommandPool, const VkQueue& imageMemoryTransferQueue);
+		, const VkSharingMode& imageSharingMode, SenStagingRing& stagingRing);
 	static void createTextureSampler(const VkDevice& logicalDevice, VkSampler& textureSamplerToCreate);
 
 	static void createResourceImage(const VkDevice& logicalDevice, const uint32_t& imageWidth, const uint32_t& imageHeight
 		, const VkImageType& imageType, const VkFormat& imageFormat, const VkImageTiling& imageTiling, const VkImageUsageFlags& imageUsageFlags
 		, VkImage& imageToCreate, VkDeviceMemory& imageDeviceMemoryToAllocate, const VkMemoryPropertyFlags& requiredMemoryPropertyFlags
 		, const VkSharingMode& imageSharingMode, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties, const uint32_t& layerCount);
+	// Attachments living within one render pass (depth, stencil):  TRANSIENT_ATTACHMENT usage on LAZILY_ALLOCATED memory where the
+	//   device has it (tile-based / integrated GPUs keep them in tile memory), DEVICE_LOCAL otherwise;  initialLayout UNDEFINED
+	static void createTransientAttachmentImage(const VkDevice& logicalDevice, const uint32_t& imageWidth, const uint32_t& imageHeight
+		, const VkFormat& imageFormat, const VkImageUsageFlags& attachmentUsageFlags, const std::string& attachmentName
+		, VkImage& imageToCreate, VkDeviceMemory& imageDeviceMemoryToAllocate, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties);
+	// false if none of memoryRequirements.memoryTypeBits is LAZILY_ALLOCATED (most discrete GPUs)
+	static bool findLazilyAllocatedMemoryTypeIndex(const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties
+		, const VkMemoryRequirements& memoryRequirements, uint32_t& lazilyAllocatedMemoryTypeIndex);
+	static void reportTransientAttachment(const std::string& attachmentName, const VkDeviceSize& attachmentBytes, const bool& lazilyAllocated);
 	static void transitionResourceImageLayout(const VkImage& imageToTransitionLayout, const VkImageSubresourceRange& imageSubresourceRangeToTransition
 		, const VkImageLayout& oldImageLayout, const VkImageLayout& newImageLayout
 		, const VkDevice& logicalDevice, const VkCommandPool& transitionImageLayoutCommandPool, const VkQueue& imageMemoryTransferQueue);
@@ -98,13 +122,42 @@ public:
 	static void createDeviceLocalTextureArray(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties
 		, const std::vector<std::string> & texturesDiskAddressVector, const VkImageType& imageType
 		, VkImage& deviceLocalTextureToCreate, VkDeviceMemory& textureDeviceMemoryToAllocate, VkImageView& textureImageViewToCreate
-		, const VkSharingMode& imageSharingMode, const VkCommandPool& tmpCommandBufferCommandPool, const VkQueue& imageMemoryTransferQueue);
+		, const VkSharingMode& imageSharingMode, SenStagingRing& stagingRing);
 
 	/*---------------------------------------------------------------------------------------------------------------*/
 	/*---------------------------------------------------------------------------------------------------------------*/
 	SLVK_AbstractGLFW();
 	virtual ~SLVK_AbstractGLFW();
 
+	/*---------------------------------------------------------------------------------------------------------------*/
+	// LOW_LATENCY:   MAILBOX (else IMMEDIATE), one frame in flight, input polled right before the frame is built
+	// THROUGHPUT:    MAILBOX (else FIFO), minImageCount + 1 images, one frame in flight per swapchain image
+	// POWER_SAVING:  FIFO with the fewest images, one frame in flight, capped at 30 FPS unless a limit is given
+	enum LatencyPolicy { LATENCY_POLICY_LOW_LATENCY, LATENCY_POLICY_THROUGHPUT, LATENCY_POLICY_POWER_SAVING };
+	// Has to be called before showWidget(); frameLimitFramesPerSecond == 0 means no limiter (but POWER_SAVING's default)
+	void setLatencyPolicy(const LatencyPolicy& latencyPolicy, const double& frameLimitFramesPerSecond = 0.0);
+
+	/*---------------------------------------------------------------------------------------------------------------*/
+	// What a workload needs from a GPU;  pickPhysicalDevice() rejects GPUs missing any of it and rates the rest
+	struct DeviceCapabilityProfile {
+		VkQueueFlags					requiredQueueFlags		= VK_QUEUE_GRAPHICS_BIT;	// all in one queue family
+		bool							requirePresent			= true;		// a queue family presenting to m_Surface
+		bool							requireGeometryShader	= false;
+		bool							requireSamplerAnisotropy	= true;
+		VkDeviceSize					minDeviceLocalBytes		= 0;		// largest DEVICE_LOCAL heap
+		uint32_t						minSubgroupSize			= 0;		// 0: don't care;  else needs Vulkan 1.1 and physical device properties2
+		bool							preferDiscrete			= true;		// else integrated GPUs get the type bonus
+	};
+	// Compute queue only, any size, integrated GPUs first:  preprocessing jobs for SenComputeOffloadDevice
+	static DeviceCapabilityProfile defaultComputeOffloadProfile();
+	// Both have to be called before showWidget();  the offload device is only created if another GPU than the rendering
+	//   one matches its profile, else computeOffloadDevice stays nullptr and preprocessing stays on the CPU
+	void setRenderDeviceProfile(const DeviceCapabilityProfile& renderDeviceProfile);
+	void enableComputeOffloadDevice(const DeviceCapabilityProfile& computeOffloadProfile = defaultComputeOffloadProfile());
+	// Has to be called before showWidget():  once the staging ring exists, times a batch of texture uploads through it and
+	//   through VK_EXT_host_image_copy (when the device has it) and prints both
+	void enableTextureUploadComparison();
+
 	void showWidget();
 
 protected:
@@ -114,6 +167,16 @@ protected:
 	virtual void finalizeWidget()			= 0;
 	virtual void updateUniformBuffer()		= 0;
 	virtual void onKeyboardReaction(GLFWwindow* widget, int key, int scancode, int action, int mode);
+	// Called right after the graphicsTimeline value of swapchainImageIndex completed, per-image resources (e.g. instance buffer regions) are free to rewrite
+	virtual void updateSwapchainImageResources(const uint32_t& swapchainImageIndex);
+	// Called first thing in showWidget(), before the window or the device exist:  call prefetchShader() / prefetchTexture()
+	//   for what initVulkanApplication() will load, such that compiling and decoding run while the device is brought up
+	virtual void prefetchStartupAssets();
+
+	// Start compiling / decoding on a worker thread, createVulkanShaderModule() and createDeviceLocalTexture(Array)() of
+	//   the same disk address later take the result (waiting for it if needed) instead of loading again
+	void prefetchShader(const std::string& diskFileAddress);
+	void prefetchTexture(const std::string& diskFileAddress);
 
 	const int DEFAULT_widgetWidth	= 800;	// 640;
 	const int DEFAULT_widgetHeight	= 600;	// 640;
@@ -121,27 +184,39 @@ protected:
 	void createColorAttachOnlyRenderPass();
 	void createColorAttachOnlySwapchainFramebuffers();
 	void createDefaultCommandPool();
+	void compareTextureUploadPaths();
 	void createSingleRectIndexBuffer();
 	/*****************************************************************************************************************/
 	/*-----------     Necessary Structures for Resources Descrition       -------------------------------------------*/
 	/*---------------------------------------------------------------------------------------------------------------*/
 	void createMvpUniformBuffers();
+	// One MVP region per swapchain image in mvpOptimalUniformBuffer (no staging buffer):  the staging ring rewrites only the region
+	//   of the image whose frame completed, never one the frames in flight still read;  call again if m_SwapChain_ImagesCount changed
+	void createMvpUniformRegionsBuffer();
 
 	struct MvpUniformBufferObject {
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = glm::mat4(1.0f);
 		glm::mat4 projection = glm::mat4(1.0f);
 	};
+	// Queue the copy into the swapchainImageIndex region, from updateSwapchainImageResources() once its timeline value completed
+	void uploadMvpUniformRegion(const MvpUniformBufferObject& mvpUbo, const uint32_t& swapchainImageIndex);
+	// For a set shared by all swapchain images:  m_UniformBuffer_DS_BindingIndex as UNIFORM_BUFFER_DYNAMIC, bound with mvpUniformDynamicOffset()
+	void writeMvpUniformRegionsDescriptor(const VkDescriptorSet& descriptorSet);
+	uint32_t mvpUniformDynamicOffset(const uint32_t& swapchainImageIndex) const { return static_cast<uint32_t>(swapchainImageIndex * mvpUniformRegionStride); }
 
 	const int						m_UniformBuffer_DS_BindingIndex = 0;
 	VkBuffer						mvpUniformStagingBuffer = VK_NULL_HANDLE;
 	VkDeviceMemory					mvpUniformStagingBufferDeviceMemory = VK_NULL_HANDLE;
 	VkBuffer						mvpOptimalUniformBuffer = VK_NULL_HANDLE;
 	VkDeviceMemory					mvpOptimalUniformBufferMemory = VK_NULL_HANDLE;
+	VkDeviceSize					mvpUniformRegionStride = 0;		// aligned to minUniformBufferOffsetAlignment, also the dynamic offset step
+	uint32_t						mvpUniformRegionsCount = 0;
 
 	/*****************************************************************************************************************/
 	/*-----------             Depth Test FrameBuffer related            ---------------------------------------------*/
 	/*---------------------------------------------------------------------------------------------------------------*/
+	void selectDepthTestFormat();	// also used by samples handing the depth image to a SenRenderGraph
 	void createDepthTestAttachment();
 	void createDepthTestRenderPass();
 	void createDepthTestSwapchainFramebuffers();
@@ -167,7 +242,7 @@ protected:
 
 	void setImageMemoryBarrier(VkImage image, VkImageAspectFlags imageAspectFlags
 		, VkImageLayout oldImageLayout, VkImageLayout newImageLayout
-		, VkAccessFlagBits srcAccessFlagBits, const VkCommandBuffer& imageLayoutTransitionCommandBuffer);
+		, VkAccessFlagBits srcAccessFlagBits, SenBarrierBatch& barrierBatch);
 	void createDepthStencilAttachment();
 	void createDepthStencilRenderPass();
 	void createDepthStencilGraphicsPipeline();
@@ -212,12 +287,35 @@ protected:
 	std::vector<VkImageView>		m_SwapchainImageViewsVector;	// m_SwapchainImageViewsVector has the same life length as m_SwapchainFramebufferVector
 	std::vector<VkFramebuffer>		m_SwapchainFramebufferVector;
 	std::vector<VkCommandBuffer>	m_SwapchainCommandBufferVector;
-	/**** Three Default (no need to change) SwapChain (SC) Synchronization Primitives:  one VkFence vector, two VkSemaphore ***/
-	std::vector<VkFence>			m_SC_WaitCommandBufferCompleteFencesVector;
-	VkSemaphore m_SC_ImageAcquiredSemaphore;		// wait for SWI, from VK_IMAGE_LAYOUT_PRESENT_SRC_KHR to VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
-	VkSemaphore m_SC_PaintReadyToPresentSemaphore;	// wait for GPU, from VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL to VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+	/**** Three Default (no need to change) SwapChain (SC) Synchronization Primitives:  one timeline value vector, two VkSemaphore vectors ***/
+	std::vector<uint64_t>			m_SC_CommandBufferTimelineValueVector;	// graphicsTimeline value of each command buffer's last submission
+	// One per frame in flight:  a slot comes back only after waitForFramesInFlight() saw the submit that waited on it complete
+	std::vector<VkSemaphore>		m_SC_ImageAcquiredSemaphoreVector;		// wait for SWI, from VK_IMAGE_LAYOUT_PRESENT_SRC_KHR to VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
+	// One per swapchain image:  reacquiring an image means its last present consumed the semaphore
+	std::vector<VkSemaphore>		m_SC_PaintReadyToPresentSemaphoreVector;	// wait for GPU, from VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL to VK_IMAGE_LAYOUT_PRESENT_SRC_KHR
+	uint32_t						m_SC_FrameSlotIndex			= 0;		// m_SC_ImageAcquiredSemaphoreVector of the next frame
+
+	/*****************************************************************************************************************/
+	/*-----------      Latency policy, frame limiter / pacing, and input-to-present latency measurement    ----------*/
+	/*---------------------------------------------------------------------------------------------------------------*/
+	LatencyPolicy					m_LatencyPolicy				= LATENCY_POLICY_THROUGHPUT;
+	uint32_t						m_MaxFramesInFlight			= 0;		// 0: as many as swapchain images, set by collectSwapchainFeatures()
+	double							m_FrameLimitFramesPerSecond	= 0.0;
+	bool							m_ReportFramePacing			= false;	// only once a policy was picked explicitly
+	std::chrono::high_resolution_clock::time_point	presentTimePoint;		// right after the last vkQueuePresentKHR
 
 	VkCommandPool					m_DefaultThreadCommandPool	= VK_NULL_HANDLE;
+	// Every m_GraphicsQueue upload goes through it, created with m_DefaultThreadCommandPool and flushed once per frame
+	SenStagingRing*					stagingRing					= nullptr;
+	const VkDeviceSize				m_StagingRingBytes			= 16 * 1024 * 1024;
+	// Startup steps run and timed from showWidget() until the first frame was presented, see SenStartupPipeline
+	SenStartupPipeline*				startupPipeline				= nullptr;
+	// Every m_GraphicsQueue submission that anything waits on:  frames, staging ring batches, single time commands
+	SenQueueTimeline*				graphicsTimeline			= nullptr;
+	// Second logical device for preprocessing compute jobs, see enableComputeOffloadDevice();  nullptr when there is none
+	SenComputeOffloadDevice*		computeOffloadDevice		= nullptr;
+	// Textures written by the host right into the image, see SenHostImageCopy;  nullptr without VK_EXT_host_image_copy
+	SenHostImageCopy*				hostImageCopy				= nullptr;
 	VkRenderPass					m_ColorAttachOnlyRenderPass	= VK_NULL_HANDLE;
 	VkBuffer						singleRectIndexBuffer		= VK_NULL_HANDLE;
 	VkDeviceMemory					singleRectIndexBufferMemory = VK_NULL_HANDLE;
@@ -251,12 +349,31 @@ private:
 	std::vector<const char*> debugInstanceExtensionsVector;
 	std::vector<const char*> debugDeviceLayersVector; 		// depricated, but still recommended
 	std::vector<const char*> debugDeviceExtensionsVector;
+	bool							physicalDeviceProperties2Enabled	= false;	// VK_KHR_get_physical_device_properties2, needed by VK_EXT_memory_budget
+	bool							timelineSemaphoreEnabled	= false;	// VK_KHR_timeline_semaphore, else SenQueueTimeline emulates it with fences
+	bool							hostImageCopyEnabled		= false;	// VK_EXT_host_image_copy and its hostImageCopy feature
+	bool							m_CompareTextureUploadPaths	= false;
+
+	DeviceCapabilityProfile			m_RenderDeviceProfile;
+	DeviceCapabilityProfile			m_ComputeOffloadProfile;
+	bool							m_ComputeOffloadEnabled		= false;
+	VkPhysicalDevice				offloadPhysicalDevice		= VK_NULL_HANDLE;	// picked by pickPhysicalDevice(), never m_PhysicalDevice
+	int32_t							offloadComputeQueueFamilyIndex	= -1;
 
 	VkDebugReportCallbackCreateInfoEXT	debugReportCallbackCreateInfo{}; // important for creations of both instance and debugReportCallback
 	VkDebugReportCallbackEXT			debugReportCallback						= VK_NULL_HANDLE;
 	PFN_vkCreateDebugReportCallbackEXT	fetch_vkCreateDebugReportCallbackEXT	= VK_NULL_HANDLE;
 	PFN_vkDestroyDebugReportCallbackEXT	fetch_vkDestroyDebugReportCallbackEXT	= VK_NULL_HANDLE;
 
+	std::vector<uint32_t>			inFlightSwapchainImageIndexVector;	// submission order, oldest first
+	std::chrono::high_resolution_clock::time_point	nextFrameDeadline;
+	std::chrono::high_resolution_clock::time_point	framePacingReportTime;
+	uint64_t						framePacingFramesCount		= 0;
+	double							inputToPresentMillisecondsSum	= 0.0;
+	double							inputToPresentMillisecondsMax	= 0.0;
+	double							frameMillisecondsSum		= 0.0;
+	double							frameMillisecondsSquareSum	= 0.0;
+
 	void initGlfwVulkanDebugWSI();
 	void initDebugLayers();
 	void initExtensions();
@@ -269,7 +386,9 @@ private:
 
 	void showPhysicalDeviceInfo(const VkPhysicalDevice& gpuToCheck);
 	bool isPhysicalDeviceSuitable(const VkPhysicalDevice& gpuToCheck, int32_t& graphicsQueueIndex, int32_t& presentQueueIndex);
-	int  ratePhysicalDevice(const VkPhysicalDevice& gpuToCheck, int32_t& graphicsQueueIndex, int32_t& presentQueueIndex);
+	// 0 if gpuToCheck misses anything of profile;  workQueueIndex is a family with all of profile.requiredQueueFlags
+	int  ratePhysicalDevice(const VkPhysicalDevice& gpuToCheck, const DeviceCapabilityProfile& profile,
+		int32_t& workQueueIndex, int32_t& presentQueueIndex);
 	void pickPhysicalDevice();
 	void createDefaultLogicalDevice();
 
@@ -277,7 +396,12 @@ private:
 	void createSwapchain();
 	void cleanUpSwapChain();
 	void createSynchronizationPrimitives();
+	// Per swapchain image, so recreated along with the swapchain
+	void createPaintReadyToPresentSemaphores();
+	void destroyPaintReadyToPresentSemaphores();
 	void swapSwapchain();
+	void waitForFramesInFlight();
+	void paceFrame();
 
 	void reInitPresentation();
 	void finalizeAbstractGLFW();
@@ -0,0 +1,146 @@
+#include "SenBarrierBatch.h"
+
+void SenBarrierBatch::addImageLayoutTransition(const VkImage& image, const VkImageSubresourceRange& subresourceRange,
+	const VkImageLayout& oldImageLayout, const VkImageLayout& newImageLayout)
+{
+	if (newImageLayout == VK_IMAGE_LAYOUT_UNDEFINED || newImageLayout == VK_IMAGE_LAYOUT_PREINITIALIZED)
+		throw std::runtime_error(" The newImageLayout must not be VK_IMAGE_LAYOUT_UNDEFINED or VK_IMAGE_LAYOUT_PREINITIALIZED  !!!");
+
+	VkImageMemoryBarrier imageMemoryBarrier{};
+	imageMemoryBarrier.sType				= VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+	imageMemoryBarrier.oldLayout			= oldImageLayout;
+	imageMemoryBarrier.newLayout			= newImageLayout;
+	imageMemoryBarrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	imageMemoryBarrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	imageMemoryBarrier.image				= image;
+	imageMemoryBarrier.subresourceRange		= subresourceRange;
+
+	VkPipelineStageFlags srcStageMask = 0, dstStageMask = 0;
+	SenBarrierBatch::layoutAccessAndStage(oldImageLayout, true, imageMemoryBarrier.srcAccessMask, srcStageMask);
+	SenBarrierBatch::layoutAccessAndStage(newImageLayout, false, imageMemoryBarrier.dstAccessMask, dstStageMask);
+	addImageBarrier(imageMemoryBarrier, srcStageMask, dstStageMask);
+}
+
+void SenBarrierBatch::addImageBarrier(const VkImageMemoryBarrier& imageMemoryBarrier, const VkPipelineStageFlags& srcStageMask,
+	const VkPipelineStageFlags& dstStageMask)
+{
+	BarrierGroupStruct& barrierGroup = groupFor(imageMemoryBarrier.image, VK_NULL_HANDLE);
+	barrierGroup.imageBarrierVector.push_back(imageMemoryBarrier);
+	barrierGroup.srcStageMask |= srcStageMask;
+	barrierGroup.dstStageMask |= dstStageMask;
+}
+
+void SenBarrierBatch::addBufferBarrier(const VkBuffer& buffer, const VkAccessFlags& srcAccessMask, const VkAccessFlags& dstAccessMask,
+	const VkPipelineStageFlags& srcStageMask, const VkPipelineStageFlags& dstStageMask, const VkDeviceSize& offset, const VkDeviceSize& size)
+{
+	VkBufferMemoryBarrier bufferMemoryBarrier{};
+	bufferMemoryBarrier.sType				= VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+	bufferMemoryBarrier.srcAccessMask		= srcAccessMask;
+	bufferMemoryBarrier.dstAccessMask		= dstAccessMask;
+	bufferMemoryBarrier.srcQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	bufferMemoryBarrier.dstQueueFamilyIndex	= VK_QUEUE_FAMILY_IGNORED;
+	bufferMemoryBarrier.buffer				= buffer;
+	bufferMemoryBarrier.offset				= offset;
+	bufferMemoryBarrier.size				= size;
+
+	BarrierGroupStruct& barrierGroup = groupFor(VK_NULL_HANDLE, buffer);
+	barrierGroup.bufferBarrierVector.push_back(bufferMemoryBarrier);
+	barrierGroup.srcStageMask |= srcStageMask;
+	barrierGroup.dstStageMask |= dstStageMask;
+}
+
+void SenBarrierBatch::addMemoryBarrier(const VkAccessFlags& srcAccessMask, const VkAccessFlags& dstAccessMask,
+	const VkPipelineStageFlags& srcStageMask, const VkPipelineStageFlags& dstStageMask)
+{
+	BarrierGroupStruct& barrierGroup = groupFor(VK_NULL_HANDLE, VK_NULL_HANDLE);
+	if (!barrierGroup.memoryBarrierVector.empty()) {	// one global barrier per group is enough, merge the masks
+		barrierGroup.memoryBarrierVector.front().srcAccessMask |= srcAccessMask;
+		barrierGroup.memoryBarrierVector.front().dstAccessMask |= dstAccessMask;
+	}
+	else {
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType			= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.srcAccessMask	= srcAccessMask;
+		memoryBarrier.dstAccessMask	= dstAccessMask;
+		barrierGroup.memoryBarrierVector.push_back(memoryBarrier);
+	}
+	barrierGroup.srcStageMask |= srcStageMask;
+	barrierGroup.dstStageMask |= dstStageMask;
+}
+
+void SenBarrierBatch::flush(const VkCommandBuffer& commandBuffer)
+{
+	if (VK_NULL_HANDLE == commandBuffer)
+		throw std::runtime_error("No commandBuffer to record the barrier batch into !!!");
+
+	for (const auto& barrierGroup : barrierGroupVector) {
+		vkCmdPipelineBarrier(commandBuffer, barrierGroup.srcStageMask, barrierGroup.dstStageMask, 0,
+			static_cast<uint32_t>(barrierGroup.memoryBarrierVector.size()), barrierGroup.memoryBarrierVector.data(),
+			static_cast<uint32_t>(barrierGroup.bufferBarrierVector.size()), barrierGroup.bufferBarrierVector.data(),
+			static_cast<uint32_t>(barrierGroup.imageBarrierVector.size()), barrierGroup.imageBarrierVector.data());
+		barrierCallsCount++;
+		barriersCount += barrierGroup.memoryBarrierVector.size() + barrierGroup.bufferBarrierVector.size() + barrierGroup.imageBarrierVector.size();
+	}
+	barrierGroupVector.clear();
+}
+
+void SenBarrierBatch::layoutAccessAndStage(const VkImageLayout& imageLayout, const bool& srcSide,
+	VkAccessFlags& accessMask, VkPipelineStageFlags& stageMask)
+{
+	VkAccessFlags readAccessMask = 0, writeAccessMask = 0;
+	switch (imageLayout) {
+	case VK_IMAGE_LAYOUT_UNDEFINED:		// content is discarded, nothing to wait for
+		stageMask		= VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;									break;
+	case VK_IMAGE_LAYOUT_PREINITIALIZED:	// written by the host before the submission
+		writeAccessMask	= VK_ACCESS_HOST_WRITE_BIT;
+		stageMask		= VK_PIPELINE_STAGE_HOST_BIT;											break;
+	case VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL:
+		readAccessMask	= VK_ACCESS_TRANSFER_READ_BIT;
+		stageMask		= VK_PIPELINE_STAGE_TRANSFER_BIT;										break;
+	case VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL:
+		writeAccessMask	= VK_ACCESS_TRANSFER_WRITE_BIT;
+		stageMask		= VK_PIPELINE_STAGE_TRANSFER_BIT;										break;
+	case VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL:
+		readAccessMask	= VK_ACCESS_SHADER_READ_BIT;
+		stageMask		= VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;	break;
+	case VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL:
+		readAccessMask	= VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+		writeAccessMask	= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+		stageMask		= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;						break;
+	case VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL:
+		readAccessMask	= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT;
+		writeAccessMask	= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		stageMask		= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;		break;
+	case VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL:
+		readAccessMask	= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+		stageMask		= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;	break;
+	case VK_IMAGE_LAYOUT_GENERAL:			// storage images, anything may touch them
+		readAccessMask	= VK_ACCESS_MEMORY_READ_BIT;
+		writeAccessMask	= VK_ACCESS_MEMORY_WRITE_BIT;
+		stageMask		= VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;									break;
+	case VK_IMAGE_LAYOUT_PRESENT_SRC_KHR:	// the presentation engine syncs through semaphores, only the stages matter
+		stageMask		= srcSide ? VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT : VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;	break;
+	default:
+		throw std::invalid_argument("unsupported layout transition!");
+	}
+	accessMask = srcSide ? writeAccessMask : (readAccessMask | writeAccessMask);
+}
+
+SenBarrierBatch::BarrierGroupStruct& SenBarrierBatch::groupFor(const VkImage& image, const VkBuffer& buffer)
+{
+	if (barrierGroupVector.empty())
+		barrierGroupVector.push_back(BarrierGroupStruct());
+
+	BarrierGroupStruct& lastGroup = barrierGroupVector.back();
+	bool alreadyInGroup = false;
+	if (VK_NULL_HANDLE != image)
+		for (const auto& imageMemoryBarrier : lastGroup.imageBarrierVector)
+			alreadyInGroup = alreadyInGroup || imageMemoryBarrier.image == image;
+	if (VK_NULL_HANDLE != buffer)
+		for (const auto& bufferMemoryBarrier : lastGroup.bufferBarrierVector)
+			alreadyInGroup = alreadyInGroup || bufferMemoryBarrier.buffer == buffer;
+
+	if (alreadyInGroup)
+		barrierGroupVector.push_back(BarrierGroupStruct());
+	return barrierGroupVector.back();
+}
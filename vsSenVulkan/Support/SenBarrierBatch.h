@@ -0,0 +1,59 @@
+#pragma once
+
+#ifndef __SenBarrierBatch__
+#define __SenBarrierBatch__
+
+#include "SLVK_AbstractGLFW.h"
+
+/*
+	Collects the image, buffer and global memory barriers a commandBuffer needs at one point and records them with a
+	single vkCmdPipelineBarrier, src/dst stage masks OR-merged, instead of one barrier call (or one single time submit)
+	per transition.  addImageLayoutTransition() derives access and stage masks from the two layouts.
+	A barrier on an image or buffer that already has one in the batch (A -> B then B -> C) cannot share that call:
+	it opens a new group, and flush() records one vkCmdPipelineBarrier per group, in the order they were added.
+	Synchronization1 only, VK_KHR_synchronization2 is not enabled on the devices created here.  Not thread safe.
+*/
+class SenBarrierBatch
+{
+public:
+	void addImageLayoutTransition(const VkImage& image, const VkImageSubresourceRange& subresourceRange,
+		const VkImageLayout& oldImageLayout, const VkImageLayout& newImageLayout);
+	void addImageBarrier(const VkImageMemoryBarrier& imageMemoryBarrier, const VkPipelineStageFlags& srcStageMask,
+		const VkPipelineStageFlags& dstStageMask);
+	void addBufferBarrier(const VkBuffer& buffer, const VkAccessFlags& srcAccessMask, const VkAccessFlags& dstAccessMask,
+		const VkPipelineStageFlags& srcStageMask, const VkPipelineStageFlags& dstStageMask,
+		const VkDeviceSize& offset = 0, const VkDeviceSize& size = VK_WHOLE_SIZE);
+	void addMemoryBarrier(const VkAccessFlags& srcAccessMask, const VkAccessFlags& dstAccessMask,
+		const VkPipelineStageFlags& srcStageMask, const VkPipelineStageFlags& dstStageMask);
+
+	// Records every barrier added since the last flush and empties the batch;  an empty batch records nothing
+	void flush(const VkCommandBuffer& commandBuffer);
+	void clear() { barrierGroupVector.clear(); }
+	bool empty() const { return barrierGroupVector.empty(); }
+
+	// Accesses an image in imageLayout is used for, and the stages doing them;  srcSide keeps the write accesses only,
+	//   the ones a barrier has to make available
+	static void layoutAccessAndStage(const VkImageLayout& imageLayout, const bool& srcSide,
+		VkAccessFlags& accessMask, VkPipelineStageFlags& stageMask);
+
+	uint64_t recordedBarrierCallsCount() const { return barrierCallsCount; }
+	uint64_t recordedBarriersCount() const { return barriersCount; }
+
+private:
+	struct BarrierGroupStruct {
+		VkPipelineStageFlags				srcStageMask			= 0;
+		VkPipelineStageFlags				dstStageMask			= 0;
+		std::vector<VkMemoryBarrier>		memoryBarrierVector;
+		std::vector<VkBufferMemoryBarrier>	bufferBarrierVector;
+		std::vector<VkImageMemoryBarrier>	imageBarrierVector;
+	};
+
+	// The group a barrier on image / buffer (VK_NULL_HANDLE for global ones) goes to, opening a new one if needed
+	BarrierGroupStruct& groupFor(const VkImage& image, const VkBuffer& buffer);
+
+	std::vector<BarrierGroupStruct>		barrierGroupVector;
+	uint64_t							barrierCallsCount		= 0;
+	uint64_t							barriersCount			= 0;
+};
+
+#endif // !__SenBarrierBatch__
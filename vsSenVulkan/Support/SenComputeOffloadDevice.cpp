@@ -0,0 +1,443 @@
+#include "SenComputeOffloadDevice.h"
+
+#include <algorithm>
+#include <cstring>
+
+SenComputeOffloadDevice::SenComputeOffloadDevice(const VkPhysicalDevice& physicalDevice, const int32_t& computeQueueFamilyIndex)
+	: m_PhysicalDevice(physicalDevice)
+{
+	vkGetPhysicalDeviceProperties(m_PhysicalDevice, &m_PhysicalDeviceProperties);
+	vkGetPhysicalDeviceMemoryProperties(m_PhysicalDevice, &m_PhysicalDeviceMemoryProperties);
+
+	/****************************************************************************************************************************/
+	/**********      One compute queue, no extensions or features:  storage buffers and push constants only      ***************/
+	/****************************************************************************************************************************/
+	float queuePriority = 1.0f;
+	VkDeviceQueueCreateInfo queueCreateInfo{};
+	queueCreateInfo.sType				= VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+	queueCreateInfo.queueFamilyIndex	= computeQueueFamilyIndex;
+	queueCreateInfo.queueCount			= 1;
+	queueCreateInfo.pQueuePriorities	= &queuePriority;
+
+	VkDeviceCreateInfo deviceCreateInfo{};
+	deviceCreateInfo.sType					= VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+	deviceCreateInfo.queueCreateInfoCount	= 1;
+	deviceCreateInfo.pQueueCreateInfos		= &queueCreateInfo;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDevice(m_PhysicalDevice, &deviceCreateInfo, nullptr, &m_LogicalDevice),
+		std::string("Failed to create compute offload Logical Device !!!")
+	);
+	vkGetDeviceQueue(m_LogicalDevice, computeQueueFamilyIndex, 0, &m_ComputeQueue);
+
+	VkCommandPoolCreateInfo commandPoolCreateInfo{};
+	commandPoolCreateInfo.sType				= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	commandPoolCreateInfo.queueFamilyIndex	= computeQueueFamilyIndex;
+	commandPoolCreateInfo.flags				= VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;	// one commandBuffer, re-recorded per job
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateCommandPool(m_LogicalDevice, &commandPoolCreateInfo, nullptr, &jobCommandPool),
+		std::string("Failed to create compute offload commandPool !!!")
+	);
+
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+	commandBufferAllocateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.commandPool			= jobCommandPool;
+	commandBufferAllocateInfo.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount	= 1;
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateCommandBuffers(m_LogicalDevice, &commandBufferAllocateInfo, &jobCommandBuffer),
+		std::string("Failed to allocate compute offload commandBuffer !!!")
+	);
+
+	VkFenceCreateInfo fenceCreateInfo{};
+	fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateFence(m_LogicalDevice, &fenceCreateInfo, nullptr, &jobFence),
+		std::string("Failed to create compute offload fence !!!")
+	);
+
+	/****************************************************************************************************************************/
+	/**********      Three storage buffers and the push constants, the same layout for every job pipeline      *****************/
+	/****************************************************************************************************************************/
+	std::vector<VkDescriptorSetLayoutBinding> storageBufferBindingVector(3);
+	for (uint32_t binding = 0; binding < storageBufferBindingVector.size(); binding++) {
+		storageBufferBindingVector[binding].binding			= binding;
+		storageBufferBindingVector[binding].descriptorType	= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		storageBufferBindingVector[binding].descriptorCount	= 1;
+		storageBufferBindingVector[binding].stageFlags		= VK_SHADER_STAGE_COMPUTE_BIT;
+	}
+	VkDescriptorSetLayoutCreateInfo descriptorSetLayoutCreateInfo{};
+	descriptorSetLayoutCreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	descriptorSetLayoutCreateInfo.bindingCount	= static_cast<uint32_t>(storageBufferBindingVector.size());
+	descriptorSetLayoutCreateInfo.pBindings		= storageBufferBindingVector.data();
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorSetLayout(m_LogicalDevice, &descriptorSetLayoutCreateInfo, nullptr, &job_DSL),
+		std::string("Failed to create compute offload DescriptorSetLayout !!!")
+	);
+
+	VkDescriptorPoolSize storageBufferDescriptorPoolSize{};
+	storageBufferDescriptorPoolSize.type			= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+	storageBufferDescriptorPoolSize.descriptorCount	= static_cast<uint32_t>(storageBufferBindingVector.size());
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+	descriptorPoolCreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.poolSizeCount	= 1;
+	descriptorPoolCreateInfo.pPoolSizes		= &storageBufferDescriptorPoolSize;
+	descriptorPoolCreateInfo.maxSets		= 1;	// jobs run one after the other, the set is rewritten per job
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorPool(m_LogicalDevice, &descriptorPoolCreateInfo, nullptr, &jobDescriptorPool),
+		std::string("Failed to create compute offload DescriptorPool !!!")
+	);
+
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+	descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.descriptorPool		= jobDescriptorPool;
+	descriptorSetAllocateInfo.descriptorSetCount	= 1;
+	descriptorSetAllocateInfo.pSetLayouts			= &job_DSL;
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateDescriptorSets(m_LogicalDevice, &descriptorSetAllocateInfo, &job_DS),
+		std::string("Failed to allocate compute offload DescriptorSet !!!")
+	);
+
+	VkPushConstantRange pushConstantRange{};
+	pushConstantRange.stageFlags	= VK_SHADER_STAGE_COMPUTE_BIT;
+	pushConstantRange.offset		= 0;
+	pushConstantRange.size			= sizeof(JobPushConstantsStruct);
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+	pipelineLayoutCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.setLayoutCount			= 1;
+	pipelineLayoutCreateInfo.pSetLayouts			= &job_DSL;
+	pipelineLayoutCreateInfo.pushConstantRangeCount	= 1;
+	pipelineLayoutCreateInfo.pPushConstantRanges	= &pushConstantRange;
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreatePipelineLayout(m_LogicalDevice, &pipelineLayoutCreateInfo, nullptr, &jobPipelineLayout),
+		std::string("Failed to create compute offload PipelineLayout !!!")
+	);
+
+	std::cout << "\t SenComputeOffloadDevice created on " << m_PhysicalDeviceProperties.deviceName << "\n";
+	jobThread = std::thread(&SenComputeOffloadDevice::jobThreadLoop, this);
+}
+
+SenComputeOffloadDevice::~SenComputeOffloadDevice()
+{
+	{
+		std::lock_guard<std::mutex> jobLock(jobMutex);
+		jobThreadQuit = true;
+	}
+	jobConditionVariable.notify_all();
+	if (jobThread.joinable())
+		jobThread.join();	// runs the jobs already queued first, nobody is left waiting on a broken promise
+
+	if (VK_NULL_HANDLE != m_LogicalDevice) {
+		vkDeviceWaitIdle(m_LogicalDevice);
+
+		if (VK_NULL_HANDLE != mipChainPipeline) {
+			vkDestroyPipeline(m_LogicalDevice, mipChainPipeline, nullptr);
+			mipChainPipeline = VK_NULL_HANDLE;
+		}
+		if (VK_NULL_HANDLE != meshletBoundsPipeline) {
+			vkDestroyPipeline(m_LogicalDevice, meshletBoundsPipeline, nullptr);
+			meshletBoundsPipeline = VK_NULL_HANDLE;
+		}
+		if (VK_NULL_HANDLE != jobPipelineLayout) {
+			vkDestroyPipelineLayout(m_LogicalDevice, jobPipelineLayout, nullptr);
+			jobPipelineLayout = VK_NULL_HANDLE;
+		}
+		if (VK_NULL_HANDLE != jobDescriptorPool) {
+			vkDestroyDescriptorPool(m_LogicalDevice, jobDescriptorPool, nullptr);	// frees job_DS as well
+			jobDescriptorPool = VK_NULL_HANDLE;
+			job_DS = VK_NULL_HANDLE;
+		}
+		if (VK_NULL_HANDLE != job_DSL) {
+			vkDestroyDescriptorSetLayout(m_LogicalDevice, job_DSL, nullptr);
+			job_DSL = VK_NULL_HANDLE;
+		}
+		if (VK_NULL_HANDLE != jobFence) {
+			vkDestroyFence(m_LogicalDevice, jobFence, nullptr);
+			jobFence = VK_NULL_HANDLE;
+		}
+		if (VK_NULL_HANDLE != jobCommandPool) {
+			vkDestroyCommandPool(m_LogicalDevice, jobCommandPool, nullptr);	// frees jobCommandBuffer as well
+			jobCommandPool = VK_NULL_HANDLE;
+			jobCommandBuffer = VK_NULL_HANDLE;
+		}
+		vkDestroyDevice(m_LogicalDevice, nullptr);
+		m_LogicalDevice = VK_NULL_HANDLE;
+	}
+	OutputDebugString("\n\t ~SenComputeOffloadDevice()\n");
+}
+
+std::shared_future<std::vector<SenComputeOffloadDevice::MipLevelStruct>> SenComputeOffloadDevice::generateMipChain(
+	std::vector<uint8_t> level0TexelVector, const uint32_t& width, const uint32_t& height)
+{
+	if (0 == width || 0 == height || level0TexelVector.size() != (size_t)width * height * 4)
+		throw std::runtime_error("generateMipChain() needs width x height RGBA8 texels !!!");
+
+	std::shared_ptr<std::vector<uint8_t>> sharedLevel0 = std::make_shared<std::vector<uint8_t>>(std::move(level0TexelVector));
+	return enqueueJob<std::vector<MipLevelStruct>>([this, sharedLevel0, width, height]() {
+		/************************************************************************************************************/
+		/**********    Every level in one buffer, level 0 first, offsets counted in RGBA8 texels     ****************/
+		/************************************************************************************************************/
+		std::vector<MipLevelStruct> mipLevelVector(1);
+		std::vector<uint32_t> texelOffsetVector(1, 0);
+		mipLevelVector[0].width		= width;
+		mipLevelVector[0].height	= height;
+		uint32_t texelsCount = width * height;
+		while (mipLevelVector.back().width > 1 || mipLevelVector.back().height > 1) {
+			MipLevelStruct dstLevel{};
+			dstLevel.width	= (std::max)(mipLevelVector.back().width / 2, 1u);
+			dstLevel.height	= (std::max)(mipLevelVector.back().height / 2, 1u);
+			texelOffsetVector.push_back(texelsCount);
+			texelsCount += dstLevel.width * dstLevel.height;
+			mipLevelVector.push_back(dstLevel);
+		}
+
+		JobBufferStruct mipChainBuffer = createJobBuffer((VkDeviceSize)texelsCount * 4);
+		memcpy(mipChainBuffer.mappedData, sharedLevel0->data(), sharedLevel0->size());
+		try {
+			runDispatches({ &mipChainBuffer }, [&](const VkCommandBuffer& commandBuffer) {
+				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mipChainPipeline);
+				for (size_t dstMip = 1; dstMip < mipLevelVector.size(); dstMip++) {
+					JobPushConstantsStruct pushConstants{};
+					pushConstants.srcOffset	= texelOffsetVector[dstMip - 1];
+					pushConstants.srcWidth	= mipLevelVector[dstMip - 1].width;
+					pushConstants.srcHeight	= mipLevelVector[dstMip - 1].height;
+					pushConstants.dstOffset	= texelOffsetVector[dstMip];
+					pushConstants.dstWidth	= mipLevelVector[dstMip].width;
+					pushConstants.dstHeight	= mipLevelVector[dstMip].height;
+					vkCmdPushConstants(commandBuffer, jobPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+					vkCmdDispatch(commandBuffer, (pushConstants.dstWidth + m_MipWorkGroupSize - 1) / m_MipWorkGroupSize,
+						(pushConstants.dstHeight + m_MipWorkGroupSize - 1) / m_MipWorkGroupSize, 1);
+
+					// The next level reads what this one wrote
+					VkMemoryBarrier levelMemoryBarrier{};
+					levelMemoryBarrier.sType			= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+					levelMemoryBarrier.srcAccessMask	= VK_ACCESS_SHADER_WRITE_BIT;
+					levelMemoryBarrier.dstAccessMask	= VK_ACCESS_SHADER_READ_BIT;
+					vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+						0, 1, &levelMemoryBarrier, 0, nullptr, 0, nullptr);
+				}
+			});
+		}
+		catch (...) {
+			destroyJobBuffer(mipChainBuffer);
+			throw;
+		}
+
+		const uint8_t* mappedTexels = static_cast<const uint8_t*>(mipChainBuffer.mappedData);
+		mipLevelVector[0].texelVector = std::move(*sharedLevel0);
+		for (size_t mip = 1; mip < mipLevelVector.size(); mip++) {
+			const uint8_t* levelTexels = mappedTexels + (size_t)texelOffsetVector[mip] * 4;
+			mipLevelVector[mip].texelVector.assign(levelTexels, levelTexels + (size_t)mipLevelVector[mip].width * mipLevelVector[mip].height * 4);
+		}
+		destroyJobBuffer(mipChainBuffer);
+		return mipLevelVector;
+	});
+}
+
+std::shared_future<std::vector<MeshletStruct>> SenComputeOffloadDevice::computeMeshletBounds(const std::vector<VertexStruct>& vertexStructVector,
+	const std::vector<uint32_t>& meshletIndexVector, std::vector<MeshletStruct> meshletVector)
+{
+	// Positions widened to vec4 for std430, the rest of VertexStruct is of no use here
+	std::shared_ptr<std::vector<glm::vec4>> sharedPositions = std::make_shared<std::vector<glm::vec4>>();
+	sharedPositions->reserve(vertexStructVector.size());
+	for (const auto& vertexStruct : vertexStructVector)
+		sharedPositions->push_back(glm::vec4(vertexStruct.position, 1.0f));
+	std::shared_ptr<std::vector<uint32_t>> sharedIndices = std::make_shared<std::vector<uint32_t>>(meshletIndexVector);
+	std::shared_ptr<std::vector<MeshletStruct>> sharedMeshlets = std::make_shared<std::vector<MeshletStruct>>(std::move(meshletVector));
+
+	return enqueueJob<std::vector<MeshletStruct>>([this, sharedPositions, sharedIndices, sharedMeshlets]() {
+		if (sharedMeshlets->empty() || sharedIndices->empty() || sharedPositions->empty())
+			return std::move(*sharedMeshlets);
+
+		JobBufferStruct positionBuffer	= createJobBuffer(sharedPositions->size() * sizeof(glm::vec4));
+		JobBufferStruct indexBuffer		= createJobBuffer(sharedIndices->size() * sizeof(uint32_t));
+		JobBufferStruct meshletBuffer	= createJobBuffer(sharedMeshlets->size() * sizeof(MeshletStruct));
+		memcpy(positionBuffer.mappedData, sharedPositions->data(), (size_t)positionBuffer.bufferBytes);
+		memcpy(indexBuffer.mappedData, sharedIndices->data(), (size_t)indexBuffer.bufferBytes);
+		memcpy(meshletBuffer.mappedData, sharedMeshlets->data(), (size_t)meshletBuffer.bufferBytes);
+
+		try {
+			runDispatches({ &positionBuffer, &indexBuffer, &meshletBuffer }, [&](const VkCommandBuffer& commandBuffer) {
+				JobPushConstantsStruct pushConstants{};
+				pushConstants.meshletCount = static_cast<uint32_t>(sharedMeshlets->size());
+				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, meshletBoundsPipeline);
+				vkCmdPushConstants(commandBuffer, jobPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(pushConstants), &pushConstants);
+				vkCmdDispatch(commandBuffer, (pushConstants.meshletCount + m_MeshletWorkGroupSize - 1) / m_MeshletWorkGroupSize, 1, 1);
+			});
+		}
+		catch (...) {
+			destroyJobBuffer(positionBuffer);
+			destroyJobBuffer(indexBuffer);
+			destroyJobBuffer(meshletBuffer);
+			throw;
+		}
+
+		memcpy(sharedMeshlets->data(), meshletBuffer.mappedData, (size_t)meshletBuffer.bufferBytes);
+		destroyJobBuffer(positionBuffer);
+		destroyJobBuffer(indexBuffer);
+		destroyJobBuffer(meshletBuffer);
+		return std::move(*sharedMeshlets);
+	});
+}
+
+template <typename JobResultType>
+std::shared_future<JobResultType> SenComputeOffloadDevice::enqueueJob(std::function<JobResultType()> jobFunction)
+{
+	// std::function needs a copyable target, the packaged_task is shared
+	std::shared_ptr<std::packaged_task<JobResultType()>> jobTask = std::make_shared<std::packaged_task<JobResultType()>>(std::move(jobFunction));
+	std::shared_future<JobResultType> jobFuture = jobTask->get_future().share();
+	{
+		std::lock_guard<std::mutex> jobLock(jobMutex);
+		if (jobThreadQuit)
+			throw std::runtime_error("SenComputeOffloadDevice is shutting down, job rejected !!!");
+		jobQueue.push_back([jobTask]() { (*jobTask)(); });
+	}
+	jobConditionVariable.notify_one();
+	return jobFuture;
+}
+
+void SenComputeOffloadDevice::jobThreadLoop()
+{
+	while (true) {
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> jobLock(jobMutex);
+			jobConditionVariable.wait(jobLock, [this] { return jobThreadQuit || !jobQueue.empty(); });
+			if (jobQueue.empty()) return;	// quit, and nothing left to run
+			job = std::move(jobQueue.front());
+			jobQueue.pop_front();
+		}
+		job();	// exceptions end up in the job's future
+		completedJobsCounter++;
+	}
+}
+
+void SenComputeOffloadDevice::createComputePipelines()
+{
+	if (VK_NULL_HANDLE != mipChainPipeline) return;
+
+	const std::vector<std::string> shaderNameVector = { "generateMipChain.comp", "meshletBounds.comp" };
+	std::vector<VkPipeline*> pipelineVector = { &mipChainPipeline, &meshletBoundsPipeline };
+	for (size_t pipelineIndex = 0; pipelineIndex < shaderNameVector.size(); pipelineIndex++) {
+		VkShaderModule compShaderModule = VK_NULL_HANDLE;
+		SLVK_AbstractGLFW::createVulkanShaderModule(m_LogicalDevice, m_ShaderDirectory + shaderNameVector[pipelineIndex], compShaderModule);
+
+		VkComputePipelineCreateInfo computePipelineCreateInfo{};
+		computePipelineCreateInfo.sType			= VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+		computePipelineCreateInfo.stage.sType	= VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		computePipelineCreateInfo.stage.stage	= VK_SHADER_STAGE_COMPUTE_BIT;
+		computePipelineCreateInfo.stage.module	= compShaderModule;
+		computePipelineCreateInfo.stage.pName	= "main";
+		computePipelineCreateInfo.layout		= jobPipelineLayout;
+
+		VkResult result = vkCreateComputePipelines(m_LogicalDevice, VK_NULL_HANDLE, 1, &computePipelineCreateInfo, nullptr, pipelineVector[pipelineIndex]);
+		vkDestroyShaderModule(m_LogicalDevice, compShaderModule, nullptr);
+		SLVK_AbstractGLFW::errorCheck(result, std::string("Failed to create compute offload pipeline " + shaderNameVector[pipelineIndex] + " !!!"));
+	}
+}
+
+SenComputeOffloadDevice::JobBufferStruct SenComputeOffloadDevice::createJobBuffer(const VkDeviceSize& bufferBytes)
+{
+	JobBufferStruct jobBuffer{};
+	jobBuffer.bufferBytes = bufferBytes;
+
+	VkBufferCreateInfo bufferCreateInfo{};
+	bufferCreateInfo.sType			= VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+	bufferCreateInfo.size			= bufferBytes;
+	bufferCreateInfo.usage			= VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+	bufferCreateInfo.sharingMode	= VK_SHARING_MODE_EXCLUSIVE;
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateBuffer(m_LogicalDevice, &bufferCreateInfo, nullptr, &jobBuffer.buffer),
+		std::string("Failed to create compute offload job buffer !!!")
+	);
+
+	// Written once and read back once by the CPU, so plain host visible memory;  cached when available for the readback
+	VkMemoryRequirements memoryRequirements;
+	vkGetBufferMemoryRequirements(m_LogicalDevice, jobBuffer.buffer, &memoryRequirements);
+	VkMemoryAllocateInfo memoryAllocateInfo{};
+	memoryAllocateInfo.sType			= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	memoryAllocateInfo.allocationSize	= memoryRequirements.size;
+	try {
+		memoryAllocateInfo.memoryTypeIndex = SLVK_AbstractGLFW::findPhysicalDeviceMemoryPropertyIndex(m_PhysicalDeviceMemoryProperties, memoryRequirements,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT | VK_MEMORY_PROPERTY_HOST_CACHED_BIT);
+	}
+	catch (const std::runtime_error&) {
+		memoryAllocateInfo.memoryTypeIndex = SLVK_AbstractGLFW::findPhysicalDeviceMemoryPropertyIndex(m_PhysicalDeviceMemoryProperties, memoryRequirements,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	}
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateMemory(m_LogicalDevice, &memoryAllocateInfo, nullptr, &jobBuffer.bufferMemory),
+		std::string("Failed to allocate compute offload job buffer memory !!!")
+	);
+	vkBindBufferMemory(m_LogicalDevice, jobBuffer.buffer, jobBuffer.bufferMemory, 0);
+	vkMapMemory(m_LogicalDevice, jobBuffer.bufferMemory, 0, bufferBytes, 0, &jobBuffer.mappedData);
+	return jobBuffer;
+}
+
+void SenComputeOffloadDevice::destroyJobBuffer(JobBufferStruct& jobBuffer)
+{
+	if (VK_NULL_HANDLE != jobBuffer.buffer) {
+		vkDestroyBuffer(m_LogicalDevice, jobBuffer.buffer, nullptr);
+		jobBuffer.buffer = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != jobBuffer.bufferMemory) {
+		vkUnmapMemory(m_LogicalDevice, jobBuffer.bufferMemory);
+		vkFreeMemory(m_LogicalDevice, jobBuffer.bufferMemory, nullptr);	// this device's heaps are not tracked
+		jobBuffer.bufferMemory = VK_NULL_HANDLE;
+		jobBuffer.mappedData = nullptr;
+	}
+}
+
+void SenComputeOffloadDevice::runDispatches(const std::vector<JobBufferStruct*>& storageBufferVector,
+	const std::function<void(const VkCommandBuffer&)>& recordDispatches)
+{
+	createComputePipelines();
+
+	std::vector<VkDescriptorBufferInfo> descriptorBufferInfoVector(storageBufferVector.size());
+	std::vector<VkWriteDescriptorSet> writeDescriptorSetVector(storageBufferVector.size());
+	for (uint32_t binding = 0; binding < storageBufferVector.size(); binding++) {
+		descriptorBufferInfoVector[binding].buffer	= storageBufferVector[binding]->buffer;
+		descriptorBufferInfoVector[binding].offset	= 0;
+		descriptorBufferInfoVector[binding].range	= VK_WHOLE_SIZE;
+
+		writeDescriptorSetVector[binding].sType				= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSetVector[binding].dstSet			= job_DS;
+		writeDescriptorSetVector[binding].dstBinding		= binding;
+		writeDescriptorSetVector[binding].descriptorType	= VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+		writeDescriptorSetVector[binding].descriptorCount	= 1;
+		writeDescriptorSetVector[binding].pBufferInfo		= &descriptorBufferInfoVector[binding];
+	}
+	// The previous job waited on jobFence, so job_DS is not in use anymore
+	vkUpdateDescriptorSets(m_LogicalDevice, static_cast<uint32_t>(writeDescriptorSetVector.size()), writeDescriptorSetVector.data(), 0, nullptr);
+
+	VkCommandBufferBeginInfo commandBufferBeginInfo{};
+	commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(jobCommandBuffer, &commandBufferBeginInfo);
+	vkCmdBindDescriptorSets(jobCommandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, jobPipelineLayout, 0, 1, &job_DS, 0, nullptr);
+
+	recordDispatches(jobCommandBuffer);
+
+	// Results become visible to the mapped pointers once the fence signaled
+	VkMemoryBarrier hostReadMemoryBarrier{};
+	hostReadMemoryBarrier.sType			= VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+	hostReadMemoryBarrier.srcAccessMask	= VK_ACCESS_SHADER_WRITE_BIT;
+	hostReadMemoryBarrier.dstAccessMask	= VK_ACCESS_HOST_READ_BIT;
+	vkCmdPipelineBarrier(jobCommandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+		0, 1, &hostReadMemoryBarrier, 0, nullptr, 0, nullptr);
+	SLVK_AbstractGLFW::errorCheck(
+		vkEndCommandBuffer(jobCommandBuffer),
+		std::string("Failed to record compute offload commandBuffer !!!")
+	);
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType				= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.commandBufferCount	= 1;
+	submitInfo.pCommandBuffers		= &jobCommandBuffer;
+	SLVK_AbstractGLFW::errorCheck(
+		vkQueueSubmit(m_ComputeQueue, 1, &submitInfo, jobFence),
+		std::string("Failed to submit compute offload job !!!")
+	);
+	vkWaitForFences(m_LogicalDevice, 1, &jobFence, VK_TRUE, UINT64_MAX);
+	vkResetFences(m_LogicalDevice, 1, &jobFence);
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#ifndef __SenComputeOffloadDevice__
+#define __SenComputeOffloadDevice__
+
+#include "SLVK_AbstractGLFW.h"
+#include "SenTinyObjLoader.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <functional>
+#include <atomic>
+
+/*
+	A second logical device, on another GPU than the rendering one (typically the integrated GPU next to a discrete one),
+	running preprocessing compute jobs while the primary device renders.  Nothing is shared between the two devices:
+	a job copies its input into host visible storage buffers of this device, dispatches, waits on its own fence and
+	reads the result back, which the caller then uploads to the rendering device as usual.
+	Jobs run one after the other on the job thread, the only one touching this device's queue;  they are submitted
+	from any thread and return a std::shared_future (get() rethrows a failed job).
+	Allocations are not tracked by SenMemoryTracker, which accounts the rendering device's heaps only.
+*/
+class SenComputeOffloadDevice
+{
+public:
+	struct MipLevelStruct {
+		uint32_t						width					= 0;
+		uint32_t						height					= 0;
+		std::vector<uint8_t>			texelVector;			// RGBA8, tightly packed
+	};
+
+	SenComputeOffloadDevice(const VkPhysicalDevice& physicalDevice, const int32_t& computeQueueFamilyIndex);
+	virtual ~SenComputeOffloadDevice();
+
+	// Level 0 (RGBA8) down to 1x1 with the 2x2 box filter of SenTextureStreamer, odd edges repeat their last row / column;
+	//   level 0 itself is moved into the first element of the result
+	std::shared_future<std::vector<MipLevelStruct>> generateMipChain(std::vector<uint8_t> level0TexelVector,
+		const uint32_t& width, const uint32_t& height);
+	// boundingSphere and normalCone of every meshlet, from its range of meshletIndexVector (see stobjl::buildMeshlets)
+	std::shared_future<std::vector<MeshletStruct>> computeMeshletBounds(const std::vector<VertexStruct>& vertexStructVector,
+		const std::vector<uint32_t>& meshletIndexVector, std::vector<MeshletStruct> meshletVector);
+
+	const char* deviceName() const { return m_PhysicalDeviceProperties.deviceName; }
+	uint64_t completedJobsCount() const { return completedJobsCounter; }
+
+private:
+	// Push constants shared by both pipelines, std430 mirror of the push_constant blocks of the two shaders
+	struct JobPushConstantsStruct {
+		uint32_t						srcOffset				= 0;	// generateMipChain.comp:  in texels
+		uint32_t						srcWidth				= 0;
+		uint32_t						srcHeight				= 0;
+		uint32_t						dstOffset				= 0;
+		uint32_t						dstWidth				= 0;
+		uint32_t						dstHeight				= 0;
+		uint32_t						meshletCount			= 0;	// meshletBounds.comp
+		uint32_t						padding					= 0;
+	};
+	struct JobBufferStruct {
+		VkBuffer						buffer					= VK_NULL_HANDLE;
+		VkDeviceMemory					bufferMemory			= VK_NULL_HANDLE;
+		void*							mappedData				= nullptr;
+		VkDeviceSize					bufferBytes				= 0;
+	};
+
+	template <typename JobResultType>
+	std::shared_future<JobResultType> enqueueJob(std::function<JobResultType()> jobFunction);
+	void jobThreadLoop();
+
+	void createComputePipelines();
+	JobBufferStruct createJobBuffer(const VkDeviceSize& bufferBytes);
+	void destroyJobBuffer(JobBufferStruct& jobBuffer);
+	// Binds the storage buffers (binding 0, 1, 2 in order), records recordDispatches and waits until the device finished
+	void runDispatches(const std::vector<JobBufferStruct*>& storageBufferVector, const std::function<void(const VkCommandBuffer&)>& recordDispatches);
+
+	VkPhysicalDevice					m_PhysicalDevice;
+	VkPhysicalDeviceProperties			m_PhysicalDeviceProperties{};
+	VkPhysicalDeviceMemoryProperties	m_PhysicalDeviceMemoryProperties{};
+	VkDevice							m_LogicalDevice			= VK_NULL_HANDLE;
+	VkQueue								m_ComputeQueue			= VK_NULL_HANDLE;
+	const std::string					m_ShaderDirectory		= "SenVulkanTutorial/Shaders/";
+	const uint32_t						m_MipWorkGroupSize		= 8;	// local_size_x/y in generateMipChain.comp
+	const uint32_t						m_MeshletWorkGroupSize	= 64;	// local_size_x in meshletBounds.comp
+
+	VkCommandPool						jobCommandPool			= VK_NULL_HANDLE;
+	VkCommandBuffer						jobCommandBuffer		= VK_NULL_HANDLE;
+	VkFence								jobFence				= VK_NULL_HANDLE;
+	VkDescriptorSetLayout				job_DSL					= VK_NULL_HANDLE;
+	VkDescriptorPool					jobDescriptorPool		= VK_NULL_HANDLE;
+	VkDescriptorSet						job_DS					= VK_NULL_HANDLE;
+	VkPipelineLayout					jobPipelineLayout		= VK_NULL_HANDLE;
+	VkPipeline							mipChainPipeline		= VK_NULL_HANDLE;	// created by the first job, on the job thread
+	VkPipeline							meshletBoundsPipeline	= VK_NULL_HANDLE;
+
+	std::thread							jobThread;
+	std::mutex							jobMutex;				// guards jobQueue and jobThreadQuit
+	std::condition_variable				jobConditionVariable;
+	bool								jobThreadQuit			= false;
+	std::deque<std::function<void()>>	jobQueue;
+	std::atomic<uint64_t>				completedJobsCounter{ 0 };
+};
+
+#endif // !__SenComputeOffloadDevice__
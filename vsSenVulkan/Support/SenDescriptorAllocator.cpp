@@ -0,0 +1,254 @@
+#include "SenDescriptorAllocator.h"
+
+#include <algorithm>
+
+SenDescriptorAllocator::SenDescriptorAllocator(const VkDevice& logicalDevice, const uint32_t& framesCount, const uint32_t& setsPerPool)
+	: m_LogicalDevice(logicalDevice), m_FramesCount(framesCount), m_SetsPerPool((std::max)(setsPerPool, 1u))
+{
+	framePoolsVector.resize(m_FramesCount + 1);
+}
+
+SenDescriptorAllocator::~SenDescriptorAllocator()
+{
+	for (auto& framePools : framePoolsVector) {
+		// All sets allocated from a pool are implicitly freed with it
+		for (auto& descriptorPool : framePools.poolVector)
+			vkDestroyDescriptorPool(m_LogicalDevice, descriptorPool, nullptr);
+		framePools.poolVector.clear();
+		framePools.setCache.clear();
+	}
+	for (auto& cachedLayout : layoutCache)
+		vkDestroyDescriptorSetLayout(m_LogicalDevice, cachedLayout.second, nullptr);
+	layoutCache.clear();
+
+	OutputDebugString("\n\t ~SenDescriptorAllocator()\n");
+}
+
+size_t SenDescriptorAllocator::KeyHasher::operator()(const std::vector<uint64_t>& key) const
+{
+	// FNV-1a over the words
+	uint64_t hash = 14695981039346656037ull;
+	for (const auto& word : key) {
+		hash ^= word;
+		hash *= 1099511628211ull;
+	}
+	return (size_t)hash;
+}
+
+VkDescriptorSetLayout SenDescriptorAllocator::getDescriptorSetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindingVector)
+{
+	/************************************************************************************************************/
+	/*********     Signature:  bindings sorted by binding number, immutable samplers included     ***************/
+	/************************************************************************************************************/
+	std::vector<VkDescriptorSetLayoutBinding> sortedBindingVector(bindingVector);
+	std::sort(sortedBindingVector.begin(), sortedBindingVector.end(),
+		[](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) { return a.binding < b.binding; });
+
+	std::vector<uint64_t> signature;
+	for (const auto& binding : sortedBindingVector) {
+		signature.push_back(((uint64_t)binding.binding << 32) | (uint64_t)binding.descriptorType);
+		signature.push_back(((uint64_t)binding.descriptorCount << 32) | (uint64_t)binding.stageFlags);
+		if (nullptr != binding.pImmutableSamplers) {
+			for (uint32_t i = 0; i < binding.descriptorCount; i++)
+				signature.push_back((uint64_t)binding.pImmutableSamplers[i]);
+		}
+	}
+
+	auto cachedLayout = layoutCache.find(signature);
+	if (layoutCache.end() != cachedLayout)
+		return cachedLayout->second;
+
+	VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+	layoutCreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+	layoutCreateInfo.bindingCount	= (uint32_t)sortedBindingVector.size();
+	layoutCreateInfo.pBindings		= sortedBindingVector.data();
+
+	VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorSetLayout(m_LogicalDevice, &layoutCreateInfo, nullptr, &layout),
+		std::string("Fail to Create cached DescriptorSetLayout !")
+	);
+	layoutCache[signature] = layout;
+	return layout;
+}
+
+void SenDescriptorAllocator::resizeFrames(const uint32_t& framesCount)
+{
+	FramePoolsStruct persistentPools = std::move(framePoolsVector.back());
+	framePoolsVector.pop_back();
+	for (uint32_t frameIndex = 0; frameIndex < m_FramesCount; frameIndex++) {
+		if (frameIndex < framesCount) {
+			beginFrame(frameIndex);
+		}
+		else {
+			for (auto& descriptorPool : framePoolsVector[frameIndex].poolVector)
+				vkDestroyDescriptorPool(m_LogicalDevice, descriptorPool, nullptr);
+		}
+	}
+	m_FramesCount = framesCount;
+	framePoolsVector.resize(m_FramesCount);
+	framePoolsVector.push_back(std::move(persistentPools));
+}
+
+void SenDescriptorAllocator::beginFrame(const uint32_t& frameIndex)
+{
+	if (frameIndex >= m_FramesCount)
+		throw std::runtime_error("SenDescriptorAllocator::beginFrame() out of range, the persistent slot is never reset !");
+
+	FramePoolsStruct& framePools = framePoolsVector[frameIndex];
+	for (auto& descriptorPool : framePools.poolVector)
+		vkResetDescriptorPool(m_LogicalDevice, descriptorPool, 0);
+	framePools.activePoolIndex = 0;
+	framePools.setCache.clear();
+}
+
+VkDescriptorPool SenDescriptorAllocator::createDescriptorPool(const uint32_t& maxSets)
+{
+	// Descriptors per set for each type, a guess that fits material and per-frame sets;  a pool that runs out is simply skipped.
+	//   Every type a layout can hold has to be listed, a type missing here makes every new pool fail the same way
+	static const std::vector<std::pair<VkDescriptorType, float>> descriptorsPerSetVector = {
+		{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,			2.0f },
+		{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,	1.0f },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,			2.0f },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC,	0.5f },
+		{ VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER,		0.25f },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER,		0.25f },
+		{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,	4.0f },
+		{ VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,				1.0f },
+		{ VK_DESCRIPTOR_TYPE_SAMPLER,					0.5f },
+		{ VK_DESCRIPTOR_TYPE_STORAGE_IMAGE,				0.5f },
+		{ VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT,			0.5f }
+	};
+	std::vector<VkDescriptorPoolSize> descriptorPoolSizeVector;
+	for (const auto& descriptorsPerSet : descriptorsPerSetVector) {
+		VkDescriptorPoolSize descriptorPoolSize{};
+		descriptorPoolSize.type				= descriptorsPerSet.first;
+		descriptorPoolSize.descriptorCount	= (std::max)(1u, (uint32_t)(descriptorsPerSet.second * maxSets));
+		descriptorPoolSizeVector.push_back(descriptorPoolSize);
+	}
+
+	VkDescriptorPoolCreateInfo descriptorPoolCreateInfo{};
+	descriptorPoolCreateInfo.sType			= VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+	descriptorPoolCreateInfo.flags			= 0;	// no FREE_DESCRIPTOR_SET_BIT:  sets are only ever released by a pool reset
+	descriptorPoolCreateInfo.maxSets		= maxSets;
+	descriptorPoolCreateInfo.poolSizeCount	= (uint32_t)descriptorPoolSizeVector.size();
+	descriptorPoolCreateInfo.pPoolSizes		= descriptorPoolSizeVector.data();
+
+	VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateDescriptorPool(m_LogicalDevice, &descriptorPoolCreateInfo, nullptr, &descriptorPool),
+		std::string("Fail to Create growable descriptorPool !")
+	);
+	return descriptorPool;
+}
+
+VkDescriptorSet SenDescriptorAllocator::allocateDescriptorSet(const uint32_t& frameIndex, const VkDescriptorSetLayout& layout)
+{
+	FramePoolsStruct& framePools = framePoolsVector.at(frameIndex);
+
+	VkDescriptorSetAllocateInfo descriptorSetAllocateInfo{};
+	descriptorSetAllocateInfo.sType					= VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+	descriptorSetAllocateInfo.descriptorSetCount	= 1;
+	descriptorSetAllocateInfo.pSetLayouts			= &layout;
+
+	VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+	while (true) {
+		bool poolIsEmpty = false;
+		/************************************************************************************************************/
+		/*********     Grow:  every new pool of this frame slot holds twice the sets of the previous one     ********/
+		/************************************************************************************************************/
+		if (framePools.activePoolIndex == framePools.poolVector.size()) {
+			uint32_t maxSets = m_SetsPerPool;
+			for (size_t i = 0; i < framePools.poolVector.size() && maxSets < m_MaxSetsPerPool; i++)
+				maxSets *= 2;
+			framePools.poolVector.push_back(createDescriptorPool((std::min)(maxSets, m_MaxSetsPerPool)));
+			poolIsEmpty = true;
+		}
+
+		descriptorSetAllocateInfo.descriptorPool = framePools.poolVector[framePools.activePoolIndex];
+		VkResult result = vkAllocateDescriptorSets(m_LogicalDevice, &descriptorSetAllocateInfo, &descriptorSet);
+		if (VK_SUCCESS == result)
+			break;
+		if (VK_ERROR_OUT_OF_POOL_MEMORY_KHR != result && VK_ERROR_FRAGMENTED_POOL != result)
+			SLVK_AbstractGLFW::errorCheck(result, std::string("Fail to Allocate descriptorSet from growable pool !"));
+
+		// This pool is full for the rest of the frame, move on to the next one
+		if (poolIsEmpty)
+			throw std::runtime_error("SenDescriptorAllocator: a single descriptorSet does not fit into an empty pool !");
+		framePools.activePoolIndex++;
+	}
+	setsAllocatedCount++;
+	return descriptorSet;
+}
+
+VkDescriptorSet SenDescriptorAllocator::getDescriptorSet(const uint32_t& frameIndex, const VkDescriptorSetLayout& layout,
+	const std::vector<DescriptorWriteStruct>& writeVector)
+{
+	/************************************************************************************************************/
+	/*********     Key:  layout + every write, in (binding, arrayElement) order     *****************************/
+	/************************************************************************************************************/
+	std::vector<DescriptorWriteStruct> sortedWriteVector(writeVector);
+	std::sort(sortedWriteVector.begin(), sortedWriteVector.end(), [](const DescriptorWriteStruct& a, const DescriptorWriteStruct& b) {
+		return a.binding < b.binding || (a.binding == b.binding && a.arrayElement < b.arrayElement); });
+
+	std::vector<uint64_t> key;
+	key.push_back((uint64_t)layout);
+	for (const auto& write : sortedWriteVector) {
+		key.push_back(((uint64_t)write.binding << 32) | (uint64_t)write.arrayElement);
+		key.push_back((uint64_t)write.descriptorType);
+		key.push_back((uint64_t)write.bufferInfo.buffer);
+		key.push_back((uint64_t)write.bufferInfo.offset);
+		key.push_back((uint64_t)write.bufferInfo.range);
+		key.push_back((uint64_t)write.imageInfo.sampler);
+		key.push_back((uint64_t)write.imageInfo.imageView);
+		key.push_back((uint64_t)write.imageInfo.imageLayout);
+		key.push_back((uint64_t)write.texelBufferView);
+	}
+
+	FramePoolsStruct& framePools = framePoolsVector.at(frameIndex);
+	auto cachedSet = framePools.setCache.find(key);
+	if (framePools.setCache.end() != cachedSet) {
+		setsReusedCount++;
+		return cachedSet->second;
+	}
+
+	VkDescriptorSet descriptorSet = allocateDescriptorSet(frameIndex, layout);
+
+	std::vector<VkWriteDescriptorSet> DS_Write_Vector(sortedWriteVector.size());
+	for (size_t i = 0; i < sortedWriteVector.size(); i++) {
+		const DescriptorWriteStruct& write = sortedWriteVector[i];
+		DS_Write_Vector[i].sType			= VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		DS_Write_Vector[i].dstSet			= descriptorSet;
+		DS_Write_Vector[i].dstBinding		= write.binding;
+		DS_Write_Vector[i].dstArrayElement	= write.arrayElement;
+		DS_Write_Vector[i].descriptorCount	= 1;
+		DS_Write_Vector[i].descriptorType	= write.descriptorType;
+		switch (write.descriptorType) {
+		case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:
+		case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC:
+		case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+		case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC:
+			DS_Write_Vector[i].pBufferInfo	= &write.bufferInfo;
+			break;
+		case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:
+		case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+			DS_Write_Vector[i].pTexelBufferView	= &write.texelBufferView;
+			break;
+		default:
+			DS_Write_Vector[i].pImageInfo	= &write.imageInfo;
+			break;
+		}
+	}
+	vkUpdateDescriptorSets(m_LogicalDevice, (uint32_t)DS_Write_Vector.size(), DS_Write_Vector.data(), 0, nullptr);
+
+	framePools.setCache[key] = descriptorSet;
+	return descriptorSet;
+}
+
+uint32_t SenDescriptorAllocator::poolsCount() const
+{
+	uint32_t count = 0;
+	for (const auto& framePools : framePoolsVector)
+		count += (uint32_t)framePools.poolVector.size();
+	return count;
+}
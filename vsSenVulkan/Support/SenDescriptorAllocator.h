@@ -0,0 +1,78 @@
+#pragma once
+
+#ifndef __SenDescriptorAllocator__
+#define __SenDescriptorAllocator__
+
+#include "SLVK_AbstractGLFW.h"
+
+#include <unordered_map>
+
+/*
+	Descriptor subsystem:  VkDescriptorSetLayouts are cached by their binding signature and live until the allocator dies.
+	Sets come from growable pools owned by a frame slot;  beginFrame() resets every pool of that slot in bulk
+	(vkResetDescriptorPool), sets are never freed one at a time.  Within a frame slot, a set requested twice with the
+	same layout and the same writes is allocated and written only once.
+	Slot framesCount is persistent:  its pools are never reset, for sets that live as long as the application.
+*/
+class SenDescriptorAllocator
+{
+public:
+	// One resource bound to one array element of one binding;  bufferInfo, imageInfo or texelBufferView is used depending on descriptorType
+	struct DescriptorWriteStruct {
+		uint32_t						binding					= 0;
+		uint32_t						arrayElement			= 0;
+		VkDescriptorType				descriptorType			= VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		VkDescriptorBufferInfo			bufferInfo				= {};
+		VkDescriptorImageInfo			imageInfo				= {};
+		VkBufferView					texelBufferView			= VK_NULL_HANDLE;	// UNIFORM_TEXEL_BUFFER, STORAGE_TEXEL_BUFFER
+	};
+
+	SenDescriptorAllocator(const VkDevice& logicalDevice, const uint32_t& framesCount, const uint32_t& setsPerPool = 64);
+	virtual ~SenDescriptorAllocator();
+
+	VkDescriptorSetLayout getDescriptorSetLayout(const std::vector<VkDescriptorSetLayoutBinding>& bindingVector);
+
+	// Device idle only:  per-frame slots are reset and their count changed, the persistent slot and the layouts survive
+	void resizeFrames(const uint32_t& framesCount);
+	// The GPU must be done with every set of frameIndex (its fence signaled) before it is begun again
+	void beginFrame(const uint32_t& frameIndex);
+	VkDescriptorSet allocateDescriptorSet(const uint32_t& frameIndex, const VkDescriptorSetLayout& layout);
+	// Allocate-and-write, or return the set already written with identical writes during this frame slot
+	VkDescriptorSet getDescriptorSet(const uint32_t& frameIndex, const VkDescriptorSetLayout& layout,
+		const std::vector<DescriptorWriteStruct>& writeVector);
+
+	uint32_t persistentFrameIndex() const { return m_FramesCount; }
+	uint32_t framesCount() const { return m_FramesCount; }
+	size_t layoutsCount() const { return layoutCache.size(); }
+	uint64_t allocatedSetsCount() const { return setsAllocatedCount; }
+	uint64_t reusedSetsCount() const { return setsReusedCount; }
+	uint32_t poolsCount() const;
+
+private:
+	// Keys are flattened into 64 bit words, compared in full so that a hash collision never returns a wrong object
+	struct KeyHasher {
+		size_t operator()(const std::vector<uint64_t>& key) const;
+	};
+	typedef std::unordered_map<std::vector<uint64_t>, VkDescriptorSetLayout, KeyHasher>	LayoutCacheMap;
+	typedef std::unordered_map<std::vector<uint64_t>, VkDescriptorSet, KeyHasher>		SetCacheMap;
+
+	struct FramePoolsStruct {
+		std::vector<VkDescriptorPool>	poolVector;
+		uint32_t						activePoolIndex			= 0;	// pools before it are full until the next beginFrame()
+		SetCacheMap						setCache;
+	};
+
+	VkDescriptorPool createDescriptorPool(const uint32_t& maxSets);
+
+	VkDevice							m_LogicalDevice;
+	uint32_t							m_FramesCount;
+	const uint32_t						m_SetsPerPool;
+	const uint32_t						m_MaxSetsPerPool		= 4096;
+
+	LayoutCacheMap						layoutCache;
+	std::vector<FramePoolsStruct>		framePoolsVector;		// m_FramesCount + 1, the last one is persistent
+	uint64_t							setsAllocatedCount		= 0;
+	uint64_t							setsReusedCount			= 0;
+};
+
+#endif // !__SenDescriptorAllocator__
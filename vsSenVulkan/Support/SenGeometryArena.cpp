@@ -0,0 +1,108 @@
+#include "SenGeometryArena.h"
+
+#include <iterator>
+
+SenGeometryArena::SenGeometryArena(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+	const VkDeviceSize& arenaBytes)
+	: m_LogicalDevice(logicalDevice), m_ArenaBytes(arenaBytes)
+{
+	SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, m_ArenaBytes,
+		VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+		VK_SHARING_MODE_EXCLUSIVE, gpuMemoryProperties, arenaBuffer, arenaBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	freeRangeMap[0] = m_ArenaBytes;
+
+	std::ostringstream stream;
+	stream << "\t SenGeometryArena:  " << m_ArenaBytes / (1024 * 1024) << " MB for the vertices and indices of every mesh\n";
+	std::cout << stream.str();
+}
+
+SenGeometryArena::~SenGeometryArena()
+{
+	if (VK_NULL_HANDLE != arenaBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, arenaBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, arenaBufferMemory);	// always try to destroy before free
+
+		arenaBuffer			= VK_NULL_HANDLE;
+		arenaBufferMemory	= VK_NULL_HANDLE;
+	}
+
+	OutputDebugString("\n\t ~SenGeometryArena()\n");
+}
+
+SenGeometryArena::AllocationStruct SenGeometryArena::allocate(const uint32_t& elementsCount, const uint32_t& elementStride)
+{
+	if (0 == elementStride || 0 != elementStride % 4)
+		throw std::runtime_error("Geometry arena element stride has to be a non-zero multiple of 4 !!!");
+
+	AllocationStruct allocation{};
+	allocation.elementStride	= elementStride;
+	allocation.elementsCount	= elementsCount;
+	allocation.byteSize			= (VkDeviceSize)elementsCount * elementStride;
+	if (0 == allocation.byteSize) return allocation;
+
+	std::lock_guard<std::mutex> freeRangeLock(freeRangeMutex);
+
+	/****************************************************************************************************************************/
+	/**********   First fit:  the range has to hold the elements after rounding its start up to a whole element   **************/
+	/****************************************************************************************************************************/
+	for (auto freeRange = freeRangeMap.begin(); freeRange != freeRangeMap.end(); ++freeRange) {
+		const VkDeviceSize rangeOffset	= freeRange->first;
+		const VkDeviceSize rangeSize	= freeRange->second;
+		const VkDeviceSize alignedOffset = (rangeOffset + elementStride - 1) / elementStride * elementStride;
+		if (alignedOffset + allocation.byteSize > rangeOffset + rangeSize) continue;
+
+		// Give back what is left in front of and behind the allocation
+		freeRangeMap.erase(freeRange);
+		if (alignedOffset > rangeOffset)
+			freeRangeMap[rangeOffset] = alignedOffset - rangeOffset;
+		const VkDeviceSize allocationEnd = alignedOffset + allocation.byteSize;
+		if (allocationEnd < rangeOffset + rangeSize)
+			freeRangeMap[allocationEnd] = rangeOffset + rangeSize - allocationEnd;
+
+		allocation.byteOffset	= alignedOffset;
+		allocatedBytes			+= allocation.byteSize;
+		return allocation;
+	}
+
+	std::ostringstream stream;
+	stream << "Geometry arena out of memory:  " << allocation.byteSize / 1024 << " KB requested, "
+		<< (m_ArenaBytes - allocatedBytes) / 1024 << " KB free in " << freeRangeMap.size() << " ranges !!!";
+	throw std::runtime_error(stream.str());
+}
+
+void SenGeometryArena::free(AllocationStruct& allocation)
+{
+	if (0 == allocation.byteSize) return;
+
+	std::lock_guard<std::mutex> freeRangeLock(freeRangeMutex);
+	VkDeviceSize rangeOffset	= allocation.byteOffset;
+	VkDeviceSize rangeSize		= allocation.byteSize;
+
+	/****************************************************************************************************************************/
+	/**********   Merge with the free neighbours, so the map never holds two adjacent ranges   **********************************/
+	/****************************************************************************************************************************/
+	auto nextRange = freeRangeMap.lower_bound(rangeOffset);
+	if (nextRange != freeRangeMap.end() && nextRange->first == rangeOffset + rangeSize) {
+		rangeSize += nextRange->second;
+		nextRange = freeRangeMap.erase(nextRange);
+	}
+	if (nextRange != freeRangeMap.begin()) {
+		auto previousRange = std::prev(nextRange);
+		if (previousRange->first + previousRange->second == rangeOffset) {
+			rangeOffset	= previousRange->first;
+			rangeSize	+= previousRange->second;
+			freeRangeMap.erase(previousRange);
+		}
+	}
+	freeRangeMap[rangeOffset] = rangeSize;
+
+	allocatedBytes	-= allocation.byteSize;
+	allocation		= AllocationStruct();
+}
+
+VkDeviceSize SenGeometryArena::usedBytes()
+{
+	std::lock_guard<std::mutex> freeRangeLock(freeRangeMutex);
+	return allocatedBytes;
+}
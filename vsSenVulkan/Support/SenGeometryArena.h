@@ -0,0 +1,57 @@
+#pragma once
+
+#ifndef __SenGeometryArena__
+#define __SenGeometryArena__
+
+#include "SLVK_AbstractGLFW.h"
+
+#include <map>
+#include <mutex>
+
+/*
+	One device local buffer holding the vertices and indices of every mesh, sub-allocated per mesh instead of a
+	VkBuffer + VkDeviceMemory pair each.  It is usable as index buffer and as storage buffer:  vertex shaders fetch their
+	vertices from it with gl_VertexIndex (vertex pulling, no fixed-function vertex input), so all meshes draw from one
+	descriptor and one index buffer binding, and only the draw's firstIndex / vertexOffset tell them apart.
+	Ranges are aligned to their element stride, so byteOffset / stride is the firstIndex or vertexOffset to draw with;
+	freed ranges merge with their free neighbours and are reused first fit.
+	allocate() and free() are thread safe (the streaming loader thread allocates), uploads go through the caller's
+	staging path;  a range has to be freed only once no commandBuffer in flight reads it anymore.
+*/
+class SenGeometryArena
+{
+public:
+	struct AllocationStruct {
+		VkDeviceSize					byteOffset				= 0;
+		VkDeviceSize					byteSize				= 0;	// 0: nothing allocated
+		uint32_t						elementStride			= 0;
+		uint32_t						elementsCount			= 0;
+
+		// firstIndex for indices, vertexOffset for vertices
+		uint32_t firstElement() const { return 0 == elementStride ? 0 : static_cast<uint32_t>(byteOffset / elementStride); }
+	};
+
+	SenGeometryArena(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties, const VkDeviceSize& arenaBytes);
+	virtual ~SenGeometryArena();
+
+	// elementStride has to be a multiple of 4 (shaders read the arena as floats / uints);  throws when no free range fits
+	AllocationStruct allocate(const uint32_t& elementsCount, const uint32_t& elementStride);
+	void free(AllocationStruct& allocation);
+
+	VkBuffer buffer() const { return arenaBuffer; }
+	VkDeviceSize capacity() const { return m_ArenaBytes; }
+	VkDeviceSize usedBytes();
+
+private:
+	VkDevice							m_LogicalDevice;
+	const VkDeviceSize					m_ArenaBytes;
+
+	VkBuffer							arenaBuffer				= VK_NULL_HANDLE;
+	VkDeviceMemory						arenaBufferMemory		= VK_NULL_HANDLE;
+
+	std::mutex							freeRangeMutex;			// guards freeRangeMap, allocatedBytes
+	std::map<VkDeviceSize, VkDeviceSize>	freeRangeMap;		// byteOffset -> byteSize, never two adjacent ranges
+	VkDeviceSize						allocatedBytes			= 0;
+};
+
+#endif // !__SenGeometryArena__
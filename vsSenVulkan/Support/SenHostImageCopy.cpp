@@ -0,0 +1,135 @@
+#include "SenHostImageCopy.h"
+#include "SenStagingRing.h"
+
+SenHostImageCopy::SenHostImageCopy(const VkInstance& instance, const VkPhysicalDevice& physicalDevice, const VkDevice& logicalDevice)
+	: m_PhysicalDevice(physicalDevice), m_LogicalDevice(logicalDevice)
+{
+#if defined( VK_EXT_host_image_copy )
+	fetch_vkGetPhysicalDeviceImageFormatProperties2KHR	= vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceImageFormatProperties2KHR");
+	fetch_vkTransitionImageLayoutEXT					= vkGetDeviceProcAddr(m_LogicalDevice, "vkTransitionImageLayoutEXT");
+	fetch_vkCopyMemoryToImageEXT						= vkGetDeviceProcAddr(m_LogicalDevice, "vkCopyMemoryToImageEXT");
+
+	/****************************************************************************************************************************/
+	/**********   Layouts the host may copy into:  count first, then the list   *************************************************/
+	/****************************************************************************************************************************/
+	PFN_vkGetPhysicalDeviceProperties2KHR fetch_vkGetPhysicalDeviceProperties2KHR =
+		reinterpret_cast<PFN_vkGetPhysicalDeviceProperties2KHR>(vkGetInstanceProcAddr(instance, "vkGetPhysicalDeviceProperties2KHR"));
+	if (nullptr != fetch_vkGetPhysicalDeviceProperties2KHR) {
+		VkPhysicalDeviceHostImageCopyPropertiesEXT hostImageCopyProperties{};
+		hostImageCopyProperties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_HOST_IMAGE_COPY_PROPERTIES_EXT;
+		VkPhysicalDeviceProperties2KHR physicalDeviceProperties2{};
+		physicalDeviceProperties2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2_KHR;
+		physicalDeviceProperties2.pNext = &hostImageCopyProperties;
+		fetch_vkGetPhysicalDeviceProperties2KHR(m_PhysicalDevice, &physicalDeviceProperties2);
+
+		std::vector<VkImageLayout> copyDstLayoutVector(hostImageCopyProperties.copyDstLayoutCount);
+		hostImageCopyProperties.copySrcLayoutCount	= 0;
+		hostImageCopyProperties.pCopyDstLayouts		= copyDstLayoutVector.data();
+		fetch_vkGetPhysicalDeviceProperties2KHR(m_PhysicalDevice, &physicalDeviceProperties2);
+		for (const auto& copyDstLayout : copyDstLayoutVector)
+			shaderReadOnlyCopyDst |= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL == copyDstLayout;
+	}
+#else
+	(void)instance;		// headers older than the extension, supportsImage() stays false
+#endif
+
+	std::ostringstream stream;
+	stream << "\t SenHostImageCopy:  VK_EXT_host_image_copy enabled, "
+		<< (shaderReadOnlyCopyDst ? "textures are written straight into SHADER_READ_ONLY_OPTIMAL\n"
+			: "but SHADER_READ_ONLY_OPTIMAL is no host copy layout, textures keep going through the staging ring\n");
+	std::cout << stream.str();
+}
+
+SenHostImageCopy::~SenHostImageCopy()
+{
+	OutputDebugString("\n\t ~SenHostImageCopy()\n");
+}
+
+bool SenHostImageCopy::supportsImage(const VkFormat& imageFormat, const VkImageType& imageType, const VkImageUsageFlags& imageUsageFlags) const
+{
+#if defined( VK_EXT_host_image_copy )
+	if (!shaderReadOnlyCopyDst || nullptr == fetch_vkGetPhysicalDeviceImageFormatProperties2KHR
+		|| nullptr == fetch_vkTransitionImageLayoutEXT || nullptr == fetch_vkCopyMemoryToImageEXT)
+		return false;
+
+	VkPhysicalDeviceImageFormatInfo2KHR imageFormatInfo{};
+	imageFormatInfo.sType	= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_IMAGE_FORMAT_INFO_2_KHR;
+	imageFormatInfo.format	= imageFormat;
+	imageFormatInfo.type	= imageType;
+	imageFormatInfo.tiling	= VK_IMAGE_TILING_OPTIMAL;
+	imageFormatInfo.usage	= hostTransferUsage(imageUsageFlags);
+
+	// optimalDeviceAccess false:  HOST_TRANSFER usage would change the image's memory layout and slow down sampling
+	VkHostImageCopyDevicePerformanceQueryEXT devicePerformanceQuery{};
+	devicePerformanceQuery.sType = VK_STRUCTURE_TYPE_HOST_IMAGE_COPY_DEVICE_PERFORMANCE_QUERY_EXT;
+	VkImageFormatProperties2KHR imageFormatProperties{};
+	imageFormatProperties.sType = VK_STRUCTURE_TYPE_IMAGE_FORMAT_PROPERTIES_2_KHR;
+	imageFormatProperties.pNext = &devicePerformanceQuery;
+
+	VkResult result = reinterpret_cast<PFN_vkGetPhysicalDeviceImageFormatProperties2KHR>(fetch_vkGetPhysicalDeviceImageFormatProperties2KHR)(
+		m_PhysicalDevice, &imageFormatInfo, &imageFormatProperties);
+	return VK_SUCCESS == result && VK_TRUE == devicePerformanceQuery.optimalDeviceAccess;
+#else
+	(void)imageFormat; (void)imageType; (void)imageUsageFlags;
+	return false;
+#endif
+}
+
+VkImageUsageFlags SenHostImageCopy::hostTransferUsage(const VkImageUsageFlags& imageUsageFlags) const
+{
+#if defined( VK_EXT_host_image_copy )
+	return imageUsageFlags | VK_IMAGE_USAGE_HOST_TRANSFER_BIT_EXT;
+#else
+	return imageUsageFlags;
+#endif
+}
+
+void SenHostImageCopy::uploadToImage(const void* srcData, const VkImage& dstImage, const VkFormat& imageFormat, const VkBufferImageCopy& imageRegion)
+{
+#if defined( VK_EXT_host_image_copy )
+	VkHostImageLayoutTransitionInfoEXT layoutTransitionInfo{};
+	layoutTransitionInfo.sType								= VK_STRUCTURE_TYPE_HOST_IMAGE_LAYOUT_TRANSITION_INFO_EXT;
+	layoutTransitionInfo.image								= dstImage;
+	layoutTransitionInfo.oldLayout							= VK_IMAGE_LAYOUT_UNDEFINED;	// whole subresources are overwritten
+	layoutTransitionInfo.newLayout							= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	layoutTransitionInfo.subresourceRange.aspectMask		= imageRegion.imageSubresource.aspectMask;
+	layoutTransitionInfo.subresourceRange.baseMipLevel		= imageRegion.imageSubresource.mipLevel;
+	layoutTransitionInfo.subresourceRange.levelCount		= 1;
+	layoutTransitionInfo.subresourceRange.baseArrayLayer	= imageRegion.imageSubresource.baseArrayLayer;
+	layoutTransitionInfo.subresourceRange.layerCount		= imageRegion.imageSubresource.layerCount;
+	SLVK_AbstractGLFW::errorCheck(
+		reinterpret_cast<PFN_vkTransitionImageLayoutEXT>(fetch_vkTransitionImageLayoutEXT)(m_LogicalDevice, 1, &layoutTransitionInfo),
+		std::string("Failed to transition image layout on the host !!!")
+	);
+
+	VkMemoryToImageCopyEXT memoryToImageCopy{};
+	memoryToImageCopy.sType					= VK_STRUCTURE_TYPE_MEMORY_TO_IMAGE_COPY_EXT;
+	memoryToImageCopy.pHostPointer			= srcData;
+	memoryToImageCopy.memoryRowLength		= 0;	// tightly packed, like the staging ring's source
+	memoryToImageCopy.memoryImageHeight		= 0;
+	memoryToImageCopy.imageSubresource		= imageRegion.imageSubresource;
+	memoryToImageCopy.imageOffset			= imageRegion.imageOffset;
+	memoryToImageCopy.imageExtent			= imageRegion.imageExtent;
+
+	VkCopyMemoryToImageInfoEXT copyMemoryToImageInfo{};
+	copyMemoryToImageInfo.sType				= VK_STRUCTURE_TYPE_COPY_MEMORY_TO_IMAGE_INFO_EXT;
+	copyMemoryToImageInfo.dstImage			= dstImage;
+	copyMemoryToImageInfo.dstImageLayout	= VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	copyMemoryToImageInfo.regionCount		= 1;
+	copyMemoryToImageInfo.pRegions			= &memoryToImageCopy;
+	SLVK_AbstractGLFW::errorCheck(
+		reinterpret_cast<PFN_vkCopyMemoryToImageEXT>(fetch_vkCopyMemoryToImageEXT)(m_LogicalDevice, &copyMemoryToImageInfo),
+		std::string("Failed to copy memory to image on the host !!!")
+	);
+
+	uint32_t blockBytes = 4, blockExtent = 1;
+	SenStagingRing::texelBlockSize(imageFormat, blockBytes, blockExtent);
+	hostCopiesCount++;
+	totalUploadedBytes += static_cast<VkDeviceSize>((imageRegion.imageExtent.width + blockExtent - 1) / blockExtent)
+		* ((imageRegion.imageExtent.height + blockExtent - 1) / blockExtent) * blockBytes
+		* imageRegion.imageExtent.depth * imageRegion.imageSubresource.layerCount;
+#else
+	(void)srcData; (void)dstImage; (void)imageFormat; (void)imageRegion;
+	throw std::runtime_error("VK_EXT_host_image_copy is not in these Vulkan headers !!!");
+#endif
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#ifndef __SenHostImageCopy__
+#define __SenHostImageCopy__
+
+#include "SLVK_AbstractGLFW.h"
+
+/*
+	Texture uploads through VK_EXT_host_image_copy:  the CPU writes the pixels straight into an optimal tiled image
+	(vkCopyMemoryToImageEXT), with no staging allocation, no copy command and no GPU transfer.  The layout transition
+	is done on the host as well, right into SHADER_READ_ONLY_OPTIMAL, so the image is ready to sample on return.
+	Only created when the device enabled the extension and its hostImageCopy feature;  supportsImage() is false for
+	formats the driver can not host copy, or would sample slower when created with HOST_TRANSFER usage, and when
+	SHADER_READ_ONLY_OPTIMAL is no host copy destination layout.  The caller then takes the staging ring path.
+	The image must not be in use by the GPU while it is written;  host writes are visible to later submissions.
+*/
+class SenHostImageCopy
+{
+public:
+	SenHostImageCopy(const VkInstance& instance, const VkPhysicalDevice& physicalDevice, const VkDevice& logicalDevice);
+	virtual ~SenHostImageCopy();
+
+	bool supportsImage(const VkFormat& imageFormat, const VkImageType& imageType, const VkImageUsageFlags& imageUsageFlags) const;
+	// imageUsageFlags plus HOST_TRANSFER, to create the image with
+	VkImageUsageFlags hostTransferUsage(const VkImageUsageFlags& imageUsageFlags) const;
+
+	// Same arguments as SenStagingRing::uploadToImage();  imageRegion has to cover whole subresources, their previous
+	//   content is discarded.  They end up in SHADER_READ_ONLY_OPTIMAL
+	void uploadToImage(const void* srcData, const VkImage& dstImage, const VkFormat& imageFormat, const VkBufferImageCopy& imageRegion);
+
+	uint64_t copiesCount() const { return hostCopiesCount; }
+	VkDeviceSize uploadedBytes() const { return totalUploadedBytes; }
+
+private:
+	VkPhysicalDevice					m_PhysicalDevice;
+	VkDevice							m_LogicalDevice;
+	bool								shaderReadOnlyCopyDst				= false;	// in pCopyDstLayouts
+
+	PFN_vkVoidFunction					fetch_vkGetPhysicalDeviceImageFormatProperties2KHR	= nullptr;
+	PFN_vkVoidFunction					fetch_vkTransitionImageLayoutEXT	= nullptr;
+	PFN_vkVoidFunction					fetch_vkCopyMemoryToImageEXT		= nullptr;
+
+	uint64_t							hostCopiesCount						= 0;
+	VkDeviceSize						totalUploadedBytes					= 0;
+};
+
+#endif // !__SenHostImageCopy__
@@ -0,0 +1,312 @@
+#include "SenJobSystem.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+
+#if defined( _WIN32 )
+#include <Windows.h>		// for OutputDebugString() function
+#endif
+
+namespace {
+	// Set once per worker thread, tells a worker of which system (and which of its deques) the calling thread is
+	thread_local const SenJobSystem*	currentJobSystem	= nullptr;
+	thread_local uint32_t				currentWorkerIndex	= 0;
+
+	typedef std::chrono::high_resolution_clock	BenchmarkClock;
+	double secondsSince(const BenchmarkClock::time_point& startTime) {
+		return std::chrono::duration<double>(BenchmarkClock::now() - startTime).count();
+	}
+}
+
+const uint32_t SenJobSystem::maxBenchmarkThreadsCount;
+
+SenJobSystem::SenJobSystem(const uint32_t& workerThreadsCount)
+{
+	for (uint32_t dequeIndex = 0; dequeIndex <= workerThreadsCount; dequeIndex++)
+		jobDequeVector.emplace_back(new JobDequeStruct());
+	for (uint32_t workerIndex = 0; workerIndex < workerThreadsCount; workerIndex++)
+		workerThreadVector.emplace_back(&SenJobSystem::workerThreadLoop, this, workerIndex);
+}
+
+SenJobSystem::~SenJobSystem()
+{
+	// Workers drain every queued job before they quit
+	{
+		std::lock_guard<std::mutex> sleepLock(sleepMutex);
+		quitWorkers = true;
+	}
+	wakeConditionVariable.notify_all();
+	for (auto& workerThread : workerThreadVector)
+		workerThread.join();
+#if defined( _WIN32 )
+	OutputDebugString("\n\t ~SenJobSystem()\n");
+#endif
+}
+
+SenJobSystem& SenJobSystem::shared()
+{
+	static SenJobSystem sharedJobSystem((std::max)(2u, std::thread::hardware_concurrency()) - 1);
+	return sharedJobSystem;
+}
+
+void SenJobSystem::run(std::function<void()> jobFunction, JobCounter* jobCounter, JobCounter* dependencyCounter)
+{
+	JobStruct job;
+	job.jobFunction	= std::move(jobFunction);
+	job.jobCounter	= jobCounter;
+	if (nullptr != jobCounter)
+		jobCounter->pendingJobsCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (nullptr != dependencyCounter && !dependencyCounter->done()) {
+		// Checked again under the lock, the last job of dependencyCounter releases its dependents under the same lock
+		std::lock_guard<std::mutex> counterLock(dependencyCounter->counterMutex);
+		if (!dependencyCounter->done()) {
+			dependencyCounter->dependentJobVector.push_back(std::move(job));
+			return;
+		}
+	}
+	enqueueJob(std::move(job));
+}
+
+void SenJobSystem::wait(JobCounter& jobCounter)
+{
+	while (!jobCounter.done()) {
+		JobStruct job;
+		if (takeJob(job)) {
+			executeJob(job);
+			continue;
+		}
+		// Nothing to help with, the remaining jobs are running elsewhere (or parked on a dependency)
+		std::unique_lock<std::mutex> counterLock(jobCounter.counterMutex);
+		jobCounter.doneConditionVariable.wait_for(counterLock, std::chrono::microseconds(200), [&jobCounter] { return jobCounter.done(); });
+	}
+	// The last job finished under the lock, once it is released the counter may go out of scope
+	std::lock_guard<std::mutex> counterLock(jobCounter.counterMutex);
+	if (jobCounter.firstJobException)
+		std::rethrow_exception(jobCounter.firstJobException);
+}
+
+bool SenJobSystem::runQueuedJob()
+{
+	JobStruct job;
+	if (!takeJob(job))
+		return false;
+	executeJob(job);
+	return true;
+}
+
+void SenJobSystem::parallelFor(const uint32_t& itemsCount, const uint32_t& grainSize, const std::function<void(uint32_t, uint32_t)>& rangeFunction)
+{
+	if (0 == itemsCount) return;
+	const uint32_t chunkItemsCount = 0 != grainSize ? grainSize : (std::max)(1u, itemsCount / ((workerThreadsCount() + 1) * 4));
+
+	JobCounter chunkCounter;
+	for (uint32_t chunkBegin = chunkItemsCount; chunkBegin < itemsCount; chunkBegin += chunkItemsCount) {
+		const uint32_t chunkEnd = chunkBegin + (std::min)(chunkItemsCount, itemsCount - chunkBegin);
+		run([&rangeFunction, chunkBegin, chunkEnd]() { rangeFunction(chunkBegin, chunkEnd); }, &chunkCounter);
+	}
+
+	std::exception_ptr firstChunkException;
+	try {
+		rangeFunction(0, (std::min)(chunkItemsCount, itemsCount));
+	}
+	catch (...) {
+		firstChunkException = std::current_exception();
+	}
+	// Waited even when the first chunk threw, the other chunks reference rangeFunction
+	wait(chunkCounter);
+	if (firstChunkException)
+		std::rethrow_exception(firstChunkException);
+}
+
+/****************************************************************************************************************************/
+/**********        Deques:  own back (LIFO), steal front (FIFO)        ******************************************************/
+/****************************************************************************************************************************/
+uint32_t SenJobSystem::callingThreadDequeIndex() const
+{
+	return this == currentJobSystem ? currentWorkerIndex : workerThreadsCount();
+}
+
+void SenJobSystem::enqueueJob(JobStruct&& job)
+{
+	// Counted before it is visible, so queuedJobsCount never drops below the jobs actually queued
+	queuedJobsCount.fetch_add(1, std::memory_order_release);
+	JobDequeStruct& jobDeque = *jobDequeVector[callingThreadDequeIndex()];
+	{
+		std::lock_guard<std::mutex> dequeLock(jobDeque.dequeMutex);
+		jobDeque.jobDeque.push_back(std::move(job));
+	}
+	// Taking sleepMutex orders the notify after a worker's predicate check, no wakeup gets lost
+	{
+		std::lock_guard<std::mutex> sleepLock(sleepMutex);
+	}
+	wakeConditionVariable.notify_one();
+}
+
+bool SenJobSystem::takeJob(JobStruct& jobToPopulate)
+{
+	if (0 == queuedJobsCount.load(std::memory_order_acquire))
+		return false;
+
+	const uint32_t ownDequeIndex = callingThreadDequeIndex();
+	const uint32_t dequesCount = static_cast<uint32_t>(jobDequeVector.size());
+	for (uint32_t offset = 0; offset < dequesCount; offset++) {
+		const uint32_t dequeIndex = (ownDequeIndex + offset) % dequesCount;
+		JobDequeStruct& jobDeque = *jobDequeVector[dequeIndex];
+		std::lock_guard<std::mutex> dequeLock(jobDeque.dequeMutex);
+		if (jobDeque.jobDeque.empty()) continue;
+
+		if (0 == offset) {
+			jobToPopulate = std::move(jobDeque.jobDeque.back());
+			jobDeque.jobDeque.pop_back();
+		}else {
+			jobToPopulate = std::move(jobDeque.jobDeque.front());
+			jobDeque.jobDeque.pop_front();
+			stolenJobs.fetch_add(1, std::memory_order_relaxed);
+		}
+		queuedJobsCount.fetch_sub(1, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+void SenJobSystem::executeJob(JobStruct& job)
+{
+	std::exception_ptr jobException;
+	try {
+		job.jobFunction();
+	}
+	catch (...) {
+		jobException = std::current_exception();
+	}
+	job.jobFunction = nullptr;		// captured state is released before the counter tells anyone the job is done
+	executedJobs.fetch_add(1, std::memory_order_relaxed);
+
+	JobCounter* jobCounter = job.jobCounter;
+	if (nullptr == jobCounter) return;
+
+	std::vector<JobStruct> releasedJobVector;
+	{
+		std::lock_guard<std::mutex> counterLock(jobCounter->counterMutex);
+		if (jobException && !jobCounter->firstJobException)
+			jobCounter->firstJobException = jobException;
+		if (1 == jobCounter->pendingJobsCount.fetch_sub(1, std::memory_order_acq_rel)) {
+			releasedJobVector.swap(jobCounter->dependentJobVector);
+			jobCounter->doneConditionVariable.notify_all();
+		}
+	}
+	// jobCounter must not be touched from here on, its waiter may already have returned
+	for (auto& releasedJob : releasedJobVector)
+		enqueueJob(std::move(releasedJob));
+}
+
+void SenJobSystem::workerThreadLoop(const uint32_t& workerIndex)
+{
+	currentJobSystem	= this;
+	currentWorkerIndex	= workerIndex;
+	while (true) {
+		JobStruct job;
+		if (takeJob(job)) {
+			executeJob(job);
+			continue;
+		}
+		std::unique_lock<std::mutex> sleepLock(sleepMutex);
+		wakeConditionVariable.wait(sleepLock, [this] { return quitWorkers || 0 != queuedJobsCount.load(std::memory_order_acquire); });
+		if (quitWorkers && 0 == queuedJobsCount.load(std::memory_order_acquire))
+			return;
+	}
+}
+
+/****************************************************************************************************************************/
+/**********        Benchmark:  scheduler overhead and scaling, 1 to N threads        ****************************************/
+/****************************************************************************************************************************/
+std::string SenJobSystem::benchmark(const uint32_t& maxThreadsCount)
+{
+	const uint32_t threadsCountLimit	= (std::min)(0 != maxThreadsCount ? maxThreadsCount : (std::max)(1u, std::thread::hardware_concurrency()), maxBenchmarkThreadsCount);
+	const uint32_t emptyJobsCount		= 200000;
+	const uint32_t stagesCount			= 64, stageJobsCount = 256;
+	const uint32_t loopItemsCount		= 1 << 20;
+	const int runsCount					= 3;	// best of
+
+	std::vector<uint32_t> threadsCountVector;
+	for (uint32_t threadsCount = 1; threadsCount < threadsCountLimit; threadsCount *= 2)
+		threadsCountVector.push_back(threadsCount);
+	threadsCountVector.push_back(threadsCountLimit);
+
+	std::vector<float> loopResultVector(loopItemsCount);
+	auto loopRange = [&loopResultVector](uint32_t begin, uint32_t end) {
+		for (uint32_t item = begin; item < end; item++) {
+			float value = static_cast<float>(item) * 1e-6f;
+			for (int step = 0; step < 64; step++)
+				value = value * 0.999f + std::sqrt(value + 1.0f);
+			loopResultVector[item] = value;
+		}
+	};
+
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(2);
+	stream << "\t SenJobSystem benchmark (" << std::thread::hardware_concurrency() << " hardware threads), best of " << runsCount << ":\n";
+	stream << "\t threads   empty job ns   dependent job ns   parallelFor ms   speedup   efficiency   stolen\n";
+
+	double singleThreadLoopSeconds = 0.0;
+	for (uint32_t threadsCount : threadsCountVector) {
+		SenJobSystem jobSystem(threadsCount - 1);		// the calling thread is the last one, helping in wait()
+		double emptyJobSeconds = 0.0, dependentJobSeconds = 0.0, loopSeconds = 0.0;
+		uint64_t loopStolenJobs = 0;
+		for (int run = 0; run < runsCount; run++) {
+			/*****   Independent empty jobs from an outside thread:  submission, stealing and completion cost   *****/
+			auto startTime = BenchmarkClock::now();
+			{
+				JobCounter emptyJobCounter;
+				for (uint32_t job = 0; job < emptyJobsCount; job++)
+					jobSystem.run([]() {}, &emptyJobCounter);
+				jobSystem.wait(emptyJobCounter);
+			}
+			double seconds = secondsSince(startTime);
+			emptyJobSeconds = 0 == run ? seconds : (std::min)(emptyJobSeconds, seconds);
+
+			/*****   Stages of jobs, each stage parked on the counter of the one before   *************************/
+			startTime = BenchmarkClock::now();
+			{
+				std::vector<std::unique_ptr<JobCounter>> stageCounterVector;
+				for (uint32_t stage = 0; stage < stagesCount; stage++) {
+					stageCounterVector.emplace_back(new JobCounter());
+					JobCounter* dependencyCounter = 0 == stage ? nullptr : stageCounterVector[stage - 1].get();
+					for (uint32_t job = 0; job < stageJobsCount; job++)
+						jobSystem.run([]() {}, stageCounterVector[stage].get(), dependencyCounter);
+				}
+				for (auto& stageCounter : stageCounterVector)
+					jobSystem.wait(*stageCounter);
+			}
+			seconds = secondsSince(startTime);
+			dependentJobSeconds = 0 == run ? seconds : (std::min)(dependentJobSeconds, seconds);
+
+			/*****   CPU bound parallelFor, automatic grain   ******************************************************/
+			const uint64_t stolenJobsBefore = jobSystem.stolenJobsCount();
+			startTime = BenchmarkClock::now();
+			jobSystem.parallelFor(loopItemsCount, 0, loopRange);
+			seconds = secondsSince(startTime);
+			if (0 == run || seconds < loopSeconds) {
+				loopSeconds		= seconds;
+				loopStolenJobs	= jobSystem.stolenJobsCount() - stolenJobsBefore;
+			}
+		}
+		if (1 == threadsCount)
+			singleThreadLoopSeconds = loopSeconds;
+		const double speedup = loopSeconds > 0.0 ? singleThreadLoopSeconds / loopSeconds : 0.0;
+
+		stream << "\t " << std::setw(7) << threadsCount
+			<< std::setw(15) << emptyJobSeconds * 1.0e9 / emptyJobsCount
+			<< std::setw(19) << dependentJobSeconds * 1.0e9 / (stagesCount * stageJobsCount)
+			<< std::setw(17) << loopSeconds * 1.0e3
+			<< std::setw(10) << speedup
+			<< std::setw(12) << speedup / threadsCount * 100.0 << "%"
+			<< std::setw(8) << loopStolenJobs << "\n";
+	}
+	// Keeps the loop from being optimized away
+	stream << "\t (checksum " << loopResultVector[loopItemsCount / 3] << ")\n";
+	return stream.str();
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#ifndef __SenJobSystem__
+#define __SenJobSystem__
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+	Work-stealing job scheduler shared by loaders, preprocessors and startup steps (shared()):
+	every worker thread owns a deque, pushes and pops its own jobs at the back (the most recent job is the one whose
+	data is still in cache) and, once it runs dry, steals the oldest job from the front of another deque.  Jobs run()
+	from outside threads go to one more deque that the workers steal from.
+	A JobCounter counts the jobs run() against it until they finished;  wait() runs queued jobs on the calling thread
+	until the counter is done (so waiting inside a job never blocks a worker), then rethrows the first exception one
+	of its jobs threw.  A job run() with a dependencyCounter is parked on that counter and queued once it is done,
+	which chains stages without any thread blocking in between.  parallelFor() cuts a range into chunks on top of it.
+	Counters have to outlive their jobs (wait() on them) and belong to one SenJobSystem.
+*/
+class SenJobSystem
+{
+public:
+	class JobCounter;
+
+private:
+	struct JobStruct {
+		std::function<void()>			jobFunction;
+		JobCounter*						jobCounter				= nullptr;
+	};
+
+public:
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool done() const { return 0 == pendingJobsCount.load(std::memory_order_acquire); }
+
+	private:
+		friend class SenJobSystem;
+		std::atomic<uint32_t>			pendingJobsCount{ 0 };
+		std::mutex						counterMutex;
+		std::condition_variable			doneConditionVariable;
+		std::vector<JobStruct>			dependentJobVector;		// run() with this counter as dependency, queued once done
+		std::exception_ptr				firstJobException;
+	};
+
+	// workerThreadsCount may be 0:  jobs then only run inside wait() / parallelFor() on the calling thread
+	explicit SenJobSystem(const uint32_t& workerThreadsCount);
+	virtual ~SenJobSystem();
+	SenJobSystem(const SenJobSystem&) = delete;
+	SenJobSystem& operator=(const SenJobSystem&) = delete;
+
+	// Process wide instance, created on first use:  one worker per hardware thread but the caller's (at least one)
+	static SenJobSystem& shared();
+
+	void run(std::function<void()> jobFunction, JobCounter* jobCounter = nullptr, JobCounter* dependencyCounter = nullptr);
+	void wait(JobCounter& jobCounter);
+	// Runs one queued job on the calling thread, false when there was none:  for waits on anything else than a JobCounter
+	bool runQueuedJob();
+	// rangeFunction(begin, end) over [0, itemsCount) in chunks of grainSize items, 0:  about four chunks per thread;
+	//   the calling thread takes the first chunk and helps with the rest, returns once all of them ran
+	void parallelFor(const uint32_t& itemsCount, const uint32_t& grainSize, const std::function<void(uint32_t, uint32_t)>& rangeFunction);
+
+	uint32_t workerThreadsCount() const { return static_cast<uint32_t>(workerThreadVector.size()); }
+	uint64_t executedJobsCount() const { return executedJobs.load(); }
+	uint64_t stolenJobsCount() const { return stolenJobs.load(); }
+
+	// Per job overhead of empty jobs, dependent stages and parallelFor speedup of a CPU bound loop, from 1 thread (the caller)
+	//   to maxThreadsCount (0:  hardware threads);  every step runs on a SenJobSystem of its own, shared() is untouched
+	static std::string benchmark(const uint32_t& maxThreadsCount = 0);
+	static const uint32_t				maxBenchmarkThreadsCount	= 256;	// larger maxThreadsCount is clamped to it
+
+private:
+	struct JobDequeStruct {
+		std::mutex						dequeMutex;
+		std::deque<JobStruct>			jobDeque;				// owner at the back, thieves at the front
+	};
+
+	// Deque of the calling thread:  its own for a worker of this system, else the one shared by outside threads
+	uint32_t callingThreadDequeIndex() const;
+	void enqueueJob(JobStruct&& job);
+	// Own deque first, then steals from the others;  false when every deque is empty
+	bool takeJob(JobStruct& jobToPopulate);
+	void executeJob(JobStruct& job);
+	void workerThreadLoop(const uint32_t& workerIndex);
+
+	std::vector<std::unique_ptr<JobDequeStruct>>	jobDequeVector;	// one per worker, the last one for outside threads
+	std::vector<std::thread>			workerThreadVector;
+	std::atomic<uint32_t>				queuedJobsCount{ 0 };	// over all deques, parked dependent jobs not included
+	std::mutex							sleepMutex;
+	std::condition_variable				wakeConditionVariable;
+	bool								quitWorkers				= false;
+
+	std::atomic<uint64_t>				executedJobs{ 0 };
+	std::atomic<uint64_t>				stolenJobs{ 0 };
+};
+
+#endif // !__SenJobSystem__
@@ -0,0 +1,286 @@
+#include "SenKtxFile.h"
+#include "SenStagingRing.h"
+
+#include <cstring>
+
+#if !defined( _WIN32 )
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+	const uint8_t ktx1Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x31, 0x31, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };	// «KTX 11»\r\n\x1A\n
+	const uint8_t ktx2Identifier[12] = { 0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32, 0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A };	// «KTX 20»\r\n\x1A\n
+
+	struct Ktx1HeaderStruct {
+		uint8_t		identifier[12];
+		uint32_t	endianness;					// 0x04030201 when written with the reader's byte order
+		uint32_t	glType;
+		uint32_t	glTypeSize;
+		uint32_t	glFormat;
+		uint32_t	glInternalFormat;
+		uint32_t	glBaseInternalFormat;
+		uint32_t	pixelWidth;
+		uint32_t	pixelHeight;
+		uint32_t	pixelDepth;
+		uint32_t	numberOfArrayElements;
+		uint32_t	numberOfFaces;
+		uint32_t	numberOfMipmapLevels;
+		uint32_t	bytesOfKeyValueData;
+	};
+	struct Ktx2HeaderStruct {
+		uint8_t		identifier[12];
+		uint32_t	vkFormat;
+		uint32_t	typeSize;
+		uint32_t	pixelWidth;
+		uint32_t	pixelHeight;
+		uint32_t	pixelDepth;
+		uint32_t	layerCount;
+		uint32_t	faceCount;
+		uint32_t	levelCount;
+		uint32_t	supercompressionScheme;
+		uint32_t	dfdByteOffset;
+		uint32_t	dfdByteLength;
+		uint32_t	kvdByteOffset;
+		uint32_t	kvdByteLength;
+		uint64_t	sgdByteOffset;
+		uint64_t	sgdByteLength;
+	};
+	struct Ktx2LevelIndexStruct {
+		uint64_t	byteOffset;
+		uint64_t	byteLength;
+		uint64_t	uncompressedByteLength;
+	};
+	static_assert(sizeof(Ktx1HeaderStruct) == 64 && sizeof(Ktx2HeaderStruct) == 80, "KTX headers are read with memcpy");
+
+	// The formats the gli path used to accept, plus the plain RGBA8 ones
+	VkFormat vulkanFormatFromGlInternalFormat(const uint32_t& glInternalFormat) {
+		switch (glInternalFormat) {
+		case 0x8E8C:	return VK_FORMAT_BC7_UNORM_BLOCK;		// GL_COMPRESSED_RGBA_BPTC_UNORM
+		case 0x8E8D:	return VK_FORMAT_BC7_SRGB_BLOCK;		// GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM
+		case 0x83F2:	return VK_FORMAT_BC2_UNORM_BLOCK;		// GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+		case 0x83F3:	return VK_FORMAT_BC3_UNORM_BLOCK;		// GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+		case 0x83F1:	return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;	// GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+		case 0x83F0:	return VK_FORMAT_BC1_RGB_UNORM_BLOCK;	// GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+		case 0x8DBB:	return VK_FORMAT_BC4_UNORM_BLOCK;		// GL_COMPRESSED_RED_RGTC1
+		case 0x8DBD:									// GL_COMPRESSED_RG_RGTC2
+		case 0x8837:	return VK_FORMAT_BC5_UNORM_BLOCK;		// GL_COMPRESSED_LUMINANCE_ALPHA_3DC_ATI
+		case 0x9270:	return VK_FORMAT_EAC_R11_UNORM_BLOCK;	// GL_COMPRESSED_R11_EAC
+		case 0x8058:	return VK_FORMAT_R8G8B8A8_UNORM;		// GL_RGBA8
+		case 0x8C43:	return VK_FORMAT_R8G8B8A8_SRGB;			// GL_SRGB8_ALPHA8
+		default:
+			throw std::runtime_error("May not support this KTX image format, check it out !!!");
+		}
+	}
+}
+
+SenKtxFile::SenKtxFile(const std::string& ktxDiskAddress)
+{
+	try {
+		mapFile(ktxDiskAddress);
+		if (mappedBytes >= sizeof(ktx1Identifier) && 0 == memcmp(mappedData, ktx1Identifier, sizeof(ktx1Identifier)))
+			parseKtx1();
+		else if (mappedBytes >= sizeof(ktx2Identifier) && 0 == memcmp(mappedData, ktx2Identifier, sizeof(ktx2Identifier)))
+			parseKtx2();
+		else
+			throw std::runtime_error("Not a KTX file !!!");
+	}
+	catch (const std::runtime_error& e) {
+		unmapFile();	// the destructor does not run for a throwing constructor
+		throw std::runtime_error("failed to load KTX image " + ktxDiskAddress + ":  " + e.what());
+	}
+}
+
+SenKtxFile::~SenKtxFile()
+{
+	unmapFile();
+#if defined( _WIN32 )
+	OutputDebugString("\n\t ~SenKtxFile()\n");
+#endif
+}
+
+bool SenKtxFile::isKtxAddress(const std::string& textureDiskAddress)
+{
+	const size_t dotPosition = textureDiskAddress.find_last_of('.');
+	if (std::string::npos == dotPosition) return false;
+	const std::string extension = textureDiskAddress.substr(dotPosition);
+	return extension == ".ktx" || extension == ".ktx2";
+}
+
+const uint8_t* SenKtxFile::imageData(const uint32_t& level, const uint32_t& layer) const
+{
+	if (level >= levelVector.size() || layer >= layersCount())
+		throw std::runtime_error("KTX level or layer out of range !!!");
+	return mappedData + levelVector[level].byteOffset + layer * levelVector[level].imageBytes;
+}
+
+VkDeviceSize SenKtxFile::imageBytes(const uint32_t& level) const
+{
+	if (level >= levelVector.size())
+		throw std::runtime_error("KTX level out of range !!!");
+	return levelVector[level].imageBytes;
+}
+
+void SenKtxFile::touchPages() const
+{
+	volatile uint8_t touchedByte = 0;
+	for (size_t byteOffset = 0; byteOffset < mappedBytes; byteOffset += 4096)
+		touchedByte = mappedData[byteOffset];
+	(void)touchedByte;
+}
+
+/****************************************************************************************************************************/
+/**********   Read-only mapping, unmapped by the destructor   ***************************************************************/
+/****************************************************************************************************************************/
+void SenKtxFile::mapFile(const std::string& ktxDiskAddress)
+{
+#if defined( _WIN32 )
+	fileHandle = CreateFileA(ktxDiskAddress.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (INVALID_HANDLE_VALUE == fileHandle)
+		throw std::runtime_error("failed to open file!");
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || 0 == fileSize.QuadPart)
+		throw std::runtime_error("Empty KTX file !!!");
+	mappedBytes = static_cast<size_t>(fileSize.QuadPart);
+
+	fileMappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (NULL == fileMappingHandle)
+		throw std::runtime_error("Failed to map KTX file !!!");
+	mappedData = static_cast<const uint8_t*>(MapViewOfFile(fileMappingHandle, FILE_MAP_READ, 0, 0, 0));
+	if (nullptr == mappedData)
+		throw std::runtime_error("Failed to map KTX file !!!");
+#else
+	fileDescriptor = open(ktxDiskAddress.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+		throw std::runtime_error("failed to open file!");
+
+	struct stat fileStatus;
+	if (0 != fstat(fileDescriptor, &fileStatus) || 0 == fileStatus.st_size)
+		throw std::runtime_error("Empty KTX file !!!");
+	mappedBytes = static_cast<size_t>(fileStatus.st_size);
+
+	void* mapping = mmap(nullptr, mappedBytes, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (MAP_FAILED == mapping)
+		throw std::runtime_error("Failed to map KTX file !!!");
+	madvise(mapping, mappedBytes, MADV_SEQUENTIAL);
+	mappedData = static_cast<const uint8_t*>(mapping);
+#endif
+}
+
+void SenKtxFile::unmapFile()
+{
+#if defined( _WIN32 )
+	if (nullptr != mappedData)					UnmapViewOfFile(mappedData);
+	if (NULL != fileMappingHandle)				CloseHandle(fileMappingHandle);
+	if (INVALID_HANDLE_VALUE != fileHandle)		CloseHandle(fileHandle);
+	fileMappingHandle	= NULL;
+	fileHandle			= INVALID_HANDLE_VALUE;
+#else
+	if (nullptr != mappedData)					munmap(const_cast<uint8_t*>(mappedData), mappedBytes);
+	if (fileDescriptor >= 0)					close(fileDescriptor);
+	fileDescriptor		= -1;
+#endif
+	mappedData			= nullptr;
+	mappedBytes			= 0;
+}
+
+/****************************************************************************************************************************/
+/**********   KTX 1.1:  per level a uint32_t imageSize, then all its layers and faces, padded to 4 bytes   *******************/
+/****************************************************************************************************************************/
+void SenKtxFile::parseKtx1()
+{
+	Ktx1HeaderStruct header;
+	if (mappedBytes < sizeof(header))
+		throw std::runtime_error("Truncated KTX header !!!");
+	memcpy(&header, mappedData, sizeof(header));
+	if (0x04030201 != header.endianness)
+		throw std::runtime_error("Big endian KTX files are not supported !!!");
+	if (1 != header.numberOfFaces && 6 != header.numberOfFaces)
+		throw std::runtime_error("Malformed KTX header, numberOfFaces !!!");
+
+	imageFormat			= vulkanFormatFromGlInternalFormat(header.glInternalFormat);
+	pixelWidth			= header.pixelWidth;
+	pixelHeight			= (std::max)(header.pixelHeight, 1u);
+	pixelDepth			= (std::max)(header.pixelDepth, 1u);
+	arrayLayersCount	= (std::max)(header.numberOfArrayElements, 1u);
+	facesCount			= header.numberOfFaces;
+	const uint32_t levelsCountInFile = (std::max)(header.numberOfMipmapLevels, 1u);
+
+	VkDeviceSize byteOffset = (VkDeviceSize)sizeof(header) + header.bytesOfKeyValueData;
+	for (uint32_t level = 0; level < levelsCountInFile; level++) {
+		if (byteOffset + sizeof(uint32_t) > mappedBytes)
+			throw std::runtime_error("Truncated KTX level !!!");
+		uint32_t imageSize;
+		memcpy(&imageSize, mappedData + byteOffset, sizeof(imageSize));
+		byteOffset += sizeof(imageSize);
+
+		// imageSize covers all layers and faces, but a single face of a non-array cube map (each face padded to 4)
+		VkDeviceSize levelBytesInFile = imageSize;
+		if (6 == facesCount && 0 == header.numberOfArrayElements) {
+			if (0 != imageSize % 4)
+				throw std::runtime_error("Padded KTX cube faces are not supported !!!");
+			levelBytesInFile = (VkDeviceSize)imageSize * 6;
+		}
+		addLevel(byteOffset, levelBytesInFile, level);
+		byteOffset += (levelBytesInFile + 3) / 4 * 4;	// mipPadding
+	}
+}
+
+/****************************************************************************************************************************/
+/**********   KTX2:  the header holds the VkFormat, the level index where each level starts   *******************************/
+/****************************************************************************************************************************/
+void SenKtxFile::parseKtx2()
+{
+	Ktx2HeaderStruct header;
+	if (mappedBytes < sizeof(header))
+		throw std::runtime_error("Truncated KTX2 header !!!");
+	memcpy(&header, mappedData, sizeof(header));
+	if (0 != header.supercompressionScheme)
+		throw std::runtime_error("Supercompressed KTX2 files are not supported, transcode them offline !!!");
+	if (VK_FORMAT_UNDEFINED == header.vkFormat)
+		throw std::runtime_error("KTX2 files without a VkFormat (Basis Universal) are not supported !!!");
+	if (1 != header.faceCount && 6 != header.faceCount)
+		throw std::runtime_error("Malformed KTX2 header, faceCount !!!");
+
+	imageFormat			= static_cast<VkFormat>(header.vkFormat);
+	pixelWidth			= header.pixelWidth;
+	pixelHeight			= (std::max)(header.pixelHeight, 1u);
+	pixelDepth			= (std::max)(header.pixelDepth, 1u);
+	arrayLayersCount	= (std::max)(header.layerCount, 1u);
+	facesCount			= header.faceCount;
+	const uint32_t levelsCountInFile = (std::max)(header.levelCount, 1u);
+
+	if (sizeof(header) + (VkDeviceSize)levelsCountInFile * sizeof(Ktx2LevelIndexStruct) > mappedBytes)
+		throw std::runtime_error("Truncated KTX2 level index !!!");
+	for (uint32_t level = 0; level < levelsCountInFile; level++) {
+		Ktx2LevelIndexStruct levelIndex;
+		memcpy(&levelIndex, mappedData + sizeof(header) + level * sizeof(levelIndex), sizeof(levelIndex));
+		addLevel(levelIndex.byteOffset, levelIndex.byteLength, level);
+	}
+}
+
+void SenKtxFile::addLevel(const VkDeviceSize& byteOffset, const VkDeviceSize& levelBytesInFile, const uint32_t& level)
+{
+	if (0 == pixelWidth || level >= 32)
+		throw std::runtime_error("Malformed KTX extent or level count !!!");
+
+	uint32_t blockBytes = 4, blockExtent = 1;
+	SenStagingRing::texelBlockSize(imageFormat, blockBytes, blockExtent);
+	const uint32_t levelWidth	= (std::max)(pixelWidth >> level, 1u);
+	const uint32_t levelHeight	= (std::max)(pixelHeight >> level, 1u);
+	const uint32_t levelDepth	= (std::max)(pixelDepth >> level, 1u);
+
+	LevelStruct levelStruct;
+	levelStruct.byteOffset	= byteOffset;
+	levelStruct.imageBytes	= (VkDeviceSize)((levelWidth + blockExtent - 1) / blockExtent) * ((levelHeight + blockExtent - 1) / blockExtent)
+		* blockBytes * levelDepth;
+	if (levelStruct.imageBytes * layersCount() != levelBytesInFile)
+		throw std::runtime_error("KTX level size does not match its format (row padding, or an unsupported block size) !!!");
+	if (byteOffset + levelBytesInFile > mappedBytes)
+		throw std::runtime_error("Truncated KTX level !!!");
+	levelVector.push_back(levelStruct);
+}
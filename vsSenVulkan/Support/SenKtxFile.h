@@ -0,0 +1,74 @@
+#pragma once
+
+#ifndef __SenKtxFile__
+#define __SenKtxFile__
+
+#include "SLVK_AbstractGLFW.h"
+
+/*
+	Read-only memory mapping of a .ktx (KTX 1.1) or .ktx2 file, parsed in place:  the header gives the VkFormat and
+	extents, the level index gives where each mip level starts in the mapping, and imageData() points right into it.
+	Uploads memcpy from the mapping straight into the staging ring, so the texel data is copied once and never
+	sits in a heap allocation of its own;  the OS pages the file in as the copy reads it (or ahead of it, touchPages()).
+	Within a level, every array layer and cube face is one tightly packed image, layer major (Vulkan's layer order);
+	supercompressed KTX2 (Basis, zstd) and formats whose level size does not match their texel blocks are rejected.
+	Not copyable, the mapping lives as long as the object.
+*/
+class SenKtxFile
+{
+public:
+	explicit SenKtxFile(const std::string& ktxDiskAddress);
+	virtual ~SenKtxFile();
+	SenKtxFile(const SenKtxFile&) = delete;
+	SenKtxFile& operator=(const SenKtxFile&) = delete;
+
+	// ends with .ktx or .ktx2
+	static bool isKtxAddress(const std::string& textureDiskAddress);
+
+	VkFormat format() const { return imageFormat; }
+	uint32_t width() const { return pixelWidth; }
+	uint32_t height() const { return pixelHeight; }
+	uint32_t depth() const { return pixelDepth; }
+	uint32_t levelsCount() const { return static_cast<uint32_t>(levelVector.size()); }
+	uint32_t layersCount() const { return arrayLayersCount * facesCount; }		// array layers times cube faces
+
+	// Tightly packed texel blocks of one layer (or face) of one level, inside the mapping
+	const uint8_t* imageData(const uint32_t& level, const uint32_t& layer) const;
+	VkDeviceSize imageBytes(const uint32_t& level) const;
+
+	// Reads one byte per page, so a worker thread takes the page faults instead of the uploading thread
+	void touchPages() const;
+	size_t fileBytes() const { return mappedBytes; }
+
+private:
+	struct LevelStruct {
+		VkDeviceSize					byteOffset				= 0;	// from the start of the file
+		VkDeviceSize					imageBytes				= 0;	// one layer / face
+	};
+
+	void mapFile(const std::string& ktxDiskAddress);
+	void unmapFile();
+	void parseKtx1();
+	void parseKtx2();
+	// Level sizes from the texel blocks, checked against what the file says it holds
+	void addLevel(const VkDeviceSize& byteOffset, const VkDeviceSize& levelBytesInFile, const uint32_t& level);
+
+	const uint8_t*						mappedData				= nullptr;
+	size_t								mappedBytes				= 0;
+#if defined( _WIN32 )
+	HANDLE								fileHandle				= INVALID_HANDLE_VALUE;
+	HANDLE								fileMappingHandle		= NULL;
+#else
+	int									fileDescriptor			= -1;
+#endif
+
+	VkFormat							imageFormat				= VK_FORMAT_UNDEFINED;
+	uint32_t							pixelWidth				= 0;
+	uint32_t							pixelHeight				= 0;
+	uint32_t							pixelDepth				= 1;
+	uint32_t							arrayLayersCount		= 1;
+	uint32_t							facesCount				= 1;
+	std::vector<LevelStruct>			levelVector;
+};
+
+#endif // !__SenKtxFile__
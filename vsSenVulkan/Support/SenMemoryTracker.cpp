@@ -0,0 +1,179 @@
+#include "SenMemoryTracker.h"
+
+SenMemoryTracker::TrackerStateStruct& SenMemoryTracker::trackerState()
+{
+	static TrackerStateStruct state;
+	return state;
+}
+
+void SenMemoryTracker::initialize(const VkPhysicalDevice& physicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+	const PFN_vkVoidFunction& fetch_vkGetPhysicalDeviceMemoryProperties2)
+{
+	TrackerStateStruct& state = trackerState();
+	std::lock_guard<std::mutex> trackerLock(state.trackerMutex);
+	state.physicalDevice								= physicalDevice;
+	state.gpuMemoryProperties							= gpuMemoryProperties;
+	state.fetch_vkGetPhysicalDeviceMemoryProperties2	= fetch_vkGetPhysicalDeviceMemoryProperties2;
+}
+
+void SenMemoryTracker::recordAllocation(const VkDeviceMemory& deviceMemory, const VkDeviceSize& allocationSize,
+	const uint32_t& memoryTypeIndex, const MemoryCategory& category)
+{
+	if (VK_NULL_HANDLE == deviceMemory) return;
+
+	TrackerStateStruct& state = trackerState();
+	std::lock_guard<std::mutex> trackerLock(state.trackerMutex);
+
+	TrackedAllocationStruct trackedAllocation;
+	trackedAllocation.allocationSize	= allocationSize;
+	trackedAllocation.heapIndex			= memoryTypeIndex < state.gpuMemoryProperties.memoryTypeCount
+											? state.gpuMemoryProperties.memoryTypes[memoryTypeIndex].heapIndex : 0;
+	trackedAllocation.category			= category;
+	state.trackedAllocationMap[deviceMemory] = trackedAllocation;
+
+	CategoryUsageStruct& categoryUsage = state.categoryUsageArray[category];
+	categoryUsage.bytes					+= allocationSize;
+	categoryUsage.peakBytes				= (std::max)(categoryUsage.peakBytes, categoryUsage.bytes);
+	categoryUsage.allocationsCount++;
+
+	VkDeviceSize& heapTrackedBytes		= state.heapTrackedBytesArray[trackedAllocation.heapIndex];
+	heapTrackedBytes					+= allocationSize;
+	state.heapTrackedPeakBytesArray[trackedAllocation.heapIndex] = (std::max)(state.heapTrackedPeakBytesArray[trackedAllocation.heapIndex], heapTrackedBytes);
+}
+
+void SenMemoryTracker::recordFree(const VkDeviceMemory& deviceMemory)
+{
+	TrackerStateStruct& state = trackerState();
+	std::lock_guard<std::mutex> trackerLock(state.trackerMutex);
+
+	auto trackedAllocationIterator = state.trackedAllocationMap.find(deviceMemory);
+	if (trackedAllocationIterator == state.trackedAllocationMap.end()) return;	// allocated before initialize() or outside the helpers
+
+	const TrackedAllocationStruct& trackedAllocation = trackedAllocationIterator->second;
+	CategoryUsageStruct& categoryUsage = state.categoryUsageArray[trackedAllocation.category];
+	categoryUsage.bytes -= trackedAllocation.allocationSize;
+	categoryUsage.allocationsCount--;
+	state.heapTrackedBytesArray[trackedAllocation.heapIndex] -= trackedAllocation.allocationSize;
+
+	state.trackedAllocationMap.erase(trackedAllocationIterator);
+}
+
+SenMemoryTracker::MemoryCategory SenMemoryTracker::categoryFromBufferUsage(const VkBufferUsageFlags& bufferUsageFlags,
+	const VkMemoryPropertyFlags& memoryPropertyFlags)
+{
+	if (bufferUsageFlags & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT)
+		return MEMORY_CATEGORY_UNIFORM;
+	if (bufferUsageFlags & (VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT))
+		return MEMORY_CATEGORY_MESH;
+	// Host visible and only ever copied from:  an upload buffer
+	if ((bufferUsageFlags & VK_BUFFER_USAGE_TRANSFER_SRC_BIT) && (memoryPropertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT))
+		return MEMORY_CATEGORY_STAGING;
+	return MEMORY_CATEGORY_OTHER;
+}
+
+SenMemoryTracker::MemoryCategory SenMemoryTracker::categoryFromImageUsage(const VkImageUsageFlags& imageUsageFlags)
+{
+	if (imageUsageFlags & (VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT
+		| VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_INPUT_ATTACHMENT_BIT))
+		return MEMORY_CATEGORY_ATTACHMENT;
+	if (imageUsageFlags & VK_IMAGE_USAGE_SAMPLED_BIT)
+		return MEMORY_CATEGORY_TEXTURE;
+	// Linear images that only serve as a copy source are uploads
+	if (imageUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT)
+		return MEMORY_CATEGORY_STAGING;
+	return MEMORY_CATEGORY_OTHER;
+}
+
+std::vector<SenMemoryTracker::HeapUsageStruct> SenMemoryTracker::heapUsage()
+{
+	TrackerStateStruct& state = trackerState();
+	std::lock_guard<std::mutex> trackerLock(state.trackerMutex);
+
+	std::vector<HeapUsageStruct> heapUsageVector(state.gpuMemoryProperties.memoryHeapCount);
+	for (uint32_t heapIndex = 0; heapIndex < state.gpuMemoryProperties.memoryHeapCount; heapIndex++) {
+		HeapUsageStruct& heapUsage = heapUsageVector[heapIndex];
+		heapUsage.heapSize			= state.gpuMemoryProperties.memoryHeaps[heapIndex].size;
+		heapUsage.deviceLocal		= 0 != (state.gpuMemoryProperties.memoryHeaps[heapIndex].flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT);
+		heapUsage.trackedBytes		= state.heapTrackedBytesArray[heapIndex];
+		heapUsage.trackedPeakBytes	= state.heapTrackedPeakBytesArray[heapIndex];
+		heapUsage.budgetBytes		= heapUsage.heapSize;
+		heapUsage.usageBytes		= heapUsage.trackedBytes;
+	}
+
+#if defined( VK_EXT_memory_budget ) && defined( VK_KHR_get_physical_device_properties2 )
+	if (nullptr != state.fetch_vkGetPhysicalDeviceMemoryProperties2) {
+		VkPhysicalDeviceMemoryBudgetPropertiesEXT memoryBudgetProperties{};
+		memoryBudgetProperties.sType	= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT;
+		VkPhysicalDeviceMemoryProperties2KHR memoryProperties2{};
+		memoryProperties2.sType			= VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2_KHR;
+		memoryProperties2.pNext			= &memoryBudgetProperties;
+		reinterpret_cast<PFN_vkGetPhysicalDeviceMemoryProperties2KHR>(state.fetch_vkGetPhysicalDeviceMemoryProperties2)(
+			state.physicalDevice, &memoryProperties2);
+
+		for (uint32_t heapIndex = 0; heapIndex < heapUsageVector.size(); heapIndex++) {
+			heapUsageVector[heapIndex].budgetBytes	= memoryBudgetProperties.heapBudget[heapIndex];
+			heapUsageVector[heapIndex].usageBytes	= memoryBudgetProperties.heapUsage[heapIndex];
+		}
+	}
+#endif
+	return heapUsageVector;
+}
+
+VkDeviceSize SenMemoryTracker::deviceLocalHeadroom()
+{
+	VkDeviceSize headroomBytes = VK_WHOLE_SIZE;
+	for (const auto& heapUsage : SenMemoryTracker::heapUsage()) {
+		if (heapUsage.deviceLocal)
+			headroomBytes = (std::min)(headroomBytes, heapUsage.headroomBytes());
+	}
+	return VK_WHOLE_SIZE == headroomBytes ? 0 : headroomBytes;
+}
+
+SenMemoryTracker::CategoryUsageStruct SenMemoryTracker::categoryUsage(const MemoryCategory& category)
+{
+	TrackerStateStruct& state = trackerState();
+	std::lock_guard<std::mutex> trackerLock(state.trackerMutex);
+	return state.categoryUsageArray[category];
+}
+
+bool SenMemoryTracker::memoryBudgetSupported()
+{
+	TrackerStateStruct& state = trackerState();
+	std::lock_guard<std::mutex> trackerLock(state.trackerMutex);
+	return nullptr != state.fetch_vkGetPhysicalDeviceMemoryProperties2;
+}
+
+const char* SenMemoryTracker::categoryName(const MemoryCategory& category)
+{
+	switch (category) {
+	case MEMORY_CATEGORY_MESH:			return "mesh";
+	case MEMORY_CATEGORY_TEXTURE:		return "texture";
+	case MEMORY_CATEGORY_STAGING:		return "staging";
+	case MEMORY_CATEGORY_UNIFORM:		return "uniform";
+	case MEMORY_CATEGORY_ATTACHMENT:	return "attachment";
+	default:							return "other";
+	}
+}
+
+std::string SenMemoryTracker::report()
+{
+	const double megabyte = 1024.0 * 1024.0;
+	std::ostringstream stream;
+	stream << "Device memory (" << (memoryBudgetSupported() ? "VK_EXT_memory_budget" : "tracked only, no VK_EXT_memory_budget") << "):\n";
+
+	std::vector<HeapUsageStruct> heapUsageVector = SenMemoryTracker::heapUsage();
+	for (size_t heapIndex = 0; heapIndex < heapUsageVector.size(); heapIndex++) {
+		const HeapUsageStruct& heapUsage = heapUsageVector[heapIndex];
+		stream << "\t heap " << heapIndex << (heapUsage.deviceLocal ? " (device local):  " : " (host):  ")
+			<< heapUsage.usageBytes / megabyte << " / " << heapUsage.budgetBytes / megabyte << " MB used,  headroom "
+			<< heapUsage.headroomBytes() / megabyte << " MB,  tracked " << heapUsage.trackedBytes / megabyte
+			<< " MB (peak " << heapUsage.trackedPeakBytes / megabyte << " MB)\n";
+	}
+	for (int category = 0; category < MEMORY_CATEGORY_COUNT; category++) {
+		CategoryUsageStruct usage = categoryUsage(static_cast<MemoryCategory>(category));
+		if (0 == usage.peakBytes) continue;
+		stream << "\t " << categoryName(static_cast<MemoryCategory>(category)) << ":  " << usage.bytes / megabyte << " MB in "
+			<< usage.allocationsCount << " allocations,  peak " << usage.peakBytes / megabyte << " MB\n";
+	}
+	return stream.str();
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#ifndef __SenMemoryTracker__
+#define __SenMemoryTracker__
+
+#include "SLVK_AbstractGLFW.h"
+
+#include <mutex>
+#include <unordered_map>
+
+/*
+	Device memory accounting:  every VkDeviceMemory allocated through SLVK_AbstractGLFW::createResourceBuffer(),
+	createResourceImage() (or recorded explicitly) is tagged with a category and its heap, and released through
+	SLVK_AbstractGLFW::freeDeviceMemory().  Bytes and peaks are kept per category and per heap.
+	heapUsage() adds the live driver view from VK_EXT_memory_budget when the device enabled it:  budget is what the
+	process may use on that heap right now, usage covers every allocation of the process (not only tracked ones).
+	Without the extension budget falls back to the heap size and usage to the tracked bytes.
+	One tracker per process (the static helpers have no widget at hand), all functions are thread safe.
+*/
+class SenMemoryTracker
+{
+public:
+	enum MemoryCategory { MEMORY_CATEGORY_MESH, MEMORY_CATEGORY_TEXTURE, MEMORY_CATEGORY_STAGING, MEMORY_CATEGORY_UNIFORM,
+		MEMORY_CATEGORY_ATTACHMENT, MEMORY_CATEGORY_OTHER, MEMORY_CATEGORY_COUNT };
+
+	struct HeapUsageStruct {
+		VkDeviceSize					heapSize				= 0;
+		bool							deviceLocal				= false;
+		VkDeviceSize					budgetBytes				= 0;
+		VkDeviceSize					usageBytes				= 0;
+		VkDeviceSize					trackedBytes			= 0;
+		VkDeviceSize					trackedPeakBytes		= 0;
+
+		VkDeviceSize headroomBytes() const { return budgetBytes > usageBytes ? budgetBytes - usageBytes : 0; }
+	};
+	struct CategoryUsageStruct {
+		VkDeviceSize					bytes					= 0;
+		VkDeviceSize					peakBytes				= 0;
+		uint32_t						allocationsCount		= 0;
+	};
+
+	// After the logical device was created;  fetch_vkGetPhysicalDeviceMemoryProperties2 is null unless VK_EXT_memory_budget is enabled
+	static void initialize(const VkPhysicalDevice& physicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+		const PFN_vkVoidFunction& fetch_vkGetPhysicalDeviceMemoryProperties2);
+
+	static void recordAllocation(const VkDeviceMemory& deviceMemory, const VkDeviceSize& allocationSize,
+		const uint32_t& memoryTypeIndex, const MemoryCategory& category);
+	static void recordFree(const VkDeviceMemory& deviceMemory);
+
+	// Category guessed from how the resource is used, for allocations that were not tagged explicitly
+	static MemoryCategory categoryFromBufferUsage(const VkBufferUsageFlags& bufferUsageFlags, const VkMemoryPropertyFlags& memoryPropertyFlags);
+	static MemoryCategory categoryFromImageUsage(const VkImageUsageFlags& imageUsageFlags);
+
+	static std::vector<HeapUsageStruct> heapUsage();
+	// Smallest headroom among the device local heaps, what a streaming or caching system may still grow into
+	static VkDeviceSize deviceLocalHeadroom();
+	static CategoryUsageStruct categoryUsage(const MemoryCategory& category);
+	static bool memoryBudgetSupported();
+	static std::string report();
+
+private:
+	struct TrackedAllocationStruct {
+		VkDeviceSize					allocationSize			= 0;
+		uint32_t						heapIndex				= 0;
+		MemoryCategory					category				= MEMORY_CATEGORY_OTHER;
+	};
+	struct TrackerStateStruct {
+		std::mutex						trackerMutex;
+		VkPhysicalDevice				physicalDevice			= VK_NULL_HANDLE;
+		VkPhysicalDeviceMemoryProperties	gpuMemoryProperties{};
+		PFN_vkVoidFunction				fetch_vkGetPhysicalDeviceMemoryProperties2	= nullptr;
+		std::unordered_map<VkDeviceMemory, TrackedAllocationStruct>	trackedAllocationMap;
+		std::array<CategoryUsageStruct, MEMORY_CATEGORY_COUNT>		categoryUsageArray{};
+		std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>				heapTrackedBytesArray{};
+		std::array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>				heapTrackedPeakBytesArray{};
+	};
+	static TrackerStateStruct& trackerState();
+	static const char* categoryName(const MemoryCategory& category);
+};
+
+#endif // !__SenMemoryTracker__
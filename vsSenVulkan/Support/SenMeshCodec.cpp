@@ -0,0 +1,655 @@
+#include "SenMeshCodec.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#define SEN_MESH_CODEC_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SEN_MESH_CODEC_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define SEN_MESH_CODEC_NEON
+#include <arm_neon.h>
+#endif
+
+namespace {
+	const uint32_t	meshCodecMagic			= 0x31434D53;	// "SMC1"
+	const uint32_t	componentsCount			= 5;			// position xyz, texCoord uv
+	const uint32_t	streamsCount			= 7;			// the 5 components, triangle codes, index residuals
+	const uint32_t	triangleCodesStream		= 5;
+	const uint32_t	indexResidualsStream	= 6;
+	const uint32_t	lanesCount				= 8;
+	const uint32_t	blockValuesCount		= 256;			// lanesCount * 32 values per lane
+	const uint32_t	rowBytes				= lanesCount * sizeof(uint32_t);
+
+	static_assert(sizeof(VertexStruct) == componentsCount * sizeof(float), "VertexStruct is decoded as 5 tightly packed floats");
+
+	struct MeshCodecHeaderStruct {
+		uint32_t	magic;
+		uint32_t	verticesCount;
+		uint32_t	indicesCount;
+		uint32_t	indexResidualsCount;
+		uint32_t	positionBits;
+		uint32_t	texCoordBits;
+		float		componentOffset[componentsCount];	// value = offset + quantized * scale
+		float		componentScale[componentsCount];
+		uint32_t	streamOffset[streamsCount];			// from the start of the header, 16 byte aligned
+		uint32_t	streamBytes[streamsCount];
+	};
+
+	inline uint32_t zigzagEncode(const int32_t& value) {
+		return (static_cast<uint32_t>(value) << 1) ^ static_cast<uint32_t>(value >> 31);
+	}
+	inline uint32_t zigzagDecode(const uint32_t& value) {
+		return (value >> 1) ^ (0u - (value & 1));
+	}
+	inline uint32_t bitWidth(uint32_t value) {
+		uint32_t width = 0;
+		while (value) { width++; value >>= 1; }
+		return width;
+	}
+	inline size_t alignUp(const size_t& value, const size_t& alignment) {
+		return (value + alignment - 1) / alignment * alignment;
+	}
+
+	/****************************************************************************************************************************/
+	/**********   Packed stream:  one bit width byte per block (padded to 4 bytes), then each block's rows of 8 words   *********/
+	/**********   Row k holds word k of every lane;  value j of lane l sits at bits [j * width, (j + 1) * width) of lane l  ******/
+	/****************************************************************************************************************************/
+	void packStream(std::vector<uint32_t> valueVector, std::vector<uint8_t>& streamToPopulate) {
+		const size_t blocksCount = (valueVector.size() + blockValuesCount - 1) / blockValuesCount;
+		valueVector.resize(blocksCount * blockValuesCount, 0);
+
+		std::vector<uint8_t> bitWidthVector(blocksCount);
+		std::vector<uint32_t> rowWordVector;
+		for (size_t block = 0; block < blocksCount; block++) {
+			const uint32_t* blockValues = valueVector.data() + block * blockValuesCount;
+			uint32_t widestValue = 0;
+			for (uint32_t i = 0; i < blockValuesCount; i++)
+				widestValue |= blockValues[i];
+			const uint32_t width = bitWidth(widestValue);
+			bitWidthVector[block] = static_cast<uint8_t>(width);
+			if (0 == width) continue;
+
+			const size_t firstWord = rowWordVector.size();
+			rowWordVector.resize(firstWord + lanesCount * width, 0);
+			uint32_t* rowWords = rowWordVector.data() + firstWord;
+			for (uint32_t lane = 0; lane < lanesCount; lane++) {
+				for (uint32_t j = 0; j < blockValuesCount / lanesCount; j++) {
+					const uint32_t value		= blockValues[j * lanesCount + lane];
+					const uint32_t bitPosition	= j * width;
+					const uint32_t word			= bitPosition >> 5;
+					const uint32_t shift		= bitPosition & 31;
+					rowWords[word * lanesCount + lane] |= value << shift;
+					if (shift + width > 32)
+						rowWords[(word + 1) * lanesCount + lane] |= value >> (32 - shift);
+				}
+			}
+		}
+
+		const size_t bitWidthsBytes = alignUp(blocksCount, sizeof(uint32_t));
+		streamToPopulate.assign(bitWidthsBytes + rowWordVector.size() * sizeof(uint32_t), 0);
+		if (blocksCount > 0)
+			memcpy(streamToPopulate.data(), bitWidthVector.data(), blocksCount);
+		if (!rowWordVector.empty())
+			memcpy(streamToPopulate.data() + bitWidthsBytes, rowWordVector.data(), rowWordVector.size() * sizeof(uint32_t));
+	}
+
+	// Validates the whole stream up front, so the decode loops need no bounds checks
+	void openPackedStream(const uint8_t* stream, const size_t& streamBytes, const size_t& valuesCount,
+		const uint8_t*& bitWidthsToPopulate, const uint8_t*& rowWordsToPopulate) {
+		const size_t blocksCount	= (valuesCount + blockValuesCount - 1) / blockValuesCount;
+		const size_t bitWidthsBytes	= alignUp(blocksCount, sizeof(uint32_t));
+		if (bitWidthsBytes > streamBytes)
+			throw std::runtime_error("Truncated mesh stream !!!");
+
+		size_t rowWordsBytes = 0;
+		for (size_t block = 0; block < blocksCount; block++) {
+			if (stream[block] > 32)
+				throw std::runtime_error("Malformed mesh stream bit width !!!");
+			rowWordsBytes += stream[block] * rowBytes;
+		}
+		if (bitWidthsBytes + rowWordsBytes > streamBytes)
+			throw std::runtime_error("Truncated mesh stream !!!");
+
+		bitWidthsToPopulate	= stream;
+		rowWordsToPopulate	= stream + bitWidthsBytes;
+	}
+
+	/****************************************************************************************************************************/
+	/**********   8 lanes of uint32_t:  one AVX2 register, two SSE2 / NEON registers, or a plain array   ************************/
+	/****************************************************************************************************************************/
+	struct ScalarLanes {
+		struct Vector { uint32_t lane[lanesCount]; };
+
+		static Vector zero() { Vector vector; for (auto& lane : vector.lane) lane = 0; return vector; }
+		static Vector load(const uint8_t* rowWords) { Vector vector; memcpy(vector.lane, rowWords, rowBytes); return vector; }
+		static Vector shiftRight(Vector vector, const uint32_t& shift) { for (auto& lane : vector.lane) lane >>= shift; return vector; }
+		static Vector shiftLeft(Vector vector, const uint32_t& shift) { for (auto& lane : vector.lane) lane <<= shift; return vector; }
+		static Vector bitOr(Vector vector, const Vector& other) {
+			for (uint32_t l = 0; l < lanesCount; l++) vector.lane[l] |= other.lane[l];
+			return vector;
+		}
+		static Vector bitAnd(Vector vector, const uint32_t& mask) { for (auto& lane : vector.lane) lane &= mask; return vector; }
+		static Vector add(Vector vector, const Vector& other) {
+			for (uint32_t l = 0; l < lanesCount; l++) vector.lane[l] += other.lane[l];
+			return vector;
+		}
+		static Vector zigzag(Vector vector) { for (auto& lane : vector.lane) lane = zigzagDecode(lane); return vector; }
+		static void store(uint32_t* dst, const Vector& vector) { memcpy(dst, vector.lane, rowBytes); }
+		static void storeDequantized(float* dst, const Vector& vector, const float& offset, const float& scale) {
+			for (uint32_t l = 0; l < lanesCount; l++)
+				dst[l] = offset + static_cast<float>(static_cast<int32_t>(vector.lane[l])) * scale;
+		}
+	};
+
+#if defined(SEN_MESH_CODEC_AVX2)
+	struct SimdLanes {
+		typedef __m256i Vector;
+
+		static Vector zero() { return _mm256_setzero_si256(); }
+		static Vector load(const uint8_t* rowWords) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rowWords)); }
+		static Vector shiftRight(const Vector& vector, const uint32_t& shift) { return _mm256_srl_epi32(vector, _mm_cvtsi32_si128(static_cast<int>(shift))); }
+		static Vector shiftLeft(const Vector& vector, const uint32_t& shift) { return _mm256_sll_epi32(vector, _mm_cvtsi32_si128(static_cast<int>(shift))); }
+		static Vector bitOr(const Vector& vector, const Vector& other) { return _mm256_or_si256(vector, other); }
+		static Vector bitAnd(const Vector& vector, const uint32_t& mask) { return _mm256_and_si256(vector, _mm256_set1_epi32(static_cast<int>(mask))); }
+		static Vector add(const Vector& vector, const Vector& other) { return _mm256_add_epi32(vector, other); }
+		static Vector zigzag(const Vector& vector) {
+			const __m256i signMask = _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(vector, _mm256_set1_epi32(1)));
+			return _mm256_xor_si256(_mm256_srli_epi32(vector, 1), signMask);
+		}
+		static void store(uint32_t* dst, const Vector& vector) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), vector); }
+		static void storeDequantized(float* dst, const Vector& vector, const float& offset, const float& scale) {
+			_mm256_storeu_ps(dst, _mm256_add_ps(_mm256_set1_ps(offset), _mm256_mul_ps(_mm256_cvtepi32_ps(vector), _mm256_set1_ps(scale))));
+		}
+	};
+	const char* const simdLanesName = "AVX2";
+#elif defined(SEN_MESH_CODEC_SSE2)
+	struct SimdLanes {
+		struct Vector { __m128i low, high; };
+
+		static Vector zero() { return { _mm_setzero_si128(), _mm_setzero_si128() }; }
+		static Vector load(const uint8_t* rowWords) {
+			return { _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowWords)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(rowWords + 16)) };
+		}
+		static Vector shiftRight(const Vector& vector, const uint32_t& shift) {
+			const __m128i count = _mm_cvtsi32_si128(static_cast<int>(shift));
+			return { _mm_srl_epi32(vector.low, count), _mm_srl_epi32(vector.high, count) };
+		}
+		static Vector shiftLeft(const Vector& vector, const uint32_t& shift) {
+			const __m128i count = _mm_cvtsi32_si128(static_cast<int>(shift));
+			return { _mm_sll_epi32(vector.low, count), _mm_sll_epi32(vector.high, count) };
+		}
+		static Vector bitOr(const Vector& vector, const Vector& other) {
+			return { _mm_or_si128(vector.low, other.low), _mm_or_si128(vector.high, other.high) };
+		}
+		static Vector bitAnd(const Vector& vector, const uint32_t& mask) {
+			const __m128i maskLanes = _mm_set1_epi32(static_cast<int>(mask));
+			return { _mm_and_si128(vector.low, maskLanes), _mm_and_si128(vector.high, maskLanes) };
+		}
+		static Vector add(const Vector& vector, const Vector& other) {
+			return { _mm_add_epi32(vector.low, other.low), _mm_add_epi32(vector.high, other.high) };
+		}
+		static __m128i zigzag4(const __m128i& lanes) {
+			const __m128i signMask = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(lanes, _mm_set1_epi32(1)));
+			return _mm_xor_si128(_mm_srli_epi32(lanes, 1), signMask);
+		}
+		static Vector zigzag(const Vector& vector) { return { zigzag4(vector.low), zigzag4(vector.high) }; }
+		static void store(uint32_t* dst, const Vector& vector) {
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), vector.low);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 4), vector.high);
+		}
+		static void storeDequantized(float* dst, const Vector& vector, const float& offset, const float& scale) {
+			const __m128 offsetLanes = _mm_set1_ps(offset), scaleLanes = _mm_set1_ps(scale);
+			_mm_storeu_ps(dst,		_mm_add_ps(offsetLanes, _mm_mul_ps(_mm_cvtepi32_ps(vector.low), scaleLanes)));
+			_mm_storeu_ps(dst + 4,	_mm_add_ps(offsetLanes, _mm_mul_ps(_mm_cvtepi32_ps(vector.high), scaleLanes)));
+		}
+	};
+	const char* const simdLanesName = "SSE2";
+#elif defined(SEN_MESH_CODEC_NEON)
+	struct SimdLanes {
+		struct Vector { uint32x4_t low, high; };
+
+		static Vector zero() { return { vdupq_n_u32(0), vdupq_n_u32(0) }; }
+		static Vector load(const uint8_t* rowWords) {
+			return { vreinterpretq_u32_u8(vld1q_u8(rowWords)), vreinterpretq_u32_u8(vld1q_u8(rowWords + 16)) };
+		}
+		// vshlq_u32 shifts right for negative counts
+		static Vector shiftRight(const Vector& vector, const uint32_t& shift) {
+			const int32x4_t count = vdupq_n_s32(-static_cast<int32_t>(shift));
+			return { vshlq_u32(vector.low, count), vshlq_u32(vector.high, count) };
+		}
+		static Vector shiftLeft(const Vector& vector, const uint32_t& shift) {
+			const int32x4_t count = vdupq_n_s32(static_cast<int32_t>(shift));
+			return { vshlq_u32(vector.low, count), vshlq_u32(vector.high, count) };
+		}
+		static Vector bitOr(const Vector& vector, const Vector& other) {
+			return { vorrq_u32(vector.low, other.low), vorrq_u32(vector.high, other.high) };
+		}
+		static Vector bitAnd(const Vector& vector, const uint32_t& mask) {
+			const uint32x4_t maskLanes = vdupq_n_u32(mask);
+			return { vandq_u32(vector.low, maskLanes), vandq_u32(vector.high, maskLanes) };
+		}
+		static Vector add(const Vector& vector, const Vector& other) {
+			return { vaddq_u32(vector.low, other.low), vaddq_u32(vector.high, other.high) };
+		}
+		static uint32x4_t zigzag4(const uint32x4_t& lanes) {
+			const uint32x4_t signMask = vreinterpretq_u32_s32(vnegq_s32(vreinterpretq_s32_u32(vandq_u32(lanes, vdupq_n_u32(1)))));
+			return veorq_u32(vshrq_n_u32(lanes, 1), signMask);
+		}
+		static Vector zigzag(const Vector& vector) { return { zigzag4(vector.low), zigzag4(vector.high) }; }
+		static void store(uint32_t* dst, const Vector& vector) {
+			vst1q_u32(dst, vector.low);
+			vst1q_u32(dst + 4, vector.high);
+		}
+		static void storeDequantized(float* dst, const Vector& vector, const float& offset, const float& scale) {
+			const float32x4_t offsetLanes = vdupq_n_f32(offset), scaleLanes = vdupq_n_f32(scale);
+			vst1q_f32(dst,		vaddq_f32(offsetLanes, vmulq_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(vector.low)), scaleLanes)));
+			vst1q_f32(dst + 4,	vaddq_f32(offsetLanes, vmulq_f32(vcvtq_f32_s32(vreinterpretq_s32_u32(vector.high)), scaleLanes)));
+		}
+	};
+	const char* const simdLanesName = "NEON";
+#else
+	typedef ScalarLanes SimdLanes;
+	const char* const simdLanesName = "scalar";
+#endif
+
+	// Values j * 8 .. j * 8 + 7 of a block, one per lane;  rows are rowBytes apart, the shifts are the same for every lane
+	template<typename Lanes>
+	inline typename Lanes::Vector extractValues(const uint8_t* rowWords, const uint32_t& width, const uint32_t& mask, const uint32_t& j) {
+		const uint32_t bitPosition	= j * width;
+		const uint32_t word			= bitPosition >> 5;
+		const uint32_t shift		= bitPosition & 31;
+		typename Lanes::Vector values = Lanes::shiftRight(Lanes::load(rowWords + word * rowBytes), shift);
+		if (shift + width > 32)
+			values = Lanes::bitOr(values, Lanes::shiftLeft(Lanes::load(rowWords + (word + 1) * rowBytes), 32 - shift));
+		return Lanes::bitAnd(values, mask);
+	}
+
+	template<typename Lanes>
+	void unpackBlock(const uint8_t* rowWords, const uint32_t& width, uint32_t* valuesToPopulate) {
+		if (0 == width) {
+			memset(valuesToPopulate, 0, blockValuesCount * sizeof(uint32_t));
+			return;
+		}
+		const uint32_t mask = (width >= 32) ? ~0u : ((1u << width) - 1);
+		for (uint32_t j = 0; j < blockValuesCount / lanesCount; j++)
+			Lanes::store(valuesToPopulate + j * lanesCount, extractValues<Lanes>(rowWords, width, mask, j));
+	}
+
+	// Unpack, undo zigzag, add to the lane's running sum (the stride-8 deltas) and dequantize, 8 values at a time
+	template<typename Lanes>
+	void decodeComponentBlock(const uint8_t* rowWords, const uint32_t& width, typename Lanes::Vector& accumulator,
+		const float& offset, const float& scale, float* floatsToPopulate) {
+		const uint32_t mask = (width >= 32) ? ~0u : ((1u << width) - 1);
+		for (uint32_t j = 0; j < blockValuesCount / lanesCount; j++) {
+			if (0 != width)
+				accumulator = Lanes::add(accumulator, Lanes::zigzag(extractValues<Lanes>(rowWords, width, mask, j)));
+			Lanes::storeDequantized(floatsToPopulate + j * lanesCount, accumulator, offset, scale);
+		}
+	}
+
+	template<typename Lanes>
+	void decodeVertices(const MeshCodecHeaderStruct& header, const uint8_t* encodedMesh, VertexStruct* dstVertices) {
+		const uint8_t* bitWidths[componentsCount];
+		const uint8_t* rowWords[componentsCount];
+		typename Lanes::Vector accumulator[componentsCount];
+		for (uint32_t component = 0; component < componentsCount; component++) {
+			openPackedStream(encodedMesh + header.streamOffset[component], header.streamBytes[component], header.verticesCount,
+				bitWidths[component], rowWords[component]);
+			accumulator[component] = Lanes::zero();
+		}
+
+		// One block of every component, then interleaved into VertexStruct, written front to back
+		alignas(32) float blockFloats[componentsCount][blockValuesCount];
+		float* dstFloats = reinterpret_cast<float*>(dstVertices);
+		const size_t blocksCount = (header.verticesCount + blockValuesCount - 1) / blockValuesCount;
+		for (size_t block = 0; block < blocksCount; block++) {
+			for (uint32_t component = 0; component < componentsCount; component++) {
+				const uint32_t width = bitWidths[component][block];
+				decodeComponentBlock<Lanes>(rowWords[component], width, accumulator[component],
+					header.componentOffset[component], header.componentScale[component], blockFloats[component]);
+				rowWords[component] += width * rowBytes;
+			}
+			const size_t blockVerticesCount = (std::min)(static_cast<size_t>(blockValuesCount), header.verticesCount - block * blockValuesCount);
+			for (size_t vertex = 0; vertex < blockVerticesCount; vertex++) {
+				dstFloats[0] = blockFloats[0][vertex];
+				dstFloats[1] = blockFloats[1][vertex];
+				dstFloats[2] = blockFloats[2][vertex];
+				dstFloats[3] = blockFloats[3][vertex];
+				dstFloats[4] = blockFloats[4][vertex];
+				dstFloats += componentsCount;
+			}
+		}
+	}
+
+	template<typename Lanes>
+	void decodeIndices(const MeshCodecHeaderStruct& header, const uint8_t* encodedMesh, uint32_t* dstIndices) {
+		const size_t trianglesCount = header.indicesCount / 3;
+		if (header.streamBytes[triangleCodesStream] < (trianglesCount + 3) / 4)
+			throw std::runtime_error("Truncated mesh triangle codes !!!");
+		const uint8_t* triangleCodes = encodedMesh + header.streamOffset[triangleCodesStream];
+
+		const uint8_t* bitWidths;
+		const uint8_t* rowWords;
+		openPackedStream(encodedMesh + header.streamOffset[indexResidualsStream], header.streamBytes[indexResidualsStream],
+			header.indexResidualsCount, bitWidths, rowWords);
+		const size_t blocksCount = (header.indexResidualsCount + blockValuesCount - 1) / blockValuesCount;
+		std::vector<uint32_t> residualVector(blocksCount * blockValuesCount);
+		for (size_t block = 0; block < blocksCount; block++) {
+			unpackBlock<Lanes>(rowWords, bitWidths[block], residualVector.data() + block * blockValuesCount);
+			rowWords += bitWidths[block] * rowBytes;
+		}
+
+		/****************************************************************************************************************************/
+		/**********   Sequential by nature:  each triangle starts from the edge it shares with the previous one   *******************/
+		/****************************************************************************************************************************/
+		uint32_t previousTriangle[3]	= { 0, 0, 0 };
+		uint32_t nextNewIndex			= 0;	// one past the largest index so far
+		size_t residualCursor			= 0;
+		auto takeIndex = [&]() {
+			if (residualCursor >= header.indexResidualsCount)
+				throw std::runtime_error("Truncated mesh index residuals !!!");
+			const uint32_t index = nextNewIndex - zigzagDecode(residualVector[residualCursor++]);
+			if (index >= header.verticesCount)
+				throw std::runtime_error("Mesh index out of range !!!");
+			nextNewIndex = (std::max)(nextNewIndex, index + 1);
+			return index;
+		};
+		for (size_t triangle = 0; triangle < trianglesCount; triangle++) {
+			const uint32_t sharedEdge = (triangleCodes[triangle >> 2] >> ((triangle & 3) * 2)) & 3;
+			uint32_t currentTriangle[3];
+			if (sharedEdge < 3) {
+				currentTriangle[0] = previousTriangle[(sharedEdge + 1) % 3];
+				currentTriangle[1] = previousTriangle[sharedEdge];
+				currentTriangle[2] = takeIndex();
+			}else {
+				currentTriangle[0] = takeIndex();
+				currentTriangle[1] = takeIndex();
+				currentTriangle[2] = takeIndex();
+			}
+			dstIndices[0] = currentTriangle[0];
+			dstIndices[1] = currentTriangle[1];
+			dstIndices[2] = currentTriangle[2];
+			dstIndices += 3;
+			memcpy(previousTriangle, currentTriangle, sizeof(previousTriangle));
+		}
+	}
+
+	void readHeader(const uint8_t* encodedMesh, const size_t& encodedMeshBytes, MeshCodecHeaderStruct& headerToPopulate) {
+		if (nullptr == encodedMesh || encodedMeshBytes < sizeof(MeshCodecHeaderStruct))
+			throw std::runtime_error("Truncated mesh header !!!");
+		memcpy(&headerToPopulate, encodedMesh, sizeof(MeshCodecHeaderStruct));
+		if (meshCodecMagic != headerToPopulate.magic)
+			throw std::runtime_error("Not a .smc mesh !!!");
+		if (0 != headerToPopulate.indicesCount % 3)
+			throw std::runtime_error("Malformed mesh header, indices are not whole triangles !!!");
+		for (uint32_t stream = 0; stream < streamsCount; stream++) {
+			if ((size_t)headerToPopulate.streamOffset[stream] + headerToPopulate.streamBytes[stream] > encodedMeshBytes)
+				throw std::runtime_error("Truncated mesh stream !!!");
+		}
+	}
+
+	size_t diskFileBytes(const char* const diskAddress) {
+		std::ifstream diskFile(diskAddress, std::ios::ate | std::ios::binary);
+		return diskFile.is_open() ? static_cast<size_t>(diskFile.tellg()) : 0;
+	}
+
+	// Best of decodeRunsCount runs, in GB/s of decoded VertexStruct + index bytes
+	double measureDecodeThroughput(const std::vector<uint8_t>& encodedMesh, std::vector<VertexStruct>& dstVertexStructVector,
+		std::vector<uint32_t>& dstIndexVector, const bool& useSimd) {
+		const int decodeRunsCount = 10;
+		double bestSeconds = 0.0;
+		for (int run = 0; run < decodeRunsCount; run++) {
+			auto decodeStartTime = std::chrono::high_resolution_clock::now();
+			smcd::decodeMesh(encodedMesh.data(), encodedMesh.size(), dstVertexStructVector.data(), dstIndexVector.data(), useSimd);
+			double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - decodeStartTime).count();
+			if (0 == run || seconds < bestSeconds) bestSeconds = seconds;
+		}
+		const double decodedBytes = static_cast<double>(smcd::rawMeshBytes(dstVertexStructVector.size(), dstIndexVector.size()));
+		return bestSeconds > 0.0 ? decodedBytes / bestSeconds / 1.0e9 : 0.0;
+	}
+}
+
+namespace smcd
+{
+	void encodeMesh(const std::vector<VertexStruct>& vertexStructVector, const std::vector<uint32_t>& indexVector,
+		std::vector<uint8_t>& encodedMeshToPopulate, const uint32_t& positionBits, const uint32_t& texCoordBits) {
+		if (0 != indexVector.size() % 3)
+			throw std::runtime_error("Mesh indices are not whole triangles !!!");
+		if (positionBits < 1 || positionBits > 24 || texCoordBits < 1 || texCoordBits > 24)
+			throw std::runtime_error("Mesh quantization bits have to be within [1, 24] !!!");
+
+		MeshCodecHeaderStruct header{};
+		header.magic			= meshCodecMagic;
+		header.verticesCount	= static_cast<uint32_t>(vertexStructVector.size());
+		header.indicesCount		= static_cast<uint32_t>(indexVector.size());
+		header.positionBits		= positionBits;
+		header.texCoordBits		= texCoordBits;
+
+		std::vector<uint8_t> streamVector[streamsCount];
+
+		/****************************************************************************************************************************/
+		/**********   Vertices:  quantize each component over its range, stride-8 deltas, zigzag, bit pack   ************************/
+		/****************************************************************************************************************************/
+		std::vector<uint32_t> quantizedVector(vertexStructVector.size());
+		std::vector<uint32_t> deltaVector(vertexStructVector.size());
+		for (uint32_t component = 0; component < componentsCount; component++) {
+			auto componentValue = [&](const size_t& vertex) {
+				return component < 3 ? vertexStructVector[vertex].position[component] : vertexStructVector[vertex].texCoord[component - 3];
+			};
+			float minValue = 0.0f, maxValue = 0.0f;
+			for (size_t vertex = 0; vertex < vertexStructVector.size(); vertex++) {
+				const float value = componentValue(vertex);
+				if (0 == vertex || value < minValue) minValue = value;
+				if (0 == vertex || value > maxValue) maxValue = value;
+			}
+			const uint32_t bits			= component < 3 ? positionBits : texCoordBits;
+			const uint32_t maxQuantized	= (1u << bits) - 1;
+			const float scale			= maxValue > minValue ? (maxValue - minValue) / maxQuantized : 0.0f;
+			header.componentOffset[component]	= minValue;
+			header.componentScale[component]	= scale;
+
+			for (size_t vertex = 0; vertex < vertexStructVector.size(); vertex++) {
+				const double quantized = scale > 0.0f ? std::floor((componentValue(vertex) - minValue) / (double)scale + 0.5) : 0.0;
+				quantizedVector[vertex] = static_cast<uint32_t>((std::min)((std::max)(quantized, 0.0), (double)maxQuantized));
+			}
+			for (size_t vertex = 0; vertex < vertexStructVector.size(); vertex++) {
+				const uint32_t laneBase = vertex >= lanesCount ? quantizedVector[vertex - lanesCount] : 0;
+				deltaVector[vertex] = zigzagEncode(static_cast<int32_t>(quantizedVector[vertex] - laneBase));
+			}
+			packStream(deltaVector, streamVector[component]);
+		}
+
+		/****************************************************************************************************************************/
+		/**********   Indices:  triangles continuing from an edge of the previous one store their third index only   ****************/
+		/****************************************************************************************************************************/
+		const size_t trianglesCount = indexVector.size() / 3;
+		std::vector<uint8_t>& triangleCodeVector = streamVector[triangleCodesStream];
+		triangleCodeVector.assign((trianglesCount + 3) / 4, 0);
+		std::vector<uint32_t> residualVector;
+		residualVector.reserve(indexVector.size());
+
+		uint32_t previousTriangle[3]	= { 0, 0, 0 };
+		uint32_t nextNewIndex			= 0;
+		auto putIndex = [&](const uint32_t& index) {
+			residualVector.push_back(zigzagEncode(static_cast<int32_t>(nextNewIndex - index)));
+			nextNewIndex = (std::max)(nextNewIndex, index + 1);
+		};
+		for (size_t triangle = 0; triangle < trianglesCount; triangle++) {
+			const uint32_t* triangleIndices = indexVector.data() + 3 * triangle;
+			uint32_t sharedEdge = 3;
+			uint32_t currentTriangle[3] = { triangleIndices[0], triangleIndices[1], triangleIndices[2] };
+
+			// Previous edge (x, y) is shared when this triangle runs along it as (y, x), rotate that pair to the front
+			for (uint32_t edge = 0; triangle > 0 && edge < 3 && sharedEdge == 3; edge++) {
+				const uint32_t edgeStart = previousTriangle[edge], edgeEnd = previousTriangle[(edge + 1) % 3];
+				for (uint32_t rotation = 0; rotation < 3; rotation++) {
+					if (triangleIndices[rotation] == edgeEnd && triangleIndices[(rotation + 1) % 3] == edgeStart) {
+						sharedEdge = edge;
+						currentTriangle[0] = triangleIndices[rotation];
+						currentTriangle[1] = triangleIndices[(rotation + 1) % 3];
+						currentTriangle[2] = triangleIndices[(rotation + 2) % 3];
+						break;
+					}
+				}
+			}
+			triangleCodeVector[triangle >> 2] |= static_cast<uint8_t>(sharedEdge << ((triangle & 3) * 2));
+			if (sharedEdge < 3) {
+				putIndex(currentTriangle[2]);
+			}else {
+				putIndex(currentTriangle[0]);
+				putIndex(currentTriangle[1]);
+				putIndex(currentTriangle[2]);
+			}
+			memcpy(previousTriangle, currentTriangle, sizeof(previousTriangle));
+		}
+		header.indexResidualsCount = static_cast<uint32_t>(residualVector.size());
+		packStream(residualVector, streamVector[indexResidualsStream]);
+
+		/****************************************************************************************************************************/
+		/**********   Header, then the streams at 16 byte aligned offsets   *********************************************************/
+		/****************************************************************************************************************************/
+		size_t encodedBytes = alignUp(sizeof(MeshCodecHeaderStruct), 16);
+		for (uint32_t stream = 0; stream < streamsCount; stream++) {
+			header.streamOffset[stream]	= static_cast<uint32_t>(encodedBytes);
+			header.streamBytes[stream]	= static_cast<uint32_t>(streamVector[stream].size());
+			encodedBytes = alignUp(encodedBytes + streamVector[stream].size(), 16);
+		}
+		encodedMeshToPopulate.assign(encodedBytes, 0);
+		memcpy(encodedMeshToPopulate.data(), &header, sizeof(header));
+		for (uint32_t stream = 0; stream < streamsCount; stream++) {
+			if (!streamVector[stream].empty())
+				memcpy(encodedMeshToPopulate.data() + header.streamOffset[stream], streamVector[stream].data(), streamVector[stream].size());
+		}
+	}// encodeMesh()
+
+	void readMeshHeader(const uint8_t* encodedMesh, const size_t& encodedMeshBytes, uint32_t& verticesCount, uint32_t& indicesCount) {
+		MeshCodecHeaderStruct header;
+		readHeader(encodedMesh, encodedMeshBytes, header);
+		verticesCount	= header.verticesCount;
+		indicesCount	= header.indicesCount;
+	}// readMeshHeader()
+
+	void decodeMesh(const uint8_t* encodedMesh, const size_t& encodedMeshBytes, VertexStruct* dstVertices, uint32_t* dstIndices,
+		const bool& useSimd) {
+		MeshCodecHeaderStruct header;
+		readHeader(encodedMesh, encodedMeshBytes, header);
+
+		if (useSimd) {
+			decodeVertices<SimdLanes>(header, encodedMesh, dstVertices);
+			decodeIndices<SimdLanes>(header, encodedMesh, dstIndices);
+		}else {
+			decodeVertices<ScalarLanes>(header, encodedMesh, dstVertices);
+			decodeIndices<ScalarLanes>(header, encodedMesh, dstIndices);
+		}
+	}// decodeMesh()
+
+	const char* simdPathName() {
+		return simdLanesName;
+	}
+
+	bool isCompressedMeshAddress(const std::string& meshDiskAddress) {
+		const std::string extension(".smc");
+		return meshDiskAddress.size() >= extension.size()
+			&& 0 == meshDiskAddress.compare(meshDiskAddress.size() - extension.size(), extension.size(), extension);
+	}
+
+	void readMeshFile(const char* const smcDiskAddress, std::vector<uint8_t>& encodedMeshToPopulate) {
+		std::ifstream meshFile(smcDiskAddress, std::ios::ate | std::ios::binary);
+		if (!meshFile.is_open())
+			throw std::runtime_error(std::string("failed to open file ") + smcDiskAddress);
+
+		encodedMeshToPopulate.resize(static_cast<size_t>(meshFile.tellg()));
+		meshFile.seekg(0);
+		meshFile.read(reinterpret_cast<char*>(encodedMeshToPopulate.data()), encodedMeshToPopulate.size());
+	}// readMeshFile()
+
+	void loadMeshFile(const char* const smcDiskAddress,
+		std::vector<VertexStruct>& vertexStructVectorToPopulate, std::vector<uint32_t>& indexVectorToPopulate) {
+		std::vector<uint8_t> encodedMesh;
+		readMeshFile(smcDiskAddress, encodedMesh);
+
+		uint32_t verticesCount = 0, indicesCount = 0;
+		readMeshHeader(encodedMesh.data(), encodedMesh.size(), verticesCount, indicesCount);
+		vertexStructVectorToPopulate.resize(verticesCount);
+		indexVectorToPopulate.resize(indicesCount);
+		decodeMesh(encodedMesh.data(), encodedMesh.size(), vertexStructVectorToPopulate.data(), indexVectorToPopulate.data());
+	}// loadMeshFile()
+
+	void compressObjFile(const char* const objDiskAddress, const char* const smcDiskAddress,
+		const uint32_t& positionBits, const uint32_t& texCoordBits) {
+		std::vector<VertexStruct> vertexStructVector;
+		std::vector<uint32_t> indexVector;
+		auto objLoadStartTime = std::chrono::high_resolution_clock::now();
+		stobjl::populateVertexIndexVector(objDiskAddress, vertexStructVector, indexVector);
+		auto objLoadEndTime = std::chrono::high_resolution_clock::now();
+
+		std::vector<uint8_t> encodedMesh;
+		encodeMesh(vertexStructVector, indexVector, encodedMesh, positionBits, texCoordBits);
+		auto encodeEndTime = std::chrono::high_resolution_clock::now();
+
+		std::ofstream meshFile(smcDiskAddress, std::ios::binary | std::ios::trunc);
+		if (!meshFile.is_open())
+			throw std::runtime_error(std::string("failed to write file ") + smcDiskAddress);
+		meshFile.write(reinterpret_cast<const char*>(encodedMesh.data()), encodedMesh.size());
+		meshFile.close();
+
+		/****************************************************************************************************************************/
+		/**********   Round trip:  quantization error, and every triangle back as the same triangle (maybe rotated)   ***************/
+		/****************************************************************************************************************************/
+		std::vector<VertexStruct> decodedVertexStructVector(vertexStructVector.size());
+		std::vector<uint32_t> decodedIndexVector(indexVector.size());
+		decodeMesh(encodedMesh.data(), encodedMesh.size(), decodedVertexStructVector.data(), decodedIndexVector.data());
+
+		float maxPositionError = 0.0f, maxTexCoordError = 0.0f;
+		for (size_t vertex = 0; vertex < vertexStructVector.size(); vertex++) {
+			for (int axis = 0; axis < 3; axis++)
+				maxPositionError = (std::max)(maxPositionError,
+					std::fabs(vertexStructVector[vertex].position[axis] - decodedVertexStructVector[vertex].position[axis]));
+			for (int axis = 0; axis < 2; axis++)
+				maxTexCoordError = (std::max)(maxTexCoordError,
+					std::fabs(vertexStructVector[vertex].texCoord[axis] - decodedVertexStructVector[vertex].texCoord[axis]));
+		}
+		for (size_t first = 0; first < indexVector.size(); first += 3) {
+			bool sameTriangle = false;
+			for (size_t rotation = 0; rotation < 3 && !sameTriangle; rotation++) {
+				sameTriangle = decodedIndexVector[first] == indexVector[first + rotation]
+					&& decodedIndexVector[first + 1] == indexVector[first + (rotation + 1) % 3]
+					&& decodedIndexVector[first + 2] == indexVector[first + (rotation + 2) % 3];
+			}
+			if (!sameTriangle)
+				throw std::runtime_error("Mesh codec round trip changed triangle " + std::to_string(first / 3) + " !!!");
+		}
+
+		const double scalarGigabytesPerSecond	= measureDecodeThroughput(encodedMesh, decodedVertexStructVector, decodedIndexVector, false);
+		const double simdGigabytesPerSecond		= measureDecodeThroughput(encodedMesh, decodedVertexStructVector, decodedIndexVector, true);
+
+		const size_t objBytes = diskFileBytes(objDiskAddress);
+		const size_t rawBytes = rawMeshBytes(vertexStructVector.size(), indexVector.size());
+		std::ostringstream stream;
+		stream << "Compressed " << objDiskAddress << " into " << smcDiskAddress << "\n"
+			<< "\t " << vertexStructVector.size() << " vertices, " << indexVector.size() / 3 << " triangles,  "
+			<< positionBits << " bit positions, " << texCoordBits << " bit texCoords\n"
+			<< "\t OBJ text:    " << objBytes / 1024 << " KB,  parsed in "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(objLoadEndTime - objLoadStartTime).count() << " ms\n"
+			<< "\t raw binary:  " << rawBytes / 1024 << " KB\n"
+			<< "\t .smc:        " << encodedMesh.size() / 1024 << " KB,  encoded in "
+			<< std::chrono::duration_cast<std::chrono::milliseconds>(encodeEndTime - objLoadEndTime).count() << " ms\n"
+			<< "\t ratio:       " << (double)objBytes / encodedMesh.size() << " : 1 against OBJ,  "
+			<< (double)rawBytes / encodedMesh.size() << " : 1 against raw binary\n"
+			<< "\t max error:   " << maxPositionError << " position,  " << maxTexCoordError << " texCoord\n"
+			<< "\t decode:      " << scalarGigabytesPerSecond << " GB/s scalar,  " << simdGigabytesPerSecond << " GB/s "
+			<< simdPathName() << "  (decoded bytes, best of 10)\n";
+		std::cout << stream.str();
+	}// compressObjFile()
+
+} //namespace smcd
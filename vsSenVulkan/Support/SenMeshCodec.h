@@ -0,0 +1,57 @@
+#pragma once
+
+#ifndef __SenMeshCodec__
+#define __SenMeshCodec__
+
+#include "SenTinyObjLoader.h"
+
+#include <string>
+
+/*
+	Compressed mesh files (.smc), much smaller than OBJ text or a raw VertexStruct + uint32_t dump, decoded fast
+	enough to write straight into mapped staging memory.
+	-	Vertices:  each of the 5 VertexStruct components is quantized over its range (positionBits / texCoordBits),
+		then stored as its own stream of deltas to the vertex 8 places earlier, zigzag coded and bit packed in blocks
+		of 256 values, one bit width per block.  A block is 8 lanes of 32 values packed "vertically", lane l holding
+		values l, l + 8, l + 16 ...:  one SIMD register of 8 (AVX2) or two of 4 (SSE2, NEON) unpacks 8 values with
+		uniform shifts, and the running sums of the stride-8 deltas are plain lane-wise adds.
+	-	Indices:  a 2 bit code per triangle says which edge of the previous triangle it shares (in strip order most
+		of them do), so only its third index is stored;  3 is "no shared edge", all three are stored.  Stored indices
+		are zigzag coded distances to the next index never used yet (mostly 0), bit packed like the vertex streams.
+		A triangle may come back rotated (same winding, same order of triangles).
+	The SIMD path is chosen at compile time (AVX2, else SSE2, else NEON, else scalar), the scalar one stays callable.
+*/
+namespace smcd
+{
+	// Bytes of a raw dump of the same mesh, to compare the encoded size with
+	inline size_t rawMeshBytes(const size_t& verticesCount, const size_t& indicesCount) {
+		return verticesCount * sizeof(VertexStruct) + indicesCount * sizeof(uint32_t);
+	}
+
+	// indexVector.size() has to be a multiple of 3;  bits between 1 and 24 (the integers fit a float mantissa)
+	void encodeMesh(const std::vector<VertexStruct>& vertexStructVector, const std::vector<uint32_t>& indexVector,
+		std::vector<uint8_t>& encodedMeshToPopulate, const uint32_t& positionBits = 16, const uint32_t& texCoordBits = 16);
+
+	// Counts only, to size the destination (e.g. a staging buffer) before decodeMesh();  throws on a malformed header
+	void readMeshHeader(const uint8_t* encodedMesh, const size_t& encodedMeshBytes, uint32_t& verticesCount, uint32_t& indicesCount);
+
+	// Writes every destination byte once, front to back, and never reads it back:  fine for write-combined mapped memory.
+	// dstIndices has room for indicesCount, dstVertices for verticesCount;  throws on a truncated or malformed stream
+	void decodeMesh(const uint8_t* encodedMesh, const size_t& encodedMeshBytes, VertexStruct* dstVertices, uint32_t* dstIndices,
+		const bool& useSimd = true);
+
+	// "AVX2", "SSE2", "NEON" or "scalar"
+	const char* simdPathName();
+
+	bool isCompressedMeshAddress(const std::string& meshDiskAddress);	// ends with .smc
+	void readMeshFile(const char* const smcDiskAddress, std::vector<uint8_t>& encodedMeshToPopulate);
+	void loadMeshFile(const char* const smcDiskAddress,
+		std::vector<VertexStruct>& vertexStructVectorToPopulate, std::vector<uint32_t>& indexVectorToPopulate);
+
+	// Command line tool:  OBJ -> .smc, then reports compression ratios, quantization error and decode throughput
+	void compressObjFile(const char* const objDiskAddress, const char* const smcDiskAddress,
+		const uint32_t& positionBits = 16, const uint32_t& texCoordBits = 16);
+
+} //namespace smcd
+
+#endif // !__SenMeshCodec__
@@ -0,0 +1,247 @@
+#include "SenQueueTimeline.h"
+
+#include <algorithm>
+
+/*****   Queue -> timeline, registered for the lifetime of each SenQueueTimeline  *****/
+static std::mutex									queueTimelineMapMutex;
+static std::map<VkQueue, SenQueueTimeline*>			queueTimelineMap;
+
+SenQueueTimeline::SenQueueTimeline(const VkDevice& logicalDevice, const VkQueue& queue, const bool& timelineSemaphoreEnabled)
+	: m_LogicalDevice(logicalDevice), m_Queue(queue)
+{
+#if defined( VK_KHR_timeline_semaphore )
+	if (timelineSemaphoreEnabled) {
+		fetch_vkWaitSemaphoresKHR			= vkGetDeviceProcAddr(m_LogicalDevice, "vkWaitSemaphoresKHR");
+		fetch_vkGetSemaphoreCounterValueKHR	= vkGetDeviceProcAddr(m_LogicalDevice, "vkGetSemaphoreCounterValueKHR");
+	}
+	if (nullptr != fetch_vkWaitSemaphoresKHR && nullptr != fetch_vkGetSemaphoreCounterValueKHR) {
+		VkSemaphoreTypeCreateInfoKHR semaphoreTypeCreateInfo{};
+		semaphoreTypeCreateInfo.sType			= VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO_KHR;
+		semaphoreTypeCreateInfo.semaphoreType	= VK_SEMAPHORE_TYPE_TIMELINE_KHR;
+		semaphoreTypeCreateInfo.initialValue	= 0;
+
+		VkSemaphoreCreateInfo semaphoreCreateInfo{};
+		semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		semaphoreCreateInfo.pNext = &semaphoreTypeCreateInfo;
+		SLVK_AbstractGLFW::errorCheck(
+			vkCreateSemaphore(m_LogicalDevice, &semaphoreCreateInfo, nullptr, &timelineSemaphore),
+			std::string("Failed to create queue timelineSemaphore !!!")
+		);
+	}
+#else
+	(void)timelineSemaphoreEnabled;	// headers older than the extension, fence emulation only
+#endif
+
+	std::lock_guard<std::mutex> queueTimelineMapLock(queueTimelineMapMutex);
+	queueTimelineMap[m_Queue] = this;
+}
+
+SenQueueTimeline::~SenQueueTimeline()
+{
+	{
+		std::lock_guard<std::mutex> queueTimelineMapLock(queueTimelineMapMutex);
+		auto registeredTimeline = queueTimelineMap.find(m_Queue);
+		if (queueTimelineMap.end() != registeredTimeline && this == registeredTimeline->second)
+			queueTimelineMap.erase(registeredTimeline);
+	}
+	// Neither the semaphore nor a fence may be destroyed while a submission still signals it
+	waitIdle();
+
+	if (VK_NULL_HANDLE != timelineSemaphore) {
+		vkDestroySemaphore(m_LogicalDevice, timelineSemaphore, nullptr);
+		timelineSemaphore = VK_NULL_HANDLE;
+	}
+	for (auto& pendingFence : pendingFenceDeque)
+		vkDestroyFence(m_LogicalDevice, pendingFence.fence, nullptr);
+	pendingFenceDeque.clear();
+	for (auto& fence : idleFenceVector)
+		vkDestroyFence(m_LogicalDevice, fence, nullptr);
+	idleFenceVector.clear();
+
+	OutputDebugString("\n\t ~SenQueueTimeline()\n");
+}
+
+SenQueueTimeline* SenQueueTimeline::findQueueTimeline(const VkQueue& queue)
+{
+	std::lock_guard<std::mutex> queueTimelineMapLock(queueTimelineMapMutex);
+	auto registeredTimeline = queueTimelineMap.find(queue);
+	return queueTimelineMap.end() != registeredTimeline ? registeredTimeline->second : nullptr;
+}
+
+uint64_t SenQueueTimeline::submit(const VkCommandBuffer& commandBuffer)
+{
+	SubmitStruct submitStruct;
+	submitStruct.commandBufferVector.push_back(commandBuffer);
+	return submit(submitStruct);
+}
+
+uint64_t SenQueueTimeline::submit(const SubmitStruct& submitStruct)
+{
+	std::vector<VkSemaphore> waitSemaphoreVector(submitStruct.waitSemaphoreVector);
+	std::vector<VkPipelineStageFlags> waitDstStageMaskVector(submitStruct.waitDstStageMaskVector);
+	std::vector<uint64_t> waitValueVector(waitSemaphoreVector.size(), 0);	// ignored for binary semaphores
+	if (nullptr != submitStruct.waitTimeline && submitStruct.waitTimelineValue > 0) {
+		if (timelineSemaphoreBacked() && submitStruct.waitTimeline->timelineSemaphoreBacked()) {
+			waitSemaphoreVector.push_back(submitStruct.waitTimeline->timelineSemaphore);
+			waitDstStageMaskVector.push_back(submitStruct.waitTimelineDstStageMask);
+			waitValueVector.push_back(submitStruct.waitTimelineValue);
+		}
+		else
+			submitStruct.waitTimeline->waitUntil(submitStruct.waitTimelineValue);	// emulated, no GPU side wait on a fence
+	}
+
+	std::lock_guard<std::mutex> timelineLock(timelineMutex);
+	const uint64_t submitTimelineValue = lastSubmittedTimelineValue + 1;
+
+	std::vector<VkSemaphore> signalSemaphoreVector(submitStruct.signalSemaphoreVector);
+	std::vector<uint64_t> signalValueVector(signalSemaphoreVector.size(), 0);
+	if (timelineSemaphoreBacked()) {
+		signalSemaphoreVector.push_back(timelineSemaphore);
+		signalValueVector.push_back(submitTimelineValue);
+	}
+
+	VkSubmitInfo submitInfo{};
+	submitInfo.sType				= VK_STRUCTURE_TYPE_SUBMIT_INFO;
+	submitInfo.waitSemaphoreCount	= static_cast<uint32_t>(waitSemaphoreVector.size());
+	submitInfo.pWaitSemaphores		= waitSemaphoreVector.data();
+	submitInfo.pWaitDstStageMask	= waitDstStageMaskVector.data();
+	submitInfo.commandBufferCount	= static_cast<uint32_t>(submitStruct.commandBufferVector.size());
+	submitInfo.pCommandBuffers		= submitStruct.commandBufferVector.data();
+	submitInfo.signalSemaphoreCount	= static_cast<uint32_t>(signalSemaphoreVector.size());
+	submitInfo.pSignalSemaphores	= signalSemaphoreVector.data();
+
+	VkFence submitFence = VK_NULL_HANDLE;
+#if defined( VK_KHR_timeline_semaphore )
+	VkTimelineSemaphoreSubmitInfoKHR timelineSemaphoreSubmitInfo{};
+	if (timelineSemaphoreBacked()) {
+		timelineSemaphoreSubmitInfo.sType						= VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO_KHR;
+		timelineSemaphoreSubmitInfo.waitSemaphoreValueCount		= static_cast<uint32_t>(waitValueVector.size());
+		timelineSemaphoreSubmitInfo.pWaitSemaphoreValues		= waitValueVector.data();
+		timelineSemaphoreSubmitInfo.signalSemaphoreValueCount	= static_cast<uint32_t>(signalValueVector.size());
+		timelineSemaphoreSubmitInfo.pSignalSemaphoreValues		= signalValueVector.data();
+		submitInfo.pNext = &timelineSemaphoreSubmitInfo;
+	}
+	else
+#endif
+		submitFence = acquireFence();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkQueueSubmit(m_Queue, 1, &submitInfo, submitFence),
+		std::string("Failed to submit to the queue timeline !!!")
+	);
+	if (VK_NULL_HANDLE != submitFence) {
+		PendingFenceStruct pendingFence;
+		pendingFence.timelineValue	= submitTimelineValue;
+		pendingFence.fence			= submitFence;
+		pendingFenceDeque.push_back(pendingFence);
+	}
+	lastSubmittedTimelineValue = submitTimelineValue;
+	return submitTimelineValue;
+}
+
+uint64_t SenQueueTimeline::completedValue()
+{
+#if defined( VK_KHR_timeline_semaphore )
+	if (timelineSemaphoreBacked()) {
+		uint64_t counterValue = 0;
+		SLVK_AbstractGLFW::errorCheck(
+			reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(fetch_vkGetSemaphoreCounterValueKHR)(m_LogicalDevice, timelineSemaphore, &counterValue),
+			std::string("Failed to vkGetSemaphoreCounterValueKHR !!!")
+		);
+		return counterValue;
+	}
+#endif
+	std::lock_guard<std::mutex> timelineLock(timelineMutex);
+	retireSignaledFences();
+	return completedTimelineValue;
+}
+
+void SenQueueTimeline::waitUntil(const uint64_t& timelineValue)
+{
+	if (0 == timelineValue) return;
+	// Never signaled otherwise, the wait would last for ever
+	if (timelineValue > lastSubmittedValue())
+		throw std::runtime_error("Queue timeline value waited before it was submitted !!!");
+#if defined( VK_KHR_timeline_semaphore )
+	if (timelineSemaphoreBacked()) {
+		VkSemaphoreWaitInfoKHR semaphoreWaitInfo{};
+		semaphoreWaitInfo.sType				= VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO_KHR;
+		semaphoreWaitInfo.semaphoreCount	= 1;
+		semaphoreWaitInfo.pSemaphores		= &timelineSemaphore;
+		semaphoreWaitInfo.pValues			= &timelineValue;
+		SLVK_AbstractGLFW::errorCheck(
+			reinterpret_cast<PFN_vkWaitSemaphoresKHR>(fetch_vkWaitSemaphoresKHR)(m_LogicalDevice, &semaphoreWaitInfo, UINT64_MAX),
+			std::string("Failed to vkWaitSemaphoresKHR !!!")
+		);
+		return;
+	}
+#endif
+	// A fence signals once its batch and every batch submitted before it on the queue completed, so waiting on the
+	//   first fence at or past timelineValue is enough.  It is marked waited under the lock and waited without it,
+	//   such that submit() and completedValue() of other threads go on meanwhile
+	VkFence waitFence = VK_NULL_HANDLE;
+	{
+		std::lock_guard<std::mutex> timelineLock(timelineMutex);
+		retireSignaledFences();
+		if (timelineValue <= completedTimelineValue) return;
+		for (const auto& pendingFence : pendingFenceDeque) {
+			if (pendingFence.timelineValue < timelineValue) continue;
+			waitFence = pendingFence.fence;
+			break;
+		}
+		waitedFenceMap[waitFence]++;
+	}
+
+	VkResult waitResult = vkWaitForFences(m_LogicalDevice, 1, &waitFence, VK_TRUE, UINT64_MAX);
+
+	{
+		std::lock_guard<std::mutex> timelineLock(timelineMutex);
+		if (0 == --waitedFenceMap[waitFence]) {
+			waitedFenceMap.erase(waitFence);
+			// Retired by another thread while waited:  retireSignaledFences() held it back from idleFenceVector
+			bool stillPending = std::any_of(pendingFenceDeque.begin(), pendingFenceDeque.end(),
+				[&waitFence](const PendingFenceStruct& pendingFence) { return waitFence == pendingFence.fence; });
+			if (!stillPending)
+				idleFenceVector.push_back(waitFence);
+		}
+		retireSignaledFences();
+	}
+	SLVK_AbstractGLFW::errorCheck(waitResult, std::string("Failed to vkWaitForFences of the queue timeline !!"));
+}
+
+uint64_t SenQueueTimeline::lastSubmittedValue() const
+{
+	std::lock_guard<std::mutex> timelineLock(timelineMutex);
+	return lastSubmittedTimelineValue;
+}
+
+VkFence SenQueueTimeline::acquireFence()
+{
+	retireSignaledFences();
+	VkFence fence = VK_NULL_HANDLE;
+	if (!idleFenceVector.empty()) {
+		fence = idleFenceVector.back();
+		idleFenceVector.pop_back();
+		vkResetFences(m_LogicalDevice, 1, &fence);
+		return fence;
+	}
+
+	VkFenceCreateInfo fenceCreateInfo{};
+	fenceCreateInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateFence(m_LogicalDevice, &fenceCreateInfo, nullptr, &fence),
+		std::string("Failed to create queue timeline fence !!!")
+	);
+	return fence;
+}
+
+void SenQueueTimeline::retireSignaledFences()
+{
+	// Submission order is completion order for fences of one queue, only the front can have signaled first
+	while (!pendingFenceDeque.empty() && VK_SUCCESS == vkGetFenceStatus(m_LogicalDevice, pendingFenceDeque.front().fence)) {
+		completedTimelineValue = pendingFenceDeque.front().timelineValue;
+		if (waitedFenceMap.end() == waitedFenceMap.find(pendingFenceDeque.front().fence))
+			idleFenceVector.push_back(pendingFenceDeque.front().fence);	// else recycled by its last waiter
+		pendingFenceDeque.pop_front();
+	}
+}
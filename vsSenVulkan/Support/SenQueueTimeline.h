@@ -0,0 +1,79 @@
+#pragma once
+
+#ifndef __SenQueueTimeline__
+#define __SenQueueTimeline__
+
+#include "SLVK_AbstractGLFW.h"
+
+#include <deque>
+#include <map>
+#include <mutex>
+
+/*
+	Synchronization core of one VkQueue:  every submit() through it signals the next value of a 64 bit counter,
+	so a submission is known by its value.  completedValue() tells how far the GPU got, waitUntil(value) blocks the
+	CPU until that submission (and every one before it on this queue) completed;  uploads, frames and readbacks keep
+	the value of their submission and wait on exactly that, instead of a vkQueueWaitIdle or one fence per resource.
+	A submission may also wait, on the GPU, for a value of another queue's timeline.
+	Backed by one VK_KHR_timeline_semaphore (core in Vulkan 1.2) when the device enabled it, else emulated with one
+	pooled fence per submission:  same values and CPU waits, but a wait on another timeline is done on the CPU.
+	All submissions to the queue that want a value go through the same SenQueueTimeline, submit() is thread safe.
+*/
+class SenQueueTimeline
+{
+public:
+	struct SubmitStruct {
+		std::vector<VkCommandBuffer>		commandBufferVector;
+		std::vector<VkSemaphore>			waitSemaphoreVector;		// binary ones, e.g. swapchain image acquired
+		std::vector<VkPipelineStageFlags>	waitDstStageMaskVector;		// one per waitSemaphoreVector element
+		std::vector<VkSemaphore>			signalSemaphoreVector;		// binary ones, e.g. ready to present
+		SenQueueTimeline*					waitTimeline			= nullptr;	// GPU wait for waitTimelineValue of another queue
+		uint64_t							waitTimelineValue		= 0;
+		VkPipelineStageFlags				waitTimelineDstStageMask	= VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
+	};
+
+	// timelineSemaphoreEnabled:  VK_KHR_timeline_semaphore and its timelineSemaphore feature were enabled on logicalDevice
+	SenQueueTimeline(const VkDevice& logicalDevice, const VkQueue& queue, const bool& timelineSemaphoreEnabled);
+	virtual ~SenQueueTimeline();
+
+	// Returns the value signaled once the submission completed
+	uint64_t submit(const SubmitStruct& submitStruct);
+	uint64_t submit(const VkCommandBuffer& commandBuffer);
+
+	uint64_t completedValue();
+	bool isCompleted(const uint64_t& timelineValue) { return completedValue() >= timelineValue; }
+	void waitUntil(const uint64_t& timelineValue);
+	void waitIdle() { waitUntil(lastSubmittedValue()); }
+	uint64_t lastSubmittedValue() const;
+
+	bool timelineSemaphoreBacked() const { return VK_NULL_HANDLE != timelineSemaphore; }
+	VkQueue queue() const { return m_Queue; }
+
+	// The timeline submitting to queue, nullptr if none was created for it;  lets static helpers (single time commands)
+	//   wait for their own submission only
+	static SenQueueTimeline* findQueueTimeline(const VkQueue& queue);
+
+private:
+	struct PendingFenceStruct {
+		uint64_t						timelineValue			= 0;
+		VkFence							fence					= VK_NULL_HANDLE;
+	};
+
+	VkFence acquireFence();
+	void retireSignaledFences();
+
+	VkDevice							m_LogicalDevice;
+	VkQueue								m_Queue;
+	VkSemaphore							timelineSemaphore		= VK_NULL_HANDLE;	// VK_NULL_HANDLE:  fence emulation
+	PFN_vkVoidFunction					fetch_vkWaitSemaphoresKHR			= nullptr;
+	PFN_vkVoidFunction					fetch_vkGetSemaphoreCounterValueKHR	= nullptr;
+
+	mutable std::mutex					timelineMutex;			// guards the queue, lastSubmittedTimelineValue and the fences below
+	uint64_t							lastSubmittedTimelineValue	= 0;
+	uint64_t							completedTimelineValue	= 0;	// fence emulation only, in step with pendingFenceDeque
+	std::deque<PendingFenceStruct>		pendingFenceDeque;		// submission order
+	std::vector<VkFence>				idleFenceVector;
+	std::map<VkFence, uint32_t>			waitedFenceMap;			// fence -> threads in vkWaitForFences on it, not recycled meanwhile
+};
+
+#endif // !__SenQueueTimeline__
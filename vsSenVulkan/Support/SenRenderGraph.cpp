@@ -0,0 +1,527 @@
+#include "SenRenderGraph.h"
+#include "SenMemoryTracker.h"
+
+SenRenderGraph::SenRenderGraph(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties)
+	: m_LogicalDevice(logicalDevice), m_PhysicalDeviceMemoryProperties(gpuMemoryProperties)
+{
+}
+
+SenRenderGraph::~SenRenderGraph()
+{
+	destroyTargets();
+	for (auto& pass : passVector) {
+		if (VK_NULL_HANDLE != pass.renderPass) {
+			vkDestroyRenderPass(m_LogicalDevice, pass.renderPass, nullptr);
+			pass.renderPass = VK_NULL_HANDLE;
+		}
+	}
+	OutputDebugString("\n\t ~SenRenderGraph()\n");
+}
+
+/*************************************************************************************************************/
+/**********    Declaration       *****************************************************************************/
+/*************************************************************************************************************/
+uint32_t SenRenderGraph::importSwapchain(const VkFormat& swapchainFormat)
+{
+	for (const auto& resource : resourceVector)
+		if (resource.swapchain) throw std::runtime_error("Render graph swapchain imported twice !!!");
+
+	ResourceStruct swapchainResource;
+	swapchainResource.resourceName	= "swapchain";
+	swapchainResource.format		= swapchainFormat;
+	swapchainResource.swapchain		= true;
+	swapchainResource.output		= true;
+	resourceVector.push_back(swapchainResource);
+	return static_cast<uint32_t>(resourceVector.size() - 1);
+}
+
+uint32_t SenRenderGraph::createTransientImage(const std::string& imageName, const VkFormat& imageFormat)
+{
+	ResourceStruct transientResource;
+	transientResource.resourceName	= imageName;
+	transientResource.format		= imageFormat;
+	transientResource.depthStencil	= imageFormat == VK_FORMAT_D16_UNORM || imageFormat == VK_FORMAT_X8_D24_UNORM_PACK32
+		|| imageFormat == VK_FORMAT_D32_SFLOAT || SLVK_AbstractGLFW::hasStencilComponent(imageFormat);
+	resourceVector.push_back(transientResource);
+	return static_cast<uint32_t>(resourceVector.size() - 1);
+}
+
+void SenRenderGraph::markOutput(const uint32_t& resourceIndex)
+{
+	resourceVector.at(resourceIndex).output = true;
+}
+
+uint32_t SenRenderGraph::addPass(const std::string& passName, const RecordFunction& recordFunction)
+{
+	if (compiled) throw std::runtime_error("Render graph passes have to be added before compile() !!!");
+	PassStruct pass;
+	pass.passName		= passName;
+	pass.recordFunction	= recordFunction;
+	passVector.push_back(pass);
+	return static_cast<uint32_t>(passVector.size() - 1);
+}
+
+void SenRenderGraph::writeColor(const uint32_t& passIndex, const uint32_t& resourceIndex, const VkClearColorValue& clearColor)
+{
+	VkClearValue clearValue{};
+	clearValue.color = clearColor;
+	addUse(passIndex, resourceIndex, USE_COLOR_WRITE, clearValue);
+}
+
+void SenRenderGraph::writeDepth(const uint32_t& passIndex, const uint32_t& resourceIndex, const VkClearDepthStencilValue& clearDepthStencil)
+{
+	VkClearValue clearValue{};
+	clearValue.depthStencil = clearDepthStencil;
+	addUse(passIndex, resourceIndex, USE_DEPTH_WRITE, clearValue);
+}
+
+void SenRenderGraph::readDepth(const uint32_t& passIndex, const uint32_t& resourceIndex)
+{
+	addUse(passIndex, resourceIndex, USE_DEPTH_READ, VkClearValue{});
+}
+
+void SenRenderGraph::readSampled(const uint32_t& passIndex, const uint32_t& resourceIndex)
+{
+	addUse(passIndex, resourceIndex, USE_SAMPLED, VkClearValue{});
+}
+
+void SenRenderGraph::addUse(const uint32_t& passIndex, const uint32_t& resourceIndex, const UseKind& useKind, const VkClearValue& clearValue)
+{
+	if (compiled) throw std::runtime_error("Render graph uses have to be declared before compile() !!!");
+	PassStruct& pass = passVector.at(passIndex);
+	const ResourceStruct& resource = resourceVector.at(resourceIndex);
+
+	if ((USE_DEPTH_WRITE == useKind || USE_DEPTH_READ == useKind) != resource.depthStencil && USE_SAMPLED != useKind)
+		throw std::runtime_error("Render graph " + resource.resourceName + " used with the wrong attachment kind !!!");
+	if (resource.swapchain && USE_COLOR_WRITE != useKind)
+		throw std::runtime_error("Render graph swapchain can only be written as color attachment !!!");
+	for (const auto& use : pass.useVector) {
+		if (use.resourceIndex == resourceIndex)	// sampling an attachment of the same pass would be a feedback loop
+			throw std::runtime_error("Render graph pass " + pass.passName + " uses " + resource.resourceName + " twice !!!");
+		if ((USE_DEPTH_WRITE == useKind || USE_DEPTH_READ == useKind) && (USE_DEPTH_WRITE == use.useKind || USE_DEPTH_READ == use.useKind))
+			throw std::runtime_error("Render graph pass " + pass.passName + " has two depth attachments !!!");
+	}
+
+	UseStruct use;
+	use.passIndex		= passIndex;
+	use.resourceIndex	= resourceIndex;
+	use.useKind			= useKind;
+	use.clearValue		= clearValue;
+	pass.useVector.push_back(use);
+}
+
+/*************************************************************************************************************/
+/**********    Compile       *********************************************************************************/
+/*************************************************************************************************************/
+void SenRenderGraph::compile()
+{
+	if (compiled) throw std::runtime_error("Render graph compiled twice !!!");
+	cullPasses();
+
+	for (uint32_t passIndex = 0; passIndex < passVector.size(); passIndex++) {
+		if (passVector[passIndex].culled) continue;
+		for (const auto& use : passVector[passIndex].useVector) {
+			ResourceStruct& resource = resourceVector[use.resourceIndex];
+			if (UINT32_MAX == resource.firstPass && USE_COLOR_WRITE != use.useKind && USE_DEPTH_WRITE != use.useKind)
+				throw std::runtime_error("Render graph " + resource.resourceName + " is read before any pass writes it !!!");
+			resource.firstPass	= (std::min)(resource.firstPass, passIndex);
+			resource.lastPass	= (std::max)(resource.lastPass, passIndex);
+			switch (use.useKind) {
+			case USE_COLOR_WRITE:	resource.usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;			break;
+			case USE_DEPTH_WRITE:
+			case USE_DEPTH_READ:	resource.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;	break;
+			case USE_SAMPLED:		resource.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;					break;
+			}
+			if (resource.swapchain)
+				passVector[passIndex].writesSwapchain = true;
+		}
+	}
+	for (auto& resource : resourceVector) {
+		if (resource.output && !resource.swapchain)
+			resource.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;	// read by whatever comes after the graph
+		// Cleared and dropped by one render pass (storeOp DONT_CARE):  tile-based GPUs need no memory behind it
+		resource.singlePass = !resource.swapchain && !resource.output && UINT32_MAX != resource.firstPass
+			&& resource.firstPass == resource.lastPass && !(resource.usage & VK_IMAGE_USAGE_SAMPLED_BIT);
+		if (resource.singlePass)
+			resource.usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+	}
+
+	uint32_t culledPassesCount = 0;
+	for (auto& pass : passVector) {
+		if (pass.culled) { culledPassesCount++;	continue; }
+		createRenderPass(pass);
+	}
+	compiled = true;
+
+	std::ostringstream stream;
+	stream << "Render graph compiled:  " << passVector.size() - culledPassesCount << " of " << passVector.size() << " passes kept";
+	for (const auto& pass : passVector)
+		if (pass.culled) stream << ",  " << pass.passName << " culled (output unused)";
+	stream << "\n";
+	std::cout << stream.str();
+}
+
+void SenRenderGraph::cullPasses()
+{
+	// Walk back from the outputs:  a pass is kept if it writes something still needed, then what it reads is needed too.
+	//   Writes after the first one load the previous content, so earlier writers of a needed resource stay needed
+	std::vector<bool> resourceNeededVector(resourceVector.size(), false);
+	for (size_t resourceIndex = 0; resourceIndex < resourceVector.size(); resourceIndex++)
+		resourceNeededVector[resourceIndex] = resourceVector[resourceIndex].output;
+
+	for (size_t passIndex = passVector.size(); passIndex-- > 0; ) {
+		PassStruct& pass = passVector[passIndex];
+		pass.culled = true;
+		for (const auto& use : pass.useVector)
+			if ((USE_COLOR_WRITE == use.useKind || USE_DEPTH_WRITE == use.useKind) && resourceNeededVector[use.resourceIndex])
+				pass.culled = false;
+		if (pass.culled) continue;
+		for (const auto& use : pass.useVector)
+			resourceNeededVector[use.resourceIndex] = true;
+	}
+}
+
+VkImageLayout SenRenderGraph::useLayout(const UseKind& useKind, const bool& depthStencil) const
+{
+	switch (useKind) {
+	case USE_COLOR_WRITE:	return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+	case USE_DEPTH_WRITE:	return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+	case USE_DEPTH_READ:	return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+	default:				return depthStencil ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+	}
+}
+
+const SenRenderGraph::UseStruct* SenRenderGraph::neighbourUse(const uint32_t& resourceIndex, const uint32_t& passIndex, const bool& after) const
+{
+	if (after) {
+		for (uint32_t otherPassIndex = passIndex + 1; otherPassIndex < passVector.size(); otherPassIndex++) {
+			if (passVector[otherPassIndex].culled) continue;
+			for (const auto& use : passVector[otherPassIndex].useVector)
+				if (use.resourceIndex == resourceIndex) return &use;
+		}
+	}else {
+		for (uint32_t otherPassIndex = passIndex; otherPassIndex-- > 0; ) {
+			if (passVector[otherPassIndex].culled) continue;
+			for (const auto& use : passVector[otherPassIndex].useVector)
+				if (use.resourceIndex == resourceIndex) return &use;
+		}
+	}
+	return nullptr;
+}
+
+void SenRenderGraph::createRenderPass(PassStruct& pass)
+{
+	/********************************************************************************************************************/
+	/************    Attachments:  ops and layouts from the uses before and after this pass      ************************/
+	/********************************************************************************************************************/
+	std::vector<VkAttachmentDescription> attachmentDescriptionVector;
+	std::vector<VkAttachmentReference> colorAttachmentReferenceVector;
+	VkAttachmentReference depthAttachmentReference{};
+	bool hasDepthAttachment = false;
+	VkPipelineStageFlags dstStageMask = 0;
+	VkAccessFlags dstAccessMask = 0;
+
+	// Color attachments first, in declaration order, then the depth attachment
+	std::vector<const UseStruct*> attachmentUseVector;
+	for (const auto& use : pass.useVector)
+		if (USE_COLOR_WRITE == use.useKind) attachmentUseVector.push_back(&use);
+	for (const auto& use : pass.useVector)
+		if (USE_DEPTH_WRITE == use.useKind || USE_DEPTH_READ == use.useKind) attachmentUseVector.push_back(&use);
+
+	pass.attachmentResourceVector.clear();
+	pass.clearValueVector.clear();
+	for (const UseStruct* use : attachmentUseVector) {
+		const ResourceStruct& resource = resourceVector[use->resourceIndex];
+		const UseStruct* previousUse	= neighbourUse(use->resourceIndex, use->passIndex, false);
+		const UseStruct* nextUse		= neighbourUse(use->resourceIndex, use->passIndex, true);
+		const VkImageLayout attachmentLayout = useLayout(use->useKind, resource.depthStencil);
+
+		VkAttachmentDescription attachmentDescription{};
+		attachmentDescription.format		= resource.format;
+		attachmentDescription.samples		= VK_SAMPLE_COUNT_1_BIT;
+		// Nothing written before:  clear, and whatever the memory held (another aliased image) is discarded
+		attachmentDescription.loadOp		= nullptr == previousUse ? VK_ATTACHMENT_LOAD_OP_CLEAR : VK_ATTACHMENT_LOAD_OP_LOAD;
+		attachmentDescription.storeOp		= (nullptr != nextUse || resource.output) ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+		attachmentDescription.initialLayout	= nullptr == previousUse ? VK_IMAGE_LAYOUT_UNDEFINED
+			: (USE_SAMPLED == previousUse->useKind ? useLayout(USE_SAMPLED, resource.depthStencil) : attachmentLayout);
+		if (nullptr != nextUse)
+			attachmentDescription.finalLayout = useLayout(nextUse->useKind, resource.depthStencil);
+		else if (resource.swapchain)
+			attachmentDescription.finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+		else if (resource.output)
+			attachmentDescription.finalLayout = useLayout(USE_SAMPLED, resource.depthStencil);
+		else
+			attachmentDescription.finalLayout = attachmentLayout;
+		const bool hasStencil = SLVK_AbstractGLFW::hasStencilComponent(resource.format);
+		attachmentDescription.stencilLoadOp		= hasStencil ? attachmentDescription.loadOp : VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+		attachmentDescription.stencilStoreOp	= hasStencil ? attachmentDescription.storeOp : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
+		VkAttachmentReference attachmentReference{};
+		attachmentReference.attachment	= static_cast<uint32_t>(attachmentDescriptionVector.size());
+		attachmentReference.layout		= attachmentLayout;
+		if (USE_COLOR_WRITE == use->useKind) {
+			colorAttachmentReferenceVector.push_back(attachmentReference);
+			dstStageMask	|= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+			dstAccessMask	|= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | (nullptr != previousUse ? VK_ACCESS_COLOR_ATTACHMENT_READ_BIT : 0);
+		}else {
+			depthAttachmentReference	= attachmentReference;
+			hasDepthAttachment			= true;
+			dstStageMask	|= VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+			dstAccessMask	|= VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | (USE_DEPTH_WRITE == use->useKind ? VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : 0);
+		}
+		attachmentDescriptionVector.push_back(attachmentDescription);
+		pass.attachmentResourceVector.push_back(use->resourceIndex);
+		pass.clearValueVector.push_back(use->clearValue);
+	}
+	for (const auto& use : pass.useVector) {
+		if (USE_SAMPLED != use.useKind) continue;
+		dstStageMask	|= VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
+		dstAccessMask	|= VK_ACCESS_SHADER_READ_BIT;
+	}
+	if (0 == dstStageMask)
+		dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;	// a pass without any use, nothing to wait for
+
+	std::array<VkSubpassDescription, 1> subpassDescriptionArray{};
+	subpassDescriptionArray[0].pipelineBindPoint		= VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpassDescriptionArray[0].colorAttachmentCount		= static_cast<uint32_t>(colorAttachmentReferenceVector.size());
+	subpassDescriptionArray[0].pColorAttachments		= colorAttachmentReferenceVector.data();
+	subpassDescriptionArray[0].pDepthStencilAttachment	= hasDepthAttachment ? &depthAttachmentReference : nullptr;
+
+	/********************************************************************************************************************/
+	/******  The barrier before this pass:  after every attachment write submitted earlier, which covers the passes    **/
+	/******  before it, the previous frame on the same images, aliased images, and the swapchain acquire semaphore     **/
+	/******  (waited on at COLOR_ATTACHMENT_OUTPUT);  only the stages this pass uses wait                              **/
+	/********************************************************************************************************************/
+	std::array<VkSubpassDependency, 1> subpassDependencyArray{};
+	subpassDependencyArray[0].srcSubpass	= VK_SUBPASS_EXTERNAL;
+	subpassDependencyArray[0].dstSubpass	= 0;
+	subpassDependencyArray[0].srcStageMask	= VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
+		| VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	subpassDependencyArray[0].srcAccessMask	= VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	subpassDependencyArray[0].dstStageMask	= dstStageMask;
+	subpassDependencyArray[0].dstAccessMask	= dstAccessMask;
+
+	VkRenderPassCreateInfo renderPassCreateInfo{};
+	renderPassCreateInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassCreateInfo.attachmentCount	= static_cast<uint32_t>(attachmentDescriptionVector.size());
+	renderPassCreateInfo.pAttachments		= attachmentDescriptionVector.data();
+	renderPassCreateInfo.subpassCount		= static_cast<uint32_t>(subpassDescriptionArray.size());
+	renderPassCreateInfo.pSubpasses			= subpassDescriptionArray.data();
+	renderPassCreateInfo.dependencyCount	= static_cast<uint32_t>(subpassDependencyArray.size());
+	renderPassCreateInfo.pDependencies		= subpassDependencyArray.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateRenderPass(m_LogicalDevice, &renderPassCreateInfo, nullptr, &pass.renderPass),
+		std::string("Failed to create render graph pass " + pass.passName + " !!!")
+	);
+}
+
+/*************************************************************************************************************/
+/**********    Targets       *********************************************************************************/
+/*************************************************************************************************************/
+void SenRenderGraph::createTargets(const uint32_t& width, const uint32_t& height, const std::vector<VkImageView>& swapchainImageViewVector)
+{
+	if (!compiled) throw std::runtime_error("Render graph targets created before compile() !!!");
+	destroyTargets();
+	targetExtent			= { width, height };
+	swapchainImagesCount	= static_cast<uint32_t>(swapchainImageViewVector.size());
+
+	/********************************************************************************************************************/
+	/***********    Transient images, largest first, each into the first slot none of whose images it overlaps   ********/
+	/***********    single pass ones get a lazily allocated slot of their own where the device has the type      ********/
+	/********************************************************************************************************************/
+	std::vector<uint32_t> transientResourceIndexVector;
+	std::vector<VkMemoryRequirements> memoryRequirementsVector(resourceVector.size());
+	for (uint32_t resourceIndex = 0; resourceIndex < resourceVector.size(); resourceIndex++) {
+		ResourceStruct& resource = resourceVector[resourceIndex];
+		if (resource.swapchain || UINT32_MAX == resource.firstPass) continue;	// not owned, or used by culled passes only
+
+		VkImageCreateInfo imageCreateInfo{};
+		imageCreateInfo.sType			= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+		imageCreateInfo.imageType		= VK_IMAGE_TYPE_2D;
+		imageCreateInfo.format			= resource.format;
+		imageCreateInfo.extent			= { width, height, 1 };
+		imageCreateInfo.mipLevels		= 1;
+		imageCreateInfo.arrayLayers		= 1;
+		imageCreateInfo.samples			= VK_SAMPLE_COUNT_1_BIT;
+		imageCreateInfo.tiling			= VK_IMAGE_TILING_OPTIMAL;
+		imageCreateInfo.usage			= resource.usage;
+		imageCreateInfo.sharingMode		= VK_SHARING_MODE_EXCLUSIVE;
+		imageCreateInfo.initialLayout	= VK_IMAGE_LAYOUT_UNDEFINED;	// the first pass using it clears it
+		SLVK_AbstractGLFW::errorCheck(
+			vkCreateImage(m_LogicalDevice, &imageCreateInfo, nullptr, &resource.image),
+			std::string("Failed to create render graph image " + resource.resourceName + " !!!")
+		);
+		vkGetImageMemoryRequirements(m_LogicalDevice, resource.image, &memoryRequirementsVector[resourceIndex]);
+		transientResourceIndexVector.push_back(resourceIndex);
+
+		uint32_t lazilyAllocatedMemoryTypeIndex = 0;
+		if (resource.singlePass && SLVK_AbstractGLFW::findLazilyAllocatedMemoryTypeIndex(m_PhysicalDeviceMemoryProperties,
+				memoryRequirementsVector[resourceIndex], lazilyAllocatedMemoryTypeIndex)) {
+			MemorySlotStruct memorySlot;
+			memorySlot.memoryRequirements	= memoryRequirementsVector[resourceIndex];
+			memorySlot.memoryRequirements.memoryTypeBits = 1u << lazilyAllocatedMemoryTypeIndex;
+			memorySlot.lazilyAllocated		= true;
+			memorySlot.resourceIndexVector.push_back(resourceIndex);
+			memorySlotVector.push_back(memorySlot);
+			resource.memorySlot = static_cast<uint32_t>(memorySlotVector.size() - 1);
+		}else
+			unaliasedMemoryBytes += memoryRequirementsVector[resourceIndex].size;
+	}
+	std::stable_sort(transientResourceIndexVector.begin(), transientResourceIndexVector.end(), [&](const uint32_t& lhs, const uint32_t& rhs) {
+		return memoryRequirementsVector[lhs].size > memoryRequirementsVector[rhs].size; });
+
+	for (const uint32_t& resourceIndex : transientResourceIndexVector) {
+		ResourceStruct& resource = resourceVector[resourceIndex];
+		const VkMemoryRequirements& memoryRequirements = memoryRequirementsVector[resourceIndex];
+		for (uint32_t slotIndex = 0; slotIndex < memorySlotVector.size() && UINT32_MAX == resource.memorySlot; slotIndex++) {
+			MemorySlotStruct& memorySlot = memorySlotVector[slotIndex];
+			if (memorySlot.lazilyAllocated) continue;
+			bool lifetimesOverlap = false;
+			for (const uint32_t& slotResourceIndex : memorySlot.resourceIndexVector) {
+				const ResourceStruct& slotResource = resourceVector[slotResourceIndex];
+				lifetimesOverlap = lifetimesOverlap || (resource.firstPass <= slotResource.lastPass && slotResource.firstPass <= resource.lastPass);
+			}
+			VkMemoryRequirements mergedRequirements = memorySlot.memoryRequirements;
+			mergedRequirements.memoryTypeBits &= memoryRequirements.memoryTypeBits;
+			bool deviceLocalTypeLeft = false;
+			for (uint32_t memoryTypeIndex = 0; memoryTypeIndex < m_PhysicalDeviceMemoryProperties.memoryTypeCount; memoryTypeIndex++)
+				deviceLocalTypeLeft = deviceLocalTypeLeft || ((mergedRequirements.memoryTypeBits & (1u << memoryTypeIndex))
+					&& (m_PhysicalDeviceMemoryProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT));
+			if (lifetimesOverlap || !deviceLocalTypeLeft) continue;
+
+			mergedRequirements.size			= (std::max)(mergedRequirements.size, memoryRequirements.size);
+			mergedRequirements.alignment	= (std::max)(mergedRequirements.alignment, memoryRequirements.alignment);
+			memorySlot.memoryRequirements	= mergedRequirements;
+			memorySlot.resourceIndexVector.push_back(resourceIndex);
+			resource.memorySlot				= slotIndex;
+		}
+		if (UINT32_MAX == resource.memorySlot) {
+			MemorySlotStruct memorySlot;
+			memorySlot.memoryRequirements = memoryRequirements;
+			memorySlot.resourceIndexVector.push_back(resourceIndex);
+			memorySlotVector.push_back(memorySlot);
+			resource.memorySlot = static_cast<uint32_t>(memorySlotVector.size() - 1);
+		}
+	}
+
+	for (auto& memorySlot : memorySlotVector) {
+		VkMemoryAllocateInfo memoryAllocateInfo{};
+		memoryAllocateInfo.sType			= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		memoryAllocateInfo.allocationSize	= memorySlot.memoryRequirements.size;
+		memoryAllocateInfo.memoryTypeIndex	= SLVK_AbstractGLFW::findPhysicalDeviceMemoryPropertyIndex(m_PhysicalDeviceMemoryProperties,
+			memorySlot.memoryRequirements, memorySlot.lazilyAllocated ? VK_MEMORY_PROPERTY_LAZILY_ALLOCATED_BIT : VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		SLVK_AbstractGLFW::errorCheck(
+			vkAllocateMemory(m_LogicalDevice, &memoryAllocateInfo, nullptr, &memorySlot.deviceMemory),
+			std::string("Failed to allocate render graph transient memory !!!")
+		);
+		SenMemoryTracker::recordAllocation(memorySlot.deviceMemory, memoryAllocateInfo.allocationSize, memoryAllocateInfo.memoryTypeIndex,
+			SenMemoryTracker::MEMORY_CATEGORY_ATTACHMENT);
+		(memorySlot.lazilyAllocated ? lazilyAllocatedMemoryBytes : aliasedMemoryBytes) += memoryAllocateInfo.allocationSize;
+
+		for (const uint32_t& resourceIndex : memorySlot.resourceIndexVector) {
+			ResourceStruct& resource = resourceVector[resourceIndex];
+			vkBindImageMemory(m_LogicalDevice, resource.image, memorySlot.deviceMemory, 0);
+			if (resource.singlePass)
+				SLVK_AbstractGLFW::reportTransientAttachment(resource.resourceName, memoryRequirementsVector[resourceIndex].size, memorySlot.lazilyAllocated);
+
+			VkImageViewCreateInfo imageViewCreateInfo{};
+			imageViewCreateInfo.sType								= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+			imageViewCreateInfo.image								= resource.image;
+			imageViewCreateInfo.viewType							= VK_IMAGE_VIEW_TYPE_2D;
+			imageViewCreateInfo.format								= resource.format;
+			imageViewCreateInfo.subresourceRange.aspectMask			= !resource.depthStencil ? VK_IMAGE_ASPECT_COLOR_BIT
+				: (VK_IMAGE_ASPECT_DEPTH_BIT | (SLVK_AbstractGLFW::hasStencilComponent(resource.format) ? VK_IMAGE_ASPECT_STENCIL_BIT : 0));
+			imageViewCreateInfo.subresourceRange.baseMipLevel		= 0;
+			imageViewCreateInfo.subresourceRange.levelCount			= 1;
+			imageViewCreateInfo.subresourceRange.baseArrayLayer		= 0;
+			imageViewCreateInfo.subresourceRange.layerCount			= 1;
+			SLVK_AbstractGLFW::errorCheck(
+				vkCreateImageView(m_LogicalDevice, &imageViewCreateInfo, nullptr, &resource.imageView),
+				std::string("Failed to create render graph image view " + resource.resourceName + " !!!")
+			);
+		}
+	}
+
+	/********************************************************************************************************************/
+	/***********    Framebuffers:  one per swapchain image for passes writing the swapchain, else one       *************/
+	/********************************************************************************************************************/
+	for (auto& pass : passVector) {
+		if (pass.culled) continue;
+		const uint32_t framebuffersCount = pass.writesSwapchain ? swapchainImagesCount : 1;
+		pass.framebufferVector.assign(framebuffersCount, VK_NULL_HANDLE);
+		for (uint32_t framebufferIndex = 0; framebufferIndex < framebuffersCount; framebufferIndex++) {
+			std::vector<VkImageView> imageViewAttachmentVector;
+			for (const uint32_t& resourceIndex : pass.attachmentResourceVector)
+				imageViewAttachmentVector.push_back(resourceVector[resourceIndex].swapchain
+					? swapchainImageViewVector[framebufferIndex] : resourceVector[resourceIndex].imageView);
+
+			VkFramebufferCreateInfo framebufferCreateInfo{};
+			framebufferCreateInfo.sType				= VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+			framebufferCreateInfo.renderPass		= pass.renderPass;
+			framebufferCreateInfo.attachmentCount	= static_cast<uint32_t>(imageViewAttachmentVector.size());
+			framebufferCreateInfo.pAttachments		= imageViewAttachmentVector.data();
+			framebufferCreateInfo.width				= width;
+			framebufferCreateInfo.height			= height;
+			framebufferCreateInfo.layers			= 1;
+			SLVK_AbstractGLFW::errorCheck(
+				vkCreateFramebuffer(m_LogicalDevice, &framebufferCreateInfo, nullptr, &pass.framebufferVector[framebufferIndex]),
+				std::string("Failed to create render graph framebuffer of " + pass.passName + " !!!")
+			);
+		}
+	}
+
+	std::ostringstream stream;
+	stream << "Render graph targets " << width << "x" << height << ":  " << transientResourceIndexVector.size() << " transient images in "
+		<< memorySlotVector.size() << " allocations, " << aliasedMemoryBytes / 1024 << " KB instead of " << unaliasedMemoryBytes / 1024 << " KB"
+		<< " + " << lazilyAllocatedMemoryBytes / 1024 << " KB lazily allocated\n";
+	std::cout << stream.str();
+}
+
+void SenRenderGraph::destroyTargets()
+{
+	for (auto& pass : passVector) {
+		for (auto& framebuffer : pass.framebufferVector)
+			vkDestroyFramebuffer(m_LogicalDevice, framebuffer, nullptr);
+		pass.framebufferVector.clear();
+	}
+	for (auto& resource : resourceVector) {
+		if (VK_NULL_HANDLE != resource.imageView) {
+			vkDestroyImageView(m_LogicalDevice, resource.imageView, nullptr);
+			resource.imageView = VK_NULL_HANDLE;
+		}
+		if (VK_NULL_HANDLE != resource.image) {
+			vkDestroyImage(m_LogicalDevice, resource.image, nullptr);
+			resource.image = VK_NULL_HANDLE;
+		}
+		resource.memorySlot = UINT32_MAX;
+	}
+	for (auto& memorySlot : memorySlotVector)
+		if (VK_NULL_HANDLE != memorySlot.deviceMemory)
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, memorySlot.deviceMemory);	// always try to destroy before free
+	memorySlotVector.clear();
+	aliasedMemoryBytes			= 0;
+	unaliasedMemoryBytes		= 0;
+	lazilyAllocatedMemoryBytes	= 0;
+}
+
+void SenRenderGraph::record(const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex) const
+{
+	for (const auto& pass : passVector) {
+		if (pass.culled) continue;
+
+		VkRenderPassBeginInfo renderPassBeginInfo{};
+		renderPassBeginInfo.sType				= VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+		renderPassBeginInfo.renderPass			= pass.renderPass;
+		renderPassBeginInfo.framebuffer			= pass.framebufferVector.at(pass.writesSwapchain ? swapchainImageIndex : 0);
+		renderPassBeginInfo.renderArea.offset	= { 0, 0 };
+		renderPassBeginInfo.renderArea.extent	= targetExtent;
+		renderPassBeginInfo.clearValueCount		= static_cast<uint32_t>(pass.clearValueVector.size());
+		renderPassBeginInfo.pClearValues		= pass.clearValueVector.data();
+
+		vkCmdBeginRenderPass(commandBuffer, &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+		if (pass.recordFunction)
+			pass.recordFunction(commandBuffer, swapchainImageIndex);
+		vkCmdEndRenderPass(commandBuffer);
+	}
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#ifndef __SenRenderGraph__
+#define __SenRenderGraph__
+
+#include "SLVK_AbstractGLFW.h"
+
+#include <functional>
+
+/*
+	A frame described as passes that declare the attachments they write and the images they read, instead of render
+	passes, framebuffers and barriers written by hand.  compile() derives the rest from the declarations:
+	-	passes contributing to no output (the swapchain, or an image given to markOutput()) are culled;
+	-	each remaining pass gets its VkRenderPass:  loadOp CLEAR when nothing earlier wrote the attachment, LOAD otherwise,
+		storeOp STORE only when a later pass (or the output) uses it, and initial / final layouts chained from use to use,
+		so every layout transition happens inside a render pass;
+	-	one external subpass dependency per pass, from the attachment writes of the passes before it to the stages of its
+		own uses, is the only barrier between passes.
+	createTargets() then creates the transient images (depth, G-buffer, post-processing targets) and lets those whose
+	pass ranges do not overlap share one VkDeviceMemory, and the framebuffers (one per swapchain image for passes
+	writing the swapchain).  Images used by a single pass and never sampled get TRANSIENT_ATTACHMENT usage and, where the
+	device has it, their own LAZILY_ALLOCATED memory instead of a shared slot.  Call it again after a resize:  render passes, and the pipelines created against them, stay.
+	record() begins each remaining pass, calls its recordFunction and ends it.
+*/
+class SenRenderGraph
+{
+public:
+	typedef std::function<void(const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex)> RecordFunction;
+
+	SenRenderGraph(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties);
+	virtual ~SenRenderGraph();
+
+	/*************************************************************************************************************/
+	/**********    Declaration, before compile()       ***********************************************************/
+	// The presented image, always an output;  its views come with createTargets()
+	uint32_t importSwapchain(const VkFormat& swapchainFormat);
+	// An image living within the frame, as large as the swapchain;  usage is derived from the passes using it
+	uint32_t createTransientImage(const std::string& imageName, const VkFormat& imageFormat);
+	void markOutput(const uint32_t& resourceIndex);
+
+	uint32_t addPass(const std::string& passName, const RecordFunction& recordFunction);
+	void writeColor(const uint32_t& passIndex, const uint32_t& resourceIndex, const VkClearColorValue& clearColor);
+	void writeDepth(const uint32_t& passIndex, const uint32_t& resourceIndex, const VkClearDepthStencilValue& clearDepthStencil);
+	// Depth test against what an earlier pass wrote, no depth writes (DEPTH_STENCIL_READ_ONLY_OPTIMAL)
+	void readDepth(const uint32_t& passIndex, const uint32_t& resourceIndex);
+	// Sampled by the fragment shader
+	void readSampled(const uint32_t& passIndex, const uint32_t& resourceIndex);
+
+	/*************************************************************************************************************/
+	/**********    Compiled graph      ***************************************************************************/
+	void compile();
+	// (Re)creates transient images, aliased memory and framebuffers for the given extent;  the device has to be idle
+	void createTargets(const uint32_t& width, const uint32_t& height, const std::vector<VkImageView>& swapchainImageViewVector);
+	void destroyTargets();
+	void record(const VkCommandBuffer& commandBuffer, const uint32_t& swapchainImageIndex) const;
+
+	VkRenderPass renderPass(const uint32_t& passIndex) const { return passVector.at(passIndex).renderPass; }
+	bool passCulled(const uint32_t& passIndex) const { return passVector.at(passIndex).culled; }
+	VkImageView imageView(const uint32_t& resourceIndex) const { return resourceVector.at(resourceIndex).imageView; }
+	VkFormat imageFormat(const uint32_t& resourceIndex) const { return resourceVector.at(resourceIndex).format; }
+
+	VkDeviceSize transientMemoryBytes() const { return aliasedMemoryBytes; }		// allocated, after aliasing, lazily allocated excluded
+	VkDeviceSize lazilyAllocatedBytes() const { return lazilyAllocatedMemoryBytes; }
+	VkDeviceSize transientImageBytes() const { return unaliasedMemoryBytes; }		// what one allocation per image would take
+
+private:
+	enum UseKind { USE_COLOR_WRITE, USE_DEPTH_WRITE, USE_DEPTH_READ, USE_SAMPLED };
+	struct UseStruct {
+		uint32_t						passIndex				= 0;
+		uint32_t						resourceIndex			= 0;
+		UseKind							useKind					= USE_SAMPLED;
+		VkClearValue					clearValue{};
+	};
+	struct ResourceStruct {
+		std::string						resourceName;
+		VkFormat						format					= VK_FORMAT_UNDEFINED;
+		bool							swapchain				= false;
+		bool							output					= false;
+		bool							depthStencil			= false;
+		VkImageUsageFlags				usage					= 0;	// derived by compile()
+		bool							singlePass				= false;	// TRANSIENT_ATTACHMENT:  never outlives the pass using it
+		uint32_t						firstPass				= UINT32_MAX;	// among the passes kept, set by compile()
+		uint32_t						lastPass				= 0;
+		VkImage							image					= VK_NULL_HANDLE;
+		VkImageView						imageView				= VK_NULL_HANDLE;
+		uint32_t						memorySlot				= UINT32_MAX;
+	};
+	struct PassStruct {
+		std::string						passName;
+		RecordFunction					recordFunction;
+		std::vector<UseStruct>			useVector;
+		bool							culled					= false;
+		bool							writesSwapchain			= false;
+		VkRenderPass					renderPass				= VK_NULL_HANDLE;
+		std::vector<uint32_t>			attachmentResourceVector;	// framebuffer attachment order
+		std::vector<VkClearValue>		clearValueVector;
+		std::vector<VkFramebuffer>		framebufferVector;		// one per swapchain image if writesSwapchain
+	};
+	struct MemorySlotStruct {
+		VkDeviceMemory					deviceMemory			= VK_NULL_HANDLE;
+		VkMemoryRequirements			memoryRequirements{};	// merged over the images sharing the slot
+		bool							lazilyAllocated			= false;	// one singlePass image, not shared
+		std::vector<uint32_t>			resourceIndexVector;
+	};
+
+	void addUse(const uint32_t& passIndex, const uint32_t& resourceIndex, const UseKind& useKind, const VkClearValue& clearValue);
+	void cullPasses();
+	void createRenderPass(PassStruct& pass);
+	// Layout the resource has to be in for useKind
+	VkImageLayout useLayout(const UseKind& useKind, const bool& depthStencil) const;
+	// The use of resourceIndex right before / after passIndex among the passes kept, nullptr if none
+	const UseStruct* neighbourUse(const uint32_t& resourceIndex, const uint32_t& passIndex, const bool& after) const;
+
+	VkDevice							m_LogicalDevice;
+	VkPhysicalDeviceMemoryProperties	m_PhysicalDeviceMemoryProperties;
+
+	std::vector<ResourceStruct>			resourceVector;
+	std::vector<PassStruct>				passVector;
+	std::vector<MemorySlotStruct>		memorySlotVector;
+	bool								compiled				= false;
+	VkExtent2D							targetExtent{};
+	uint32_t							swapchainImagesCount	= 0;
+	VkDeviceSize						aliasedMemoryBytes		= 0;
+	VkDeviceSize						unaliasedMemoryBytes	= 0;
+	VkDeviceSize						lazilyAllocatedMemoryBytes	= 0;
+};
+
+#endif // !__SenRenderGraph__
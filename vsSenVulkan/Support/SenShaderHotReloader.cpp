@@ -0,0 +1,300 @@
+#include "SenShaderHotReloader.h"
+
+#if defined( __linux )
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#endif
+
+SenShaderHotReloader::SenShaderHotReloader(const VkDevice& logicalDevice, const std::string& watchedDirectory)
+	: m_LogicalDevice(logicalDevice), m_WatchedDirectory(watchedDirectory), watcherThreadQuit(false)
+{
+	VkPipelineCacheCreateInfo pipelineCacheCreateInfo{};
+	pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreatePipelineCache(m_LogicalDevice, &pipelineCacheCreateInfo, nullptr, &m_PipelineCache),
+		std::string("Failed to create hot-reload pipelineCache !!!")
+	);
+
+#if defined( __linux )
+	// Editors either rewrite the file (CLOSE_WRITE) or save a temporary and rename it over (MOVED_TO)
+	inotifyFileDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFileDescriptor < 0 || inotify_add_watch(inotifyFileDescriptor, m_WatchedDirectory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+		throw std::runtime_error("failed to watch shader directory " + m_WatchedDirectory + " !");
+#endif
+
+	watcherThread = std::thread(&SenShaderHotReloader::watcherThreadLoop, this);
+}
+
+SenShaderHotReloader::~SenShaderHotReloader()
+{
+	watcherThreadQuit = true;
+	if (watcherThread.joinable())
+		watcherThread.join();
+
+#if defined( __linux )
+	if (inotifyFileDescriptor >= 0) {
+		close(inotifyFileDescriptor);
+		inotifyFileDescriptor = -1;
+	}
+#endif
+
+	/************************************************************************************************************/
+	/*********     Device is idle here:  destroy live, rebuilt-but-never-swapped and retired pipelines     ******/
+	/************************************************************************************************************/
+	for (auto& registeredPipeline : registeredPipelineVector) {
+		if (VK_NULL_HANDLE != registeredPipeline.pipeline)
+			vkDestroyPipeline(m_LogicalDevice, registeredPipeline.pipeline, nullptr);
+	}
+	registeredPipelineVector.clear();
+	for (auto& rebuiltPipeline : rebuiltPipelineQueue)
+		vkDestroyPipeline(m_LogicalDevice, rebuiltPipeline.pipeline, nullptr);
+	rebuiltPipelineQueue.clear();
+	for (auto& retiredPipeline : retiredPipelineVector)
+		vkDestroyPipeline(m_LogicalDevice, retiredPipeline.pipeline, nullptr);
+	retiredPipelineVector.clear();
+
+	if (VK_NULL_HANDLE != m_PipelineCache) {
+		vkDestroyPipelineCache(m_LogicalDevice, m_PipelineCache, nullptr);
+		m_PipelineCache = VK_NULL_HANDLE;
+	}
+	OutputDebugString("\n\t ~SenShaderHotReloader()\n");
+}
+
+uint32_t SenShaderHotReloader::registerPipeline(const std::vector<std::string>& shaderDiskFileAddressVector,
+	const PipelineBuilderFunction& pipelineBuilder, const std::vector<std::vector<uint32_t>>& initialSpirvVector)
+{
+	RegisteredPipelineStruct registeredPipeline{};
+	registeredPipeline.shaderDiskFileAddressVector	= shaderDiskFileAddressVector;
+	registeredPipeline.pipelineBuilder				= pipelineBuilder;
+
+	std::vector<std::vector<uint32_t>> spirvVector(initialSpirvVector);
+	if (spirvVector.size() != shaderDiskFileAddressVector.size()) {
+		spirvVector.clear();
+		for (const auto& shaderDiskFileAddress : shaderDiskFileAddressVector)
+			spirvVector.push_back(SLVK_AbstractGLFW::compileShaderToSPIRV(shaderDiskFileAddress));
+	}
+	for (size_t shader = 0; shader < spirvVector.size(); shader++) {
+		if (spirvVector[shader].empty())
+			throw std::runtime_error("failed to compile shader " + shaderDiskFileAddressVector[shader] + " !");
+	}
+	registeredPipeline.pipeline = buildPipeline(registeredPipeline, spirvVector);
+
+	std::lock_guard<std::mutex> pipelineLock(pipelineMutex);
+	registeredPipelineVector.push_back(registeredPipeline);
+	return (uint32_t)registeredPipelineVector.size() - 1;
+}
+
+VkPipeline SenShaderHotReloader::buildPipeline(const RegisteredPipelineStruct& registeredPipeline, const std::vector<std::vector<uint32_t>>& spirvVector)
+{
+	std::vector<VkShaderModule> shaderModuleVector;
+	for (const auto& spirv32Vector : spirvVector) {
+		VkShaderModule shaderModule = VK_NULL_HANDLE;
+		SLVK_AbstractGLFW::createVulkanShaderModule(m_LogicalDevice, spirv32Vector, shaderModule);
+		shaderModuleVector.push_back(shaderModule);
+	}
+
+	VkPipeline pipeline = VK_NULL_HANDLE;
+	try {
+		pipeline = registeredPipeline.pipelineBuilder(m_PipelineCache, shaderModuleVector);
+	}
+	catch (...) {
+		for (auto& shaderModule : shaderModuleVector)
+			vkDestroyShaderModule(m_LogicalDevice, shaderModule, nullptr);
+		throw;
+	}
+	// Modules are only needed while the pipeline is created
+	for (auto& shaderModule : shaderModuleVector)
+		vkDestroyShaderModule(m_LogicalDevice, shaderModule, nullptr);
+	return pipeline;
+}
+
+bool SenShaderHotReloader::swapRebuiltPipelines()
+{
+	std::deque<RebuiltPipelineStruct> swapPipelineQueue;
+	std::deque<std::string> printQueue;
+	{
+		std::lock_guard<std::mutex> pipelineLock(pipelineMutex);
+		swapPipelineQueue.swap(rebuiltPipelineQueue);
+		printQueue.swap(reportQueue);
+	}
+	for (const auto& report : printQueue)
+		std::cout << report;
+
+	if (swapPipelineQueue.empty())
+		return false;
+
+	/************************************************************************************************************/
+	/*********     One new generation for the whole batch, the replaced pipelines retire with it     ***********/
+	/************************************************************************************************************/
+	currentPipelineGeneration++;
+	for (const auto& rebuiltPipeline : swapPipelineQueue) {
+		RetiredPipelineStruct retiredPipeline{};
+		retiredPipeline.pipeline			= registeredPipelineVector[rebuiltPipeline.pipelineId].pipeline;
+		retiredPipeline.retireGeneration	= currentPipelineGeneration;
+		retiredPipelineVector.push_back(retiredPipeline);
+
+		registeredPipelineVector[rebuiltPipeline.pipelineId].pipeline = rebuiltPipeline.pipeline;
+		swappedPipelinesCount++;
+	}
+	return true;
+}
+
+void SenShaderHotReloader::destroyRetiredPipelines(const uint64_t& generationAdoptedByAllSwapchainImages)
+{
+	for (size_t i = 0; i < retiredPipelineVector.size(); ) {
+		if (retiredPipelineVector[i].retireGeneration <= generationAdoptedByAllSwapchainImages) {
+			vkDestroyPipeline(m_LogicalDevice, retiredPipelineVector[i].pipeline, nullptr);
+			retiredPipelineVector[i] = retiredPipelineVector.back();
+			retiredPipelineVector.pop_back();
+		}
+		else {
+			i++;
+		}
+	}
+}
+
+void SenShaderHotReloader::watcherThreadLoop()
+{
+	while (!watcherThreadQuit) {
+		std::vector<std::string> changedFileVector = waitForChangedFiles();
+		if (changedFileVector.empty())
+			continue;
+
+		// Every pipeline that uses one of the changed files is rebuilt once
+		std::vector<uint32_t> affectedPipelineIdVector;
+		{
+			std::lock_guard<std::mutex> pipelineLock(pipelineMutex);
+			for (uint32_t pipelineId = 0; pipelineId < registeredPipelineVector.size(); pipelineId++) {
+				for (const auto& shaderDiskFileAddress : registeredPipelineVector[pipelineId].shaderDiskFileAddressVector) {
+					if (changedFileVector.end() != std::find(changedFileVector.begin(), changedFileVector.end(), shaderDiskFileAddress)) {
+						affectedPipelineIdVector.push_back(pipelineId);
+						break;
+					}
+				}
+			}
+		}
+		for (const auto& pipelineId : affectedPipelineIdVector)
+			rebuildPipeline(pipelineId);
+	}
+}
+
+std::vector<std::string> SenShaderHotReloader::waitForChangedFiles()
+{
+	std::vector<std::string> changedFileVector;
+#if defined( __linux )
+	pollfd inotifyPollFileDescriptor{};
+	inotifyPollFileDescriptor.fd		= inotifyFileDescriptor;
+	inotifyPollFileDescriptor.events	= POLLIN;
+	if (poll(&inotifyPollFileDescriptor, 1, 200) <= 0)	// wakes up regularly to check watcherThreadQuit
+		return changedFileVector;
+
+	// Editors often write in several steps, let the save settle and collect everything it produced
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	alignas(inotify_event) char eventBuffer[4096];
+	ssize_t readBytes;
+	while ((readBytes = read(inotifyFileDescriptor, eventBuffer, sizeof(eventBuffer))) > 0) {
+		for (char* eventPointer = eventBuffer; eventPointer < eventBuffer + readBytes; ) {
+			const inotify_event* fileEvent = reinterpret_cast<const inotify_event*>(eventPointer);
+			if (fileEvent->len > 0) {
+				std::string changedFile = m_WatchedDirectory + "/" + fileEvent->name;
+				if (changedFileVector.end() == std::find(changedFileVector.begin(), changedFileVector.end(), changedFile))
+					changedFileVector.push_back(changedFile);
+			}
+			eventPointer += sizeof(inotify_event) + fileEvent->len;
+		}
+	}
+#else
+	std::this_thread::sleep_for(std::chrono::milliseconds(250));
+
+	std::vector<std::string> watchedFileVector;
+	{
+		std::lock_guard<std::mutex> pipelineLock(pipelineMutex);
+		for (const auto& registeredPipeline : registeredPipelineVector)
+			watchedFileVector.insert(watchedFileVector.end(), registeredPipeline.shaderDiskFileAddressVector.begin(),
+				registeredPipeline.shaderDiskFileAddressVector.end());
+	}
+	for (const auto& watchedFile : watchedFileVector) {
+		struct stat fileStatus;
+		if (0 != stat(watchedFile.c_str(), &fileStatus))
+			continue;	// being replaced right now, caught on the next round
+
+		auto knownModificationTime = modificationTimeMap.find(watchedFile);
+		if (modificationTimeMap.end() == knownModificationTime) {
+			modificationTimeMap[watchedFile] = fileStatus.st_mtime;	// first sight, the registered pipeline is up to date
+		}
+		else if (knownModificationTime->second != fileStatus.st_mtime) {
+			knownModificationTime->second = fileStatus.st_mtime;
+			if (changedFileVector.end() == std::find(changedFileVector.begin(), changedFileVector.end(), watchedFile))
+				changedFileVector.push_back(watchedFile);
+		}
+	}
+#endif
+	return changedFileVector;
+}
+
+void SenShaderHotReloader::rebuildPipeline(const uint32_t& pipelineId)
+{
+	RegisteredPipelineStruct registeredPipeline{};
+	{
+		std::lock_guard<std::mutex> pipelineLock(pipelineMutex);
+		registeredPipeline.shaderDiskFileAddressVector	= registeredPipelineVector[pipelineId].shaderDiskFileAddressVector;
+		registeredPipeline.pipelineBuilder				= registeredPipelineVector[pipelineId].pipelineBuilder;
+	}
+
+	std::ostringstream reportStream;
+	/****************************************************************************************************************************/
+	/**********     Recompile every stage, any error keeps the last good pipeline      ******************************************/
+	/****************************************************************************************************************************/
+	std::vector<std::vector<uint32_t>> spirvVector;
+	bool allStagesCompiled = true;
+	for (const auto& shaderDiskFileAddress : registeredPipeline.shaderDiskFileAddressVector) {
+		spirvVector.emplace_back();
+		try {
+			spirvVector.back() = SLVK_AbstractGLFW::compileShaderToSPIRV(shaderDiskFileAddress);	// shaderc errors go to std::cerr
+		}
+		catch (const std::runtime_error&) {
+			// the file vanished between the event and the read, the next save brings it back
+		}
+		if (spirvVector.back().empty()) {
+			reportStream << "Shader hot-reload:  " << shaderDiskFileAddress << " failed to compile, keeping the last good pipeline\n";
+			allStagesCompiled = false;
+		}
+	}
+
+	VkPipeline pipeline = VK_NULL_HANDLE;
+	if (allStagesCompiled) {
+		try {
+			pipeline = buildPipeline(registeredPipeline, spirvVector);
+			reportStream << "Shader hot-reload:  pipeline " << pipelineId << " rebuilt, swapped in at the next frame\n";
+		}
+		catch (const std::runtime_error& buildError) {
+			reportStream << "Shader hot-reload:  pipeline " << pipelineId << " failed to build (" << buildError.what()
+				<< "), keeping the last good pipeline\n";
+		}
+	}
+
+	std::lock_guard<std::mutex> pipelineLock(pipelineMutex);
+	if (VK_NULL_HANDLE != pipeline) {
+		// A newer rebuild of the same pipeline replaces one that was never swapped in
+		for (auto& rebuiltPipeline : rebuiltPipelineQueue) {
+			if (rebuiltPipeline.pipelineId == pipelineId) {
+				vkDestroyPipeline(m_LogicalDevice, rebuiltPipeline.pipeline, nullptr);
+				rebuiltPipeline.pipeline = pipeline;
+				pipeline = VK_NULL_HANDLE;
+				break;
+			}
+		}
+		if (VK_NULL_HANDLE != pipeline) {
+			RebuiltPipelineStruct rebuiltPipeline{};
+			rebuiltPipeline.pipelineId	= pipelineId;
+			rebuiltPipeline.pipeline	= pipeline;
+			rebuiltPipelineQueue.push_back(rebuiltPipeline);
+		}
+	}
+	reportQueue.push_back(reportStream.str());
+}
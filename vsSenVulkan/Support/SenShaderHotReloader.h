@@ -0,0 +1,88 @@
+#pragma once
+
+#ifndef __SenShaderHotReloader__
+#define __SenShaderHotReloader__
+
+#include "SLVK_AbstractGLFW.h"
+
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <deque>
+
+/*
+	Shader hot-reload:  a watcher thread follows one shader directory (inotify on Linux, modification time polling
+	elsewhere), recompiles the GLSL of every registered pipeline that uses a changed file through
+	SLVK_AbstractGLFW::compileShaderToSPIRV(), and rebuilds that pipeline on the same thread with the shared VkPipelineCache.
+	Nothing reaches the renderer until swapRebuiltPipelines() is called at a frame boundary:  it publishes the new
+	pipelines and bumps pipelineGeneration(), the replaced ones are retired until every swapchain image re-recorded
+	with the new generation.  A compile or build error is reported and the last good pipeline stays in use.
+	The pipeline layout and render pass given to the builder must not change:  only shader code is reloaded.
+*/
+class SenShaderHotReloader
+{
+public:
+	// Called once on the registering thread, then on the watcher thread:  must only read state that stays constant
+	typedef std::function<VkPipeline(const VkPipelineCache& pipelineCache, const std::vector<VkShaderModule>& shaderModuleVector)> PipelineBuilderFunction;
+
+	SenShaderHotReloader(const VkDevice& logicalDevice, const std::string& watchedDirectory);
+	virtual ~SenShaderHotReloader();
+
+	// Builds the first pipeline right away;  initialSpirvVector (one per shader) skips compiling when the caller already has it
+	uint32_t registerPipeline(const std::vector<std::string>& shaderDiskFileAddressVector, const PipelineBuilderFunction& pipelineBuilder,
+		const std::vector<std::vector<uint32_t>>& initialSpirvVector = std::vector<std::vector<uint32_t>>());
+
+	// Render thread, once per frame boundary:  true when at least one pipeline was swapped in
+	bool swapRebuiltPipelines();
+	// Retired pipelines are destroyed once no swapchain image records a generation older than their retirement
+	void destroyRetiredPipelines(const uint64_t& generationAdoptedByAllSwapchainImages);
+
+	VkPipeline getPipeline(const uint32_t& pipelineId) const { return registeredPipelineVector[pipelineId].pipeline; }
+	uint64_t pipelineGeneration() const { return currentPipelineGeneration; }
+	VkPipelineCache pipelineCache() const { return m_PipelineCache; }
+	uint64_t reloadsCount() const { return swappedPipelinesCount; }
+
+private:
+	struct RegisteredPipelineStruct {
+		std::vector<std::string>		shaderDiskFileAddressVector;
+		PipelineBuilderFunction			pipelineBuilder;
+		VkPipeline						pipeline				= VK_NULL_HANDLE;	// render thread only
+	};
+	struct RebuiltPipelineStruct {
+		uint32_t						pipelineId				= 0;
+		VkPipeline						pipeline				= VK_NULL_HANDLE;
+	};
+	struct RetiredPipelineStruct {
+		VkPipeline						pipeline				= VK_NULL_HANDLE;
+		uint64_t						retireGeneration		= 0;
+	};
+
+	void watcherThreadLoop();
+	std::vector<std::string> waitForChangedFiles();
+	void rebuildPipeline(const uint32_t& pipelineId);
+	VkPipeline buildPipeline(const RegisteredPipelineStruct& registeredPipeline, const std::vector<std::vector<uint32_t>>& spirvVector);
+
+	VkDevice							m_LogicalDevice;
+	const std::string					m_WatchedDirectory;
+	VkPipelineCache						m_PipelineCache			= VK_NULL_HANDLE;
+
+	std::thread							watcherThread;
+	std::atomic<bool>					watcherThreadQuit;
+	std::mutex							pipelineMutex;			// guards registeredPipelineVector's shaders and builders, rebuiltPipelineQueue, reportQueue
+	std::deque<RegisteredPipelineStruct>	registeredPipelineVector;	// deque keeps references stable for the watcher thread
+	std::deque<RebuiltPipelineStruct>	rebuiltPipelineQueue;
+	std::deque<std::string>				reportQueue;			// printed by the render thread
+
+	std::vector<RetiredPipelineStruct>	retiredPipelineVector;	// render thread only
+	uint64_t							currentPipelineGeneration	= 1;
+	uint64_t							swappedPipelinesCount	= 0;
+
+#if defined( __linux )
+	int									inotifyFileDescriptor	= -1;
+#else
+	std::map<std::string, time_t>		modificationTimeMap;	// watcher thread only
+#endif
+};
+
+#endif // !__SenShaderHotReloader__
@@ -0,0 +1,440 @@
+#include "SenShaderReflection.h"
+
+#include <unordered_map>
+
+namespace {
+	// The handful of SPIR-V opcodes, decorations and storage classes the reflection needs (SPIR-V 1.0 specification)
+	enum SpirvOpcodeEnum {
+		SpvOpEntryPoint			= 15,
+		SpvOpTypeInt			= 21,
+		SpvOpTypeFloat			= 22,
+		SpvOpTypeVector			= 23,
+		SpvOpTypeMatrix			= 24,
+		SpvOpTypeImage			= 25,
+		SpvOpTypeSampler		= 26,
+		SpvOpTypeSampledImage	= 27,
+		SpvOpTypeArray			= 28,
+		SpvOpTypeRuntimeArray	= 29,
+		SpvOpTypeStruct			= 30,
+		SpvOpTypePointer		= 32,
+		SpvOpConstant			= 43,
+		SpvOpVariable			= 59,
+		SpvOpDecorate			= 71,
+		SpvOpMemberDecorate		= 72
+	};
+	enum SpirvDecorationEnum {
+		SpvDecorationBufferBlock	= 3,
+		SpvDecorationArrayStride	= 6,
+		SpvDecorationMatrixStride	= 7,
+		SpvDecorationBuiltIn		= 11,
+		SpvDecorationLocation		= 30,
+		SpvDecorationBinding		= 33,
+		SpvDecorationDescriptorSet	= 34,
+		SpvDecorationOffset			= 35
+	};
+	enum SpirvStorageClassEnum {
+		SpvStorageClassUniformConstant	= 0,
+		SpvStorageClassInput			= 1,
+		SpvStorageClassUniform			= 2,
+		SpvStorageClassPushConstant		= 9,
+		SpvStorageClassStorageBuffer	= 12
+	};
+	const uint32_t SpvMagicNumber		= 0x07230203;
+	const uint32_t SpvDimBuffer			= 5;
+	const uint32_t SpvDimSubpassData	= 6;
+
+	// Everything known about one result id
+	struct SpirvIdStruct {
+		uint32_t				opcode				= 0;
+		std::vector<uint32_t>	operandVector;		// operands after the result id
+		uint32_t				typeId				= 0;	// OpVariable / OpConstant result type
+		uint32_t				set					= 0;
+		uint32_t				binding				= UINT32_MAX;
+		uint32_t				location			= UINT32_MAX;
+		uint32_t				arrayStride			= 0;
+		bool					builtIn				= false;
+		bool					bufferBlock			= false;
+		std::vector<uint32_t>	memberOffsetVector;
+		std::vector<uint32_t>	memberMatrixStrideVector;
+		std::vector<bool>		memberBuiltInVector;
+	};
+	typedef std::unordered_map<uint32_t, SpirvIdStruct> SpirvIdMap;
+
+	void resizeMembers(SpirvIdStruct& spirvId, const uint32_t& member) {
+		if (spirvId.memberOffsetVector.size() <= member) {
+			spirvId.memberOffsetVector.resize(member + 1, 0);
+			spirvId.memberMatrixStrideVector.resize(member + 1, 0);
+			spirvId.memberBuiltInVector.resize(member + 1, false);
+		}
+	}
+
+	uint32_t arrayLength(const SpirvIdMap& idMap, const SpirvIdStruct& arrayType) {
+		auto lengthConstant = idMap.find(arrayType.operandVector[1]);
+		return (idMap.end() != lengthConstant && !lengthConstant->second.operandVector.empty()) ? lengthConstant->second.operandVector[0] : 1;
+	}
+
+	// Byte size of a type inside an explicitly laid out block (push constants)
+	uint32_t typeByteSize(const SpirvIdMap& idMap, const uint32_t& typeId, const uint32_t& matrixStride = 0) {
+		const SpirvIdStruct& type = idMap.at(typeId);
+		switch (type.opcode) {
+		case SpvOpTypeInt:
+		case SpvOpTypeFloat:
+			return type.operandVector[0] / 8;
+		case SpvOpTypeVector:
+			return type.operandVector[1] * typeByteSize(idMap, type.operandVector[0]);
+		case SpvOpTypeMatrix:
+			return type.operandVector[1] * (matrixStride > 0 ? matrixStride : typeByteSize(idMap, type.operandVector[0]));
+		case SpvOpTypeArray:
+			return arrayLength(idMap, type) * (type.arrayStride > 0 ? type.arrayStride : typeByteSize(idMap, type.operandVector[0], matrixStride));
+		case SpvOpTypeStruct: {
+			uint32_t structSize = 0;
+			for (uint32_t member = 0; member < type.operandVector.size(); member++) {
+				uint32_t memberOffset	= member < type.memberOffsetVector.size() ? type.memberOffsetVector[member] : 0;
+				uint32_t memberStride	= member < type.memberMatrixStrideVector.size() ? type.memberMatrixStrideVector[member] : 0;
+				structSize = (std::max)(structSize, memberOffset + typeByteSize(idMap, type.operandVector[member], memberStride));
+			}
+			return structSize;
+		}
+		default:
+			return 0;
+		}
+	}
+
+	VkFormat vertexInputFormat(const SpirvIdMap& idMap, const uint32_t& typeId) {
+		const SpirvIdStruct& type = idMap.at(typeId);
+		const SpirvIdStruct& scalar = (SpvOpTypeVector == type.opcode) ? idMap.at(type.operandVector[0]) : type;
+		const uint32_t componentsCount = (SpvOpTypeVector == type.opcode) ? type.operandVector[1] : 1;
+		if (32 != scalar.operandVector[0])
+			return VK_FORMAT_UNDEFINED;
+
+		static const VkFormat floatFormats[4]	= { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+		static const VkFormat sintFormats[4]	= { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+		static const VkFormat uintFormats[4]	= { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+		if (SpvOpTypeFloat == scalar.opcode)
+			return floatFormats[componentsCount - 1];
+		return (1 == scalar.operandVector[1]) ? sintFormats[componentsCount - 1] : uintFormats[componentsCount - 1];
+	}
+
+	const char* descriptorTypeName(const VkDescriptorType& descriptorType) {
+		switch (descriptorType) {
+		case VK_DESCRIPTOR_TYPE_SAMPLER:				return "sampler";
+		case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER:	return "combined image sampler";
+		case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:			return "sampled image";
+		case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE:			return "storage image";
+		case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER:	return "uniform texel buffer";
+		case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:	return "storage texel buffer";
+		case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER:			return "uniform buffer";
+		case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:			return "storage buffer";
+		case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:		return "input attachment";
+		default:										return "unknown";
+		}
+	}
+}
+
+SenShaderReflection::SenShaderReflection(const VkDevice& logicalDevice, SenDescriptorAllocator& layoutCache)
+	: m_LogicalDevice(logicalDevice), m_LayoutCache(layoutCache)
+{
+}
+
+SenShaderReflection::~SenShaderReflection()
+{
+	for (auto& cachedPipelineLayout : pipelineLayoutCache)
+		vkDestroyPipelineLayout(m_LogicalDevice, cachedPipelineLayout.second, nullptr);
+	pipelineLayoutCache.clear();
+	shaderCache.clear();
+
+	OutputDebugString("\n\t ~SenShaderReflection()\n");
+}
+
+SenShaderReflection::ReflectedShaderStruct SenShaderReflection::reflectSPIRV(const std::vector<uint32_t>& spirv32Vector)
+{
+	if (spirv32Vector.size() < 5 || SpvMagicNumber != spirv32Vector[0])
+		throw std::runtime_error("SenShaderReflection: not a SPIR-V module !");
+
+	ReflectedShaderStruct reflectedShader{};
+	SpirvIdMap idMap;
+	std::vector<uint32_t> variableIdVector;
+
+	/****************************************************************************************************************************/
+	/**********     One pass over the instructions:  types, constants, variables and their decorations     *********************/
+	/****************************************************************************************************************************/
+	for (size_t word = 5; word < spirv32Vector.size(); ) {
+		const uint32_t wordsCount	= spirv32Vector[word] >> 16;
+		const uint32_t opcode		= spirv32Vector[word] & 0xFFFF;
+		if (0 == wordsCount || word + wordsCount > spirv32Vector.size())
+			throw std::runtime_error("SenShaderReflection: truncated SPIR-V instruction !");
+		const uint32_t* operands = &spirv32Vector[word + 1];
+		const uint32_t operandsCount = wordsCount - 1;
+
+		switch (opcode) {
+		case SpvOpEntryPoint: {
+			static const VkShaderStageFlagBits executionModelStages[6] = { VK_SHADER_STAGE_VERTEX_BIT, VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT,
+				VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT, VK_SHADER_STAGE_GEOMETRY_BIT, VK_SHADER_STAGE_FRAGMENT_BIT, VK_SHADER_STAGE_COMPUTE_BIT };
+			if (operands[0] < 6)
+				reflectedShader.stage = executionModelStages[operands[0]];
+			break;
+		}
+		case SpvOpTypeInt:		case SpvOpTypeFloat:		case SpvOpTypeVector:	case SpvOpTypeMatrix:
+		case SpvOpTypeImage:	case SpvOpTypeSampler:		case SpvOpTypeSampledImage:
+		case SpvOpTypeArray:	case SpvOpTypeRuntimeArray:	case SpvOpTypeStruct:	case SpvOpTypePointer: {
+			SpirvIdStruct& type = idMap[operands[0]];
+			type.opcode = opcode;
+			type.operandVector.assign(operands + 1, operands + operandsCount);
+			break;
+		}
+		case SpvOpConstant:
+		case SpvOpVariable: {
+			SpirvIdStruct& value = idMap[operands[1]];
+			value.opcode = opcode;
+			value.typeId = operands[0];
+			value.operandVector.assign(operands + 2, operands + operandsCount);
+			if (SpvOpVariable == opcode)
+				variableIdVector.push_back(operands[1]);
+			break;
+		}
+		case SpvOpDecorate: {
+			SpirvIdStruct& target = idMap[operands[0]];
+			switch (operands[1]) {
+			case SpvDecorationBufferBlock:		target.bufferBlock	= true;			break;
+			case SpvDecorationArrayStride:		target.arrayStride	= operands[2];	break;
+			case SpvDecorationBuiltIn:			target.builtIn		= true;			break;
+			case SpvDecorationLocation:			target.location		= operands[2];	break;
+			case SpvDecorationBinding:			target.binding		= operands[2];	break;
+			case SpvDecorationDescriptorSet:	target.set			= operands[2];	break;
+			default: break;
+			}
+			break;
+		}
+		case SpvOpMemberDecorate: {
+			SpirvIdStruct& target = idMap[operands[0]];
+			resizeMembers(target, operands[1]);
+			switch (operands[2]) {
+			case SpvDecorationOffset:			target.memberOffsetVector[operands[1]]			= operands[3];	break;
+			case SpvDecorationMatrixStride:		target.memberMatrixStrideVector[operands[1]]	= operands[3];	break;
+			case SpvDecorationBuiltIn:			target.memberBuiltInVector[operands[1]]			= true;			break;
+			default: break;
+			}
+			break;
+		}
+		default:
+			break;
+		}
+		word += wordsCount;
+	}
+
+	/****************************************************************************************************************************/
+	/**********     Interface variables:  descriptors, push constant block, vertex inputs     **********************************/
+	/****************************************************************************************************************************/
+	for (const auto& variableId : variableIdVector) {
+		const SpirvIdStruct& variable	= idMap.at(variableId);
+		const SpirvIdStruct& pointer	= idMap.at(variable.typeId);
+		const uint32_t storageClass		= pointer.operandVector[0];
+		uint32_t pointeeTypeId			= pointer.operandVector[1];
+
+		if (SpvStorageClassPushConstant == storageClass) {
+			reflectedShader.pushConstantSize = (std::max)(reflectedShader.pushConstantSize, typeByteSize(idMap, pointeeTypeId));
+		}
+		else if (SpvStorageClassInput == storageClass && VK_SHADER_STAGE_VERTEX_BIT == reflectedShader.stage) {
+			const SpirvIdStruct& inputType = idMap.at(pointeeTypeId);
+			if (variable.builtIn || UINT32_MAX == variable.location || SpvOpTypeStruct == inputType.opcode)
+				continue;
+			// A matrix input takes one location per column
+			const bool isMatrix = (SpvOpTypeMatrix == inputType.opcode);
+			const uint32_t columnTypeId = isMatrix ? inputType.operandVector[0] : pointeeTypeId;
+			const uint32_t columnsCount = isMatrix ? inputType.operandVector[1] : 1;
+			for (uint32_t column = 0; column < columnsCount; column++) {
+				VertexInputStruct vertexInput{};
+				vertexInput.location	= variable.location + column;
+				vertexInput.format		= vertexInputFormat(idMap, columnTypeId);
+				vertexInput.byteSize	= typeByteSize(idMap, columnTypeId);
+				reflectedShader.vertexInputVector.push_back(vertexInput);
+			}
+		}
+		else if (SpvStorageClassUniformConstant == storageClass || SpvStorageClassUniform == storageClass
+			|| SpvStorageClassStorageBuffer == storageClass) {
+			if (UINT32_MAX == variable.binding)
+				continue;
+
+			DescriptorBindingStruct descriptorBinding{};
+			descriptorBinding.set								= variable.set;
+			descriptorBinding.layoutBinding.binding				= variable.binding;
+			descriptorBinding.layoutBinding.descriptorCount		= 1;
+			descriptorBinding.layoutBinding.stageFlags			= reflectedShader.stage;
+			descriptorBinding.layoutBinding.pImmutableSamplers	= nullptr;
+
+			const SpirvIdStruct* pointeeType = &idMap.at(pointeeTypeId);
+			if (SpvOpTypeArray == pointeeType->opcode || SpvOpTypeRuntimeArray == pointeeType->opcode) {
+				if (SpvOpTypeArray == pointeeType->opcode)
+					descriptorBinding.layoutBinding.descriptorCount = arrayLength(idMap, *pointeeType);
+				pointeeTypeId	= pointeeType->operandVector[0];
+				pointeeType		= &idMap.at(pointeeTypeId);
+			}
+
+			switch (pointeeType->opcode) {
+			case SpvOpTypeSampledImage:
+				descriptorBinding.layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+				break;
+			case SpvOpTypeSampler:
+				descriptorBinding.layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+				break;
+			case SpvOpTypeImage: {
+				// operands:  sampled type, Dim, Depth, Arrayed, MS, Sampled (1 = with sampler, 2 = storage), Format
+				const bool isStorage = (2 == pointeeType->operandVector[5]);
+				if (SpvDimBuffer == pointeeType->operandVector[1])
+					descriptorBinding.layoutBinding.descriptorType = isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER;
+				else if (SpvDimSubpassData == pointeeType->operandVector[1])
+					descriptorBinding.layoutBinding.descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT;
+				else
+					descriptorBinding.layoutBinding.descriptorType = isStorage ? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+				break;
+			}
+			case SpvOpTypeStruct:
+				descriptorBinding.layoutBinding.descriptorType = (SpvStorageClassStorageBuffer == storageClass || pointeeType->bufferBlock)
+					? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+				break;
+			default:
+				continue;
+			}
+			reflectedShader.descriptorBindingVector.push_back(descriptorBinding);
+		}
+	}
+
+	std::sort(reflectedShader.vertexInputVector.begin(), reflectedShader.vertexInputVector.end(),
+		[](const VertexInputStruct& a, const VertexInputStruct& b) { return a.location < b.location; });
+	return reflectedShader;
+}
+
+const SenShaderReflection::ReflectedShaderStruct& SenShaderReflection::loadShader(const std::string& diskFileAddress)
+{
+	auto cachedShader = shaderCache.find(diskFileAddress);
+	if (shaderCache.end() != cachedShader)
+		return cachedShader->second;
+
+	std::vector<uint32_t> spirv32Vector = SLVK_AbstractGLFW::compileShaderToSPIRV(diskFileAddress);
+	if (spirv32Vector.empty())
+		throw std::runtime_error("failed to compile shader " + diskFileAddress + " !");
+
+	ReflectedShaderStruct reflectedShader = reflectSPIRV(spirv32Vector);
+	reflectedShader.diskFileAddress	= diskFileAddress;
+	reflectedShader.spirv32Vector	= std::move(spirv32Vector);
+	return shaderCache[diskFileAddress] = std::move(reflectedShader);
+}
+
+void SenShaderReflection::createShaderModule(const std::string& diskFileAddress, VkShaderModule& shaderModule)
+{
+	SLVK_AbstractGLFW::createVulkanShaderModule(m_LogicalDevice, loadShader(diskFileAddress).spirv32Vector, shaderModule);
+}
+
+void SenShaderReflection::invalidateShader(const std::string& diskFileAddress)
+{
+	shaderCache.erase(diskFileAddress);
+}
+
+SenShaderReflection::ReflectedProgramStruct SenShaderReflection::buildProgram(const std::vector<std::string>& shaderDiskFileAddressVector)
+{
+	ReflectedProgramStruct reflectedProgram{};
+
+	/****************************************************************************************************************************/
+	/**********     Merge every stage's bindings per set, a binding used by several stages gets all their stage flags     ******/
+	/****************************************************************************************************************************/
+	std::map<uint32_t, std::map<uint32_t, VkDescriptorSetLayoutBinding>> setBindingMap;
+	std::map<uint32_t, std::map<uint32_t, std::string>> bindingOwnerMap;		// for the mismatch message
+	uint32_t pushConstantSize = 0;
+	VkShaderStageFlags pushConstantStageFlags = 0;
+
+	for (const auto& shaderDiskFileAddress : shaderDiskFileAddressVector) {
+		const ReflectedShaderStruct& reflectedShader = loadShader(shaderDiskFileAddress);
+
+		for (const auto& descriptorBinding : reflectedShader.descriptorBindingVector) {
+			auto& bindingMap = setBindingMap[descriptorBinding.set];
+			auto mergedBinding = bindingMap.find(descriptorBinding.layoutBinding.binding);
+			if (bindingMap.end() == mergedBinding) {
+				bindingMap[descriptorBinding.layoutBinding.binding] = descriptorBinding.layoutBinding;
+				bindingOwnerMap[descriptorBinding.set][descriptorBinding.layoutBinding.binding] = shaderDiskFileAddress;
+				continue;
+			}
+			if (mergedBinding->second.descriptorType != descriptorBinding.layoutBinding.descriptorType
+				|| mergedBinding->second.descriptorCount != descriptorBinding.layoutBinding.descriptorCount) {
+				std::ostringstream stream;
+				stream << "Descriptor mismatch at set " << descriptorBinding.set << ", binding " << descriptorBinding.layoutBinding.binding << ":  "
+					<< bindingOwnerMap[descriptorBinding.set][descriptorBinding.layoutBinding.binding] << " declares "
+					<< descriptorTypeName(mergedBinding->second.descriptorType) << " x" << mergedBinding->second.descriptorCount << ",  "
+					<< shaderDiskFileAddress << " declares " << descriptorTypeName(descriptorBinding.layoutBinding.descriptorType)
+					<< " x" << descriptorBinding.layoutBinding.descriptorCount << " !";
+				throw std::runtime_error(stream.str());
+			}
+			mergedBinding->second.stageFlags |= descriptorBinding.layoutBinding.stageFlags;
+		}
+
+		if (reflectedShader.pushConstantSize > 0) {
+			pushConstantSize = (std::max)(pushConstantSize, reflectedShader.pushConstantSize);
+			pushConstantStageFlags |= reflectedShader.stage;
+		}
+
+		if (VK_SHADER_STAGE_VERTEX_BIT == reflectedShader.stage) {
+			uint32_t offset = 0;
+			for (const auto& vertexInput : reflectedShader.vertexInputVector) {
+				VkVertexInputAttributeDescription vertexInputAttributeDescription{};
+				vertexInputAttributeDescription.location	= vertexInput.location;
+				vertexInputAttributeDescription.binding		= 0;
+				vertexInputAttributeDescription.format		= vertexInput.format;
+				vertexInputAttributeDescription.offset		= offset;
+				reflectedProgram.vertexInputAttributeDescriptionVector.push_back(vertexInputAttributeDescription);
+				offset += vertexInput.byteSize;
+			}
+			reflectedProgram.vertexInputBindingDescription.binding		= 0;
+			reflectedProgram.vertexInputBindingDescription.stride		= offset;
+			reflectedProgram.vertexInputBindingDescription.inputRate	= VK_VERTEX_INPUT_RATE_VERTEX;
+		}
+	}
+
+	/****************************************************************************************************************************/
+	/**********     Set layouts from the cache, sets skipped by the shaders get an empty layout     ****************************/
+	/****************************************************************************************************************************/
+	const uint32_t setsCount = setBindingMap.empty() ? 0 : setBindingMap.rbegin()->first + 1;
+	for (uint32_t set = 0; set < setsCount; set++) {
+		std::vector<VkDescriptorSetLayoutBinding> layoutBindingVector;
+		for (const auto& mergedBinding : setBindingMap[set])
+			layoutBindingVector.push_back(mergedBinding.second);
+		reflectedProgram.setLayoutVector.push_back(m_LayoutCache.getDescriptorSetLayout(layoutBindingVector));
+	}
+
+	if (pushConstantSize > 0) {
+		VkPushConstantRange pushConstantRange{};
+		pushConstantRange.stageFlags	= pushConstantStageFlags;
+		pushConstantRange.offset		= 0;
+		pushConstantRange.size			= pushConstantSize;
+		reflectedProgram.pushConstantRangeVector.push_back(pushConstantRange);
+	}
+
+	/****************************************************************************************************************************/
+	/**********     Pipeline layout, shared by every program with the same set layouts and push constant ranges     ************/
+	/****************************************************************************************************************************/
+	std::vector<uint64_t> signature;
+	for (const auto& setLayout : reflectedProgram.setLayoutVector)
+		signature.push_back((uint64_t)setLayout);
+	for (const auto& pushConstantRange : reflectedProgram.pushConstantRangeVector) {
+		signature.push_back((uint64_t)pushConstantRange.stageFlags);
+		signature.push_back(((uint64_t)pushConstantRange.offset << 32) | (uint64_t)pushConstantRange.size);
+	}
+
+	auto cachedPipelineLayout = pipelineLayoutCache.find(signature);
+	if (pipelineLayoutCache.end() != cachedPipelineLayout) {
+		reflectedProgram.pipelineLayout = cachedPipelineLayout->second;
+		return reflectedProgram;
+	}
+
+	VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo{};
+	pipelineLayoutCreateInfo.sType					= VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
+	pipelineLayoutCreateInfo.setLayoutCount			= (uint32_t)reflectedProgram.setLayoutVector.size();
+	pipelineLayoutCreateInfo.pSetLayouts			= reflectedProgram.setLayoutVector.data();
+	pipelineLayoutCreateInfo.pushConstantRangeCount	= (uint32_t)reflectedProgram.pushConstantRangeVector.size();
+	pipelineLayoutCreateInfo.pPushConstantRanges	= reflectedProgram.pushConstantRangeVector.data();
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreatePipelineLayout(m_LogicalDevice, &pipelineLayoutCreateInfo, nullptr, &reflectedProgram.pipelineLayout),
+		std::string("Failed to to create reflected pipeline layout !!!")
+	);
+	pipelineLayoutCache[signature] = reflectedProgram.pipelineLayout;
+	return reflectedProgram;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#ifndef __SenShaderReflection__
+#define __SenShaderReflection__
+
+#include "SLVK_AbstractGLFW.h"
+#include "SenDescriptorAllocator.h"
+
+#include <map>
+
+/*
+	SPIR-V reflection:  every shader is compiled once through SLVK_AbstractGLFW::compileShaderToSPIRV() and its SPIR-V is
+	cached together with what was read back from it:  descriptor bindings (set, binding, type, count), the push constant
+	block size and, for vertex shaders, the input locations and formats.
+	buildProgram() merges the stages of one pipeline into VkDescriptorSetLayouts (through SenDescriptorAllocator's layout
+	cache), push constant ranges and a VkPipelineLayout that is shared by every program with the same signature.
+	Vertex inputs are described as one interleaved, tightly packed binding in location order.
+*/
+class SenShaderReflection
+{
+public:
+	struct DescriptorBindingStruct {
+		uint32_t						set						= 0;
+		VkDescriptorSetLayoutBinding	layoutBinding			= {};
+	};
+	struct VertexInputStruct {
+		uint32_t						location				= 0;
+		VkFormat						format					= VK_FORMAT_UNDEFINED;
+		uint32_t						byteSize				= 0;
+	};
+	struct ReflectedShaderStruct {
+		std::string						diskFileAddress;
+		VkShaderStageFlagBits			stage					= VK_SHADER_STAGE_VERTEX_BIT;
+		std::vector<uint32_t>			spirv32Vector;
+		std::vector<DescriptorBindingStruct>	descriptorBindingVector;
+		uint32_t						pushConstantSize		= 0;
+		std::vector<VertexInputStruct>	vertexInputVector;		// vertex stage only, sorted by location
+	};
+	struct ReflectedProgramStruct {
+		std::vector<VkDescriptorSetLayout>	setLayoutVector;	// index == set, owned by the layout cache
+		std::vector<VkPushConstantRange>	pushConstantRangeVector;
+		VkPipelineLayout					pipelineLayout		= VK_NULL_HANDLE;	// owned by SenShaderReflection
+		VkVertexInputBindingDescription		vertexInputBindingDescription = {};
+		std::vector<VkVertexInputAttributeDescription>	vertexInputAttributeDescriptionVector;
+	};
+
+	SenShaderReflection(const VkDevice& logicalDevice, SenDescriptorAllocator& layoutCache);
+	virtual ~SenShaderReflection();
+
+	// Parse one SPIR-V module;  throws std::runtime_error on a malformed module
+	static ReflectedShaderStruct reflectSPIRV(const std::vector<uint32_t>& spirv32Vector);
+
+	// Compile and reflect on first use, then served from the cache
+	const ReflectedShaderStruct& loadShader(const std::string& diskFileAddress);
+	void createShaderModule(const std::string& diskFileAddress, VkShaderModule& shaderModule);
+	// Drop a cached shader so that the next loadShader() compiles it again;  built programs are not affected
+	void invalidateShader(const std::string& diskFileAddress);
+
+	// Throws when two stages disagree on the type of the same (set, binding)
+	ReflectedProgramStruct buildProgram(const std::vector<std::string>& shaderDiskFileAddressVector);
+
+	size_t pipelineLayoutsCount() const { return pipelineLayoutCache.size(); }
+
+private:
+	VkDevice									m_LogicalDevice;
+	SenDescriptorAllocator&						m_LayoutCache;
+
+	std::map<std::string, ReflectedShaderStruct>					shaderCache;
+	std::map<std::vector<uint64_t>, VkPipelineLayout>				pipelineLayoutCache;	// set layouts + push ranges
+};
+
+#endif // !__SenShaderReflection__
@@ -0,0 +1,320 @@
+#include "SenStagingRing.h"
+
+SenStagingRing::SenStagingRing(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+	const int32_t& uploadQueueFamilyIndex, SenQueueTimeline& uploadQueueTimeline, const VkDeviceSize& ringBytes)
+	: m_LogicalDevice(logicalDevice), uploadTimeline(uploadQueueTimeline), m_RingBytes(ringBytes), m_MaxChunkBytes(ringBytes / 4)
+{
+	if (m_MaxChunkBytes < m_RegionAlignment)
+		throw std::runtime_error("Staging ring is too small !!!");
+
+	VkCommandPoolCreateInfo commandPoolCreateInfo{};
+	commandPoolCreateInfo.sType				= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	commandPoolCreateInfo.queueFamilyIndex	= uploadQueueFamilyIndex;
+	commandPoolCreateInfo.flags				= VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;	// batch commandBuffers are re-recorded
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateCommandPool(m_LogicalDevice, &commandPoolCreateInfo, nullptr, &uploadCommandPool),
+		std::string("Failed to create staging ring commandPool !!!")
+	);
+
+	void* persistentMappedData = nullptr;
+	SLVK_AbstractGLFW::createPersistentMappedBuffer(m_LogicalDevice, m_RingBytes, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+		VK_SHARING_MODE_EXCLUSIVE, gpuMemoryProperties, ringBuffer, ringBufferMemory, persistentMappedData);
+	ringMappedBytes = static_cast<uint8_t*>(persistentMappedData);
+}
+
+SenStagingRing::~SenStagingRing()
+{
+	finish();
+
+	for (auto& batch : idleBatchVector) {
+		vkFreeCommandBuffers(m_LogicalDevice, uploadCommandPool, 1, &batch.commandBuffer);
+	}
+	idleBatchVector.clear();
+
+	if (VK_NULL_HANDLE != ringBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, ringBuffer, nullptr);
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, ringBufferMemory);	// always try to destroy before free, unmaps implicitly
+		ringBuffer			= VK_NULL_HANDLE;
+		ringBufferMemory	= VK_NULL_HANDLE;
+		ringMappedBytes		= nullptr;
+	}
+	if (VK_NULL_HANDLE != uploadCommandPool) {
+		vkDestroyCommandPool(m_LogicalDevice, uploadCommandPool, nullptr);
+		uploadCommandPool = VK_NULL_HANDLE;
+	}
+	OutputDebugString("\n\t ~SenStagingRing()\n");
+}
+
+void SenStagingRing::uploadToBuffer(const void* srcData, const VkDeviceSize& dataBytes, const VkBuffer& dstBuffer, const VkDeviceSize& dstOffset)
+{
+	const uint8_t* srcBytes = static_cast<const uint8_t*>(srcData);
+	for (VkDeviceSize uploadedOffset = 0; uploadedOffset < dataBytes; ) {
+		const VkDeviceSize chunkBytes = (std::min)(dataBytes - uploadedOffset, m_MaxChunkBytes);
+		const VkDeviceSize regionOffset = reserveRegion(chunkBytes);
+		memcpy(ringMappedBytes + regionOffset, srcBytes + uploadedOffset, static_cast<size_t>(chunkBytes));
+
+		PendingBufferCopyStruct pendingCopy;
+		pendingCopy.dstBuffer					= dstBuffer;
+		pendingCopy.bufferCopyRegion.srcOffset	= regionOffset;
+		pendingCopy.bufferCopyRegion.dstOffset	= dstOffset + uploadedOffset;
+		pendingCopy.bufferCopyRegion.size		= chunkBytes;
+		pendingBufferCopyVector.push_back(pendingCopy);
+
+		queuedCopiesCount++;
+		totalUploadedBytes	+= chunkBytes;
+		uploadedOffset		+= chunkBytes;
+	}
+}
+
+void SenStagingRing::uploadToImage(const void* srcData, const VkImage& dstImage, const VkFormat& imageFormat, const VkBufferImageCopy& imageRegion)
+{
+	uint32_t blockBytes = 4, blockExtent = 1;
+	SenStagingRing::texelBlockSize(imageFormat, blockBytes, blockExtent);
+
+	const VkDeviceSize rowBytes		= static_cast<VkDeviceSize>((imageRegion.imageExtent.width + blockExtent - 1) / blockExtent) * blockBytes;
+	const VkDeviceSize layerBytes	= rowBytes * ((imageRegion.imageExtent.height + blockExtent - 1) / blockExtent) * imageRegion.imageExtent.depth;
+	const uint8_t* srcBytes			= static_cast<const uint8_t*>(srcData);
+
+	if (layerBytes * imageRegion.imageSubresource.layerCount <= m_MaxChunkBytes) {
+		// The usual case:  the whole region in one copy
+		const VkDeviceSize regionBytes = layerBytes * imageRegion.imageSubresource.layerCount;
+		const VkDeviceSize regionOffset = reserveRegion(regionBytes);
+		memcpy(ringMappedBytes + regionOffset, srcBytes, static_cast<size_t>(regionBytes));
+
+		PendingImageCopyStruct pendingCopy;
+		pendingCopy.dstImage								= dstImage;
+		pendingCopy.bufferImageCopyRegion					= imageRegion;
+		pendingCopy.bufferImageCopyRegion.bufferOffset		= regionOffset;
+		pendingCopy.bufferImageCopyRegion.bufferRowLength	= 0;	// tightly packed
+		pendingCopy.bufferImageCopyRegion.bufferImageHeight	= 0;
+		pendingImageCopyVector.push_back(pendingCopy);
+
+		queuedCopiesCount++;
+		totalUploadedBytes += regionBytes;
+		return;
+	}
+
+	for (uint32_t layerIndex = 0; layerIndex < imageRegion.imageSubresource.layerCount; layerIndex++) {
+		VkBufferImageCopy layerRegion = imageRegion;
+		layerRegion.imageSubresource.baseArrayLayer	= imageRegion.imageSubresource.baseArrayLayer + layerIndex;
+		layerRegion.imageSubresource.layerCount		= 1;
+		uploadImageRows(srcBytes + layerIndex * layerBytes, dstImage, layerRegion, blockBytes, blockExtent);
+	}
+}
+
+void SenStagingRing::uploadImageRows(const uint8_t* srcData, const VkImage& dstImage, const VkBufferImageCopy& imageRegion,
+	const uint32_t& blockBytes, const uint32_t& blockExtent)
+{
+	if (imageRegion.imageExtent.depth != 1)
+		throw std::runtime_error("Staging ring can not chunk 3D image uploads, enlarge the ring !!!");
+
+	const uint32_t blockRowsCount	= (imageRegion.imageExtent.height + blockExtent - 1) / blockExtent;
+	const VkDeviceSize rowBytes		= static_cast<VkDeviceSize>((imageRegion.imageExtent.width + blockExtent - 1) / blockExtent) * blockBytes;
+	if (rowBytes > m_MaxChunkBytes)
+		throw std::runtime_error("One row of texel blocks is larger than a staging ring chunk, enlarge the ring !!!");
+	const uint32_t chunkBlockRows	= static_cast<uint32_t>(m_MaxChunkBytes / rowBytes);
+
+	for (uint32_t blockRow = 0; blockRow < blockRowsCount; blockRow += chunkBlockRows) {
+		const uint32_t rowsCount		= (std::min)(chunkBlockRows, blockRowsCount - blockRow);
+		const VkDeviceSize chunkBytes	= rowsCount * rowBytes;
+		const VkDeviceSize regionOffset	= reserveRegion(chunkBytes);
+		memcpy(ringMappedBytes + regionOffset, srcData + blockRow * rowBytes, static_cast<size_t>(chunkBytes));
+
+		PendingImageCopyStruct pendingCopy;
+		pendingCopy.dstImage								= dstImage;
+		pendingCopy.bufferImageCopyRegion					= imageRegion;
+		pendingCopy.bufferImageCopyRegion.bufferOffset		= regionOffset;
+		pendingCopy.bufferImageCopyRegion.bufferRowLength	= 0;
+		pendingCopy.bufferImageCopyRegion.bufferImageHeight	= 0;
+		pendingCopy.bufferImageCopyRegion.imageOffset.y		= imageRegion.imageOffset.y + static_cast<int32_t>(blockRow * blockExtent);
+		// The last block row may be partial, in texels the region ends exactly at the image edge
+		pendingCopy.bufferImageCopyRegion.imageExtent.height = (std::min)(rowsCount * blockExtent, imageRegion.imageExtent.height - blockRow * blockExtent);
+		pendingImageCopyVector.push_back(pendingCopy);
+
+		queuedCopiesCount++;
+		totalUploadedBytes += chunkBytes;
+	}
+}
+
+VkDeviceSize SenStagingRing::reserveRegion(const VkDeviceSize& regionBytes)
+{
+	const VkDeviceSize alignedBytes = (regionBytes + m_RegionAlignment - 1) / m_RegionAlignment * m_RegionAlignment;
+	while (true) {
+		retireCompletedBatches(false);
+		if (0 == usedBytes)
+			headOffset = tailOffset = 0;
+
+		// Free space is [head, end) + [0, tail) while head is ahead of tail, [head, tail) once head wrapped behind it
+		VkDeviceSize paddingBytes	= 0;
+		bool regionFits				= false;
+		if (0 == usedBytes || headOffset > tailOffset) {
+			if (m_RingBytes - headOffset >= alignedBytes)
+				regionFits = true;
+			else if (tailOffset >= alignedBytes) {
+				paddingBytes	= m_RingBytes - headOffset;	// skip the end of the ring, a region never wraps
+				regionFits		= true;
+			}
+		}
+		else if (headOffset < tailOffset)
+			regionFits = tailOffset - headOffset >= alignedBytes;
+
+		if (regionFits) {
+			const VkDeviceSize regionOffset = paddingBytes > 0 ? 0 : headOffset;
+			headOffset	= (regionOffset + alignedBytes) % m_RingBytes;
+			usedBytes	+= paddingBytes + alignedBytes;
+			queuedBytes	+= paddingBytes + alignedBytes;
+			return regionOffset;
+		}
+
+		// Ring full:  submit what is queued, such that its region can come back, then wait for the oldest batch
+		if (queuedBytes > 0)
+			flush();
+		if (inFlightBatchDeque.empty())
+			throw std::runtime_error("Staging ring region larger than the ring !!!");
+		retireCompletedBatches(true);
+		ringFullStallsCount++;
+	}
+}
+
+void SenStagingRing::retireCompletedBatches(const bool& waitForOldest)
+{
+	if (waitForOldest && !inFlightBatchDeque.empty())
+		uploadTimeline.waitUntil(inFlightBatchDeque.front().timelineValue);
+
+	const uint64_t completedTimelineValue = uploadTimeline.completedValue();
+	while (!inFlightBatchDeque.empty() && inFlightBatchDeque.front().timelineValue <= completedTimelineValue) {
+		BatchStruct& batch = inFlightBatchDeque.front();
+		tailOffset	= batch.ringEndOffset;
+		usedBytes	-= batch.consumedBytes;
+		idleBatchVector.push_back(batch);
+		inFlightBatchDeque.pop_front();
+	}
+}
+
+SenStagingRing::BatchStruct SenStagingRing::acquireBatch()
+{
+	BatchStruct batch;
+	if (!idleBatchVector.empty()) {
+		batch = idleBatchVector.back();
+		idleBatchVector.pop_back();
+		vkResetCommandBuffer(batch.commandBuffer, 0);
+		return batch;
+	}
+
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+	commandBufferAllocateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.commandPool			= uploadCommandPool;
+	commandBufferAllocateInfo.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount	= 1;
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateCommandBuffers(m_LogicalDevice, &commandBufferAllocateInfo, &batch.commandBuffer),
+		std::string("Failed to allocate staging ring commandBuffer !!!")
+	);
+	return batch;
+}
+
+void SenStagingRing::transitionImageLayout(const VkImage& image, const VkImageSubresourceRange& subresourceRange,
+	const VkImageLayout& oldImageLayout, const VkImageLayout& newImageLayout)
+{
+	if (VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL == newImageLayout)
+		preCopyBarrierBatch.addImageLayoutTransition(image, subresourceRange, oldImageLayout, newImageLayout);
+	else
+		postCopyBarrierBatch.addImageLayoutTransition(image, subresourceRange, oldImageLayout, newImageLayout);
+}
+
+uint64_t SenStagingRing::flush()
+{
+	const bool copiesQueued = !pendingBufferCopyVector.empty() || !pendingImageCopyVector.empty();
+	if (!copiesQueued && preCopyBarrierBatch.empty() && postCopyBarrierBatch.empty()) return lastBatchTimelineValue;
+
+	BatchStruct batch = acquireBatch();
+
+	VkCommandBufferBeginInfo commandBufferBeginInfo{};
+	commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(batch.commandBuffer, &commandBufferBeginInfo);
+	preCopyBarrierBatch.flush(batch.commandBuffer);
+
+	// Coalesce:  one vkCmdCopyBuffer / vkCmdCopyBufferToImage per destination, with all of its regions
+	std::stable_sort(pendingBufferCopyVector.begin(), pendingBufferCopyVector.end(),
+		[](const PendingBufferCopyStruct& lhs, const PendingBufferCopyStruct& rhs) { return lhs.dstBuffer < rhs.dstBuffer; });
+	std::vector<VkBufferCopy> bufferCopyRegionVector;
+	for (size_t copyIndex = 0; copyIndex < pendingBufferCopyVector.size(); copyIndex++) {
+		bufferCopyRegionVector.push_back(pendingBufferCopyVector[copyIndex].bufferCopyRegion);
+		if (copyIndex + 1 == pendingBufferCopyVector.size() || pendingBufferCopyVector[copyIndex + 1].dstBuffer != pendingBufferCopyVector[copyIndex].dstBuffer) {
+			vkCmdCopyBuffer(batch.commandBuffer, ringBuffer, pendingBufferCopyVector[copyIndex].dstBuffer,
+				static_cast<uint32_t>(bufferCopyRegionVector.size()), bufferCopyRegionVector.data());
+			bufferCopyRegionVector.clear();
+		}
+	}
+	std::stable_sort(pendingImageCopyVector.begin(), pendingImageCopyVector.end(),
+		[](const PendingImageCopyStruct& lhs, const PendingImageCopyStruct& rhs) { return lhs.dstImage < rhs.dstImage; });
+	std::vector<VkBufferImageCopy> bufferImageCopyRegionVector;
+	for (size_t copyIndex = 0; copyIndex < pendingImageCopyVector.size(); copyIndex++) {
+		bufferImageCopyRegionVector.push_back(pendingImageCopyVector[copyIndex].bufferImageCopyRegion);
+		if (copyIndex + 1 == pendingImageCopyVector.size() || pendingImageCopyVector[copyIndex + 1].dstImage != pendingImageCopyVector[copyIndex].dstImage) {
+			vkCmdCopyBufferToImage(batch.commandBuffer, ringBuffer, pendingImageCopyVector[copyIndex].dstImage, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+				static_cast<uint32_t>(bufferImageCopyRegionVector.size()), bufferImageCopyRegionVector.data());
+			bufferImageCopyRegionVector.clear();
+		}
+	}
+
+	// Make the copies available and visible to whatever is submitted after this batch on the same queue,
+	//   in the same vkCmdPipelineBarrier as the queued transitions out of TRANSFER_DST_OPTIMAL
+	if (copiesQueued)
+		postCopyBarrierBatch.addMemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_MEMORY_READ_BIT,
+			VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+	postCopyBarrierBatch.flush(batch.commandBuffer);
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkEndCommandBuffer(batch.commandBuffer),
+		std::string("Failed to record staging ring commandBuffer !!!")
+	);
+
+	batch.timelineValue	= uploadTimeline.submit(batch.commandBuffer);
+	lastBatchTimelineValue	= batch.timelineValue;
+
+	batch.ringEndOffset	= headOffset;
+	batch.consumedBytes	= queuedBytes;
+	inFlightBatchDeque.push_back(batch);
+	queuedBytes			= 0;
+	submittedBatchesCount++;
+
+	pendingBufferCopyVector.clear();
+	pendingImageCopyVector.clear();
+	return lastBatchTimelineValue;
+}
+
+void SenStagingRing::finish()
+{
+	flush();
+	while (!inFlightBatchDeque.empty())
+		retireCompletedBatches(true);
+}
+
+void SenStagingRing::texelBlockSize(const VkFormat& imageFormat, uint32_t& blockBytes, uint32_t& blockExtent)
+{
+	switch (imageFormat) {
+	case VK_FORMAT_BC1_RGB_UNORM_BLOCK:	case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
+	case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:	case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
+	case VK_FORMAT_BC4_UNORM_BLOCK:		case VK_FORMAT_BC4_SNORM_BLOCK:
+	case VK_FORMAT_EAC_R11_UNORM_BLOCK:	case VK_FORMAT_EAC_R11_SNORM_BLOCK:
+		blockBytes = 8;		blockExtent = 4;	break;
+	case VK_FORMAT_BC2_UNORM_BLOCK:		case VK_FORMAT_BC2_SRGB_BLOCK:
+	case VK_FORMAT_BC3_UNORM_BLOCK:		case VK_FORMAT_BC3_SRGB_BLOCK:
+	case VK_FORMAT_BC5_UNORM_BLOCK:		case VK_FORMAT_BC5_SNORM_BLOCK:
+	case VK_FORMAT_BC7_UNORM_BLOCK:		case VK_FORMAT_BC7_SRGB_BLOCK:
+		blockBytes = 16;	blockExtent = 4;	break;
+	case VK_FORMAT_R8_UNORM:
+		blockBytes = 1;		blockExtent = 1;	break;
+	case VK_FORMAT_R8G8_UNORM:
+		blockBytes = 2;		blockExtent = 1;	break;
+	case VK_FORMAT_R16G16B16A16_SFLOAT:
+		blockBytes = 8;		blockExtent = 1;	break;
+	case VK_FORMAT_R32G32B32A32_SFLOAT:
+		blockBytes = 16;	blockExtent = 1;	break;
+	default:	// R8G8B8A8 / B8G8R8A8 and the other 32 bit formats used here
+		blockBytes = 4;		blockExtent = 1;	break;
+	}
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#ifndef __SenStagingRing__
+#define __SenStagingRing__
+
+#include "SLVK_AbstractGLFW.h"
+#include "SenQueueTimeline.h"
+#include "SenBarrierBatch.h"
+
+#include <deque>
+
+class SenHostImageCopy;
+
+/*
+	One persistently mapped, host coherent staging buffer shared by every upload, used as a ring:
+	uploadToBuffer() / uploadToImage() memcpy the source into the next free region right away (the caller may free
+	its data on return) and queue the copy;  flush() records all queued copies into one commandBuffer, grouped by
+	destination, and submits it through the upload queue's SenQueueTimeline.  The batch's timeline value tracks the ring
+	region it consumed, the region is reused once that value completed.  When the ring is full the queued copies are flushed and the oldest batch is
+	waited on, uploads larger than a quarter of the ring are cut into chunks (buffers by bytes, images by layer and
+	block rows) so they stream through it.
+	Each batch ends with a transfer write -> memory read barrier, so any later submission on the upload queue sees
+	the data without a vkQueueWaitIdle.  Nothing orders a batch after earlier reads:  a buffer updated every frame
+	(the MVP uniform) gets one region per swapchain image, written only once that image's frame completed.
+	Image layout transitions queued with transitionImageLayout() go into the same
+	batch, merged into one barrier ahead of the copies and one after them, so a whole texture upload is one submit.
+	Not thread safe, one ring per submitting thread.
+*/
+class SenStagingRing
+{
+public:
+	SenStagingRing(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+		const int32_t& uploadQueueFamilyIndex, SenQueueTimeline& uploadQueueTimeline, const VkDeviceSize& ringBytes);
+	virtual ~SenStagingRing();
+
+	void uploadToBuffer(const void* srcData, const VkDeviceSize& dataBytes, const VkBuffer& dstBuffer, const VkDeviceSize& dstOffset = 0);
+	// srcData is tightly packed, layer after layer;  imageRegion.bufferOffset/RowLength/ImageHeight are ignored
+	void uploadToImage(const void* srcData, const VkImage& dstImage, const VkFormat& imageFormat, const VkBufferImageCopy& imageRegion);
+	// Recorded by the next flush():  transitions into TRANSFER_DST_OPTIMAL ahead of the batch's copies, any other after them;
+	//   queue the transition out of TRANSFER_DST_OPTIMAL after the last uploadToImage() of that image
+	void transitionImageLayout(const VkImage& image, const VkImageSubresourceRange& subresourceRange,
+		const VkImageLayout& oldImageLayout, const VkImageLayout& newImageLayout);
+
+	// Submits every copy queued since the last flush as one batch and returns its timeline value;  nothing queued
+	//   returns the value of the last batch (0 before the first), which is just as good to wait on
+	uint64_t flush();
+	// flush() and wait until every batch completed
+	void finish();
+	// Timeline the batches are submitted on, for waiting on or polling a value flush() returned
+	SenQueueTimeline& queueTimeline() const { return uploadTimeline; }
+
+	// Bytes per texel block and block width/height (1 for uncompressed formats)
+	static void texelBlockSize(const VkFormat& imageFormat, uint32_t& blockBytes, uint32_t& blockExtent);
+
+	VkDeviceSize ringSize() const { return m_RingBytes; }
+	uint64_t batchesCount() const { return submittedBatchesCount; }
+	uint64_t copiesCount() const { return queuedCopiesCount; }
+	uint64_t stallsCount() const { return ringFullStallsCount; }
+	VkDeviceSize uploadedBytes() const { return totalUploadedBytes; }
+
+	// Texture loaders write straight into the image through it where supportsImage(), nullptr:  everything goes through the ring
+	void setHostImageCopy(SenHostImageCopy* hostImageCopy) { attachedHostImageCopy = hostImageCopy; }
+	SenHostImageCopy* hostImageCopy() const { return attachedHostImageCopy; }
+
+private:
+	struct PendingBufferCopyStruct {
+		VkBuffer						dstBuffer				= VK_NULL_HANDLE;
+		VkBufferCopy					bufferCopyRegion{};
+	};
+	struct PendingImageCopyStruct {
+		VkImage							dstImage				= VK_NULL_HANDLE;
+		VkBufferImageCopy				bufferImageCopyRegion{};
+	};
+	struct BatchStruct {
+		VkCommandBuffer					commandBuffer			= VK_NULL_HANDLE;
+		uint64_t						timelineValue			= 0;
+		VkDeviceSize					ringEndOffset			= 0;	// tail moves here once timelineValue completed
+		VkDeviceSize					consumedBytes			= 0;	// including alignment and wrap-around padding
+	};
+
+	// Offset of a free ring region of regionBytes, flushing and waiting as long as the ring is full
+	VkDeviceSize reserveRegion(const VkDeviceSize& regionBytes);
+	// Returns the ring regions of completed batches;  waitForOldest blocks on the oldest in-flight batch first
+	void retireCompletedBatches(const bool& waitForOldest);
+	BatchStruct acquireBatch();
+	void uploadImageRows(const uint8_t* srcData, const VkImage& dstImage, const VkBufferImageCopy& imageRegion,
+		const uint32_t& blockBytes, const uint32_t& blockExtent);
+
+	VkDevice							m_LogicalDevice;
+	SenQueueTimeline&					uploadTimeline;
+	uint64_t							lastBatchTimelineValue	= 0;
+	const VkDeviceSize					m_RingBytes;
+	const VkDeviceSize					m_MaxChunkBytes;
+	const VkDeviceSize					m_RegionAlignment		= 16;	// multiple of every texel block size, and of 4 for bufferOffset
+	VkCommandPool						uploadCommandPool		= VK_NULL_HANDLE;
+
+	VkBuffer							ringBuffer				= VK_NULL_HANDLE;
+	VkDeviceMemory						ringBufferMemory		= VK_NULL_HANDLE;
+	uint8_t*							ringMappedBytes			= nullptr;
+	VkDeviceSize						headOffset				= 0;
+	VkDeviceSize						tailOffset				= 0;
+	VkDeviceSize						usedBytes				= 0;	// queued + in flight, padding included
+	VkDeviceSize						queuedBytes				= 0;	// part of usedBytes not submitted yet
+
+	std::vector<PendingBufferCopyStruct>	pendingBufferCopyVector;
+	std::vector<PendingImageCopyStruct>		pendingImageCopyVector;
+	SenBarrierBatch						preCopyBarrierBatch;
+	SenBarrierBatch						postCopyBarrierBatch;
+	std::deque<BatchStruct>				inFlightBatchDeque;		// submission order, oldest first
+	std::vector<BatchStruct>			idleBatchVector;
+
+	uint64_t							submittedBatchesCount	= 0;
+	uint64_t							queuedCopiesCount		= 0;
+	uint64_t							ringFullStallsCount		= 0;
+	VkDeviceSize						totalUploadedBytes		= 0;
+	SenHostImageCopy*					attachedHostImageCopy	= nullptr;	// not owned
+};
+
+#endif // !__SenStagingRing__
@@ -0,0 +1,198 @@
+#include "SenStartupPipeline.h"
+#include "SenJobSystem.h"
+
+#include <algorithm>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+#if defined( _WIN32 )
+#include <Windows.h>		// for OutputDebugString() function
+#endif
+
+SenStartupPipeline::SenStartupPipeline()
+{
+	pipelineStartTime = std::chrono::high_resolution_clock::now();
+}
+
+SenStartupPipeline::~SenStartupPipeline()
+{
+	// A worker must not outlive the objects its step captured
+	for (auto& step : stepVector) {
+		if (step->onWorkerThread && step->stepFuture.valid())
+			helpUntilReady(step->stepFuture);
+	}
+#if defined( _WIN32 )
+	OutputDebugString("\n\t ~SenStartupPipeline()\n");
+#endif
+}
+
+void SenStartupPipeline::runStep(const std::string& stepName, const std::function<void()>& stepFunction)
+{
+	std::unique_ptr<StepStruct> step(new StepStruct());
+	step->stepName		= stepName;
+	step->startTime		= std::chrono::high_resolution_clock::now();
+	stepVector.push_back(std::move(step));
+	StepStruct* mainStep = stepVector.back().get();
+
+	StepStruct* outerMainStep = runningMainStep;
+	mainStep->nestedInMainStep = nullptr != outerMainStep;
+	runningMainStep = mainStep;
+	try {
+		stepFunction();
+	}
+	catch (...) {
+		runningMainStep = outerMainStep;
+		throw;
+	}
+	runningMainStep = outerMainStep;
+
+	std::lock_guard<std::mutex> stepTimesLock(stepTimesMutex);
+	mainStep->endTime	= std::chrono::high_resolution_clock::now();
+	mainStep->joined	= true;
+}
+
+void SenStartupPipeline::launchStep(const std::string& stepName, const std::function<void()>& stepFunction)
+{
+	if (nullptr != findStep(stepName))
+		throw std::runtime_error("Startup step " + stepName + " was launched twice !!!");
+
+	std::unique_ptr<StepStruct> step(new StepStruct());
+	step->stepName			= stepName;
+	step->onWorkerThread	= true;
+	StepStruct* workerStep	= step.get();
+	stepVector.push_back(std::move(step));
+
+	// Runs on SenJobSystem::shared() like any other job;  the packaged_task keeps the future (and its exception) for waitStep()
+	std::mutex* timesMutex = &stepTimesMutex;
+	std::shared_ptr<std::packaged_task<void()>> stepTask = std::make_shared<std::packaged_task<void()>>([workerStep, timesMutex, stepFunction]() {
+		{
+			std::lock_guard<std::mutex> stepTimesLock(*timesMutex);
+			workerStep->startTime = std::chrono::high_resolution_clock::now();
+		}
+		// endTime is taken even when the step throws, the exception itself reaches waitStep() through the future
+		struct EndTimeGuard {
+			StepStruct* guardedStep;	std::mutex* guardedMutex;
+			~EndTimeGuard() {
+				std::lock_guard<std::mutex> stepTimesLock(*guardedMutex);
+				guardedStep->endTime = std::chrono::high_resolution_clock::now();
+			}
+		} endTimeGuard{ workerStep, timesMutex };
+		stepFunction();
+	});
+	workerStep->stepFuture = stepTask->get_future().share();
+	SenJobSystem::shared().run([stepTask]() { (*stepTask)(); });
+}
+
+void SenStartupPipeline::waitStep(const std::string& stepName)
+{
+	StepStruct* workerStep = findStep(stepName);
+	if (nullptr == workerStep || !workerStep->onWorkerThread)
+		throw std::runtime_error("Startup step " + stepName + " was never launched !!!");
+
+	if (!workerStep->joined) {
+		TimePoint waitStartTime = std::chrono::high_resolution_clock::now();
+		helpUntilReady(workerStep->stepFuture);
+		double waitedMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - waitStartTime).count();
+
+		workerStep->joined				= true;
+		workerStep->waitedMilliseconds	= waitedMilliseconds;
+		if (nullptr != runningMainStep) {
+			runningMainStep->nestedWaitMilliseconds += waitedMilliseconds;
+			workerStep->waitedInsideMainStep = true;
+		}
+	}
+	workerStep->stepFuture.get();	// rethrows the exception of a failed step, every time it is waited
+}
+
+void SenStartupPipeline::helpUntilReady(const std::shared_future<void>& stepFuture)
+{
+	// With few cores shared() has a single worker, the waiting thread runs queued steps (or any job) instead of idling
+	while (std::future_status::ready != stepFuture.wait_for(std::chrono::seconds(0))) {
+		if (!SenJobSystem::shared().runQueuedJob())
+			stepFuture.wait_for(std::chrono::microseconds(200));
+	}
+}
+
+void SenStartupPipeline::waitAllSteps()
+{
+	for (auto& step : stepVector) {
+		if (step->onWorkerThread)
+			waitStep(step->stepName);
+	}
+}
+
+bool SenStartupPipeline::hasStep(const std::string& stepName) const
+{
+	return nullptr != findStep(stepName);
+}
+
+void SenStartupPipeline::markFirstFrame()
+{
+	if (firstFrameReached) return;
+	firstFrameTime		= std::chrono::high_resolution_clock::now();
+	firstFrameReached	= true;
+}
+
+double SenStartupPipeline::timeToFirstFrameMilliseconds() const
+{
+	return firstFrameReached ? millisecondsSinceStart(firstFrameTime) : 0.0;
+}
+
+std::string SenStartupPipeline::report() const
+{
+	std::lock_guard<std::mutex> stepTimesLock(stepTimesMutex);
+	const double firstFrameMilliseconds = firstFrameReached ? millisecondsSinceStart(firstFrameTime)
+		: millisecondsSinceStart(std::chrono::high_resolution_clock::now());
+
+	std::ostringstream stream;
+	stream << "Startup:  " << firstFrameMilliseconds << " ms to " << (firstFrameReached ? "first frame" : "now (no frame yet)") << "\n";
+
+	// Only top level main thread steps add up, nested ones are part of their parent's duration
+	double mainStepsMilliseconds = 0.0, mainWaitsMilliseconds = 0.0;
+	stream << "\t critical path (main thread):\n";
+	for (const auto& step : stepVector) {
+		if (step->onWorkerThread) {
+			if (step->joined && !step->waitedInsideMainStep && step->waitedMilliseconds > 0.0) {
+				stream << "\t\t wait " << step->stepName << ":\t" << step->waitedMilliseconds << " ms\n";
+				mainWaitsMilliseconds += step->waitedMilliseconds;
+			}
+			continue;
+		}
+		if (!step->joined || step->nestedInMainStep) continue;
+		double stepMilliseconds = std::chrono::duration<double, std::milli>(step->endTime - step->startTime).count();
+		stream << "\t\t " << step->stepName << ":\t" << stepMilliseconds << " ms";
+		if (step->nestedWaitMilliseconds > 0.0)
+			stream << " (" << step->nestedWaitMilliseconds << " ms of it waiting for workers)";
+		stream << "\n";
+		mainStepsMilliseconds += stepMilliseconds;
+	}
+	stream << "\t\t untracked:\t" << (std::max)(0.0, firstFrameMilliseconds - mainStepsMilliseconds - mainWaitsMilliseconds) << " ms\n";
+
+	stream << "\t overlapped (worker threads):\n";
+	for (const auto& step : stepVector) {
+		if (!step->onWorkerThread) continue;
+		if (std::future_status::ready != step->stepFuture.wait_for(std::chrono::seconds(0))) {
+			stream << "\t\t " << step->stepName << ":\t still running\n";
+			continue;
+		}
+		double stepMilliseconds = std::chrono::duration<double, std::milli>(step->endTime - step->startTime).count();
+		stream << "\t\t " << step->stepName << ":\t" << stepMilliseconds << " ms, "
+			<< (std::max)(0.0, stepMilliseconds - step->waitedMilliseconds) << " ms hidden behind the main thread\n";
+	}
+	return stream.str();
+}
+
+SenStartupPipeline::StepStruct* SenStartupPipeline::findStep(const std::string& stepName) const
+{
+	for (const auto& step : stepVector) {
+		if (step->stepName == stepName)
+			return step.get();
+	}
+	return nullptr;
+}
+
+double SenStartupPipeline::millisecondsSinceStart(const TimePoint& timePoint) const
+{
+	return std::chrono::duration<double, std::milli>(timePoint - pipelineStartTime).count();
+}
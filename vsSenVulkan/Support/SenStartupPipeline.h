@@ -0,0 +1,71 @@
+#pragma once
+
+#ifndef __SenStartupPipeline__
+#define __SenStartupPipeline__
+
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+	Startup steps and their timing, from the first step until markFirstFrame():
+	runStep() runs a step on the calling (main) thread, launchStep() runs it as a SenJobSystem::shared() job and
+	waitStep() joins it, running queued jobs meanwhile, and rethrows whatever the step threw.  Only the main thread
+	calls these functions.
+	report() breaks the time to first frame down along the main thread, which is the critical path:  its own steps,
+	the time it sat in waitStep() for a worker, and untracked time in between.  Worker steps are listed with the
+	part of their duration that ran hidden behind the main thread.
+	Steps launched but never waited are joined by the destructor (or waitAllSteps()).
+*/
+class SenStartupPipeline
+{
+public:
+	SenStartupPipeline();
+	virtual ~SenStartupPipeline();
+
+	void runStep(const std::string& stepName, const std::function<void()>& stepFunction);
+	void launchStep(const std::string& stepName, const std::function<void()>& stepFunction);
+	void waitStep(const std::string& stepName);
+	void waitAllSteps();
+	bool hasStep(const std::string& stepName) const;
+
+	// Ends the measurement, later steps are still run but not reported
+	void markFirstFrame();
+	bool firstFrameMarked() const { return firstFrameReached; }
+	double timeToFirstFrameMilliseconds() const;
+	std::string report() const;
+
+private:
+	typedef std::chrono::high_resolution_clock::time_point	TimePoint;
+
+	struct StepStruct {
+		std::string						stepName;
+		bool							onWorkerThread			= false;
+		TimePoint						startTime;
+		TimePoint						endTime;
+		std::shared_future<void>		stepFuture;				// worker steps only
+		bool							joined					= false;
+		bool							nestedInMainStep		= false;	// runStep() inside another main thread step
+		bool							waitedInsideMainStep	= false;
+		double							waitedMilliseconds		= 0.0;	// main thread blocked in waitStep()
+		double							nestedWaitMilliseconds	= 0.0;	// main steps:  waitStep() calls made inside them
+	};
+
+	StepStruct* findStep(const std::string& stepName) const;
+	// Runs queued SenJobSystem::shared() jobs on the calling thread until stepFuture is ready
+	static void helpUntilReady(const std::shared_future<void>& stepFuture);
+	double millisecondsSinceStart(const TimePoint& timePoint) const;
+
+	TimePoint							pipelineStartTime;
+	TimePoint							firstFrameTime;
+	bool								firstFrameReached		= false;
+	StepStruct*							runningMainStep			= nullptr;
+	std::vector<std::unique_ptr<StepStruct>>	stepVector;		// launch order, stable addresses for the workers
+	mutable std::mutex					stepTimesMutex;			// guards start/end times written by the workers
+};
+
+#endif // !__SenStartupPipeline__
@@ -0,0 +1,530 @@
+#include "SenStreamingLoader.h"
+#include "SenBarrierBatch.h"
+#include "SenMeshCodec.h"
+
+// Declarations only, the stb_image implementation lives in SLVK_AbstractGLFW.cpp
+#include <stb/stb_image.h>
+
+#include <algorithm>
+
+SenStreamingLoader::SenStreamingLoader(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+	const int32_t& uploadQueueFamilyIndex, SenQueueTimeline& uploadQueueTimeline, SenGeometryArena* meshGeometryArena)
+	: m_LogicalDevice(logicalDevice), m_PhysicalDeviceMemoryProperties(gpuMemoryProperties), uploadTimeline(uploadQueueTimeline)
+	, geometryArena(meshGeometryArena)
+{
+	VkCommandPoolCreateInfo commandPoolCreateInfo{};
+	commandPoolCreateInfo.sType				= VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	commandPoolCreateInfo.queueFamilyIndex	= uploadQueueFamilyIndex;
+	commandPoolCreateInfo.flags				= VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;	// one short lived command buffer per upload batch
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateCommandPool(m_LogicalDevice, &commandPoolCreateInfo, nullptr, &uploadCommandPool),
+		std::string("Failed to create streaming upload commandPool !!!")
+	);
+
+	loaderThread = std::thread(&SenStreamingLoader::loaderThreadLoop, this);
+}
+
+SenStreamingLoader::~SenStreamingLoader()
+{
+	{
+		std::lock_guard<std::mutex> assetLock(assetMutex);
+		loaderThreadQuit = true;
+	}
+	requestConditionVariable.notify_all();
+	if (loaderThread.joinable())
+		loaderThread.join();
+
+	/************************************************************************************************************/
+	/*********     Wait for the batches still in flight (the newest covers all), then destroy commandPool      ******/
+	/************************************************************************************************************/
+	if (!uploadBatchQueue.empty())
+		uploadTimeline.waitUntil(uploadBatchQueue.back().timelineValue);
+	uploadBatchQueue.clear();
+
+	if (VK_NULL_HANDLE != uploadCommandPool) {
+		vkDestroyCommandPool(m_LogicalDevice, uploadCommandPool, nullptr);	// frees the batch commandBuffers as well
+		uploadCommandPool = VK_NULL_HANDLE;
+	}
+	// Taken assets have already handed their device local resources over, only staging or untaken ones are left
+	for (auto& asset : streamedAssetDeque)
+		destroyAssetResources(asset);
+
+	OutputDebugString("\n\t ~SenStreamingLoader()\n");
+}
+
+uint32_t SenStreamingLoader::requestMesh(const std::string& objectDiskAddress, const bool& generateLodChain)
+{
+	uint32_t assetId;
+	{
+		std::lock_guard<std::mutex> assetLock(assetMutex);
+		assetId = (uint32_t)streamedAssetDeque.size();
+		streamedAssetDeque.emplace_back();
+		streamedAssetDeque.back().assetId			= assetId;
+		streamedAssetDeque.back().assetType			= ASSET_MESH;
+		streamedAssetDeque.back().diskAddress		= objectDiskAddress;
+		streamedAssetDeque.back().generateLodChain	= generateLodChain;
+		requestedAssetIdQueue.push_back(assetId);
+	}
+	requestConditionVariable.notify_one();
+	return assetId;
+}
+
+uint32_t SenStreamingLoader::requestTexture(const std::string& textureDiskAddress)
+{
+	uint32_t assetId;
+	{
+		std::lock_guard<std::mutex> assetLock(assetMutex);
+		assetId = (uint32_t)streamedAssetDeque.size();
+		streamedAssetDeque.emplace_back();
+		streamedAssetDeque.back().assetId		= assetId;
+		streamedAssetDeque.back().assetType		= ASSET_TEXTURE;
+		streamedAssetDeque.back().diskAddress	= textureDiskAddress;
+		requestedAssetIdQueue.push_back(assetId);
+	}
+	requestConditionVariable.notify_one();
+	return assetId;
+}
+
+bool SenStreamingLoader::takeMesh(const uint32_t& assetId, StreamedMeshStruct& meshToTake)
+{
+	std::lock_guard<std::mutex> assetLock(assetMutex);
+	if (assetId >= streamedAssetDeque.size() || streamedAssetDeque[assetId].assetType != ASSET_MESH)
+		throw std::runtime_error("takeMesh() with an id that was not returned by requestMesh() !!!");
+
+	StreamedAssetStruct& asset = streamedAssetDeque[assetId];
+	if (asset.assetState == ASSET_FAILED)
+		throw std::runtime_error("Failed to stream mesh " + asset.diskAddress + " !!!");
+	if (asset.assetState != ASSET_RESIDENT) return false;
+
+	meshToTake			= std::move(asset.mesh);
+	asset.mesh			= StreamedMeshStruct();
+	asset.assetState	= ASSET_TAKEN;
+	return true;
+}
+
+bool SenStreamingLoader::takeTexture(const uint32_t& assetId, StreamedTextureStruct& textureToTake)
+{
+	std::lock_guard<std::mutex> assetLock(assetMutex);
+	if (assetId >= streamedAssetDeque.size() || streamedAssetDeque[assetId].assetType != ASSET_TEXTURE)
+		throw std::runtime_error("takeTexture() with an id that was not returned by requestTexture() !!!");
+
+	StreamedAssetStruct& asset = streamedAssetDeque[assetId];
+	if (asset.assetState == ASSET_FAILED)
+		throw std::runtime_error("Failed to stream texture " + asset.diskAddress + " !!!");
+	if (asset.assetState != ASSET_RESIDENT) return false;
+
+	textureToTake		= asset.texture;
+	asset.texture		= StreamedTextureStruct();
+	asset.assetState	= ASSET_TAKEN;
+	return true;
+}
+
+bool SenStreamingLoader::isIdle()
+{
+	std::lock_guard<std::mutex> assetLock(assetMutex);
+	for (const auto& asset : streamedAssetDeque) {
+		if (asset.assetState == ASSET_REQUESTED || asset.assetState == ASSET_STAGED || asset.assetState == ASSET_UPLOADING)
+			return false;
+	}
+	return uploadBatchQueue.empty();
+}
+
+/****************************************************************************************************************************/
+/**********        Loader thread:  read + decode + fill staging, never touches the queue        *****************************/
+/****************************************************************************************************************************/
+void SenStreamingLoader::loaderThreadLoop()
+{
+	while (true) {
+		StreamedAssetStruct* ptrAsset = nullptr;
+		{
+			std::unique_lock<std::mutex> assetLock(assetMutex);
+			requestConditionVariable.wait(assetLock, [this] { return loaderThreadQuit || !requestedAssetIdQueue.empty(); });
+			if (loaderThreadQuit) return;
+
+			// Pointer stays valid while other requests are appended, std::deque never relocates its elements on push_back
+			ptrAsset = &streamedAssetDeque[requestedAssetIdQueue.front()];
+			requestedAssetIdQueue.pop_front();
+		}
+		StreamedAssetStruct& asset = *ptrAsset;
+
+		bool assetStaged = true;
+		auto stageStartTime = std::chrono::high_resolution_clock::now();
+		try {
+			if (asset.assetType == ASSET_MESH)	stageMesh(asset);
+			else								stageTexture(asset);
+		}
+		catch (const std::exception& e) {
+			std::cerr << "SenStreamingLoader:  " << asset.diskAddress << "  " << e.what() << std::endl;
+			destroyAssetResources(asset);
+			assetStaged = false;
+		}
+		auto stageEndTime = std::chrono::high_resolution_clock::now();
+
+		// The render thread owns the asset as soon as it is in stagedAssetIdQueue, so count the bytes before handing it over
+		VkDeviceSize stagedBytes = 0;
+		for (const auto& uploadCopy : asset.uploadCopyVector)
+			stagedBytes += uploadCopy.totalBytes;
+		{
+			std::lock_guard<std::mutex> assetLock(assetMutex);
+			asset.assetState = assetStaged ? ASSET_STAGED : ASSET_FAILED;
+			if (assetStaged) stagedAssetIdQueue.push_back(asset.assetId);
+		}
+		if (assetStaged) {
+			std::ostringstream stream;
+			stream << "\t SenStreamingLoader staged " << asset.diskAddress << ":  " << stagedBytes / 1024 << " KB in "
+				<< std::chrono::duration_cast<std::chrono::milliseconds>(stageEndTime - stageStartTime).count() << " ms\n";
+			std::cout << stream.str();
+		}
+	}
+}
+
+void SenStreamingLoader::stageMesh(StreamedAssetStruct& asset)
+{
+	StreamedMeshStruct& mesh = asset.mesh;
+	uint32_t verticesCount = 0, indicesCount = 0;
+
+	/****************************************************************************************************************************/
+	/**********   A .smc mesh without LOD chain is decoded straight into the staging memory, no CPU copy is kept   *************/
+	/****************************************************************************************************************************/
+	std::vector<uint8_t> encodedMesh;
+	const bool decodeIntoStaging = smcd::isCompressedMeshAddress(asset.diskAddress) && !asset.generateLodChain;
+	if (smcd::isCompressedMeshAddress(asset.diskAddress)) {
+		smcd::readMeshFile(asset.diskAddress.c_str(), encodedMesh);
+		smcd::readMeshHeader(encodedMesh.data(), encodedMesh.size(), verticesCount, indicesCount);
+		if (!decodeIntoStaging) {
+			mesh.vertexStructVector.resize(verticesCount);
+			mesh.indexVector.resize(indicesCount);
+			smcd::decodeMesh(encodedMesh.data(), encodedMesh.size(), mesh.vertexStructVector.data(), mesh.indexVector.data());
+		}
+	}else {
+		stobjl::populateVertexIndexVector(asset.diskAddress.c_str(), mesh.vertexStructVector, mesh.indexVector);
+		verticesCount	= (uint32_t)mesh.vertexStructVector.size();
+		indicesCount	= (uint32_t)mesh.indexVector.size();
+	}
+	if (0 == verticesCount || 0 == indicesCount)
+		throw std::runtime_error("Empty mesh !!!");
+
+	if (asset.generateLodChain) {
+		stobjl::generateLodChain(mesh.vertexStructVector, mesh.indexVector, mesh.lodLevelVector);
+		indicesCount = (uint32_t)mesh.indexVector.size();	// all levels back to back
+	}else {
+		LodLevelStruct fullLevel{};
+		fullLevel.firstIndex		= 0;
+		fullLevel.indexCount		= indicesCount;
+		fullLevel.objectSpaceError	= 0.0f;
+		mesh.lodLevelVector.push_back(fullLevel);
+	}
+
+	VkDeviceSize verticesBufferSize	= sizeof(VertexStruct) * verticesCount;
+	VkDeviceSize indicesBufferSize	= sizeof(uint32_t) * indicesCount;
+
+	/****************************************************************************************************************************/
+	/**********   A malformed .smc only throws in decodeMesh(), once everything below is allocated and mapped:  unmap and   ******/
+	/**********   give it all back here instead of leaving the arena ranges and the staging memory to the caller    *************/
+	/****************************************************************************************************************************/
+	void* data = nullptr;
+	try {
+		if (nullptr != geometryArena) {
+			mesh.vertexAllocation	= geometryArena->allocate(verticesCount, sizeof(VertexStruct));
+			mesh.indexAllocation	= geometryArena->allocate(indicesCount, sizeof(uint32_t));
+		}else {
+			SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, verticesBufferSize,
+				VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+				mesh.vertexBuffer, mesh.vertexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+			SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, indicesBufferSize,
+				VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+				mesh.indexBuffer, mesh.indexBufferMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+		}
+
+		/************************************************************************************************************************/
+		/**********     One staging buffer per asset:  vertices first, indices right behind     *********************************/
+		SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, verticesBufferSize + indicesBufferSize,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+			asset.stagingBuffer, asset.stagingBufferMemory, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		SLVK_AbstractGLFW::errorCheck(
+			vkMapMemory(m_LogicalDevice, asset.stagingBufferMemory, 0, verticesBufferSize + indicesBufferSize, 0, &data),
+			std::string("Failed to map the mesh staging memory !!!")
+		);
+		if (decodeIntoStaging) {
+			smcd::decodeMesh(encodedMesh.data(), encodedMesh.size(), static_cast<VertexStruct*>(data),
+				reinterpret_cast<uint32_t*>(static_cast<uint8_t*>(data) + verticesBufferSize));
+		}else {
+			memcpy(data, mesh.vertexStructVector.data(), (size_t)verticesBufferSize);
+			memcpy(static_cast<uint8_t*>(data) + verticesBufferSize, mesh.indexVector.data(), (size_t)indicesBufferSize);
+		}
+	}
+	catch (...) {
+		if (nullptr != data)
+			vkUnmapMemory(m_LogicalDevice, asset.stagingBufferMemory);
+		destroyAssetResources(asset);	// staging buffer, mesh buffers or arena ranges, whichever got allocated
+		throw;
+	}
+	vkUnmapMemory(m_LogicalDevice, asset.stagingBufferMemory);
+
+	UploadCopyStruct vertexCopy{};
+	vertexCopy.dstBuffer	= (nullptr != geometryArena) ? geometryArena->buffer() : mesh.vertexBuffer;
+	vertexCopy.dstOffset	= mesh.vertexAllocation.byteOffset;
+	vertexCopy.srcOffset	= 0;
+	vertexCopy.totalBytes	= verticesBufferSize;
+	asset.uploadCopyVector.push_back(vertexCopy);
+
+	UploadCopyStruct indexCopy{};
+	indexCopy.dstBuffer		= (nullptr != geometryArena) ? geometryArena->buffer() : mesh.indexBuffer;
+	indexCopy.dstOffset		= mesh.indexAllocation.byteOffset;
+	indexCopy.srcOffset		= verticesBufferSize;
+	indexCopy.totalBytes	= indicesBufferSize;
+	asset.uploadCopyVector.push_back(indexCopy);
+}
+
+void SenStreamingLoader::stageTexture(StreamedAssetStruct& asset)
+{
+	// Only stb decoded RGBA8 is streamed, KTX keeps going through SLVK_AbstractGLFW::createDeviceLocalTexture
+	StreamedTextureStruct& texture = asset.texture;
+	int actuallyTextureChannels = 0;
+	stbi_uc* ptrDiskTextureToUpload = stbi_load(asset.diskAddress.c_str(), &texture.width, &texture.height, &actuallyTextureChannels, STBI_rgb_alpha);
+	if (!ptrDiskTextureToUpload)
+		throw std::runtime_error("failed to load texture image!");
+
+	VkDeviceSize hostVisibleTextureDeviceSize = (VkDeviceSize)texture.width * texture.height * 4;	// 4 for RGBA
+	try {
+		SLVK_AbstractGLFW::createResourceBuffer(m_LogicalDevice, hostVisibleTextureDeviceSize,
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties,
+			asset.stagingBuffer, asset.stagingBufferMemory, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+	}
+	catch (...) {
+		stbi_image_free(ptrDiskTextureToUpload);
+		throw;
+	}
+	void* data;
+	vkMapMemory(m_LogicalDevice, asset.stagingBufferMemory, 0, hostVisibleTextureDeviceSize, 0, &data);
+	memcpy(data, ptrDiskTextureToUpload, (size_t)hostVisibleTextureDeviceSize);
+	vkUnmapMemory(m_LogicalDevice, asset.stagingBufferMemory);
+	stbi_image_free(ptrDiskTextureToUpload);
+
+	SLVK_AbstractGLFW::createResourceImage(m_LogicalDevice, texture.width, texture.height, VK_IMAGE_TYPE_2D,
+		VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, texture.image
+		, texture.imageMemory, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, VK_SHARING_MODE_EXCLUSIVE, m_PhysicalDeviceMemoryProperties, 1);
+
+	VkImageViewCreateInfo textureImageViewCreateInfo{};
+	textureImageViewCreateInfo.sType							= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	textureImageViewCreateInfo.image							= texture.image;
+	textureImageViewCreateInfo.viewType							= VK_IMAGE_VIEW_TYPE_2D;
+	textureImageViewCreateInfo.format							= VK_FORMAT_R8G8B8A8_UNORM;
+	textureImageViewCreateInfo.subresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	textureImageViewCreateInfo.subresourceRange.baseMipLevel	= 0;
+	textureImageViewCreateInfo.subresourceRange.levelCount		= 1;
+	textureImageViewCreateInfo.subresourceRange.baseArrayLayer	= 0;
+	textureImageViewCreateInfo.subresourceRange.layerCount		= 1;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateImageView(m_LogicalDevice, &textureImageViewCreateInfo, nullptr, &texture.imageView),
+		std::string("Failed to create streamed texture Image View !!!")
+	);
+
+	UploadCopyStruct imageCopy{};
+	imageCopy.dstImage		= texture.image;
+	imageCopy.srcOffset		= 0;
+	imageCopy.totalBytes	= hostVisibleTextureDeviceSize;
+	imageCopy.imageWidth	= (uint32_t)texture.width;
+	imageCopy.imageHeight	= (uint32_t)texture.height;
+	asset.uploadCopyVector.push_back(imageCopy);
+}
+
+/****************************************************************************************************************************/
+/**********        Render thread:  budgeted copies, submitted without waiting, retired by timeline  *************************/
+/****************************************************************************************************************************/
+void SenStreamingLoader::pumpUploads(const VkDeviceSize& frameUploadByteBudget)
+{
+	retireUploadBatches();
+	lastFrameUploadBytes = 0;
+
+	std::vector<uint32_t> uploadAssetIdVector;
+	{
+		std::lock_guard<std::mutex> assetLock(assetMutex);
+		uploadAssetIdVector.assign(stagedAssetIdQueue.begin(), stagedAssetIdQueue.end());
+	}
+	if (uploadAssetIdVector.empty()) return;
+
+	VkCommandBufferAllocateInfo commandBufferAllocateInfo{};
+	commandBufferAllocateInfo.sType					= VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+	commandBufferAllocateInfo.commandPool			= uploadCommandPool;
+	commandBufferAllocateInfo.level					= VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+	commandBufferAllocateInfo.commandBufferCount	= 1;
+
+	UploadBatchStruct uploadBatch{};
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateCommandBuffers(m_LogicalDevice, &commandBufferAllocateInfo, &uploadBatch.commandBuffer),
+		std::string("Failed to allocate streaming upload commandBuffer !!!")
+	);
+	VkCommandBufferBeginInfo commandBufferBeginInfo{};
+	commandBufferBeginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+	commandBufferBeginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+	vkBeginCommandBuffer(uploadBatch.commandBuffer, &commandBufferBeginInfo);
+
+	VkImageSubresourceRange textureImageSubresourceRange{};
+	textureImageSubresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	textureImageSubresourceRange.baseMipLevel	= 0;
+	textureImageSubresourceRange.levelCount		= 1;
+	textureImageSubresourceRange.baseArrayLayer	= 0;
+	textureImageSubresourceRange.layerCount		= 1;
+
+	// Transitions out of TRANSFER_DST_OPTIMAL wait until the batch's copies are all recorded, then go out as one barrier
+	SenBarrierBatch finishedImagesBarrierBatch;
+
+	/****************************************************************************************************************************/
+	/**********   Walk the staged assets in order until the budget runs out; buffers split by bytes, images by whole rows   *****/
+	/**********   At least one piece goes out every frame, so an oversized budget miss never stalls the stream               *****/
+	/****************************************************************************************************************************/
+	VkDeviceSize remainingBudget	= frameUploadByteBudget;
+	bool budgetExhausted			= false;
+	for (const auto& assetId : uploadAssetIdVector) {
+		StreamedAssetStruct& asset = streamedAssetDeque[assetId];
+
+		while (asset.uploadCopyCursor < asset.uploadCopyVector.size()) {
+			UploadCopyStruct& uploadCopy = asset.uploadCopyVector[asset.uploadCopyCursor];
+			VkDeviceSize leftBytes = uploadCopy.totalBytes - uploadCopy.copiedBytes;
+			VkDeviceSize chunkBytes;
+
+			if (VK_NULL_HANDLE != uploadCopy.dstBuffer) {
+				chunkBytes = (std::min)(leftBytes, remainingBudget);
+				if (0 == chunkBytes && 0 == lastFrameUploadBytes) chunkBytes = leftBytes;
+				if (0 == chunkBytes) { budgetExhausted = true; break; }
+
+				VkBufferCopy bufferCopyRegion{};
+				bufferCopyRegion.srcOffset	= uploadCopy.srcOffset + uploadCopy.copiedBytes;
+				bufferCopyRegion.dstOffset	= uploadCopy.dstOffset + uploadCopy.copiedBytes;
+				bufferCopyRegion.size		= chunkBytes;
+				vkCmdCopyBuffer(uploadBatch.commandBuffer, asset.stagingBuffer, uploadCopy.dstBuffer, 1, &bufferCopyRegion);
+			}else {
+				VkDeviceSize rowBytes	= (VkDeviceSize)uploadCopy.imageWidth * 4;
+				uint32_t copiedRows		= (uint32_t)(uploadCopy.copiedBytes / rowBytes);
+				uint32_t chunkRows		= (uint32_t)(std::min)((VkDeviceSize)uploadCopy.imageHeight - copiedRows, remainingBudget / rowBytes);
+				if (0 == chunkRows && 0 == lastFrameUploadBytes) chunkRows = 1;
+				if (0 == chunkRows) { budgetExhausted = true; break; }
+				chunkBytes = chunkRows * rowBytes;
+
+				if (0 == copiedRows) {
+					SenBarrierBatch firstCopyBarrierBatch;
+					firstCopyBarrierBatch.addImageLayoutTransition(uploadCopy.dstImage, textureImageSubresourceRange,
+						VK_IMAGE_LAYOUT_PREINITIALIZED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+					firstCopyBarrierBatch.flush(uploadBatch.commandBuffer);
+				}
+
+				VkBufferImageCopy bufferImageCopyRegion{};
+				bufferImageCopyRegion.bufferOffset						= uploadCopy.srcOffset + uploadCopy.copiedBytes;
+				bufferImageCopyRegion.bufferRowLength					= 0;	// tightly packed
+				bufferImageCopyRegion.bufferImageHeight					= 0;
+				bufferImageCopyRegion.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+				bufferImageCopyRegion.imageSubresource.mipLevel			= 0;
+				bufferImageCopyRegion.imageSubresource.baseArrayLayer	= 0;
+				bufferImageCopyRegion.imageSubresource.layerCount		= 1;
+				bufferImageCopyRegion.imageOffset						= { 0, (int32_t)copiedRows, 0 };
+				bufferImageCopyRegion.imageExtent						= { uploadCopy.imageWidth, chunkRows, 1 };
+				vkCmdCopyBufferToImage(uploadBatch.commandBuffer, asset.stagingBuffer, uploadCopy.dstImage,
+					VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferImageCopyRegion);
+
+				if (copiedRows + chunkRows == uploadCopy.imageHeight)
+					finishedImagesBarrierBatch.addImageLayoutTransition(uploadCopy.dstImage, textureImageSubresourceRange,
+						VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+			}
+
+			uploadCopy.copiedBytes	+= chunkBytes;
+			lastFrameUploadBytes	+= chunkBytes;
+			remainingBudget			 = remainingBudget > chunkBytes ? remainingBudget - chunkBytes : 0;
+			if (uploadCopy.copiedBytes < uploadCopy.totalBytes) { budgetExhausted = true; break; }
+			asset.uploadCopyCursor++;
+		}
+
+		std::lock_guard<std::mutex> assetLock(assetMutex);
+		if (asset.uploadCopyCursor == asset.uploadCopyVector.size()) {
+			asset.assetState = ASSET_UPLOADING;
+			uploadBatch.completedAssetIdVector.push_back(assetId);
+			stagedAssetIdQueue.pop_front();	// assets finish in staging order, so it is always the front one
+		}
+		if (budgetExhausted) break;
+	}
+
+	// Streamed buffers are read as vertices/indices (or pulled by vertex shaders from the arena), images are sampled; covers every later submission on this queue
+	finishedImagesBarrierBatch.addMemoryBarrier(VK_ACCESS_TRANSFER_WRITE_BIT,
+		VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+		VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+	finishedImagesBarrierBatch.flush(uploadBatch.commandBuffer);
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkEndCommandBuffer(uploadBatch.commandBuffer),
+		std::string("Failed to end record of streaming upload commandBuffer !!!")
+	);
+
+	uploadBatch.timelineValue = uploadTimeline.submit(uploadBatch.commandBuffer);
+	uploadBatchQueue.push_back(uploadBatch);
+}
+
+void SenStreamingLoader::retireUploadBatches()
+{
+	// Batches retire in submission order, so an asset whose last bytes are in a completed batch has all earlier pieces done as well
+	const uint64_t completedTimelineValue = uploadTimeline.completedValue();
+	while (!uploadBatchQueue.empty() && uploadBatchQueue.front().timelineValue <= completedTimelineValue) {
+		UploadBatchStruct& uploadBatch = uploadBatchQueue.front();
+		for (const auto& assetId : uploadBatch.completedAssetIdVector) {
+			std::lock_guard<std::mutex> assetLock(assetMutex);
+			StreamedAssetStruct& asset = streamedAssetDeque[assetId];
+
+			vkDestroyBuffer(m_LogicalDevice, asset.stagingBuffer, nullptr);
+			SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, asset.stagingBufferMemory);	// always try to destroy before free
+			asset.stagingBuffer			= VK_NULL_HANDLE;
+			asset.stagingBufferMemory	= VK_NULL_HANDLE;
+			asset.uploadCopyVector.clear();
+			asset.assetState			= ASSET_RESIDENT;
+		}
+		vkFreeCommandBuffers(m_LogicalDevice, uploadCommandPool, 1, &uploadBatch.commandBuffer);
+		uploadBatchQueue.pop_front();
+	}
+}
+
+void SenStreamingLoader::destroyAssetResources(StreamedAssetStruct& asset)
+{
+	if (VK_NULL_HANDLE != asset.stagingBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, asset.stagingBuffer, nullptr);
+		asset.stagingBuffer = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != asset.stagingBufferMemory) {
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, asset.stagingBufferMemory);
+		asset.stagingBufferMemory = VK_NULL_HANDLE;
+	}
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != asset.mesh.vertexBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, asset.mesh.vertexBuffer, nullptr);
+		asset.mesh.vertexBuffer = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != asset.mesh.vertexBufferMemory) {
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, asset.mesh.vertexBufferMemory);
+		asset.mesh.vertexBufferMemory = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != asset.mesh.indexBuffer) {
+		vkDestroyBuffer(m_LogicalDevice, asset.mesh.indexBuffer, nullptr);
+		asset.mesh.indexBuffer = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != asset.mesh.indexBufferMemory) {
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, asset.mesh.indexBufferMemory);
+		asset.mesh.indexBufferMemory = VK_NULL_HANDLE;
+	}
+	if (nullptr != geometryArena) {
+		geometryArena->free(asset.mesh.vertexAllocation);
+		geometryArena->free(asset.mesh.indexAllocation);
+	}
+	/************************************************************************************************************/
+	if (VK_NULL_HANDLE != asset.texture.imageView) {
+		vkDestroyImageView(m_LogicalDevice, asset.texture.imageView, nullptr);
+		asset.texture.imageView = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != asset.texture.image) {
+		vkDestroyImage(m_LogicalDevice, asset.texture.image, nullptr);
+		asset.texture.image = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != asset.texture.imageMemory) {
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, asset.texture.imageMemory);
+		asset.texture.imageMemory = VK_NULL_HANDLE;
+	}
+}
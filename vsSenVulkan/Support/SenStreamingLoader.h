@@ -0,0 +1,125 @@
+#pragma once
+
+#ifndef __SenStreamingLoader__
+#define __SenStreamingLoader__
+
+#include "SLVK_AbstractGLFW.h"
+#include "SenQueueTimeline.h"
+#include "SenTinyObjLoader.h"
+#include "SenGeometryArena.h"
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+/*
+	Background asset loading:  a loader thread reads, decodes and fills host visible staging buffers,
+	the render thread records the staging -> device local copies under a per-frame byte budget (pumpUploads),
+	and an asset becomes takeable once the timeline value of the batch holding its last bytes completed.
+	Only the render thread touches the VkQueue, the loader thread only creates buffers/images and maps memory;
+	request, pump and take are meant to be called from the render thread.
+	Given a SenGeometryArena, meshes are sub-allocated from it by the loader thread instead of getting buffers of their own.
+*/
+class SenStreamingLoader
+{
+public:
+	struct StreamedMeshStruct {
+		VkBuffer						vertexBuffer			= VK_NULL_HANDLE;	// without a geometry arena
+		VkDeviceMemory					vertexBufferMemory		= VK_NULL_HANDLE;
+		VkBuffer						indexBuffer				= VK_NULL_HANDLE;
+		VkDeviceMemory					indexBufferMemory		= VK_NULL_HANDLE;
+		SenGeometryArena::AllocationStruct	vertexAllocation;	// with a geometry arena, freed by whoever took the mesh
+		SenGeometryArena::AllocationStruct	indexAllocation;
+		std::vector<VertexStruct>		vertexStructVector;		// both empty for a .smc mesh without LOD chain,
+		std::vector<uint32_t>			indexVector;			// it is decoded straight into the staging memory
+		std::vector<LodLevelStruct>		lodLevelVector;			// single level unless requested with generateLodChain
+	};
+	struct StreamedTextureStruct {
+		VkImage							image					= VK_NULL_HANDLE;
+		VkDeviceMemory					imageMemory				= VK_NULL_HANDLE;
+		VkImageView						imageView				= VK_NULL_HANDLE;
+		int								width					= 0;
+		int								height					= 0;
+	};
+
+	SenStreamingLoader(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+		const int32_t& uploadQueueFamilyIndex, SenQueueTimeline& uploadQueueTimeline, SenGeometryArena* meshGeometryArena = nullptr);
+	virtual ~SenStreamingLoader();
+
+	// Both return an asset id right away, the loader thread does the work;  meshes are OBJ or .smc (SenMeshCodec)
+	uint32_t requestMesh(const std::string& objectDiskAddress, const bool& generateLodChain = false);
+	uint32_t requestTexture(const std::string& textureDiskAddress);
+
+	// Render thread, once per frame: retire finished batches, then record and submit at most frameUploadByteBudget bytes of copies
+	void pumpUploads(const VkDeviceSize& frameUploadByteBudget);
+
+	// Ownership of the device local resources moves to the caller; false while the asset is still on its way
+	bool takeMesh(const uint32_t& assetId, StreamedMeshStruct& meshToTake);
+	bool takeTexture(const uint32_t& assetId, StreamedTextureStruct& textureToTake);
+
+	bool isIdle();
+	VkDeviceSize lastFrameUploadedBytes() const { return lastFrameUploadBytes; }
+
+private:
+	enum AssetType { ASSET_MESH, ASSET_TEXTURE };
+	enum AssetState { ASSET_REQUESTED, ASSET_STAGED, ASSET_UPLOADING, ASSET_RESIDENT, ASSET_TAKEN, ASSET_FAILED };
+
+	// One contiguous piece of the staging buffer going to one device local buffer or image
+	struct UploadCopyStruct {
+		VkBuffer						dstBuffer				= VK_NULL_HANDLE;
+		VkImage							dstImage				= VK_NULL_HANDLE;
+		VkDeviceSize					dstOffset				= 0;	// into dstBuffer
+		VkDeviceSize					srcOffset				= 0;
+		VkDeviceSize					totalBytes				= 0;
+		VkDeviceSize					copiedBytes				= 0;
+		uint32_t						imageWidth				= 0;	// images are split on whole rows
+		uint32_t						imageHeight				= 0;
+	};
+	struct StreamedAssetStruct {
+		uint32_t						assetId					= 0;
+		AssetType						assetType				= ASSET_MESH;
+		AssetState						assetState				= ASSET_REQUESTED;
+		std::string						diskAddress;
+		bool							generateLodChain		= false;
+
+		VkBuffer						stagingBuffer			= VK_NULL_HANDLE;
+		VkDeviceMemory					stagingBufferMemory		= VK_NULL_HANDLE;
+		std::vector<UploadCopyStruct>	uploadCopyVector;
+		size_t							uploadCopyCursor		= 0;
+
+		StreamedMeshStruct				mesh;
+		StreamedTextureStruct			texture;
+	};
+	// Copies recorded in one pumpUploads call, retired in submission order
+	struct UploadBatchStruct {
+		VkCommandBuffer					commandBuffer			= VK_NULL_HANDLE;
+		uint64_t						timelineValue			= 0;	// of uploadTimeline
+		std::vector<uint32_t>			completedAssetIdVector;	// assets whose last bytes are in this batch
+	};
+
+	void loaderThreadLoop();
+	void stageMesh(StreamedAssetStruct& asset);
+	void stageTexture(StreamedAssetStruct& asset);
+	void retireUploadBatches();
+	void destroyAssetResources(StreamedAssetStruct& asset);
+
+	VkDevice							m_LogicalDevice;
+	VkPhysicalDeviceMemoryProperties	m_PhysicalDeviceMemoryProperties;
+	SenQueueTimeline&					uploadTimeline;
+	SenGeometryArena*					geometryArena			= nullptr;	// outlives the loader
+	VkCommandPool						uploadCommandPool		= VK_NULL_HANDLE;
+
+	std::thread							loaderThread;
+	std::mutex							assetMutex;				// guards streamedAssetDeque, requestedAssetIdQueue, stagedAssetIdQueue
+	std::condition_variable				requestConditionVariable;
+	bool								loaderThreadQuit		= false;
+	std::deque<StreamedAssetStruct>		streamedAssetDeque;		// indexed by assetId, deque keeps references stable for the loader thread
+	std::deque<uint32_t>				requestedAssetIdQueue;
+	std::deque<uint32_t>				stagedAssetIdQueue;		// ready for pumpUploads, in staging order
+
+	std::deque<UploadBatchStruct>		uploadBatchQueue;		// render thread only
+	VkDeviceSize						lastFrameUploadBytes	= 0;
+};
+
+#endif // !__SenStreamingLoader__
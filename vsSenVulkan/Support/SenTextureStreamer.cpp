@@ -0,0 +1,403 @@
+#include "SenTextureStreamer.h"
+#include "SenMemoryTracker.h"
+#include "SenComputeOffloadDevice.h"
+
+// Declarations only, the stb_image implementation lives in SLVK_AbstractGLFW.cpp
+#include <stb/stb_image.h>
+
+#include <cmath>
+
+SenTextureStreamer::SenTextureStreamer(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+	SenStagingRing& uploadStagingRing, const VkDeviceSize& initialResidencyBudgetBytes)
+	: m_LogicalDevice(logicalDevice), m_PhysicalDeviceMemoryProperties(gpuMemoryProperties), stagingRing(uploadStagingRing)
+	, uploadTimeline(uploadStagingRing.queueTimeline()), residencyBudgetBytes(initialResidencyBudgetBytes)
+{
+}
+
+SenTextureStreamer::~SenTextureStreamer()
+{
+	// Residency changes still queued in the staging ring have no timeline value yet:  flush them to get one to wait on
+	assignFlushedTimelineValue();
+	for (auto& texture : textureVector) {
+		if (texture.uploadPending) {
+			uploadTimeline.waitUntil(texture.pendingImage.uploadTimelineValue);
+			destroyResidentImage(texture.pendingImage);
+		}
+		ResidentImageStruct activeImage{};
+		activeImage.image		= texture.image;
+		activeImage.imageMemory	= texture.imageMemory;
+		activeImage.imageView	= texture.imageView;
+		destroyResidentImage(activeImage);
+	}
+	textureVector.clear();
+
+	for (auto& retiredImage : retiredImageVector)
+		destroyResidentImage(retiredImage);
+	retiredImageVector.clear();
+	OutputDebugString("\n\t ~SenTextureStreamer()\n");
+}
+
+uint32_t SenTextureStreamer::registerTexture(const std::string& textureDiskAddress)
+{
+	return registerTextures({ textureDiskAddress }).front();
+}
+
+std::vector<uint32_t> SenTextureStreamer::registerTextures(const std::vector<std::string>& textureDiskAddressVector)
+{
+	/****************************************************************************************************************************/
+	/**********      The tails are tiny:  queue them all, then one staging ring batch and one wait for the whole set      *******/
+	/****************************************************************************************************************************/
+	std::vector<uint32_t> textureIdVector;
+	try {
+		for (const auto& textureDiskAddress : textureDiskAddressVector)
+			textureIdVector.push_back(queueTextureTail(textureDiskAddress));
+	}
+	catch (...) {
+		finishTailUploads(textureIdVector);	// the ones queued so far stay registered
+		throw;
+	}
+	finishTailUploads(textureIdVector);
+
+	for (const auto& textureId : textureIdVector) {
+		const StreamedTextureStruct& texture = textureVector[textureId];
+		std::ostringstream stream;
+		stream << "\t SenTextureStreamer registered " << texture.diskAddress << ":  " << texture.mipVector[0].width << " x "
+			<< texture.mipVector[0].height << ", " << texture.mipVector.size() << " mips, resident from mip " << texture.tailBaseMip
+			<< " (" << texture.texelBytes / 1024 << " KB of " << texelBytesFromMip(texture, 0) / 1024 << " KB)\n";
+		std::cout << stream.str();
+	}
+	return textureIdVector;
+}
+
+void SenTextureStreamer::finishTailUploads(const std::vector<uint32_t>& textureIdVector)
+{
+	if (textureIdVector.empty()) return;
+
+	// A valid view exists for every one of them from the first frame on
+	uploadTimeline.waitUntil(assignFlushedTimelineValue());
+	for (const auto& textureId : textureIdVector)
+		finishResidencyChange(textureVector[textureId]);
+	currentResidencyGeneration++;
+}
+
+uint64_t SenTextureStreamer::assignFlushedTimelineValue()
+{
+	const uint64_t uploadTimelineValue = stagingRing.flush();
+	for (auto& texture : textureVector) {
+		if (texture.uploadPending && 0 == texture.pendingImage.uploadTimelineValue)
+			texture.pendingImage.uploadTimelineValue = uploadTimelineValue;
+	}
+	return uploadTimelineValue;
+}
+
+uint32_t SenTextureStreamer::queueTextureTail(const std::string& textureDiskAddress)
+{
+	// Only stb decoded RGBA8 is mip streamed, the chain below level 0 is box filtered here (or on mipGenerationOffloadDevice)
+	int textureWidth = 0, textureHeight = 0, actuallyTextureChannels = 0;
+	stbi_uc* ptrDiskTextureToUpload = stbi_load(textureDiskAddress.c_str(), &textureWidth, &textureHeight, &actuallyTextureChannels, STBI_rgb_alpha);
+	if (!ptrDiskTextureToUpload)
+		throw std::runtime_error("failed to load texture image " + textureDiskAddress + " !");
+
+	textureVector.emplace_back();
+	StreamedTextureStruct& texture = textureVector.back();
+	texture.diskAddress = textureDiskAddress;
+
+	MipLevelStruct mipLevel{};
+	mipLevel.width	= (uint32_t)textureWidth;
+	mipLevel.height	= (uint32_t)textureHeight;
+	mipLevel.texelVector.assign(ptrDiskTextureToUpload, ptrDiskTextureToUpload + (size_t)textureWidth * textureHeight * 4);
+	stbi_image_free(ptrDiskTextureToUpload);
+
+	if (nullptr != mipGenerationOffloadDevice) {
+		// Same filter, computed by the other GPU;  the whole chain comes back through host memory
+		std::vector<SenComputeOffloadDevice::MipLevelStruct> generatedMipVector = mipGenerationOffloadDevice->generateMipChain(
+			std::move(mipLevel.texelVector), mipLevel.width, mipLevel.height).get();
+		for (auto& generatedMip : generatedMipVector) {
+			MipLevelStruct generatedLevel{};
+			generatedLevel.width		= generatedMip.width;
+			generatedLevel.height		= generatedMip.height;
+			generatedLevel.texelVector	= std::move(generatedMip.texelVector);
+			texture.mipVector.push_back(std::move(generatedLevel));
+		}
+	}
+	else
+		texture.mipVector.push_back(std::move(mipLevel));
+
+	/****************************************************************************************************************************/
+	/**********      2x2 box filter down to 1x1, odd edges repeat their last row / column      **********************************/
+	/****************************************************************************************************************************/
+	while (texture.mipVector.back().width > 1 || texture.mipVector.back().height > 1) {
+		const MipLevelStruct& srcLevel = texture.mipVector.back();
+		MipLevelStruct dstLevel{};
+		dstLevel.width	= (std::max)(srcLevel.width / 2, 1u);
+		dstLevel.height	= (std::max)(srcLevel.height / 2, 1u);
+		dstLevel.texelVector.resize((size_t)dstLevel.width * dstLevel.height * 4);
+
+		for (uint32_t y = 0; y < dstLevel.height; y++) {
+			uint32_t srcY0 = (std::min)(y * 2, srcLevel.height - 1), srcY1 = (std::min)(y * 2 + 1, srcLevel.height - 1);
+			for (uint32_t x = 0; x < dstLevel.width; x++) {
+				uint32_t srcX0 = (std::min)(x * 2, srcLevel.width - 1), srcX1 = (std::min)(x * 2 + 1, srcLevel.width - 1);
+				for (uint32_t channel = 0; channel < 4; channel++) {
+					uint32_t texelSum = srcLevel.texelVector[((size_t)srcY0 * srcLevel.width + srcX0) * 4 + channel]
+						+ srcLevel.texelVector[((size_t)srcY0 * srcLevel.width + srcX1) * 4 + channel]
+						+ srcLevel.texelVector[((size_t)srcY1 * srcLevel.width + srcX0) * 4 + channel]
+						+ srcLevel.texelVector[((size_t)srcY1 * srcLevel.width + srcX1) * 4 + channel];
+					dstLevel.texelVector[((size_t)y * dstLevel.width + x) * 4 + channel] = (uint8_t)((texelSum + 2) / 4);
+				}
+			}
+		}
+		texture.mipVector.push_back(std::move(dstLevel));
+	}
+
+	uint32_t mipCount = (uint32_t)texture.mipVector.size();
+	texture.tailBaseMip = mipCount - 1;
+	while (texture.tailBaseMip > 0 && (std::max)(texture.mipVector[texture.tailBaseMip - 1].width,
+		texture.mipVector[texture.tailBaseMip - 1].height) <= m_TailMipSize)
+		texture.tailBaseMip--;
+	texture.residentBaseMip		= mipCount;	// nothing resident yet
+	texture.requestedBaseMip	= texture.tailBaseMip;
+
+	// Queued only, registerTextures() flushes the tails of the whole set at once
+	beginResidencyChange(texture, texture.tailBaseMip);
+
+	return (uint32_t)textureVector.size() - 1;
+}
+
+uint32_t SenTextureStreamer::mipLevelForScreenSize(const uint32_t& textureId, const float& projectedPixelsCount) const
+{
+	const StreamedTextureStruct& texture = textureVector[textureId];
+	float texelsPerPixel = texture.mipVector[0].width / (std::max)(projectedPixelsCount, 1.0f);
+	if (texelsPerPixel <= 1.0f) return 0;
+
+	uint32_t mipLevel = (uint32_t)std::floor(std::log2(texelsPerPixel));
+	return (std::min)(mipLevel, (uint32_t)texture.mipVector.size() - 1);
+}
+
+void SenTextureStreamer::requestMipLevel(const uint32_t& textureId, const uint32_t& mipLevel, const uint64_t& frameNumber)
+{
+	StreamedTextureStruct& texture = textureVector[textureId];
+	uint32_t clampedMipLevel = (std::min)(mipLevel, texture.tailBaseMip);
+	// Several users in one frame: the finest request wins
+	if (texture.lastRequestedFrame != frameNumber || clampedMipLevel < texture.requestedBaseMip)
+		texture.requestedBaseMip = clampedMipLevel;
+	texture.lastRequestedFrame = frameNumber;
+}
+
+void SenTextureStreamer::update(const uint64_t& frameNumber, const VkDeviceSize& frameUploadByteBudget)
+{
+	/****************************************************************************************************************************/
+	/**********      Finished uploads replace the active image, the old one waits for the swapchain images to move on      ******/
+	/****************************************************************************************************************************/
+	bool imageViewsChanged = false;
+	const uint64_t completedTimelineValue = uploadTimeline.completedValue();
+	for (auto& texture : textureVector) {
+		if (texture.uploadPending && texture.pendingImage.uploadTimelineValue <= completedTimelineValue) {
+			finishResidencyChange(texture);
+			imageViewsChanged = true;
+		}
+	}
+	if (imageViewsChanged) currentResidencyGeneration++;
+
+	/****************************************************************************************************************************/
+	/**********      Raise residency for textures requested this frame, the ones missing the most levels first      *************/
+	/****************************************************************************************************************************/
+	std::vector<uint32_t> candidateIdVector;
+	for (uint32_t textureId = 0; textureId < textureVector.size(); textureId++) {
+		const StreamedTextureStruct& texture = textureVector[textureId];
+		if (!texture.uploadPending && texture.lastRequestedFrame == frameNumber && texture.requestedBaseMip < texture.residentBaseMip)
+			candidateIdVector.push_back(textureId);
+	}
+	std::sort(candidateIdVector.begin(), candidateIdVector.end(), [this](const uint32_t& a, const uint32_t& b) {
+		return textureVector[a].residentBaseMip - textureVector[a].requestedBaseMip
+			> textureVector[b].residentBaseMip - textureVector[b].requestedBaseMip;
+	});
+
+	// LRU victim:  least recently requested texture holding more than its tail; ones used this frame only give back over-detailed levels
+	auto findEvictionVictim = [this, &frameNumber](const uint32_t& excludedTextureId) -> int32_t {
+		int32_t victimId = -1;
+		for (uint32_t textureId = 0; textureId < textureVector.size(); textureId++) {
+			const StreamedTextureStruct& texture = textureVector[textureId];
+			if (textureId == excludedTextureId || texture.uploadPending) continue;
+			uint32_t keptBaseMip = texture.lastRequestedFrame == frameNumber ? texture.requestedBaseMip : texture.tailBaseMip;
+			if (texture.residentBaseMip >= keptBaseMip) continue;
+			if (victimId < 0 || texture.lastRequestedFrame < textureVector[victimId].lastRequestedFrame)
+				victimId = (int32_t)textureId;
+		}
+		return victimId;
+	};
+
+	VkDeviceSize uploadBytes = 0;
+	for (const auto& candidateId : candidateIdVector) {
+		if (uploadBytes > 0 && uploadBytes >= frameUploadByteBudget) break;
+		StreamedTextureStruct& texture = textureVector[candidateId];
+
+		uint32_t newBaseMip = texture.requestedBaseMip;
+		while (newBaseMip < texture.residentBaseMip) {
+			VkDeviceSize newTexelBytes = texelBytesFromMip(texture, newBaseMip);
+			bool fitsUploadBudget = 0 == uploadBytes || uploadBytes + newTexelBytes <= frameUploadByteBudget;
+			if (fitsUploadBudget && committedBytes + newTexelBytes - texture.texelBytes <= residencyBudgetBytes) break;
+
+			int32_t victimId = fitsUploadBudget ? findEvictionVictim(candidateId) : -1;
+			if (victimId >= 0) {
+				StreamedTextureStruct& victim = textureVector[victimId];
+				beginResidencyChange(victim, victim.lastRequestedFrame == frameNumber ? victim.requestedBaseMip : victim.tailBaseMip);
+				evictedTexturesCount++;
+				continue;
+			}
+			newBaseMip++;	// nothing left to evict, settle for a coarser level
+		}
+		if (newBaseMip < texture.residentBaseMip) {
+			beginResidencyChange(texture, newBaseMip);
+			uploadBytes += texture.pendingImage.texelBytes;
+		}
+	}
+
+	// This frame's residency changes, evictions included, go out as one staging ring batch
+	assignFlushedTimelineValue();
+}
+
+void SenTextureStreamer::destroyRetiredImages(const uint64_t& generationAdoptedByAllSwapchainImages)
+{
+	for (size_t i = 0; i < retiredImageVector.size();) {
+		if (retiredImageVector[i].retireGeneration <= generationAdoptedByAllSwapchainImages) {
+			destroyResidentImage(retiredImageVector[i]);
+			retiredImageVector.erase(retiredImageVector.begin() + i);
+		}
+		else i++;
+	}
+}
+
+VkDeviceSize SenTextureStreamer::texelBytesFromMip(const StreamedTextureStruct& texture, const uint32_t& baseMip) const
+{
+	VkDeviceSize texelBytes = 0;
+	for (uint32_t mip = baseMip; mip < texture.mipVector.size(); mip++)
+		texelBytes += texture.mipVector[mip].texelVector.size();
+	return texelBytes;
+}
+
+void SenTextureStreamer::beginResidencyChange(StreamedTextureStruct& texture, const uint32_t& newBaseMip)
+{
+	ResidentImageStruct& pendingImage	= texture.pendingImage;
+	const uint32_t levelCount			= (uint32_t)texture.mipVector.size() - newBaseMip;
+	pendingImage.baseMip				= newBaseMip;
+	pendingImage.texelBytes				= texelBytesFromMip(texture, newBaseMip);
+
+	/****************************************************************************************************************************/
+	/**********      Device local image holding exactly the resident levels, its level 0 is mip newBaseMip      *****************/
+	/****************************************************************************************************************************/
+	VkImageCreateInfo imageCreateInfo{};
+	imageCreateInfo.sType			= VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCreateInfo.imageType		= VK_IMAGE_TYPE_2D;
+	imageCreateInfo.extent.width	= texture.mipVector[newBaseMip].width;
+	imageCreateInfo.extent.height	= texture.mipVector[newBaseMip].height;
+	imageCreateInfo.extent.depth	= 1;
+	imageCreateInfo.mipLevels		= levelCount;
+	imageCreateInfo.arrayLayers		= 1;
+	imageCreateInfo.format			= VK_FORMAT_R8G8B8A8_UNORM;
+	imageCreateInfo.tiling			= VK_IMAGE_TILING_OPTIMAL;
+	imageCreateInfo.initialLayout	= VK_IMAGE_LAYOUT_UNDEFINED;	// every level gets overwritten by the copy
+	imageCreateInfo.usage			= VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+	imageCreateInfo.samples			= VK_SAMPLE_COUNT_1_BIT;
+	imageCreateInfo.sharingMode		= VK_SHARING_MODE_EXCLUSIVE;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateImage(m_LogicalDevice, &imageCreateInfo, nullptr, &pendingImage.image),
+		std::string("Failed to create streamed texture image !!!")
+	);
+
+	VkMemoryRequirements imageMemoryRequirements;
+	vkGetImageMemoryRequirements(m_LogicalDevice, pendingImage.image, &imageMemoryRequirements);
+	VkMemoryAllocateInfo imageMemoryAllocateInfo{};
+	imageMemoryAllocateInfo.sType			= VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+	imageMemoryAllocateInfo.allocationSize	= imageMemoryRequirements.size;
+	imageMemoryAllocateInfo.memoryTypeIndex	= SLVK_AbstractGLFW::findPhysicalDeviceMemoryPropertyIndex(
+		m_PhysicalDeviceMemoryProperties, imageMemoryRequirements, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkAllocateMemory(m_LogicalDevice, &imageMemoryAllocateInfo, nullptr, &pendingImage.imageMemory),
+		std::string("Failed to allocate streamed texture image memory !!!")
+	);
+	SenMemoryTracker::recordAllocation(pendingImage.imageMemory, imageMemoryAllocateInfo.allocationSize, imageMemoryAllocateInfo.memoryTypeIndex,
+		SenMemoryTracker::MEMORY_CATEGORY_TEXTURE);
+	vkBindImageMemory(m_LogicalDevice, pendingImage.image, pendingImage.imageMemory, 0);
+
+	VkImageSubresourceRange textureImageSubresourceRange{};
+	textureImageSubresourceRange.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+	textureImageSubresourceRange.baseMipLevel	= 0;
+	textureImageSubresourceRange.levelCount		= levelCount;
+	textureImageSubresourceRange.baseArrayLayer	= 0;
+	textureImageSubresourceRange.layerCount		= 1;
+
+	VkImageViewCreateInfo textureImageViewCreateInfo{};
+	textureImageViewCreateInfo.sType			= VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	textureImageViewCreateInfo.image			= pendingImage.image;
+	textureImageViewCreateInfo.viewType			= VK_IMAGE_VIEW_TYPE_2D;
+	textureImageViewCreateInfo.format			= VK_FORMAT_R8G8B8A8_UNORM;
+	textureImageViewCreateInfo.subresourceRange	= textureImageSubresourceRange;
+
+	SLVK_AbstractGLFW::errorCheck(
+		vkCreateImageView(m_LogicalDevice, &textureImageViewCreateInfo, nullptr, &pendingImage.imageView),
+		std::string("Failed to create streamed texture Image View !!!")
+	);
+
+	/****************************************************************************************************************************/
+	/**********      Queued in the staging ring, one copy per level between the two transitions;  update() flushes      *******/
+	/****************************************************************************************************************************/
+	stagingRing.transitionImageLayout(pendingImage.image, textureImageSubresourceRange,
+		VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+	for (uint32_t mip = newBaseMip; mip < texture.mipVector.size(); mip++) {
+		const MipLevelStruct& mipLevel = texture.mipVector[mip];
+
+		VkBufferImageCopy bufferImageCopyRegion{};
+		bufferImageCopyRegion.imageSubresource.aspectMask		= VK_IMAGE_ASPECT_COLOR_BIT;
+		bufferImageCopyRegion.imageSubresource.mipLevel			= mip - newBaseMip;
+		bufferImageCopyRegion.imageSubresource.baseArrayLayer	= 0;
+		bufferImageCopyRegion.imageSubresource.layerCount		= 1;
+		bufferImageCopyRegion.imageExtent						= { mipLevel.width, mipLevel.height, 1 };
+		stagingRing.uploadToImage(mipLevel.texelVector.data(), pendingImage.image, VK_FORMAT_R8G8B8A8_UNORM, bufferImageCopyRegion);
+	}
+	stagingRing.transitionImageLayout(pendingImage.image, textureImageSubresourceRange,
+		VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	pendingImage.uploadTimelineValue = 0;
+
+	// Accounted at the new size right away, so one update() never plans past the budget
+	committedBytes			= committedBytes + pendingImage.texelBytes - texture.texelBytes;
+	texture.uploadPending	= true;
+}
+
+void SenTextureStreamer::finishResidencyChange(StreamedTextureStruct& texture)
+{
+	ResidentImageStruct& pendingImage = texture.pendingImage;
+
+	if (VK_NULL_HANDLE != texture.image) {
+		ResidentImageStruct retiredImage{};
+		retiredImage.image				= texture.image;
+		retiredImage.imageMemory		= texture.imageMemory;
+		retiredImage.imageView			= texture.imageView;
+		retiredImage.retireGeneration	= currentResidencyGeneration + 1;	// the generation that stops referencing it
+		retiredImageVector.push_back(retiredImage);
+	}
+	texture.image			= pendingImage.image;
+	texture.imageMemory		= pendingImage.imageMemory;
+	texture.imageView		= pendingImage.imageView;
+	texture.residentBaseMip	= pendingImage.baseMip;
+	texture.texelBytes		= pendingImage.texelBytes;
+	texture.pendingImage	= ResidentImageStruct();
+	texture.uploadPending	= false;
+}
+
+void SenTextureStreamer::destroyResidentImage(ResidentImageStruct& residentImage)
+{
+	if (VK_NULL_HANDLE != residentImage.imageView) {
+		vkDestroyImageView(m_LogicalDevice, residentImage.imageView, nullptr);
+		residentImage.imageView = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != residentImage.image) {
+		vkDestroyImage(m_LogicalDevice, residentImage.image, nullptr);
+		residentImage.image = VK_NULL_HANDLE;
+	}
+	if (VK_NULL_HANDLE != residentImage.imageMemory) {
+		SLVK_AbstractGLFW::freeDeviceMemory(m_LogicalDevice, residentImage.imageMemory);
+		residentImage.imageMemory = VK_NULL_HANDLE;
+	}
+}
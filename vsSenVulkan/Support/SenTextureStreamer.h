@@ -0,0 +1,109 @@
+#pragma once
+
+#ifndef __SenTextureStreamer__
+#define __SenTextureStreamer__
+
+#include "SLVK_AbstractGLFW.h"
+#include "SenStagingRing.h"
+
+class SenComputeOffloadDevice;
+
+/*
+	Texture streaming by mip level:  every registered texture keeps its whole mip chain in system memory,
+	the GPU only holds the levels from residentBaseMip down to the 1x1 tail.
+	Registration uploads the small tail mips only, a registerTextures() set in one batch; update() raises residency toward the finest level requested
+	this frame (from screen-space size), and evicts the least recently requested textures back to their tail
+	when the residency budget would be exceeded.  Changing residency rebuilds the VkImage with the new level
+	count, the old image is retired until every swapchain image adopted the new residencyGeneration.
+	Levels are uploaded through the application's SenStagingRing, all residency changes of one update() in one batch.
+*/
+class SenTextureStreamer
+{
+public:
+	SenTextureStreamer(const VkDevice& logicalDevice, const VkPhysicalDeviceMemoryProperties& gpuMemoryProperties,
+		SenStagingRing& uploadStagingRing, const VkDeviceSize& initialResidencyBudgetBytes);
+	virtual ~SenTextureStreamer();
+
+	uint32_t registerTexture(const std::string& textureDiskAddress);
+	// The tail mips of the whole set go out in one staging ring batch, waited on once;  ids in textureDiskAddressVector order
+	std::vector<uint32_t> registerTextures(const std::vector<std::string>& textureDiskAddressVector);
+	// Mip chains of the next registrations are generated there instead of on the CPU;  nullptr goes back to the CPU
+	void setMipGenerationDevice(SenComputeOffloadDevice* mipGenerationDevice) { mipGenerationOffloadDevice = mipGenerationDevice; }
+
+	// Mip level (of the full chain) whose texel density matches projectedPixelsCount screen pixels across the texture width
+	uint32_t mipLevelForScreenSize(const uint32_t& textureId, const float& projectedPixelsCount) const;
+	void requestMipLevel(const uint32_t& textureId, const uint32_t& mipLevel, const uint64_t& frameNumber);
+
+	// Once per frame, render thread:  swap in finished uploads, evict over budget, start at most frameUploadByteBudget of uploads
+	void update(const uint64_t& frameNumber, const VkDeviceSize& frameUploadByteBudget);
+	// Retired images are destroyed once no swapchain image records a generation older than their retirement
+	void destroyRetiredImages(const uint64_t& generationAdoptedByAllSwapchainImages);
+
+	VkImageView getImageView(const uint32_t& textureId) const { return textureVector[textureId].imageView; }
+	uint32_t residentMipLevel(const uint32_t& textureId) const { return textureVector[textureId].residentBaseMip; }
+	uint32_t mipLevelsCount(const uint32_t& textureId) const { return (uint32_t)textureVector[textureId].mipVector.size(); }
+	uint64_t residencyGeneration() const { return currentResidencyGeneration; }
+	VkDeviceSize residentBytes() const { return committedBytes; }
+	VkDeviceSize residencyBudget() const { return residencyBudgetBytes; }
+	// Lowering it below residentBytes() evicts nothing by itself, it only stops growth until residency falls under it again
+	void setResidencyBudget(const VkDeviceSize& budgetBytes) { residencyBudgetBytes = budgetBytes; }
+	uint64_t evictionsCount() const { return evictedTexturesCount; }
+
+private:
+	struct MipLevelStruct {
+		uint32_t						width					= 0;
+		uint32_t						height					= 0;
+		std::vector<uint8_t>			texelVector;			// RGBA8, tightly packed
+	};
+	// One device local image holding mips [baseMip, mipVector.size()), uploaded through the staging ring
+	struct ResidentImageStruct {
+		VkImage							image					= VK_NULL_HANDLE;
+		VkDeviceMemory					imageMemory				= VK_NULL_HANDLE;
+		VkImageView						imageView				= VK_NULL_HANDLE;
+		uint32_t						baseMip					= 0;
+		VkDeviceSize					texelBytes				= 0;
+
+		uint64_t						uploadTimelineValue		= 0;	// of the staging ring's timeline, 0 until its batch is flushed
+		uint64_t						retireGeneration		= 0;
+	};
+	struct StreamedTextureStruct {
+		std::string						diskAddress;
+		std::vector<MipLevelStruct>		mipVector;
+		uint32_t						tailBaseMip				= 0;	// finest level that is always resident
+		uint32_t						residentBaseMip			= 0;
+		uint32_t						requestedBaseMip		= 0;	// finest level asked for during lastRequestedFrame
+		uint64_t						lastRequestedFrame		= 0;
+		VkImage							image					= VK_NULL_HANDLE;
+		VkDeviceMemory					imageMemory				= VK_NULL_HANDLE;
+		VkImageView						imageView				= VK_NULL_HANDLE;
+		VkDeviceSize					texelBytes				= 0;
+		bool							uploadPending			= false;
+		ResidentImageStruct				pendingImage;
+	};
+
+	// Decode and build the mip chain, queue the tail upload without flushing
+	uint32_t queueTextureTail(const std::string& textureDiskAddress);
+	void finishTailUploads(const std::vector<uint32_t>& textureIdVector);
+	// Flush the staging ring, the value goes to every pending upload that has none yet
+	uint64_t assignFlushedTimelineValue();
+	VkDeviceSize texelBytesFromMip(const StreamedTextureStruct& texture, const uint32_t& baseMip) const;
+	void beginResidencyChange(StreamedTextureStruct& texture, const uint32_t& newBaseMip);
+	void finishResidencyChange(StreamedTextureStruct& texture);
+	void destroyResidentImage(ResidentImageStruct& residentImage);
+
+	VkDevice							m_LogicalDevice;
+	VkPhysicalDeviceMemoryProperties	m_PhysicalDeviceMemoryProperties;
+	SenStagingRing&						stagingRing;
+	SenQueueTimeline&					uploadTimeline;			// stagingRing's
+	VkDeviceSize						residencyBudgetBytes;
+	const uint32_t						m_TailMipSize			= 64;	// levels no larger than this stay resident for ever
+	SenComputeOffloadDevice*			mipGenerationOffloadDevice	= nullptr;	// not owned
+
+	std::vector<StreamedTextureStruct>	textureVector;
+	std::vector<ResidentImageStruct>	retiredImageVector;
+	uint64_t							currentResidencyGeneration	= 1;
+	VkDeviceSize						committedBytes			= 0;	// resident levels, pending ones counted at their new size
+	uint64_t							evictedTexturesCount	= 0;
+};
+
+#endif // !__SenTextureStreamer__
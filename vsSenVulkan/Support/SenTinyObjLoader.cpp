@@ -1,11 +1,16 @@
 
 #include "SenTinyObjLoader.h"
+#include "SenJobSystem.h"
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/hash.hpp>			// for tinyObjLoader
 #define TINYOBJLOADER_IMPLEMENTATION
 #include <tiny_obj_loader.h>
 
+#include <algorithm>	// std::sort for edge collapse candidates
+#include <cmath>
+#include <stdexcept>	// std::runtime_error
+
 namespace std {
 	template<> struct hash<VertexStruct> {
 		size_t operator()(VertexStruct const& vertex) const {
@@ -14,6 +19,64 @@ namespace std {
 	};
 }
 
+namespace {
+	/* Symmetric 4x4 error quadric of Garland & Heckbert, only the upper triangle is stored:
+	   a2 ab ac ad  b2 bc bd  c2 cd  d2 */
+	struct QuadricStruct {
+		double q[10] = {};
+
+		void addPlane(const glm::dvec3& n, const double& d) {
+			q[0] += n.x * n.x;	q[1] += n.x * n.y;	q[2] += n.x * n.z;	q[3] += n.x * d;
+			q[4] += n.y * n.y;	q[5] += n.y * n.z;	q[6] += n.y * d;
+			q[7] += n.z * n.z;	q[8] += n.z * d;
+			q[9] += d * d;
+		}
+		void operator+=(const QuadricStruct& other) {
+			for (int i = 0; i < 10; i++) q[i] += other.q[i];
+		}
+		// Sum of squared distances from p to all accumulated planes
+		double evaluate(const glm::vec3& p) const {
+			const double x = p.x, y = p.y, z = p.z;
+			return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x
+				+ q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y
+				+ q[7] * z * z + 2 * q[8] * z
+				+ q[9];
+		}
+	};
+
+	struct CollapseStruct {
+		uint32_t fromVertex;
+		uint32_t toVertex;
+		double error;
+	};
+
+	inline uint64_t edgeKey(uint32_t a, uint32_t b) {
+		return a < b ? (uint64_t(a) << 32) | b : (uint64_t(b) << 32) | a;
+	}
+
+	// Collapsing fromVertex onto toVertex must not fold any surviving triangle around fromVertex over
+	bool collapseFlipsTriangle(const std::vector<VertexStruct>& vertexStructVector, const std::vector<uint32_t>& indexVector,
+		const std::vector<uint32_t>& adjacencyOffsetVector, const std::vector<uint32_t>& adjacencyTriangleVector,
+		const uint32_t& fromVertex, const uint32_t& toVertex) {
+		for (uint32_t a = adjacencyOffsetVector[fromVertex]; a < adjacencyOffsetVector[fromVertex + 1]; a++) {
+			const uint32_t* triangle = &indexVector[3 * adjacencyTriangleVector[a]];
+			if (triangle[0] == toVertex || triangle[1] == toVertex || triangle[2] == toVertex)
+				continue; // this triangle degenerates and disappears
+
+			glm::vec3 before[3], after[3];
+			for (int c = 0; c < 3; c++) {
+				before[c] = vertexStructVector[triangle[c]].position;
+				after[c] = vertexStructVector[triangle[c] == fromVertex ? toVertex : triangle[c]].position;
+			}
+			glm::vec3 normalBefore = glm::cross(before[1] - before[0], before[2] - before[0]);
+			glm::vec3 normalAfter = glm::cross(after[1] - after[0], after[2] - after[0]);
+			if (glm::dot(normalBefore, normalAfter) <= 0.0f)
+				return true;
+		}
+		return false;
+	}
+}// namespace
+
 namespace stobjl {
 
 	void populateVertexIndexVector(const char* const tinyObjectDiskAddress,
@@ -55,5 +118,305 @@ namespace stobjl {
 		}
 	}// populateVertexIndexVector()
 
+	void generateLodChain(const std::vector<VertexStruct>& vertexStructVector, std::vector<uint32_t>& indexVectorToAppend,
+		std::vector<LodLevelStruct>& lodLevelVectorToPopulate, const uint32_t& maxLodLevelsCount, const float& lodTriangleRatio) {
+
+		const uint32_t verticesCount = static_cast<uint32_t>(vertexStructVector.size());
+		lodLevelVectorToPopulate.clear();
+		lodLevelVectorToPopulate.push_back({ 0, static_cast<uint32_t>(indexVectorToAppend.size()), 0.0f });
+
+		/****************************************************************************************************************/
+		/**********    Per vertex quadric from the planes of all its triangles in the full resolution mesh    ***********/
+		/****************************************************************************************************************/
+		std::vector<QuadricStruct> quadricVector(verticesCount);
+		for (size_t t = 0; t + 2 < indexVectorToAppend.size(); t += 3) {
+			const glm::dvec3 p0 = vertexStructVector[indexVectorToAppend[t + 0]].position;
+			const glm::dvec3 p1 = vertexStructVector[indexVectorToAppend[t + 1]].position;
+			const glm::dvec3 p2 = vertexStructVector[indexVectorToAppend[t + 2]].position;
+			glm::dvec3 normal = glm::cross(p1 - p0, p2 - p0);
+			double length = glm::length(normal);
+			if (length <= 0.0) continue;
+			normal /= length;
+			for (int c = 0; c < 3; c++)
+				quadricVector[indexVectorToAppend[t + c]].addPlane(normal, -glm::dot(normal, p0));
+		}
+
+		/****************************************************************************************************************/
+		/**********    Lock open border vertices (including texCoord seams, which are split vertices in OBJ)   **********/
+		/****************************************************************************************************************/
+		std::vector<bool> vertexLockedVector(verticesCount, false);
+		{
+			std::unordered_map<uint64_t, uint32_t> edgeUsageMap;
+			for (size_t t = 0; t + 2 < indexVectorToAppend.size(); t += 3)
+				for (int c = 0; c < 3; c++)
+					edgeUsageMap[edgeKey(indexVectorToAppend[t + c], indexVectorToAppend[t + (c + 1) % 3])]++;
+			for (const auto& edgeUsage : edgeUsageMap) {
+				if (edgeUsage.second != 2) {
+					vertexLockedVector[uint32_t(edgeUsage.first >> 32)] = true;
+					vertexLockedVector[uint32_t(edgeUsage.first & 0xffffffff)] = true;
+				}
+			}
+		}
+
+		std::vector<uint32_t> lodIndexVector(indexVectorToAppend.begin(), indexVectorToAppend.end());
+		double lodMaxError = 0.0;
+
+		for (uint32_t level = 1; level < maxLodLevelsCount; level++) {
+			const size_t previousIndexCount = lodIndexVector.size();
+			const size_t targetIndexCount = static_cast<size_t>(previousIndexCount * lodTriangleRatio) / 3 * 3;
+
+			/************************************************************************************************************/
+			/**********    Greedy passes: cheapest independent collapses first, until the target is reached    **********/
+			/************************************************************************************************************/
+			while (lodIndexVector.size() > targetIndexCount) {
+				const uint32_t trianglesCount = static_cast<uint32_t>(lodIndexVector.size() / 3);
+
+				std::vector<uint32_t> adjacencyOffsetVector(verticesCount + 1, 0);
+				for (uint32_t index : lodIndexVector) adjacencyOffsetVector[index + 1]++;
+				for (uint32_t v = 0; v < verticesCount; v++) adjacencyOffsetVector[v + 1] += adjacencyOffsetVector[v];
+				std::vector<uint32_t> adjacencyTriangleVector(lodIndexVector.size());
+				{
+					std::vector<uint32_t> adjacencyFillVector(adjacencyOffsetVector.begin(), adjacencyOffsetVector.end() - 1);
+					for (uint32_t t = 0; t < trianglesCount; t++)
+						for (int c = 0; c < 3; c++)
+							adjacencyTriangleVector[adjacencyFillVector[lodIndexVector[3 * t + c]]++] = t;
+				}
+
+				std::vector<uint64_t> edgeVector;
+				edgeVector.reserve(lodIndexVector.size());
+				for (uint32_t t = 0; t < trianglesCount; t++)
+					for (int c = 0; c < 3; c++)
+						edgeVector.push_back(edgeKey(lodIndexVector[3 * t + c], lodIndexVector[3 * t + (c + 1) % 3]));
+				std::sort(edgeVector.begin(), edgeVector.end());
+				edgeVector.erase(std::unique(edgeVector.begin(), edgeVector.end()), edgeVector.end());
+
+				std::vector<CollapseStruct> collapseVector;
+				collapseVector.reserve(edgeVector.size());
+				for (uint64_t edge : edgeVector) {
+					uint32_t u = uint32_t(edge >> 32), v = uint32_t(edge & 0xffffffff);
+					QuadricStruct edgeQuadric = quadricVector[u];
+					edgeQuadric += quadricVector[v];
+
+					CollapseStruct collapse{ 0, 0, -1.0 };
+					if (!vertexLockedVector[v])
+						collapse = { v, u, edgeQuadric.evaluate(vertexStructVector[u].position) };
+					if (!vertexLockedVector[u]) {
+						double error = edgeQuadric.evaluate(vertexStructVector[v].position);
+						if (collapse.error < 0.0 || error < collapse.error)
+							collapse = { u, v, error };
+					}
+					if (collapse.error >= 0.0)
+						collapseVector.push_back(collapse);
+				}
+				std::sort(collapseVector.begin(), collapseVector.end(),
+					[](const CollapseStruct& a, const CollapseStruct& b) { return a.error < b.error; });
+
+				// Every interior collapse removes two triangles
+				size_t trianglesToRemove = (lodIndexVector.size() - targetIndexCount) / 3;
+				size_t collapsesApplied = 0;
+				std::vector<uint32_t> remapVector(verticesCount);
+				for (uint32_t v = 0; v < verticesCount; v++) remapVector[v] = v;
+				std::vector<bool> vertexTouchedVector(verticesCount, false);
+
+				for (const CollapseStruct& collapse : collapseVector) {
+					if (2 * collapsesApplied >= trianglesToRemove) break;
+					if (vertexTouchedVector[collapse.fromVertex] || vertexTouchedVector[collapse.toVertex]) continue;
+					if (collapseFlipsTriangle(vertexStructVector, lodIndexVector, adjacencyOffsetVector, adjacencyTriangleVector,
+						collapse.fromVertex, collapse.toVertex))
+						continue;
+
+					// Neighbours of both ends are frozen for this pass, so adjacency stays valid for the flip test
+					for (uint32_t end : { collapse.fromVertex, collapse.toVertex })
+						for (uint32_t a = adjacencyOffsetVector[end]; a < adjacencyOffsetVector[end + 1]; a++)
+							for (int c = 0; c < 3; c++)
+								vertexTouchedVector[lodIndexVector[3 * adjacencyTriangleVector[a] + c]] = true;
+
+					remapVector[collapse.fromVertex] = collapse.toVertex;
+					quadricVector[collapse.toVertex] += quadricVector[collapse.fromVertex];
+					lodMaxError = (std::max)(lodMaxError, collapse.error);
+					collapsesApplied++;
+				}
+				if (0 == collapsesApplied) break; // only locked or folding edges left
+
+				size_t writeIndex = 0;
+				for (size_t t = 0; t < lodIndexVector.size(); t += 3) {
+					uint32_t a = remapVector[lodIndexVector[t]], b = remapVector[lodIndexVector[t + 1]], c = remapVector[lodIndexVector[t + 2]];
+					if (a == b || b == c || c == a) continue;
+					lodIndexVector[writeIndex++] = a;	lodIndexVector[writeIndex++] = b;	lodIndexVector[writeIndex++] = c;
+				}
+				lodIndexVector.resize(writeIndex);
+			}
+
+			// Stop the chain once a level no longer saves a meaningful share of triangles
+			if (lodIndexVector.size() * 10 > previousIndexCount * 9) break;
+
+			LodLevelStruct lodLevel{};
+			lodLevel.firstIndex = static_cast<uint32_t>(indexVectorToAppend.size());
+			lodLevel.indexCount = static_cast<uint32_t>(lodIndexVector.size());
+			lodLevel.objectSpaceError = (std::max)(static_cast<float>(std::sqrt(lodMaxError)), lodLevelVectorToPopulate.back().objectSpaceError);
+			lodLevelVectorToPopulate.push_back(lodLevel);
+			indexVectorToAppend.insert(indexVectorToAppend.end(), lodIndexVector.begin(), lodIndexVector.end());
+		}
+	}// generateLodChain()
+
+	void buildMeshlets(const std::vector<VertexStruct>& vertexStructVector, const std::vector<uint32_t>& indexVector,
+		std::vector<MeshletStruct>& meshletVectorToPopulate, std::vector<uint32_t>& meshletIndexVectorToPopulate,
+		const uint32_t& maxMeshletVertices, const uint32_t& maxMeshletTriangles, const bool& computeBounds) {
+
+		const uint32_t verticesCount = static_cast<uint32_t>(vertexStructVector.size());
+		const uint32_t trianglesCount = static_cast<uint32_t>(indexVector.size() / 3);
+		meshletVectorToPopulate.clear();
+		meshletIndexVectorToPopulate.clear();
+		meshletIndexVectorToPopulate.reserve(trianglesCount * 3);
+
+		/****************************************************************************************************************/
+		/**********    Vertex -> triangles adjacency, to grow each meshlet over triangles it already touches    *********/
+		/****************************************************************************************************************/
+		std::vector<uint32_t> adjacencyOffsetVector(verticesCount + 1, 0);
+		for (size_t i = 0; i < trianglesCount * 3; i++) adjacencyOffsetVector[indexVector[i] + 1]++;
+		for (uint32_t v = 0; v < verticesCount; v++) adjacencyOffsetVector[v + 1] += adjacencyOffsetVector[v];
+		std::vector<uint32_t> adjacencyTriangleVector(trianglesCount * 3);
+		{
+			std::vector<uint32_t> adjacencyFillVector(adjacencyOffsetVector.begin(), adjacencyOffsetVector.end() - 1);
+			for (uint32_t t = 0; t < trianglesCount; t++)
+				for (int c = 0; c < 3; c++)
+					adjacencyTriangleVector[adjacencyFillVector[indexVector[3 * t + c]]++] = t;
+		}
+
+		std::vector<bool> triangleEmittedVector(trianglesCount, false);
+		std::vector<uint32_t> vertexMeshletStampVector(verticesCount, 0);	// meshlet id + 1 the vertex last joined
+		std::vector<uint32_t> meshletVertexVector, meshletTriangleVector, candidateTriangleVector;
+		uint32_t scanTriangle = 0;
+
+		auto newVerticesCount = [&](uint32_t triangle, uint32_t stamp) {
+			uint32_t count = 0;
+			for (int c = 0; c < 3; c++)
+				if (vertexMeshletStampVector[indexVector[3 * triangle + c]] != stamp) count++;
+			return count;
+		};
+
+		while (true) {
+			while (scanTriangle < trianglesCount && triangleEmittedVector[scanTriangle]) scanTriangle++;
+			if (scanTriangle == trianglesCount) break;
+
+			const uint32_t stamp = static_cast<uint32_t>(meshletVectorToPopulate.size()) + 1;
+			meshletVertexVector.clear();
+			meshletTriangleVector.clear();
+			candidateTriangleVector.clear();
+
+			uint32_t nextTriangle = scanTriangle;
+			while (meshletTriangleVector.size() < maxMeshletTriangles) {
+				triangleEmittedVector[nextTriangle] = true;
+				meshletTriangleVector.push_back(nextTriangle);
+				for (int c = 0; c < 3; c++) {
+					uint32_t vertex = indexVector[3 * nextTriangle + c];
+					if (vertexMeshletStampVector[vertex] == stamp) continue;
+					vertexMeshletStampVector[vertex] = stamp;
+					meshletVertexVector.push_back(vertex);
+					for (uint32_t a = adjacencyOffsetVector[vertex]; a < adjacencyOffsetVector[vertex + 1]; a++)
+						if (!triangleEmittedVector[adjacencyTriangleVector[a]])
+							candidateTriangleVector.push_back(adjacencyTriangleVector[a]);
+				}
+
+				// Prefer the neighbour that brings the fewest new vertices; disconnected pieces continue in file order
+				uint32_t bestTriangle = trianglesCount, bestNewVertices = 4;
+				size_t writeCandidate = 0;
+				for (size_t i = 0; i < candidateTriangleVector.size(); i++) {
+					uint32_t candidate = candidateTriangleVector[i];
+					if (triangleEmittedVector[candidate]) continue;
+					candidateTriangleVector[writeCandidate++] = candidate;
+					uint32_t newVertices = newVerticesCount(candidate, stamp);
+					if (newVertices < bestNewVertices) {
+						bestNewVertices = newVertices;
+						bestTriangle = candidate;
+					}
+				}
+				candidateTriangleVector.resize(writeCandidate);
+
+				if (trianglesCount == bestTriangle) {
+					while (scanTriangle < trianglesCount && triangleEmittedVector[scanTriangle]) scanTriangle++;
+					if (scanTriangle == trianglesCount) break;
+					bestTriangle = scanTriangle;
+					bestNewVertices = newVerticesCount(bestTriangle, stamp);
+				}
+				if (meshletVertexVector.size() + bestNewVertices > maxMeshletVertices) break;
+				nextTriangle = bestTriangle;
+			}
+
+			MeshletStruct meshlet{};
+			meshlet.firstIndex = static_cast<uint32_t>(meshletIndexVectorToPopulate.size());
+			meshlet.indexCount = static_cast<uint32_t>(meshletTriangleVector.size() * 3);
+			meshlet.verticesCount = static_cast<uint32_t>(meshletVertexVector.size());
+			for (uint32_t triangle : meshletTriangleVector)
+				meshletIndexVectorToPopulate.insert(meshletIndexVectorToPopulate.end(),
+					{ indexVector[3 * triangle + 0], indexVector[3 * triangle + 1], indexVector[3 * triangle + 2] });
+
+			meshletVectorToPopulate.push_back(meshlet);
+		}
+		if (!computeBounds) return;
+
+		/****************************************************************************************************************/
+		/**********    Bounding sphere and normal cone of every meshlet, independent of each other:  in parallel    *****/
+		/****************************************************************************************************************/
+		SenJobSystem::shared().parallelFor(static_cast<uint32_t>(meshletVectorToPopulate.size()), 0, [&](uint32_t meshletBegin, uint32_t meshletEnd) {
+			std::vector<glm::vec3> triangleNormalVector;
+			for (uint32_t meshletIndex = meshletBegin; meshletIndex < meshletEnd; meshletIndex++) {
+				MeshletStruct& meshlet = meshletVectorToPopulate[meshletIndex];
+				const uint32_t* meshletIndices = meshletIndexVectorToPopulate.data() + meshlet.firstIndex;
+
+				// Shared vertices are visited more than once, which changes neither the box nor the radius
+				glm::vec3 boundsMin = vertexStructVector[meshletIndices[0]].position, boundsMax = boundsMin;
+				for (uint32_t i = 0; i < meshlet.indexCount; i++) {
+					boundsMin = glm::min(boundsMin, vertexStructVector[meshletIndices[i]].position);
+					boundsMax = glm::max(boundsMax, vertexStructVector[meshletIndices[i]].position);
+				}
+				glm::vec3 center = (boundsMin + boundsMax) * 0.5f;
+				float radius = 0.0f;
+				for (uint32_t i = 0; i < meshlet.indexCount; i++)
+					radius = (std::max)(radius, glm::length(vertexStructVector[meshletIndices[i]].position - center));
+				meshlet.boundingSphere = glm::vec4(center, radius);
+
+				triangleNormalVector.clear();
+				glm::vec3 normalSum(0.0f);
+				for (uint32_t i = 0; i + 2 < meshlet.indexCount; i += 3) {
+					const glm::vec3& p0 = vertexStructVector[meshletIndices[i + 0]].position;
+					const glm::vec3& p1 = vertexStructVector[meshletIndices[i + 1]].position;
+					const glm::vec3& p2 = vertexStructVector[meshletIndices[i + 2]].position;
+					glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+					float length = glm::length(normal);
+					if (length > 0.0f) {
+						triangleNormalVector.push_back(normal / length);
+						normalSum += normal / length;
+					}
+				}
+
+				meshlet.normalCone = glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+				float normalSumLength = glm::length(normalSum);
+				if (normalSumLength > 0.0f) {
+					glm::vec3 axis = normalSum / normalSumLength;
+					float minAxisDot = 1.0f;
+					for (const glm::vec3& normal : triangleNormalVector)
+						minAxisDot = (std::min)(minAxisDot, glm::dot(axis, normal));
+					// Normals spread beyond a hemisphere can always face the camera somewhere, keep cutoff 1
+					if (minAxisDot > 0.0f)
+						meshlet.normalCone = glm::vec4(axis, std::sqrt(1.0f - minAxisDot * minAxisDot));
+				}
+			}
+		});
+	}// buildMeshlets()
+
+	uint32_t selectLodLevel(const std::vector<LodLevelStruct>& lodLevelVector, const float& distanceToCamera,
+		const float& fovY, const float& viewportHeight, const float& pixelErrorThreshold) {
+		// Pixels covered by one model unit at distanceToCamera under a perspective projection
+		const float pixelsPerUnit = viewportHeight / (2.0f * (std::max)(distanceToCamera, 1e-4f) * std::tan(fovY * 0.5f));
+
+		uint32_t selectedLevel = 0;
+		for (uint32_t level = 1; level < lodLevelVector.size(); level++) {
+			if (lodLevelVector[level].objectSpaceError * pixelsPerUnit > pixelErrorThreshold) break;
+			selectedLevel = level;
+		}
+		return selectedLevel;
+	}// selectLodLevel()
+
 
 }// namespace stobjl
\ No newline at end of file
@@ -19,11 +19,50 @@ struct VertexStruct {
 	}
 };
 
+// Per-instance vertex stream, bound with VK_VERTEX_INPUT_RATE_INSTANCE; a mat4 attribute occupies 4 consecutive locations
+struct InstanceStruct {
+	glm::mat4 model;
+};
+
+// One level of detail inside a shared index buffer, all levels index into the same vertex buffer
+struct LodLevelStruct {
+	uint32_t firstIndex;
+	uint32_t indexCount;
+	float objectSpaceError;	// max deviation from the full resolution surface, in model units
+};
+
+// Cluster of at most 64 vertices / 124 triangles, laid out for a std430 storage buffer read by the culling compute shader
+struct MeshletStruct {
+	glm::vec4 boundingSphere;	// xyz: center, w: radius, in model space
+	glm::vec4 normalCone;		// xyz: average facing axis, w: cutoff; 1 means the cluster is never back-face culled
+	uint32_t firstIndex;		// into the meshlet ordered index buffer
+	uint32_t indexCount;
+	uint32_t verticesCount;
+	uint32_t padding;
+};
+
 namespace stobjl
 {
 	void populateVertexIndexVector(const char* const tinyObjectDiskAddress,
 		std::vector<VertexStruct>& vertexStructVectorToPopulate, std::vector<uint32_t>& indexVectorToPopulate);
 
+	// Quadric edge collapse: LOD 0 is the input range, each following level keeps ~lodTriangleRatio of the previous one's triangles.
+	// Simplified index ranges are appended to indexVectorToAppend; vertices are never moved or added, so one vertex buffer serves all levels.
+	void generateLodChain(const std::vector<VertexStruct>& vertexStructVector, std::vector<uint32_t>& indexVectorToAppend,
+		std::vector<LodLevelStruct>& lodLevelVectorToPopulate, const uint32_t& maxLodLevelsCount = 6, const float& lodTriangleRatio = 0.5f);
+
+	// Regroup triangles into clusters of spatially adjacent triangles; meshletIndexVectorToPopulate holds the same triangles
+	// ordered by meshlet, still indexing vertexStructVector, so a meshlet is drawn with a plain indexed draw of its range.
+	// Without computeBounds, boundingSphere and normalCone are left zero (SenComputeOffloadDevice::computeMeshletBounds fills them).
+	// With it they are computed once all meshlets are built, spread over SenJobSystem::shared().
+	void buildMeshlets(const std::vector<VertexStruct>& vertexStructVector, const std::vector<uint32_t>& indexVector,
+		std::vector<MeshletStruct>& meshletVectorToPopulate, std::vector<uint32_t>& meshletIndexVectorToPopulate,
+		const uint32_t& maxMeshletVertices = 64, const uint32_t& maxMeshletTriangles = 124, const bool& computeBounds = true);
+
+	// Coarsest level whose objectSpaceError projects to no more than pixelErrorThreshold pixels at distanceToCamera
+	uint32_t selectLodLevel(const std::vector<LodLevelStruct>& lodLevelVector, const float& distanceToCamera,
+		const float& fovY, const float& viewportHeight, const float& pixelErrorThreshold = 1.0f);
+
 } //namespace stobjl
 
 
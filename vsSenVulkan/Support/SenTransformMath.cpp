@@ -0,0 +1,51 @@
+#include "SenTransformMath.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define SEN_TRANSFORM_MATH_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace stfm
+{
+	void multiplyMat4(const glm::mat4& lhs, const glm::mat4& rhs, glm::mat4& productToPopulate) {
+		const float* lhsFloats = &lhs[0][0];
+		const float* rhsFloats = &rhs[0][0];
+		float productFloats[16];
+
+#ifdef SEN_TRANSFORM_MATH_SSE
+		const __m128 lhsColumn0 = _mm_loadu_ps(lhsFloats);
+		const __m128 lhsColumn1 = _mm_loadu_ps(lhsFloats + 4);
+		const __m128 lhsColumn2 = _mm_loadu_ps(lhsFloats + 8);
+		const __m128 lhsColumn3 = _mm_loadu_ps(lhsFloats + 12);
+
+		for (int column = 0; column < 4; column++) {
+			const float* rhsColumn = rhsFloats + 4 * column;
+			__m128 productColumn = _mm_mul_ps(lhsColumn0, _mm_set1_ps(rhsColumn[0]));
+			productColumn = _mm_add_ps(productColumn, _mm_mul_ps(lhsColumn1, _mm_set1_ps(rhsColumn[1])));
+			productColumn = _mm_add_ps(productColumn, _mm_mul_ps(lhsColumn2, _mm_set1_ps(rhsColumn[2])));
+			productColumn = _mm_add_ps(productColumn, _mm_mul_ps(lhsColumn3, _mm_set1_ps(rhsColumn[3])));
+			_mm_storeu_ps(productFloats + 4 * column, productColumn);
+		}
+#else
+		for (int column = 0; column < 4; column++) {
+			for (int row = 0; row < 4; row++) {
+				float sum = 0.0f;
+				for (int k = 0; k < 4; k++)
+					sum += lhsFloats[4 * k + row] * rhsFloats[4 * column + k];
+				productFloats[4 * column + row] = sum;
+			}
+		}
+#endif
+		// Written last, such that productToPopulate may be one of the inputs
+		for (int column = 0; column < 4; column++)
+			productToPopulate[column] = glm::vec4(productFloats[4 * column], productFloats[4 * column + 1],
+				productFloats[4 * column + 2], productFloats[4 * column + 3]);
+	}// multiplyMat4()
+
+	void computeModelViewProjection(const glm::mat4& projection, const glm::mat4& view, const glm::mat4& model,
+		glm::mat4& modelViewToPopulate, glm::mat4& modelViewProjectionToPopulate) {
+		multiplyMat4(view, model, modelViewToPopulate);
+		multiplyMat4(projection, modelViewToPopulate, modelViewProjectionToPopulate);
+	}// computeModelViewProjection()
+
+}// namespace stfm
@@ -0,0 +1,27 @@
+#pragma once
+
+#ifndef __SenTransformMath__
+#define __SenTransformMath__
+
+#define GLM_FORCE_SWIZZLE // Have to add this for new glm version without default structure initialization
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+/*
+	Transform math done once per object on the CPU instead of once per vertex on the GPU:  the vertex shader then only
+	needs a single mat4 * vec4 with the precomputed model-view-projection.
+	Matrices are glm column-major, a product column is a linear combination of the left matrix's columns, which maps
+	to four SSE multiply-adds;  a scalar loop is used when SSE is not available.
+*/
+namespace stfm
+{
+	// productToPopulate = lhs * rhs, productToPopulate may alias lhs or rhs
+	void multiplyMat4(const glm::mat4& lhs, const glm::mat4& rhs, glm::mat4& productToPopulate);
+
+	// projection * view * model as two matrix products, modelView is kept for view space tests (e.g. LOD distance)
+	void computeModelViewProjection(const glm::mat4& projection, const glm::mat4& view, const glm::mat4& model,
+		glm::mat4& modelViewToPopulate, glm::mat4& modelViewProjectionToPopulate);
+
+} //namespace stfm
+
+#endif // !__SenTransformMath__
@@ -119,6 +119,7 @@ void SenVulkanAPI_Widget::showWidget()
 	//initGlfwVulkanDebugWSI();
 
 	auto w = renderer.openSenWindow(800, 600, strWindowName);
+	const uint32_t frames_in_flight_count = w->GetFramesInFlightCount();
 
 	VkCommandPool command_pool = VK_NULL_HANDLE;
 	VkCommandPoolCreateInfo pool_create_info{};
@@ -127,18 +128,30 @@ void SenVulkanAPI_Widget::showWidget()
 	pool_create_info.queueFamilyIndex = renderer.getGraphicsQueueFamilyIndex();
 	vkCreateCommandPool(renderer.getDevice(), &pool_create_info, nullptr, &command_pool);
 
-	VkCommandBuffer command_buffer = VK_NULL_HANDLE;
+	// One command buffer and one fence per frame in flight:  frame N+1 is recorded while the GPU still executes frame N
+	std::vector<VkCommandBuffer> command_buffers(frames_in_flight_count, VK_NULL_HANDLE);
 	VkCommandBufferAllocateInfo	command_buffer_allocate_info{};
 	command_buffer_allocate_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
 	command_buffer_allocate_info.commandPool = command_pool;
 	command_buffer_allocate_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-	command_buffer_allocate_info.commandBufferCount = 1;
-	vkAllocateCommandBuffers(renderer.getDevice(), &command_buffer_allocate_info, &command_buffer);
+	command_buffer_allocate_info.commandBufferCount = frames_in_flight_count;
+	vkAllocateCommandBuffers(renderer.getDevice(), &command_buffer_allocate_info, command_buffers.data());
+
+	std::vector<VkFence> frame_fences(frames_in_flight_count, VK_NULL_HANDLE);
+	VkFenceCreateInfo fence_create_info{};
+	fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+	fence_create_info.flags = VK_FENCE_CREATE_SIGNALED_BIT;	// the first use of each frame has nothing to wait for
+	for (auto& frame_fence : frame_fences) {
+		vkCreateFence(renderer.getDevice(), &fence_create_info, nullptr, &frame_fence);
+	}
 
-	VkSemaphore render_complete_semaphore = VK_NULL_HANDLE;
+	// Per swapchain image:  image i is only re-acquired after its present consumed the semaphore
+	std::vector<VkSemaphore> render_complete_semaphores(w->GetSwapchainImagesCount(), VK_NULL_HANDLE);
 	VkSemaphoreCreateInfo semaphore_create_info{};
 	semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-	vkCreateSemaphore(renderer.getDevice(), &semaphore_create_info, nullptr, &render_complete_semaphore);
+	for (auto& render_complete_semaphore : render_complete_semaphores) {
+		vkCreateSemaphore(renderer.getDevice(), &semaphore_create_info, nullptr, &render_complete_semaphore);
+	}
 
 	float color_rotator = 0.0f;
 	auto timer = std::chrono::steady_clock();
@@ -157,6 +170,12 @@ void SenVulkanAPI_Widget::showWidget()
 			std::cout << "FPS: " << fps << std::endl;
 		}
 
+		// Wait only for the frame that used this slot frames_in_flight_count frames ago
+		const uint32_t frame_id = w->GetActiveFrame_ID();
+		ErrorCheck(vkWaitForFences(renderer.getDevice(), 1, &frame_fences[frame_id], VK_TRUE, UINT64_MAX));
+		ErrorCheck(vkResetFences(renderer.getDevice(), 1, &frame_fences[frame_id]));
+		VkCommandBuffer command_buffer = command_buffers[frame_id];
+
 		// Begin render
 		w->BeginRender();
 		// Record command buffer
@@ -195,18 +214,21 @@ void SenVulkanAPI_Widget::showWidget()
 
 		vkEndCommandBuffer(command_buffer);
 
-		// Submit command buffer
+		// Submit command buffer, the color attachment is not written before the swapchain image is really available
+		VkSemaphore image_acquired_semaphore = w->GetVulkanImageAcquiredSemaphore();
+		VkSemaphore render_complete_semaphore = render_complete_semaphores[w->GetActiveSwapchainImage_ID()];
+		VkPipelineStageFlags wait_dst_stage_mask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
 		VkSubmitInfo submit_info{};
 		submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-		submit_info.waitSemaphoreCount = 0;
-		submit_info.pWaitSemaphores = nullptr;
-		submit_info.pWaitDstStageMask = nullptr;
+		submit_info.waitSemaphoreCount = 1;
+		submit_info.pWaitSemaphores = &image_acquired_semaphore;
+		submit_info.pWaitDstStageMask = &wait_dst_stage_mask;
 		submit_info.commandBufferCount = 1;
 		submit_info.pCommandBuffers = &command_buffer;
 		submit_info.signalSemaphoreCount = 1;
 		submit_info.pSignalSemaphores = &render_complete_semaphore;
 
-		vkQueueSubmit(renderer.getQueue(), 1, &submit_info, VK_NULL_HANDLE);
+		ErrorCheck(vkQueueSubmit(renderer.getQueue(), 1, &submit_info, frame_fences[frame_id]));
 
 		// End render
 		w->EndRender({ render_complete_semaphore });
@@ -215,7 +237,12 @@ void SenVulkanAPI_Widget::showWidget()
 
 	vkQueueWaitIdle(renderer.getQueue());
 
-	vkDestroySemaphore(renderer.getDevice(), render_complete_semaphore, nullptr);
+	for (auto render_complete_semaphore : render_complete_semaphores) {
+		vkDestroySemaphore(renderer.getDevice(), render_complete_semaphore, nullptr);
+	}
+	for (auto frame_fence : frame_fences) {
+		vkDestroyFence(renderer.getDevice(), frame_fence, nullptr);
+	}
 	vkDestroyCommandPool(renderer.getDevice(), command_pool, nullptr);
 	//finalize();// all the clean up works
 }
@@ -204,12 +204,24 @@ void SenWindow::_InitRenderPass()
 	sub_passes[0].pDepthStencilAttachment = &subPass_0_depthStencilAttachment;
 
 
+	// Frames overlap now:  the layout transitions wait for the acquire semaphore (color output stage),
+	// and the shared depth image is not cleared before the previous frame finished writing it.
+	std::array<VkSubpassDependency, 1> sub_pass_dependencies{};
+	sub_pass_dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+	sub_pass_dependencies[0].dstSubpass = 0;
+	sub_pass_dependencies[0].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+	sub_pass_dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
+	sub_pass_dependencies[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+	sub_pass_dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
 	VkRenderPassCreateInfo render_pass_create_info{};
 	render_pass_create_info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
 	render_pass_create_info.attachmentCount = attachments.size();
 	render_pass_create_info.pAttachments = attachments.data();
 	render_pass_create_info.subpassCount = sub_passes.size();
 	render_pass_create_info.pSubpasses = sub_passes.data();
+	render_pass_create_info.dependencyCount = sub_pass_dependencies.size();
+	render_pass_create_info.pDependencies = sub_pass_dependencies.data();
 
 	ErrorCheck(vkCreateRenderPass(_renderer->getDevice(), &render_pass_create_info, nullptr, &_renderPass));
 
@@ -250,14 +262,20 @@ void SenWindow::_DeInitFramebuffers()
 
 void SenWindow::_InitSynchronizations()
 {
-	VkFenceCreateInfo fence_create_info{};
-	fence_create_info.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-	vkCreateFence(_renderer->getDevice(), &fence_create_info, nullptr, &_swapchainImageAvailableFence);
+	VkSemaphoreCreateInfo semaphore_create_info{};
+	semaphore_create_info.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+	_imageAcquiredSemaphoresVector.resize(_framesInFlightCount);
+	for (auto& semaphore : _imageAcquiredSemaphoresVector) {
+		ErrorCheck(vkCreateSemaphore(_renderer->getDevice(), &semaphore_create_info, nullptr, &semaphore));
+	}
 }
 
 void SenWindow::_DeInitSynchronizations()
 {
-	vkDestroyFence(_renderer->getDevice(), _swapchainImageAvailableFence, nullptr);
+	for (auto semaphore : _imageAcquiredSemaphoresVector) {
+		vkDestroySemaphore(_renderer->getDevice(), semaphore, nullptr);
+	}
+	_imageAcquiredSemaphoresVector.clear();
 }
 
 void SenWindow::closeSenWindow()
@@ -273,16 +291,14 @@ bool SenWindow::updateSenWindow()
 
 void SenWindow::BeginRender()
 {
+	// No CPU wait here:  the GPU waits on the semaphore, the CPU goes on recording
 	ErrorCheck(vkAcquireNextImageKHR(
 		_renderer->getDevice(),
 		_swapchain,
 		UINT64_MAX,
+		_imageAcquiredSemaphoresVector[_activeFrame_ID],
 		VK_NULL_HANDLE,
-		_swapchainImageAvailableFence,
 		&_activeSwapchainImage_ID));
-	ErrorCheck(vkWaitForFences(_renderer->getDevice(), 1, &_swapchainImageAvailableFence, VK_TRUE, UINT64_MAX));
-	ErrorCheck(vkResetFences(_renderer->getDevice(), 1, &_swapchainImageAvailableFence));
-	ErrorCheck(vkQueueWaitIdle(_renderer->getQueue()));
 }
 
 void SenWindow::EndRender(std::vector<VkSemaphore> wait_semaphores)
@@ -300,6 +316,8 @@ void SenWindow::EndRender(std::vector<VkSemaphore> wait_semaphores)
 
 	ErrorCheck(vkQueuePresentKHR(_renderer->getQueue(), &present_info));
 	ErrorCheck(present_result);
+
+	_activeFrame_ID = (_activeFrame_ID + 1) % _framesInFlightCount;
 }
 
 void SenWindow::_InitSurface()
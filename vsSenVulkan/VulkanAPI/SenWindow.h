@@ -20,12 +20,19 @@ public:
 	void closeSenWindow();
 	bool updateSenWindow();
 
+	// BeginRender() only queues the acquire:  the first submit of the frame has to wait on GetVulkanImageAcquiredSemaphore(),
+	// and the caller has to wait for the fence of frame GetActiveFrame_ID() before calling BeginRender() again for that frame.
 	void								BeginRender();
 	void								EndRender(std::vector<VkSemaphore> wait_semaphores);
 
 	VkRenderPass						GetVulkanRenderPass() {	return _renderPass;	}
 	VkFramebuffer						GetVulkanActiveFramebuffer() { return _framebuffers[_activeSwapchainImage_ID]; }
 	VkExtent2D							GetVulkanSurfaceSize()	{ return{ _surfaceSize_X, _surfaceSize_Y }; }
+	VkSemaphore							GetVulkanImageAcquiredSemaphore() { return _imageAcquiredSemaphoresVector[_activeFrame_ID]; }
+	uint32_t							GetActiveSwapchainImage_ID() { return _activeSwapchainImage_ID; }
+	uint32_t							GetSwapchainImagesCount() { return _swapchainImagesCount; }
+	uint32_t							GetActiveFrame_ID() { return _activeFrame_ID; }
+	uint32_t							GetFramesInFlightCount() { return _framesInFlightCount; }
 
 private:
 	void								_InitOSWindow();
@@ -78,7 +85,11 @@ private:
 	VkRenderPass						_renderPass = VK_NULL_HANDLE;
 	std::vector<VkFramebuffer>			_framebuffers;
 	uint32_t							_activeSwapchainImage_ID = UINT32_MAX;
-	VkFence								_swapchainImageAvailableFence = VK_NULL_HANDLE;
+
+	// Frames the CPU may record ahead of the GPU, each with its own acquire semaphore
+	const uint32_t						_framesInFlightCount = 2;
+	uint32_t							_activeFrame_ID = 0;
+	std::vector<VkSemaphore>			_imageAcquiredSemaphoresVector;
 
 
 #if defined( _WIN32 )  // on Windows OS
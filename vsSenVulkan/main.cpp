@@ -15,11 +15,47 @@
 #include "SenVulkanTutorial/Sen_22_DepthTest.h"
 #include "SenVulkanTutorial/Sen_221_Cube.h"
 #include "SenVulkanTutorial/Sen_222_TinyObjLoader.h"
+#include "SenVulkanTutorial/Sen_223_Instancing.h"
+#include "SenVulkanTutorial/Sen_224_ClusterCulling.h"
+#include "SenVulkanTutorial/Sen_225_TextureStreaming.h"
+#include "Support/SenMeshCodec.h"
+#include "Support/SenJobSystem.h"
 //#include <functional>
 
 SLVK_AbstractGLFW* widget;
-int main() {
+int main(int argc, char* argv[]) {
+	// vsSenVulkan --compress-mesh [in.obj] [out.smc]:  no window, writes the .smc and reports ratio / decode throughput
+	if (argc > 1 && std::string(argv[1]) == "--compress-mesh") {
+		const char* objDiskAddress = argc > 2 ? argv[2] : "../Images/MeshLinkModels/Chalet/chalet.obj";
+		const char* smcDiskAddress = argc > 3 ? argv[3] : "../Images/MeshLinkModels/Chalet/chalet.smc";
+		try {
+			smcd::compressObjFile(objDiskAddress, smcDiskAddress);
+		}
+		catch (const std::runtime_error& e) {
+			std::cerr << e.what() << std::endl;
+			return EXIT_FAILURE;
+		}
+		return EXIT_SUCCESS;
+	}
+	// vsSenVulkan --benchmark-jobs [maxThreads]:  no window, SenJobSystem overhead and scaling from 1 to maxThreads threads
+	if (argc > 1 && std::string(argv[1]) == "--benchmark-jobs") {
+		unsigned long maxThreadsCount = 0;
+		if (argc > 2) {
+			try {
+				maxThreadsCount = std::stoul(argv[2]);
+			}
+			catch (const std::logic_error&) {	// std::invalid_argument, std::out_of_range
+				std::cerr << "Usage:  vsSenVulkan --benchmark-jobs [maxThreads]   (maxThreads 1-" << SenJobSystem::maxBenchmarkThreadsCount << ")" << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		std::cout << SenJobSystem::benchmark(static_cast<uint32_t>((std::min)(maxThreadsCount, static_cast<unsigned long>(SenJobSystem::maxBenchmarkThreadsCount))));
+		return EXIT_SUCCESS;
+	}
+
 	widget = new Sen_072_TextureArray();
+	//widget->setLatencyPolicy(SLVK_AbstractGLFW::LATENCY_POLICY_LOW_LATENCY);	// or THROUGHPUT (default), POWER_SAVING, optional FPS cap
+	//widget->enableTextureUploadComparison();	// staging ring vs VK_EXT_host_image_copy upload throughput, printed at startup
 	try {
 		widget->showWidget();
 	}